@@ -36,10 +36,13 @@
 #include "atom/gdata-category.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 
 static void gdata_app_categories_dispose (GObject *object);
 static void gdata_app_categories_finalize (GObject *object);
 static void gdata_app_categories_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 static gboolean
 parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data,
             GError **error);
@@ -93,6 +96,8 @@ gdata_app_categories_class_init (GDataAPPCategoriesClass *klass)
 	                                                       "Fixed?", "Whether entries may use categories not in this category list.",
 	                                                       FALSE,
 	                                                       G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static void
@@ -223,6 +228,26 @@ get_content_type (void)
 	return "application/json";
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	GDataAPPCategoriesPrivate *priv = GDATA_APP_CATEGORIES (parsable)->priv;
+
+	gdata_binary_writer_put_parsable_list (writer, priv->categories);
+	gdata_binary_writer_put_string (writer, priv->scheme);
+	gdata_binary_writer_put_boolean (writer, priv->fixed);
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	GDataAPPCategoriesPrivate *priv = GDATA_APP_CATEGORIES (parsable)->priv;
+
+	priv->categories = gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_CATEGORY);
+	priv->scheme = gdata_binary_reader_dup_string (reader);
+	priv->fixed = gdata_binary_reader_get_boolean (reader);
+}
+
 /**
  * gdata_app_categories_get_categories:
  * @self: a #GDataAPPCategories
@@ -35,6 +35,7 @@
 #include "gdata-author.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 #include "gdata-comparable.h"
 
 static void gdata_author_comparable_init (GDataComparableIface *iface);
@@ -124,6 +125,8 @@ gdata_author_class_init (GDataAuthorClass *klass)
 	                                                      "E-mail address", "An e-mail address associated with the person.",
 	                                                      NULL,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static gint
@@ -132,10 +135,17 @@ compare_with (GDataComparable *self, GDataComparable *other)
 	return g_strcmp0 (((GDataAuthor*) self)->priv->name, ((GDataAuthor*) other)->priv->name);
 }
 
+static guint
+hash (GDataComparable *self)
+{
+	return _gdata_comparable_hash_string (0, ((GDataAuthor*) self)->priv->name);
+}
+
 static void
 gdata_author_comparable_init (GDataComparableIface *iface)
 {
 	iface->compare_with = compare_with;
+	iface->hash = hash;
 }
 
 static void
@@ -35,6 +35,7 @@
 #include "gdata-category.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 #include "gdata-comparable.h"
 
 static void gdata_category_comparable_init (GDataComparableIface *iface);
@@ -125,6 +126,8 @@ gdata_category_class_init (GDataCategoryClass *klass)
 	                                                      "Label", "A human-readable label for display in end-user applications.",
 	                                                      NULL,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static gint
@@ -133,10 +136,17 @@ compare_with (GDataComparable *self, GDataComparable *other)
 	return g_strcmp0 (((GDataCategory*) self)->priv->term, ((GDataCategory*) other)->priv->term);
 }
 
+static guint
+hash (GDataComparable *self)
+{
+	return _gdata_comparable_hash_string (0, ((GDataCategory*) self)->priv->term);
+}
+
 static void
 gdata_category_comparable_init (GDataComparableIface *iface)
 {
 	iface->compare_with = compare_with;
+	iface->hash = hash;
 }
 
 static void
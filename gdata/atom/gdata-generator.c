@@ -33,6 +33,7 @@
 #include "gdata-generator.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 #include "gdata-comparable.h"
 
 static void gdata_generator_comparable_init (GDataComparableIface *iface);
@@ -40,6 +41,8 @@ static void gdata_generator_finalize (GObject *object);
 static void gdata_generator_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 static gboolean pre_parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *root_node, gpointer user_data, GError **error);
 static gboolean parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *root_node, gpointer user_data, GError **error);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 
 struct _GDataGeneratorPrivate {
 	gchar *name;
@@ -121,6 +124,8 @@ gdata_generator_class_init (GDataGeneratorClass *klass)
 	                                                      "Version", "Indicates the version of the generating agent.",
 	                                                      NULL,
 	                                                      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static gint
@@ -129,10 +134,17 @@ compare_with (GDataComparable *self, GDataComparable *other)
 	return g_strcmp0 (((GDataGenerator*) self)->priv->name, ((GDataGenerator*) other)->priv->name);
 }
 
+static guint
+hash (GDataComparable *self)
+{
+	return _gdata_comparable_hash_string (0, ((GDataGenerator*) self)->priv->name);
+}
+
 static void
 gdata_generator_comparable_init (GDataComparableIface *iface)
 {
 	iface->compare_with = compare_with;
+	iface->hash = hash;
 }
 
 static void
@@ -212,6 +224,26 @@ parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *node, gpointer user_da
 	return GDATA_PARSABLE_CLASS (gdata_generator_parent_class)->parse_xml (parsable, doc, node, user_data, error);
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	GDataGeneratorPrivate *priv = GDATA_GENERATOR (parsable)->priv;
+
+	gdata_binary_writer_put_string (writer, priv->name);
+	gdata_binary_writer_put_string (writer, priv->uri);
+	gdata_binary_writer_put_string (writer, priv->version);
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	GDataGeneratorPrivate *priv = GDATA_GENERATOR (parsable)->priv;
+
+	priv->name = gdata_binary_reader_dup_string (reader);
+	priv->uri = gdata_binary_reader_dup_string (reader);
+	priv->version = gdata_binary_reader_dup_string (reader);
+}
+
 /**
  * gdata_generator_get_name:
  * @self: a #GDataGenerator
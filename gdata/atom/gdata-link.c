@@ -36,6 +36,7 @@
 #include "gdata-link.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 #include "gdata-comparable.h"
 
 static void gdata_link_comparable_init (GDataComparableIface *iface);
@@ -178,6 +179,8 @@ gdata_link_class_init (GDataLinkClass *klass)
 	                                                   "Length", "Indicates an advisory length of the linked content in octets.",
 	                                                   -1, G_MAXINT, -1,
 	                                                   G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static gint
@@ -190,10 +193,23 @@ compare_with (GDataComparable *self, GDataComparable *other)
 	return 1;
 }
 
+static guint
+hash (GDataComparable *self)
+{
+	GDataLinkPrivate *priv = ((GDataLink*) self)->priv;
+	guint value = 0;
+
+	value = _gdata_comparable_hash_string (value, priv->uri);
+	value = _gdata_comparable_hash_string (value, priv->relation_type);
+
+	return value;
+}
+
 static void
 gdata_link_comparable_init (GDataComparableIface *iface)
 {
 	iface->compare_with = compare_with;
+	iface->hash = hash;
 }
 
 static void
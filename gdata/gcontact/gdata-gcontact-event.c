@@ -36,6 +36,7 @@
 #include "gdata-gcontact-event.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 
 static void gdata_gcontact_event_finalize (GObject *object);
 static void gdata_gcontact_event_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
@@ -131,6 +132,8 @@ gdata_gcontact_event_class_init (GDataGContactEventClass *klass)
 	                                                      "Label", "A simple string value used to name this event.",
 	                                                      NULL,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static void
@@ -35,6 +35,7 @@
 #include "gdata-gcontact-external-id.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 #include "gdata-comparable.h"
 
 static void gdata_gcontact_external_id_comparable_init (GDataComparableIface *iface);
@@ -126,6 +127,8 @@ gdata_gcontact_external_id_class_init (GDataGContactExternalIDClass *klass)
 	                                                      "Label", "A free-form string that identifies the type of external ID.",
 	                                                      NULL,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static gint
@@ -138,10 +141,24 @@ compare_with (GDataComparable *self, GDataComparable *other)
 	return 1;
 }
 
+static guint
+hash (GDataComparable *self)
+{
+	GDataGContactExternalIDPrivate *priv = ((GDataGContactExternalID*) self)->priv;
+	guint value = 0;
+
+	value = _gdata_comparable_hash_string (value, priv->value);
+	value = _gdata_comparable_hash_string (value, priv->relation_type);
+	value = _gdata_comparable_hash_string (value, priv->label);
+
+	return value;
+}
+
 static void
 gdata_gcontact_external_id_comparable_init (GDataComparableIface *iface)
 {
 	iface->compare_with = compare_with;
+	iface->hash = hash;
 }
 
 static void
@@ -35,6 +35,7 @@
 #include "gdata-gcontact-jot.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 
 static void gdata_gcontact_jot_finalize (GObject *object);
 static void gdata_gcontact_jot_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
@@ -108,6 +109,8 @@ gdata_gcontact_jot_class_init (GDataGContactJotClass *klass)
 	                                                      "Relation type", "A programmatic value that identifies the type of jot.",
 	                                                      NULL,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static void
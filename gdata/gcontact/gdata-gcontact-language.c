@@ -35,6 +35,7 @@
 #include "gdata-gcontact-language.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 #include "gdata-comparable.h"
 
 static void gdata_gcontact_language_comparable_init (GDataComparableIface *iface);
@@ -107,6 +108,8 @@ gdata_gcontact_language_class_init (GDataGContactLanguageClass *klass)
 	                                                      "Label", "A free-form string that identifies the language.",
 	                                                      NULL,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static gint
@@ -119,10 +122,23 @@ compare_with (GDataComparable *self, GDataComparable *other)
 	return 1;
 }
 
+static guint
+hash (GDataComparable *self)
+{
+	GDataGContactLanguagePrivate *priv = ((GDataGContactLanguage*) self)->priv;
+	guint value = 0;
+
+	value = _gdata_comparable_hash_string (value, priv->code);
+	value = _gdata_comparable_hash_string (value, priv->label);
+
+	return value;
+}
+
 static void
 gdata_gcontact_language_comparable_init (GDataComparableIface *iface)
 {
 	iface->compare_with = compare_with;
+	iface->hash = hash;
 }
 
 static void
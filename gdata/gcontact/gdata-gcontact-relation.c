@@ -35,6 +35,7 @@
 #include "gdata-gcontact-relation.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 
 static void gdata_gcontact_relation_finalize (GObject *object);
 static void gdata_gcontact_relation_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
@@ -127,6 +128,8 @@ gdata_gcontact_relation_class_init (GDataGContactRelationClass *klass)
 	                                                      "Label", "A free-form string that identifies the type of relation.",
 	                                                      NULL,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static void
@@ -35,6 +35,7 @@
 #include "gdata-gcontact-website.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 #include "gdata-comparable.h"
 
 static void gdata_gcontact_website_comparable_init (GDataComparableIface *iface);
@@ -145,6 +146,8 @@ gdata_gcontact_website_class_init (GDataGContactWebsiteClass *klass)
 	                                                       "Primary?", "Indicates which website out of a group is primary.",
 	                                                       FALSE,
 	                                                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static gint
@@ -157,10 +160,24 @@ compare_with (GDataComparable *self, GDataComparable *other)
 	return 1;
 }
 
+static guint
+hash (GDataComparable *self)
+{
+	GDataGContactWebsitePrivate *priv = ((GDataGContactWebsite*) self)->priv;
+	guint value = 0;
+
+	value = _gdata_comparable_hash_string (value, priv->uri);
+	value = _gdata_comparable_hash_string (value, priv->relation_type);
+	value = _gdata_comparable_hash_string (value, priv->label);
+
+	return value;
+}
+
 static void
 gdata_gcontact_website_comparable_init (GDataComparableIface *iface)
 {
 	iface->compare_with = compare_with;
+	iface->hash = hash;
 }
 
 static void
@@ -35,6 +35,7 @@
 #include "gdata-gd-email-address.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 #include "gdata-comparable.h"
 
 static void gdata_gd_email_address_comparable_init (GDataComparableIface *iface);
@@ -161,6 +162,8 @@ gdata_gd_email_address_class_init (GDataGDEmailAddressClass *klass)
 	                                                      "Display name", "A display name of the entity the e-mail address belongs to.",
 	                                                      NULL,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static gint
@@ -169,10 +172,17 @@ compare_with (GDataComparable *self, GDataComparable *other)
 	return g_strcmp0 (((GDataGDEmailAddress*) self)->priv->address, ((GDataGDEmailAddress*) other)->priv->address);
 }
 
+static guint
+hash (GDataComparable *self)
+{
+	return _gdata_comparable_hash_string (0, ((GDataGDEmailAddress*) self)->priv->address);
+}
+
 static void
 gdata_gd_email_address_comparable_init (GDataComparableIface *iface)
 {
 	iface->compare_with = compare_with;
+	iface->hash = hash;
 }
 
 static void
@@ -150,6 +150,8 @@ gdata_gd_feed_link_class_init (GDataGDFeedLinkClass *klass)
 	                                                       "Read only?", "Indicates whether the feed is read only.",
 	                                                       TRUE,
 	                                                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static void
@@ -35,6 +35,7 @@
 #include "gdata-gd-im-address.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 #include "gdata-comparable.h"
 
 static void gdata_gd_im_address_comparable_init (GDataComparableIface *iface);
@@ -161,6 +162,8 @@ gdata_gd_im_address_class_init (GDataGDIMAddressClass *klass)
 	                                                       "Primary?", "Indicates which IM address out of a group is primary.",
 	                                                       FALSE,
 	                                                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static gint
@@ -173,10 +176,23 @@ compare_with (GDataComparable *self, GDataComparable *other)
 	return 1;
 }
 
+static guint
+hash (GDataComparable *self)
+{
+	GDataGDIMAddressPrivate *priv = ((GDataGDIMAddress*) self)->priv;
+	guint value = 0;
+
+	value = _gdata_comparable_hash_string (value, priv->address);
+	value = _gdata_comparable_hash_string (value, priv->protocol);
+
+	return value;
+}
+
 static void
 gdata_gd_im_address_comparable_init (GDataComparableIface *iface)
 {
 	iface->compare_with = compare_with;
+	iface->hash = hash;
 }
 
 static void
@@ -45,6 +45,7 @@
 #include "gdata-gd-name.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 #include "gdata-comparable.h"
 
 static void gdata_gd_name_comparable_init (GDataComparableIface *iface);
@@ -190,6 +191,8 @@ gdata_gd_name_class_init (GDataGDNameClass *klass)
 	                                                      "Full name", "An unstructured representation of the person's full name.",
 	                                                      NULL,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static gint
@@ -203,10 +206,25 @@ compare_with (GDataComparable *self, GDataComparable *other)
 	return 1;
 }
 
+static guint
+hash (GDataComparable *self)
+{
+	GDataGDNamePrivate *priv = ((GDataGDName*) self)->priv;
+	guint value = 0;
+
+	value = _gdata_comparable_hash_string (value, priv->given_name);
+	value = _gdata_comparable_hash_string (value, priv->additional_name);
+	value = _gdata_comparable_hash_string (value, priv->family_name);
+	value = _gdata_comparable_hash_string (value, priv->prefix);
+
+	return value;
+}
+
 static void
 gdata_gd_name_comparable_init (GDataComparableIface *iface)
 {
 	iface->compare_with = compare_with;
+	iface->hash = hash;
 }
 
 static void
@@ -242,6 +242,8 @@ gdata_gd_organization_class_init (GDataGDOrganizationClass *klass)
 	                                                      "Location", "A place associated with the organization, e.g. office location.",
 	                                                      GDATA_TYPE_GD_WHERE,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static gint
@@ -254,10 +256,24 @@ compare_with (GDataComparable *self, GDataComparable *other)
 	return 1;
 }
 
+static guint
+hash (GDataComparable *self)
+{
+	GDataGDOrganizationPrivate *priv = ((GDataGDOrganization*) self)->priv;
+	guint value = 0;
+
+	value = _gdata_comparable_hash_string (value, priv->name);
+	value = _gdata_comparable_hash_string (value, priv->title);
+	value = _gdata_comparable_hash_string (value, priv->department);
+
+	return value;
+}
+
 static void
 gdata_gd_organization_comparable_init (GDataComparableIface *iface)
 {
 	iface->compare_with = compare_with;
+	iface->hash = hash;
 }
 
 static void
@@ -36,6 +36,7 @@
 #include "gdata-gd-phone-number.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 #include "gdata-comparable.h"
 
 static void gdata_gd_phone_number_comparable_init (GDataComparableIface *iface);
@@ -166,6 +167,8 @@ gdata_gd_phone_number_class_init (GDataGDPhoneNumberClass *klass)
 	                                                       "Primary?", "Indicates which phone number out of a group is primary.",
 	                                                       FALSE,
 	                                                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static gint
@@ -194,6 +197,8 @@ static void
 gdata_gd_phone_number_comparable_init (GDataComparableIface *iface)
 {
 	iface->compare_with = compare_with;
+
+	/* No hash function: numbers compare equal if either their numbers or their URIs match, which isn't transitive and so can't be hashed */
 }
 
 static void
@@ -37,6 +37,7 @@
 #include "gdata-gd-postal-address.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 #include "gdata-comparable.h"
 
 static void gdata_gd_postal_address_comparable_init (GDataComparableIface *iface);
@@ -48,6 +49,8 @@ static gboolean parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *node,
 static void pre_get_xml (GDataParsable *parsable, GString *xml_string);
 static void get_xml (GDataParsable *parsable, GString *xml_string);
 static void get_namespaces (GDataParsable *parsable, GHashTable *namespaces);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 
 struct _GDataGDPostalAddressPrivate {
 	gchar *formatted_address;
@@ -389,6 +392,8 @@ gdata_gd_postal_address_class_init (GDataGDPostalAddressClass *klass)
 	                                                      "Country code", "The ISO 3166-1 alpha-2 country code for the country.",
 	                                                      NULL,
 	                                                      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static gint
@@ -402,10 +407,25 @@ compare_with (GDataComparable *self, GDataComparable *other)
 	return 1;
 }
 
+static guint
+hash (GDataComparable *self)
+{
+	GDataGDPostalAddressPrivate *priv = ((GDataGDPostalAddress*) self)->priv;
+	guint value = 0;
+
+	value = _gdata_comparable_hash_string (value, priv->street);
+	value = _gdata_comparable_hash_string (value, priv->po_box);
+	value = _gdata_comparable_hash_string (value, priv->city);
+	value = _gdata_comparable_hash_string (value, priv->postcode);
+
+	return value;
+}
+
 static void
 gdata_gd_postal_address_comparable_init (GDataComparableIface *iface)
 {
 	iface->compare_with = compare_with;
+	iface->hash = hash;
 }
 
 static void
@@ -676,6 +696,25 @@ get_namespaces (GDataParsable *parsable, GHashTable *namespaces)
 	g_hash_table_insert (namespaces, (gchar*) "gd", (gchar*) "http://schemas.google.com/g/2005");
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	GDataGDPostalAddressPrivate *priv = GDATA_GD_POSTAL_ADDRESS (parsable)->priv;
+
+	/* The country is read-only, as it's set together with its code using gdata_gd_postal_address_set_country() */
+	gdata_binary_writer_put_string (writer, priv->country);
+	gdata_binary_writer_put_string (writer, priv->country_code);
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	GDataGDPostalAddressPrivate *priv = GDATA_GD_POSTAL_ADDRESS (parsable)->priv;
+
+	priv->country = gdata_binary_reader_dup_string (reader);
+	priv->country_code = gdata_binary_reader_dup_string (reader);
+}
+
 /**
  * gdata_gd_postal_address_new:
  * @relation_type: (allow-none): the relationship between the address and its owner, or %NULL
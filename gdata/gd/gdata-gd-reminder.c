@@ -35,6 +35,7 @@
 #include "gdata-gd-reminder.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 #include "gdata-types.h"
 #include "gdata-comparable.h"
 
@@ -143,6 +144,8 @@ gdata_gd_reminder_class_init (GDataGDReminderClass *klass)
 	                                                   "Relative time", "Time at which the reminder should be issued, in minutes.",
 	                                                   -1, G_MAXINT, -1,
 	                                                   G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static gint
@@ -167,10 +170,26 @@ compare_with (GDataComparable *self, GDataComparable *other)
 		return method_cmp;
 }
 
+static guint
+hash (GDataComparable *self)
+{
+	GDataGDReminder *reminder = (GDataGDReminder*) self;
+	guint value;
+
+	/* compare_with() only compares the low bits of the times, so only hash those */
+	if (gdata_gd_reminder_is_absolute_time (reminder) == TRUE)
+		value = (guint) reminder->priv->absolute_time;
+	else
+		value = (guint) reminder->priv->relative_time * 2 + 1;
+
+	return _gdata_comparable_hash_string (value, reminder->priv->method);
+}
+
 static void
 gdata_gd_reminder_comparable_init (GDataComparableIface *iface)
 {
 	iface->compare_with = compare_with;
+	iface->hash = hash;
 }
 
 static void
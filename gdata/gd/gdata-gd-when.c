@@ -51,13 +51,15 @@ static gboolean post_parse_xml (GDataParsable *parsable, gpointer user_data, GEr
 static void pre_get_xml (GDataParsable *parsable, GString *xml_string);
 static void get_xml (GDataParsable *parsable, GString *xml_string);
 static void get_namespaces (GDataParsable *parsable, GHashTable *namespaces);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 
 struct _GDataGDWhenPrivate {
 	gint64 start_time;
 	gint64 end_time;
 	gboolean is_date;
 	gchar *value_string;
-	GList *reminders;
+	GDataComparableList reminders;
 };
 
 enum {
@@ -156,6 +158,8 @@ gdata_gd_when_class_init (GDataGDWhenClass *klass)
 	                                                      "Value string", "A simple string value used to name this when.",
 	                                                      NULL,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static gint
@@ -175,10 +179,20 @@ compare_with (GDataComparable *self, GDataComparable *other)
 	return CLAMP (start_diff, -1, 1);
 }
 
+static guint
+hash (GDataComparable *self)
+{
+	GDataGDWhenPrivate *priv = ((GDataGDWhen*) self)->priv;
+
+	return (guint) (priv->start_time ^ (priv->start_time >> 32)) * 33 + (guint) (priv->end_time ^ (priv->end_time >> 32)) +
+	       ((priv->is_date == TRUE) ? 1 : 0);
+}
+
 static void
 gdata_gd_when_comparable_init (GDataComparableIface *iface)
 {
 	iface->compare_with = compare_with;
+	iface->hash = hash;
 }
 
 static void
@@ -193,11 +207,7 @@ gdata_gd_when_dispose (GObject *object)
 {
 	GDataGDWhenPrivate *priv = GDATA_GD_WHEN (object)->priv;
 
-	if (priv->reminders != NULL) {
-		g_list_foreach (priv->reminders, (GFunc) g_object_unref, NULL);
-		g_list_free (priv->reminders);
-	}
-	priv->reminders = NULL;
+	_gdata_comparable_list_clear (&priv->reminders);
 
 	/* Chain up to the parent class */
 	G_OBJECT_CLASS (gdata_gd_when_parent_class)->dispose (object);
@@ -334,7 +344,7 @@ post_parse_xml (GDataParsable *parsable, gpointer user_data, GError **error)
 	GDataGDWhenPrivate *priv = GDATA_GD_WHEN (parsable)->priv;
 
 	/* Reverse our lists of stuff */
-	priv->reminders = g_list_reverse (priv->reminders);
+	_gdata_comparable_list_reverse (&priv->reminders);
 
 	return TRUE;
 }
@@ -375,7 +385,7 @@ get_xml (GDataParsable *parsable, GString *xml_string)
 	GList *reminders;
 	GDataGDWhenPrivate *priv = GDATA_GD_WHEN (parsable)->priv;
 
-	for (reminders = priv->reminders; reminders != NULL; reminders = reminders->next)
+	for (reminders = priv->reminders.list; reminders != NULL; reminders = reminders->next)
 		_gdata_parsable_get_xml (GDATA_PARSABLE (reminders->data), xml_string, FALSE);
 }
 
@@ -385,6 +395,19 @@ get_namespaces (GDataParsable *parsable, GHashTable *namespaces)
 	g_hash_table_insert (namespaces, (gchar*) "gd", (gchar*) "http://schemas.google.com/g/2005");
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	gdata_binary_writer_put_parsable_list (writer, GDATA_GD_WHEN (parsable)->priv->reminders.list);
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	_gdata_comparable_list_set (&GDATA_GD_WHEN (parsable)->priv->reminders,
+	                            gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_GD_REMINDER));
+}
+
 /**
  * gdata_gd_when_new:
  * @start_time: when the event starts or (for zero-duration events) when it occurs
@@ -571,7 +594,7 @@ GList *
 gdata_gd_when_get_reminders (GDataGDWhen *self)
 {
 	g_return_val_if_fail (GDATA_IS_GD_WHEN (self), NULL);
-	return self->priv->reminders;
+	return self->priv->reminders.list;
 }
 
 /**
@@ -591,6 +614,5 @@ gdata_gd_when_add_reminder (GDataGDWhen *self, GDataGDReminder *reminder)
 	g_return_if_fail (GDATA_IS_GD_WHEN (self));
 	g_return_if_fail (GDATA_IS_GD_REMINDER (reminder));
 
-	if (g_list_find_custom (self->priv->reminders, reminder, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->reminders = g_list_append (self->priv->reminders, g_object_ref (reminder));
+	_gdata_comparable_list_add (&self->priv->reminders, GDATA_COMPARABLE (reminder), FALSE);
 }
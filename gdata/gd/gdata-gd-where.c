@@ -35,6 +35,7 @@
 #include "gdata-gd-where.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 #include "gdata-comparable.h"
 
 static void gdata_gd_where_comparable_init (GDataComparableIface *iface);
@@ -130,6 +131,8 @@ gdata_gd_where_class_init (GDataGDWhereClass *klass)
 	                                                      "Label", "Specifies a user-readable label to distinguish this location from others.",
 	                                                      NULL,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static gint
@@ -142,10 +145,23 @@ compare_with (GDataComparable *self, GDataComparable *other)
 	return 1;
 }
 
+static guint
+hash (GDataComparable *self)
+{
+	GDataGDWherePrivate *priv = ((GDataGDWhere*) self)->priv;
+	guint value = 0;
+
+	value = _gdata_comparable_hash_string (value, priv->value_string);
+	value = _gdata_comparable_hash_string (value, priv->label);
+
+	return value;
+}
+
 static void
 gdata_gd_where_comparable_init (GDataComparableIface *iface)
 {
 	iface->compare_with = compare_with;
+	iface->hash = hash;
 }
 
 static void
@@ -121,13 +121,13 @@ gdata_access_handler_real_get_rules (GDataAccessHandler *self,
 		/* Definitely JSON. */
 		g_debug("JSON content type detected.");
 		feed = _gdata_feed_new_from_json (GDATA_TYPE_FEED, message->response_body->data, message->response_body->length, GDATA_TYPE_ACCESS_RULE,
-		                                  progress_callback, progress_user_data, error);
+		                                  NULL, progress_callback, progress_user_data, error);
 	} else {
 		/* Potentially XML. Don't bother checking the Content-Type, since the parser
 		 * will fail gracefully if the response body is not valid XML. */
 		g_debug("XML content type detected.");
 		feed = _gdata_feed_new_from_xml (GDATA_TYPE_FEED, message->response_body->data, message->response_body->length, GDATA_TYPE_ACCESS_RULE,
-		                                 progress_callback, progress_user_data, error);
+		                                 NULL, progress_callback, progress_user_data, error);
 	}
 
 	g_object_unref (message);
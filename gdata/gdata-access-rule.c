@@ -96,6 +96,8 @@ static void gdata_access_rule_set_property (GObject *object, guint property_id,
 static void gdata_access_rule_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 static gboolean parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *node, gpointer user_data, GError **error);
 static gboolean post_parse_xml (GDataParsable *parsable, gpointer user_data, GError **error);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 
 struct _GDataAccessRulePrivate {
 	gchar *role;
@@ -215,6 +217,8 @@ gdata_access_rule_class_init (GDataAccessRuleClass *klass)
 	/* Override the ETag property since ETags don't seem to be supported for ACL entries. TODO: Investigate this further (might only be
 	 * unsupported for Google Calendar). */
 	g_object_class_override_property (gobject_class, PROP_ETAG, "etag");
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static void notify_role_cb (GDataAccessRule *self, GParamSpec *pspec, gpointer user_data);
@@ -332,11 +336,13 @@ gdata_access_rule_set_property (GObject *object, guint property_id, const GValue
 		case PROP_SCOPE_TYPE:
 			g_free (self->priv->scope_type);
 			self->priv->scope_type = g_value_dup_string (value);
+			_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (object), "scope-type");
 			g_object_notify (object, "scope-type");
 			break;
 		case PROP_SCOPE_VALUE:
 			g_free (self->priv->scope_value);
 			self->priv->scope_value = g_value_dup_string (value);
+			_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (object), "scope-value");
 			g_object_notify (object, "scope-value");
 			break;
 		case PROP_ETAG:
@@ -500,6 +506,24 @@ get_namespaces (GDataParsable *parsable, GHashTable *namespaces)
 	g_hash_table_insert (namespaces, (gchar*) "gAcl", (gchar*) "http://schemas.google.com/acl/2007");
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	GDataAccessRulePrivate *priv = GDATA_ACCESS_RULE (parsable)->priv;
+
+	gdata_binary_writer_put_int (writer, priv->edited);
+	gdata_binary_writer_put_string (writer, priv->key);
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	GDataAccessRulePrivate *priv = GDATA_ACCESS_RULE (parsable)->priv;
+
+	priv->edited = gdata_binary_reader_get_int (reader);
+	priv->key = gdata_binary_reader_dup_string (reader);
+}
+
 /**
  * gdata_access_rule_new:
  * @id: the access rule's ID, or %NULL
@@ -535,6 +559,7 @@ gdata_access_rule_set_role (GDataAccessRule *self, const gchar *role)
 
 	g_free (self->priv->role);
 	self->priv->role = g_strdup (role);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "role");
 	g_object_notify (G_OBJECT (self), "role");
 }
 
@@ -587,7 +612,9 @@ gdata_access_rule_set_scope (GDataAccessRule *self, const gchar *type, const gch
 	self->priv->scope_value = g_strdup (value);
 
 	g_object_freeze_notify (G_OBJECT (self));
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "scope-type");
 	g_object_notify (G_OBJECT (self), "scope-type");
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "scope-value");
 	g_object_notify (G_OBJECT (self), "scope-value");
 	g_object_thaw_notify (G_OBJECT (self));
 }
@@ -38,6 +38,14 @@
  * #GDataService subclass in question's operations for details of which require authorization), #GDataBatchOperation:authorization-domain can be set
  * to %NULL to save the overhead of sending authorization data to the online service.
  *
+ * Batch operations on entries which use JSON (such as those from #GDataTasksService and #GDataCalendarService) are sent as a single
+ * <code class="literal">multipart/mixed</code> request, containing one HTTP request per operation, to the batch endpoint of the API which
+ * #GDataBatchOperation:feed-uri belongs to. In this case, #GDataBatchOperation:feed-uri is the URI of the collection which entries are inserted
+ * into (for example, the URI of a task list's tasks), and the ID passed to gdata_batch_operation_add_query() must be the URI of the entry to query.
+ * At most 100 operations are sent in each request; larger batch operations are split across several requests. The exception is when
+ * #GDataBatchOperation:feed-uri is itself a GData batch feed (its path ends in <code class="literal">/batch</code>, as with
+ * #GDataDocumentsService), in which case an Atom batch feed is sent as for XML entries. A single batch operation can't mix JSON and XML entries.
+ *
  * <example>
  * 	<title>Running a Synchronous Operation</title>
  * 	<programlisting>
@@ -572,6 +580,400 @@ gdata_batch_operation_add_deletion (GDataBatchOperation *self, GDataEntry *entry
 	return add_operation (self, GDATA_BATCH_OPERATION_DELETION, entry, callback, user_data);
 }
 
+/* The maximum number of parts Google's APIs accept in a single multipart batch request */
+#define MAX_JSON_BATCH_SIZE 100
+
+static gboolean
+operation_is_json (BatchOperation *op)
+{
+	GDataParsableClass *klass;
+	gboolean is_json;
+
+	klass = g_type_class_ref ((op->type == GDATA_BATCH_OPERATION_QUERY) ? op->entry_type : G_OBJECT_TYPE (op->entry));
+	g_assert (klass->get_content_type != NULL);
+	is_json = (g_strcmp0 (klass->get_content_type (), "application/json") == 0);
+	g_type_class_unref (klass);
+
+	return is_json;
+}
+
+static GDataOperationType
+operation_type_to_service_operation_type (GDataBatchOperationType type)
+{
+	switch (type) {
+		case GDATA_BATCH_OPERATION_QUERY:
+			return GDATA_OPERATION_QUERY;
+		case GDATA_BATCH_OPERATION_INSERTION:
+			return GDATA_OPERATION_INSERTION;
+		case GDATA_BATCH_OPERATION_UPDATE:
+			return GDATA_OPERATION_UPDATE;
+		case GDATA_BATCH_OPERATION_DELETION:
+			return GDATA_OPERATION_DELETION;
+		default:
+			g_assert_not_reached ();
+	}
+}
+
+static gint
+compare_operations (BatchOperation *a, BatchOperation *b)
+{
+	return (a->id < b->id) ? -1 : (a->id > b->id) ? 1 : 0;
+}
+
+/* Whether @feed_uri is a GData batch feed, which takes an Atom feed of operations even if the entries themselves are JSON-based (as with
+ * #GDataDocumentsEntry). JSON-based APIs without such a feed use multipart requests to a separate batch endpoint instead. */
+static gboolean
+is_atom_batch_feed (const gchar *feed_uri)
+{
+	SoupURI *uri;
+	gboolean is_batch_feed;
+
+	uri = soup_uri_new (feed_uri);
+	if (uri == NULL)
+		return FALSE;
+
+	is_batch_feed = g_str_has_suffix (soup_uri_get_path (uri), "/batch");
+	soup_uri_free (uri);
+
+	return is_batch_feed;
+}
+
+/* Build the URI of the batch endpoint for the API @feed_uri belongs to. Google's APIs have one per API version, so
+ * https://www.googleapis.com/tasks/v1/lists/abc/tasks becomes https://www.googleapis.com/batch/tasks/v1. */
+static gchar *
+build_json_batch_uri (const gchar *feed_uri)
+{
+	SoupURI *uri;
+	gchar **segments, *batch_path, *batch_uri;
+
+	uri = soup_uri_new (feed_uri);
+	g_assert (uri != NULL);
+
+	/* The path starts with a slash, so the first segment is empty */
+	segments = g_strsplit (soup_uri_get_path (uri), "/", 4);
+	if (g_strv_length (segments) >= 3 && *segments[1] != '\0' && *segments[2] != '\0')
+		batch_path = g_strdup_printf ("/batch/%s/%s", segments[1], segments[2]);
+	else
+		batch_path = g_strdup ("/batch");
+	g_strfreev (segments);
+
+	soup_uri_set_path (uri, batch_path);
+	soup_uri_set_query (uri, NULL);
+	g_free (batch_path);
+
+	batch_uri = soup_uri_to_string (uri, FALSE);
+	soup_uri_free (uri);
+
+	return batch_uri;
+}
+
+/* Append the HTTP request for @op to @multipart as an application/http part, returning %FALSE (and setting @error) if the request can't be
+ * built. */
+static gboolean
+append_json_part (GDataBatchOperation *self, SoupMultipart *multipart, BatchOperation *op, GError **error)
+{
+	const gchar *method, *etag = NULL;
+	gchar *uri_string, *body = NULL, *content_id;
+	SoupURI *uri;
+	GString *request;
+	SoupMessageHeaders *part_headers;
+	SoupBuffer *part_body;
+	GDataLink *_link;
+
+	switch (op->type) {
+		case GDATA_BATCH_OPERATION_QUERY: {
+			GDataEntryClass *klass = g_type_class_ref (op->entry_type);
+			g_assert (klass->get_entry_uri != NULL);
+			method = SOUP_METHOD_GET;
+			uri_string = klass->get_entry_uri (op->query_id);
+			g_type_class_unref (klass);
+			break;
+		}
+		case GDATA_BATCH_OPERATION_INSERTION:
+			method = SOUP_METHOD_POST;
+			uri_string = g_strdup (self->priv->feed_uri);
+			body = gdata_parsable_get_json (GDATA_PARSABLE (op->entry));
+			break;
+		case GDATA_BATCH_OPERATION_UPDATE:
+		case GDATA_BATCH_OPERATION_DELETION:
+			_link = gdata_entry_look_up_link (op->entry, GDATA_LINK_SELF);
+			g_assert (_link != NULL);
+			uri_string = g_strdup (gdata_link_get_uri (_link));
+			etag = gdata_entry_get_etag (op->entry);
+
+			if (op->type == GDATA_BATCH_OPERATION_UPDATE) {
+				method = SOUP_METHOD_PUT;
+				body = gdata_parsable_get_json (GDATA_PARSABLE (op->entry));
+			} else {
+				method = SOUP_METHOD_DELETE;
+			}
+			break;
+		default:
+			g_assert_not_reached ();
+	}
+
+	uri = soup_uri_new (uri_string);
+
+	if (uri == NULL) {
+		g_set_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_BAD_QUERY_PARAMETER,
+		             /* Translators: the parameter is the URI of an entry in a batch operation. */
+		             _("Invalid entry URI in batch operation: %s"), uri_string);
+		g_free (uri_string);
+		g_free (body);
+		return FALSE;
+	}
+
+	g_free (uri_string);
+
+	/* Build the HTTP request; the request line only contains the path, as the host is that of the batch endpoint */
+	uri_string = soup_uri_to_string (uri, TRUE);
+	soup_uri_free (uri);
+
+	request = g_string_new (NULL);
+	g_string_append_printf (request, "%s %s HTTP/1.1\r\n", method, uri_string);
+	g_free (uri_string);
+
+	if (etag != NULL)
+		g_string_append_printf (request, "If-Match: %s\r\n", etag);
+
+	if (body != NULL) {
+		g_string_append_printf (request, "Content-Type: application/json\r\n\r\n%s", body);
+		g_free (body);
+	} else {
+		g_string_append (request, "\r\n");
+	}
+
+	/* Add it as a part, identified by the operation's ID */
+	part_headers = soup_message_headers_new (SOUP_MESSAGE_HEADERS_MULTIPART);
+	soup_message_headers_replace (part_headers, "Content-Type", "application/http");
+	content_id = g_strdup_printf ("<item%u>", op->id);
+	soup_message_headers_replace (part_headers, "Content-ID", content_id);
+	g_free (content_id);
+
+	part_body = soup_buffer_new (SOUP_MEMORY_TAKE, request->str, request->len);
+	g_string_free (request, FALSE);
+
+	soup_multipart_append_part (multipart, part_headers, part_body);
+
+	soup_buffer_free (part_body);
+	soup_message_headers_free (part_headers);
+
+	return TRUE;
+}
+
+/* Parse one application/http part of a multipart batch response and run the callback for the operation it belongs to, if it's still
+ * @pending. */
+static void
+handle_json_part (GDataBatchOperation *self, SoupMessageHeaders *part_headers, SoupBuffer *part_body, GHashTable *pending)
+{
+	const gchar *content_id, *header_end, *body;
+	gchar *reason_phrase = NULL;
+	guint id, status_code;
+	gsize header_length, body_length;
+	SoupMessageHeaders *response_headers;
+	BatchOperation *op;
+	GDataEntry *entry = NULL;
+	GError *child_error = NULL;
+
+	/* Response parts are identified by the ID of the request part, prefixed with "response-" */
+	content_id = soup_message_headers_get_one (part_headers, "Content-ID");
+	if (content_id == NULL)
+		return;
+
+	if (*content_id == '<')
+		content_id++;
+	if (g_str_has_prefix (content_id, "response-") == TRUE)
+		content_id += strlen ("response-");
+	if (g_str_has_prefix (content_id, "item") == FALSE)
+		return;
+
+	id = g_ascii_strtoull (content_id + strlen ("item"), NULL, 10);
+	op = g_hash_table_lookup (pending, GUINT_TO_POINTER (id));
+	if (op == NULL)
+		return;
+
+	g_hash_table_remove (pending, GUINT_TO_POINTER (id));
+
+	/* Split the embedded HTTP response into its status line and headers, and its body */
+	header_end = g_strstr_len (part_body->data, part_body->length, "\r\n\r\n");
+	if (header_end != NULL) {
+		header_length = header_end - part_body->data + 4;
+	} else {
+		header_end = g_strstr_len (part_body->data, part_body->length, "\n\n");
+		header_length = (header_end != NULL) ? (gsize) (header_end - part_body->data + 2) : part_body->length;
+	}
+
+	body = part_body->data + header_length;
+	body_length = part_body->length - header_length;
+
+	response_headers = soup_message_headers_new (SOUP_MESSAGE_HEADERS_RESPONSE);
+
+	if (soup_headers_parse_response (part_body->data, header_length, response_headers, NULL, &status_code, &reason_phrase) == FALSE) {
+		g_set_error_literal (&child_error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR,
+		                     _("The batch response contained an invalid part."));
+	} else if (SOUP_STATUS_IS_SUCCESSFUL (status_code) == FALSE) {
+		/* Parse the error (it's returned in a service-specific format). The part body isn't nul-terminated, but error parsers may
+		 * include it in the error message. */
+		GDataService *service = self->priv->service;
+		GDataServiceClass *klass = GDATA_SERVICE_GET_CLASS (service);
+		gchar *error_body = g_strndup (body, body_length);
+
+		g_assert (klass->parse_error_response != NULL);
+		klass->parse_error_response (service, operation_type_to_service_operation_type (op->type), status_code, reason_phrase, error_body,
+		                             body_length, &child_error);
+		g_free (error_body);
+	} else if (op->type != GDATA_BATCH_OPERATION_DELETION) {
+		GType entry_type = (op->type == GDATA_BATCH_OPERATION_QUERY) ? op->entry_type : G_OBJECT_TYPE (op->entry);
+		entry = GDATA_ENTRY (gdata_parsable_new_from_json (entry_type, body, body_length, &child_error));
+	}
+
+	g_free (reason_phrase);
+	soup_message_headers_free (response_headers);
+
+	/* Run the operation's callback. This takes ownership of @child_error. */
+	_gdata_batch_operation_run_callback (self, op, entry, child_error);
+
+	if (entry != NULL)
+		g_object_unref (entry);
+}
+
+/* Send the operations from @first up to (but not including) @last as a single multipart batch request. If the request as a whole fails, all
+ * the operations' callbacks are run with the error, and it's also returned in @error. */
+static gboolean
+run_json_chunk (GDataBatchOperation *self, const gchar *batch_uri, GList *first, GList *last, GCancellable *cancellable, GError **error)
+{
+	GDataBatchOperationPrivate *priv = self->priv;
+	SoupMultipart *multipart;
+	SoupMessage *message;
+	GHashTable *pending;
+	GHashTableIter iter;
+	BatchOperation *op;
+	GList *l;
+	guint status, i;
+	GError *child_error = NULL;
+
+	/* Build the request, one part per operation */
+	pending = g_hash_table_new (g_direct_hash, g_direct_equal);
+	multipart = soup_multipart_new ("multipart/mixed");
+
+	for (l = first; l != last; l = l->next) {
+		op = l->data;
+
+		if (append_json_part (self, multipart, op, &child_error) == TRUE)
+			g_hash_table_insert (pending, GUINT_TO_POINTER (op->id), op);
+		else
+			_gdata_batch_operation_run_callback (self, op, NULL, child_error);
+
+		child_error = NULL;
+	}
+
+	if (g_hash_table_size (pending) == 0) {
+		soup_multipart_free (multipart);
+		g_hash_table_destroy (pending);
+		return TRUE;
+	}
+
+	message = _gdata_service_build_message (priv->service, priv->authorization_domain, SOUP_METHOD_POST, batch_uri, NULL, TRUE);
+	_gdata_service_set_message_operation_type (message, GDATA_OPERATION_BATCH);
+	soup_multipart_to_message (multipart, message->request_headers, message->request_body);
+	soup_multipart_free (multipart);
+
+	/* Send the message */
+	status = _gdata_service_send_message (priv->service, message, cancellable, &child_error);
+
+	if (status != SOUP_STATUS_OK) {
+		/* Iff status is SOUP_STATUS_NONE or SOUP_STATUS_CANCELLED, child_error has already been set */
+		if (status != SOUP_STATUS_NONE && status != SOUP_STATUS_CANCELLED) {
+			/* Error */
+			GDataServiceClass *klass = GDATA_SERVICE_GET_CLASS (priv->service);
+			g_assert (klass->parse_error_response != NULL);
+			klass->parse_error_response (priv->service, GDATA_OPERATION_BATCH, status, message->reason_phrase, message->response_body->data,
+			                             message->response_body->length, &child_error);
+		}
+
+		g_object_unref (message);
+		goto error;
+	}
+
+	/* Split the response up, and handle each part in turn */
+	multipart = soup_multipart_new_from_message (message->response_headers, message->response_body);
+	g_object_unref (message);
+
+	if (multipart == NULL) {
+		g_set_error_literal (&child_error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR,
+		                     _("The batch response was not a multipart message."));
+		goto error;
+	}
+
+	for (i = 0; i < (guint) soup_multipart_get_length (multipart); i++) {
+		SoupMessageHeaders *part_headers;
+		SoupBuffer *part_body;
+
+		if (soup_multipart_get_part (multipart, i, &part_headers, &part_body) == TRUE)
+			handle_json_part (self, part_headers, part_body, pending);
+	}
+
+	soup_multipart_free (multipart);
+
+	/* Any operations the server didn't respond to have failed */
+	g_hash_table_iter_init (&iter, pending);
+	while (g_hash_table_iter_next (&iter, NULL, (gpointer*) &op) == TRUE) {
+		g_set_error_literal (&child_error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR,
+		                     _("The batch response did not contain a response for every operation."));
+		_gdata_batch_operation_run_callback (self, op, NULL, child_error);
+		child_error = NULL;
+	}
+
+	g_hash_table_destroy (pending);
+
+	return TRUE;
+
+error:
+	g_hash_table_iter_init (&iter, pending);
+	while (g_hash_table_iter_next (&iter, NULL, (gpointer*) &op) == TRUE)
+		_gdata_batch_operation_run_callback (self, op, NULL, g_error_copy (child_error));
+
+	g_hash_table_destroy (pending);
+	g_propagate_error (error, child_error);
+
+	return FALSE;
+}
+
+/* Run a batch operation on JSON entries as a series of multipart/mixed requests. */
+static gboolean
+run_json (GDataBatchOperation *self, GCancellable *cancellable, GError **error)
+{
+	GList *operations, *chunk, *next_chunk, *l;
+	gchar *batch_uri;
+	GError *child_error = NULL;
+
+	/* Send the operations in the order they were added */
+	operations = g_list_sort (g_hash_table_get_values (self->priv->operations), (GCompareFunc) compare_operations);
+	batch_uri = build_json_batch_uri (self->priv->feed_uri);
+
+	for (chunk = operations; chunk != NULL; chunk = next_chunk) {
+		next_chunk = g_list_nth (chunk, MAX_JSON_BATCH_SIZE);
+
+		if (child_error == NULL) {
+			run_json_chunk (self, batch_uri, chunk, next_chunk, cancellable, &child_error);
+		} else {
+			/* An earlier request failed as a whole, so don't bother sending the rest */
+			for (l = chunk; l != next_chunk; l = l->next)
+				_gdata_batch_operation_run_callback (self, l->data, NULL, g_error_copy (child_error));
+		}
+	}
+
+	g_free (batch_uri);
+	g_list_free (operations);
+
+	if (child_error != NULL) {
+		g_propagate_error (error, child_error);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
 /**
  * gdata_batch_operation_run:
  * @self: a #GDataBatchOperation
@@ -608,6 +1010,7 @@ gdata_batch_operation_run (GDataBatchOperation *self, GCancellable *cancellable,
 	gpointer op_id;
 	BatchOperation *op;
 	GError *child_error = NULL;
+	gboolean is_json = FALSE, is_first = TRUE;
 
 	g_return_val_if_fail (GDATA_IS_BATCH_OPERATION (self), FALSE);
 	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), FALSE);
@@ -636,9 +1039,28 @@ gdata_batch_operation_run (GDataBatchOperation *self, GCancellable *cancellable,
 			               "this service."));
 			return FALSE;
 		}
+
+		/* Check which format to use */
+		if (is_first == TRUE) {
+			is_json = operation_is_json (op);
+			is_first = FALSE;
+		} else if (operation_is_json (op) != is_json) {
+			g_set_error_literal (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_WITH_BATCH_OPERATION,
+			                     _("Batch operations cannot mix JSON and XML entries."));
+			return FALSE;
+		}
+	}
+
+	/* JSON-based services use multipart batch requests, unless they still provide a batch feed */
+	if (is_json == TRUE && is_atom_batch_feed (priv->feed_uri) == FALSE) {
+		/* Ensure that this GDataBatchOperation can't be run again */
+		priv->has_run = TRUE;
+
+		return run_json (self, cancellable, error);
 	}
 
 	message = _gdata_service_build_message (priv->service, priv->authorization_domain, SOUP_METHOD_POST, priv->feed_uri, NULL, TRUE);
+	_gdata_service_set_message_operation_type (message, GDATA_OPERATION_BATCH);
 
 	/* Build the request */
 	g_get_current_time (&updated);
@@ -0,0 +1,887 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ * Copyright (C) Philip Withnall 2017 <philip@tecnocode.co.uk>
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SECTION:gdata-binary
+ * @short_description: GData binary serialisation helpers
+ * @stability: Unstable
+ * @include: gdata/gdata-binary.h
+ *
+ * #GDataBinaryWriter and #GDataBinaryReader implement the compact binary format used by gdata_parsable_get_binary() and
+ * gdata_parsable_new_from_binary(). The format starts with a four-byte header (the magic bytes <literal>GDB</literal> followed by a version
+ * byte), followed by the root object.
+ *
+ * Integers are stored as variable-length little-endian base-128 numbers (with signed integers zig-zag encoded first), so small values take a
+ * single byte. Doubles are stored as eight little-endian bytes.
+ *
+ * Strings are interned: the first time a string is written, it's stored in full (prefixed by its length, and followed by a nul byte so that
+ * the reader can return it without copying); subsequent occurrences of the same string are stored as a reference to the first. Property
+ * names, type names and the many repeated values in a typical collection (such as relation types) therefore cost a byte or two each.
+ *
+ * Errors are sticky: once a writer or reader has failed, all further operations on it are no-ops (and reads return zero or %NULL), and the
+ * error is returned by gdata_binary_writer_finish() or gdata_binary_reader_finish(). This keeps the per-class serialisation functions short.
+ */
+
+#include <config.h>
+#include <glib.h>
+#include <glib/gi18n-lib.h>
+#include <gio/gio.h>
+#include <string.h>
+
+#include "gdata-binary.h"
+#include "gdata-private.h"
+
+#define MAGIC "GDB"
+#define MAGIC_LENGTH 3
+#define FORMAT_VERSION 1
+#define HEADER_LENGTH (MAGIC_LENGTH + 1)
+
+/* Maximum nesting depth of objects, to stop corrupt data from exhausting the stack. */
+#define MAX_DEPTH 64
+
+/* String references: 0 is NULL, 1 introduces a new string, and n ≥ 2 refers to the (n - 2)th string in the table. */
+#define STRING_NULL 0
+#define STRING_NEW 1
+#define STRING_FIRST_REFERENCE 2
+
+struct _GDataBinaryWriter {
+	GByteArray *data;
+	GHashTable/*<owned gchar*, guint>*/ *strings; /* string → its reference */
+	guint next_string_reference;
+	GError *error;
+};
+
+struct _GDataBinaryReader {
+	GBytes *bytes; /* owned */
+	const guint8 *data;
+	gsize length;
+	gsize offset;
+	GPtrArray/*<unowned gchar*>*/ *strings; /* pointers into @data */
+	guint depth;
+	GError *error;
+};
+
+/**
+ * gdata_binary_writer_new:
+ *
+ * Creates a new #GDataBinaryWriter with the format header already written.
+ *
+ * Return value: a new #GDataBinaryWriter; finish with gdata_binary_writer_finish()
+ *
+ * Since: 0.17.9
+ */
+GDataBinaryWriter *
+gdata_binary_writer_new (void)
+{
+	GDataBinaryWriter *self = g_slice_new0 (GDataBinaryWriter);
+	guint8 version = FORMAT_VERSION;
+
+	self->data = g_byte_array_sized_new (256);
+	self->strings = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+	self->next_string_reference = STRING_FIRST_REFERENCE;
+
+	g_byte_array_append (self->data, (const guint8*) MAGIC, MAGIC_LENGTH);
+	g_byte_array_append (self->data, &version, 1);
+
+	return self;
+}
+
+/**
+ * gdata_binary_writer_finish:
+ * @self: a #GDataBinaryWriter
+ * @error: a #GError, or %NULL
+ *
+ * Frees @self, returning the data written to it. If any of the writes failed, the first error is returned instead.
+ *
+ * Return value: (transfer full): the serialised data, or %NULL; unref with g_bytes_unref()
+ *
+ * Since: 0.17.9
+ */
+GBytes *
+gdata_binary_writer_finish (GDataBinaryWriter *self, GError **error)
+{
+	GBytes *bytes = NULL;
+
+	g_return_val_if_fail (self != NULL, NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	if (self->error != NULL) {
+		g_propagate_error (error, self->error);
+		g_byte_array_unref (self->data);
+	} else {
+		bytes = g_byte_array_free_to_bytes (self->data);
+	}
+
+	g_hash_table_destroy (self->strings);
+	g_slice_free (GDataBinaryWriter, self);
+
+	return bytes;
+}
+
+/**
+ * gdata_binary_writer_set_error:
+ * @self: a #GDataBinaryWriter
+ * @error: (transfer full): the error to set
+ *
+ * Marks @self as having failed with @error. If it has already failed, @error is freed and the original error is kept.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_binary_writer_set_error (GDataBinaryWriter *self, GError *error)
+{
+	g_return_if_fail (self != NULL);
+	g_return_if_fail (error != NULL);
+
+	if (self->error == NULL)
+		self->error = error;
+	else
+		g_error_free (error);
+}
+
+/**
+ * gdata_binary_writer_put_uint:
+ * @self: a #GDataBinaryWriter
+ * @value: the value to write
+ *
+ * Writes an unsigned integer to @self.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_binary_writer_put_uint (GDataBinaryWriter *self, guint64 value)
+{
+	guint8 buffer[10];
+	guint length = 0;
+
+	g_return_if_fail (self != NULL);
+
+	if (self->error != NULL)
+		return;
+
+	do {
+		buffer[length] = value & 0x7f;
+		value >>= 7;
+
+		if (value != 0)
+			buffer[length] |= 0x80;
+
+		length++;
+	} while (value != 0);
+
+	g_byte_array_append (self->data, buffer, length);
+}
+
+/**
+ * gdata_binary_writer_put_int:
+ * @self: a #GDataBinaryWriter
+ * @value: the value to write
+ *
+ * Writes a signed integer to @self. Values close to zero (including small negative numbers, such as the -1 used for unset times) are
+ * written as a single byte.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_binary_writer_put_int (GDataBinaryWriter *self, gint64 value)
+{
+	/* Zig-zag encode: 0 → 0, -1 → 1, 1 → 2, -2 → 3, … */
+	gdata_binary_writer_put_uint (self, ((guint64) value << 1) ^ (guint64) (value >> 63));
+}
+
+/**
+ * gdata_binary_writer_put_boolean:
+ * @self: a #GDataBinaryWriter
+ * @value: the value to write
+ *
+ * Writes a boolean to @self.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_binary_writer_put_boolean (GDataBinaryWriter *self, gboolean value)
+{
+	guint8 byte = (value == FALSE) ? 0 : 1;
+
+	g_return_if_fail (self != NULL);
+
+	if (self->error == NULL)
+		g_byte_array_append (self->data, &byte, 1);
+}
+
+/**
+ * gdata_binary_writer_put_double:
+ * @self: a #GDataBinaryWriter
+ * @value: the value to write
+ *
+ * Writes a double to @self.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_binary_writer_put_double (GDataBinaryWriter *self, gdouble value)
+{
+	union {
+		gdouble d;
+		guint64 u;
+	} bits;
+
+	g_return_if_fail (self != NULL);
+
+	if (self->error != NULL)
+		return;
+
+	bits.d = value;
+	bits.u = GUINT64_TO_LE (bits.u);
+	g_byte_array_append (self->data, (const guint8*) &(bits.u), sizeof (bits.u));
+}
+
+/**
+ * gdata_binary_writer_put_string:
+ * @self: a #GDataBinaryWriter
+ * @value: (allow-none): the string to write, or %NULL
+ *
+ * Writes a nullable string to @self, interning it so that later occurrences of the same string are written as references to this one.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_binary_writer_put_string (GDataBinaryWriter *self, const gchar *value)
+{
+	guint reference;
+	gsize length;
+
+	g_return_if_fail (self != NULL);
+
+	if (self->error != NULL)
+		return;
+
+	if (value == NULL) {
+		gdata_binary_writer_put_uint (self, STRING_NULL);
+		return;
+	}
+
+	reference = GPOINTER_TO_UINT (g_hash_table_lookup (self->strings, value));
+	if (reference != 0) {
+		gdata_binary_writer_put_uint (self, reference);
+		return;
+	}
+
+	g_hash_table_insert (self->strings, g_strdup (value), GUINT_TO_POINTER (self->next_string_reference++));
+
+	/* Include the nul terminator, so the reader can point straight into the data. */
+	length = strlen (value);
+	gdata_binary_writer_put_uint (self, STRING_NEW);
+	gdata_binary_writer_put_uint (self, length);
+	g_byte_array_append (self->data, (const guint8*) value, length + 1);
+}
+
+/**
+ * gdata_binary_writer_put_parsable:
+ * @self: a #GDataBinaryWriter
+ * @value: (allow-none): the #GDataParsable to write, or %NULL
+ *
+ * Writes a nullable #GDataParsable to @self, including its type. If @value's type (or the type of one of its child objects) can't be
+ * serialised, @self fails with %G_IO_ERROR_NOT_SUPPORTED.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_binary_writer_put_parsable (GDataBinaryWriter *self, GDataParsable *value)
+{
+	g_return_if_fail (self != NULL);
+	g_return_if_fail (value == NULL || GDATA_IS_PARSABLE (value));
+
+	if (value == NULL)
+		gdata_binary_writer_put_string (self, NULL);
+	else
+		_gdata_parsable_write_binary (value, self);
+}
+
+/**
+ * gdata_binary_writer_put_parsable_list:
+ * @self: a #GDataBinaryWriter
+ * @list: (element-type GDataParsable): a list of #GDataParsable<!-- -->s
+ *
+ * Writes a list of #GDataParsable<!-- -->s to @self, preserving their order.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_binary_writer_put_parsable_list (GDataBinaryWriter *self, GList *list)
+{
+	GList *i;
+
+	g_return_if_fail (self != NULL);
+
+	gdata_binary_writer_put_uint (self, g_list_length (list));
+
+	for (i = list; i != NULL; i = i->next)
+		gdata_binary_writer_put_parsable (self, GDATA_PARSABLE (i->data));
+}
+
+/**
+ * gdata_binary_writer_put_string_list:
+ * @self: a #GDataBinaryWriter
+ * @list: (element-type utf8): a list of strings
+ *
+ * Writes a list of strings to @self, preserving their order.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_binary_writer_put_string_list (GDataBinaryWriter *self, GList *list)
+{
+	GList *i;
+
+	g_return_if_fail (self != NULL);
+
+	gdata_binary_writer_put_uint (self, g_list_length (list));
+
+	for (i = list; i != NULL; i = i->next)
+		gdata_binary_writer_put_string (self, i->data);
+}
+
+/**
+ * gdata_binary_writer_put_string_hash:
+ * @self: a #GDataBinaryWriter
+ * @table: (allow-none) (element-type utf8 utf8): a hash table mapping strings to nullable strings, or %NULL
+ *
+ * Writes the entries of a hash table of strings to @self. A %NULL @table is written the same as an empty one.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_binary_writer_put_string_hash (GDataBinaryWriter *self, GHashTable *table)
+{
+	GHashTableIter iter;
+	const gchar *key, *value;
+
+	g_return_if_fail (self != NULL);
+
+	if (table == NULL) {
+		gdata_binary_writer_put_uint (self, 0);
+		return;
+	}
+
+	gdata_binary_writer_put_uint (self, g_hash_table_size (table));
+
+	g_hash_table_iter_init (&iter, table);
+	while (g_hash_table_iter_next (&iter, (gpointer*) &key, (gpointer*) &value) == TRUE) {
+		gdata_binary_writer_put_string (self, key);
+		gdata_binary_writer_put_string (self, value);
+	}
+}
+
+static void
+set_parse_error (GDataBinaryReader *self, const gchar *message)
+{
+	gdata_binary_reader_set_error (self, g_error_new (GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_PARSING_STRING,
+	                                                  /* Translators: the parameter is an error message */
+	                                                  _("Error parsing binary data: %s"), message));
+}
+
+/**
+ * gdata_binary_reader_new:
+ * @bytes: the data to read
+ *
+ * Creates a new #GDataBinaryReader for @bytes, and checks the format header. If the header is invalid, the reader fails immediately.
+ *
+ * Return value: a new #GDataBinaryReader; finish with gdata_binary_reader_finish()
+ *
+ * Since: 0.17.9
+ */
+GDataBinaryReader *
+gdata_binary_reader_new (GBytes *bytes)
+{
+	GDataBinaryReader *self;
+
+	g_return_val_if_fail (bytes != NULL, NULL);
+
+	self = g_slice_new0 (GDataBinaryReader);
+	self->bytes = g_bytes_ref (bytes);
+	self->data = g_bytes_get_data (bytes, &(self->length));
+	self->strings = g_ptr_array_new ();
+
+	if (self->length == 0) {
+		gdata_binary_reader_set_error (self, g_error_new (GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_EMPTY_DOCUMENT,
+		                                                  _("Error parsing binary data: %s"),
+		                                                  /* Translators: this is a dummy error message to be substituted into
+		                                                   * "Error parsing binary data: %s". */
+		                                                  _("Empty document.")));
+	} else if (self->length < HEADER_LENGTH || memcmp (self->data, MAGIC, MAGIC_LENGTH) != 0) {
+		set_parse_error (self, _("Unrecognized data format."));
+	} else if (self->data[MAGIC_LENGTH] != FORMAT_VERSION) {
+		gchar *message;
+
+		/* Translators: the parameter is a version number. */
+		message = g_strdup_printf (_("Unsupported format version %u."), (guint) self->data[MAGIC_LENGTH]);
+		set_parse_error (self, message);
+		g_free (message);
+	} else {
+		self->offset = HEADER_LENGTH;
+	}
+
+	return self;
+}
+
+/**
+ * gdata_binary_reader_finish:
+ * @self: a #GDataBinaryReader
+ * @error: a #GError, or %NULL
+ *
+ * Frees @self, checking that all the data was read without error. If any of the reads failed, the first error is returned; otherwise an error
+ * is returned if there is unread data left over.
+ *
+ * Return value: %TRUE if all the data was read successfully, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_binary_reader_finish (GDataBinaryReader *self, GError **error)
+{
+	gboolean success;
+
+	g_return_val_if_fail (self != NULL, FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	if (self->error == NULL && self->offset != self->length)
+		set_parse_error (self, _("Unexpected data after the end of the document."));
+
+	success = (self->error == NULL) ? TRUE : FALSE;
+	if (self->error != NULL)
+		g_propagate_error (error, self->error);
+
+	g_ptr_array_unref (self->strings);
+	g_bytes_unref (self->bytes);
+	g_slice_free (GDataBinaryReader, self);
+
+	return success;
+}
+
+/**
+ * gdata_binary_reader_set_error:
+ * @self: a #GDataBinaryReader
+ * @error: (transfer full): the error to set
+ *
+ * Marks @self as having failed with @error. If it has already failed, @error is freed and the original error is kept.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_binary_reader_set_error (GDataBinaryReader *self, GError *error)
+{
+	g_return_if_fail (self != NULL);
+	g_return_if_fail (error != NULL);
+
+	if (self->error == NULL)
+		self->error = error;
+	else
+		g_error_free (error);
+}
+
+/**
+ * gdata_binary_reader_failed:
+ * @self: a #GDataBinaryReader
+ *
+ * Returns whether any of the reads from @self have failed.
+ *
+ * Return value: %TRUE if @self has an error set, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_binary_reader_failed (GDataBinaryReader *self)
+{
+	g_return_val_if_fail (self != NULL, TRUE);
+
+	return (self->error != NULL) ? TRUE : FALSE;
+}
+
+/**
+ * gdata_binary_reader_enter:
+ * @self: a #GDataBinaryReader
+ *
+ * Notes that an object is being read, so that corrupt data can't nest objects without limit. Each successful call must be balanced by a call
+ * to gdata_binary_reader_leave().
+ *
+ * Return value: %TRUE if the object can be read, %FALSE if @self has failed (possibly because the nesting is too deep)
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_binary_reader_enter (GDataBinaryReader *self)
+{
+	g_return_val_if_fail (self != NULL, FALSE);
+
+	if (self->error != NULL)
+		return FALSE;
+
+	if (self->depth >= MAX_DEPTH) {
+		set_parse_error (self, _("Objects are nested too deeply."));
+		return FALSE;
+	}
+
+	self->depth++;
+
+	return TRUE;
+}
+
+/**
+ * gdata_binary_reader_leave:
+ * @self: a #GDataBinaryReader
+ *
+ * Notes that an object entered with gdata_binary_reader_enter() has been read.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_binary_reader_leave (GDataBinaryReader *self)
+{
+	g_return_if_fail (self != NULL);
+	g_return_if_fail (self->depth > 0);
+
+	self->depth--;
+}
+
+/**
+ * gdata_binary_reader_get_uint:
+ * @self: a #GDataBinaryReader
+ *
+ * Reads an unsigned integer written by gdata_binary_writer_put_uint().
+ *
+ * Return value: the integer, or 0 on error
+ *
+ * Since: 0.17.9
+ */
+guint64
+gdata_binary_reader_get_uint (GDataBinaryReader *self)
+{
+	guint64 value = 0;
+	guint shift;
+
+	g_return_val_if_fail (self != NULL, 0);
+
+	if (self->error != NULL)
+		return 0;
+
+	for (shift = 0; shift < 64; shift += 7) {
+		guint8 byte;
+
+		if (self->offset >= self->length) {
+			set_parse_error (self, _("Unexpected end of data."));
+			return 0;
+		}
+
+		byte = self->data[self->offset++];
+		value |= (guint64) (byte & 0x7f) << shift;
+
+		if ((byte & 0x80) == 0)
+			return value;
+	}
+
+	set_parse_error (self, _("Integer is too long."));
+
+	return 0;
+}
+
+/**
+ * gdata_binary_reader_get_int:
+ * @self: a #GDataBinaryReader
+ *
+ * Reads a signed integer written by gdata_binary_writer_put_int().
+ *
+ * Return value: the integer, or 0 on error
+ *
+ * Since: 0.17.9
+ */
+gint64
+gdata_binary_reader_get_int (GDataBinaryReader *self)
+{
+	guint64 value = gdata_binary_reader_get_uint (self);
+
+	return (gint64) (value >> 1) ^ -(gint64) (value & 1);
+}
+
+/**
+ * gdata_binary_reader_get_boolean:
+ * @self: a #GDataBinaryReader
+ *
+ * Reads a boolean written by gdata_binary_writer_put_boolean().
+ *
+ * Return value: the boolean, or %FALSE on error
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_binary_reader_get_boolean (GDataBinaryReader *self)
+{
+	guint8 byte;
+
+	g_return_val_if_fail (self != NULL, FALSE);
+
+	if (self->error != NULL)
+		return FALSE;
+
+	if (self->offset >= self->length) {
+		set_parse_error (self, _("Unexpected end of data."));
+		return FALSE;
+	}
+
+	byte = self->data[self->offset++];
+	if (byte > 1) {
+		set_parse_error (self, _("Invalid boolean value."));
+		return FALSE;
+	}
+
+	return (byte == 1) ? TRUE : FALSE;
+}
+
+/**
+ * gdata_binary_reader_get_double:
+ * @self: a #GDataBinaryReader
+ *
+ * Reads a double written by gdata_binary_writer_put_double().
+ *
+ * Return value: the double, or 0.0 on error
+ *
+ * Since: 0.17.9
+ */
+gdouble
+gdata_binary_reader_get_double (GDataBinaryReader *self)
+{
+	union {
+		gdouble d;
+		guint64 u;
+	} bits;
+
+	g_return_val_if_fail (self != NULL, 0.0);
+
+	if (self->error != NULL)
+		return 0.0;
+
+	if (self->length - self->offset < sizeof (bits.u)) {
+		set_parse_error (self, _("Unexpected end of data."));
+		return 0.0;
+	}
+
+	memcpy (&(bits.u), self->data + self->offset, sizeof (bits.u));
+	self->offset += sizeof (bits.u);
+	bits.u = GUINT64_FROM_LE (bits.u);
+
+	return bits.d;
+}
+
+/**
+ * gdata_binary_reader_get_string:
+ * @self: a #GDataBinaryReader
+ *
+ * Reads a nullable string written by gdata_binary_writer_put_string(). The string points into the data being read, so it's only valid until
+ * @self is finished, and must be copied if it's to be kept.
+ *
+ * Return value: (allow-none): the string, or %NULL
+ *
+ * Since: 0.17.9
+ */
+const gchar *
+gdata_binary_reader_get_string (GDataBinaryReader *self)
+{
+	guint64 reference, length;
+	const gchar *value;
+
+	g_return_val_if_fail (self != NULL, NULL);
+
+	reference = gdata_binary_reader_get_uint (self);
+
+	if (self->error != NULL || reference == STRING_NULL) {
+		return NULL;
+	} else if (reference >= STRING_FIRST_REFERENCE) {
+		if (reference - STRING_FIRST_REFERENCE >= self->strings->len) {
+			set_parse_error (self, _("Invalid string reference."));
+			return NULL;
+		}
+
+		return g_ptr_array_index (self->strings, reference - STRING_FIRST_REFERENCE);
+	}
+
+	/* A new string. */
+	length = gdata_binary_reader_get_uint (self);
+
+	if (self->error != NULL) {
+		return NULL;
+	} else if (length >= self->length - self->offset || self->data[self->offset + length] != '\0') {
+		set_parse_error (self, _("Unexpected end of data."));
+		return NULL;
+	}
+
+	value = (const gchar*) (self->data + self->offset);
+
+	if (g_utf8_validate (value, length, NULL) == FALSE) {
+		set_parse_error (self, _("Invalid UTF-8 in string."));
+		return NULL;
+	}
+
+	self->offset += length + 1;
+	g_ptr_array_add (self->strings, (gpointer) value);
+
+	return value;
+}
+
+/**
+ * gdata_binary_reader_dup_string:
+ * @self: a #GDataBinaryReader
+ *
+ * Reads a nullable string written by gdata_binary_writer_put_string(), returning a copy of it.
+ *
+ * Return value: (allow-none) (transfer full): the string, or %NULL; free with g_free()
+ *
+ * Since: 0.17.9
+ */
+gchar *
+gdata_binary_reader_dup_string (GDataBinaryReader *self)
+{
+	return g_strdup (gdata_binary_reader_get_string (self));
+}
+
+/**
+ * gdata_binary_reader_get_parsable:
+ * @self: a #GDataBinaryReader
+ * @parsable_type: the type of object expected, which the stored type must be (or be a subtype of)
+ *
+ * Reads a nullable #GDataParsable written by gdata_binary_writer_put_parsable().
+ *
+ * Return value: (allow-none) (transfer full): the object, or %NULL; unref with g_object_unref()
+ *
+ * Since: 0.17.9
+ */
+GDataParsable *
+gdata_binary_reader_get_parsable (GDataBinaryReader *self, GType parsable_type)
+{
+	g_return_val_if_fail (self != NULL, NULL);
+	g_return_val_if_fail (g_type_is_a (parsable_type, GDATA_TYPE_PARSABLE), NULL);
+
+	return _gdata_parsable_new_from_binary_reader (parsable_type, self);
+}
+
+/**
+ * gdata_binary_reader_get_parsable_list:
+ * @self: a #GDataBinaryReader
+ * @parsable_type: the type of object expected in the list
+ *
+ * Reads a list written by gdata_binary_writer_put_parsable_list(). %NULL elements are rejected.
+ *
+ * Return value: (element-type GDataParsable) (transfer full): the list, or %NULL if it's empty or on error
+ *
+ * Since: 0.17.9
+ */
+GList *
+gdata_binary_reader_get_parsable_list (GDataBinaryReader *self, GType parsable_type)
+{
+	guint64 count;
+	GList *list = NULL;
+
+	g_return_val_if_fail (self != NULL, NULL);
+
+	count = gdata_binary_reader_get_uint (self);
+
+	for (; count > 0 && self->error == NULL; count--) {
+		GDataParsable *parsable = gdata_binary_reader_get_parsable (self, parsable_type);
+
+		if (parsable == NULL) {
+			set_parse_error (self, _("Unexpected null object in list."));
+			break;
+		}
+
+		list = g_list_prepend (list, parsable);
+	}
+
+	if (self->error != NULL) {
+		g_list_free_full (list, g_object_unref);
+		return NULL;
+	}
+
+	return g_list_reverse (list);
+}
+
+/**
+ * gdata_binary_reader_get_string_list:
+ * @self: a #GDataBinaryReader
+ *
+ * Reads a list written by gdata_binary_writer_put_string_list().
+ *
+ * Return value: (element-type utf8) (transfer full): the list, or %NULL if it's empty or on error
+ *
+ * Since: 0.17.9
+ */
+GList *
+gdata_binary_reader_get_string_list (GDataBinaryReader *self)
+{
+	guint64 count;
+	GList *list = NULL;
+
+	g_return_val_if_fail (self != NULL, NULL);
+
+	count = gdata_binary_reader_get_uint (self);
+
+	for (; count > 0 && self->error == NULL; count--)
+		list = g_list_prepend (list, gdata_binary_reader_dup_string (self));
+
+	if (self->error != NULL) {
+		g_list_free_full (list, g_free);
+		return NULL;
+	}
+
+	return g_list_reverse (list);
+}
+
+/**
+ * gdata_binary_reader_get_string_hash:
+ * @self: a #GDataBinaryReader
+ * @table: (element-type utf8 utf8): a hash table which owns its keys and values, to add the entries to
+ *
+ * Reads the entries written by gdata_binary_writer_put_string_hash() and inserts copies of them into @table. %NULL keys are rejected.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_binary_reader_get_string_hash (GDataBinaryReader *self, GHashTable *table)
+{
+	guint64 count;
+
+	g_return_if_fail (self != NULL);
+	g_return_if_fail (table != NULL);
+
+	count = gdata_binary_reader_get_uint (self);
+
+	for (; count > 0 && self->error == NULL; count--) {
+		const gchar *key, *value;
+
+		key = gdata_binary_reader_get_string (self);
+		value = gdata_binary_reader_get_string (self);
+
+		if (self->error != NULL) {
+			break;
+		} else if (key == NULL) {
+			set_parse_error (self, _("Unexpected null key in table."));
+			break;
+		}
+
+		g_hash_table_replace (table, g_strdup (key), g_strdup (value));
+	}
+}
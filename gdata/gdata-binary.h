@@ -0,0 +1,106 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ * Copyright (C) Philip Withnall 2017 <philip@tecnocode.co.uk>
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GDATA_BINARY_H
+#define GDATA_BINARY_H
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include "gdata-parsable.h"
+
+G_BEGIN_DECLS
+
+/**
+ * GDataBinaryWriter:
+ *
+ * All the fields in the #GDataBinaryWriter structure are private and should never be accessed directly.
+ *
+ * Since: 0.17.9
+ */
+typedef struct _GDataBinaryWriter GDataBinaryWriter;
+
+/**
+ * GDataBinaryReader:
+ *
+ * All the fields in the #GDataBinaryReader structure are private and should never be accessed directly.
+ *
+ * Since: 0.17.9
+ */
+typedef struct _GDataBinaryReader GDataBinaryReader;
+
+/**
+ * GDataBinaryWriteFunc:
+ * @parsable: the #GDataParsable being serialised
+ * @writer: the #GDataBinaryWriter to append to
+ *
+ * Appends the state of @parsable which isn't covered by its writeable properties (such as read-only properties and lists of child objects) to
+ * @writer. Only the state belonging to the class which registered the function should be written; parent classes write their own.
+ *
+ * Since: 0.17.9
+ */
+typedef void (*GDataBinaryWriteFunc) (GDataParsable *parsable, GDataBinaryWriter *writer);
+
+/**
+ * GDataBinaryReadFunc:
+ * @parsable: the #GDataParsable being deserialised
+ * @reader: the #GDataBinaryReader to read from
+ *
+ * Reads back the state written by the corresponding #GDataBinaryWriteFunc, in the same order, and sets it on @parsable. Errors are recorded
+ * in @reader, and the values returned after an error are all zero or %NULL, so the function doesn't need to check for errors itself.
+ *
+ * Since: 0.17.9
+ */
+typedef void (*GDataBinaryReadFunc) (GDataParsable *parsable, GDataBinaryReader *reader);
+
+GDataBinaryWriter *gdata_binary_writer_new (void) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+GBytes *gdata_binary_writer_finish (GDataBinaryWriter *self, GError **error) G_GNUC_WARN_UNUSED_RESULT;
+void gdata_binary_writer_set_error (GDataBinaryWriter *self, GError *error);
+
+void gdata_binary_writer_put_uint (GDataBinaryWriter *self, guint64 value);
+void gdata_binary_writer_put_int (GDataBinaryWriter *self, gint64 value);
+void gdata_binary_writer_put_boolean (GDataBinaryWriter *self, gboolean value);
+void gdata_binary_writer_put_double (GDataBinaryWriter *self, gdouble value);
+void gdata_binary_writer_put_string (GDataBinaryWriter *self, const gchar *value);
+void gdata_binary_writer_put_parsable (GDataBinaryWriter *self, GDataParsable *value);
+void gdata_binary_writer_put_parsable_list (GDataBinaryWriter *self, GList *list);
+void gdata_binary_writer_put_string_list (GDataBinaryWriter *self, GList *list);
+void gdata_binary_writer_put_string_hash (GDataBinaryWriter *self, GHashTable *table);
+
+GDataBinaryReader *gdata_binary_reader_new (GBytes *bytes) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+gboolean gdata_binary_reader_finish (GDataBinaryReader *self, GError **error);
+void gdata_binary_reader_set_error (GDataBinaryReader *self, GError *error);
+gboolean gdata_binary_reader_failed (GDataBinaryReader *self) G_GNUC_PURE;
+gboolean gdata_binary_reader_enter (GDataBinaryReader *self);
+void gdata_binary_reader_leave (GDataBinaryReader *self);
+
+guint64 gdata_binary_reader_get_uint (GDataBinaryReader *self);
+gint64 gdata_binary_reader_get_int (GDataBinaryReader *self);
+gboolean gdata_binary_reader_get_boolean (GDataBinaryReader *self);
+gdouble gdata_binary_reader_get_double (GDataBinaryReader *self);
+const gchar *gdata_binary_reader_get_string (GDataBinaryReader *self);
+gchar *gdata_binary_reader_dup_string (GDataBinaryReader *self) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+GDataParsable *gdata_binary_reader_get_parsable (GDataBinaryReader *self, GType parsable_type) G_GNUC_WARN_UNUSED_RESULT;
+GList *gdata_binary_reader_get_parsable_list (GDataBinaryReader *self, GType parsable_type) G_GNUC_WARN_UNUSED_RESULT;
+GList *gdata_binary_reader_get_string_list (GDataBinaryReader *self) G_GNUC_WARN_UNUSED_RESULT;
+void gdata_binary_reader_get_string_hash (GDataBinaryReader *self, GHashTable *table);
+
+G_END_DECLS
+
+#endif /* !GDATA_BINARY_H */
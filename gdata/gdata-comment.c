@@ -38,13 +38,14 @@
 #include <glib.h>
 
 #include "gdata-comment.h"
+#include "gdata-private.h"
 
 G_DEFINE_ABSTRACT_TYPE (GDataComment, gdata_comment, GDATA_TYPE_ENTRY)
 
 static void
 gdata_comment_class_init (GDataCommentClass *klass)
 {
-	/* Nothing to see here */
+	_gdata_parsable_class_set_binary_funcs (GDATA_PARSABLE_CLASS (klass), NULL, NULL);
 }
 
 static void
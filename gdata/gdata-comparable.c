@@ -30,6 +30,10 @@
  * <ulink type="http" url="http://gcc.gnu.org/onlinedocs/gcc/Function-Attributes.html#index-g_t_0040code_007bpure_007d-function-attribute-2413">pure
  * </ulink>.
  *
+ * Classes may also implement the <function>hash</function> function, which must return equal hash values for any two objects which
+ * <function>compare_with</function> considers equal. This allows collections of the objects to be de-duplicated in constant time, rather than by
+ * comparing each new object against every object already in the collection.
+ *
  * Since: 0.7.0
  */
 
@@ -37,16 +41,23 @@
 #include <glib-object.h>
 
 #include "gdata-comparable.h"
+#include "gdata-private.h"
+
+/* Lists shorter than this are searched linearly, since it's not worth allocating an index for them. Most entries have only one or two values for
+ * each of their multi-valued properties. */
+#define COMPARABLE_LIST_INDEX_THRESHOLD 8
 
 GType
 gdata_comparable_get_type (void)
 {
-	static GType comparable_type = 0;
+	static volatile gsize comparable_type = 0;
 
-	if (!comparable_type) {
-		comparable_type = g_type_register_static_simple (G_TYPE_INTERFACE, "GDataComparable",
-		                                                 sizeof (GDataComparableIface),
-		                                                 NULL, 0, NULL, 0);
+	/* This may be called from several threads at once when a feed's entries are built in parallel */
+	if (g_once_init_enter (&comparable_type)) {
+		GType type = g_type_register_static_simple (G_TYPE_INTERFACE, "GDataComparable",
+		                                            sizeof (GDataComparableIface),
+		                                            NULL, 0, NULL, 0);
+		g_once_init_leave (&comparable_type, type);
 	}
 
 	return comparable_type;
@@ -93,3 +104,239 @@ gdata_comparable_compare (GDataComparable *self, GDataComparable *other)
 
 	return iface->compare_with (self, other);
 }
+
+/**
+ * gdata_comparable_hash:
+ * @self: a #GDataComparable
+ *
+ * Returns a hash value for @self, which is guaranteed to be equal for any two objects which gdata_comparable_compare() considers equal.
+ *
+ * If the object's type doesn't implement the <function>hash</function> function, <code class="literal">0</code> is returned for all objects of
+ * that type, which is correct but won't distribute them usefully in a hash table.
+ *
+ * Return value: a hash value for @self
+ *
+ * Since: 0.17.9
+ */
+guint
+gdata_comparable_hash (GDataComparable *self)
+{
+	GDataComparableIface *iface;
+
+	g_return_val_if_fail (GDATA_IS_COMPARABLE (self), 0);
+
+	iface = GDATA_COMPARABLE_GET_IFACE (self);
+
+	if (iface->hash == NULL)
+		return 0;
+
+	return iface->hash (self);
+}
+
+/* Combine @hash with the hash of @str, which may be %NULL. Used by the implementations of #GDataComparableIface.hash. */
+guint
+_gdata_comparable_hash_string (guint hash, const gchar *str)
+{
+	return hash * 33 + ((str != NULL) ? g_str_hash (str) : 0);
+}
+
+static guint
+comparable_list_hash_cb (gconstpointer key)
+{
+	return gdata_comparable_hash ((GDataComparable*) key);
+}
+
+static gboolean
+comparable_list_equal_cb (gconstpointer a, gconstpointer b)
+{
+	return (gdata_comparable_compare ((GDataComparable*) a, (GDataComparable*) b) == 0) ? TRUE : FALSE;
+}
+
+static void comparable_list_item_notify_cb (GObject *item, GParamSpec *pspec, GDataComparableList *self);
+
+/* Watches @item for changes which could alter its hash, since elements are exposed to callers and can be modified through their setters. */
+static void
+comparable_list_watch_item (GDataComparableList *self, GDataComparable *item)
+{
+	g_signal_connect (item, "notify", (GCallback) comparable_list_item_notify_cb, self);
+}
+
+/* Drops the index, if there is one, so that it's rebuilt from the current state of the elements when next needed */
+static void
+comparable_list_drop_index (GDataComparableList *self)
+{
+	GList *i;
+
+	if (self->index == NULL)
+		return;
+
+	for (i = self->list; i != NULL; i = i->next)
+		g_signal_handlers_disconnect_by_func (i->data, comparable_list_item_notify_cb, self);
+
+	g_clear_pointer (&self->index, g_hash_table_destroy);
+}
+
+static void
+comparable_list_item_notify_cb (GObject *item, GParamSpec *pspec, GDataComparableList *self)
+{
+	/* The element may now hash differently to when it was indexed */
+	comparable_list_drop_index (self);
+}
+
+/* Returns whether lookups of @item in @self can go through the index, building the index if necessary. */
+static gboolean
+comparable_list_ensure_index (GDataComparableList *self, GDataComparable *item)
+{
+	GList *i;
+
+	if (self->index != NULL)
+		return TRUE;
+
+	if (self->length < COMPARABLE_LIST_INDEX_THRESHOLD || GDATA_COMPARABLE_GET_IFACE (item)->hash == NULL)
+		return FALSE;
+
+	self->index = g_hash_table_new (comparable_list_hash_cb, comparable_list_equal_cb);
+
+	/* Keep the first of any duplicates, to match what g_list_find_custom() would return */
+	for (i = self->list; i != NULL; i = i->next) {
+		if (g_hash_table_contains (self->index, i->data) == FALSE)
+			g_hash_table_insert (self->index, i->data, i);
+
+		comparable_list_watch_item (self, i->data);
+	}
+
+	return TRUE;
+}
+
+/*
+ * _gdata_comparable_list_find:
+ * @self: a #GDataComparableList
+ * @item: the #GDataComparable to look for
+ *
+ * Finds the first element of @self which compares equal to @item using gdata_comparable_compare(). This is a hash table lookup once the list is
+ * long enough, and a linear search otherwise or if @item's type doesn't implement #GDataComparableIface.hash.
+ *
+ * Return value: (transfer none): the #GList link containing the equal element, or %NULL
+ */
+GList *
+_gdata_comparable_list_find (GDataComparableList *self, GDataComparable *item)
+{
+	if (comparable_list_ensure_index (self, item) == TRUE)
+		return g_hash_table_lookup (self->index, item);
+
+	return g_list_find_custom (self->list, item, (GCompareFunc) gdata_comparable_compare);
+}
+
+/*
+ * _gdata_comparable_list_add:
+ * @self: a #GDataComparableList
+ * @item: the #GDataComparable to add
+ * @prepend: %TRUE to add @item to the start of the list, %FALSE to add it to the end
+ *
+ * Adds a reference to @item to @self, unless an equal element is already in the list. Both ends of the list can be added to in constant time.
+ *
+ * Return value: %TRUE if @item was added, %FALSE if it was a duplicate
+ */
+gboolean
+_gdata_comparable_list_add (GDataComparableList *self, GDataComparable *item, gboolean prepend)
+{
+	GList *link;
+
+	if (_gdata_comparable_list_find (self, item) != NULL)
+		return FALSE;
+
+	if (prepend == TRUE) {
+		self->list = g_list_prepend (self->list, g_object_ref (item));
+		link = self->list;
+
+		if (self->last == NULL)
+			self->last = link;
+	} else {
+		link = g_list_alloc ();
+		link->data = g_object_ref (item);
+		link->prev = self->last;
+
+		if (self->last != NULL)
+			self->last->next = link;
+		else
+			self->list = link;
+
+		self->last = link;
+	}
+
+	self->length++;
+
+	if (self->index != NULL) {
+		g_hash_table_insert (self->index, item, link);
+		comparable_list_watch_item (self, item);
+	}
+
+	return TRUE;
+}
+
+/*
+ * _gdata_comparable_list_delete_link:
+ * @self: a #GDataComparableList
+ * @link: a link in @self
+ *
+ * Removes @link from @self and frees it. The caller is responsible for the reference held on the link's data.
+ */
+void
+_gdata_comparable_list_delete_link (GDataComparableList *self, GList *link)
+{
+	/* An equal element later in the list may have been shadowed by this one, so the index is rebuilt when next needed. Removals are rare. */
+	comparable_list_drop_index (self);
+
+	if (self->last == link)
+		self->last = link->prev;
+
+	self->list = g_list_delete_link (self->list, link);
+	self->length--;
+}
+
+/*
+ * _gdata_comparable_list_reverse:
+ * @self: a #GDataComparableList
+ *
+ * Reverses @self in place. Used to restore document order after parsing into a list using prepends.
+ */
+void
+_gdata_comparable_list_reverse (GDataComparableList *self)
+{
+	self->last = self->list;
+	self->list = g_list_reverse (self->list);
+}
+
+/*
+ * _gdata_comparable_list_set:
+ * @self: a #GDataComparableList
+ * @list: (transfer full) (element-type GDataComparable): the new contents for @self
+ *
+ * Replaces the contents of @self with @list, which is not de-duplicated.
+ */
+void
+_gdata_comparable_list_set (GDataComparableList *self, GList *list)
+{
+	_gdata_comparable_list_clear (self);
+
+	self->list = list;
+	self->last = g_list_last (list);
+	self->length = g_list_length (list);
+}
+
+/*
+ * _gdata_comparable_list_clear:
+ * @self: a #GDataComparableList
+ *
+ * Removes all the elements from @self, dropping the references held on them.
+ */
+void
+_gdata_comparable_list_clear (GDataComparableList *self)
+{
+	comparable_list_drop_index (self);
+
+	g_list_free_full (self->list, g_object_unref);
+	self->list = NULL;
+	self->last = NULL;
+	self->length = 0;
+}
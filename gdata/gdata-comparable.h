@@ -46,6 +46,9 @@ typedef struct _GDataComparable		GDataComparable; /* dummy typedef */
  * @compare_with: compares the object with an @other object of the same type, returning <code class="literal">-1</code> if the object is "less than"
  * the other object, <code class="literal">0</code> if they're equal, or <code class="literal">1</code> if the object is "greater than" the other. The
  * function can assume that neither @self or @other will be %NULL, and that both have correct types. The function must be pure.
+ * @hash: returns a hash value for the object, which must be equal for any two objects which @compare_with considers equal. The function can assume
+ * that @self will not be %NULL, and must be pure. It may be left as %NULL if the type's notion of equality can't be hashed, in which case
+ * collections of the type are searched linearly. (Since: 0.17.9.)
  *
  * The class structure for the #GDataComparable interface.
  *
@@ -55,11 +58,13 @@ typedef struct {
 	GTypeInterface parent;
 
 	gint (*compare_with) (GDataComparable *self, GDataComparable *other);
+	guint (*hash) (GDataComparable *self);
 } GDataComparableIface;
 
 GType gdata_comparable_get_type (void) G_GNUC_CONST;
 
 gint gdata_comparable_compare (GDataComparable *self, GDataComparable *other) G_GNUC_PURE;
+guint gdata_comparable_hash (GDataComparable *self) G_GNUC_PURE;
 
 G_END_DECLS
 
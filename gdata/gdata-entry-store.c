@@ -0,0 +1,1331 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ * Copyright (C) Philip Withnall 2017 <philip@tecnocode.co.uk>
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:gdata-entry-store
+ * @short_description: GData persistent local entry store
+ * @stability: Unstable
+ * @include: gdata/gdata-entry-store.h
+ *
+ * #GDataEntryStore is a persistent local cache of #GDataEntry<!-- -->s, kept in a file so that an application can answer most reads from
+ * the cache and start up quickly from a warm cache, rather than re-downloading its entries on each run. Entries can be looked up by their ID,
+ * or scanned in order of their #GDataEntry:updated time.
+ *
+ * The store is kept in two files. The data file is an append-only log of entries, in the format returned by gdata_parsable_get_binary().
+ * Storing a new version of an entry (or removing it) appends a record to the log, so existing records are never modified in place. The data
+ * file is memory-mapped, and entries are only deserialised when they're looked up. The index file (the data file's name with
+ * <literal>.index</literal> appended) holds an on-disk hash table of entry IDs and an array of entries sorted by their update time, so that
+ * opening a store doesn't need to read the entries themselves.
+ *
+ * The index file is rewritten by gdata_entry_store_flush(). Records appended since the index was last written are indexed in memory, and are
+ * re-read from the end of the data file when the store is next opened, so the index doesn't have to be written after every change. If an
+ * application crashes part-way through appending a record, the incomplete record is discarded the next time the store is opened.
+ *
+ * As superseded and removed entries are kept in the log, the data file should periodically be compacted using gdata_entry_store_compact().
+ *
+ * The ETags of stored entries are available without deserialising them, using gdata_entry_store_dup_etag(), so that an entry can be
+ * revalidated against the server cheaply.
+ *
+ * <example>
+ * 	<title>Caching a Calendar</title>
+ * 	<programlisting>
+ *	GDataEntryStore *store;
+ *	GDataFeed *feed;
+ *	GDataEntry *entry;
+ *	GError *error = NULL;
+ *
+ *	store = gdata_entry_store_new ("/home/user/.cache/my-app/calendar.store", &error);
+ *
+ *	if (error != NULL) {
+ *		g_error ("Error opening store: %s", error->message);
+ *		g_error_free (error);
+ *		return;
+ *	}
+ *
+ *	/<!-- -->* Add the events which have changed to the store *<!-- -->/
+ *	feed = gdata_calendar_service_query_events (service, calendar, query, NULL, NULL, NULL, &error);
+ *	gdata_entry_store_upsert_feed (store, feed, &error);
+ *	g_object_unref (feed);
+ *
+ *	/<!-- -->* Look up an event locally *<!-- -->/
+ *	entry = gdata_entry_store_lookup (store, event_id, &error);
+ *
+ *	/<!-- -->* Write out the index before closing the store, so it opens quickly next time *<!-- -->/
+ *	gdata_entry_store_flush (store, &error);
+ *	g_object_unref (store);
+ * 	</programlisting>
+ * </example>
+ *
+ * Since: 0.17.9
+ */
+
+#include <config.h>
+#include <glib.h>
+#include <glib/gi18n-lib.h>
+#include <gio/gio.h>
+#include <string.h>
+
+#include "gdata-entry-store.h"
+#include "gdata-private.h"
+
+/* All integers in both files are little-endian. Records in the data file are aligned to 8 bytes.
+ *
+ * Data file header: magic (8 bytes), format version (u32), generation (u32).
+ * Record: record length including header and padding (u32), flags (u32), updated time (i64), ID length (u32), ETag length (u32),
+ *         entry data length (u32), reserved (u32); followed by the ID, the ETag and the entry data, then padding.
+ * Index file header: magic (8 bytes), format version (u32), generation of the data file (u32), length of the data file covered by the
+ *                    index (u64), number of hash buckets (u32, a power of two), reserved (u32), number of entries (u64);
+ *                    followed by the hash buckets (u64 record offset each, or 0 if empty), then the entries sorted by updated time
+ *                    (i64 updated time, u64 record offset).
+ *
+ * The generation is regenerated each time the data file is rewritten by compaction, so that an index left over from a previous generation of
+ * the data file is ignored. */
+#define DATA_MAGIC "GDATAES\x01"
+#define INDEX_MAGIC "GDATAEI\x01"
+#define FORMAT_VERSION 1
+
+#define DATA_HEADER_LENGTH 16
+#define RECORD_HEADER_LENGTH 32
+#define INDEX_HEADER_LENGTH 40
+#define INDEX_ENTRY_LENGTH 16
+
+#define MIN_BUCKETS 16
+
+/* Record flags */
+#define RECORD_DELETED (1 << 0)
+
+typedef struct {
+	GMappedFile *map; /* NULL if there's no usable index */
+	const guint8 *buckets;
+	guint32 n_buckets;
+	const guint8 *entries;
+	guint64 n_entries;
+	guint64 data_length; /* length of the data file covered by the index */
+} StoreIndex;
+
+typedef struct {
+	guint64 offset;
+	guint32 length;
+	guint32 flags;
+	gint64 updated;
+	const gchar *id;
+	guint32 id_length;
+	const gchar *etag;
+	guint32 etag_length;
+	const guint8 *data;
+	guint32 data_length;
+} StoreRecord;
+
+typedef struct {
+	gint64 updated;
+	guint64 offset;
+} ScanMatch;
+
+static void gdata_entry_store_finalize (GObject *object);
+static void gdata_entry_store_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+static void gdata_entry_store_set_property (GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+
+struct _GDataEntryStorePrivate {
+	gchar *filename;
+	gchar *index_filename;
+
+	GMutex mutex; /* protects everything below */
+
+	GFileIOStream *stream; /* positioned at the end of the valid data; NULL if the store couldn't be (re-)opened */
+	guint64 data_length; /* length of the valid data in the data file */
+	guint32 generation;
+	GMappedFile *data_map; /* may not cover records appended since it was mapped; see ensure_data_mapped() */
+	gboolean data_map_is_stale; /* TRUE if records have been appended since @data_map was mapped */
+
+	StoreIndex index;
+	GHashTable *overlay; /* entry ID → guint64 record offset, for each entry with records appended after the index was written */
+	guint n_entries; /* number of live entries */
+};
+
+enum {
+	PROP_FILENAME = 1,
+};
+
+G_DEFINE_TYPE (GDataEntryStore, gdata_entry_store, G_TYPE_OBJECT)
+
+static void
+gdata_entry_store_class_init (GDataEntryStoreClass *klass)
+{
+	GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+	g_type_class_add_private (klass, sizeof (GDataEntryStorePrivate));
+
+	gobject_class->finalize = gdata_entry_store_finalize;
+	gobject_class->get_property = gdata_entry_store_get_property;
+	gobject_class->set_property = gdata_entry_store_set_property;
+
+	/**
+	 * GDataEntryStore:filename:
+	 *
+	 * The name of the store's data file. The index file has the same name, with <literal>.index</literal> appended.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_FILENAME,
+	                                 g_param_spec_string ("filename",
+	                                                      "Filename", "The name of the store's data file.",
+	                                                      NULL,
+	                                                      G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+}
+
+static void
+gdata_entry_store_init (GDataEntryStore *self)
+{
+	self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self, GDATA_TYPE_ENTRY_STORE, GDataEntryStorePrivate);
+	self->priv->overlay = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+	g_mutex_init (&(self->priv->mutex));
+}
+
+static void
+clear_index (StoreIndex *index)
+{
+	if (index->map != NULL)
+		g_mapped_file_unref (index->map);
+
+	memset (index, 0, sizeof (*index));
+}
+
+static void
+close_store (GDataEntryStorePrivate *priv)
+{
+	if (priv->stream != NULL) {
+		g_io_stream_close (G_IO_STREAM (priv->stream), NULL, NULL);
+		g_clear_object (&priv->stream);
+	}
+
+	if (priv->data_map != NULL) {
+		g_mapped_file_unref (priv->data_map);
+		priv->data_map = NULL;
+	}
+	priv->data_map_is_stale = FALSE;
+
+	clear_index (&(priv->index));
+	g_hash_table_remove_all (priv->overlay);
+	priv->data_length = 0;
+	priv->n_entries = 0;
+}
+
+static void
+gdata_entry_store_finalize (GObject *object)
+{
+	GDataEntryStorePrivate *priv = GDATA_ENTRY_STORE (object)->priv;
+
+	close_store (priv);
+	g_hash_table_unref (priv->overlay);
+	g_mutex_clear (&(priv->mutex));
+	g_free (priv->index_filename);
+	g_free (priv->filename);
+
+	/* Chain up to the parent class */
+	G_OBJECT_CLASS (gdata_entry_store_parent_class)->finalize (object);
+}
+
+static void
+gdata_entry_store_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+	GDataEntryStorePrivate *priv = GDATA_ENTRY_STORE (object)->priv;
+
+	switch (property_id) {
+		case PROP_FILENAME:
+			g_value_set_string (value, priv->filename);
+			break;
+		default:
+			/* We don't have any other property... */
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+			break;
+	}
+}
+
+static void
+gdata_entry_store_set_property (GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+	GDataEntryStorePrivate *priv = GDATA_ENTRY_STORE (object)->priv;
+
+	switch (property_id) {
+		/* Construct only */
+		case PROP_FILENAME:
+			priv->filename = g_value_dup_string (value);
+			priv->index_filename = g_strconcat (priv->filename, ".index", NULL);
+			break;
+		default:
+			/* We don't have any other property... */
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+			break;
+	}
+}
+
+static inline guint32
+read_uint32 (const guint8 *data)
+{
+	guint32 value;
+
+	memcpy (&value, data, sizeof (value));
+	return GUINT32_FROM_LE (value);
+}
+
+static inline guint64
+read_uint64 (const guint8 *data)
+{
+	guint64 value;
+
+	memcpy (&value, data, sizeof (value));
+	return GUINT64_FROM_LE (value);
+}
+
+static inline void
+write_uint32 (guint8 *data, guint32 value)
+{
+	value = GUINT32_TO_LE (value);
+	memcpy (data, &value, sizeof (value));
+}
+
+static inline void
+write_uint64 (guint8 *data, guint64 value)
+{
+	value = GUINT64_TO_LE (value);
+	memcpy (data, &value, sizeof (value));
+}
+
+/* FNV-1a. This is stored on disk (as bucket positions), so it mustn't change between versions, unlike g_str_hash(). */
+static guint32
+hash_id (const gchar *id, gsize id_length)
+{
+	guint32 hash = 2166136261U;
+	gsize i;
+
+	for (i = 0; i < id_length; i++) {
+		hash ^= (guint8) id[i];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+/* Parses the record at @offset in the data file, checking that it lies entirely within the valid data. The data file must have been mapped
+ * with ensure_data_mapped(). Returns %FALSE if @offset doesn't point to a valid record. */
+static gboolean
+parse_record (GDataEntryStorePrivate *priv, guint64 offset, StoreRecord *record)
+{
+	const guint8 *data;
+	guint64 limit;
+	guint32 length, id_length, etag_length, data_length;
+
+	if (priv->data_map == NULL)
+		return FALSE;
+
+	limit = MIN (g_mapped_file_get_length (priv->data_map), priv->data_length);
+	if (offset < DATA_HEADER_LENGTH || offset % 8 != 0 || offset > limit || limit - offset < RECORD_HEADER_LENGTH)
+		return FALSE;
+
+	data = (const guint8 *) g_mapped_file_get_contents (priv->data_map) + offset;
+	length = read_uint32 (data);
+	id_length = read_uint32 (data + 16);
+	etag_length = read_uint32 (data + 20);
+	data_length = read_uint32 (data + 24);
+
+	if (length % 8 != 0 || length > limit - offset || id_length == 0 ||
+	    (guint64) RECORD_HEADER_LENGTH + id_length + etag_length + data_length > length) {
+		return FALSE;
+	}
+
+	record->offset = offset;
+	record->length = length;
+	record->flags = read_uint32 (data + 4);
+	record->updated = (gint64) read_uint64 (data + 8);
+	record->id = (const gchar *) data + RECORD_HEADER_LENGTH;
+	record->id_length = id_length;
+	record->etag = record->id + id_length;
+	record->etag_length = etag_length;
+	record->data = (const guint8 *) record->etag + etag_length;
+	record->data_length = data_length;
+
+	return TRUE;
+}
+
+static gboolean
+record_has_id (const StoreRecord *record, const gchar *id, gsize id_length)
+{
+	return (record->id_length == id_length && memcmp (record->id, id, id_length) == 0);
+}
+
+/* Maps the data file, or re-maps it if records have been appended since it was last mapped. */
+static gboolean
+ensure_data_mapped (GDataEntryStorePrivate *priv, GError **error)
+{
+	GMappedFile *data_map;
+
+	if (priv->stream == NULL) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_CLOSED, _("The entry store ‘%s’ is closed."), priv->filename);
+		return FALSE;
+	}
+
+	if (priv->data_map != NULL && priv->data_map_is_stale == FALSE)
+		return TRUE;
+
+	if (g_output_stream_flush (g_io_stream_get_output_stream (G_IO_STREAM (priv->stream)), NULL, error) == FALSE)
+		return FALSE;
+
+	data_map = g_mapped_file_new (priv->filename, FALSE, error);
+	if (data_map == NULL)
+		return FALSE;
+
+	if (priv->data_map != NULL)
+		g_mapped_file_unref (priv->data_map);
+	priv->data_map = data_map;
+	priv->data_map_is_stale = FALSE;
+
+	return TRUE;
+}
+
+/* Makes sure the latest record for @id, if there is one, can be read. Unlike ensure_data_mapped(), this only re-maps the data file if that
+ * record was appended since the file was last mapped, so that storing a run of different entries doesn't re-map the file after each one. */
+static gboolean
+ensure_record_mapped (GDataEntryStorePrivate *priv, const gchar *id, GError **error)
+{
+	const guint64 *overlay_offset;
+
+	if (priv->stream != NULL && priv->data_map != NULL) {
+		overlay_offset = g_hash_table_lookup (priv->overlay, id);
+
+		/* Records from the index are always covered, as are records in the overlay which were appended before the file was mapped */
+		if (overlay_offset == NULL || *overlay_offset < g_mapped_file_get_length (priv->data_map))
+			return TRUE;
+	}
+
+	return ensure_data_mapped (priv, error);
+}
+
+/* Finds the latest record for @id, which may be a deletion record. The data file must have been mapped with ensure_data_mapped(). */
+static gboolean
+find_record (GDataEntryStorePrivate *priv, const gchar *id, StoreRecord *record)
+{
+	const guint64 *overlay_offset;
+	gsize id_length;
+	guint32 mask, bucket, probes;
+
+	/* Records appended since the index was written take precedence */
+	overlay_offset = g_hash_table_lookup (priv->overlay, id);
+	if (overlay_offset != NULL)
+		return parse_record (priv, *overlay_offset, record);
+
+	if (priv->index.map == NULL)
+		return FALSE;
+
+	/* Linear probing. The index only contains live entries, and never contains deletion records. */
+	id_length = strlen (id);
+	mask = priv->index.n_buckets - 1;
+
+	for (bucket = hash_id (id, id_length) & mask, probes = 0; probes < priv->index.n_buckets; bucket = (bucket + 1) & mask, probes++) {
+		guint64 offset = read_uint64 (priv->index.buckets + bucket * 8);
+
+		if (offset == 0)
+			return FALSE;
+
+		if (parse_record (priv, offset, record) == TRUE && record_has_id (record, id, id_length) == TRUE)
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+static gboolean
+find_live_record (GDataEntryStorePrivate *priv, const gchar *id, StoreRecord *record)
+{
+	return (find_record (priv, id, record) == TRUE && (record->flags & RECORD_DELETED) == 0);
+}
+
+/* Updates the in-memory index for a record which has been appended to the data file. Takes ownership of @id. */
+static void
+add_to_overlay (GDataEntryStorePrivate *priv, gchar *id, guint64 offset, gboolean was_live, gboolean is_live)
+{
+	g_hash_table_insert (priv->overlay, id, g_memdup (&offset, sizeof (offset)));
+
+	if (was_live == TRUE && is_live == FALSE)
+		priv->n_entries--;
+	else if (was_live == FALSE && is_live == TRUE)
+		priv->n_entries++;
+}
+
+static gboolean
+append_record (GDataEntryStorePrivate *priv, guint32 flags, gint64 updated, const gchar *id, const gchar *etag, GBytes *data,
+               gboolean was_live, GError **error)
+{
+	GOutputStream *output_stream;
+	guint8 *record;
+	gsize id_length, etag_length, data_length;
+	guint64 length;
+	guint8 *p;
+
+	id_length = strlen (id);
+	etag_length = (etag != NULL) ? strlen (etag) : 0;
+	data_length = (data != NULL) ? g_bytes_get_size (data) : 0;
+	length = ((guint64) RECORD_HEADER_LENGTH + id_length + etag_length + data_length + 7) & ~((guint64) 7);
+
+	if (length > G_MAXUINT32) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT, _("The entry ‘%s’ is too large to store."), id);
+		return FALSE;
+	}
+
+	record = g_malloc0 (length);
+	write_uint32 (record, length);
+	write_uint32 (record + 4, flags);
+	write_uint64 (record + 8, (guint64) updated);
+	write_uint32 (record + 16, id_length);
+	write_uint32 (record + 20, etag_length);
+	write_uint32 (record + 24, data_length);
+
+	p = record + RECORD_HEADER_LENGTH;
+	memcpy (p, id, id_length);
+	p += id_length;
+	if (etag_length > 0)
+		memcpy (p, etag, etag_length);
+	p += etag_length;
+	if (data_length > 0)
+		memcpy (p, g_bytes_get_data (data, NULL), data_length);
+
+	output_stream = g_io_stream_get_output_stream (G_IO_STREAM (priv->stream));
+
+	if (g_output_stream_write_all (output_stream, record, length, NULL, NULL, error) == FALSE) {
+		/* Drop any partially-written record so that the next one starts at a record boundary */
+		g_seekable_truncate (G_SEEKABLE (priv->stream), priv->data_length, NULL, NULL);
+		g_seekable_seek (G_SEEKABLE (priv->stream), priv->data_length, G_SEEK_SET, NULL, NULL);
+		g_free (record);
+
+		return FALSE;
+	}
+
+	g_free (record);
+
+	add_to_overlay (priv, g_strdup (id), priv->data_length, was_live, (flags & RECORD_DELETED) == 0);
+	priv->data_length += length;
+
+	/* Re-mapping the file is left until the record is next read */
+	priv->data_map_is_stale = TRUE;
+
+	return TRUE;
+}
+
+/* Loads and validates the index file. It's ignored if it's missing, corrupt or belongs to a different generation of the data file. */
+static gboolean
+load_index (GDataEntryStorePrivate *priv, StoreIndex *index)
+{
+	GMappedFile *index_map;
+	const guint8 *contents;
+	gsize length;
+	guint32 n_buckets;
+	guint64 data_length, n_entries;
+
+	index_map = g_mapped_file_new (priv->index_filename, FALSE, NULL);
+	if (index_map == NULL)
+		return FALSE;
+
+	contents = (const guint8 *) g_mapped_file_get_contents (index_map);
+	length = g_mapped_file_get_length (index_map);
+
+	if (length < INDEX_HEADER_LENGTH || memcmp (contents, INDEX_MAGIC, 8) != 0 || read_uint32 (contents + 8) != FORMAT_VERSION ||
+	    read_uint32 (contents + 12) != priv->generation) {
+		goto invalid;
+	}
+
+	data_length = read_uint64 (contents + 16);
+	n_buckets = read_uint32 (contents + 24);
+	n_entries = read_uint64 (contents + 32);
+
+	/* There are always more buckets than entries, so probing always terminates */
+	if (data_length < DATA_HEADER_LENGTH || data_length > priv->data_length || n_buckets < MIN_BUCKETS ||
+	    (n_buckets & (n_buckets - 1)) != 0 || n_entries >= n_buckets ||
+	    length - INDEX_HEADER_LENGTH != (guint64) n_buckets * 8 + n_entries * INDEX_ENTRY_LENGTH) {
+		goto invalid;
+	}
+
+	index->map = index_map;
+	index->buckets = contents + INDEX_HEADER_LENGTH;
+	index->n_buckets = n_buckets;
+	index->entries = index->buckets + (gsize) n_buckets * 8;
+	index->n_entries = n_entries;
+	index->data_length = data_length;
+
+	return TRUE;
+
+invalid:
+	g_mapped_file_unref (index_map);
+	return FALSE;
+}
+
+static gboolean
+write_data_header (GOutputStream *output_stream, guint32 generation, GError **error)
+{
+	guint8 header[DATA_HEADER_LENGTH];
+
+	memcpy (header, DATA_MAGIC, 8);
+	write_uint32 (header + 8, FORMAT_VERSION);
+	write_uint32 (header + 12, generation);
+
+	return g_output_stream_write_all (output_stream, header, sizeof (header), NULL, NULL, error);
+}
+
+static gboolean
+open_store (GDataEntryStorePrivate *priv, GError **error)
+{
+	GFile *file;
+	GFileIOStream *stream;
+	const guint8 *contents;
+	guint64 length, offset;
+	GError *child_error = NULL;
+
+	file = g_file_new_for_path (priv->filename);
+	stream = g_file_open_readwrite (file, NULL, &child_error);
+
+	if (stream == NULL && g_error_matches (child_error, G_IO_ERROR, G_IO_ERROR_NOT_FOUND) == TRUE) {
+		/* Create a new, empty store */
+		g_clear_error (&child_error);
+		stream = g_file_create_readwrite (file, G_FILE_CREATE_NONE, NULL, error);
+		g_object_unref (file);
+
+		if (stream == NULL)
+			return FALSE;
+
+		priv->stream = stream;
+		priv->generation = g_random_int ();
+
+		if (write_data_header (g_io_stream_get_output_stream (G_IO_STREAM (stream)), priv->generation, error) == FALSE) {
+			g_clear_object (&priv->stream);
+			return FALSE;
+		}
+
+		priv->data_length = DATA_HEADER_LENGTH;
+
+		return TRUE;
+	} else if (stream == NULL) {
+		g_propagate_error (error, child_error);
+		g_object_unref (file);
+		return FALSE;
+	}
+
+	g_object_unref (file);
+	priv->stream = stream;
+
+	priv->data_map = g_mapped_file_new (priv->filename, FALSE, error);
+	if (priv->data_map == NULL)
+		goto error;
+
+	contents = (const guint8 *) g_mapped_file_get_contents (priv->data_map);
+	length = g_mapped_file_get_length (priv->data_map);
+
+	if (length < DATA_HEADER_LENGTH || memcmp (contents, DATA_MAGIC, 8) != 0 || read_uint32 (contents + 8) != FORMAT_VERSION) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA, _("‘%s’ is not a valid entry store."), priv->filename);
+		goto error;
+	}
+
+	priv->generation = read_uint32 (contents + 12);
+	priv->data_length = length;
+
+	if (load_index (priv, &(priv->index)) == TRUE) {
+		offset = priv->index.data_length;
+		priv->n_entries = priv->index.n_entries;
+	} else {
+		offset = DATA_HEADER_LENGTH;
+	}
+
+	/* Replay the records appended since the index was written into the in-memory index. This stops at the first invalid record, which can
+	 * only be a record torn by a crash part-way through appending it. */
+	while (offset < length) {
+		StoreRecord record, previous;
+		gchar *id;
+		gboolean was_live;
+
+		if (parse_record (priv, offset, &record) == FALSE)
+			break;
+
+		id = g_strndup (record.id, record.id_length);
+		was_live = find_live_record (priv, id, &previous);
+		add_to_overlay (priv, id, offset, was_live, (record.flags & RECORD_DELETED) == 0);
+
+		offset += record.length;
+	}
+
+	if (offset < length) {
+		if (g_seekable_truncate (G_SEEKABLE (stream), offset, NULL, error) == FALSE)
+			goto error;
+
+		/* Don't keep a mapping which extends past the end of the file */
+		g_mapped_file_unref (priv->data_map);
+		priv->data_map = NULL;
+	}
+
+	priv->data_length = offset;
+
+	if (g_seekable_seek (G_SEEKABLE (stream), offset, G_SEEK_SET, NULL, error) == FALSE)
+		goto error;
+
+	return TRUE;
+
+error:
+	close_store (priv);
+	return FALSE;
+}
+
+/**
+ * gdata_entry_store_new:
+ * @filename: the name of the store's data file
+ * @error: a #GError, or %NULL
+ *
+ * Opens the entry store in @filename, creating a new, empty store if the file doesn't exist. The index file is created or updated the first
+ * time gdata_entry_store_flush() is called.
+ *
+ * If @filename exists but isn't an entry store, %G_IO_ERROR_INVALID_DATA will be returned.
+ *
+ * Return value: (transfer full): a new #GDataEntryStore, or %NULL; unref with g_object_unref()
+ *
+ * Since: 0.17.9
+ */
+GDataEntryStore *
+gdata_entry_store_new (const gchar *filename, GError **error)
+{
+	GDataEntryStore *self;
+
+	g_return_val_if_fail (filename != NULL && *filename != '\0', NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	self = g_object_new (GDATA_TYPE_ENTRY_STORE, "filename", filename, NULL);
+
+	if (open_store (self->priv, error) == FALSE) {
+		g_object_unref (self);
+		return NULL;
+	}
+
+	return self;
+}
+
+/**
+ * gdata_entry_store_get_filename:
+ * @self: a #GDataEntryStore
+ *
+ * Gets the #GDataEntryStore:filename property.
+ *
+ * Return value: the name of the store's data file
+ *
+ * Since: 0.17.9
+ */
+const gchar *
+gdata_entry_store_get_filename (GDataEntryStore *self)
+{
+	g_return_val_if_fail (GDATA_IS_ENTRY_STORE (self), NULL);
+	return self->priv->filename;
+}
+
+/**
+ * gdata_entry_store_get_n_entries:
+ * @self: a #GDataEntryStore
+ *
+ * Gets the number of entries in the store. Superseded versions of entries, and entries which have been removed, aren't counted.
+ *
+ * Return value: the number of entries in the store
+ *
+ * Since: 0.17.9
+ */
+guint
+gdata_entry_store_get_n_entries (GDataEntryStore *self)
+{
+	guint n_entries;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_STORE (self), 0);
+
+	g_mutex_lock (&(self->priv->mutex));
+	n_entries = self->priv->n_entries;
+	g_mutex_unlock (&(self->priv->mutex));
+
+	return n_entries;
+}
+
+static gboolean
+upsert_entry (GDataEntryStorePrivate *priv, GDataEntry *entry, GError **error)
+{
+	StoreRecord record;
+	const gchar *id, *etag;
+	gint64 updated;
+	gboolean was_live, success;
+	GBytes *data;
+
+	id = gdata_entry_get_id (entry);
+	etag = gdata_entry_get_etag (entry);
+	updated = gdata_entry_get_updated (entry);
+
+	if (ensure_record_mapped (priv, id, error) == FALSE)
+		return FALSE;
+
+	was_live = find_live_record (priv, id, &record);
+
+	/* Skip entries which haven't changed since they were stored, so that storing a whole feed again only appends what's changed */
+	if (was_live == TRUE && etag != NULL && record.updated == updated &&
+	    record.etag_length == strlen (etag) && memcmp (record.etag, etag, record.etag_length) == 0) {
+		return TRUE;
+	}
+
+	data = gdata_parsable_get_binary (GDATA_PARSABLE (entry), error);
+	if (data == NULL)
+		return FALSE;
+
+	success = append_record (priv, 0, updated, id, etag, data, was_live, error);
+	g_bytes_unref (data);
+
+	return success;
+}
+
+/**
+ * gdata_entry_store_upsert:
+ * @self: a #GDataEntryStore
+ * @entry: the #GDataEntry to store
+ * @error: a #GError, or %NULL
+ *
+ * Adds @entry to the store, replacing any entry with the same #GDataEntry:id. @entry must have an ID, so it must have been returned by the
+ * server rather than constructed locally.
+ *
+ * If the stored entry has the same #GDataEntry:etag and #GDataEntry:updated time as @entry, it's assumed to be unchanged and nothing is
+ * written.
+ *
+ * Entries are stored using gdata_parsable_get_binary(), and if @entry can't be serialised, a %G_IO_ERROR_NOT_SUPPORTED error is returned.
+ *
+ * Return value: %TRUE on success, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_entry_store_upsert (GDataEntryStore *self, GDataEntry *entry, GError **error)
+{
+	gboolean success;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_STORE (self), FALSE);
+	g_return_val_if_fail (GDATA_IS_ENTRY (entry), FALSE);
+	g_return_val_if_fail (gdata_entry_get_id (entry) != NULL, FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	g_mutex_lock (&(self->priv->mutex));
+	success = upsert_entry (self->priv, entry, error);
+	g_mutex_unlock (&(self->priv->mutex));
+
+	return success;
+}
+
+/**
+ * gdata_entry_store_upsert_feed:
+ * @self: a #GDataEntryStore
+ * @feed: a #GDataFeed of entries to store
+ * @error: a #GError, or %NULL
+ *
+ * Adds each of the entries in @feed to the store, as with gdata_entry_store_upsert(). Entries without IDs are ignored. If an error occurs,
+ * the entries before the one which failed will have been stored.
+ *
+ * Deletions aren't represented consistently in feeds, so entries which have been deleted on the server have to be removed from the store
+ * using gdata_entry_store_remove(). #GDataSyncSession reports them as %GDATA_SYNC_CHANGE_DELETION changes.
+ *
+ * Return value: %TRUE on success, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_entry_store_upsert_feed (GDataEntryStore *self, GDataFeed *feed, GError **error)
+{
+	GList *i;
+	gboolean success = TRUE;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_STORE (self), FALSE);
+	g_return_val_if_fail (GDATA_IS_FEED (feed), FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	g_mutex_lock (&(self->priv->mutex));
+
+	for (i = gdata_feed_get_entries (feed); i != NULL && success == TRUE; i = i->next) {
+		if (gdata_entry_get_id (GDATA_ENTRY (i->data)) != NULL)
+			success = upsert_entry (self->priv, GDATA_ENTRY (i->data), error);
+	}
+
+	g_mutex_unlock (&(self->priv->mutex));
+
+	return success;
+}
+
+/**
+ * gdata_entry_store_remove:
+ * @self: a #GDataEntryStore
+ * @id: the ID of the entry to remove
+ * @error: a #GError, or %NULL
+ *
+ * Removes the entry with the given @id from the store. It isn't an error if there's no such entry.
+ *
+ * Return value: %TRUE on success, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_entry_store_remove (GDataEntryStore *self, const gchar *id, GError **error)
+{
+	GDataEntryStorePrivate *priv;
+	StoreRecord record;
+	gboolean success = TRUE;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_STORE (self), FALSE);
+	g_return_val_if_fail (id != NULL && *id != '\0', FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	priv = self->priv;
+	g_mutex_lock (&(priv->mutex));
+
+	if (ensure_record_mapped (priv, id, error) == FALSE)
+		success = FALSE;
+	else if (find_live_record (priv, id, &record) == TRUE)
+		success = append_record (priv, RECORD_DELETED, -1, id, NULL, NULL, TRUE, error);
+
+	g_mutex_unlock (&(priv->mutex));
+
+	return success;
+}
+
+static GDataEntry *
+record_to_entry (GDataEntryStorePrivate *priv, const StoreRecord *record, GError **error)
+{
+	GBytes *map_bytes, *data;
+	GDataParsable *parsable;
+
+	/* The entry data is referenced straight from the mapping, rather than copied */
+	map_bytes = g_mapped_file_get_bytes (priv->data_map);
+	data = g_bytes_new_from_bytes (map_bytes, record->data - (const guint8 *) g_mapped_file_get_contents (priv->data_map),
+	                               record->data_length);
+	g_bytes_unref (map_bytes);
+
+	parsable = gdata_parsable_new_from_binary (GDATA_TYPE_ENTRY, data, error);
+	g_bytes_unref (data);
+
+	return (parsable != NULL) ? GDATA_ENTRY (parsable) : NULL;
+}
+
+/**
+ * gdata_entry_store_lookup:
+ * @self: a #GDataEntryStore
+ * @id: the ID of the entry to look up
+ * @error: a #GError, or %NULL
+ *
+ * Looks up the entry with the given @id in the store. If there's no such entry, %NULL is returned without setting @error.
+ *
+ * The returned entry is of the same type as the entry which was stored, which must already have been registered with the type system (as
+ * described for gdata_parsable_new_from_binary()).
+ *
+ * Return value: (transfer full) (allow-none): the stored entry, or %NULL; unref with g_object_unref()
+ *
+ * Since: 0.17.9
+ */
+GDataEntry *
+gdata_entry_store_lookup (GDataEntryStore *self, const gchar *id, GError **error)
+{
+	GDataEntryStorePrivate *priv;
+	StoreRecord record;
+	GDataEntry *entry = NULL;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_STORE (self), NULL);
+	g_return_val_if_fail (id != NULL, NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	priv = self->priv;
+	g_mutex_lock (&(priv->mutex));
+
+	if (ensure_data_mapped (priv, error) == TRUE && find_live_record (priv, id, &record) == TRUE)
+		entry = record_to_entry (priv, &record, error);
+
+	g_mutex_unlock (&(priv->mutex));
+
+	return entry;
+}
+
+/**
+ * gdata_entry_store_dup_etag:
+ * @self: a #GDataEntryStore
+ * @id: the ID of the entry to look up
+ *
+ * Gets the #GDataEntry:etag of the entry with the given @id in the store, without deserialising the entry. This can be used to make a
+ * conditional request to check whether the stored entry is still up to date.
+ *
+ * Return value: (allow-none): the stored entry's ETag, or %NULL if there's no such entry or it has no ETag; free with g_free()
+ *
+ * Since: 0.17.9
+ */
+gchar *
+gdata_entry_store_dup_etag (GDataEntryStore *self, const gchar *id)
+{
+	GDataEntryStorePrivate *priv;
+	StoreRecord record;
+	gchar *etag = NULL;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_STORE (self), NULL);
+	g_return_val_if_fail (id != NULL, NULL);
+
+	priv = self->priv;
+	g_mutex_lock (&(priv->mutex));
+
+	if (ensure_data_mapped (priv, NULL) == TRUE && find_live_record (priv, id, &record) == TRUE && record.etag_length > 0)
+		etag = g_strndup (record.etag, record.etag_length);
+
+	g_mutex_unlock (&(priv->mutex));
+
+	return etag;
+}
+
+static gint
+compare_scan_matches (gconstpointer a, gconstpointer b)
+{
+	const ScanMatch *match_a = a, *match_b = b;
+
+	if (match_a->updated != match_b->updated)
+		return (match_a->updated < match_b->updated) ? -1 : 1;
+	else if (match_a->offset != match_b->offset)
+		return (match_a->offset < match_b->offset) ? -1 : 1;
+
+	return 0;
+}
+
+/* Finds the live records updated in [@updated_min, @updated_max), sorted by updated time. Either bound may be -1 to leave it open. The data
+ * file must have been mapped with ensure_data_mapped(). */
+static GArray *
+scan_records (GDataEntryStorePrivate *priv, gint64 updated_min, gint64 updated_max)
+{
+	GArray *matches;
+	GHashTableIter iter;
+	gpointer value;
+	guint64 lower, upper;
+
+	matches = g_array_new (FALSE, FALSE, sizeof (ScanMatch));
+
+	/* Binary search the index for the first entry at or after @updated_min */
+	lower = 0;
+	upper = priv->index.n_entries;
+
+	while (updated_min != -1 && lower < upper) {
+		guint64 middle = lower + (upper - lower) / 2;
+
+		if ((gint64) read_uint64 (priv->index.entries + middle * INDEX_ENTRY_LENGTH) < updated_min)
+			lower = middle + 1;
+		else
+			upper = middle;
+	}
+
+	for (; lower < priv->index.n_entries; lower++) {
+		const guint8 *index_entry = priv->index.entries + lower * INDEX_ENTRY_LENGTH;
+		StoreRecord record;
+		ScanMatch match;
+		gchar *id;
+		gboolean superseded;
+
+		match.updated = (gint64) read_uint64 (index_entry);
+		match.offset = read_uint64 (index_entry + 8);
+
+		if (updated_max != -1 && match.updated >= updated_max)
+			break;
+
+		/* Skip entries which have been updated or removed since the index was written; they're handled below */
+		if (parse_record (priv, match.offset, &record) == FALSE)
+			continue;
+
+		id = g_strndup (record.id, record.id_length);
+		superseded = g_hash_table_contains (priv->overlay, id);
+		g_free (id);
+
+		if (superseded == FALSE)
+			g_array_append_val (matches, match);
+	}
+
+	g_hash_table_iter_init (&iter, priv->overlay);
+
+	while (g_hash_table_iter_next (&iter, NULL, &value) == TRUE) {
+		StoreRecord record;
+		ScanMatch match;
+
+		if (parse_record (priv, *((guint64 *) value), &record) == FALSE || (record.flags & RECORD_DELETED) != 0 ||
+		    (updated_min != -1 && record.updated < updated_min) || (updated_max != -1 && record.updated >= updated_max)) {
+			continue;
+		}
+
+		match.updated = record.updated;
+		match.offset = record.offset;
+		g_array_append_val (matches, match);
+	}
+
+	g_array_sort (matches, compare_scan_matches);
+
+	return matches;
+}
+
+/**
+ * gdata_entry_store_scan_updated:
+ * @self: a #GDataEntryStore
+ * @updated_min: the earliest #GDataEntry:updated time of entries to return (inclusive), or -1
+ * @updated_max: the latest #GDataEntry:updated time of entries to return (exclusive), or -1
+ * @error: a #GError, or %NULL
+ *
+ * Gets the entries in the store which were last updated in the given time range, in ascending order of #GDataEntry:updated time. Either
+ * bound may be -1 to leave that end of the range open, so passing -1 for both returns all the entries in the store.
+ *
+ * The bounds are interpreted in the same way as #GDataQuery:updated-min and #GDataQuery:updated-max.
+ *
+ * Return value: (transfer full) (element-type GData.Entry): a list of the matching entries, or %NULL; free with
+ * <literal>g_list_free_full (list, g_object_unref)</literal>
+ *
+ * Since: 0.17.9
+ */
+GList *
+gdata_entry_store_scan_updated (GDataEntryStore *self, gint64 updated_min, gint64 updated_max, GError **error)
+{
+	GDataEntryStorePrivate *priv;
+	GArray *matches;
+	GList *entries = NULL;
+	guint i;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_STORE (self), NULL);
+	g_return_val_if_fail (updated_min >= -1, NULL);
+	g_return_val_if_fail (updated_max >= -1, NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	priv = self->priv;
+	g_mutex_lock (&(priv->mutex));
+
+	if (ensure_data_mapped (priv, error) == FALSE) {
+		g_mutex_unlock (&(priv->mutex));
+		return NULL;
+	}
+
+	matches = scan_records (priv, updated_min, updated_max);
+
+	for (i = 0; i < matches->len; i++) {
+		StoreRecord record;
+		GDataEntry *entry;
+
+		if (parse_record (priv, g_array_index (matches, ScanMatch, i).offset, &record) == FALSE)
+			continue;
+
+		entry = record_to_entry (priv, &record, error);
+		if (entry == NULL) {
+			g_list_free_full (entries, g_object_unref);
+			entries = NULL;
+			break;
+		}
+
+		entries = g_list_prepend (entries, entry);
+	}
+
+	g_array_free (matches, TRUE);
+	g_mutex_unlock (&(priv->mutex));
+
+	return g_list_reverse (entries);
+}
+
+static gboolean
+write_index (GDataEntryStorePrivate *priv, GError **error)
+{
+	GArray *matches;
+	StoreIndex index = { NULL, };
+	guint8 *contents, *buckets, *entries;
+	guint32 n_buckets, mask;
+	gsize length;
+	guint i;
+	gboolean success;
+
+	if (ensure_data_mapped (priv, error) == FALSE)
+		return FALSE;
+
+	matches = scan_records (priv, -1, -1);
+
+	/* Keep the load factor at most 0.5 */
+	for (n_buckets = MIN_BUCKETS; n_buckets < (guint64) matches->len * 2; n_buckets *= 2);
+	mask = n_buckets - 1;
+
+	length = INDEX_HEADER_LENGTH + (gsize) n_buckets * 8 + (gsize) matches->len * INDEX_ENTRY_LENGTH;
+	contents = g_malloc0 (length);
+	buckets = contents + INDEX_HEADER_LENGTH;
+	entries = buckets + (gsize) n_buckets * 8;
+
+	memcpy (contents, INDEX_MAGIC, 8);
+	write_uint32 (contents + 8, FORMAT_VERSION);
+	write_uint32 (contents + 12, priv->generation);
+	write_uint64 (contents + 16, priv->data_length);
+	write_uint32 (contents + 24, n_buckets);
+	write_uint64 (contents + 32, matches->len);
+
+	for (i = 0; i < matches->len; i++) {
+		const ScanMatch *match = &g_array_index (matches, ScanMatch, i);
+		StoreRecord record;
+		guint32 bucket;
+
+		/* scan_records() only returns valid records */
+		parse_record (priv, match->offset, &record);
+
+		for (bucket = hash_id (record.id, record.id_length) & mask; read_uint64 (buckets + bucket * 8) != 0; bucket = (bucket + 1) & mask);
+		write_uint64 (buckets + bucket * 8, match->offset);
+
+		write_uint64 (entries + i * INDEX_ENTRY_LENGTH, (guint64) match->updated);
+		write_uint64 (entries + i * INDEX_ENTRY_LENGTH + 8, match->offset);
+	}
+
+	g_array_free (matches, TRUE);
+
+	/* g_file_set_contents() replaces the file atomically, so a crash can't leave a half-written index */
+	success = g_file_set_contents (priv->index_filename, (const gchar *) contents, length, error);
+	g_free (contents);
+
+	if (success == FALSE)
+		return FALSE;
+
+	/* Switch to the new index. If it can't be loaded for some reason, keep using the old one and the in-memory index, which are still
+	 * consistent with the data file. */
+	if (load_index (priv, &index) == FALSE) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED, _("The index of the entry store ‘%s’ couldn’t be loaded."), priv->filename);
+		return FALSE;
+	}
+
+	clear_index (&(priv->index));
+	priv->index = index;
+	g_hash_table_remove_all (priv->overlay);
+
+	return TRUE;
+}
+
+/**
+ * gdata_entry_store_flush:
+ * @self: a #GDataEntryStore
+ * @error: a #GError, or %NULL
+ *
+ * Rewrites the store's index file to cover all the changes made to the store, so that it can be opened quickly next time. This should be
+ * called after making a batch of changes, and before closing the store.
+ *
+ * Changes are written to the data file as they're made, so they aren't lost if this isn't called; but they have to be re-read from the data
+ * file when the store is next opened.
+ *
+ * Return value: %TRUE on success, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_entry_store_flush (GDataEntryStore *self, GError **error)
+{
+	gboolean success;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_STORE (self), FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	g_mutex_lock (&(self->priv->mutex));
+	success = write_index (self->priv, error);
+	g_mutex_unlock (&(self->priv->mutex));
+
+	return success;
+}
+
+/**
+ * gdata_entry_store_compact:
+ * @self: a #GDataEntryStore
+ * @error: a #GError, or %NULL
+ *
+ * Rewrites the store's data file to contain only the current version of each entry, discarding superseded and removed entries, and then
+ * rewrites the index as with gdata_entry_store_flush(). Entries are written in order of their update time, so that scanning them with
+ * gdata_entry_store_scan_updated() reads the data file sequentially.
+ *
+ * The new data file replaces the old one atomically, so the store isn't lost if compaction fails part-way through. If the store can't be
+ * re-opened afterwards, all further operations on it will fail with %G_IO_ERROR_CLOSED.
+ *
+ * Return value: %TRUE on success, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_entry_store_compact (GDataEntryStore *self, GError **error)
+{
+	GDataEntryStorePrivate *priv;
+	GFile *file;
+	GFileOutputStream *output_stream;
+	GArray *matches;
+	guint32 generation;
+	guint i;
+	gboolean success = FALSE;
+
+	g_return_val_if_fail (GDATA_IS_ENTRY_STORE (self), FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	priv = self->priv;
+	g_mutex_lock (&(priv->mutex));
+
+	if (ensure_data_mapped (priv, error) == FALSE)
+		goto done;
+
+	file = g_file_new_for_path (priv->filename);
+	output_stream = g_file_replace (file, NULL, FALSE, G_FILE_CREATE_NONE, NULL, error);
+	g_object_unref (file);
+
+	if (output_stream == NULL)
+		goto done;
+
+	/* A new generation invalidates the old index, in case we crash before the new one is written */
+	do {
+		generation = g_random_int ();
+	} while (generation == priv->generation);
+
+	matches = scan_records (priv, -1, -1);
+	success = write_data_header (G_OUTPUT_STREAM (output_stream), generation, error);
+
+	for (i = 0; i < matches->len && success == TRUE; i++) {
+		StoreRecord record;
+
+		/* Records are position-independent, so can be copied verbatim */
+		parse_record (priv, g_array_index (matches, ScanMatch, i).offset, &record);
+		success = g_output_stream_write_all (G_OUTPUT_STREAM (output_stream),
+		                                     (const guint8 *) g_mapped_file_get_contents (priv->data_map) + record.offset,
+		                                     record.length, NULL, NULL, error);
+	}
+
+	g_array_free (matches, TRUE);
+
+	if (success == FALSE) {
+		GCancellable *cancellable;
+
+		/* Closing a replacement stream with a cancelled cancellable leaves the original file in place */
+		cancellable = g_cancellable_new ();
+		g_cancellable_cancel (cancellable);
+		g_output_stream_close (G_OUTPUT_STREAM (output_stream), cancellable, NULL);
+		g_object_unref (cancellable);
+		g_object_unref (output_stream);
+
+		goto done;
+	}
+
+	/* This is where the new data file replaces the old one */
+	success = g_output_stream_close (G_OUTPUT_STREAM (output_stream), NULL, error);
+	g_object_unref (output_stream);
+
+	if (success == FALSE)
+		goto done;
+
+	/* Re-open the new data file, and index it */
+	close_store (priv);
+	success = (open_store (priv, error) == TRUE && write_index (priv, error) == TRUE);
+
+done:
+	g_mutex_unlock (&(priv->mutex));
+
+	return success;
+}
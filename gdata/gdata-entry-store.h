@@ -0,0 +1,94 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ * Copyright (C) Philip Withnall 2017 <philip@tecnocode.co.uk>
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GDATA_ENTRY_STORE_H
+#define GDATA_ENTRY_STORE_H
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <gdata/gdata-entry.h>
+#include <gdata/gdata-feed.h>
+
+G_BEGIN_DECLS
+
+#define GDATA_TYPE_ENTRY_STORE			(gdata_entry_store_get_type ())
+#define GDATA_ENTRY_STORE(o)			(G_TYPE_CHECK_INSTANCE_CAST ((o), GDATA_TYPE_ENTRY_STORE, GDataEntryStore))
+#define GDATA_ENTRY_STORE_CLASS(k)		(G_TYPE_CHECK_CLASS_CAST((k), GDATA_TYPE_ENTRY_STORE, GDataEntryStoreClass))
+#define GDATA_IS_ENTRY_STORE(o)			(G_TYPE_CHECK_INSTANCE_TYPE ((o), GDATA_TYPE_ENTRY_STORE))
+#define GDATA_IS_ENTRY_STORE_CLASS(k)		(G_TYPE_CHECK_CLASS_TYPE ((k), GDATA_TYPE_ENTRY_STORE))
+#define GDATA_ENTRY_STORE_GET_CLASS(o)		(G_TYPE_INSTANCE_GET_CLASS ((o), GDATA_TYPE_ENTRY_STORE, GDataEntryStoreClass))
+
+typedef struct _GDataEntryStorePrivate	GDataEntryStorePrivate;
+
+/**
+ * GDataEntryStore:
+ *
+ * All the fields in the #GDataEntryStore structure are private and should never be accessed directly.
+ *
+ * Since: 0.17.9
+ */
+typedef struct {
+	GObject parent;
+	GDataEntryStorePrivate *priv;
+} GDataEntryStore;
+
+/**
+ * GDataEntryStoreClass:
+ *
+ * All the fields in the #GDataEntryStoreClass structure are private and should never be accessed directly.
+ *
+ * Since: 0.17.9
+ */
+typedef struct {
+	/*< private >*/
+	GObjectClass parent;
+
+	/*< private >*/
+	/* Padding for future expansion */
+	void (*_g_reserved0) (void);
+	void (*_g_reserved1) (void);
+	void (*_g_reserved2) (void);
+	void (*_g_reserved3) (void);
+	void (*_g_reserved4) (void);
+	void (*_g_reserved5) (void);
+} GDataEntryStoreClass;
+
+GType gdata_entry_store_get_type (void) G_GNUC_CONST;
+
+GDataEntryStore *gdata_entry_store_new (const gchar *filename, GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+
+const gchar *gdata_entry_store_get_filename (GDataEntryStore *self) G_GNUC_PURE;
+guint gdata_entry_store_get_n_entries (GDataEntryStore *self);
+
+gboolean gdata_entry_store_upsert (GDataEntryStore *self, GDataEntry *entry, GError **error);
+gboolean gdata_entry_store_upsert_feed (GDataEntryStore *self, GDataFeed *feed, GError **error);
+gboolean gdata_entry_store_remove (GDataEntryStore *self, const gchar *id, GError **error);
+
+GDataEntry *gdata_entry_store_lookup (GDataEntryStore *self, const gchar *id, GError **error) G_GNUC_WARN_UNUSED_RESULT;
+gchar *gdata_entry_store_dup_etag (GDataEntryStore *self, const gchar *id) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+GList *gdata_entry_store_scan_updated (GDataEntryStore *self, gint64 updated_min, gint64 updated_max,
+                                       GError **error) G_GNUC_WARN_UNUSED_RESULT;
+
+gboolean gdata_entry_store_flush (GDataEntryStore *self, GError **error);
+gboolean gdata_entry_store_compact (GDataEntryStore *self, GError **error);
+
+G_END_DECLS
+
+#endif /* !GDATA_ENTRY_STORE_H */
@@ -58,6 +58,8 @@ static void get_namespaces (GDataParsable *parsable, GHashTable *namespaces);
 static gchar *get_entry_uri (const gchar *id) G_GNUC_WARN_UNUSED_RESULT;
 static gboolean parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GError **error);
 static void get_json (GDataParsable *parsable, JsonBuilder *builder);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 
 struct _GDataEntryPrivate {
 	gchar *title;
@@ -66,11 +68,11 @@ struct _GDataEntryPrivate {
 	gchar *etag;
 	gint64 updated;
 	gint64 published;
-	GList *categories; /* GDataCategory */
+	GDataComparableList categories; /* GDataCategory */
 	gchar *content;
 	gboolean content_is_uri;
-	GList *links; /* GDataLink */
-	GList *authors; /* GDataAuthor */
+	GDataComparableList links; /* GDataLink */
+	GDataComparableList authors; /* GDataAuthor */
 	gchar *rights;
 
 	/* Batch processing data */
@@ -267,6 +269,8 @@ gdata_entry_class_init (GDataEntryClass *klass)
 	                                                      "Rights", "The ownership rights pertaining to the entry.",
 	                                                      NULL,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static void
@@ -301,23 +305,11 @@ gdata_entry_dispose (GObject *object)
 {
 	GDataEntryPrivate *priv = GDATA_ENTRY (object)->priv;
 
-	if (priv->categories != NULL) {
-		g_list_foreach (priv->categories, (GFunc) g_object_unref, NULL);
-		g_list_free (priv->categories);
-	}
-	priv->categories = NULL;
+	_gdata_comparable_list_clear (&priv->categories);
 
-	if (priv->links != NULL) {
-		g_list_foreach (priv->links, (GFunc) g_object_unref, NULL);
-		g_list_free (priv->links);
-	}
-	priv->links = NULL;
+	_gdata_comparable_list_clear (&priv->links);
 
-	if (priv->authors != NULL) {
-		g_list_foreach (priv->authors, (GFunc) g_object_unref, NULL);
-		g_list_free (priv->authors);
-	}
-	priv->authors = NULL;
+	_gdata_comparable_list_clear (&priv->authors);
 
 	/* Chain up to the parent class */
 	G_OBJECT_CLASS (gdata_entry_parent_class)->dispose (object);
@@ -486,9 +478,9 @@ post_parse_xml (GDataParsable *parsable, gpointer user_data, GError **error)
 		return gdata_parser_error_required_element_missing ("updated", "entry", error);*/
 
 	/* Reverse our lists of stuff */
-	priv->categories = g_list_reverse (priv->categories);
-	priv->links = g_list_reverse (priv->links);
-	priv->authors = g_list_reverse (priv->authors);
+	_gdata_comparable_list_reverse (&priv->categories);
+	_gdata_comparable_list_reverse (&priv->links);
+	_gdata_comparable_list_reverse (&priv->authors);
 
 	return TRUE;
 }
@@ -539,13 +531,13 @@ get_xml (GDataParsable *parsable, GString *xml_string)
 			gdata_parser_string_append_escaped (xml_string, "<content type='text'>", priv->content, "</content>");
 	}
 
-	for (categories = priv->categories; categories != NULL; categories = categories->next)
+	for (categories = priv->categories.list; categories != NULL; categories = categories->next)
 		_gdata_parsable_get_xml (GDATA_PARSABLE (categories->data), xml_string, FALSE);
 
-	for (links = priv->links; links != NULL; links = links->next)
+	for (links = priv->links.list; links != NULL; links = links->next)
 		_gdata_parsable_get_xml (GDATA_PARSABLE (links->data), xml_string, FALSE);
 
-	for (authors = priv->authors; authors != NULL; authors = authors->next)
+	for (authors = priv->authors.list; authors != NULL; authors = authors->next)
 		_gdata_parsable_get_xml (GDATA_PARSABLE (authors->data), xml_string, FALSE);
 
 	/* Batch operation data */
@@ -666,7 +658,7 @@ get_json (GDataParsable *parsable, JsonBuilder *builder)
 	}
 
 	/* If we have a "kind" category, add that. */
-	for (i = priv->categories; i != NULL; i = i->next) {
+	for (i = priv->categories.list; i != NULL; i = i->next) {
 		GDataCategory *category = GDATA_CATEGORY (i->data);
 
 		if (g_strcmp0 (gdata_category_get_scheme (category), "http://schemas.google.com/g/2005#kind") == 0) {
@@ -689,6 +681,36 @@ get_json (GDataParsable *parsable, JsonBuilder *builder)
 	}
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	GDataEntryPrivate *priv = GDATA_ENTRY (parsable)->priv;
+
+	/* The ETag is also a construct property, but some subclasses (such as GDataAccessRule) ignore attempts to set it */
+	gdata_binary_writer_put_string (writer, priv->etag);
+	gdata_binary_writer_put_int (writer, priv->updated);
+	gdata_binary_writer_put_int (writer, priv->published);
+	gdata_binary_writer_put_parsable_list (writer, priv->categories.list);
+	gdata_binary_writer_put_parsable_list (writer, priv->links.list);
+	gdata_binary_writer_put_parsable_list (writer, priv->authors.list);
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	GDataEntryPrivate *priv = GDATA_ENTRY (parsable)->priv;
+
+	g_free (priv->etag);
+	priv->etag = gdata_binary_reader_dup_string (reader);
+	priv->updated = gdata_binary_reader_get_int (reader);
+	priv->published = gdata_binary_reader_get_int (reader);
+
+	/* Replace the kind category added in gdata_entry_constructed() */
+	_gdata_comparable_list_set (&priv->categories, gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_CATEGORY));
+	_gdata_comparable_list_set (&priv->links, gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_LINK));
+	_gdata_comparable_list_set (&priv->authors, gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_AUTHOR));
+}
+
 /**
  * gdata_entry_new:
  * @id: (allow-none): the entry's ID, or %NULL
@@ -737,6 +759,7 @@ gdata_entry_set_title (GDataEntry *self, const gchar *title)
 
 	g_free (self->priv->title);
 	self->priv->title = g_strdup (title);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "title");
 	g_object_notify (G_OBJECT (self), "title");
 }
 
@@ -773,6 +796,7 @@ gdata_entry_set_summary (GDataEntry *self, const gchar *summary)
 
 	g_free (self->priv->summary);
 	self->priv->summary = g_strdup (summary);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "summary");
 	g_object_notify (G_OBJECT (self), "summary");
 }
 
@@ -967,17 +991,16 @@ gdata_entry_add_category (GDataEntry *self, GDataCategory *category)
 		 * category.
 		 *
 		 * See: https://bugzilla.gnome.org/show_bug.cgi?id=707477 */
-		element = g_list_find_custom (self->priv->categories, category, (GCompareFunc) gdata_comparable_compare);
+		element = _gdata_comparable_list_find (&self->priv->categories, GDATA_COMPARABLE (category));
 		if (element != NULL) {
 			g_assert (GDATA_IS_CATEGORY (element->data));
 			g_object_unref (element->data);
-			self->priv->categories = g_list_delete_link (self->priv->categories, element);
+			_gdata_comparable_list_delete_link (&self->priv->categories, element);
 		}
 	}
 
 	/* Add the category if we don't already have it */
-	if (g_list_find_custom (self->priv->categories, category, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->categories = g_list_prepend (self->priv->categories, g_object_ref (category));
+	_gdata_comparable_list_add (&self->priv->categories, GDATA_COMPARABLE (category), TRUE);
 }
 
 /**
@@ -994,7 +1017,7 @@ GList *
 gdata_entry_get_categories (GDataEntry *self)
 {
 	g_return_val_if_fail (GDATA_IS_ENTRY (self), NULL);
-	return self->priv->categories;
+	return self->priv->categories.list;
 }
 
 /**
@@ -1011,7 +1034,7 @@ GList *
 gdata_entry_get_authors (GDataEntry *self)
 {
 	g_return_val_if_fail (GDATA_IS_ENTRY (self), NULL);
-	return self->priv->authors;
+	return self->priv->authors.list;
 }
 
 /**
@@ -1047,6 +1070,7 @@ gdata_entry_set_content (GDataEntry *self, const gchar *content)
 	self->priv->content_is_uri = FALSE;
 
 	g_object_freeze_notify (G_OBJECT (self));
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "content");
 	g_object_notify (G_OBJECT (self), "content");
 	g_object_notify (G_OBJECT (self), "content-uri");
 	g_object_thaw_notify (G_OBJECT (self));
@@ -1089,6 +1113,7 @@ gdata_entry_set_content_uri (GDataEntry *self, const gchar *content_uri)
 	self->priv->content_is_uri = TRUE;
 
 	g_object_freeze_notify (G_OBJECT (self));
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "content");
 	g_object_notify (G_OBJECT (self), "content");
 	g_object_notify (G_OBJECT (self), "content-uri");
 	g_object_thaw_notify (G_OBJECT (self));
@@ -1110,8 +1135,7 @@ gdata_entry_add_link (GDataEntry *self, GDataLink *_link)
 	g_return_if_fail (GDATA_IS_ENTRY (self));
 	g_return_if_fail (GDATA_IS_LINK (_link));
 
-	if (g_list_find_custom (self->priv->links, _link, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->links = g_list_prepend (self->priv->links, g_object_ref (_link));
+	_gdata_comparable_list_add (&self->priv->links, GDATA_COMPARABLE (_link), TRUE);
 }
 
 /**
@@ -1134,13 +1158,13 @@ gdata_entry_remove_link (GDataEntry *self, GDataLink *_link)
 	g_return_val_if_fail (GDATA_IS_ENTRY (self), FALSE);
 	g_return_val_if_fail (GDATA_IS_LINK (_link), FALSE);
 
-	i = g_list_find_custom (self->priv->links, _link, (GCompareFunc) gdata_comparable_compare);
+	i = _gdata_comparable_list_find (&self->priv->links, GDATA_COMPARABLE (_link));
 
 	if (i == NULL) {
 		return FALSE;
 	}
 
-	self->priv->links = g_list_delete_link (self->priv->links, i);
+	_gdata_comparable_list_delete_link (&self->priv->links, i);
 	g_object_unref (_link);
 
 	return TRUE;
@@ -1174,7 +1198,7 @@ gdata_entry_look_up_link (GDataEntry *self, const gchar *rel)
 	g_return_val_if_fail (GDATA_IS_ENTRY (self), NULL);
 	g_return_val_if_fail (rel != NULL, NULL);
 
-	element = g_list_find_custom (self->priv->links, rel, (GCompareFunc) link_compare_cb);
+	element = g_list_find_custom (self->priv->links.list, rel, (GCompareFunc) link_compare_cb);
 	if (element == NULL)
 		return NULL;
 	return GDATA_LINK (element->data);
@@ -1203,7 +1227,7 @@ gdata_entry_look_up_links (GDataEntry *self, const gchar *rel)
 	g_return_val_if_fail (GDATA_IS_ENTRY (self), NULL);
 	g_return_val_if_fail (rel != NULL, NULL);
 
-	for (i = self->priv->links; i != NULL; i = i->next) {
+	for (i = self->priv->links.list; i != NULL; i = i->next) {
 		const gchar *relation_type = gdata_link_get_relation_type (((GDataLink*) i->data));
 		if (strcmp (relation_type, rel) == 0)
 			results = g_list_prepend (results, i->data);
@@ -1228,8 +1252,7 @@ gdata_entry_add_author (GDataEntry *self, GDataAuthor *author)
 	g_return_if_fail (GDATA_IS_ENTRY (self));
 	g_return_if_fail (GDATA_IS_AUTHOR (author));
 
-	if (g_list_find_custom (self->priv->authors, author, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->authors = g_list_prepend (self->priv->authors, g_object_ref (author));
+	_gdata_comparable_list_add (&self->priv->authors, GDATA_COMPARABLE (author), TRUE);
 }
 
 /**
@@ -1283,6 +1306,7 @@ gdata_entry_set_rights (GDataEntry *self, const gchar *rights)
 
 	g_free (self->priv->rights);
 	self->priv->rights = g_strdup (rights);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "rights");
 	g_object_notify (G_OBJECT (self), "rights");
 }
 
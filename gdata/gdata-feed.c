@@ -60,6 +60,8 @@ static void _gdata_feed_add_author (GDataFeed *self, GDataAuthor *author);
 
 static gboolean parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GError **error);
 static gboolean post_parse_json (GDataParsable *parsable, gpointer user_data, GError **error);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 
 struct _GDataFeedPrivate {
 	GList *entries;
@@ -79,8 +81,29 @@ struct _GDataFeedPrivate {
 	guint total_results;
 	gchar *rights;
 	gchar *next_page_token;
+	gchar *next_sync_token; /* cursor for fetching only changes since this feed, as used by GDataSyncSession */
+
+	/* TRUE if the feed is a partial response (i.e. the query had a fields selector), in which case elements which are normally required
+	 * may legitimately be missing. */
+	gboolean is_partial;
+
+	/* <entry> elements seen while parsing, which are built into entries (possibly in parallel) by post_parse_xml() */
+	GArray/*<PendingEntry>*/ *pending_entries;
 };
 
+/* Feeds with at least this many entries have them built on a thread pool, if more than one processor is available. For smaller feeds, the
+ * cost of handing the entries to the worker threads outweighs the gain. */
+#define PARALLEL_ENTRIES_THRESHOLD 16
+
+typedef struct {
+	xmlDoc *doc;
+	xmlNode *node;
+	GDataEntry *entry;
+	GError *error;
+	GDataParseStatistics statistics; /* only used when built by the thread pool */
+	gboolean is_built; /* only used when built by the thread pool; protected by BuildPoolData.mutex */
+} PendingEntry;
+
 enum {
 	PROP_ID = 1,
 	PROP_ETAG,
@@ -314,6 +337,8 @@ gdata_feed_class_init (GDataFeedClass *klass)
 	                                                      "Next page token", "The next page token for feeds.",
 	                                                      NULL,
 	                                                      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static void
@@ -356,6 +381,11 @@ gdata_feed_dispose (GObject *object)
 		g_object_unref (priv->generator);
 	priv->generator = NULL;
 
+	/* Only non-NULL if parsing failed part-way through */
+	if (priv->pending_entries != NULL)
+		g_array_free (priv->pending_entries, TRUE);
+	priv->pending_entries = NULL;
+
 	/* Chain up to the parent class */
 	G_OBJECT_CLASS (gdata_feed_parent_class)->dispose (object);
 }
@@ -373,6 +403,7 @@ gdata_feed_finalize (GObject *object)
 	g_free (priv->icon);
 	g_free (priv->rights);
 	g_free (priv->next_page_token);
+	g_free (priv->next_sync_token);
 
 	/* Chain up to the parent class */
 	G_OBJECT_CLASS (gdata_feed_parent_class)->finalize (object);
@@ -430,28 +461,63 @@ gdata_feed_get_property (GObject *object, guint property_id, GValue *value, GPar
 	}
 }
 
+typedef struct _ProgressCallbackData ProgressCallbackData;
+
 typedef struct {
 	GType entry_type;
+	GDataQuery *query; /* owned; or %NULL */
 	GDataQueryProgressCallback progress_callback;
 	gpointer progress_user_data;
+	GDataQueryBatchProgressCallback batch_progress_callback;
+	gpointer batch_progress_user_data;
 	guint entry_i;
+	gboolean is_lite;
+
+	/* Progress callbacks are dispatched for batches of entries, rather than individually. @progress_batch holds the entries which haven't
+	 * been dispatched yet, and is dispatched once it reaches @progress_batch_size entries or its first entry was added @progress_latency
+	 * microseconds ago, and once parsing has finished. */
+	ProgressCallbackData *progress_batch;
+	gint64 progress_batch_start_time;
+	guint progress_batch_size;
+	gint64 progress_latency;
+	gboolean progress_in_thread;
 } ParseData;
 
+static void
+pending_entry_clear (PendingEntry *pending)
+{
+	g_clear_object (&pending->entry);
+	g_clear_error (&pending->error);
+}
+
 static gboolean
 pre_parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *root_node, gpointer user_data, GError **error)
 {
+	GDataFeedPrivate *priv = GDATA_FEED (parsable)->priv;
+	xmlChar *fields;
+
 	/* Extract the ETag */
-	GDATA_FEED (parsable)->priv->etag = (gchar*) xmlGetProp (root_node, (xmlChar*) "etag");
+	priv->etag = (gchar*) xmlGetProp (root_node, (xmlChar*) "etag");
+
+	/* Partial responses are marked with a gd:fields attribute on the root element, echoing the selector from the query.
+	 * See: https://developers.google.com/gdata/docs/2.0/reference#PartialResponse */
+	fields = xmlGetNsProp (root_node, (xmlChar*) "fields", (xmlChar*) "http://schemas.google.com/g/2005");
+	priv->is_partial = (fields != NULL);
+	xmlFree (fields);
+
 	return TRUE;
 }
 
-typedef struct {
+struct _ProgressCallbackData {
+	GDataQuery *query; /* owned; keeps @batch_progress_user_data alive */
 	GDataQueryProgressCallback progress_callback;
 	gpointer progress_user_data;
-	GDataEntry *entry;
-	guint entry_i;
+	GDataQueryBatchProgressCallback batch_progress_callback;
+	gpointer batch_progress_user_data;
+	GPtrArray/*<owned GDataEntry*>*/ *entries;
+	guint first_entry_i;
 	guint total_results;
-} ProgressCallbackData;
+};
 
 static gboolean
 parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *node, gpointer user_data, GError **error)
@@ -463,21 +529,32 @@ parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *node, gpointer user_da
 	if (gdata_parser_is_namespace (node, "http://www.w3.org/2005/Atom") == TRUE) {
 		if (xmlStrcmp (node->name, (xmlChar*) "entry") == 0) {
 			/* atom:entry */
-			GDataEntry *entry;
-			GType entry_type;
+			PendingEntry pending = { NULL, };
 
 			/* Allow @data to be %NULL, and assume we're parsing a vanilla feed, so that we can test #GDataFeed in tests/general.c.
 			 * A little hacky, but not too much so, and valuable for testing. */
-			entry_type = (data != NULL) ? data->entry_type : GDATA_TYPE_ENTRY;
-			entry = GDATA_ENTRY (_gdata_parsable_new_from_xml_node (entry_type, doc, node, NULL, error));
-			if (entry == NULL)
-				return FALSE;
+			if (data == NULL) {
+				GDataEntry *entry;
 
-			/* Calls the callbacks in the main thread */
-			if (data != NULL)
-				_gdata_feed_call_progress_callback (self, data, entry);
-			_gdata_feed_add_entry (self, entry);
-			g_object_unref (entry);
+				entry = GDATA_ENTRY (_gdata_parsable_new_from_xml_node (GDATA_TYPE_ENTRY, doc, node, NULL, error));
+				if (entry == NULL)
+					return FALSE;
+
+				_gdata_feed_add_entry (self, entry);
+				g_object_unref (entry);
+
+				return TRUE;
+			}
+
+			/* Otherwise, defer building the entry until post_parse_xml(), so that all the feed's entries can be built at once */
+			if (self->priv->pending_entries == NULL) {
+				self->priv->pending_entries = g_array_new (FALSE, FALSE, sizeof (PendingEntry));
+				g_array_set_clear_func (self->priv->pending_entries, (GDestroyNotify) pending_entry_clear);
+			}
+
+			pending.doc = doc;
+			pending.node = node;
+			g_array_append_val (self->priv->pending_entries, pending);
 		} else if (gdata_parser_string_from_element (node, "title", P_DEFAULT | P_NO_DUPES, &(self->priv->title), &success, error) == TRUE ||
 		           gdata_parser_string_from_element (node, "subtitle", P_NO_DUPES, &(self->priv->subtitle), &success, error) == TRUE ||
 		           gdata_parser_string_from_element (node, "id", P_REQUIRED | P_NON_EMPTY | P_NO_DUPES,
@@ -555,11 +632,132 @@ parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *node, gpointer user_da
 	return TRUE;
 }
 
+static void
+build_pending_entry (PendingEntry *pending, ParseData *data)
+{
+	GDataParsable *entry;
+
+	if (data->is_lite == TRUE)
+		entry = _gdata_parsable_new_lite_from_xml_node (data->entry_type, pending->doc, pending->node, NULL, &(pending->error));
+	else
+		entry = _gdata_parsable_new_from_xml_node (data->entry_type, pending->doc, pending->node, NULL, &(pending->error));
+
+	pending->entry = (entry != NULL) ? GDATA_ENTRY (entry) : NULL;
+}
+
+typedef struct {
+	ParseData *data;
+	GMutex mutex;
+	GCond cond; /* signalled when an entry is built */
+} BuildPoolData;
+
+/* Parse statistics are collected per-thread, so those for entries built by the thread pool are collected separately and added to the parsing
+ * thread's afterwards. */
+static void
+build_pending_entry_in_pool (PendingEntry *pending, BuildPoolData *pool_data)
+{
+	gdata_parse_statistics_start (&(pending->statistics));
+	build_pending_entry (pending, pool_data->data);
+	gdata_parse_statistics_stop (&(pending->statistics));
+
+	g_mutex_lock (&(pool_data->mutex));
+	pending->is_built = TRUE;
+	g_cond_broadcast (&(pool_data->cond));
+	g_mutex_unlock (&(pool_data->mutex));
+}
+
+/* Add a built entry to the feed and queue its progress callback, or propagate its error if it failed to build */
+static gboolean
+add_pending_entry (GDataFeed *self, ParseData *data, PendingEntry *pending, GError **error)
+{
+	if (pending->entry == NULL) {
+		if (pending->error != NULL) {
+			g_propagate_error (error, pending->error);
+			pending->error = NULL;
+		}
+
+		return FALSE;
+	}
+
+	/* Calls the callbacks in the main thread */
+	_gdata_feed_call_progress_callback (self, data, pending->entry);
+	_gdata_feed_add_entry (self, pending->entry);
+
+	return TRUE;
+}
+
+/* Build all the entries deferred by parse_xml() and add them to the feed in document order, stopping at the first which fails to build so that
+ * the same error is returned as when parsing serially. Each entry is built from a separate subtree of the document, so large feeds can be built
+ * in parallel; entries are still added from this thread, as soon as they and all the entries before them have been built, so the progress
+ * callbacks stay ordered without waiting for the whole feed. */
+static gboolean
+build_pending_entries (GDataFeed *self, ParseData *data, GError **error)
+{
+	GArray *pending_entries = self->priv->pending_entries;
+	gboolean success = TRUE;
+	guint i, n_threads;
+
+	n_threads = MIN ((guint) g_get_num_processors (), pending_entries->len);
+
+	if (pending_entries->len >= PARALLEL_ENTRIES_THRESHOLD && n_threads > 1) {
+		BuildPoolData pool_data;
+		GThreadPool *pool;
+
+		pool_data.data = data;
+		g_mutex_init (&(pool_data.mutex));
+		g_cond_init (&(pool_data.cond));
+
+		pool = g_thread_pool_new ((GFunc) build_pending_entry_in_pool, &pool_data, n_threads, FALSE, NULL);
+
+		for (i = 0; i < pending_entries->len; i++)
+			g_thread_pool_push (pool, &g_array_index (pending_entries, PendingEntry, i), NULL);
+
+		for (i = 0; i < pending_entries->len && success == TRUE; i++) {
+			PendingEntry *pending = &g_array_index (pending_entries, PendingEntry, i);
+
+			/* Wait for the entry to be built; the pool builds them roughly in order, so later ones are usually already done */
+			g_mutex_lock (&(pool_data.mutex));
+			while (pending->is_built == FALSE)
+				g_cond_wait (&(pool_data.cond), &(pool_data.mutex));
+			g_mutex_unlock (&(pool_data.mutex));
+
+			success = add_pending_entry (self, data, pending, error);
+		}
+
+		/* On failure, skip building any entries which haven't been started, but wait for those which have */
+		g_thread_pool_free (pool, (success == FALSE) ? TRUE : FALSE, TRUE);
+
+		g_cond_clear (&(pool_data.cond));
+		g_mutex_clear (&(pool_data.mutex));
+
+		for (i = 0; i < pending_entries->len; i++)
+			_gdata_parse_statistics_add (&(g_array_index (pending_entries, PendingEntry, i).statistics));
+	} else {
+		for (i = 0; i < pending_entries->len && success == TRUE; i++) {
+			PendingEntry *pending = &g_array_index (pending_entries, PendingEntry, i);
+
+			build_pending_entry (pending, data);
+			success = add_pending_entry (self, data, pending, error);
+		}
+	}
+
+	g_array_free (pending_entries, TRUE);
+	self->priv->pending_entries = NULL;
+
+	return success;
+}
+
 static gboolean
 post_parse_xml (GDataParsable *parsable, gpointer user_data, GError **error)
 {
 	GDataFeedPrivate *priv = GDATA_FEED (parsable)->priv;
 
+	/* Build the entries first, so that errors in them take precedence as they did when they were built during parsing. @user_data is
+	 * only guaranteed to be a ParseData if parse_xml() deferred some entries, since subclasses such as GDataBatchFeed handle their
+	 * entries themselves. */
+	if (priv->pending_entries != NULL && build_pending_entries (GDATA_FEED (parsable), user_data, error) == FALSE)
+		return FALSE;
+
 	/* Check for missing required elements */
 	/* FIXME: The YouTube comments feed seems to have lost its <feed/title> element, making it an invalid Atom feed and meaning
 	 * the check below has to be commented out.
@@ -567,9 +765,9 @@ post_parse_xml (GDataParsable *parsable, gpointer user_data, GError **error)
 	 * Discovered in: https://bugzilla.gnome.org/show_bug.cgi?id=679072#c12. */
 	/*if (priv->title == NULL)
 		return gdata_parser_error_required_element_missing ("title", "feed", error);*/
-	if (priv->id == NULL)
+	if (priv->id == NULL && priv->is_partial == FALSE)
 		return gdata_parser_error_required_element_missing ("id", "feed", error);
-	if (priv->updated == -1)
+	if (priv->updated == -1 && priv->is_partial == FALSE)
 		return gdata_parser_error_required_element_missing ("updated", "feed", error);
 
 	/* Reverse our lists of stuff */
@@ -667,6 +865,9 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 		GDATA_FEED (parsable)->priv->etag = g_strdup (json_reader_get_string_value (reader));
 	} else if (g_strcmp0 (json_reader_get_member_name (reader), "nextPageToken") == 0) {
 		GDATA_FEED (parsable)->priv->next_page_token = g_strdup (json_reader_get_string_value (reader));
+	} else if (g_strcmp0 (json_reader_get_member_name (reader), "nextSyncToken") == 0) {
+		/* https://developers.google.com/google-apps/calendar/v3/sync */
+		_gdata_feed_set_next_sync_token (GDATA_FEED (parsable), json_reader_get_string_value (reader));
 	} else {
 		return GDATA_PARSABLE_CLASS (gdata_feed_parent_class)->parse_json (parsable, reader, user_data, error);
 	}
@@ -685,6 +886,61 @@ post_parse_json (GDataParsable *parsable, gpointer user_data, GError **error)
 	return TRUE;
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	GDataFeedPrivate *priv = GDATA_FEED (parsable)->priv;
+
+	/* All of the feed's properties are read-only */
+	gdata_binary_writer_put_string (writer, priv->title);
+	gdata_binary_writer_put_string (writer, priv->subtitle);
+	gdata_binary_writer_put_string (writer, priv->id);
+	gdata_binary_writer_put_string (writer, priv->etag);
+	gdata_binary_writer_put_int (writer, priv->updated);
+	gdata_binary_writer_put_string (writer, priv->logo);
+	gdata_binary_writer_put_string (writer, priv->icon);
+	gdata_binary_writer_put_parsable (writer, GDATA_PARSABLE (priv->generator));
+	gdata_binary_writer_put_uint (writer, priv->items_per_page);
+	gdata_binary_writer_put_uint (writer, priv->start_index);
+	gdata_binary_writer_put_uint (writer, priv->total_results);
+	gdata_binary_writer_put_string (writer, priv->rights);
+	gdata_binary_writer_put_string (writer, priv->next_page_token);
+	gdata_binary_writer_put_string (writer, priv->next_sync_token);
+	gdata_binary_writer_put_boolean (writer, priv->is_partial);
+
+	gdata_binary_writer_put_parsable_list (writer, priv->categories);
+	gdata_binary_writer_put_parsable_list (writer, priv->links);
+	gdata_binary_writer_put_parsable_list (writer, priv->authors);
+	gdata_binary_writer_put_parsable_list (writer, priv->entries);
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	GDataFeedPrivate *priv = GDATA_FEED (parsable)->priv;
+
+	priv->title = gdata_binary_reader_dup_string (reader);
+	priv->subtitle = gdata_binary_reader_dup_string (reader);
+	priv->id = gdata_binary_reader_dup_string (reader);
+	priv->etag = gdata_binary_reader_dup_string (reader);
+	priv->updated = gdata_binary_reader_get_int (reader);
+	priv->logo = gdata_binary_reader_dup_string (reader);
+	priv->icon = gdata_binary_reader_dup_string (reader);
+	priv->generator = GDATA_GENERATOR (gdata_binary_reader_get_parsable (reader, GDATA_TYPE_GENERATOR));
+	priv->items_per_page = gdata_binary_reader_get_uint (reader);
+	priv->start_index = gdata_binary_reader_get_uint (reader);
+	priv->total_results = gdata_binary_reader_get_uint (reader);
+	priv->rights = gdata_binary_reader_dup_string (reader);
+	priv->next_page_token = gdata_binary_reader_dup_string (reader);
+	priv->next_sync_token = gdata_binary_reader_dup_string (reader);
+	priv->is_partial = gdata_binary_reader_get_boolean (reader);
+
+	priv->categories = gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_CATEGORY);
+	priv->links = gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_LINK);
+	priv->authors = gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_AUTHOR);
+	priv->entries = gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_ENTRY);
+}
+
 /* Internal helper method to set these properties. */
 void
 _gdata_feed_set_page_info (GDataFeed *self, guint total_results,
@@ -732,7 +988,7 @@ _gdata_feed_new (GType feed_type,
 }
 
 GDataFeed *
-_gdata_feed_new_from_xml (GType feed_type, const gchar *xml, gint length, GType entry_type,
+_gdata_feed_new_from_xml (GType feed_type, const gchar *xml, gint length, GType entry_type, GDataQuery *query,
                           GDataQueryProgressCallback progress_callback, gpointer progress_user_data, GError **error)
 {
 	ParseData *data;
@@ -741,9 +997,10 @@ _gdata_feed_new_from_xml (GType feed_type, const gchar *xml, gint length, GType
 	g_return_val_if_fail (g_type_is_a (feed_type, GDATA_TYPE_FEED), NULL);
 	g_return_val_if_fail (xml != NULL, NULL);
 	g_return_val_if_fail (g_type_is_a (entry_type, GDATA_TYPE_ENTRY), NULL);
+	g_return_val_if_fail (query == NULL || GDATA_IS_QUERY (query), NULL);
 	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
 
-	data = _gdata_feed_parse_data_new (entry_type, progress_callback, progress_user_data);
+	data = _gdata_feed_parse_data_new (entry_type, query, progress_callback, progress_user_data);
 	feed = GDATA_FEED (_gdata_parsable_new_from_xml (feed_type, xml, length, data, error));
 	_gdata_feed_parse_data_free (data);
 
@@ -751,7 +1008,7 @@ _gdata_feed_new_from_xml (GType feed_type, const gchar *xml, gint length, GType
 }
 
 GDataFeed *
-_gdata_feed_new_from_json (GType feed_type, const gchar *json, gint length, GType entry_type,
+_gdata_feed_new_from_json (GType feed_type, const gchar *json, gint length, GType entry_type, GDataQuery *query,
                           GDataQueryProgressCallback progress_callback, gpointer progress_user_data, GError **error)
 {
 	ParseData *data;
@@ -760,9 +1017,10 @@ _gdata_feed_new_from_json (GType feed_type, const gchar *json, gint length, GTyp
 	g_return_val_if_fail (g_type_is_a (feed_type, GDATA_TYPE_FEED), NULL);
 	g_return_val_if_fail (json != NULL, NULL);
 	g_return_val_if_fail (g_type_is_a (entry_type, GDATA_TYPE_ENTRY), NULL);
+	g_return_val_if_fail (query == NULL || GDATA_IS_QUERY (query), NULL);
 	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
 
-	data = _gdata_feed_parse_data_new (entry_type, progress_callback, progress_user_data);
+	data = _gdata_feed_parse_data_new (entry_type, query, progress_callback, progress_user_data);
 	feed = GDATA_FEED (_gdata_parsable_new_from_json (feed_type, json, length, data, error));
 	_gdata_feed_parse_data_free (data);
 
@@ -1117,6 +1375,31 @@ gdata_feed_get_next_page_token (GDataFeed *self)
 	return self->priv->next_page_token;
 }
 
+/*
+ * _gdata_feed_get_next_sync_token:
+ * @self: a #GDataFeed
+ *
+ * Returns the token which can be passed back to the service to retrieve only the entries which have changed since this feed was returned, or
+ * %NULL if the service didn't provide one. This is only set on the last page of a feed.
+ *
+ * Return value: (nullable): the next sync token
+ */
+const gchar *
+_gdata_feed_get_next_sync_token (GDataFeed *self)
+{
+	g_return_val_if_fail (GDATA_IS_FEED (self), NULL);
+	return self->priv->next_sync_token;
+}
+
+void
+_gdata_feed_set_next_sync_token (GDataFeed *self, const gchar *next_sync_token)
+{
+	g_return_if_fail (GDATA_IS_FEED (self));
+
+	g_free (self->priv->next_sync_token);
+	self->priv->next_sync_token = g_strdup (next_sync_token);
+}
+
 void
 _gdata_feed_add_entry (GDataFeed *self, GDataEntry *entry)
 {
@@ -1126,28 +1409,61 @@ _gdata_feed_add_entry (GDataFeed *self, GDataEntry *entry)
 }
 
 gpointer
-_gdata_feed_parse_data_new (GType entry_type, GDataQueryProgressCallback progress_callback, gpointer progress_user_data)
+_gdata_feed_parse_data_new (GType entry_type, GDataQuery *query, GDataQueryProgressCallback progress_callback, gpointer progress_user_data)
 {
 	ParseData *data;
-	data = g_slice_new (ParseData);
+	data = g_slice_new0 (ParseData);
 	data->entry_type = entry_type;
 	data->progress_callback = progress_callback;
 	data->progress_user_data = progress_user_data;
 	data->entry_i = 0;
 
+	if (query != NULL) {
+		data->query = g_object_ref (query);
+		data->is_lite = gdata_query_is_lite (query);
+		data->batch_progress_callback = _gdata_query_get_batch_progress_callback (query, &(data->batch_progress_user_data));
+		data->progress_batch_size = gdata_query_get_progress_batch_size (query);
+		data->progress_latency = gdata_query_get_progress_latency (query) * G_TIME_SPAN_MILLISECOND;
+		data->progress_in_thread = gdata_query_get_progress_in_thread (query);
+	} else {
+		data->is_lite = FALSE;
+		data->progress_batch_size = GDATA_QUERY_DEFAULT_PROGRESS_BATCH_SIZE;
+		data->progress_latency = GDATA_QUERY_DEFAULT_PROGRESS_LATENCY * G_TIME_SPAN_MILLISECOND;
+		data->progress_in_thread = FALSE;
+	}
+
 	return data;
 }
 
+static void dispatch_progress_callbacks (ParseData *data);
+
 void
-_gdata_feed_parse_data_free (gpointer data)
+_gdata_feed_parse_data_free (gpointer user_data)
 {
+	ParseData *data = user_data;
+
+	/* Dispatch any entries left over from parsing. This is done even if parsing failed, since the callbacks have always been called for
+	 * the entries parsed before the error. */
+	dispatch_progress_callbacks (data);
+
+	g_clear_object (&data->query);
 	g_slice_free (ParseData, data);
 }
 
 static gboolean
 progress_callback_idle (ProgressCallbackData *data)
 {
-	data->progress_callback (data->entry, data->entry_i, data->total_results, data->progress_user_data);
+	guint i;
+
+	if (data->batch_progress_callback != NULL)
+		data->batch_progress_callback (data->entries, data->first_entry_i, data->total_results, data->batch_progress_user_data);
+
+	if (data->progress_callback != NULL) {
+		for (i = 0; i < data->entries->len; i++) {
+			data->progress_callback (g_ptr_array_index (data->entries, i), data->first_entry_i + i, data->total_results,
+			                         data->progress_user_data);
+		}
+	}
 
 	return G_SOURCE_REMOVE;
 }
@@ -1155,26 +1471,31 @@ progress_callback_idle (ProgressCallbackData *data)
 static void
 progress_callback_data_free (ProgressCallbackData *data)
 {
-	g_object_unref (data->entry);
+	g_ptr_array_unref (data->entries);
+	if (data->query != NULL)
+		g_object_unref (data->query);
 	g_slice_free (ProgressCallbackData, data);
 }
 
-void
-_gdata_feed_call_progress_callback (GDataFeed *self, gpointer user_data, GDataEntry *entry)
+/* Dispatch the progress callbacks for the entries in the current batch, if any. */
+static void
+dispatch_progress_callbacks (ParseData *data)
 {
-	ParseData *data = user_data;
+	ProgressCallbackData *progress_data = data->progress_batch;
+	gint64 start_time = 0;
 
-	if (data->progress_callback != NULL) {
-		ProgressCallbackData *progress_data;
-
-		/* Build the data for the callback */
-		progress_data = g_slice_new (ProgressCallbackData);
-		progress_data->progress_callback = data->progress_callback;
-		progress_data->progress_user_data = data->progress_user_data;
-		progress_data->entry = g_object_ref (entry);
-		progress_data->entry_i = data->entry_i;
-		progress_data->total_results = MIN (self->priv->items_per_page, self->priv->total_results);
+	if (progress_data == NULL)
+		return;
+
+	data->progress_batch = NULL;
 
+	if (_gdata_parse_statistics_are_active () == TRUE)
+		start_time = g_get_monotonic_time ();
+
+	if (data->progress_in_thread == TRUE) {
+		progress_callback_idle (progress_data);
+		progress_callback_data_free (progress_data);
+	} else {
 		/* Send the callback; use G_PRIORITY_DEFAULT rather than G_PRIORITY_DEFAULT_IDLE
 		 * to contend with the priorities used by the callback functions in GAsyncResult */
 		g_main_context_invoke_full (NULL, G_PRIORITY_DEFAULT,
@@ -1182,6 +1503,41 @@ _gdata_feed_call_progress_callback (GDataFeed *self, gpointer user_data, GDataEn
 		                            progress_data,
 		                            (GDestroyNotify) progress_callback_data_free);
 	}
+
+	if (start_time != 0)
+		_gdata_parse_statistics_add_progress_callback_time (g_get_monotonic_time () - start_time);
+}
+
+void
+_gdata_feed_call_progress_callback (GDataFeed *self, gpointer user_data, GDataEntry *entry)
+{
+	ParseData *data = user_data;
+
+	if (data->progress_callback != NULL || data->batch_progress_callback != NULL) {
+		ProgressCallbackData *progress_data = data->progress_batch;
+		gint64 now = g_get_monotonic_time ();
+
+		/* Start a new batch if necessary */
+		if (progress_data == NULL) {
+			progress_data = g_slice_new (ProgressCallbackData);
+			progress_data->query = (data->query != NULL) ? g_object_ref (data->query) : NULL;
+			progress_data->progress_callback = data->progress_callback;
+			progress_data->progress_user_data = data->progress_user_data;
+			progress_data->batch_progress_callback = data->batch_progress_callback;
+			progress_data->batch_progress_user_data = data->batch_progress_user_data;
+			progress_data->entries = g_ptr_array_new_full (data->progress_batch_size, g_object_unref);
+			progress_data->first_entry_i = data->entry_i;
+
+			data->progress_batch = progress_data;
+			data->progress_batch_start_time = now;
+		}
+
+		g_ptr_array_add (progress_data->entries, g_object_ref (entry));
+		progress_data->total_results = MIN (self->priv->items_per_page, self->priv->total_results);
+
+		if (progress_data->entries->len >= data->progress_batch_size || now - data->progress_batch_start_time >= data->progress_latency)
+			dispatch_progress_callbacks (data);
+	}
 	data->entry_i++;
 }
 
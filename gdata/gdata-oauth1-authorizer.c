@@ -158,7 +158,11 @@ static void set_property (GObject *object, guint property_id, const GValue *valu
 static void process_request (GDataAuthorizer *self, GDataAuthorizationDomain *domain, SoupMessage *message);
 static gboolean is_authorized_for_domain (GDataAuthorizer *self, GDataAuthorizationDomain *domain);
 
-static void sign_message (GDataOAuth1Authorizer *self, SoupMessage *message, const gchar *token, const gchar *token_secret, GHashTable *parameters);
+typedef struct _SigningState SigningState;
+
+static SigningState *signing_state_new (const gchar *token, const gchar *token_secret);
+static void signing_state_free (SigningState *state);
+static void sign_message (GDataOAuth1Authorizer *self, SoupMessage *message, SigningState *state, GHashTable *parameters);
 
 static void notify_proxy_uri_cb (GObject *object, GParamSpec *pspec, GDataOAuth1Authorizer *self);
 static void notify_timeout_cb (GObject *gobject, GParamSpec *pspec, GObject *self);
@@ -181,6 +185,9 @@ struct _GDataOAuth1AuthorizerPrivate {
 	gchar *token;
 	GDataSecureString token_secret; /* must be allocated by _gdata_service_secure_strdup() */
 
+	/* Signing state derived from token and token_secret, built when first needed and freed whenever they change. NULL if not yet built. */
+	SigningState *signing_state;
+
 	/* Mapping from GDataAuthorizationDomain to itself; a set of domains for which ->access_token is valid. */
 	GHashTable *authorization_domains;
 };
@@ -348,6 +355,10 @@ finalize (GObject *object)
 	g_free (priv->token);
 	_gdata_service_secure_strfree (priv->token_secret);
 
+	if (priv->signing_state != NULL) {
+		signing_state_free (priv->signing_state);
+	}
+
 	/* Chain up to the parent class */
 	G_OBJECT_CLASS (gdata_oauth1_authorizer_parent_class)->finalize (object);
 }
@@ -428,7 +439,12 @@ process_request (GDataAuthorizer *self, GDataAuthorizationDomain *domain, SoupMe
 	g_assert ((priv->token == NULL) == (priv->token_secret == NULL));
 
 	if (priv->token != NULL && g_hash_table_lookup (priv->authorization_domains, domain) != NULL) {
-		sign_message (GDATA_OAUTH1_AUTHORIZER (self), message, priv->token, priv->token_secret, NULL);
+		/* The parts of the signature which only depend on the token are computed once, and reused for every request */
+		if (priv->signing_state == NULL) {
+			priv->signing_state = signing_state_new (priv->token, priv->token_secret);
+		}
+
+		sign_message (GDATA_OAUTH1_AUTHORIZER (self), message, priv->signing_state, NULL);
 	}
 
 	g_mutex_unlock (&(priv->mutex));
@@ -452,20 +468,134 @@ is_authorized_for_domain (GDataAuthorizer *self, GDataAuthorizationDomain *domai
 	return (token != NULL && result != NULL) ? TRUE : FALSE;
 }
 
+/* The parts of an OAuth 1.0 signature which only depend on the token, and so can be computed once per token rather than once per request.
+ * We always use an anonymous consumer key and secret (see sign_message()), so these are also constant. */
+struct _SigningState {
+	GPtrArray *static_params; /* owned; sorted, escaped "key=value" pairs for the signature base string */
+	gsize static_params_length; /* total length of static_params, including separators */
+	GHmac *hmac; /* owned; HMAC-SHA1 keyed with the signing key, copied to sign each request */
+	gchar *authorization_prefix; /* owned; Authorization header up to the start of the signature */
+};
+
+static gint
+compare_params (const gchar **a, const gchar **b)
+{
+	return strcmp (*a, *b);
+}
+
+static gchar *
+escape_param (const gchar *key, const gchar *value)
+{
+	GString *pair = g_string_new (NULL);
+
+	g_string_append_uri_escaped (pair, key, NULL, FALSE);
+	g_string_append_c (pair, '=');
+	g_string_append_uri_escaped (pair, value, NULL, FALSE);
+
+	return g_string_free (pair, FALSE);
+}
+
+static SigningState *
+signing_state_new (const gchar *token, const gchar *token_secret)
+{
+	SigningState *state;
+	const gchar *consumer_key, *consumer_secret, *signature_method;
+	GString *secret_string, *authorization_prefix;
+	guint i;
+
+	g_return_val_if_fail (token == NULL || *token != '\0', NULL);
+	g_return_val_if_fail (token_secret == NULL || *token_secret != '\0', NULL);
+	g_return_val_if_fail ((token == NULL) == (token_secret == NULL), NULL);
+
+	/* We always use HMAC-SHA1, since installed applications have to be unregistered
+	 * (see: http://code.google.com/apis/accounts/docs/OAuth_ref.html#SigningOAuth). */
+	signature_method = "HMAC-SHA1";
+
+	/* As described here, we use an anonymous consumer key and secret, since we're designed for installed applications:
+	 * http://code.google.com/apis/accounts/docs/OAuth_ref.html#SigningOAuth */
+	consumer_key = "anonymous";
+	consumer_secret = "anonymous";
+
+	state = g_slice_new0 (SigningState);
+
+	/* Escape and sort the parameters which are the same for every request, ready to be merged with the per-request ones */
+	state->static_params = g_ptr_array_new_with_free_func (g_free);
+	g_ptr_array_add (state->static_params, escape_param ("oauth_signature_method", signature_method));
+	g_ptr_array_add (state->static_params, escape_param ("oauth_consumer_key", consumer_key));
+	g_ptr_array_add (state->static_params, escape_param ("oauth_version", "1.0"));
+
+	/* Only add the token if it's been provided */
+	if (token != NULL) {
+		g_ptr_array_add (state->static_params, escape_param ("oauth_token", token));
+	}
+
+	g_ptr_array_sort (state->static_params, (GCompareFunc) compare_params);
+
+	for (i = 0; i < state->static_params->len; i++) {
+		state->static_params_length += strlen (state->static_params->pdata[i]) + 1 /* sep */;
+	}
+
+	/* Build the secret key to use in the HMAC */
+	secret_string = g_string_new (NULL);
+	g_string_append_uri_escaped (secret_string, consumer_secret, NULL, FALSE);
+	g_string_append_c (secret_string, '&');
+
+	/* Only add token_secret if it was provided */
+	if (token_secret != NULL) {
+		g_string_append_uri_escaped (secret_string, token_secret, NULL, FALSE);
+	}
+
+	/* Key the HMAC now, so that signing each request only has to copy its state rather than re-deriving it from the key */
+	state->hmac = g_hmac_new (G_CHECKSUM_SHA1, (const guchar*) secret_string->str, secret_string->len);
+
+	/* Zero out the secret_string before freeing it, to reduce the chance of secrets hitting disk. */
+	memset (secret_string->str, 0, secret_string->allocated_len);
+	g_string_free (secret_string, TRUE);
+
+	/* Build the start of the Authorization header */
+	authorization_prefix = g_string_new ("OAuth oauth_consumer_key=\"");
+	g_string_append_uri_escaped (authorization_prefix, consumer_key, NULL, FALSE);
+
+	/* Only add the token if it's been provided */
+	if (token != NULL) {
+		g_string_append (authorization_prefix, "\",oauth_token=\"");
+		g_string_append_uri_escaped (authorization_prefix, token, NULL, FALSE);
+	}
+
+	g_string_append (authorization_prefix, "\",oauth_signature_method=\"");
+	g_string_append_uri_escaped (authorization_prefix, signature_method, NULL, FALSE);
+	g_string_append (authorization_prefix, "\",oauth_signature=\"");
+
+	state->authorization_prefix = g_string_free (authorization_prefix, FALSE);
+
+	return state;
+}
+
+static void
+signing_state_free (SigningState *state)
+{
+	g_ptr_array_unref (state->static_params);
+	g_hmac_unref (state->hmac);
+	g_free (state->authorization_prefix);
+
+	g_slice_free (SigningState, state);
+}
+
 /* Sign the message and add the Authorization header to it containing the signature.
  * NOTE: This must not lock priv->mutex, as it's called from within a critical section in process_request() and priv->mutex isn't recursive. */
 static void
-sign_message (GDataOAuth1Authorizer *self, SoupMessage *message, const gchar *token, const gchar *token_secret, GHashTable *parameters)
+sign_message (GDataOAuth1Authorizer *self, SoupMessage *message, SigningState *state, GHashTable *parameters)
 {
 	GHashTableIter iter;
-	const gchar *key, *value, *consumer_key, *consumer_secret, *signature_method;
-	gsize params_length = 0;
-	GList *sorted_params = NULL, *i;
-	GString *query_string, *signature_base_string, *secret_string, *authorization_header;
+	const gchar *key, *value;
+	gsize params_length;
+	GPtrArray *request_params;
+	GString *query_string, *signature_base_string, *authorization_header;
 	SoupURI *normalised_uri;
-	gchar *uri, *signature, *timestamp;
+	gchar *uri, *signature;
+	gchar timestamp[32];
 	char *nonce;
-	gboolean is_first = TRUE;
+	guint i, j;
 	GTimeVal time_val;
 	guchar signature_buf[HMAC_SHA1_LEN];
 	gsize signature_buf_len;
@@ -473,76 +603,58 @@ sign_message (GDataOAuth1Authorizer *self, SoupMessage *message, const gchar *to
 
 	g_return_if_fail (GDATA_IS_OAUTH1_AUTHORIZER (self));
 	g_return_if_fail (SOUP_IS_MESSAGE (message));
-	g_return_if_fail (token == NULL || *token != '\0');
-	g_return_if_fail (token_secret == NULL || *token_secret != '\0');
-	g_return_if_fail ((token == NULL) == (token_secret == NULL));
+	g_return_if_fail (state != NULL);
 
-	/* Build and return a HMAC-SHA1 signature for the given SoupMessage. We always use HMAC-SHA1, since installed applications have to be
-	 * unregistered (see: http://code.google.com/apis/accounts/docs/OAuth_ref.html#SigningOAuth).
+	/* Build and return a HMAC-SHA1 signature for the given SoupMessage.
 	 * Reference: http://tools.ietf.org/html/rfc5849#section-3.4 */
-	signature_method = "HMAC-SHA1";
 
-	/* As described here, we use an anonymous consumer key and secret, since we're designed for installed applications:
-	 * http://code.google.com/apis/accounts/docs/OAuth_ref.html#SigningOAuth */
-	consumer_key = "anonymous";
-	consumer_secret = "anonymous";
-
-	/* Add various standard parameters to the list (note: this modifies the hash table belonging to the caller) */
+	/* Escape the parameters which differ for each request. The static parameters have already been escaped by signing_state_new(). */
 	nonce = oauth_gen_nonce ();
 	g_get_current_time (&time_val);
-	timestamp = g_strdup_printf ("%li", time_val.tv_sec);
+	g_snprintf (timestamp, sizeof (timestamp), "%li", time_val.tv_sec);
 
-	if (parameters == NULL) {
-		parameters = g_hash_table_new (g_str_hash, g_str_equal);
-	} else {
-		g_hash_table_ref (parameters);
-	}
+	request_params = g_ptr_array_new_with_free_func (g_free);
+	g_ptr_array_add (request_params, escape_param ("oauth_nonce", nonce));
+	g_ptr_array_add (request_params, escape_param ("oauth_timestamp", timestamp));
 
-	g_hash_table_insert (parameters, (gpointer) "oauth_signature_method", (gpointer) signature_method);
-	g_hash_table_insert (parameters, (gpointer) "oauth_consumer_key", (gpointer) consumer_key);
-	g_hash_table_insert (parameters, (gpointer) "oauth_nonce", nonce);
-	g_hash_table_insert (parameters, (gpointer) "oauth_timestamp", timestamp);
-	g_hash_table_insert (parameters, (gpointer) "oauth_version", (gpointer) "1.0");
+	/* Add the caller's parameters. These must not include any of the oauth_* parameters added above or in signing_state_new(). */
+	if (parameters != NULL) {
+		g_hash_table_iter_init (&iter, parameters);
 
-	/* Only add the token if it's been provided */
-	if (token != NULL) {
-		g_hash_table_insert (parameters, (gpointer) "oauth_token", (gpointer) token);
+		while (g_hash_table_iter_next (&iter, (gpointer*) &key, (gpointer*) &value) == TRUE) {
+			g_ptr_array_add (request_params, escape_param (key, value));
+		}
 	}
 
-	/* Sort the parameters and build a query string, as defined here: http://tools.ietf.org/html/rfc5849#section-3.4.1.3 */
-	g_hash_table_iter_init (&iter, parameters);
+	g_ptr_array_sort (request_params, (GCompareFunc) compare_params);
 
-	while (g_hash_table_iter_next (&iter, (gpointer*) &key, (gpointer*) &value) == TRUE) {
-		GString *pair = g_string_new (NULL);
+	params_length = state->static_params_length;
 
-		g_string_append_uri_escaped (pair, key, NULL, FALSE);
-		g_string_append_c (pair, '=');
-		g_string_append_uri_escaped (pair, value, NULL, FALSE);
-
-		/* Append the pair to the list for sorting, and keep track of the total length of the strings in the list so far */
-		params_length += pair->len + 1 /* sep */;
-		sorted_params = g_list_prepend (sorted_params, g_string_free (pair, FALSE));
+	for (i = 0; i < request_params->len; i++) {
+		params_length += strlen (request_params->pdata[i]) + 1 /* sep */;
 	}
 
-	g_hash_table_unref (parameters);
+	/* Merge the two sorted sets of parameters to give the query string, as defined here: http://tools.ietf.org/html/rfc5849#section-3.4.1.3 */
+	query_string = g_string_sized_new (params_length);
 
-	sorted_params = g_list_sort (sorted_params, (GCompareFunc) g_strcmp0);
+	for (i = 0, j = 0; i < state->static_params->len || j < request_params->len;) {
+		const gchar *param;
 
-	/* Concatenate the parameters to give the query string */
-	query_string = g_string_sized_new (params_length);
+		if (j >= request_params->len ||
+		    (i < state->static_params->len && strcmp (state->static_params->pdata[i], request_params->pdata[j]) <= 0)) {
+			param = state->static_params->pdata[i++];
+		} else {
+			param = request_params->pdata[j++];
+		}
 
-	for (i = sorted_params; i != NULL; i = i->next) {
-		if (is_first == FALSE) {
+		if (query_string->len > 0) {
 			g_string_append_c (query_string, '&');
 		}
 
-		g_string_append (query_string, i->data);
-
-		g_free (i->data);
-		is_first = FALSE;
+		g_string_append (query_string, param);
 	}
 
-	g_list_free (sorted_params);
+	g_ptr_array_unref (request_params);
 
 	/* Normalise the URI as described here: http://tools.ietf.org/html/rfc5849#section-3.4.1.2 */
 	normalised_uri = soup_uri_copy (soup_message_get_uri (message));
@@ -564,18 +676,9 @@ sign_message (GDataOAuth1Authorizer *self, SoupMessage *message, const gchar *to
 	soup_uri_free (normalised_uri);
 	g_string_free (query_string, TRUE);
 
-	/* Build the secret key to use in the HMAC */
-	secret_string = g_string_new (NULL);
-	g_string_append_uri_escaped (secret_string, consumer_secret, NULL, FALSE);
-	g_string_append_c (secret_string, '&');
-
-	/* Only add token_secret if it was provided */
-	if (token_secret != NULL) {
-		g_string_append_uri_escaped (secret_string, token_secret, NULL, FALSE);
-	}
-
-	/* Create the signature as described here: http://tools.ietf.org/html/rfc5849#section-3.4.2 */
-	signature_hmac = g_hmac_new (G_CHECKSUM_SHA1, (const guchar*) secret_string->str, secret_string->len);
+	/* Create the signature as described here: http://tools.ietf.org/html/rfc5849#section-3.4.2, starting from a copy of the already-keyed
+	 * HMAC */
+	signature_hmac = g_hmac_copy (state->hmac);
 	g_hmac_update (signature_hmac, (const guchar*) signature_base_string->str, signature_base_string->len);
 
 	signature_buf_len = G_N_ELEMENTS (signature_buf);
@@ -585,28 +688,12 @@ sign_message (GDataOAuth1Authorizer *self, SoupMessage *message, const gchar *to
 
 	signature = g_base64_encode (signature_buf, signature_buf_len);
 
-	/*g_debug ("Signing message using Signature Base String: “%s” and key “%s” using method “%s” to give signature: “%s”.",
-	         signature_base_string->str, secret_string->str, signature_method, signature);*/
-
-	/* Zero out the secret_string before freeing it, to reduce the chance of secrets hitting disk. */
-	memset (secret_string->str, 0, secret_string->allocated_len);
+	/*g_debug ("Signing message using Signature Base String: “%s” to give signature: “%s”.", signature_base_string->str, signature);*/
 
-	g_string_free (secret_string, TRUE);
 	g_string_free (signature_base_string, TRUE);
 
 	/* Build the Authorization header and append it to the message */
-	authorization_header = g_string_new ("OAuth oauth_consumer_key=\"");
-	g_string_append_uri_escaped (authorization_header, consumer_key, NULL, FALSE);
-
-	/* Only add the token if it's been provided */
-	if (token != NULL) {
-		g_string_append (authorization_header, "\",oauth_token=\"");
-		g_string_append_uri_escaped (authorization_header, token, NULL, FALSE);
-	}
-
-	g_string_append (authorization_header, "\",oauth_signature_method=\"");
-	g_string_append_uri_escaped (authorization_header, signature_method, NULL, FALSE);
-	g_string_append (authorization_header, "\",oauth_signature=\"");
+	authorization_header = g_string_new (state->authorization_prefix);
 	g_string_append_uri_escaped (authorization_header, signature, NULL, FALSE);
 	g_string_append (authorization_header, "\",oauth_timestamp=\"");
 	g_string_append_uri_escaped (authorization_header, timestamp, NULL, FALSE);
@@ -618,7 +705,6 @@ sign_message (GDataOAuth1Authorizer *self, SoupMessage *message, const gchar *to
 
 	g_string_free (authorization_header, TRUE);
 	free (signature);
-	g_free (timestamp);
 	free (nonce);
 }
 
@@ -735,6 +821,7 @@ gdata_oauth1_authorizer_request_authentication_uri (GDataOAuth1Authorizer *self,
 	gchar *request_body;
 	GString *scope_string, *authentication_uri;
 	GHashTable *parameters;
+	SigningState *state;
 	GHashTableIter iter;
 	gboolean is_first = TRUE;
 	GDataAuthorizationDomain *domain;
@@ -795,7 +882,9 @@ gdata_oauth1_authorizer_request_authentication_uri (GDataOAuth1Authorizer *self,
 
 	soup_message_set_request (message, "application/x-www-form-urlencoded", SOUP_MEMORY_TAKE, request_body, strlen (request_body));
 
-	sign_message (self, message, NULL, NULL, parameters);
+	state = signing_state_new (NULL, NULL);
+	sign_message (self, message, state, parameters);
+	signing_state_free (state);
 
 	g_hash_table_destroy (parameters);
 	g_string_free (scope_string, TRUE);
@@ -1041,6 +1130,7 @@ gdata_oauth1_authorizer_request_authorization (GDataOAuth1Authorizer *self, cons
 	guint status;
 	gchar *request_body;
 	GHashTable *parameters;
+	SigningState *state;
 	GHashTable *response_details;
 	const gchar *_token, *_token_secret;
 	SoupURI *_uri;
@@ -1072,7 +1162,9 @@ gdata_oauth1_authorizer_request_authorization (GDataOAuth1Authorizer *self, cons
 	soup_uri_free (_uri);
 	soup_message_set_request (message, "application/x-www-form-urlencoded", SOUP_MEMORY_TAKE, request_body, strlen (request_body));
 
-	sign_message (self, message, token, token_secret, parameters);
+	state = signing_state_new (token, token_secret);
+	sign_message (self, message, state, parameters);
+	signing_state_free (state);
 
 	g_hash_table_destroy (parameters);
 
@@ -1128,6 +1220,11 @@ gdata_oauth1_authorizer_request_authorization (GDataOAuth1Authorizer *self, cons
 	_gdata_service_secure_strfree (priv->token_secret);
 	priv->token_secret = _gdata_service_secure_strdup (_token_secret);
 
+	if (priv->signing_state != NULL) {
+		signing_state_free (priv->signing_state);
+		priv->signing_state = NULL;
+	}
+
 	g_mutex_unlock (&(priv->mutex));
 
 	/* Zero out the secret token before freeing the hash table, to reduce the chance of it hitting disk later. */
@@ -196,6 +196,11 @@ struct _GDataOAuth2AuthorizerPrivate {
 	gchar *access_token;  /* owned */
 	gchar *refresh_token;  /* owned */
 
+	/* Authorization header value for access_token, formatted the first
+	 * time it's needed and then reused for every request until the
+	 * access token changes. NULL if not yet formatted. */
+	gchar *authorization_header;  /* owned */
+
 	/* Mapping from GDataAuthorizationDomain to itself; a set of domains for
 	 * which ->access_token is valid. */
 	GHashTable *authentication_domains;  /* owned */
@@ -454,6 +459,7 @@ finalize (GObject *object)
 
 	g_free (priv->access_token);
 	g_free (priv->refresh_token);
+	g_free (priv->authorization_header);
 
 	g_hash_table_unref (priv->authentication_domains);
 	g_mutex_clear (&priv->mutex);
@@ -607,7 +613,6 @@ sign_message_locked (GDataOAuth2Authorizer *self, SoupMessage *message,
                      const gchar *access_token)
 {
 	SoupURI *message_uri;  /* unowned */
-	gchar *auth_header = NULL;  /* owned */
 
 	g_return_if_fail (GDATA_IS_OAUTH2_AUTHORIZER (self));
 	g_return_if_fail (SOUP_IS_MESSAGE (message));
@@ -627,11 +632,16 @@ sign_message_locked (GDataOAuth2Authorizer *self, SoupMessage *message,
 		return;
 	}
 
-	/* Add the authorisation header. */
-	auth_header = g_strdup_printf ("Bearer %s", access_token);
+	/* Add the authorisation header, formatting it only once per access
+	 * token. */
+	if (self->priv->authorization_header == NULL) {
+		self->priv->authorization_header = g_strdup_printf ("Bearer %s",
+		                                                    access_token);
+	}
+
 	soup_message_headers_append (message->request_headers,
-	                             "Authorization", auth_header);
-	g_free (auth_header);
+	                             "Authorization",
+	                             self->priv->authorization_header);
 }
 
 static gboolean
@@ -1014,6 +1024,7 @@ done:
 
 	g_free (priv->access_token);
 	priv->access_token = g_strdup (access_token);
+	g_clear_pointer (&priv->authorization_header, g_free);
 
 	if (refresh_token != NULL) {
 		g_free (priv->refresh_token);
@@ -1443,6 +1454,7 @@ gdata_oauth2_authorizer_set_refresh_token (GDataOAuth2Authorizer *self,
 	 *    (access_token != NULL) && (refresh_token == NULL) */
 	g_free (priv->access_token);
 	priv->access_token = NULL;
+	g_clear_pointer (&priv->authorization_header, g_free);
 
 	/* Update the refresh token. */
 	g_free (priv->refresh_token);
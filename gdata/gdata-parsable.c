@@ -37,10 +37,14 @@
 #include <string.h>
 #include <libxml/parser.h>
 #include <json-glib/json-glib.h>
+#include <gio/gio.h>
 
 #include "gdata-parsable.h"
+#include "gdata-entry.h"
 #include "gdata-private.h"
 #include "gdata-parser.h"
+#include "gdata-binary.h"
+#include "gdata-types.h"
 
 GQuark
 gdata_parser_error_quark (void)
@@ -56,14 +60,29 @@ static gboolean real_parse_json (GDataParsable *parsable, JsonReader *reader, gp
 static const gchar *get_content_type (void);
 
 struct _GDataParsablePrivate {
-	/* XML stuff. */
+	/* XML stuff. Both of these are %NULL until the parsable is given some XML it doesn't understand, which most never are. */
 	GString *extra_xml;
 	GHashTable *extra_namespaces;
 
-	/* JSON stuff. */
+	/* JSON stuff. Similarly, this is %NULL until it's needed. */
 	GHashTable/*<gchar*, owned JsonNode*>*/ *extra_json;
 
 	gboolean constructed_from_xml;
+
+	/* Change tracking for partial updates. Once the object has been parsed, calls to _gdata_parsable_mark_property_dirty() (from the setters
+	 * of its writeable properties) and _gdata_parsable_mark_dirty() add the name of the corresponding top-level XML element or JSON member
+	 * to @dirty_names, which is allocated lazily as most parsed objects are never modified. */
+	gboolean track_changes;
+	GHashTable/*<owned gchar*, owned gchar*>*/ *dirty_names;
+
+	/* Lite parsing. While @is_lite is set (only during parsing), subclasses may pass child elements to _gdata_parsable_defer_xml() rather
+	 * than building objects for them. Those elements are kept serialised in @deferred_xml, inside an opening tag declaring their namespaces,
+	 * until _gdata_parsable_materialise() parses them. @has_deferred is set while there are deferred elements, and is accessed atomically so
+	 * that materialised objects can be checked without locking; @deferred_xml is only accessed with materialise_mutex held once parsing
+	 * has finished. */
+	gboolean is_lite;
+	GString *deferred_xml;
+	volatile gint has_deferred;
 };
 
 enum {
@@ -72,6 +91,32 @@ enum {
 
 G_DEFINE_ABSTRACT_TYPE (GDataParsable, gdata_parsable, G_TYPE_OBJECT)
 
+G_DEFINE_QUARK (gdata-parsable-patch-name, patch_name)
+G_DEFINE_QUARK (gdata-parsable-binary-funcs, binary_funcs)
+G_DEFINE_QUARK (gdata-parsable-binary-properties, binary_properties)
+G_LOCK_DEFINE_STATIC (binary_properties);
+
+/* Held while materialising deferred elements, so that objects parsed in lite mode can be read from several threads at once, like any other
+ * parsed object. It's recursive so that the parse_xml functions can call accessors which try to materialise the object again. */
+static GRecMutex materialise_mutex;
+
+/* The GDataParseStatistics being collected in the current thread, innermost first. This is %NULL unless profiling has been started, so the
+ * counting costs a single thread-local lookup otherwise. */
+static GPrivate active_statistics = G_PRIVATE_INIT ((GDestroyNotify) g_slist_free);
+
+#define PARSE_STATISTICS_ADD(active, field, value) \
+	G_STMT_START { \
+		GSList *_l; \
+		for (_l = (active); _l != NULL; _l = _l->next) \
+			((GDataParseStatistics *) _l->data)->field += (value); \
+	} G_STMT_END
+
+/* Per-class binary serialisation functions, registered with _gdata_parsable_class_set_binary_funcs() */
+typedef struct {
+	GDataBinaryWriteFunc write_binary;
+	GDataBinaryReadFunc read_binary;
+} BinaryFuncs;
+
 static void
 gdata_parsable_class_init (GDataParsableClass *klass)
 {
@@ -106,12 +151,26 @@ gdata_parsable_init (GDataParsable *self)
 {
 	self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self, GDATA_TYPE_PARSABLE, GDataParsablePrivate);
 
-	self->priv->extra_xml = g_string_new ("");
-	self->priv->extra_namespaces = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+	/* extra_xml, extra_namespaces and extra_json are allocated on demand */
+	self->priv->constructed_from_xml = FALSE;
+}
+
+static GHashTable *
+ensure_extra_namespaces (GDataParsable *self)
+{
+	if (self->priv->extra_namespaces == NULL)
+		self->priv->extra_namespaces = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
 
-	self->priv->extra_json = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) json_node_free);
+	return self->priv->extra_namespaces;
+}
 
-	self->priv->constructed_from_xml = FALSE;
+static GHashTable *
+ensure_extra_json (GDataParsable *self)
+{
+	if (self->priv->extra_json == NULL)
+		self->priv->extra_json = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) json_node_free);
+
+	return self->priv->extra_json;
 }
 
 
@@ -152,15 +211,62 @@ gdata_parsable_finalize (GObject *object)
 {
 	GDataParsablePrivate *priv = GDATA_PARSABLE (object)->priv;
 
-	g_string_free (priv->extra_xml, TRUE);
-	g_hash_table_destroy (priv->extra_namespaces);
+	if (priv->extra_xml != NULL)
+		g_string_free (priv->extra_xml, TRUE);
+	if (priv->extra_namespaces != NULL)
+		g_hash_table_destroy (priv->extra_namespaces);
+
+	if (priv->extra_json != NULL)
+		g_hash_table_destroy (priv->extra_json);
+
+	if (priv->dirty_names != NULL)
+		g_hash_table_destroy (priv->dirty_names);
 
-	g_hash_table_destroy (priv->extra_json);
+	if (priv->deferred_xml != NULL)
+		g_string_free (priv->deferred_xml, TRUE);
 
 	/* Chain up to the parent class */
 	G_OBJECT_CLASS (gdata_parsable_parent_class)->finalize (object);
 }
 
+/* Convert a property name to the name of the element or member it's most likely serialised as: "file-as" becomes "fileAs". */
+static gchar *
+property_name_to_patch_name (const gchar *property_name)
+{
+	GString *name;
+	const gchar *i;
+
+	name = g_string_sized_new (strlen (property_name));
+
+	for (i = property_name; *i != '\0'; i++) {
+		if ((*i == '-' || *i == '_') && *(i + 1) != '\0') {
+			i++;
+			g_string_append_c (name, g_ascii_toupper (*i));
+		} else {
+			g_string_append_c (name, *i);
+		}
+	}
+
+	return g_string_free (name, FALSE);
+}
+
+/* Look up a patch name set with _gdata_parsable_class_set_patch_name() on the object's class or one of its ancestors, so that subclasses can
+ * override the names used by their parent classes (for example, #GDataCalendarEvent serialises #GDataEntry:title as "summary"). */
+static const gchar *
+look_up_patch_name (GDataParsable *self, const gchar *property_name)
+{
+	GType type;
+
+	for (type = G_OBJECT_TYPE (self); type != GDATA_TYPE_PARSABLE; type = g_type_parent (type)) {
+		GHashTable *patch_names = g_type_get_qdata (type, patch_name_quark ());
+
+		if (patch_names != NULL && g_hash_table_contains (patch_names, property_name) == TRUE)
+			return g_hash_table_lookup (patch_names, property_name);
+	}
+
+	return NULL;
+}
+
 static gboolean
 real_parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *node, gpointer user_data, GError **error)
 {
@@ -170,7 +276,11 @@ real_parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *node, gpointer us
 	/* Unhandled XML */
 	buffer = xmlBufferCreate ();
 	xmlNodeDump (buffer, doc, node, 0, 0);
-	g_string_append (parsable->priv->extra_xml, (gchar*) xmlBufferContent (buffer));
+	if (parsable->priv->extra_xml == NULL)
+		parsable->priv->extra_xml = g_string_sized_new (xmlBufferLength (buffer));
+	g_string_append_len (parsable->priv->extra_xml, (gchar*) xmlBufferContent (buffer), xmlBufferLength (buffer));
+	PARSE_STATISTICS_ADD (g_private_get (&active_statistics), unhandled_elements, 1);
+	PARSE_STATISTICS_ADD (g_private_get (&active_statistics), unhandled_bytes, xmlBufferLength (buffer));
 	g_debug ("Unhandled XML in %s: %s", G_OBJECT_TYPE_NAME (parsable), (gchar*) xmlBufferContent (buffer));
 	xmlBufferFree (buffer);
 
@@ -183,7 +293,7 @@ real_parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *node, gpointer us
 		if ((*namespace)->prefix != NULL) {
 			/* NOTE: These two g_strdup()s leak, but it's probably acceptable, given that it saves us
 			 * g_strdup()ing every other namespace we put in @extra_namespaces. */
-			g_hash_table_insert (parsable->priv->extra_namespaces,
+			g_hash_table_insert (ensure_extra_namespaces (parsable),
 			                     g_strdup ((gchar*) ((*namespace)->prefix)),
 			                     g_strdup ((gchar*) ((*namespace)->href)));
 		}
@@ -252,6 +362,7 @@ static gboolean
 real_parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GError **error)
 {
 	gchar *json, *member_name;
+	gsize length;
 	JsonGenerator *generator;
 	JsonNode *value;
 
@@ -268,14 +379,17 @@ real_parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data
 	generator = json_generator_new ();
 	json_generator_set_root (generator, value);
 
-	json = json_generator_to_data (generator, NULL);
+	json = json_generator_to_data (generator, &length);
 	g_debug ("Unhandled JSON member ‘%s’ in %s: %s", member_name, G_OBJECT_TYPE_NAME (parsable), json);
 	g_free (json);
 
+	PARSE_STATISTICS_ADD (g_private_get (&active_statistics), unhandled_elements, 1);
+	PARSE_STATISTICS_ADD (g_private_get (&active_statistics), unhandled_bytes, length);
+
 	g_object_unref (generator);
 
 	/* Save the value. Transfer ownership of the member_name and value. */
-	g_hash_table_replace (parsable->priv->extra_json, (gpointer) member_name, (gpointer) value);
+	g_hash_table_replace (ensure_extra_json (parsable), (gpointer) member_name, (gpointer) value);
 
 	return TRUE;
 }
@@ -285,6 +399,97 @@ get_content_type (void) {
 	return "application/atom+xml";
 }
 
+/* Count the construction of a parsable of type @parsable_type, and return the statistics being collected, if any. */
+static GSList *
+count_parsable_built (GType parsable_type)
+{
+	GSList *active = g_private_get (&active_statistics);
+
+	if (active != NULL) {
+		PARSE_STATISTICS_ADD (active, parsables_built, 1);
+
+		if (g_type_is_a (parsable_type, GDATA_TYPE_ENTRY) == TRUE)
+			PARSE_STATISTICS_ADD (active, entries_built, 1);
+	}
+
+	return active;
+}
+
+/**
+ * gdata_parse_statistics_start:
+ * @statistics: (out caller-allocates): a #GDataParseStatistics to collect into
+ *
+ * Zeroes @statistics and starts collecting counters into it for all XML and JSON parsing done in the calling thread, until
+ * gdata_parse_statistics_stop() is called on it. This includes the parsing of responses by #GDataService.
+ *
+ * Collection may be nested, in which case all of the active #GDataParseStatistics<!-- -->s are updated. While no collection is active, the
+ * counters cost a thread-local lookup per parsed node.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_parse_statistics_start (GDataParseStatistics *statistics)
+{
+	g_return_if_fail (statistics != NULL);
+
+	memset (statistics, 0, sizeof (*statistics));
+
+	/* Use g_private_set() so the old list, which is the tail of the new one, isn't freed */
+	g_private_set (&active_statistics, g_slist_prepend (g_private_get (&active_statistics), statistics));
+}
+
+/**
+ * gdata_parse_statistics_stop:
+ * @statistics: a #GDataParseStatistics passed to gdata_parse_statistics_start()
+ *
+ * Stops collecting counters into @statistics. This must be called from the same thread as gdata_parse_statistics_start(). The counters in
+ * @statistics are left intact.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_parse_statistics_stop (GDataParseStatistics *statistics)
+{
+	GSList *active;
+
+	g_return_if_fail (statistics != NULL);
+
+	active = g_private_get (&active_statistics);
+	g_return_if_fail (g_slist_find (active, statistics) != NULL);
+
+	/* g_slist_remove() has already freed the removed link, so don't free the old list */
+	g_private_set (&active_statistics, g_slist_remove (active, statistics));
+}
+
+/* Add @time microseconds spent dispatching progress callbacks to the statistics being collected, if any. */
+void
+_gdata_parse_statistics_add_progress_callback_time (gint64 time)
+{
+	PARSE_STATISTICS_ADD (g_private_get (&active_statistics), progress_callback_time, time);
+}
+
+/* Add the counters in @statistics, collected in another thread, to the statistics being collected in the current thread, if any. Times aren't
+ * added, since they overlap with the time measured by the current thread. */
+void
+_gdata_parse_statistics_add (const GDataParseStatistics *statistics)
+{
+	GSList *active = g_private_get (&active_statistics);
+
+	PARSE_STATISTICS_ADD (active, bytes_parsed, statistics->bytes_parsed);
+	PARSE_STATISTICS_ADD (active, elements_visited, statistics->elements_visited);
+	PARSE_STATISTICS_ADD (active, parsables_built, statistics->parsables_built);
+	PARSE_STATISTICS_ADD (active, entries_built, statistics->entries_built);
+	PARSE_STATISTICS_ADD (active, unhandled_elements, statistics->unhandled_elements);
+	PARSE_STATISTICS_ADD (active, unhandled_bytes, statistics->unhandled_bytes);
+}
+
+/* Return whether any #GDataParseStatistics are being collected in the current thread. */
+gboolean
+_gdata_parse_statistics_are_active (void)
+{
+	return (g_private_get (&active_statistics) != NULL);
+}
+
 /**
  * gdata_parsable_new_from_xml:
  * @parsable_type: the type of the class represented by the XML
@@ -324,6 +529,8 @@ _gdata_parsable_new_from_xml (GType parsable_type, const gchar *xml, gint length
 	xmlDoc *doc;
 	xmlNode *node;
 	GDataParsable *parsable;
+	GSList *active;
+	gint64 start_time = 0;
 	static gboolean libxml_initialised = FALSE;
 
 	g_return_val_if_fail (g_type_is_a (parsable_type, GDATA_TYPE_PARSABLE), NULL);
@@ -343,8 +550,21 @@ _gdata_parsable_new_from_xml (GType parsable_type, const gchar *xml, gint length
 	if (length == -1)
 		length = strlen (xml);
 
+	active = g_private_get (&active_statistics);
+	if (active != NULL) {
+		PARSE_STATISTICS_ADD (active, bytes_parsed, length);
+		start_time = g_get_monotonic_time ();
+	}
+
 	/* Parse the XML */
 	doc = xmlReadMemory (xml, length, "/dev/null", NULL, 0);
+
+	if (active != NULL) {
+		gint64 now = g_get_monotonic_time ();
+		PARSE_STATISTICS_ADD (active, tokenize_time, now - start_time);
+		start_time = now;
+	}
+
 	if (doc == NULL) {
 		xmlError *xml_error = xmlGetLastError ();
 		g_set_error (error, GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_PARSING_STRING,
@@ -369,21 +589,22 @@ _gdata_parsable_new_from_xml (GType parsable_type, const gchar *xml, gint length
 	parsable = _gdata_parsable_new_from_xml_node (parsable_type, doc, node, user_data, error);
 	xmlFreeDoc (doc);
 
+	if (active != NULL)
+		PARSE_STATISTICS_ADD (active, build_time, g_get_monotonic_time () - start_time);
+
 	return parsable;
 }
 
-GDataParsable *
-_gdata_parsable_new_from_xml_node (GType parsable_type, xmlDoc *doc, xmlNode *node, gpointer user_data, GError **error)
+static GDataParsable *
+new_from_xml_node (GType parsable_type, xmlDoc *doc, xmlNode *node, gboolean is_lite, gpointer user_data, GError **error)
 {
 	GDataParsable *parsable;
 	GDataParsableClass *klass;
-
-	g_return_val_if_fail (g_type_is_a (parsable_type, GDATA_TYPE_PARSABLE), NULL);
-	g_return_val_if_fail (doc != NULL, NULL);
-	g_return_val_if_fail (node != NULL, NULL);
-	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+	GSList *active;
 
 	parsable = g_object_new (parsable_type, "constructed-from-xml", TRUE, NULL);
+	parsable->priv->is_lite = is_lite;
+	active = count_parsable_built (parsable_type);
 
 	klass = GDATA_PARSABLE_GET_CLASS (parsable);
 	if (klass->parse_xml == NULL) {
@@ -410,6 +631,8 @@ _gdata_parsable_new_from_xml_node (GType parsable_type, xmlDoc *doc, xmlNode *no
 	/* Parse each child element */
 	node = node->children;
 	while (node != NULL) {
+		PARSE_STATISTICS_ADD (active, elements_visited, 1);
+
 		if (klass->parse_xml (parsable, doc, node, user_data, error) == FALSE) {
 			g_object_unref (parsable);
 			return NULL;
@@ -424,9 +647,48 @@ _gdata_parsable_new_from_xml_node (GType parsable_type, xmlDoc *doc, xmlNode *no
 		return NULL;
 	}
 
+	/* Any changes from here on are local ones */
+	parsable->priv->is_lite = FALSE;
+	parsable->priv->track_changes = TRUE;
+
 	return parsable;
 }
 
+GDataParsable *
+_gdata_parsable_new_from_xml_node (GType parsable_type, xmlDoc *doc, xmlNode *node, gpointer user_data, GError **error)
+{
+	g_return_val_if_fail (g_type_is_a (parsable_type, GDATA_TYPE_PARSABLE), NULL);
+	g_return_val_if_fail (doc != NULL, NULL);
+	g_return_val_if_fail (node != NULL, NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	return new_from_xml_node (parsable_type, doc, node, FALSE, user_data, error);
+}
+
+/*
+ * _gdata_parsable_new_lite_from_xml_node:
+ * @parsable_type: the type of the class represented by the XML
+ * @doc: the XML document containing @node
+ * @node: the root node of the object's XML
+ * @user_data: user data to pass to the parsing functions
+ * @error: a #GError, or %NULL
+ *
+ * Like _gdata_parsable_new_from_xml_node(), but allows the class to defer parsing of its child elements using _gdata_parsable_defer_xml().
+ * Classes which don't support lite parsing are parsed as normal.
+ *
+ * Return value: a new #GDataParsable, or %NULL; unref with g_object_unref()
+ */
+GDataParsable *
+_gdata_parsable_new_lite_from_xml_node (GType parsable_type, xmlDoc *doc, xmlNode *node, gpointer user_data, GError **error)
+{
+	g_return_val_if_fail (g_type_is_a (parsable_type, GDATA_TYPE_PARSABLE), NULL);
+	g_return_val_if_fail (doc != NULL, NULL);
+	g_return_val_if_fail (node != NULL, NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	return new_from_xml_node (parsable_type, doc, node, TRUE, user_data, error);
+}
+
 /**
  * gdata_parsable_new_from_json:
  * @parsable_type: the type of the class represented by the JSON
@@ -466,6 +728,9 @@ _gdata_parsable_new_from_json (GType parsable_type, const gchar *json, gint leng
 	JsonParser *parser;
 	JsonReader *reader;
 	GDataParsable *parsable;
+	GSList *active;
+	gint64 start_time = 0;
+	gboolean loaded;
 	GError *child_error = NULL;
 
 	g_return_val_if_fail (g_type_is_a (parsable_type, GDATA_TYPE_PARSABLE), NULL);
@@ -476,8 +741,22 @@ _gdata_parsable_new_from_json (GType parsable_type, const gchar *json, gint leng
 	if (length == -1)
 		length = strlen (json);
 
+	active = g_private_get (&active_statistics);
+	if (active != NULL) {
+		PARSE_STATISTICS_ADD (active, bytes_parsed, length);
+		start_time = g_get_monotonic_time ();
+	}
+
 	parser = json_parser_new ();
-	if (!json_parser_load_from_data (parser, json, length, &child_error)) {
+	loaded = json_parser_load_from_data (parser, json, length, &child_error);
+
+	if (active != NULL) {
+		gint64 now = g_get_monotonic_time ();
+		PARSE_STATISTICS_ADD (active, tokenize_time, now - start_time);
+		start_time = now;
+	}
+
+	if (!loaded) {
 		g_set_error (error, GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_PARSING_STRING,
 		             /* Translators: the parameter is an error message */
 		             _("Error parsing JSON: %s"), child_error->message);
@@ -493,6 +772,9 @@ _gdata_parsable_new_from_json (GType parsable_type, const gchar *json, gint leng
 	g_object_unref (reader);
 	g_object_unref (parser);
 
+	if (active != NULL)
+		PARSE_STATISTICS_ADD (active, build_time, g_get_monotonic_time () - start_time);
+
 	return parsable;
 }
 
@@ -501,6 +783,7 @@ _gdata_parsable_new_from_json_node (GType parsable_type, JsonReader *reader, gpo
 {
 	GDataParsable *parsable;
 	GDataParsableClass *klass;
+	GSList *active;
 	gint i;
 
 	g_return_val_if_fail (g_type_is_a (parsable_type, GDATA_TYPE_PARSABLE), NULL);
@@ -510,6 +793,7 @@ _gdata_parsable_new_from_json_node (GType parsable_type, JsonReader *reader, gpo
 	/* Indicator property which allows distinguishing between locally created and server based objects
 	 * as it is used for non-XML tasks, and adding another one for JSON would be a bit pointless. */
 	parsable = g_object_new (parsable_type, "constructed-from-xml", TRUE, NULL);
+	active = count_parsable_built (parsable_type);
 
 	klass = GDATA_PARSABLE_GET_CLASS (parsable);
 	g_assert (klass->parse_json != NULL);
@@ -528,6 +812,8 @@ _gdata_parsable_new_from_json_node (GType parsable_type, JsonReader *reader, gpo
 	for (i = 0; i < json_reader_count_members (reader); i++) {
 		g_return_val_if_fail (json_reader_read_element (reader, i), NULL);
 
+		PARSE_STATISTICS_ADD (active, elements_visited, 1);
+
 		if (klass->parse_json (parsable, reader, user_data, error) == FALSE) {
 			json_reader_end_element (reader);
 			g_object_unref (parsable);
@@ -544,6 +830,9 @@ _gdata_parsable_new_from_json_node (GType parsable_type, JsonReader *reader, gpo
 		return NULL;
 	}
 
+	/* Any changes from here on are local ones */
+	parsable->priv->track_changes = TRUE;
+
 	return parsable;
 }
 
@@ -633,6 +922,8 @@ _gdata_parsable_get_xml (GDataParsable *self, GString *xml_string, gboolean decl
 	g_return_if_fail (GDATA_IS_PARSABLE (self));
 	g_return_if_fail (xml_string != NULL);
 
+	_gdata_parsable_materialise (self);
+
 	klass = GDATA_PARSABLE_GET_CLASS (self);
 	g_assert (klass->element_name != NULL);
 
@@ -642,7 +933,8 @@ _gdata_parsable_get_xml (GDataParsable *self, GString *xml_string, gboolean decl
 		klass->get_namespaces (self, namespaces);
 
 		/* Remove any duplicate extra namespaces */
-		g_hash_table_foreach_remove (self->priv->extra_namespaces, (GHRFunc) filter_namespaces_cb, namespaces);
+		if (self->priv->extra_namespaces != NULL)
+			g_hash_table_foreach_remove (self->priv->extra_namespaces, (GHRFunc) filter_namespaces_cb, namespaces);
 	}
 
 	/* Build up the namespace list */
@@ -660,7 +952,8 @@ _gdata_parsable_get_xml (GDataParsable *self, GString *xml_string, gboolean decl
 		}
 	}
 
-	g_hash_table_foreach (self->priv->extra_namespaces, (GHFunc) build_namespaces_cb, xml_string);
+	if (self->priv->extra_namespaces != NULL)
+		g_hash_table_foreach (self->priv->extra_namespaces, (GHFunc) build_namespaces_cb, xml_string);
 
 	/* Add anything the class thinks is suitable */
 	if (klass->pre_get_xml != NULL)
@@ -675,8 +968,8 @@ _gdata_parsable_get_xml (GDataParsable *self, GString *xml_string, gboolean decl
 		klass->get_xml (self, xml_string);
 
 	/* Any extra XML? */
-	if (self->priv->extra_xml != NULL && self->priv->extra_xml->str != NULL)
-		g_string_append (xml_string, self->priv->extra_xml->str);
+	if (self->priv->extra_xml != NULL)
+		g_string_append_len (xml_string, self->priv->extra_xml->str, self->priv->extra_xml->len);
 
 	/* Close the element; either by self-closing the opening tag, or by writing out a closing tag */
 	if (xml_string->len == length)
@@ -754,28 +1047,1236 @@ _gdata_parsable_get_json (GDataParsable *self, JsonBuilder *builder)
 		klass->get_json (self, builder);
 
 	/* Any extra JSON which we couldn't parse before? */
-	g_hash_table_iter_init (&iter, self->priv->extra_json);
-	while (g_hash_table_iter_next (&iter, (gpointer *) &member_name, (gpointer *) &value) == TRUE) {
-		json_builder_set_member_name (builder, member_name);
-		json_builder_add_value (builder, json_node_copy (value)); /* transfers ownership */
+	if (self->priv->extra_json != NULL) {
+		g_hash_table_iter_init (&iter, self->priv->extra_json);
+		while (g_hash_table_iter_next (&iter, (gpointer *) &member_name, (gpointer *) &value) == TRUE) {
+			json_builder_set_member_name (builder, member_name);
+			json_builder_add_value (builder, json_node_copy (value)); /* transfers ownership */
+		}
 	}
 
 	json_builder_end_object (builder);
 }
 
-/*
- * _gdata_parsable_is_constructed_from_xml:
+/**
+ * gdata_parsable_get_binary:
  * @self: a #GDataParsable
+ * @error: a #GError, or %NULL
  *
- * Returns the value of #GDataParsable:constructed-from-xml.
+ * Serialises the #GDataParsable in its current state to a compact binary format, which can be turned back into an identical object with
+ * gdata_parsable_new_from_binary(). This is intended for caching large numbers of objects locally: it's much smaller than the XML or JSON
+ * representation of the object, and much faster to deserialise, as no markup has to be parsed.
  *
- * Return value: %TRUE if the #GDataParsable was constructed from XML, %FALSE otherwise
+ * The binary representation includes all the object's properties (including read-only ones), child objects, and any XML or JSON which
+ * wasn't understood when the object was parsed. It doesn't include whether the object has been modified locally since it was parsed.
  *
- * Since: 0.7.0
+ * Not all #GDataParsable subclasses support binary serialisation; if @self (or one of its child objects) doesn't, a
+ * %G_IO_ERROR_NOT_SUPPORTED error is returned. The format is versioned, but isn't guaranteed to be readable by other versions of libgdata,
+ * so it should only be used for caches which can be rebuilt from the server.
+ *
+ * Return value: (transfer full): the object's binary representation, or %NULL; unref with g_bytes_unref()
+ *
+ * Since: 0.17.9
  */
-gboolean
-_gdata_parsable_is_constructed_from_xml (GDataParsable *self)
+GBytes *
+gdata_parsable_get_binary (GDataParsable *self, GError **error)
 {
-	g_return_val_if_fail (GDATA_IS_PARSABLE (self), FALSE);
-	return self->priv->constructed_from_xml;
+	GDataBinaryWriter *writer;
+
+	g_return_val_if_fail (GDATA_IS_PARSABLE (self), NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	writer = gdata_binary_writer_new ();
+	_gdata_parsable_write_binary (self, writer);
+
+	return gdata_binary_writer_finish (writer, error);
+}
+
+/**
+ * gdata_parsable_new_from_binary:
+ * @parsable_type: the type of the class represented by the binary data
+ * @data: the binary data, as returned by gdata_parsable_get_binary()
+ * @error: a #GError, or %NULL
+ *
+ * Creates a new #GDataParsable from the binary representation returned by gdata_parsable_get_binary(). The object stored in @data must be
+ * of type @parsable_type, or one of its subtypes. The types of all the objects in @data must have been registered already; this is done
+ * automatically when constructing the corresponding service or query, or by calling the type's <function>get_type</function> function.
+ *
+ * If @data is corrupt or was written by an incompatible version of libgdata, a suitable error from #GDataParserError will be returned.
+ *
+ * Return value: a new #GDataParsable, or %NULL; unref with g_object_unref()
+ *
+ * Since: 0.17.9
+ */
+GDataParsable *
+gdata_parsable_new_from_binary (GType parsable_type, GBytes *data, GError **error)
+{
+	GDataBinaryReader *reader;
+	GDataParsable *parsable;
+
+	g_return_val_if_fail (g_type_is_a (parsable_type, GDATA_TYPE_PARSABLE), NULL);
+	g_return_val_if_fail (data != NULL, NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	reader = gdata_binary_reader_new (data);
+	parsable = _gdata_parsable_new_from_binary_reader (parsable_type, reader);
+
+	if (parsable == NULL && gdata_binary_reader_failed (reader) == FALSE) {
+		/* The root object was written as NULL, which gdata_parsable_get_binary() never does. */
+		gdata_binary_reader_set_error (reader, g_error_new (GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_EMPTY_DOCUMENT,
+		                                                    _("Error parsing binary data: %s"), _("Empty document.")));
+	}
+
+	if (gdata_binary_reader_finish (reader, error) == FALSE)
+		g_clear_object (&parsable);
+
+	return parsable;
+}
+
+/* Whether every class from @type up to (but excluding) GDataParsable has registered binary functions. Classes have to opt in, as they may
+ * have state which isn't exposed as writeable properties. */
+static gboolean
+type_supports_binary (GType type)
+{
+	for (; type != GDATA_TYPE_PARSABLE; type = g_type_parent (type)) {
+		if (g_type_get_qdata (type, binary_funcs_quark ()) == NULL)
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+static gboolean
+pspec_is_serialisable (GParamSpec *pspec)
+{
+	/* Read-only properties are handled by the per-class functions, and deprecated ones are aliases or no-ops. */
+	return ((pspec->flags & G_PARAM_READWRITE) == G_PARAM_READWRITE && (pspec->flags & G_PARAM_DEPRECATED) == 0) ? TRUE : FALSE;
+}
+
+static gint
+compare_pspecs (gconstpointer a, gconstpointer b)
+{
+	const GParamSpec *pspec_a = *((const GParamSpec**) a), *pspec_b = *((const GParamSpec**) b);
+	guint depth_a = g_type_depth (pspec_a->owner_type), depth_b = g_type_depth (pspec_b->owner_type);
+
+	if (depth_a != depth_b)
+		return (depth_a < depth_b) ? -1 : 1;
+	else if (pspec_a->param_id != pspec_b->param_id)
+		return (pspec_a->param_id < pspec_b->param_id) ? -1 : 1;
+
+	return 0;
+}
+
+/* Returns the serialisable properties of @type, in the order they were installed (parent classes first), so that setters which depend on
+ * other properties (such as GDataContactsContact:birthday-has-year) see the same state as when the object was originally built. The array is
+ * cached for the lifetime of the process. */
+static GPtrArray *
+get_binary_properties (GType type)
+{
+	GPtrArray *properties;
+
+	G_LOCK (binary_properties);
+
+	properties = g_type_get_qdata (type, binary_properties_quark ());
+
+	if (properties == NULL) {
+		GObjectClass *klass;
+		GParamSpec **pspecs;
+		guint i, n_pspecs;
+
+		klass = g_type_class_ref (type);
+		pspecs = g_object_class_list_properties (klass, &n_pspecs);
+
+		properties = g_ptr_array_sized_new (n_pspecs);
+		for (i = 0; i < n_pspecs; i++) {
+			if (pspec_is_serialisable (pspecs[i]) == TRUE)
+				g_ptr_array_add (properties, pspecs[i]);
+		}
+
+		g_ptr_array_sort (properties, compare_pspecs);
+
+		/* This is never freed, as classes of static types are never finalised. */
+		g_type_set_qdata (type, binary_properties_quark (), properties);
+
+		g_free (pspecs);
+		g_type_class_unref (klass);
+	}
+
+	G_UNLOCK (binary_properties);
+
+	return properties;
+}
+
+static void
+write_value (GDataBinaryWriter *writer, GParamSpec *pspec, const GValue *value)
+{
+	GType value_type = G_PARAM_SPEC_VALUE_TYPE (pspec);
+
+	switch (G_TYPE_FUNDAMENTAL (value_type)) {
+		case G_TYPE_BOOLEAN:
+			gdata_binary_writer_put_boolean (writer, g_value_get_boolean (value));
+			return;
+		case G_TYPE_INT:
+			gdata_binary_writer_put_int (writer, g_value_get_int (value));
+			return;
+		case G_TYPE_LONG:
+			gdata_binary_writer_put_int (writer, g_value_get_long (value));
+			return;
+		case G_TYPE_INT64:
+			gdata_binary_writer_put_int (writer, g_value_get_int64 (value));
+			return;
+		case G_TYPE_ENUM:
+			gdata_binary_writer_put_int (writer, g_value_get_enum (value));
+			return;
+		case G_TYPE_UINT:
+			gdata_binary_writer_put_uint (writer, g_value_get_uint (value));
+			return;
+		case G_TYPE_ULONG:
+			gdata_binary_writer_put_uint (writer, g_value_get_ulong (value));
+			return;
+		case G_TYPE_UINT64:
+			gdata_binary_writer_put_uint (writer, g_value_get_uint64 (value));
+			return;
+		case G_TYPE_FLAGS:
+			gdata_binary_writer_put_uint (writer, g_value_get_flags (value));
+			return;
+		case G_TYPE_FLOAT:
+			gdata_binary_writer_put_double (writer, g_value_get_float (value));
+			return;
+		case G_TYPE_DOUBLE:
+			gdata_binary_writer_put_double (writer, g_value_get_double (value));
+			return;
+		case G_TYPE_STRING:
+			gdata_binary_writer_put_string (writer, g_value_get_string (value));
+			return;
+		case G_TYPE_OBJECT:
+			if (g_type_is_a (value_type, GDATA_TYPE_PARSABLE) == TRUE) {
+				gdata_binary_writer_put_parsable (writer, g_value_get_object (value));
+				return;
+			}
+
+			break;
+		case G_TYPE_BOXED:
+			if (value_type == GDATA_TYPE_COLOR) {
+				const GDataColor *color = g_value_get_boxed (value);
+
+				gdata_binary_writer_put_uint (writer, color->red);
+				gdata_binary_writer_put_uint (writer, color->green);
+				gdata_binary_writer_put_uint (writer, color->blue);
+				return;
+			} else if (value_type == G_TYPE_DATE) {
+				/* Invalid dates are never written; see _gdata_parsable_write_binary(). */
+				gdata_binary_writer_put_uint (writer, g_date_get_julian (g_value_get_boxed (value)));
+				return;
+			}
+
+			break;
+		default:
+			break;
+	}
+
+	gdata_binary_writer_set_error (writer, g_error_new (G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+	                                                    /* Translators: the first parameter is a property name, and the second is a type name. */
+	                                                    _("Property ‘%s’ of type ‘%s’ can’t be serialized."),
+	                                                    pspec->name, g_type_name (value_type)));
+}
+
+static gboolean
+read_integer_in_range (GDataBinaryReader *reader, gint64 value, gint64 minimum, gint64 maximum)
+{
+	if (value < minimum || value > maximum) {
+		gdata_binary_reader_set_error (reader, g_error_new (GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_PARSING_STRING,
+		                                                    _("Error parsing binary data: %s"), _("Integer is out of range.")));
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/* @value must already be initialised to the type of @pspec. Strings are set as static strings pointing into the reader's data. */
+static void
+read_value (GDataBinaryReader *reader, GParamSpec *pspec, GValue *value)
+{
+	GType value_type = G_PARAM_SPEC_VALUE_TYPE (pspec);
+	gint64 int_value;
+	guint64 uint_value;
+
+	switch (G_TYPE_FUNDAMENTAL (value_type)) {
+		case G_TYPE_BOOLEAN:
+			g_value_set_boolean (value, gdata_binary_reader_get_boolean (reader));
+			break;
+		case G_TYPE_INT:
+			int_value = gdata_binary_reader_get_int (reader);
+			if (read_integer_in_range (reader, int_value, G_MININT, G_MAXINT) == TRUE)
+				g_value_set_int (value, int_value);
+			break;
+		case G_TYPE_LONG:
+			int_value = gdata_binary_reader_get_int (reader);
+			if (read_integer_in_range (reader, int_value, G_MINLONG, G_MAXLONG) == TRUE)
+				g_value_set_long (value, int_value);
+			break;
+		case G_TYPE_INT64:
+			g_value_set_int64 (value, gdata_binary_reader_get_int (reader));
+			break;
+		case G_TYPE_ENUM:
+			int_value = gdata_binary_reader_get_int (reader);
+			if (read_integer_in_range (reader, int_value, G_MININT, G_MAXINT) == TRUE)
+				g_value_set_enum (value, int_value);
+			break;
+		case G_TYPE_UINT:
+			uint_value = gdata_binary_reader_get_uint (reader);
+			if (read_integer_in_range (reader, MIN (uint_value, G_MAXINT64), 0, G_MAXUINT) == TRUE)
+				g_value_set_uint (value, uint_value);
+			break;
+		case G_TYPE_ULONG:
+			uint_value = gdata_binary_reader_get_uint (reader);
+			if (uint_value <= G_MAXULONG)
+				g_value_set_ulong (value, uint_value);
+			else
+				read_integer_in_range (reader, 1, 0, 0);
+			break;
+		case G_TYPE_UINT64:
+			g_value_set_uint64 (value, gdata_binary_reader_get_uint (reader));
+			break;
+		case G_TYPE_FLAGS:
+			uint_value = gdata_binary_reader_get_uint (reader);
+			if (read_integer_in_range (reader, MIN (uint_value, G_MAXINT64), 0, G_MAXUINT) == TRUE)
+				g_value_set_flags (value, uint_value);
+			break;
+		case G_TYPE_FLOAT:
+			g_value_set_float (value, gdata_binary_reader_get_double (reader));
+			break;
+		case G_TYPE_DOUBLE:
+			g_value_set_double (value, gdata_binary_reader_get_double (reader));
+			break;
+		case G_TYPE_STRING:
+			g_value_set_static_string (value, gdata_binary_reader_get_string (reader));
+			break;
+		case G_TYPE_OBJECT:
+			g_assert (g_type_is_a (value_type, GDATA_TYPE_PARSABLE));
+			g_value_take_object (value, gdata_binary_reader_get_parsable (reader, value_type));
+			break;
+		case G_TYPE_BOXED:
+			if (value_type == GDATA_TYPE_COLOR) {
+				GDataColor color;
+
+				uint_value = gdata_binary_reader_get_uint (reader);
+				color.red = MIN (uint_value, G_MAXUINT16);
+				uint_value = gdata_binary_reader_get_uint (reader);
+				color.green = MIN (uint_value, G_MAXUINT16);
+				uint_value = gdata_binary_reader_get_uint (reader);
+				color.blue = MIN (uint_value, G_MAXUINT16);
+
+				g_value_set_boxed (value, &color);
+			} else {
+				GDate date;
+
+				g_assert (value_type == G_TYPE_DATE);
+
+				uint_value = gdata_binary_reader_get_uint (reader);
+				if (uint_value > G_MAXUINT32 || g_date_valid_julian (uint_value) == FALSE) {
+					read_integer_in_range (reader, 1, 0, 0);
+					break;
+				}
+
+				g_date_clear (&date, 1);
+				g_date_set_julian (&date, uint_value);
+				g_value_set_boxed (value, &date);
+			}
+			break;
+		default:
+			g_assert_not_reached ();
+	}
+}
+
+/* Whether values of @pspec can be read back by read_value(). write_value() reports an error for the others. */
+static gboolean
+pspec_is_readable_from_binary (GParamSpec *pspec)
+{
+	GType value_type = G_PARAM_SPEC_VALUE_TYPE (pspec);
+
+	switch (G_TYPE_FUNDAMENTAL (value_type)) {
+		case G_TYPE_OBJECT:
+			return g_type_is_a (value_type, GDATA_TYPE_PARSABLE);
+		case G_TYPE_BOXED:
+			return (value_type == GDATA_TYPE_COLOR || value_type == G_TYPE_DATE) ? TRUE : FALSE;
+		case G_TYPE_BOOLEAN:
+		case G_TYPE_INT:
+		case G_TYPE_LONG:
+		case G_TYPE_INT64:
+		case G_TYPE_ENUM:
+		case G_TYPE_UINT:
+		case G_TYPE_ULONG:
+		case G_TYPE_UINT64:
+		case G_TYPE_FLAGS:
+		case G_TYPE_FLOAT:
+		case G_TYPE_DOUBLE:
+		case G_TYPE_STRING:
+			return TRUE;
+		default:
+			return FALSE;
+	}
+}
+
+static void
+write_extra_json (GDataBinaryWriter *writer, GHashTable *extra_json)
+{
+	GHashTableIter iter;
+	const gchar *member_name;
+	JsonNode *value;
+	JsonGenerator *generator;
+
+	gdata_binary_writer_put_uint (writer, (extra_json != NULL) ? g_hash_table_size (extra_json) : 0);
+
+	if (extra_json == NULL || g_hash_table_size (extra_json) == 0)
+		return;
+
+	generator = json_generator_new ();
+
+	g_hash_table_iter_init (&iter, extra_json);
+	while (g_hash_table_iter_next (&iter, (gpointer*) &member_name, (gpointer*) &value) == TRUE) {
+		JsonArray *array;
+		JsonNode *root;
+		gchar *json;
+
+		/* Wrap the value in an array, as older versions of json-glib can't parse documents whose root is a scalar. */
+		array = json_array_new ();
+		json_array_add_element (array, json_node_copy (value));
+		root = json_node_new (JSON_NODE_ARRAY);
+		json_node_take_array (root, array);
+
+		json_generator_set_root (generator, root);
+		json = json_generator_to_data (generator, NULL);
+
+		gdata_binary_writer_put_string (writer, member_name);
+		gdata_binary_writer_put_string (writer, json);
+
+		g_free (json);
+		json_node_free (root);
+	}
+
+	g_object_unref (generator);
+}
+
+static void
+read_extra_json (GDataBinaryReader *reader, GDataParsable *parsable)
+{
+	guint64 count;
+	JsonParser *parser = NULL;
+
+	count = gdata_binary_reader_get_uint (reader);
+
+	for (; count > 0 && gdata_binary_reader_failed (reader) == FALSE; count--) {
+		const gchar *member_name, *json;
+		JsonNode *root;
+		GError *child_error = NULL;
+
+		member_name = gdata_binary_reader_get_string (reader);
+		json = gdata_binary_reader_get_string (reader);
+
+		if (gdata_binary_reader_failed (reader) == TRUE)
+			break;
+
+		if (parser == NULL)
+			parser = json_parser_new ();
+
+		if (member_name == NULL || json == NULL || json_parser_load_from_data (parser, json, -1, &child_error) == FALSE) {
+			gdata_binary_reader_set_error (reader, g_error_new (GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_PARSING_STRING,
+			                                                    _("Error parsing JSON: %s"),
+			                                                    (child_error != NULL) ? child_error->message : _("Invalid member.")));
+			g_clear_error (&child_error);
+			break;
+		}
+
+		root = json_parser_get_root (parser);
+		if (JSON_NODE_HOLDS_ARRAY (root) == FALSE || json_array_get_length (json_node_get_array (root)) != 1) {
+			gdata_binary_reader_set_error (reader, g_error_new (GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_PARSING_STRING,
+			                                                    _("Error parsing JSON: %s"), _("Invalid member.")));
+			break;
+		}
+
+		g_hash_table_replace (ensure_extra_json (parsable), g_strdup (member_name),
+		                      json_node_copy (json_array_get_element (json_node_get_array (root), 0)));
+	}
+
+	g_clear_object (&parser);
+}
+
+static void
+write_class_binary (GDataParsable *self, GType type, GDataBinaryWriter *writer)
+{
+	BinaryFuncs *funcs;
+
+	if (type == GDATA_TYPE_PARSABLE)
+		return;
+
+	/* Parent classes first */
+	write_class_binary (self, g_type_parent (type), writer);
+
+	funcs = g_type_get_qdata (type, binary_funcs_quark ());
+	if (funcs->write_binary != NULL)
+		funcs->write_binary (self, writer);
+}
+
+static void
+read_class_binary (GDataParsable *self, GType type, GDataBinaryReader *reader)
+{
+	BinaryFuncs *funcs;
+
+	if (type == GDATA_TYPE_PARSABLE)
+		return;
+
+	read_class_binary (self, g_type_parent (type), reader);
+
+	funcs = g_type_get_qdata (type, binary_funcs_quark ());
+	if (funcs->read_binary != NULL && gdata_binary_reader_failed (reader) == FALSE)
+		funcs->read_binary (self, reader);
+}
+
+/*
+ * _gdata_parsable_write_binary:
+ * @self: a #GDataParsable
+ * @writer: a #GDataBinaryWriter
+ *
+ * Appends the binary representation of @self to @writer: its type name, followed by its writeable properties which don't have their default
+ * values, the XML or JSON which wasn't parsed, and then the data written by each class' #GDataBinaryWriteFunc, parent classes first. If @self
+ * doesn't support binary serialisation, @writer fails with %G_IO_ERROR_NOT_SUPPORTED.
+ *
+ * Since: 0.17.9
+ */
+void
+_gdata_parsable_write_binary (GDataParsable *self, GDataBinaryWriter *writer)
+{
+	GType type;
+	GPtrArray *properties;
+	GParamSpec **pspecs;
+	GValue *values;
+	guint i, n_values = 0;
+
+	g_return_if_fail (GDATA_IS_PARSABLE (self));
+	g_return_if_fail (writer != NULL);
+
+	_gdata_parsable_materialise (self);
+
+	type = G_OBJECT_TYPE (self);
+
+	if (type_supports_binary (type) == FALSE) {
+		gdata_binary_writer_set_error (writer, g_error_new (G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+		                                                    /* Translators: the parameter is a type name. */
+		                                                    _("Objects of type ‘%s’ can’t be serialized."), g_type_name (type)));
+		return;
+	}
+
+	gdata_binary_writer_put_string (writer, g_type_name (type));
+
+	/* Collect the non-default property values first, as their count has to be written before them. */
+	properties = get_binary_properties (type);
+	pspecs = g_new (GParamSpec*, properties->len);
+	values = g_new0 (GValue, properties->len);
+
+	for (i = 0; i < properties->len; i++) {
+		GParamSpec *pspec = g_ptr_array_index (properties, i);
+		GValue *value = &(values[n_values]);
+
+		g_value_init (value, G_PARAM_SPEC_VALUE_TYPE (pspec));
+		g_object_get_property (G_OBJECT (self), pspec->name, value);
+
+		if (g_param_value_defaults (pspec, value) == TRUE ||
+		    (G_VALUE_HOLDS (value, G_TYPE_DATE) == TRUE && g_date_valid (g_value_get_boxed (value)) == FALSE)) {
+			g_value_unset (value);
+			continue;
+		}
+
+		pspecs[n_values++] = pspec;
+	}
+
+	gdata_binary_writer_put_uint (writer, n_values);
+
+	for (i = 0; i < n_values; i++) {
+		gdata_binary_writer_put_string (writer, pspecs[i]->name);
+		write_value (writer, pspecs[i], &(values[i]));
+		g_value_unset (&(values[i]));
+	}
+
+	g_free (values);
+	g_free (pspecs);
+
+	/* Anything which wasn't understood when parsing, so that it survives the round trip */
+	gdata_binary_writer_put_string (writer, (self->priv->extra_xml != NULL && self->priv->extra_xml->len > 0) ? self->priv->extra_xml->str : NULL);
+	gdata_binary_writer_put_string_hash (writer, self->priv->extra_namespaces);
+	write_extra_json (writer, self->priv->extra_json);
+
+	/* State which isn't exposed as writeable properties */
+	write_class_binary (self, type, writer);
+}
+
+/*
+ * _gdata_parsable_new_from_binary_reader:
+ * @parsable_type: the type of object expected, which the stored type must be (or be a subtype of)
+ * @reader: a #GDataBinaryReader
+ *
+ * Reads an object written by _gdata_parsable_write_binary() from @reader. If the object was written as %NULL, or on error, %NULL is returned;
+ * use gdata_binary_reader_failed() to tell the two apart.
+ *
+ * Return value: (transfer full): a new #GDataParsable, or %NULL; unref with g_object_unref()
+ *
+ * Since: 0.17.9
+ */
+GDataParsable *
+_gdata_parsable_new_from_binary_reader (GType parsable_type, GDataBinaryReader *reader)
+{
+	const gchar *type_name;
+	GType type;
+	GObjectClass *klass;
+	GParameter *construct_params, *params;
+	guint n_construct_params = 0, n_params = 0, i;
+	guint64 count;
+	GDataParsable *parsable = NULL;
+
+	g_return_val_if_fail (g_type_is_a (parsable_type, GDATA_TYPE_PARSABLE), NULL);
+	g_return_val_if_fail (reader != NULL, NULL);
+
+	if (gdata_binary_reader_enter (reader) == FALSE)
+		return NULL;
+
+	type_name = gdata_binary_reader_get_string (reader);
+	if (type_name == NULL) {
+		/* NULL object, or an error */
+		gdata_binary_reader_leave (reader);
+		return NULL;
+	}
+
+	type = g_type_from_name (type_name);
+	if (type == G_TYPE_INVALID || g_type_is_a (type, parsable_type) == FALSE || G_TYPE_IS_ABSTRACT (type) == TRUE) {
+		gchar *message;
+
+		/* Translators: the parameter is a type name. */
+		message = g_strdup_printf (_("Unexpected object of type ‘%s’."), type_name);
+		gdata_binary_reader_set_error (reader, g_error_new (GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_PARSING_STRING,
+		                                                    _("Error parsing binary data: %s"), message));
+		g_free (message);
+
+		gdata_binary_reader_leave (reader);
+		return NULL;
+	}
+
+	klass = g_type_class_ref (type);
+
+	if (type_supports_binary (type) == FALSE) {
+		gdata_binary_reader_set_error (reader, g_error_new (G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+		                                                    _("Objects of type ‘%s’ can’t be serialized."), type_name));
+		g_type_class_unref (klass);
+		gdata_binary_reader_leave (reader);
+		return NULL;
+	}
+
+	/* Properties; construct properties have to be passed to g_object_newv(), and the rest are set afterwards. Each property is written at
+	 * most once, which bounds the count. */
+	count = gdata_binary_reader_get_uint (reader);
+	if (count > get_binary_properties (type)->len)
+		gdata_binary_reader_set_error (reader, g_error_new (GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_PARSING_STRING,
+		                                                    _("Error parsing binary data: %s"), _("Too many properties.")));
+
+	count = (gdata_binary_reader_failed (reader) == TRUE) ? 0 : count;
+	construct_params = g_new0 (GParameter, count);
+	params = g_new0 (GParameter, count);
+
+	for (; count > 0 && gdata_binary_reader_failed (reader) == FALSE; count--) {
+		const gchar *property_name;
+		GParamSpec *pspec;
+		GParameter *param;
+
+		property_name = gdata_binary_reader_get_string (reader);
+		pspec = (property_name != NULL) ? g_object_class_find_property (klass, property_name) : NULL;
+
+		if (gdata_binary_reader_failed (reader) == TRUE) {
+			break;
+		} else if (pspec == NULL || pspec_is_serialisable (pspec) == FALSE || pspec_is_readable_from_binary (pspec) == FALSE) {
+			gchar *message;
+
+			/* Translators: the first parameter is a property name, and the second is a type name. */
+			message = g_strdup_printf (_("Unknown property ‘%s’ of type ‘%s’."), (property_name != NULL) ? property_name : "",
+			                           type_name);
+			gdata_binary_reader_set_error (reader, g_error_new (GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_PARSING_STRING,
+			                                                    _("Error parsing binary data: %s"), message));
+			g_free (message);
+
+			break;
+		}
+
+		if ((pspec->flags & (G_PARAM_CONSTRUCT | G_PARAM_CONSTRUCT_ONLY)) != 0)
+			param = &(construct_params[n_construct_params++]);
+		else
+			param = &(params[n_params++]);
+
+		param->name = pspec->name;
+		g_value_init (&(param->value), G_PARAM_SPEC_VALUE_TYPE (pspec));
+		read_value (reader, pspec, &(param->value));
+
+		if (gdata_binary_reader_failed (reader) == FALSE && g_param_value_validate (pspec, &(param->value)) == TRUE) {
+			gchar *message;
+
+			/* Translators: the parameter is a property name. */
+			message = g_strdup_printf (_("Invalid value for property ‘%s’."), pspec->name);
+			gdata_binary_reader_set_error (reader, g_error_new (GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_PARSING_STRING,
+			                                                    _("Error parsing binary data: %s"), message));
+			g_free (message);
+		}
+	}
+
+	if (gdata_binary_reader_failed (reader) == FALSE) {
+		const gchar *extra_xml;
+
+		parsable = g_object_newv (type, n_construct_params, construct_params);
+
+		for (i = 0; i < n_params; i++)
+			g_object_set_property (G_OBJECT (parsable), params[i].name, &(params[i].value));
+
+		extra_xml = gdata_binary_reader_get_string (reader);
+		if (extra_xml != NULL && *extra_xml != '\0')
+			parsable->priv->extra_xml = g_string_new (extra_xml);
+
+		gdata_binary_reader_get_string_hash (reader, ensure_extra_namespaces (parsable));
+		if (g_hash_table_size (parsable->priv->extra_namespaces) == 0)
+			g_clear_pointer (&parsable->priv->extra_namespaces, g_hash_table_destroy);
+
+		read_extra_json (reader, parsable);
+
+		read_class_binary (parsable, type, reader);
+
+		if (gdata_binary_reader_failed (reader) == TRUE) {
+			g_clear_object (&parsable);
+		} else {
+			/* Any changes from here on are local ones */
+			parsable->priv->track_changes = TRUE;
+		}
+	}
+
+	for (i = 0; i < n_construct_params; i++)
+		g_value_unset (&(construct_params[i].value));
+	for (i = 0; i < n_params; i++)
+		g_value_unset (&(params[i].value));
+
+	g_free (construct_params);
+	g_free (params);
+	g_type_class_unref (klass);
+	gdata_binary_reader_leave (reader);
+
+	return parsable;
+}
+
+/*
+ * _gdata_parsable_is_constructed_from_xml:
+ * @self: a #GDataParsable
+ *
+ * Returns the value of #GDataParsable:constructed-from-xml.
+ *
+ * Return value: %TRUE if the #GDataParsable was constructed from XML, %FALSE otherwise
+ *
+ * Since: 0.7.0
+ */
+gboolean
+_gdata_parsable_is_constructed_from_xml (GDataParsable *self)
+{
+	g_return_val_if_fail (GDATA_IS_PARSABLE (self), FALSE);
+	return self->priv->constructed_from_xml;
+}
+
+/*
+ * _gdata_parsable_is_lite:
+ * @self: a #GDataParsable
+ *
+ * Returns whether @self is currently being parsed in lite mode, in which case its <function>parse_xml</function> function may defer child
+ * elements using _gdata_parsable_defer_xml() rather than building objects for them.
+ *
+ * Return value: %TRUE if child elements may be deferred, %FALSE otherwise
+ */
+gboolean
+_gdata_parsable_is_lite (GDataParsable *self)
+{
+	g_return_val_if_fail (GDATA_IS_PARSABLE (self), FALSE);
+	return self->priv->is_lite;
+}
+
+/*
+ * _gdata_parsable_defer_xml:
+ * @self: a #GDataParsable being parsed in lite mode
+ * @doc: the XML document containing @node
+ * @node: a child element of @self's XML
+ *
+ * Stores @node as XML, to be passed to @self's <function>parse_xml</function> function when _gdata_parsable_materialise() is next called.
+ * This is much cheaper than building objects for elements which most callers never look at, and the serialised XML is much smaller than
+ * those objects. The element must not depend on anything but its own content and the namespaces in scope.
+ */
+void
+_gdata_parsable_defer_xml (GDataParsable *self, xmlDoc *doc, xmlNode *node)
+{
+	GDataParsablePrivate *priv;
+	xmlBuffer *buffer;
+
+	g_return_if_fail (GDATA_IS_PARSABLE (self));
+	g_return_if_fail (self->priv->is_lite == TRUE);
+	g_return_if_fail (doc != NULL);
+	g_return_if_fail (node != NULL);
+
+	priv = self->priv;
+
+	/* The first deferred element determines the namespace declarations for all of them. They all come from the same parent element, so
+	 * they share the namespaces in scope. */
+	if (priv->deferred_xml == NULL) {
+		xmlNs **namespaces, **namespace;
+
+		priv->deferred_xml = g_string_new ("<deferred");
+
+		namespaces = xmlGetNsList (doc, node);
+		if (namespaces != NULL) {
+			for (namespace = namespaces; *namespace != NULL; namespace++) {
+				xmlNs **shadowing;
+
+				/* xmlGetNsList() works outwards from @node, so skip any declarations shadowed by an earlier one with the same prefix */
+				for (shadowing = namespaces; shadowing != namespace; shadowing++) {
+					if (xmlStrcmp ((*shadowing)->prefix, (*namespace)->prefix) == 0)
+						break;
+				}
+
+				if (shadowing != namespace) {
+					continue;
+				} else if ((*namespace)->prefix != NULL) {
+					g_string_append_printf (priv->deferred_xml, " xmlns:%s", (*namespace)->prefix);
+					gdata_parser_string_append_escaped (priv->deferred_xml, "='", (gchar*) (*namespace)->href, "'");
+				} else {
+					gdata_parser_string_append_escaped (priv->deferred_xml, " xmlns='", (gchar*) (*namespace)->href, "'");
+				}
+			}
+
+			xmlFree (namespaces);
+		}
+
+		g_string_append_c (priv->deferred_xml, '>');
+		g_atomic_int_set (&priv->has_deferred, TRUE);
+	}
+
+	buffer = xmlBufferCreate ();
+	xmlNodeDump (buffer, doc, node, 0, 0);
+	g_string_append_len (priv->deferred_xml, (gchar*) xmlBufferContent (buffer), xmlBufferLength (buffer));
+	xmlBufferFree (buffer);
+}
+
+/*
+ * _gdata_parsable_materialise:
+ * @self: a #GDataParsable
+ *
+ * Parses any child elements which were deferred with _gdata_parsable_defer_xml() while @self was parsed in lite mode, by passing them to
+ * @self's <function>parse_xml</function> function. This must be called by every method which accesses the data the deferred elements are
+ * parsed into; it returns immediately if nothing was deferred.
+ *
+ * The elements were part of a well-formed document, but if one of them is invalid, a warning is printed and the element is skipped, since
+ * the parsing error can't be reported to the caller at this point.
+ *
+ * This is thread safe: if several threads call accessors of @self at once, one parses the elements while the others wait for it to finish.
+ */
+void
+_gdata_parsable_materialise (GDataParsable *self)
+{
+	GDataParsableClass *klass;
+	GString *deferred_xml;
+	xmlDoc *doc;
+	xmlNode *node;
+	gboolean track_changes;
+	GError *child_error = NULL;
+
+	g_return_if_fail (GDATA_IS_PARSABLE (self));
+
+	if (g_atomic_int_get (&self->priv->has_deferred) == FALSE)
+		return;
+
+	g_rec_mutex_lock (&materialise_mutex);
+
+	/* Another thread may have materialised @self while we were waiting for the lock. Otherwise, steal the XML, so that re-entrant calls
+	 * from the parse_xml function are no-ops. */
+	deferred_xml = self->priv->deferred_xml;
+	self->priv->deferred_xml = NULL;
+
+	if (deferred_xml == NULL) {
+		g_rec_mutex_unlock (&materialise_mutex);
+		return;
+	}
+
+	g_string_append (deferred_xml, "</deferred>");
+	doc = xmlReadMemory (deferred_xml->str, deferred_xml->len, "/dev/null", NULL, 0);
+	g_string_free (deferred_xml, TRUE);
+
+	if (doc == NULL) {
+		xmlError *xml_error = xmlGetLastError ();
+		g_warning ("Error parsing deferred XML for %s: %s", G_OBJECT_TYPE_NAME (self), (xml_error != NULL) ? xml_error->message : "unknown error");
+		goto done;
+	}
+
+	klass = GDATA_PARSABLE_GET_CLASS (self);
+
+	/* The elements are part of the object as it was received from the server, so they mustn't be marked as local changes */
+	track_changes = self->priv->track_changes;
+	self->priv->track_changes = FALSE;
+
+	for (node = xmlDocGetRootElement (doc)->children; node != NULL; node = node->next) {
+		klass->parse_xml (self, doc, node, NULL, &child_error);
+
+		if (child_error != NULL) {
+			g_warning ("Error parsing deferred XML for %s: %s", G_OBJECT_TYPE_NAME (self), child_error->message);
+			g_clear_error (&child_error);
+		}
+	}
+
+	self->priv->track_changes = track_changes;
+
+	xmlFreeDoc (doc);
+
+done:
+	/* Only now can other threads skip the lock, as @self is fully materialised */
+	g_atomic_int_set (&self->priv->has_deferred, FALSE);
+	g_rec_mutex_unlock (&materialise_mutex);
+}
+
+/*
+ * _gdata_parsable_discard_deferred:
+ * @self: a #GDataParsable
+ *
+ * Frees any child elements deferred with _gdata_parsable_defer_xml() without parsing them. This should be called when disposing of @self, so
+ * that clearing its properties doesn't needlessly materialise them.
+ */
+void
+_gdata_parsable_discard_deferred (GDataParsable *self)
+{
+	g_return_if_fail (GDATA_IS_PARSABLE (self));
+
+	if (self->priv->deferred_xml != NULL) {
+		g_string_free (self->priv->deferred_xml, TRUE);
+		self->priv->deferred_xml = NULL;
+		g_atomic_int_set (&self->priv->has_deferred, FALSE);
+	}
+}
+
+/*
+ * _gdata_parsable_class_set_patch_name:
+ * @klass: a #GDataParsableClass
+ * @property_name: the name of a property of @klass, which may have been installed by a parent class
+ * @patch_name: the name of the top-level XML element or JSON member which @property_name is serialised as by @klass
+ *
+ * Overrides the element or member name which is marked as dirty when @property_name changes on instances of @klass and its subclasses. By
+ * default, the property name is converted to camel case (so "file-as" becomes "fileAs"), which is correct for most JSON members and
+ * unprefixed Atom elements. XML elements in other namespaces should be given with their prefix, such as "gContact:fileAs". Pass an empty
+ * string to exclude a property from change tracking entirely.
+ *
+ * This must be called from the class_init function of @klass, and @patch_name must be a static string.
+ *
+ * Since: 0.17.9
+ */
+void
+_gdata_parsable_class_set_patch_name (GDataParsableClass *klass, const gchar *property_name, const gchar *patch_name)
+{
+	GType type;
+	GHashTable *patch_names;
+
+	g_return_if_fail (GDATA_IS_PARSABLE_CLASS (klass));
+	g_return_if_fail (g_object_class_find_property (G_OBJECT_CLASS (klass), property_name) != NULL);
+	g_return_if_fail (patch_name != NULL);
+
+	type = G_TYPE_FROM_CLASS (klass);
+	patch_names = g_type_get_qdata (type, patch_name_quark ());
+
+	if (patch_names == NULL) {
+		/* This is never freed, as classes of static types are never finalised. */
+		patch_names = g_hash_table_new (g_str_hash, g_str_equal);
+		g_type_set_qdata (type, patch_name_quark (), patch_names);
+	}
+
+	g_hash_table_insert (patch_names, (gpointer) property_name, (gpointer) patch_name);
+}
+
+/*
+ * _gdata_parsable_class_set_binary_funcs:
+ * @klass: a #GDataParsableClass
+ * @write_binary: (allow-none): a function to write the state of @klass which isn't covered by its writeable properties, or %NULL
+ * @read_binary: (allow-none): a function to read back the state written by @write_binary, or %NULL
+ *
+ * Marks instances of @klass as supporting gdata_parsable_get_binary(). An object can only be serialised if its class and all its ancestor
+ * classes (up to #GDataParsable) have called this, as otherwise private state could be silently lost.
+ *
+ * The writeable properties of @klass are serialised automatically. @write_binary and @read_binary only need to handle read-only properties
+ * and other state, such as lists of child objects; they should be %NULL if there is none.
+ *
+ * This must be called from the class_init function of @klass.
+ *
+ * Since: 0.17.9
+ */
+void
+_gdata_parsable_class_set_binary_funcs (GDataParsableClass *klass, GDataBinaryWriteFunc write_binary, GDataBinaryReadFunc read_binary)
+{
+	BinaryFuncs *funcs;
+
+	g_return_if_fail (GDATA_IS_PARSABLE_CLASS (klass));
+	g_return_if_fail ((write_binary == NULL) == (read_binary == NULL));
+
+	/* This is never freed, as classes of static types are never finalised. */
+	funcs = g_new0 (BinaryFuncs, 1);
+	funcs->write_binary = write_binary;
+	funcs->read_binary = read_binary;
+
+	g_type_set_qdata (G_TYPE_FROM_CLASS (klass), binary_funcs_quark (), funcs);
+}
+
+/*
+ * _gdata_parsable_mark_dirty:
+ * @self: a #GDataParsable
+ * @patch_name: the name of the top-level XML element or JSON member which has changed
+ *
+ * Marks @patch_name as having been changed locally, so that it's included in the next partial update of @self. Setters of writeable
+ * properties should use _gdata_parsable_mark_property_dirty() instead; this is for changes which don't correspond to a property, such as
+ * those to multi-valued elements. It's a no-op until @self has finished being parsed.
+ *
+ * Since: 0.17.9
+ */
+void
+_gdata_parsable_mark_dirty (GDataParsable *self, const gchar *patch_name)
+{
+	g_return_if_fail (GDATA_IS_PARSABLE (self));
+	g_return_if_fail (patch_name != NULL && *patch_name != '\0');
+
+	if (self->priv->track_changes == FALSE)
+		return;
+
+	if (self->priv->dirty_names == NULL)
+		self->priv->dirty_names = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+	g_hash_table_add (self->priv->dirty_names, g_strdup (patch_name));
+}
+
+/*
+ * _gdata_parsable_mark_property_dirty:
+ * @self: a #GDataParsable
+ * @property_name: the name of a writeable property of @self which has changed
+ *
+ * Marks the element or member which @property_name is serialised as (see _gdata_parsable_class_set_patch_name()) as having been changed
+ * locally. This should be called by the setter of every writeable property which is sent to the server, next to its g_object_notify() call.
+ * It's a no-op until @self has finished being parsed, so it's cheap to call while parsing.
+ *
+ * Since: 0.17.9
+ */
+void
+_gdata_parsable_mark_property_dirty (GDataParsable *self, const gchar *property_name)
+{
+	const gchar *patch_name;
+	gchar *default_name;
+
+	g_return_if_fail (GDATA_IS_PARSABLE (self));
+	g_return_if_fail (property_name != NULL);
+
+	if (self->priv->track_changes == FALSE)
+		return;
+
+	patch_name = look_up_patch_name (self, property_name);
+
+	if (patch_name == NULL) {
+		default_name = property_name_to_patch_name (property_name);
+		_gdata_parsable_mark_dirty (self, default_name);
+		g_free (default_name);
+	} else if (*patch_name != '\0') {
+		_gdata_parsable_mark_dirty (self, patch_name);
+	}
+}
+
+/*
+ * _gdata_parsable_is_dirty:
+ * @self: a #GDataParsable
+ *
+ * Returns whether any element or member of @self has been changed locally since it was parsed (or since _gdata_parsable_clear_dirty() was
+ * last called).
+ *
+ * Return value: %TRUE if @self has local changes, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+_gdata_parsable_is_dirty (GDataParsable *self)
+{
+	g_return_val_if_fail (GDATA_IS_PARSABLE (self), FALSE);
+
+	return (self->priv->dirty_names != NULL && g_hash_table_size (self->priv->dirty_names) > 0);
+}
+
+/*
+ * _gdata_parsable_clear_dirty:
+ * @self: a #GDataParsable
+ *
+ * Forgets all local changes to @self, typically after they've been sent to the server.
+ *
+ * Since: 0.17.9
+ */
+void
+_gdata_parsable_clear_dirty (GDataParsable *self)
+{
+	g_return_if_fail (GDATA_IS_PARSABLE (self));
+
+	g_clear_pointer (&self->priv->dirty_names, g_hash_table_destroy);
+}
+
+/* Returns the dirty names in a stable order, so that the same changes always produce the same request body. Free the list (but not its
+ * elements) with g_list_free(). */
+static GList *
+get_sorted_dirty_names (GDataParsable *self)
+{
+	return g_list_sort (g_hash_table_get_keys (self->priv->dirty_names), (GCompareFunc) g_strcmp0);
+}
+
+static gboolean
+xml_node_is_dirty (xmlNode *node, GHashTable *dirty_names)
+{
+	gchar *qualified_name;
+	gboolean is_dirty;
+
+	if (node->type != XML_ELEMENT_NODE)
+		return FALSE;
+
+	/* Unprefixed names match elements in the default (Atom) namespace; prefixed names have to match the prefix too. */
+	if (node->ns == NULL || node->ns->prefix == NULL)
+		return g_hash_table_contains (dirty_names, (const gchar*) node->name);
+
+	qualified_name = g_strdup_printf ("%s:%s", (const gchar*) node->ns->prefix, (const gchar*) node->name);
+	is_dirty = g_hash_table_contains (dirty_names, qualified_name);
+	g_free (qualified_name);
+
+	return is_dirty;
+}
+
+/*
+ * _gdata_parsable_get_patch_xml:
+ * @self: a #GDataParsable
+ *
+ * Builds a partial XML representation of @self containing only the top-level elements which have changed locally, suitable for use as the
+ * body of a GData PATCH request. The root element carries a <code class="literal">gd:fields</code> attribute listing all the changed
+ * elements, so that elements which have been removed locally are also removed on the server. Unhandled XML from parsing is not included
+ * unless it has been marked as dirty.
+ *
+ * See: https://developers.google.com/gdata/docs/2.0/reference#PartialUpdate
+ *
+ * Return value: the partial XML; free with g_free()
+ *
+ * Since: 0.17.9
+ */
+gchar *
+_gdata_parsable_get_patch_xml (GDataParsable *self)
+{
+	gchar *full_xml, *patch_xml;
+	xmlDoc *doc;
+	xmlNode *root_node, *node, *next_node;
+	xmlNs *gd_namespace;
+	xmlChar *dumped_xml;
+	GString *fields;
+	GList *names, *i;
+	int dumped_length;
+
+	g_return_val_if_fail (GDATA_IS_PARSABLE (self), NULL);
+	g_return_val_if_fail (_gdata_parsable_is_dirty (self), NULL);
+
+	/* Serialise the whole object and then prune it, rather than requiring every subclass to know how to serialise individual elements.
+	 * The cost of this is only paid when actually patching. */
+	full_xml = gdata_parsable_get_xml (self);
+	doc = xmlReadMemory (full_xml, strlen (full_xml), "/dev/null", NULL, 0);
+	g_free (full_xml);
+	g_assert (doc != NULL);
+
+	root_node = xmlDocGetRootElement (doc);
+
+	for (node = root_node->children; node != NULL; node = next_node) {
+		next_node = node->next;
+
+		if (xml_node_is_dirty (node, self->priv->dirty_names) == FALSE) {
+			xmlUnlinkNode (node);
+			xmlFreeNode (node);
+		}
+	}
+
+	/* List all the dirty element names, including those which no longer have any elements */
+	fields = g_string_new (NULL);
+	names = get_sorted_dirty_names (self);
+	for (i = names; i != NULL; i = i->next) {
+		if (fields->len > 0)
+			g_string_append_c (fields, ',');
+		g_string_append (fields, i->data);
+	}
+	g_list_free (names);
+
+	gd_namespace = xmlSearchNsByHref (doc, root_node, (xmlChar*) "http://schemas.google.com/g/2005");
+	if (gd_namespace == NULL)
+		gd_namespace = xmlNewNs (root_node, (xmlChar*) "http://schemas.google.com/g/2005", (xmlChar*) "gd");
+	xmlSetNsProp (root_node, gd_namespace, (xmlChar*) "fields", (xmlChar*) fields->str);
+	g_string_free (fields, TRUE);
+
+	xmlDocDumpMemoryEnc (doc, &dumped_xml, &dumped_length, "UTF-8");
+	patch_xml = g_strndup ((gchar*) dumped_xml, dumped_length);
+	xmlFree (dumped_xml);
+	xmlFreeDoc (doc);
+
+	return patch_xml;
+}
+
+/*
+ * _gdata_parsable_get_patch_json:
+ * @self: a #GDataParsable
+ *
+ * Builds a partial JSON representation of @self containing only the members which have changed locally, suitable for use as the body of a
+ * PATCH request. Members which have been cleared locally are included with a <code class="literal">null</code> value, which removes them on
+ * the server.
+ *
+ * Return value: the partial JSON; free with g_free()
+ *
+ * Since: 0.17.9
+ */
+gchar *
+_gdata_parsable_get_patch_json (GDataParsable *self)
+{
+	JsonGenerator *generator;
+	JsonBuilder *builder;
+	JsonNode *full_root, *patch_root;
+	JsonObject *full_object, *patch_object;
+	GList *names, *i;
+	gchar *output;
+
+	g_return_val_if_fail (GDATA_IS_PARSABLE (self), NULL);
+	g_return_val_if_fail (_gdata_parsable_is_dirty (self), NULL);
+
+	/* Build the whole JSON tree and then pick out the changed members. */
+	builder = json_builder_new ();
+	_gdata_parsable_get_json (self, builder);
+	full_root = json_builder_get_root (builder);
+	g_object_unref (builder);
+
+	full_object = json_node_get_object (full_root);
+	patch_object = json_object_new ();
+
+	names = get_sorted_dirty_names (self);
+	for (i = names; i != NULL; i = i->next) {
+		const gchar *name = i->data;
+
+		if (json_object_has_member (full_object, name) == TRUE)
+			json_object_set_member (patch_object, name, json_node_copy (json_object_get_member (full_object, name)));
+		else
+			json_object_set_null_member (patch_object, name);
+	}
+	g_list_free (names);
+
+	json_node_free (full_root);
+
+	/* Serialise it to a string. */
+	patch_root = json_node_new (JSON_NODE_OBJECT);
+	json_node_take_object (patch_root, patch_object);
+
+	generator = json_generator_new ();
+	json_generator_set_root (generator, patch_root);
+	output = json_generator_to_data (generator, NULL);
+	g_object_unref (generator);
+
+	json_node_free (patch_root);
+
+	return output;
 }
@@ -42,6 +42,40 @@ typedef enum {
 #define GDATA_PARSER_ERROR gdata_parser_error_quark ()
 GQuark gdata_parser_error_quark (void) G_GNUC_CONST;
 
+/**
+ * GDataParseStatistics:
+ * @bytes_parsed: the number of bytes of XML or JSON parsed
+ * @elements_visited: the number of XML child nodes and JSON members passed to the parsing functions of #GDataParsable<!-- -->s
+ * @parsables_built: the number of #GDataParsable objects constructed, including the #GDataEntry<!-- -->s counted in @entries_built
+ * @entries_built: the number of #GDataEntry objects constructed
+ * @unhandled_elements: the number of XML elements and JSON members which weren't understood, and were preserved verbatim
+ * @unhandled_bytes: the number of bytes of serialised XML retained for the elements counted in @unhandled_elements
+ * @tokenize_time: the time spent by libxml2 or json-glib parsing the documents into trees, in microseconds
+ * @build_time: the time spent building #GDataParsable<!-- -->s from the parsed trees, in microseconds, including @progress_callback_time
+ * @progress_callback_time: the time spent dispatching #GDataQueryProgressCallback<!-- -->s while parsing feeds, in microseconds
+ *
+ * Counters describing the work done to parse XML or JSON into #GDataParsable<!-- -->s, collected between calls to
+ * gdata_parse_statistics_start() and gdata_parse_statistics_stop(), or for the response to a request by #GDataService::request-finished.
+ * All times are measured using the monotonic clock.
+ *
+ * Since: 0.17.9
+ */
+typedef struct {
+	/*< public >*/
+	guint64 bytes_parsed;
+	guint elements_visited;
+	guint parsables_built;
+	guint entries_built;
+	guint unhandled_elements;
+	guint64 unhandled_bytes;
+	gint64 tokenize_time;
+	gint64 build_time;
+	gint64 progress_callback_time;
+} GDataParseStatistics;
+
+void gdata_parse_statistics_start (GDataParseStatistics *statistics);
+void gdata_parse_statistics_stop (GDataParseStatistics *statistics);
+
 #define GDATA_TYPE_PARSABLE		(gdata_parsable_get_type ())
 #define GDATA_PARSABLE(o)		(G_TYPE_CHECK_INSTANCE_CAST ((o), GDATA_TYPE_PARSABLE, GDataParsable))
 #define GDATA_PARSABLE_CLASS(k)		(G_TYPE_CHECK_CLASS_CAST((k), GDATA_TYPE_PARSABLE, GDataParsableClass))
@@ -130,6 +164,9 @@ GDataParsable *gdata_parsable_new_from_json (GType parsable_type, const gchar *j
                                              GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
 gchar *gdata_parsable_get_json (GDataParsable *self) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
 
+GDataParsable *gdata_parsable_new_from_binary (GType parsable_type, GBytes *data, GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+GBytes *gdata_parsable_get_binary (GDataParsable *self, GError **error) G_GNUC_WARN_UNUSED_RESULT;
+
 G_END_DECLS
 
 #endif /* !GDATA_PARSABLE_H */
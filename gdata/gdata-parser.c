@@ -279,6 +279,41 @@ gdata_parser_int64_to_iso8601_numeric_timezone (gint64 _time)
 	return retval;
 }
 
+/* Appends the ISO 8601 representation of @_time to @string, in exactly the same format as gdata_parser_int64_to_iso8601() (e.g.
+ * ‘2014-08-09T21:07:05Z’), but without allocating a temporary string. The date is calculated arithmetically rather than using gmtime(),
+ * so this is also thread-safe. */
+void
+gdata_parser_string_append_iso8601 (GString *string, gint64 _time)
+{
+	gint64 days, seconds, era, doe, yoe, doy, mp, year, month, day;
+	gchar buf[64];
+	gint len;
+
+	/* Split into days since the epoch and seconds into the day, rounding towards negative infinity */
+	days = _time / 86400;
+	seconds = _time % 86400;
+	if (seconds < 0) {
+		seconds += 86400;
+		days--;
+	}
+
+	/* Convert the day count to a (proleptic Gregorian) civil date; see: http://howardhinnant.github.io/date_algorithms.html#civil_from_days */
+	days += 719468;
+	era = ((days >= 0) ? days : days - 146096) / 146097;
+	doe = days - era * 146097;
+	yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	mp = (5 * doy + 2) / 153;
+	day = doy - (153 * mp + 2) / 5 + 1;
+	month = (mp < 10) ? mp + 3 : mp - 9;
+	year = yoe + era * 400 + ((month <= 2) ? 1 : 0);
+
+	/* Note: This doesn't need translating, as it's outputting an ISO 8601 date string */
+	len = g_snprintf (buf, sizeof (buf), "%04" G_GINT64_FORMAT "-%02d-%02dT%02d:%02d:%02dZ", year, (gint) month, (gint) day,
+	                  (gint) (seconds / 3600), (gint) ((seconds / 60) % 60), (gint) (seconds % 60));
+	g_string_append_len (string, buf, MIN (len, (gint) sizeof (buf) - 1));
+}
+
 gboolean
 gdata_parser_int64_from_iso8601 (const gchar *date, gint64 *_time)
 {
@@ -52,8 +52,13 @@ typedef enum {
 G_GNUC_INTERNAL SoupSession *_gdata_service_get_session (GDataService *self) G_GNUC_PURE;
 G_GNUC_INTERNAL SoupMessage *_gdata_service_build_message (GDataService *self, GDataAuthorizationDomain *domain, const gchar *method, const gchar *uri,
                                                            const gchar *etag, gboolean etag_if_match);
+G_GNUC_INTERNAL SoupMessage *_gdata_service_build_message_from_soup_uri (GDataService *self, GDataAuthorizationDomain *domain, const gchar *method,
+                                                                         SoupURI *uri, const gchar *etag, gboolean etag_if_match);
 G_GNUC_INTERNAL void _gdata_service_actually_send_message (SoupSession *session, SoupMessage *message, GCancellable *cancellable, GError **error);
 G_GNUC_INTERNAL guint _gdata_service_send_message (GDataService *self, SoupMessage *message, GCancellable *cancellable, GError **error);
+G_GNUC_INTERNAL void _gdata_service_set_message_operation_type (SoupMessage *message, GDataOperationType operation_type);
+G_GNUC_INTERNAL gint64 _gdata_service_begin_parse (SoupMessage *message);
+G_GNUC_INTERNAL void _gdata_service_end_parse (SoupMessage *message, gint64 parse_start_time);
 G_GNUC_INTERNAL SoupMessage *_gdata_service_query (GDataService *self, GDataAuthorizationDomain *domain, const gchar *feed_uri, GDataQuery *query,
                                                    GCancellable *cancellable, GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
 G_GNUC_INTERNAL const gchar *_gdata_service_get_scheme (void) G_GNUC_CONST;
@@ -63,6 +68,10 @@ G_GNUC_INTERNAL gchar *_gdata_service_fix_uri_scheme (const gchar *uri) G_GNUC_W
 G_GNUC_INTERNAL GDataLogLevel _gdata_service_get_log_level (void) G_GNUC_CONST;
 G_GNUC_INTERNAL SoupSession *_gdata_service_build_session (void) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
 
+typedef struct _GDataPrefetch GDataPrefetch;
+G_GNUC_INTERNAL gboolean _gdata_prefetch_matches (GDataPrefetch *self, GDataService *service, GDataAuthorizationDomain *domain, const gchar *uri);
+G_GNUC_INTERNAL void _gdata_prefetch_cancel_and_unref (GDataPrefetch *self);
+
 typedef gchar *GDataSecureString;
 typedef const gchar *GDataConstSecureString;
 
@@ -86,6 +95,20 @@ G_GNUC_INTERNAL void _gdata_query_set_next_page_token (GDataQuery  *self, const
 G_GNUC_INTERNAL void _gdata_query_set_next_uri (GDataQuery *self, const gchar *next_uri);
 G_GNUC_INTERNAL gboolean _gdata_query_is_finished (GDataQuery *self);
 G_GNUC_INTERNAL void _gdata_query_set_previous_uri (GDataQuery *self, const gchar *previous_uri);
+G_GNUC_INTERNAL void _gdata_query_append_fields (GDataQuery *self, GString *query_uri, gboolean *params_started);
+G_GNUC_INTERNAL GDataQueryBatchProgressCallback _gdata_query_get_batch_progress_callback (GDataQuery *self, gpointer *user_data);
+G_GNUC_INTERNAL const gchar *_gdata_query_build_uri (GDataQuery *self, const gchar *feed_uri);
+G_GNUC_INTERNAL SoupURI *_gdata_query_get_soup_uri (GDataQuery *self, const gchar *feed_uri);
+G_GNUC_INTERNAL void _gdata_query_mark_uri_volatile (GDataQuery *self);
+G_GNUC_INTERNAL void _gdata_query_invalidate_uri (GDataQuery *self);
+G_GNUC_INTERNAL gchar *_gdata_query_build_next_page_uri (GDataQuery *self, const gchar *feed_uri, GDataFeed *feed,
+                                                        guint pages_ahead) G_GNUC_WARN_UNUSED_RESULT;
+G_GNUC_INTERNAL void _gdata_query_add_prefetch (GDataQuery *self, GDataPrefetch *prefetch);
+G_GNUC_INTERNAL GDataPrefetch *_gdata_query_steal_prefetch (GDataQuery *self, GDataService *service, GDataAuthorizationDomain *domain,
+                                                            const gchar *uri) G_GNUC_WARN_UNUSED_RESULT;
+G_GNUC_INTERNAL gboolean _gdata_query_has_prefetch (GDataQuery *self, GDataService *service, GDataAuthorizationDomain *domain, const gchar *uri);
+G_GNUC_INTERNAL void _gdata_query_retain_prefetches (GDataQuery *self, GDataService *service, GDataAuthorizationDomain *domain,
+                                                     gchar **uris, guint n_uris);
 
 #include "gdata-parsable.h"
 G_GNUC_INTERNAL GDataParsable *_gdata_parsable_new_from_xml (GType parsable_type, const gchar *xml, gint length, gpointer user_data,
@@ -100,23 +123,49 @@ G_GNUC_INTERNAL void _gdata_parsable_get_xml (GDataParsable *self, GString *xml_
 G_GNUC_INTERNAL void _gdata_parsable_get_json (GDataParsable *self, JsonBuilder *builder);
 G_GNUC_INTERNAL void _gdata_parsable_string_append_escaped (GString *xml_string, const gchar *pre, const gchar *element_content, const gchar *post);
 G_GNUC_INTERNAL gboolean _gdata_parsable_is_constructed_from_xml (GDataParsable *self);
+G_GNUC_INTERNAL GDataParsable *_gdata_parsable_new_lite_from_xml_node (GType parsable_type, xmlDoc *doc, xmlNode *node, gpointer user_data,
+                                                                       GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+G_GNUC_INTERNAL gboolean _gdata_parsable_is_lite (GDataParsable *self);
+G_GNUC_INTERNAL void _gdata_parsable_defer_xml (GDataParsable *self, xmlDoc *doc, xmlNode *node);
+G_GNUC_INTERNAL void _gdata_parsable_materialise (GDataParsable *self);
+G_GNUC_INTERNAL void _gdata_parsable_discard_deferred (GDataParsable *self);
+G_GNUC_INTERNAL void _gdata_parsable_class_set_patch_name (GDataParsableClass *klass, const gchar *property_name, const gchar *patch_name);
+G_GNUC_INTERNAL void _gdata_parsable_mark_dirty (GDataParsable *self, const gchar *patch_name);
+G_GNUC_INTERNAL void _gdata_parsable_mark_property_dirty (GDataParsable *self, const gchar *property_name);
+G_GNUC_INTERNAL gboolean _gdata_parsable_is_dirty (GDataParsable *self);
+G_GNUC_INTERNAL void _gdata_parsable_clear_dirty (GDataParsable *self);
+G_GNUC_INTERNAL gchar *_gdata_parsable_get_patch_xml (GDataParsable *self) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+G_GNUC_INTERNAL gchar *_gdata_parsable_get_patch_json (GDataParsable *self) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+
+#include "gdata-binary.h"
+G_GNUC_INTERNAL void _gdata_parsable_class_set_binary_funcs (GDataParsableClass *klass, GDataBinaryWriteFunc write_binary,
+                                                             GDataBinaryReadFunc read_binary);
+G_GNUC_INTERNAL void _gdata_parsable_write_binary (GDataParsable *self, GDataBinaryWriter *writer);
+G_GNUC_INTERNAL GDataParsable *_gdata_parsable_new_from_binary_reader (GType parsable_type,
+                                                                       GDataBinaryReader *reader) G_GNUC_WARN_UNUSED_RESULT;
+G_GNUC_INTERNAL void _gdata_parse_statistics_add_progress_callback_time (gint64 time);
+G_GNUC_INTERNAL void _gdata_parse_statistics_add (const GDataParseStatistics *statistics);
+G_GNUC_INTERNAL gboolean _gdata_parse_statistics_are_active (void);
 
 #include "gdata-feed.h"
 G_GNUC_INTERNAL GDataFeed *_gdata_feed_new (GType feed_type,
                                             const gchar *title,
                                             const gchar *id,
                                             gint64 updated) G_GNUC_WARN_UNUSED_RESULT;
-G_GNUC_INTERNAL GDataFeed *_gdata_feed_new_from_xml (GType feed_type, const gchar *xml, gint length, GType entry_type,
+G_GNUC_INTERNAL GDataFeed *_gdata_feed_new_from_xml (GType feed_type, const gchar *xml, gint length, GType entry_type, GDataQuery *query,
                                                      GDataQueryProgressCallback progress_callback, gpointer progress_user_data,
                                                      GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
-G_GNUC_INTERNAL GDataFeed *_gdata_feed_new_from_json (GType feed_type, const gchar *json, gint length, GType entry_type,
+G_GNUC_INTERNAL GDataFeed *_gdata_feed_new_from_json (GType feed_type, const gchar *json, gint length, GType entry_type, GDataQuery *query,
                                                      GDataQueryProgressCallback progress_callback, gpointer progress_user_data,
                                                      GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
 G_GNUC_INTERNAL void _gdata_feed_add_entry (GDataFeed *self, GDataEntry *entry);
 G_GNUC_INTERNAL void _gdata_feed_add_link (GDataFeed *self, GDataLink *_link);
-G_GNUC_INTERNAL gpointer _gdata_feed_parse_data_new (GType entry_type, GDataQueryProgressCallback progress_callback, gpointer progress_user_data);
+G_GNUC_INTERNAL gpointer _gdata_feed_parse_data_new (GType entry_type, GDataQuery *query, GDataQueryProgressCallback progress_callback,
+                                                     gpointer progress_user_data);
 G_GNUC_INTERNAL void _gdata_feed_parse_data_free (gpointer data);
 G_GNUC_INTERNAL void _gdata_feed_call_progress_callback (GDataFeed *self, gpointer user_data, GDataEntry *entry);
+G_GNUC_INTERNAL const gchar *_gdata_feed_get_next_sync_token (GDataFeed *self) G_GNUC_PURE;
+G_GNUC_INTERNAL void _gdata_feed_set_next_sync_token (GDataFeed *self, const gchar *next_sync_token);
 G_GNUC_INTERNAL void
 _gdata_feed_set_page_info (GDataFeed *self, guint total_results,
                            guint items_per_page);
@@ -129,9 +178,46 @@ G_GNUC_INTERNAL void _gdata_entry_set_id (GDataEntry *self, const gchar *id);
 G_GNUC_INTERNAL void _gdata_entry_set_etag (GDataEntry *self, const gchar *etag);
 G_GNUC_INTERNAL void _gdata_entry_set_batch_data (GDataEntry *self, guint id, GDataBatchOperationType type);
 
+#include "gdata-sync-session.h"
+typedef gboolean (*GDataSyncSessionIsDeletedFunc) (GDataEntry *entry);
+G_GNUC_INTERNAL GDataSyncSession *_gdata_sync_session_new (GDataService *service, GDataAuthorizationDomain *domain, const gchar *feed_uri,
+                                                           GDataQuery *query, GType entry_type, const gchar *sync_token_parameter,
+                                                           GDataSyncSessionIsDeletedFunc is_deleted) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+
 #include "gdata-access-rule.h"
 G_GNUC_INTERNAL void _gdata_access_rule_set_key (GDataAccessRule *self, const gchar *key);
 
+#include "gdata-comparable.h"
+
+/*
+ * GDataComparableList:
+ * @list: (element-type GDataComparable): the elements, in order, each holding a reference
+ * @last: the last link in @list, so that appends are constant time
+ * @length: the number of elements in @list
+ * @index: (allow-none): a set of the elements, hashed with gdata_comparable_hash() and mapping to their links in @list, or %NULL if the list
+ * is too short to be worth indexing
+ *
+ * An ordered list of #GDataComparable<!-- -->s without duplicates, for use as the storage for a multi-valued property. @list may be returned to
+ * callers directly, but must only be modified using the functions below. Zero-initialisation gives an empty list.
+ *
+ * While @index exists, the list watches its elements for #GObject::notify and drops @index when any of them change, since they may be modified
+ * through their setters by callers holding them. The list must therefore not move in memory while it's indexed.
+ */
+typedef struct {
+	GList *list;
+	GList *last;
+	guint length;
+	GHashTable *index;
+} GDataComparableList;
+
+G_GNUC_INTERNAL guint _gdata_comparable_hash_string (guint hash, const gchar *str) G_GNUC_PURE;
+G_GNUC_INTERNAL GList *_gdata_comparable_list_find (GDataComparableList *self, GDataComparable *item);
+G_GNUC_INTERNAL gboolean _gdata_comparable_list_add (GDataComparableList *self, GDataComparable *item, gboolean prepend);
+G_GNUC_INTERNAL void _gdata_comparable_list_delete_link (GDataComparableList *self, GList *link);
+G_GNUC_INTERNAL void _gdata_comparable_list_reverse (GDataComparableList *self);
+G_GNUC_INTERNAL void _gdata_comparable_list_set (GDataComparableList *self, GList *list);
+G_GNUC_INTERNAL void _gdata_comparable_list_clear (GDataComparableList *self);
+
 #include "gdata-parser.h"
 
 /**
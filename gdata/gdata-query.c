@@ -52,6 +52,7 @@
 static void gdata_query_finalize (GObject *object);
 static void gdata_query_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 static void gdata_query_set_property (GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+static void gdata_query_notify (GObject *object, GParamSpec *pspec);
 static void get_query_uri (GDataQuery *self, const gchar *feed_uri, GString *query_uri, gboolean *params_started);
 
 struct _GDataQueryPrivate {
@@ -101,6 +102,32 @@ struct _GDataQueryPrivate {
 	gboolean use_previous_page;
 
 	gchar *etag;
+	gchar *fields;
+	gboolean is_lite;
+
+	/* Progress callback dispatch */
+	guint progress_batch_size;
+	guint progress_latency;
+	gboolean progress_in_thread;
+	GDataQueryBatchProgressCallback batch_progress_callback;
+	gpointer batch_progress_user_data;
+	GDestroyNotify batch_progress_destroy_notify;
+
+	/* Query URI cache. uri_generation is bumped whenever anything which could affect the built URI changes; if it still matches
+	 * cached_uri_generation (and the feed URI is the same), cached_uri can be returned as-is. cached_uri is reused as the build buffer
+	 * so that rebuilding doesn't allocate once it has grown large enough. uri_is_volatile is set by subclasses whose URIs depend on the
+	 * current time, and disables the cache for the build in progress. */
+	guint uri_generation;
+	guint cached_uri_generation;
+	gchar *cached_feed_uri;
+	GString *cached_uri;
+	SoupURI *cached_soup_uri;
+	gboolean uri_is_volatile;
+
+	/* Read-ahead of following pages; see _gdata_service_prefetch_pages() */
+	guint prefetch_depth;
+	GMutex prefetch_mutex; /* protects prefetches */
+	GPtrArray/*<owned GDataPrefetch*>*/ *prefetches;
 };
 
 enum {
@@ -114,7 +141,13 @@ enum {
 	PROP_START_INDEX,
 	PROP_IS_STRICT,
 	PROP_MAX_RESULTS,
-	PROP_ETAG
+	PROP_ETAG,
+	PROP_FIELDS,
+	PROP_IS_LITE,
+	PROP_PROGRESS_BATCH_SIZE,
+	PROP_PROGRESS_LATENCY,
+	PROP_PROGRESS_IN_THREAD,
+	PROP_PREFETCH_DEPTH
 };
 
 G_DEFINE_TYPE (GDataQuery, gdata_query, G_TYPE_OBJECT)
@@ -128,6 +161,7 @@ gdata_query_class_init (GDataQueryClass *klass)
 
 	gobject_class->set_property = gdata_query_set_property;
 	gobject_class->get_property = gdata_query_get_property;
+	gobject_class->notify = gdata_query_notify;
 	gobject_class->finalize = gdata_query_finalize;
 
 	klass->get_query_uri = get_query_uri;
@@ -300,6 +334,124 @@ gdata_query_class_init (GDataQueryClass *klass)
 	                                                      "ETag", "An ETag against which to check.",
 	                                                      NULL,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataQuery:fields:
+	 *
+	 * A partial-response field selector, limiting the elements (or JSON members) the server returns for each entry in the feed. The syntax
+	 * is the server's own; for example, <userinput>entry(@gd:etag,id,updated)</userinput> for Atom-based services, or
+	 * <userinput>nextPageToken,items(id,etag)</userinput> for JSON-based services.
+	 *
+	 * Entries returned by a query with this property set will be sparse: any properties which weren't requested will have their default
+	 * values. Such entries should not be passed back to gdata_service_update_entry(), as that would erase the missing fields on the server.
+	 *
+	 * The service-specific helpers gdata_contacts_query_set_field_mask(), gdata_documents_query_set_field_mask() and
+	 * gdata_youtube_query_set_field_mask() build a suitable selector from a #GDataQueryFields mask.
+	 *
+	 * For more information, see the <ulink type="http" url="https://developers.google.com/gdata/docs/2.0/reference#PartialResponse">
+	 * online documentation</ulink>.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_FIELDS,
+	                                 g_param_spec_string ("fields",
+	                                                      "Fields", "A partial-response field selector.",
+	                                                      NULL,
+	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataQuery:is-lite:
+	 *
+	 * Whether to parse the entries returned by the query in lite mode. In lite mode, entry classes which support it keep their
+	 * multi-valued child elements (such as a #GDataContactsContact's e-mail addresses and phone numbers) as XML, and only build objects
+	 * for them when they're first accessed. This makes queries much cheaper for callers which only look at a few properties of each
+	 * entry, such as when synchronising large address books.
+	 *
+	 * Lite mode doesn't affect the query URI or the data returned by the server, so entries parsed in lite mode behave identically to
+	 * normal ones. However, if a deferred child element turns out to be invalid when it's parsed, a warning is printed rather than an error
+	 * being returned from the query. The deferred elements are parsed under a lock, so entries parsed in lite mode can safely be read from
+	 * several threads at once, as normal ones can. Lite mode has no effect on JSON-based services.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_IS_LITE,
+	                                 g_param_spec_boolean ("is-lite",
+	                                                       "Lite?", "Whether to parse the returned entries in lite mode.",
+	                                                       FALSE,
+	                                                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataQuery:progress-batch-size:
+	 *
+	 * The maximum number of entries to report in each dispatch of the progress callbacks for the query: the #GDataQueryProgressCallback
+	 * passed to the query function, and the #GDataQueryBatchProgressCallback set with gdata_query_set_batch_progress_callback().
+	 *
+	 * Rather than dispatching the callbacks once per entry, entries are collected into batches which are dispatched together, which
+	 * greatly reduces the load on the main loop when parsing large feeds. A batch is dispatched when it reaches this size, when the first
+	 * entry in it has been waiting for #GDataQuery:progress-latency, or when the whole feed has been parsed.
+	 *
+	 * Setting this to <code class="literal">1</code> dispatches the callbacks once per entry.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_PROGRESS_BATCH_SIZE,
+	                                 g_param_spec_uint ("progress-batch-size",
+	                                                    "Progress batch size", "The maximum number of entries per progress callback dispatch.",
+	                                                    1, G_MAXUINT, GDATA_QUERY_DEFAULT_PROGRESS_BATCH_SIZE,
+	                                                    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataQuery:progress-latency:
+	 *
+	 * The maximum time, in milliseconds, for which a parsed entry may be held back in a batch before the progress callbacks are dispatched
+	 * for it. See #GDataQuery:progress-batch-size.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_PROGRESS_LATENCY,
+	                                 g_param_spec_uint ("progress-latency",
+	                                                    "Progress latency", "The maximum time an entry is held back before reporting it.",
+	                                                    0, G_MAXUINT, GDATA_QUERY_DEFAULT_PROGRESS_LATENCY,
+	                                                    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataQuery:progress-in-thread:
+	 *
+	 * Whether to call the progress callbacks for the query directly in the thread which parses the feed, rather than dispatching them to
+	 * the main thread. The parsing thread is the calling thread for synchronous queries, and a worker thread for asynchronous ones.
+	 *
+	 * This avoids the main loop entirely, so is suitable for consumers which don't have a UI and can handle the entries in any thread. The
+	 * callbacks are still called in order, and all of them are called before the query returns.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_PROGRESS_IN_THREAD,
+	                                 g_param_spec_boolean ("progress-in-thread",
+	                                                       "Progress in thread?", "Whether to call progress callbacks in the parsing thread.",
+	                                                       FALSE,
+	                                                       G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataQuery:prefetch-depth:
+	 *
+	 * The number of following pages of results to fetch in the background once a page has been queried, so that they're ready by the
+	 * time gdata_query_next_page() is called and the next query is made. Set this to <code class="literal">0</code> to disable read-ahead.
+	 *
+	 * Only the network request is made in the background: the response is parsed (and progress callbacks called) by the query which uses
+	 * it, as normal. Where the service paginates using URIs or tokens returned in each page, the following page can only be known once the
+	 * current one has been parsed, so at most one page is read ahead, whatever this is set to. Otherwise, at most 16 pages are read ahead,
+	 * stopping at the last page: one with fewer than #GDataQuery:max-results entries, or which reaches #GDataFeed:total-results.
+	 *
+	 * Any pages which have been read ahead are discarded if a property affecting the query URI is changed, or if the query moves to a
+	 * different page than the one read ahead.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_PREFETCH_DEPTH,
+	                                 g_param_spec_uint ("prefetch-depth",
+	                                                    "Prefetch depth", "The number of following pages to fetch in the background.",
+	                                                    0, G_MAXUINT, 0,
+	                                                    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -310,6 +462,9 @@ gdata_query_init (GDataQuery *self)
 	self->priv->updated_max = -1;
 	self->priv->published_min = -1;
 	self->priv->published_max = -1;
+	self->priv->progress_batch_size = GDATA_QUERY_DEFAULT_PROGRESS_BATCH_SIZE;
+	self->priv->progress_latency = GDATA_QUERY_DEFAULT_PROGRESS_LATENCY;
+	g_mutex_init (&self->priv->prefetch_mutex);
 
 	_gdata_query_set_pagination_type (self, GDATA_QUERY_PAGINATION_INDEXED);
 }
@@ -326,12 +481,62 @@ gdata_query_finalize (GObject *object)
 	g_free (priv->next_uri);
 	g_free (priv->previous_uri);
 	g_free (priv->etag);
+	g_free (priv->fields);
 	g_free (priv->next_page_token);
+	g_free (priv->cached_feed_uri);
+
+	if (priv->cached_uri != NULL)
+		g_string_free (priv->cached_uri, TRUE);
+	if (priv->cached_soup_uri != NULL)
+		soup_uri_free (priv->cached_soup_uri);
+
+	if (priv->prefetches != NULL)
+		g_ptr_array_unref (priv->prefetches);
+	g_mutex_clear (&priv->prefetch_mutex);
+
+	if (priv->batch_progress_destroy_notify != NULL)
+		priv->batch_progress_destroy_notify (priv->batch_progress_user_data);
 
 	/* Chain up to the parent class */
 	G_OBJECT_CLASS (gdata_query_parent_class)->finalize (object);
 }
 
+static void
+invalidate_query_uri (GDataQuery *self)
+{
+	self->priv->uri_generation++;
+}
+
+static void
+cancel_prefetches (GDataQuery *self)
+{
+	g_mutex_lock (&self->priv->prefetch_mutex);
+	if (self->priv->prefetches != NULL)
+		g_ptr_array_set_size (self->priv->prefetches, 0);
+	g_mutex_unlock (&self->priv->prefetch_mutex);
+}
+
+static void
+gdata_query_notify (GObject *object, GParamSpec *pspec)
+{
+	/* Every property which feeds into the query URI notifies when it changes (including those of subclasses), so we can use
+	 * notifications to invalidate the URI cache. The few properties of ours which don't affect the URI are skipped, so that
+	 * (for example) the service setting the ETag after a query doesn't throw the cache away. */
+	if (pspec->owner_type != GDATA_TYPE_QUERY ||
+	    (strcmp (pspec->name, "etag") != 0 && strcmp (pspec->name, "is-lite") != 0 &&
+	     strcmp (pspec->name, "progress-batch-size") != 0 && strcmp (pspec->name, "progress-latency") != 0 &&
+	     strcmp (pspec->name, "progress-in-thread") != 0 && strcmp (pspec->name, "prefetch-depth") != 0)) {
+		invalidate_query_uri (GDATA_QUERY (object));
+
+		/* Any pages read ahead are for the old query */
+		cancel_prefetches (GDATA_QUERY (object));
+	}
+
+	/* Chain up to the parent class */
+	if (G_OBJECT_CLASS (gdata_query_parent_class)->notify != NULL)
+		G_OBJECT_CLASS (gdata_query_parent_class)->notify (object, pspec);
+}
+
 static void
 gdata_query_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
 {
@@ -371,6 +576,24 @@ gdata_query_get_property (GObject *object, guint property_id, GValue *value, GPa
 		case PROP_ETAG:
 			g_value_set_string (value, priv->etag);
 			break;
+		case PROP_FIELDS:
+			g_value_set_string (value, priv->fields);
+			break;
+		case PROP_IS_LITE:
+			g_value_set_boolean (value, priv->is_lite);
+			break;
+		case PROP_PROGRESS_BATCH_SIZE:
+			g_value_set_uint (value, priv->progress_batch_size);
+			break;
+		case PROP_PROGRESS_LATENCY:
+			g_value_set_uint (value, priv->progress_latency);
+			break;
+		case PROP_PROGRESS_IN_THREAD:
+			g_value_set_boolean (value, priv->progress_in_thread);
+			break;
+		case PROP_PREFETCH_DEPTH:
+			g_value_set_uint (value, priv->prefetch_depth);
+			break;
 		default:
 			/* We don't have any other property... */
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -417,6 +640,24 @@ gdata_query_set_property (GObject *object, guint property_id, const GValue *valu
 		case PROP_ETAG:
 			gdata_query_set_etag (self, g_value_get_string (value));
 			break;
+		case PROP_FIELDS:
+			gdata_query_set_fields (self, g_value_get_string (value));
+			break;
+		case PROP_IS_LITE:
+			gdata_query_set_is_lite (self, g_value_get_boolean (value));
+			break;
+		case PROP_PROGRESS_BATCH_SIZE:
+			gdata_query_set_progress_batch_size (self, g_value_get_uint (value));
+			break;
+		case PROP_PROGRESS_LATENCY:
+			gdata_query_set_progress_latency (self, g_value_get_uint (value));
+			break;
+		case PROP_PROGRESS_IN_THREAD:
+			gdata_query_set_progress_in_thread (self, g_value_get_boolean (value));
+			break;
+		case PROP_PREFETCH_DEPTH:
+			gdata_query_set_prefetch_depth (self, g_value_get_uint (value));
+			break;
 		default:
 			/* We don't have any other property... */
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -458,43 +699,27 @@ get_query_uri (GDataQuery *self, const gchar *feed_uri, GString *query_uri, gboo
 	}
 
 	if (priv->updated_min != -1) {
-		gchar *updated_min;
-
 		APPEND_SEP
 		g_string_append (query_uri, "updated-min=");
-		updated_min = gdata_parser_int64_to_iso8601 (priv->updated_min);
-		g_string_append (query_uri, updated_min);
-		g_free (updated_min);
+		gdata_parser_string_append_iso8601 (query_uri, priv->updated_min);
 	}
 
 	if (priv->updated_max != -1) {
-		gchar *updated_max;
-
 		APPEND_SEP
 		g_string_append (query_uri, "updated-max=");
-		updated_max = gdata_parser_int64_to_iso8601 (priv->updated_max);
-		g_string_append (query_uri, updated_max);
-		g_free (updated_max);
+		gdata_parser_string_append_iso8601 (query_uri, priv->updated_max);
 	}
 
 	if (priv->published_min != -1) {
-		gchar *published_min;
-
 		APPEND_SEP
 		g_string_append (query_uri, "published-min=");
-		published_min = gdata_parser_int64_to_iso8601 (priv->published_min);
-		g_string_append (query_uri, published_min);
-		g_free (published_min);
+		gdata_parser_string_append_iso8601 (query_uri, priv->published_min);
 	}
 
 	if (priv->published_max != -1) {
-		gchar *published_max;
-
 		APPEND_SEP
 		g_string_append (query_uri, "published-max=");
-		published_max = gdata_parser_int64_to_iso8601 (priv->published_max);
-		g_string_append (query_uri, published_max);
-		g_free (published_max);
+		gdata_parser_string_append_iso8601 (query_uri, priv->published_max);
 	}
 
 	if (priv->start_index > 0) {
@@ -518,6 +743,8 @@ get_query_uri (GDataQuery *self, const gchar *feed_uri, GString *query_uri, gboo
 		g_string_append (query_uri, "pageToken=");
 		g_string_append_uri_escaped (query_uri, priv->next_page_token, NULL, FALSE);
 	}
+
+	_gdata_query_append_fields (self, query_uri, params_started);
 }
 
 /**
@@ -570,19 +797,41 @@ gdata_query_new_with_limits (const gchar *q, guint start_index, guint max_result
 gchar *
 gdata_query_get_query_uri (GDataQuery *self, const gchar *feed_uri)
 {
+	g_return_val_if_fail (GDATA_IS_QUERY (self), NULL);
+	g_return_val_if_fail (feed_uri != NULL, NULL);
+
+	return g_strdup (_gdata_query_build_uri (self, feed_uri));
+}
+
+/* Builds the query URI for @feed_uri into the query's cached buffer and returns it. The returned string is owned by the query, and is only
+ * valid until the query is next modified or another URI is built from it. If nothing affecting the URI has changed since the last build
+ * for the same @feed_uri, the cached URI is returned without being rebuilt. Returns %NULL if paginating by URIs and there is no further
+ * page. */
+const gchar *
+_gdata_query_build_uri (GDataQuery *self, const gchar *feed_uri)
+{
+	GDataQueryPrivate *priv;
 	GDataQueryClass *klass;
-	GString *query_uri;
 	gboolean params_started;
+	guint generation;
 
 	g_return_val_if_fail (GDATA_IS_QUERY (self), NULL);
 	g_return_val_if_fail (feed_uri != NULL, NULL);
 
+	priv = self->priv;
+
 	/* Check to see if we're paginating first */
-	if (self->priv->pagination_type == GDATA_QUERY_PAGINATION_URIS) {
-		if (self->priv->use_next_page)
-			return g_strdup (self->priv->next_uri);
-		if (self->priv->use_previous_page)
-			return g_strdup (self->priv->previous_uri);
+	if (priv->pagination_type == GDATA_QUERY_PAGINATION_URIS) {
+		if (priv->use_next_page)
+			return priv->next_uri;
+		if (priv->use_previous_page)
+			return priv->previous_uri;
+	}
+
+	/* Can we use the cached URI? */
+	if (priv->cached_uri != NULL && priv->uri_is_volatile == FALSE && priv->cached_uri_generation == priv->uri_generation &&
+	    g_strcmp0 (priv->cached_feed_uri, feed_uri) == 0) {
+		return priv->cached_uri->str;
 	}
 
 	klass = GDATA_QUERY_GET_CLASS (self);
@@ -591,11 +840,88 @@ gdata_query_get_query_uri (GDataQuery *self, const gchar *feed_uri)
 	/* Determine whether the first param has already been appended (e.g. it exists in the feed_uri) */
 	params_started = (strstr (feed_uri, "?") != NULL) ? TRUE : FALSE;
 
-	/* Build the query URI */
-	query_uri = g_string_new (feed_uri);
-	klass->get_query_uri (self, feed_uri, query_uri, &params_started);
+	/* Take a note of the generation we're building, since subclasses may modify properties (e.g. the internal query string) in the
+	 * process, and we want to reuse the result until something *external* modifies the query. */
+	generation = priv->uri_generation;
+	priv->uri_is_volatile = FALSE;
 
-	return g_string_free (query_uri, FALSE);
+	/* Build the query URI, reusing the existing buffer */
+	if (priv->cached_uri == NULL)
+		priv->cached_uri = g_string_sized_new (strlen (feed_uri) + 128);
+
+	g_string_assign (priv->cached_uri, feed_uri);
+	klass->get_query_uri (self, feed_uri, priv->cached_uri, &params_started);
+
+	if (priv->cached_feed_uri == NULL || strcmp (priv->cached_feed_uri, feed_uri) != 0) {
+		g_free (priv->cached_feed_uri);
+		priv->cached_feed_uri = g_strdup (feed_uri);
+	}
+
+	priv->uri_generation = generation;
+	priv->cached_uri_generation = generation;
+
+	if (priv->cached_soup_uri != NULL) {
+		soup_uri_free (priv->cached_soup_uri);
+		priv->cached_soup_uri = NULL;
+	}
+
+	return priv->cached_uri->str;
+}
+
+/* Like _gdata_query_build_uri(), but returns the query URI parsed as a #SoupURI, so that the service doesn't have to parse it again for each
+ * message it builds. The returned #SoupURI is owned by the query, and must not be modified. Returns %NULL if there is no further page, or if
+ * the URI couldn't be parsed. */
+SoupURI *
+_gdata_query_get_soup_uri (GDataQuery *self, const gchar *feed_uri)
+{
+	GDataQueryPrivate *priv;
+	const gchar *query_uri;
+
+	g_return_val_if_fail (GDATA_IS_QUERY (self), NULL);
+	g_return_val_if_fail (feed_uri != NULL, NULL);
+
+	priv = self->priv;
+	query_uri = _gdata_query_build_uri (self, feed_uri);
+
+	if (query_uri == NULL)
+		return NULL;
+
+	/* Paginating by URIs doesn't go through the cache */
+	if (priv->cached_uri == NULL || query_uri != priv->cached_uri->str) {
+		if (priv->cached_soup_uri != NULL)
+			soup_uri_free (priv->cached_soup_uri);
+		priv->cached_soup_uri = soup_uri_new (query_uri);
+
+		/* Make sure this parsed URI isn't mistaken for that of the cached query URI */
+		invalidate_query_uri (self);
+
+		return priv->cached_soup_uri;
+	}
+
+	if (priv->cached_soup_uri == NULL)
+		priv->cached_soup_uri = soup_uri_new (query_uri);
+
+	return priv->cached_soup_uri;
+}
+
+/* Used internally by child classes of GDataQuery from their GDataQueryClass->get_query_uri implementation to indicate that the URI being built
+ * depends on something other than the query's properties (such as the current time), and so mustn't be cached. */
+void
+_gdata_query_mark_uri_volatile (GDataQuery *self)
+{
+	g_return_if_fail (GDATA_IS_QUERY (self));
+
+	self->priv->uri_is_volatile = TRUE;
+}
+
+/* Used internally by child classes of GDataQuery to invalidate the cached query URI after modifying state which isn't exposed as a property
+ * (and so doesn't cause a notification). */
+void
+_gdata_query_invalidate_uri (GDataQuery *self)
+{
+	g_return_if_fail (GDATA_IS_QUERY (self));
+
+	invalidate_query_uri (self);
 }
 
 /* Used internally by child classes of GDataQuery to add search clauses that represent service-specific
@@ -1043,6 +1369,289 @@ gdata_query_set_etag (GDataQuery *self, const gchar *etag)
 	g_object_notify (G_OBJECT (self), "etag");
 }
 
+/**
+ * gdata_query_get_fields:
+ * @self: a #GDataQuery
+ *
+ * Gets the #GDataQuery:fields property.
+ *
+ * Return value: the partial-response field selector, or %NULL if it is unset
+ *
+ * Since: 0.17.9
+ */
+const gchar *
+gdata_query_get_fields (GDataQuery *self)
+{
+	g_return_val_if_fail (GDATA_IS_QUERY (self), NULL);
+	return self->priv->fields;
+}
+
+/**
+ * gdata_query_set_fields:
+ * @self: a #GDataQuery
+ * @fields: (allow-none): the new field selector, or %NULL
+ *
+ * Sets the #GDataQuery:fields property of the #GDataQuery to the new partial-response field selector, @fields.
+ *
+ * Set @fields to %NULL (or an empty string) to request full entries again.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_query_set_fields (GDataQuery *self, const gchar *fields)
+{
+	g_return_if_fail (GDATA_IS_QUERY (self));
+
+	g_free (self->priv->fields);
+	self->priv->fields = (fields != NULL && *fields != '\0') ? g_strdup (fields) : NULL;
+	g_object_notify (G_OBJECT (self), "fields");
+
+	/* Our current ETag will no longer be relevant */
+	gdata_query_set_etag (self, NULL);
+}
+
+/**
+ * gdata_query_is_lite:
+ * @self: a #GDataQuery
+ *
+ * Gets the #GDataQuery:is-lite property.
+ *
+ * Return value: %TRUE if entries are parsed in lite mode, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_query_is_lite (GDataQuery *self)
+{
+	g_return_val_if_fail (GDATA_IS_QUERY (self), FALSE);
+	return self->priv->is_lite;
+}
+
+/**
+ * gdata_query_set_is_lite:
+ * @self: a #GDataQuery
+ * @is_lite: %TRUE to parse entries in lite mode, %FALSE otherwise
+ *
+ * Sets the #GDataQuery:is-lite property of the #GDataQuery to @is_lite.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_query_set_is_lite (GDataQuery *self, gboolean is_lite)
+{
+	g_return_if_fail (GDATA_IS_QUERY (self));
+
+	self->priv->is_lite = is_lite;
+	g_object_notify (G_OBJECT (self), "is-lite");
+
+	/* The ETag is unaffected, since lite mode doesn't change the query URI */
+}
+
+/**
+ * gdata_query_get_progress_batch_size:
+ * @self: a #GDataQuery
+ *
+ * Gets the #GDataQuery:progress-batch-size property.
+ *
+ * Return value: the maximum number of entries per progress callback dispatch
+ *
+ * Since: 0.17.9
+ */
+guint
+gdata_query_get_progress_batch_size (GDataQuery *self)
+{
+	g_return_val_if_fail (GDATA_IS_QUERY (self), GDATA_QUERY_DEFAULT_PROGRESS_BATCH_SIZE);
+	return self->priv->progress_batch_size;
+}
+
+/**
+ * gdata_query_set_progress_batch_size:
+ * @self: a #GDataQuery
+ * @batch_size: the maximum number of entries per progress callback dispatch, which must be at least <code class="literal">1</code>
+ *
+ * Sets the #GDataQuery:progress-batch-size property of the #GDataQuery to @batch_size.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_query_set_progress_batch_size (GDataQuery *self, guint batch_size)
+{
+	g_return_if_fail (GDATA_IS_QUERY (self));
+	g_return_if_fail (batch_size > 0);
+
+	self->priv->progress_batch_size = batch_size;
+	g_object_notify (G_OBJECT (self), "progress-batch-size");
+}
+
+/**
+ * gdata_query_get_progress_latency:
+ * @self: a #GDataQuery
+ *
+ * Gets the #GDataQuery:progress-latency property.
+ *
+ * Return value: the maximum time an entry is held back before its progress callbacks are dispatched, in milliseconds
+ *
+ * Since: 0.17.9
+ */
+guint
+gdata_query_get_progress_latency (GDataQuery *self)
+{
+	g_return_val_if_fail (GDATA_IS_QUERY (self), GDATA_QUERY_DEFAULT_PROGRESS_LATENCY);
+	return self->priv->progress_latency;
+}
+
+/**
+ * gdata_query_set_progress_latency:
+ * @self: a #GDataQuery
+ * @latency: the maximum time an entry is held back before its progress callbacks are dispatched, in milliseconds
+ *
+ * Sets the #GDataQuery:progress-latency property of the #GDataQuery to @latency.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_query_set_progress_latency (GDataQuery *self, guint latency)
+{
+	g_return_if_fail (GDATA_IS_QUERY (self));
+
+	self->priv->progress_latency = latency;
+	g_object_notify (G_OBJECT (self), "progress-latency");
+}
+
+/**
+ * gdata_query_get_progress_in_thread:
+ * @self: a #GDataQuery
+ *
+ * Gets the #GDataQuery:progress-in-thread property.
+ *
+ * Return value: %TRUE if progress callbacks are called in the parsing thread, %FALSE if they're dispatched to the main thread
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_query_get_progress_in_thread (GDataQuery *self)
+{
+	g_return_val_if_fail (GDATA_IS_QUERY (self), FALSE);
+	return self->priv->progress_in_thread;
+}
+
+/**
+ * gdata_query_set_progress_in_thread:
+ * @self: a #GDataQuery
+ * @in_thread: %TRUE to call progress callbacks in the parsing thread, %FALSE to dispatch them to the main thread
+ *
+ * Sets the #GDataQuery:progress-in-thread property of the #GDataQuery to @in_thread.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_query_set_progress_in_thread (GDataQuery *self, gboolean in_thread)
+{
+	g_return_if_fail (GDATA_IS_QUERY (self));
+
+	self->priv->progress_in_thread = in_thread;
+	g_object_notify (G_OBJECT (self), "progress-in-thread");
+}
+
+/**
+ * gdata_query_get_prefetch_depth:
+ * @self: a #GDataQuery
+ *
+ * Gets the #GDataQuery:prefetch-depth property.
+ *
+ * Return value: the number of following pages to fetch in the background, or <code class="literal">0</code> if read-ahead is disabled
+ *
+ * Since: 0.17.9
+ */
+guint
+gdata_query_get_prefetch_depth (GDataQuery *self)
+{
+	g_return_val_if_fail (GDATA_IS_QUERY (self), 0);
+	return self->priv->prefetch_depth;
+}
+
+/**
+ * gdata_query_set_prefetch_depth:
+ * @self: a #GDataQuery
+ * @depth: the number of following pages to fetch in the background, or <code class="literal">0</code> to disable read-ahead
+ *
+ * Sets the #GDataQuery:prefetch-depth property of the #GDataQuery to @depth. Disabling read-ahead discards any pages which have already
+ * been read ahead.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_query_set_prefetch_depth (GDataQuery *self, guint depth)
+{
+	g_return_if_fail (GDATA_IS_QUERY (self));
+
+	self->priv->prefetch_depth = depth;
+
+	if (depth == 0)
+		cancel_prefetches (self);
+
+	g_object_notify (G_OBJECT (self), "prefetch-depth");
+}
+
+/**
+ * gdata_query_set_batch_progress_callback:
+ * @self: a #GDataQuery
+ * @callback: (allow-none) (scope notified) (closure user_data): a #GDataQueryBatchProgressCallback to call with batches of parsed entries,
+ * or %NULL
+ * @user_data: (closure): data to pass to @callback
+ * @destroy_user_data: (allow-none): the function to call when @callback is replaced or @self is finalized, or %NULL
+ *
+ * Sets a callback to be called with batches of the entries parsed by queries made with @self, as an alternative (or in addition) to the
+ * per-entry #GDataQueryProgressCallback passed to the query function. The batches are formed according to #GDataQuery:progress-batch-size
+ * and #GDataQuery:progress-latency, and are dispatched in the thread given by #GDataQuery:progress-in-thread.
+ *
+ * Any previously set callback is replaced, and its user data destroyed. Pass %NULL for @callback to unset it.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_query_set_batch_progress_callback (GDataQuery *self, GDataQueryBatchProgressCallback callback, gpointer user_data,
+                                         GDestroyNotify destroy_user_data)
+{
+	GDataQueryPrivate *priv;
+
+	g_return_if_fail (GDATA_IS_QUERY (self));
+
+	priv = self->priv;
+
+	if (priv->batch_progress_destroy_notify != NULL)
+		priv->batch_progress_destroy_notify (priv->batch_progress_user_data);
+
+	priv->batch_progress_callback = callback;
+	priv->batch_progress_user_data = (callback != NULL) ? user_data : NULL;
+	priv->batch_progress_destroy_notify = (callback != NULL) ? destroy_user_data : NULL;
+}
+
+/* Get the callback set with gdata_query_set_batch_progress_callback(), if any, and its user data. */
+GDataQueryBatchProgressCallback
+_gdata_query_get_batch_progress_callback (GDataQuery *self, gpointer *user_data)
+{
+	g_return_val_if_fail (GDATA_IS_QUERY (self), NULL);
+	g_return_val_if_fail (user_data != NULL, NULL);
+
+	*user_data = self->priv->batch_progress_user_data;
+	return self->priv->batch_progress_callback;
+}
+
+/* Append the fields parameter to a query URI. This is separate from get_query_uri() so that subclasses which don't chain up (such as
+ * GDataYouTubeQuery) can still use it. The selector's punctuation is left unescaped, as the servers expect it verbatim. */
+void
+_gdata_query_append_fields (GDataQuery *self, GString *query_uri, gboolean *params_started)
+{
+	g_return_if_fail (GDATA_IS_QUERY (self));
+
+	if (self->priv->fields != NULL) {
+		APPEND_SEP
+		g_string_append (query_uri, "fields=");
+		g_string_append_uri_escaped (query_uri, self->priv->fields, "(),/*@:", FALSE);
+	}
+}
+
 void
 _gdata_query_clear_pagination (GDataQuery *self)
 {
@@ -1065,6 +1674,8 @@ _gdata_query_clear_pagination (GDataQuery *self)
 
 	self->priv->use_next_page = FALSE;
 	self->priv->use_previous_page = FALSE;
+
+	invalidate_query_uri (self);
 }
 
 void
@@ -1087,6 +1698,8 @@ _gdata_query_set_next_page_token (GDataQuery  *self,
 
 	g_free (self->priv->next_page_token);
 	self->priv->next_page_token = g_strdup (next_page_token);
+
+	invalidate_query_uri (self);
 }
 
 void
@@ -1098,6 +1711,8 @@ _gdata_query_set_next_uri (GDataQuery *self, const gchar *next_uri)
 
 	g_free (self->priv->next_uri);
 	self->priv->next_uri = g_strdup (next_uri);
+
+	invalidate_query_uri (self);
 }
 
 gboolean
@@ -1126,6 +1741,8 @@ _gdata_query_set_previous_uri (GDataQuery *self, const gchar *previous_uri)
 
 	g_free (self->priv->previous_uri);
 	self->priv->previous_uri = g_strdup (previous_uri);
+
+	invalidate_query_uri (self);
 }
 
 /**
@@ -1162,6 +1779,8 @@ gdata_query_next_page (GDataQuery *self)
 		g_assert_not_reached ();
 	}
 
+	invalidate_query_uri (self);
+
 	/* Our current ETag will no longer be relevant */
 	gdata_query_set_etag (self, NULL);
 }
@@ -1214,9 +1833,197 @@ gdata_query_previous_page (GDataQuery *self)
 	}
 
 	if (retval) {
+		invalidate_query_uri (self);
+
 		/* Our current ETag will no longer be relevant */
 		gdata_query_set_etag (self, NULL);
 	}
 
 	return retval;
 }
+
+/* Builds the URI which the query would use for the page @pages_ahead pages after the current one (i.e. after @pages_ahead calls to
+ * gdata_query_next_page()), without changing the query's state. @feed is the current page, as just returned for the query. Returns %NULL if
+ * there is no such page, or if the URI can't be known yet (because it depends on a page which hasn't been parsed) or isn't stable (because
+ * it depends on the current time). */
+gchar *
+_gdata_query_build_next_page_uri (GDataQuery *self, const gchar *feed_uri, GDataFeed *feed, guint pages_ahead)
+{
+	GDataQueryPrivate *priv;
+	GDataQueryClass *klass;
+	GString *query_uri;
+	gboolean params_started, uri_is_volatile;
+	guint start_index, generation, i;
+	gboolean use_next_page, use_previous_page;
+
+	g_return_val_if_fail (GDATA_IS_QUERY (self), NULL);
+	g_return_val_if_fail (feed_uri != NULL, NULL);
+	g_return_val_if_fail (GDATA_IS_FEED (feed), NULL);
+	g_return_val_if_fail (pages_ahead > 0, NULL);
+
+	priv = self->priv;
+
+	switch (priv->pagination_type) {
+	case GDATA_QUERY_PAGINATION_INDEXED:
+		/* Without a page size, there are no pages */
+		if (priv->max_results == 0)
+			return NULL;
+
+		/* _gdata_query_is_finished() can't tell when an indexed query has reached its last page, so use the current page instead: a short
+		 * page is the last one, as is any page which reaches the total number of results (if the server gave it) */
+		if (g_list_length (gdata_feed_get_entries (feed)) < priv->max_results)
+			return NULL;
+
+		if (gdata_feed_get_total_results (feed) > 0 &&
+		    MAX (priv->start_index, 1) + pages_ahead * priv->max_results > gdata_feed_get_total_results (feed))
+			return NULL;
+
+		break;
+	case GDATA_QUERY_PAGINATION_URIS:
+		/* The page after next isn't known until the next page has been parsed */
+		return (pages_ahead == 1) ? g_strdup (priv->next_uri) : NULL;
+	case GDATA_QUERY_PAGINATION_TOKENS:
+		if (pages_ahead > 1 || priv->next_page_token == NULL || *priv->next_page_token == '\0')
+			return NULL;
+		break;
+	default:
+		g_assert_not_reached ();
+	}
+
+	/* Temporarily move the query forward as gdata_query_next_page() would, and build the URI from scratch. Everything which is changed is
+	 * restored afterwards, including the URI cache state, so the query is left as it was. */
+	start_index = priv->start_index;
+	use_next_page = priv->use_next_page;
+	use_previous_page = priv->use_previous_page;
+	generation = priv->uri_generation;
+	uri_is_volatile = priv->uri_is_volatile;
+
+	if (priv->pagination_type == GDATA_QUERY_PAGINATION_INDEXED) {
+		for (i = 0; i < pages_ahead; i++) {
+			if (priv->start_index == 0)
+				priv->start_index++;
+			priv->start_index += priv->max_results;
+		}
+	} else {
+		priv->use_next_page = TRUE;
+		priv->use_previous_page = FALSE;
+	}
+
+	priv->uri_is_volatile = FALSE;
+
+	klass = GDATA_QUERY_GET_CLASS (self);
+	g_assert (klass->get_query_uri != NULL);
+
+	params_started = (strstr (feed_uri, "?") != NULL) ? TRUE : FALSE;
+	query_uri = g_string_new (feed_uri);
+	klass->get_query_uri (self, feed_uri, query_uri, &params_started);
+
+	/* There's no point fetching a page ahead if the URI will be different by the time it's needed */
+	if (priv->uri_is_volatile == TRUE) {
+		g_string_free (query_uri, TRUE);
+		query_uri = NULL;
+	}
+
+	priv->start_index = start_index;
+	priv->use_next_page = use_next_page;
+	priv->use_previous_page = use_previous_page;
+	priv->uri_generation = generation;
+	priv->uri_is_volatile = uri_is_volatile;
+
+	return (query_uri != NULL) ? g_string_free (query_uri, FALSE) : NULL;
+}
+
+/* Adds a page being read ahead to the query, which takes ownership of it. It will be cancelled if the query changes. */
+void
+_gdata_query_add_prefetch (GDataQuery *self, GDataPrefetch *prefetch)
+{
+	g_return_if_fail (GDATA_IS_QUERY (self));
+	g_return_if_fail (prefetch != NULL);
+
+	g_mutex_lock (&self->priv->prefetch_mutex);
+
+	if (self->priv->prefetches == NULL)
+		self->priv->prefetches = g_ptr_array_new_with_free_func ((GDestroyNotify) _gdata_prefetch_cancel_and_unref);
+
+	g_ptr_array_add (self->priv->prefetches, prefetch);
+
+	g_mutex_unlock (&self->priv->prefetch_mutex);
+}
+
+/* Looks for a page being read ahead for @uri by @service in @domain. If one's found, it's removed from the query and returned (transfer
+ * full); otherwise %NULL is returned. */
+GDataPrefetch *
+_gdata_query_steal_prefetch (GDataQuery *self, GDataService *service, GDataAuthorizationDomain *domain, const gchar *uri)
+{
+	GDataPrefetch *prefetch = NULL;
+	guint i;
+
+	g_return_val_if_fail (GDATA_IS_QUERY (self), NULL);
+	g_return_val_if_fail (uri != NULL, NULL);
+
+	g_mutex_lock (&self->priv->prefetch_mutex);
+
+	for (i = 0; self->priv->prefetches != NULL && i < self->priv->prefetches->len; i++) {
+		if (_gdata_prefetch_matches (self->priv->prefetches->pdata[i], service, domain, uri) == TRUE) {
+			/* Clear the element before removing it so that it isn't freed */
+			prefetch = self->priv->prefetches->pdata[i];
+			self->priv->prefetches->pdata[i] = NULL;
+			g_ptr_array_remove_index (self->priv->prefetches, i);
+			break;
+		}
+	}
+
+	g_mutex_unlock (&self->priv->prefetch_mutex);
+
+	return prefetch;
+}
+
+/* Checks whether a page is already being read ahead for @uri by @service in @domain. */
+gboolean
+_gdata_query_has_prefetch (GDataQuery *self, GDataService *service, GDataAuthorizationDomain *domain, const gchar *uri)
+{
+	gboolean retval = FALSE;
+	guint i;
+
+	g_return_val_if_fail (GDATA_IS_QUERY (self), FALSE);
+	g_return_val_if_fail (uri != NULL, FALSE);
+
+	g_mutex_lock (&self->priv->prefetch_mutex);
+
+	for (i = 0; self->priv->prefetches != NULL && i < self->priv->prefetches->len; i++) {
+		if (_gdata_prefetch_matches (self->priv->prefetches->pdata[i], service, domain, uri) == TRUE) {
+			retval = TRUE;
+			break;
+		}
+	}
+
+	g_mutex_unlock (&self->priv->prefetch_mutex);
+
+	return retval;
+}
+
+/* Cancels and removes any pages being read ahead which aren't for one of the @n_uris URIs in @uris, fetched by @service in @domain. This
+ * drops pages which the query has moved past (or away from). */
+void
+_gdata_query_retain_prefetches (GDataQuery *self, GDataService *service, GDataAuthorizationDomain *domain, gchar **uris, guint n_uris)
+{
+	guint i, j;
+
+	g_return_if_fail (GDATA_IS_QUERY (self));
+
+	g_mutex_lock (&self->priv->prefetch_mutex);
+
+	for (i = 0; self->priv->prefetches != NULL && i < self->priv->prefetches->len;) {
+		gboolean wanted = FALSE;
+
+		for (j = 0; j < n_uris && wanted == FALSE; j++)
+			wanted = _gdata_prefetch_matches (self->priv->prefetches->pdata[i], service, domain, uris[j]);
+
+		if (wanted == TRUE)
+			i++;
+		else
+			g_ptr_array_remove_index (self->priv->prefetches, i);
+	}
+
+	g_mutex_unlock (&self->priv->prefetch_mutex);
+}
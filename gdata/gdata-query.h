@@ -34,6 +34,62 @@ G_BEGIN_DECLS
 
 typedef struct _GDataQueryPrivate	GDataQueryPrivate;
 
+/**
+ * GDataQueryFields:
+ * @GDATA_QUERY_FIELDS_ID: request the ID of each entry
+ * @GDATA_QUERY_FIELDS_ETAG: request the ETag of each entry
+ * @GDATA_QUERY_FIELDS_UPDATED: request the last modification time of each entry
+ * @GDATA_QUERY_FIELDS_TITLE: request the title of each entry
+ * @GDATA_QUERY_FIELDS_DELETED: request the deletion (or trashed) status of each entry, where the service supports it
+ *
+ * A set of commonly requested entry fields, used to build a partial-response field mask for services which support one. Each service maps
+ * these onto its own element or member names; see gdata_contacts_query_set_field_mask(), gdata_documents_query_set_field_mask() and
+ * gdata_youtube_query_set_field_mask(). For anything not covered by these flags, set #GDataQuery:fields directly.
+ *
+ * Since: 0.17.9
+ */
+typedef enum {
+	GDATA_QUERY_FIELDS_ID = 1 << 0,
+	GDATA_QUERY_FIELDS_ETAG = 1 << 1,
+	GDATA_QUERY_FIELDS_UPDATED = 1 << 2,
+	GDATA_QUERY_FIELDS_TITLE = 1 << 3,
+	GDATA_QUERY_FIELDS_DELETED = 1 << 4
+} GDataQueryFields;
+
+/**
+ * GDATA_QUERY_DEFAULT_PROGRESS_BATCH_SIZE:
+ *
+ * The default value of #GDataQuery:progress-batch-size.
+ *
+ * Since: 0.17.9
+ */
+#define GDATA_QUERY_DEFAULT_PROGRESS_BATCH_SIZE 32
+
+/**
+ * GDATA_QUERY_DEFAULT_PROGRESS_LATENCY:
+ *
+ * The default value of #GDataQuery:progress-latency, in milliseconds.
+ *
+ * Since: 0.17.9
+ */
+#define GDATA_QUERY_DEFAULT_PROGRESS_LATENCY 100
+
+/**
+ * GDataQueryBatchProgressCallback:
+ * @entries: (element-type GData.Entry): the newly parsed #GDataEntry<!-- -->s, in feed order
+ * @first_entry_key: the key of the first entry in @entries (zero-based index of its position in the feed)
+ * @entry_count: the total number of entries in the feed
+ * @user_data: user data passed to the callback
+ *
+ * Callback function called with batches of the #GDataEntry<!-- -->s parsed in a #GDataFeed when loading the results of a query. Batches are
+ * delivered in feed order, and all of them are delivered before the query completes. Set one with gdata_query_set_batch_progress_callback().
+ *
+ * @entries is only valid for the duration of the callback; take a reference on any entries which need to be kept.
+ *
+ * Since: 0.17.9
+ */
+typedef void (*GDataQueryBatchProgressCallback) (GPtrArray *entries, guint first_entry_key, guint entry_count, gpointer user_data);
+
 /**
  * GDataQuery:
  *
@@ -96,6 +152,20 @@ guint gdata_query_get_max_results (GDataQuery *self) G_GNUC_PURE;
 void gdata_query_set_max_results (GDataQuery *self, guint max_results);
 const gchar *gdata_query_get_etag (GDataQuery *self) G_GNUC_PURE;
 void gdata_query_set_etag (GDataQuery *self, const gchar *etag);
+const gchar *gdata_query_get_fields (GDataQuery *self) G_GNUC_PURE;
+void gdata_query_set_fields (GDataQuery *self, const gchar *fields);
+gboolean gdata_query_is_lite (GDataQuery *self) G_GNUC_PURE;
+void gdata_query_set_is_lite (GDataQuery *self, gboolean is_lite);
+guint gdata_query_get_progress_batch_size (GDataQuery *self) G_GNUC_PURE;
+void gdata_query_set_progress_batch_size (GDataQuery *self, guint batch_size);
+guint gdata_query_get_progress_latency (GDataQuery *self) G_GNUC_PURE;
+void gdata_query_set_progress_latency (GDataQuery *self, guint latency);
+gboolean gdata_query_get_progress_in_thread (GDataQuery *self) G_GNUC_PURE;
+void gdata_query_set_progress_in_thread (GDataQuery *self, gboolean in_thread);
+guint gdata_query_get_prefetch_depth (GDataQuery *self) G_GNUC_PURE;
+void gdata_query_set_prefetch_depth (GDataQuery *self, guint depth);
+void gdata_query_set_batch_progress_callback (GDataQuery *self, GDataQueryBatchProgressCallback callback, gpointer user_data,
+                                              GDestroyNotify destroy_user_data);
 
 G_END_DECLS
 
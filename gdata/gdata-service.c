@@ -35,6 +35,10 @@
  * Note that it's not always necessary to supply a #GDataAuthorizer instance to a #GDataService. If the only operations to be performed on the
  * #GDataService don't need authorization (e.g. they only query public information), setting up a #GDataAuthorizer is just extra overhead. See the
  * documentation for the operations on individual #GDataService subclasses to see which need authorization and which don't.
+ *
+ * The network requests made by a #GDataService can be monitored by connecting to its #GDataService::request-finished signal, which is emitted
+ * once for each request with a #GDataRequestStatistics structure describing its timings, sizes and outcome. The statistics are only gathered
+ * while a handler is connected, so there is no overhead otherwise.
  */
 
 #include <config.h>
@@ -43,6 +47,7 @@
 #include <libsoup/soup.h>
 #include <string.h>
 #include <stdarg.h>
+#include <time.h>
 
 #ifdef HAVE_GNOME
 #define GCR_API_SUBJECT_TO_CHANGE
@@ -61,6 +66,7 @@ gdata_service_error_quark (void)
 	return g_quark_from_static_string ("gdata-service-error-quark");
 }
 
+static void gdata_service_constructed (GObject *object);
 static void gdata_service_dispose (GObject *object);
 static void gdata_service_finalize (GObject *object);
 static void gdata_service_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
@@ -68,6 +74,7 @@ static void gdata_service_set_property (GObject *object, guint property_id, cons
 static void real_append_query_headers (GDataService *self, GDataAuthorizationDomain *domain, SoupMessage *message);
 static void real_parse_error_response (GDataService *self, GDataOperationType operation_type, guint status, const gchar *reason_phrase,
                                        const gchar *response_body, gint length, GError **error);
+static gint real_get_retry_delay (GDataService *self, SoupMessage *message, guint attempt);
 static GDataFeed *
 real_parse_feed (GDataService *self,
                  GDataAuthorizationDomain *domain,
@@ -80,6 +87,9 @@ real_parse_feed (GDataService *self,
                  GError **error);
 static void notify_proxy_uri_cb (GObject *gobject, GParamSpec *pspec, GObject *self);
 static void notify_timeout_cb (GObject *gobject, GParamSpec *pspec, GObject *self);
+static void notify_max_conns_cb (GObject *gobject, GParamSpec *pspec, GObject *self);
+static void notify_max_conns_per_host_cb (GObject *gobject, GParamSpec *pspec, GObject *self);
+static void notify_idle_timeout_cb (GObject *gobject, GParamSpec *pspec, GObject *self);
 static void debug_handler (const char *log_domain, GLogLevelFlags log_level, const char *message, gpointer user_data);
 static void soup_log_printer (SoupLogger *logger, SoupLoggerLogLevel level, char direction, const char *data, gpointer user_data);
 
@@ -95,17 +105,87 @@ struct _GDataServicePrivate {
 	gchar *locale;
 	GDataAuthorizer *authorizer;
 	GProxyResolver *proxy_resolver;
+
+	guint max_retries;
+	GMutex retry_mutex; /* protects retry_budgets */
+	GHashTable/*<owned gchar*, owned RetryBudget*>*/ *retry_budgets;
+
+	GMutex rate_limit_mutex; /* protects rate_limiters */
+	GHashTable/*<unowned GDataAuthorizationDomain*, owned RateLimiter*>*/ *rate_limiters;
 };
 
+/* A per-host budget limiting the proportion of requests which can be retries, so that a struggling server isn't overloaded by clients
+ * retrying en masse. Each request deposits RETRY_BUDGET_RATIO tokens, up to RETRY_BUDGET_MAX, and each retry withdraws one token. */
+typedef struct {
+	gdouble tokens;
+} RetryBudget;
+
+#define RETRY_BUDGET_RATIO 0.1
+#define RETRY_BUDGET_MAX 10.0
+
+#define DEFAULT_MAX_RETRIES 3
+#define RETRY_BASE_DELAY 500 /* milliseconds */
+#define RETRY_MAX_DELAY 32000 /* milliseconds */
+
+/* libsoup 2 has no constant for this */
+#define STATUS_TOO_MANY_REQUESTS 429
+
+/* A token bucket pacing the requests made under one authorization domain. Tokens are reserved in the order requests arrive, and may go
+ * negative, in which case the request waits until its token would have been added. This queues concurrent callers fairly, in FIFO order. If
+ * @adaptive is set, the rate is reduced multiplicatively when the server reports that the quota has been exceeded, and recovers additively
+ * towards @rate as requests succeed. */
+typedef struct {
+	gdouble rate; /* requests per second */
+	gdouble effective_rate; /* requests per second */
+	gdouble burst;
+	gboolean adaptive;
+
+	gdouble tokens;
+	gint64 last_refill; /* monotonic time, in microseconds */
+} RateLimiter;
+
+#define RATE_LIMIT_MIN_FACTOR (1.0 / 16.0)
+#define RATE_LIMIT_RECOVERY_FACTOR (1.0 / 20.0)
+
+/* Statistics for a request in progress, attached to its SoupMessage while a #GDataService::request-finished handler is connected. The signal
+ * is emitted when the message is finalised, so that the time spent parsing the response can be included. */
+typedef struct {
+	GDataService *service; /* owned */
+	GDataRequestStatistics statistics;
+	gint64 start_time;
+	gint64 attempt_start_time;
+	gint64 phase_start_time; /* start of the current DNS, connect or TLS phase */
+	GDataParseStatistics parse_statistics; /* collected during the current parse */
+} RequestInstrumentation;
+
 enum {
 	PROP_PROXY_URI = 1,
 	PROP_TIMEOUT,
 	PROP_LOCALE,
 	PROP_AUTHORIZER,
 	PROP_PROXY_RESOLVER,
+	PROP_SESSION,
+	PROP_MAX_CONNECTIONS,
+	PROP_MAX_CONNECTIONS_PER_HOST,
+	PROP_IDLE_TIMEOUT,
+	PROP_MAX_RETRIES,
+};
+
+enum {
+	SIGNAL_REQUEST_FINISHED,
+	LAST_SIGNAL
 };
 
+static guint service_signals[LAST_SIGNAL] = { 0, };
+
+/* libsoup only allows two connections per host by default, which serialises most of the requests made by multi-threaded clients, since all
+ * requests for a given service go to the same host. Allow a few more, in line with what web browsers do. */
+#define DEFAULT_MAX_CONNECTIONS 10
+#define DEFAULT_MAX_CONNECTIONS_PER_HOST 6
+#define DEFAULT_IDLE_TIMEOUT 60 /* seconds */
+
 G_DEFINE_TYPE (GDataService, gdata_service, G_TYPE_OBJECT)
+G_DEFINE_BOXED_TYPE (GDataRequestStatistics, gdata_request_statistics, gdata_request_statistics_copy, gdata_request_statistics_free)
 
 static void
 gdata_service_class_init (GDataServiceClass *klass)
@@ -116,6 +196,7 @@ gdata_service_class_init (GDataServiceClass *klass)
 
 	gobject_class->set_property = gdata_service_set_property;
 	gobject_class->get_property = gdata_service_get_property;
+	gobject_class->constructed = gdata_service_constructed;
 	gobject_class->dispose = gdata_service_dispose;
 	gobject_class->finalize = gdata_service_finalize;
 
@@ -124,6 +205,7 @@ gdata_service_class_init (GDataServiceClass *klass)
 	klass->append_query_headers = real_append_query_headers;
 	klass->parse_error_response = real_parse_error_response;
 	klass->parse_feed = real_parse_feed;
+	klass->get_retry_delay = real_get_retry_delay;
 	klass->get_authorization_domains = NULL; /* equivalent to returning an empty list of domains */
 
 	/**
@@ -215,23 +297,166 @@ gdata_service_class_init (GDataServiceClass *klass)
 	                                                      "Proxy Resolver", "A GProxyResolver used to determine a proxy URI.",
 	                                                      G_TYPE_PROXY_RESOLVER,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataService:session:
+	 *
+	 * The #SoupSession used for all network requests made by the service. If this is not set at construction time, a new session is created for
+	 * the service.
+	 *
+	 * Several services (of the same or different types) can share a session by passing the #GDataService:session of one to the others when
+	 * constructing them. They will then share a single connection pool, so persistent connections (and the TLS sessions on them) opened by one
+	 * service can be reused by the others, and the connection limits apply to all of them together. Note that the #GDataService:timeout,
+	 * #GDataService:proxy-resolver and connection limit properties are stored on the session, so setting them on one service affects all
+	 * services sharing its session.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_SESSION,
+	                                 g_param_spec_object ("session",
+	                                                      "Session", "The SoupSession used for all network requests.",
+	                                                      SOUP_TYPE_SESSION,
+	                                                      G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataService:max-connections:
+	 *
+	 * The maximum number of network connections the service's #GDataService:session will have open at any one time, across all hosts.
+	 * Requests made while this many connections are busy are queued until one becomes free.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_MAX_CONNECTIONS,
+	                                 g_param_spec_uint ("max-connections",
+	                                                    "Maximum connections", "The maximum number of concurrent network connections.",
+	                                                    1, G_MAXINT, DEFAULT_MAX_CONNECTIONS,
+	                                                    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataService:max-connections-per-host:
+	 *
+	 * The maximum number of network connections the service's #GDataService:session will have open to any single host at any one time. As
+	 * each service typically makes all its requests to a single host, this limits how many requests can be made in parallel (for example,
+	 * from several threads).
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_MAX_CONNECTIONS_PER_HOST,
+	                                 g_param_spec_uint ("max-connections-per-host",
+	                                                    "Maximum connections per host",
+	                                                    "The maximum number of concurrent network connections to a single host.",
+	                                                    1, G_MAXINT, DEFAULT_MAX_CONNECTIONS_PER_HOST,
+	                                                    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataService:idle-timeout:
+	 *
+	 * A timeout, in seconds, after which idle persistent connections are closed. Keeping connections open avoids the cost of a new TCP
+	 * connection and TLS handshake for each request.
+	 *
+	 * If the timeout is <code class="literal">0</code>, idle connections are kept open until the server closes them.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_IDLE_TIMEOUT,
+	                                 g_param_spec_uint ("idle-timeout",
+	                                                    "Idle timeout", "A timeout, in seconds, for idle persistent connections.",
+	                                                    0, G_MAXUINT, DEFAULT_IDLE_TIMEOUT,
+	                                                    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataService:max-retries:
+	 *
+	 * The maximum number of times a request will be retried after a transient failure, such as the server being temporarily unavailable or
+	 * rate limiting the client. Which failures are retried, and how long to wait before each retry, is decided by the
+	 * #GDataServiceClass.get_retry_delay virtual method. By default, retries use exponential backoff with jitter, honour any
+	 * <code class="literal">Retry-After</code> header from the server, and don't repeat non-idempotent requests (such as insertions) unless the
+	 * server definitely didn't process them.
+	 *
+	 * Retries are additionally limited to a small proportion of the requests made to each host, so that many clients retrying at once can't
+	 * overload a server which is struggling. If the limit is reached, the failure is returned to the caller without retrying.
+	 *
+	 * If this is <code class="literal">0</code>, requests will never be retried.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_MAX_RETRIES,
+	                                 g_param_spec_uint ("max-retries",
+	                                                    "Maximum retries", "The maximum number of times to retry a request after a transient failure.",
+	                                                    0, G_MAXUINT, DEFAULT_MAX_RETRIES,
+	                                                    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataService::request-finished:
+	 * @service: the #GDataService which made the request
+	 * @statistics: a #GDataRequestStatistics describing the request
+	 *
+	 * The #GDataService::request-finished signal is emitted once for each network request made by the service for a query, insertion,
+	 * update, deletion or batch operation, after any retries have been made and the response has been parsed. It is not emitted for
+	 * requests made by a #GDataDownloadStream or #GDataUploadStream.
+	 *
+	 * The signal is emitted in the thread which made the request, which will not be the main thread for asynchronous operations, so
+	 * handlers must be thread safe. @statistics is only valid for the duration of the emission; use gdata_request_statistics_copy() to keep
+	 * it.
+	 *
+	 * Pages of query results read ahead in the background (see #GDataQuery:prefetch-depth) are requested by a separate thread. For those,
+	 * the signal is emitted in that thread as soon as the response is received, whether or not the page is used, so the parse statistics
+	 * aren't set.
+	 *
+	 * The statistics are only gathered for requests started while at least one handler is connected.
+	 *
+	 * Since: 0.17.9
+	 */
+	service_signals[SIGNAL_REQUEST_FINISHED] = g_signal_new ("request-finished",
+	                                                         G_TYPE_FROM_CLASS (klass),
+	                                                         G_SIGNAL_RUN_LAST,
+	                                                         0, NULL, NULL,
+	                                                         g_cclosure_marshal_VOID__BOXED,
+	                                                         G_TYPE_NONE, 1, GDATA_TYPE_REQUEST_STATISTICS | G_SIGNAL_TYPE_STATIC_SCOPE);
 }
 
 static void
 gdata_service_init (GDataService *self)
 {
 	self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self, GDATA_TYPE_SERVICE, GDataServicePrivate);
-	self->priv->session = _gdata_service_build_session ();
+
+	self->priv->max_retries = DEFAULT_MAX_RETRIES;
+	g_mutex_init (&self->priv->retry_mutex);
+	self->priv->retry_budgets = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+	g_mutex_init (&self->priv->rate_limit_mutex);
+	self->priv->rate_limiters = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
 
 	/* Log handling for all message types except debug */
 	g_log_set_handler (G_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL | G_LOG_LEVEL_ERROR | G_LOG_LEVEL_INFO | G_LOG_LEVEL_MESSAGE | G_LOG_LEVEL_WARNING, (GLogFunc) debug_handler, self);
+}
+
+static void
+gdata_service_constructed (GObject *object)
+{
+	GDataServicePrivate *priv = GDATA_SERVICE (object)->priv;
+
+	/* Chain up to the parent class */
+	G_OBJECT_CLASS (gdata_service_parent_class)->constructed (object);
+
+	/* Build our own session if we haven't been given one to share */
+	if (priv->session == NULL) {
+		priv->session = _gdata_service_build_session ();
+		g_object_set (priv->session,
+		              SOUP_SESSION_MAX_CONNS, DEFAULT_MAX_CONNECTIONS,
+		              SOUP_SESSION_MAX_CONNS_PER_HOST, DEFAULT_MAX_CONNECTIONS_PER_HOST,
+		              SOUP_SESSION_IDLE_TIMEOUT, DEFAULT_IDLE_TIMEOUT,
+		              NULL);
+	}
 
-	/* Proxy the SoupSession's proxy-uri and timeout properties */
-	g_signal_connect (self->priv->session, "notify::proxy-uri", (GCallback) notify_proxy_uri_cb, self);
-	g_signal_connect (self->priv->session, "notify::timeout", (GCallback) notify_timeout_cb, self);
+	/* Proxy the SoupSession's proxy-uri, timeout and connection properties */
+	g_signal_connect (priv->session, "notify::proxy-uri", (GCallback) notify_proxy_uri_cb, object);
+	g_signal_connect (priv->session, "notify::timeout", (GCallback) notify_timeout_cb, object);
+	g_signal_connect (priv->session, "notify::max-conns", (GCallback) notify_max_conns_cb, object);
+	g_signal_connect (priv->session, "notify::max-conns-per-host", (GCallback) notify_max_conns_per_host_cb, object);
+	g_signal_connect (priv->session, "notify::idle-timeout", (GCallback) notify_idle_timeout_cb, object);
 
 	/* Keep our GProxyResolver synchronized with SoupSession's. */
-	g_object_bind_property (self->priv->session, "proxy-resolver", self, "proxy-resolver", G_BINDING_BIDIRECTIONAL | G_BINDING_SYNC_CREATE);
+	g_object_bind_property (priv->session, "proxy-resolver", object, "proxy-resolver", G_BINDING_BIDIRECTIONAL | G_BINDING_SYNC_CREATE);
 }
 
 static void
@@ -243,8 +468,11 @@ gdata_service_dispose (GObject *object)
 		g_object_unref (priv->authorizer);
 	priv->authorizer = NULL;
 
-	if (priv->session != NULL)
+	if (priv->session != NULL) {
+		/* The session may be shared with other services, so could outlive us */
+		g_signal_handlers_disconnect_by_data (priv->session, object);
 		g_object_unref (priv->session);
+	}
 	priv->session = NULL;
 
 	g_clear_object (&priv->proxy_resolver);
@@ -260,6 +488,11 @@ gdata_service_finalize (GObject *object)
 
 	g_free (priv->locale);
 
+	g_hash_table_destroy (priv->retry_budgets);
+	g_mutex_clear (&priv->retry_mutex);
+	g_hash_table_destroy (priv->rate_limiters);
+	g_mutex_clear (&priv->rate_limit_mutex);
+
 	/* Chain up to the parent class */
 	G_OBJECT_CLASS (gdata_service_parent_class)->finalize (object);
 }
@@ -285,6 +518,21 @@ gdata_service_get_property (GObject *object, guint property_id, GValue *value, G
 		case PROP_PROXY_RESOLVER:
 			g_value_set_object (value, priv->proxy_resolver);
 			break;
+		case PROP_SESSION:
+			g_value_set_object (value, priv->session);
+			break;
+		case PROP_MAX_CONNECTIONS:
+			g_value_set_uint (value, gdata_service_get_max_connections (GDATA_SERVICE (object)));
+			break;
+		case PROP_MAX_CONNECTIONS_PER_HOST:
+			g_value_set_uint (value, gdata_service_get_max_connections_per_host (GDATA_SERVICE (object)));
+			break;
+		case PROP_IDLE_TIMEOUT:
+			g_value_set_uint (value, gdata_service_get_idle_timeout (GDATA_SERVICE (object)));
+			break;
+		case PROP_MAX_RETRIES:
+			g_value_set_uint (value, priv->max_retries);
+			break;
 		default:
 			/* We don't have any other property... */
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -311,6 +559,22 @@ gdata_service_set_property (GObject *object, guint property_id, const GValue *va
 		case PROP_PROXY_RESOLVER:
 			gdata_service_set_proxy_resolver (GDATA_SERVICE (object), g_value_get_object (value));
 			break;
+		case PROP_SESSION:
+			/* Construct only; NULL means we build our own in constructed() */
+			GDATA_SERVICE (object)->priv->session = g_value_dup_object (value);
+			break;
+		case PROP_MAX_CONNECTIONS:
+			gdata_service_set_max_connections (GDATA_SERVICE (object), g_value_get_uint (value));
+			break;
+		case PROP_MAX_CONNECTIONS_PER_HOST:
+			gdata_service_set_max_connections_per_host (GDATA_SERVICE (object), g_value_get_uint (value));
+			break;
+		case PROP_IDLE_TIMEOUT:
+			gdata_service_set_idle_timeout (GDATA_SERVICE (object), g_value_get_uint (value));
+			break;
+		case PROP_MAX_RETRIES:
+			gdata_service_set_max_retries (GDATA_SERVICE (object), g_value_get_uint (value));
+			break;
 		default:
 			/* We don't have any other property... */
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -324,15 +588,14 @@ real_append_query_headers (GDataService *self, GDataAuthorizationDomain *domain,
 	g_assert (message != NULL);
 
 	/* Set the authorisation header */
-	if (self->priv->authorizer != NULL) {
+	if (self->priv->authorizer != NULL)
 		gdata_authorizer_process_request (self->priv->authorizer, domain, message);
 
-		if (domain != NULL) {
-			/* Store the authorisation domain on the message so that we can access it again after refreshing authorisation if necessary.
-			 * See _gdata_service_send_message(). */
-			g_object_set_data_full (G_OBJECT (message), "gdata-authorization-domain", g_object_ref (domain),
-			                        (GDestroyNotify) g_object_unref);
-		}
+	if (domain != NULL) {
+		/* Store the authorisation domain on the message so that we can access it again after refreshing authorisation if necessary, and
+		 * for rate limiting. See _gdata_service_send_message(). */
+		g_object_set_data_full (G_OBJECT (message), "gdata-authorization-domain", g_object_ref (domain),
+		                        (GDestroyNotify) g_object_unref);
 	}
 
 	/* Set the GData-Version header to tell it we want to use the v2 API */
@@ -578,17 +841,41 @@ _gdata_service_build_message (GDataService *self, GDataAuthorizationDomain *doma
                               const gchar *etag, gboolean etag_if_match)
 {
 	SoupMessage *message;
-	GDataServiceClass *klass;
 	SoupURI *_uri;
 
-	/* Create the message. Allow changing the HTTPS port just for testing,
-	 * but require that the URI is always HTTPS for privacy. */
 	_uri = soup_uri_new (uri);
-	soup_uri_set_port (_uri, _gdata_service_get_https_port ());
-	g_assert_cmpstr (soup_uri_get_scheme (_uri), ==, SOUP_URI_SCHEME_HTTPS);
-	message = soup_message_new_from_uri (method, _uri);
+	message = _gdata_service_build_message_from_soup_uri (self, domain, method, _uri, etag, etag_if_match);
 	soup_uri_free (_uri);
 
+	return message;
+}
+
+/* Like _gdata_service_build_message(), but takes an already-parsed URI (such as one cached by a #GDataQuery) to save parsing it again. @uri
+ * is not modified. */
+SoupMessage *
+_gdata_service_build_message_from_soup_uri (GDataService *self, GDataAuthorizationDomain *domain, const gchar *method, SoupURI *uri,
+                                            const gchar *etag, gboolean etag_if_match)
+{
+	SoupMessage *message;
+	GDataServiceClass *klass;
+	guint port;
+
+	/* Create the message. Allow changing the HTTPS port just for testing,
+	 * but require that the URI is always HTTPS for privacy. */
+	g_assert_cmpstr (soup_uri_get_scheme (uri), ==, SOUP_URI_SCHEME_HTTPS);
+
+	port = _gdata_service_get_https_port ();
+
+	if (soup_uri_get_port (uri) != port) {
+		SoupURI *_uri = soup_uri_copy (uri);
+
+		soup_uri_set_port (_uri, port);
+		message = soup_message_new_from_uri (method, _uri);
+		soup_uri_free (_uri);
+	} else {
+		message = soup_message_new_from_uri (method, uri);
+	}
+
 	/* Make sure subclasses set their headers */
 	klass = GDATA_SERVICE_GET_CLASS (self);
 	if (klass->append_query_headers != NULL)
@@ -709,8 +996,9 @@ _gdata_service_actually_send_message (SoupSession *session, SoupMessage *message
 	g_object_unref (session);
 }
 
-guint
-_gdata_service_send_message (GDataService *self, SoupMessage *message, GCancellable *cancellable, GError **error)
+/* Send @message once, following a redirect and refreshing the authorisation if necessary. */
+static guint
+send_message_once (GDataService *self, SoupMessage *message, GCancellable *cancellable, GError **error)
 {
 	/* Based on code from evolution-data-server's libgdata:
 	 *  Ebby Wiselyn <ebbywiselyn@gmail.com>
@@ -779,166 +1067,955 @@ _gdata_service_send_message (GDataService *self, SoupMessage *message, GCancella
 	return message->status_code;
 }
 
-typedef struct {
-	/* Input */
-	GDataAuthorizationDomain *domain;
-	gchar *feed_uri;
-	GDataQuery *query;
-	GType entry_type;
+static gboolean
+method_is_idempotent (const gchar *method)
+{
+	return (method == SOUP_METHOD_GET || method == SOUP_METHOD_HEAD || method == SOUP_METHOD_PUT || method == SOUP_METHOD_DELETE ||
+	        method == SOUP_METHOD_OPTIONS);
+}
 
-	/* Output */
-	GDataFeed *feed;
-	GDataQueryProgressCallback progress_callback;
-	gpointer progress_user_data;
-	GDestroyNotify destroy_progress_user_data;
-} QueryAsyncData;
+/* The error reasons with which Google APIs reject a request with a 403 because a quota or rate limit was exceeded, in lower case. The
+ * reasons are given in lower camel case (e.g. “userRateLimitExceeded”) in JSON errors, but older APIs capitalise them differently, so
+ * they're matched case-insensitively. */
+static const gchar *rate_limit_reasons[] = {
+	"ratelimitexceeded",
+	"userratelimitexceeded",
+	"dailylimitexceeded",
+};
 
-static void
-query_async_data_free (QueryAsyncData *self)
+/* Whether the server rejected @message because a quota or rate limit was exceeded. */
+static gboolean
+message_is_rate_limited (SoupMessage *message)
 {
-	if (self->domain != NULL)
-		g_object_unref (self->domain);
+	gchar *body;
+	gboolean rate_limited = FALSE;
+	guint i;
 
-	g_free (self->feed_uri);
-	if (self->query)
-		g_object_unref (self->query);
-	if (self->feed)
-		g_object_unref (self->feed);
+	if (message->status_code == STATUS_TOO_MANY_REQUESTS)
+		return TRUE;
 
-	g_slice_free (QueryAsyncData, self);
+	/* Some Google APIs report rate limiting as a 403 rather than a 429, giving the reason in the error body */
+	if (message->status_code != SOUP_STATUS_FORBIDDEN || message->response_body->length == 0)
+		return FALSE;
+
+	body = g_ascii_strdown (message->response_body->data, message->response_body->length);
+
+	for (i = 0; i < G_N_ELEMENTS (rate_limit_reasons) && rate_limited == FALSE; i++)
+		rate_limited = (strstr (body, rate_limit_reasons[i]) != NULL);
+
+	g_free (body);
+
+	return rate_limited;
 }
 
-static void
-query_thread (GSimpleAsyncResult *result, GDataService *service, GCancellable *cancellable)
+static gint
+real_get_retry_delay (GDataService *self, SoupMessage *message, guint attempt)
 {
-	GError *error = NULL;
-	QueryAsyncData *data = g_simple_async_result_get_op_res_gpointer (result);
+	const gchar *retry_after;
+	guint max_delay;
 
-	/* Execute the query and return */
-	data->feed = __gdata_service_query (service, data->domain, data->feed_uri, data->query, data->entry_type, cancellable,
-	                                    data->progress_callback, data->progress_user_data, &error);
-	if (data->feed == NULL && error != NULL) {
-		g_simple_async_result_set_from_error (result, error);
-		g_error_free (error);
+	switch (message->status_code) {
+		case SOUP_STATUS_CANT_CONNECT:
+		case STATUS_TOO_MANY_REQUESTS:
+			/* The server definitely didn't process the request, so it's always safe to retry */
+			break;
+		case SOUP_STATUS_FORBIDDEN:
+			if (message_is_rate_limited (message) == FALSE)
+				return -1;
+			break;
+		case SOUP_STATUS_IO_ERROR:
+		case SOUP_STATUS_INTERNAL_SERVER_ERROR:
+		case SOUP_STATUS_BAD_GATEWAY:
+		case SOUP_STATUS_SERVICE_UNAVAILABLE:
+		case SOUP_STATUS_GATEWAY_TIMEOUT:
+			/* The request may or may not have been processed, so only retry it if doing so twice is harmless */
+			if (method_is_idempotent (message->method) == FALSE)
+				return -1;
+			break;
+		default:
+			return -1;
 	}
 
-	if (data->destroy_progress_user_data != NULL) {
-		data->destroy_progress_user_data (data->progress_user_data);
+	/* Honour the server's request to back off for a given period, either in seconds or until a given date. If it's longer than we'd
+	 * ever back off for, give up rather than blocking the caller for that long. */
+	retry_after = soup_message_headers_get_one (message->response_headers, "Retry-After");
+	if (retry_after != NULL) {
+		gchar *end;
+		guint64 seconds;
+
+		seconds = g_ascii_strtoull (retry_after, &end, 10);
+
+		if (end == retry_after || *end != '\0') {
+			SoupDate *date = soup_date_new_from_string (retry_after);
+
+			if (date == NULL) {
+				seconds = 0;
+			} else {
+				time_t retry_time = soup_date_to_time_t (date), now = time (NULL);
+				seconds = (retry_time > now) ? retry_time - now : 0;
+				soup_date_free (date);
+			}
+		}
+
+		if (seconds > RETRY_MAX_DELAY / 1000)
+			return -1;
+
+		return seconds * 1000;
 	}
+
+	/* Otherwise, back off exponentially, with full jitter so that clients which failed at the same time don't all retry at the same time */
+	max_delay = MIN (RETRY_MAX_DELAY, RETRY_BASE_DELAY << MIN (attempt, 16));
+
+	return g_random_int_range (0, max_delay + 1);
 }
 
-/**
- * gdata_service_query_async:
- * @self: a #GDataService
- * @domain: (allow-none): the #GDataAuthorizationDomain the query falls under, or %NULL
- * @feed_uri: the feed URI to query, including the host name and protocol
- * @query: (allow-none): a #GDataQuery with the query parameters, or %NULL
- * @entry_type: a #GType for the #GDataEntry<!-- -->s to build from the XML
- * @cancellable: (allow-none): optional #GCancellable object, or %NULL
- * @progress_callback: (allow-none) (closure progress_user_data): a #GDataQueryProgressCallback to call when an entry is loaded, or %NULL
- * @progress_user_data: (closure): data to pass to the @progress_callback function
- * @destroy_progress_user_data: (allow-none): the function to call when @progress_callback will not be called any more, or %NULL. This function will be
- * called with @progress_user_data as a parameter and can be used to free any memory allocated for it.
- * @callback: a #GAsyncReadyCallback to call when the query is finished
- * @user_data: (closure): data to pass to the @callback function
- *
- * Queries the service's @feed_uri feed to build a #GDataFeed. @self, @feed_uri and
- * @query are all reffed/copied when this function is called, so can safely be freed after this function returns.
- *
- * For more details, see gdata_service_query(), which is the synchronous version of this function.
- *
- * When the operation is finished, @callback will be called. You can then call gdata_service_query_finish()
- * to get the results of the operation.
- *
- * Since: 0.9.1
- */
-void
-gdata_service_query_async (GDataService *self, GDataAuthorizationDomain *domain, const gchar *feed_uri, GDataQuery *query, GType entry_type,
-                           GCancellable *cancellable, GDataQueryProgressCallback progress_callback, gpointer progress_user_data,
-                           GDestroyNotify destroy_progress_user_data, GAsyncReadyCallback callback, gpointer user_data)
+/* Add a request's contribution to the retry budget for its host. */
+static void
+deposit_retry_budget (GDataService *self, SoupMessage *message)
 {
-	GSimpleAsyncResult *result;
-	QueryAsyncData *data;
+	const gchar *host = soup_uri_get_host (soup_message_get_uri (message));
+	RetryBudget *budget;
 
-	g_return_if_fail (GDATA_IS_SERVICE (self));
-	g_return_if_fail (domain == NULL || GDATA_IS_AUTHORIZATION_DOMAIN (domain));
-	g_return_if_fail (feed_uri != NULL);
-	g_return_if_fail (g_type_is_a (entry_type, GDATA_TYPE_ENTRY));
-	g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
-	g_return_if_fail (callback != NULL);
+	g_mutex_lock (&self->priv->retry_mutex);
 
-	data = g_slice_new (QueryAsyncData);
-	data->domain = (domain != NULL) ? g_object_ref (domain) : NULL;
-	data->feed_uri = g_strdup (feed_uri);
-	data->query = (query != NULL) ? g_object_ref (query) : NULL;
-	data->entry_type = entry_type;
-	data->feed = NULL;
-	data->progress_callback = progress_callback;
-	data->progress_user_data = progress_user_data;
-	data->destroy_progress_user_data = destroy_progress_user_data;
+	budget = g_hash_table_lookup (self->priv->retry_budgets, host);
+	if (budget == NULL) {
+		budget = g_new (RetryBudget, 1);
+		budget->tokens = RETRY_BUDGET_MAX;
+		g_hash_table_insert (self->priv->retry_budgets, g_strdup (host), budget);
+	} else {
+		budget->tokens = MIN (budget->tokens + RETRY_BUDGET_RATIO, RETRY_BUDGET_MAX);
+	}
 
-	result = g_simple_async_result_new (G_OBJECT (self), callback, user_data, gdata_service_query_async);
-	g_simple_async_result_set_op_res_gpointer (result, data, (GDestroyNotify) query_async_data_free);
-	g_simple_async_result_run_in_thread (result, (GSimpleAsyncThreadFunc) query_thread, G_PRIORITY_DEFAULT, cancellable);
-	g_object_unref (result);
+	g_mutex_unlock (&self->priv->retry_mutex);
 }
 
-/**
- * gdata_service_query_finish:
- * @self: a #GDataService
- * @async_result: a #GAsyncResult
- * @error: a #GError, or %NULL
- *
- * Finishes an asynchronous query operation started with gdata_service_query_async().
- *
- * Return value: (transfer full): a #GDataFeed of query results, or %NULL; unref with g_object_unref()
- */
-GDataFeed *
-gdata_service_query_finish (GDataService *self, GAsyncResult *async_result, GError **error)
+/* Take a retry from the budget for the message's host, returning %FALSE if the budget has been used up. */
+static gboolean
+withdraw_retry_budget (GDataService *self, SoupMessage *message)
 {
-	GSimpleAsyncResult *result = G_SIMPLE_ASYNC_RESULT (async_result);
-	QueryAsyncData *data;
+	const gchar *host = soup_uri_get_host (soup_message_get_uri (message));
+	RetryBudget *budget;
+	gboolean allowed = FALSE;
 
-	g_return_val_if_fail (GDATA_IS_SERVICE (self), NULL);
-	g_return_val_if_fail (G_IS_ASYNC_RESULT (async_result), NULL);
-	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+	g_mutex_lock (&self->priv->retry_mutex);
 
-	g_warn_if_fail (g_simple_async_result_get_source_tag (result) == gdata_service_query_async);
+	budget = g_hash_table_lookup (self->priv->retry_budgets, host);
+	if (budget != NULL && budget->tokens >= 1.0) {
+		budget->tokens -= 1.0;
+		allowed = TRUE;
+	}
 
-	if (g_simple_async_result_propagate_error (result, error) == TRUE)
-		return NULL;
+	g_mutex_unlock (&self->priv->retry_mutex);
 
-	data = g_simple_async_result_get_op_res_gpointer (result);
-	if (data->feed != NULL)
-		return g_object_ref (data->feed);
-	return NULL;
+	return allowed;
 }
 
-/* Does the bulk of the work of gdata_service_query. Split out because certain queries (such as that done by
- * gdata_service_query_single_entry()) only return a single entry, and thus need special parsing code. */
-SoupMessage *
-_gdata_service_query (GDataService *self, GDataAuthorizationDomain *domain, const gchar *feed_uri, GDataQuery *query,
-                      GCancellable *cancellable, GError **error)
+/* Sleep for @delay milliseconds, returning early with %FALSE if @cancellable is cancelled. */
+static gboolean
+wait_cancellably (guint delay, GCancellable *cancellable)
 {
-	SoupMessage *message;
-	guint status;
-	const gchar *etag = NULL;
-
-	/* Append the ETag header if possible */
-	if (query != NULL)
-		etag = gdata_query_get_etag (query);
+	GPollFD pollfd;
 
-	/* Build the message */
-	if (query != NULL) {
-		gchar *query_uri = gdata_query_get_query_uri (query, feed_uri);
-		message = _gdata_service_build_message (self, domain, SOUP_METHOD_GET, query_uri, etag, FALSE);
-		g_free (query_uri);
+	if (cancellable != NULL && g_cancellable_make_pollfd (cancellable, &pollfd) == TRUE) {
+		g_poll (&pollfd, 1, delay);
+		g_cancellable_release_fd (cancellable);
 	} else {
-		message = _gdata_service_build_message (self, domain, SOUP_METHOD_GET, feed_uri, etag, FALSE);
+		g_usleep (delay * 1000);
 	}
 
-	/* Note that cancellation only applies to network activity; not to the processing done afterwards */
-	status = _gdata_service_send_message (self, message, cancellable, error);
+	return (cancellable == NULL || g_cancellable_is_cancelled (cancellable) == FALSE);
+}
+
+static void
+rate_limiter_refill (RateLimiter *limiter, gint64 now)
+{
+	limiter->tokens = MIN (limiter->burst, limiter->tokens + limiter->effective_rate * (now - limiter->last_refill) / G_USEC_PER_SEC);
+	limiter->last_refill = now;
+}
+
+/* Reserve a token for @message from the rate limiter for its authorization domain, if there is one, returning the number of milliseconds
+ * to wait before sending it. */
+static guint
+reserve_rate_limit_token (GDataService *self, SoupMessage *message)
+{
+	GDataAuthorizationDomain *domain;
+	RateLimiter *limiter;
+	guint delay = 0;
+
+	domain = g_object_get_data (G_OBJECT (message), "gdata-authorization-domain");
+
+	g_mutex_lock (&self->priv->rate_limit_mutex);
+
+	limiter = g_hash_table_lookup (self->priv->rate_limiters, domain);
+	if (limiter != NULL) {
+		rate_limiter_refill (limiter, g_get_monotonic_time ());
+		limiter->tokens -= 1.0;
+
+		if (limiter->tokens < 0.0)
+			delay = (guint) (-limiter->tokens * 1000.0 / limiter->effective_rate);
+	}
+
+	g_mutex_unlock (&self->priv->rate_limit_mutex);
+
+	return delay;
+}
+
+/* Return a reserved token which wasn't used because the request was cancelled while waiting. */
+static void
+release_rate_limit_token (GDataService *self, SoupMessage *message)
+{
+	RateLimiter *limiter;
+
+	g_mutex_lock (&self->priv->rate_limit_mutex);
+
+	limiter = g_hash_table_lookup (self->priv->rate_limiters, g_object_get_data (G_OBJECT (message), "gdata-authorization-domain"));
+	if (limiter != NULL)
+		limiter->tokens = MIN (limiter->burst, limiter->tokens + 1.0);
+
+	g_mutex_unlock (&self->priv->rate_limit_mutex);
+}
+
+/* Adapt the rate limit for @message's authorization domain to the server's response to it. */
+static void
+update_rate_limit (GDataService *self, SoupMessage *message)
+{
+	RateLimiter *limiter;
+
+	g_mutex_lock (&self->priv->rate_limit_mutex);
+
+	limiter = g_hash_table_lookup (self->priv->rate_limiters, g_object_get_data (G_OBJECT (message), "gdata-authorization-domain"));
+	if (limiter != NULL && limiter->adaptive == TRUE) {
+		gdouble old_rate = limiter->effective_rate;
+
+		/* Account for tokens added at the old rate before changing it */
+		rate_limiter_refill (limiter, g_get_monotonic_time ());
+
+		if (message_is_rate_limited (message) == TRUE) {
+			limiter->effective_rate = MAX (limiter->rate * RATE_LIMIT_MIN_FACTOR, limiter->effective_rate / 2.0);
+		} else if (SOUP_STATUS_IS_SUCCESSFUL (message->status_code)) {
+			limiter->effective_rate = MIN (limiter->rate, limiter->effective_rate + limiter->rate * RATE_LIMIT_RECOVERY_FACTOR);
+		}
+
+		if (limiter->effective_rate != old_rate)
+			g_debug ("Adjusted rate limit from %.3f to %.3f requests per second.", old_rate, limiter->effective_rate);
+	}
+
+	g_mutex_unlock (&self->priv->rate_limit_mutex);
+}
+
+/**
+ * gdata_request_statistics_copy:
+ * @self: a #GDataRequestStatistics
+ *
+ * Copies @self, including its strings, so that it can be kept after the #GDataService::request-finished signal emission it was passed to.
+ *
+ * Return value: (transfer full): a copy of @self; free with gdata_request_statistics_free()
+ *
+ * Since: 0.17.9
+ */
+GDataRequestStatistics *
+gdata_request_statistics_copy (const GDataRequestStatistics *self)
+{
+	GDataRequestStatistics *copy;
+
+	g_return_val_if_fail (self != NULL, NULL);
+
+	copy = g_slice_dup (GDataRequestStatistics, self);
+	copy->method = g_intern_string (self->method);
+	copy->host = g_strdup (self->host);
+
+	if (copy->authorization_domain != NULL)
+		g_object_ref (copy->authorization_domain);
+
+	return copy;
+}
+
+/**
+ * gdata_request_statistics_free:
+ * @self: (allow-none): a #GDataRequestStatistics returned by gdata_request_statistics_copy(), or %NULL
+ *
+ * Frees a #GDataRequestStatistics copied with gdata_request_statistics_copy().
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_request_statistics_free (GDataRequestStatistics *self)
+{
+	if (self == NULL)
+		return;
+
+	if (self->authorization_domain != NULL)
+		g_object_unref (self->authorization_domain);
+	g_free ((gchar *) self->host);
+
+	g_slice_free (GDataRequestStatistics, self);
+}
+
+static GDataOperationType
+operation_type_for_method (const gchar *method)
+{
+	if (method == SOUP_METHOD_POST)
+		return GDATA_OPERATION_INSERTION;
+	else if (method == SOUP_METHOD_PUT || g_strcmp0 (method, "PATCH") == 0)
+		return GDATA_OPERATION_UPDATE;
+	else if (method == SOUP_METHOD_DELETE)
+		return GDATA_OPERATION_DELETION;
+	else
+		return GDATA_OPERATION_QUERY;
+}
+
+static void
+add_header_size_cb (const gchar *name, const gchar *value, guint64 *size)
+{
+	/* Account for the ": " and "\r\n" too */
+	*size += strlen (name) + strlen (value) + 4;
+}
+
+static guint64
+get_headers_size (SoupMessageHeaders *headers)
+{
+	guint64 size = 0;
+
+	soup_message_headers_foreach (headers, (SoupMessageHeadersForeachFunc) add_header_size_cb, &size);
+
+	return size;
+}
+
+/* Add the time since the start of the current phase to *@time, which is -1 if the phase hasn't happened yet. */
+static void
+end_phase (RequestInstrumentation *instrumentation, gint64 *time)
+{
+	*time = MAX (*time, 0) + (g_get_monotonic_time () - instrumentation->phase_start_time);
+}
+
+static void
+message_network_event_cb (SoupMessage *message, GSocketClientEvent event, GIOStream *connection, RequestInstrumentation *instrumentation)
+{
+	switch (event) {
+		case G_SOCKET_CLIENT_RESOLVING:
+		case G_SOCKET_CLIENT_CONNECTING:
+		case G_SOCKET_CLIENT_TLS_HANDSHAKING:
+			instrumentation->phase_start_time = g_get_monotonic_time ();
+			break;
+		case G_SOCKET_CLIENT_RESOLVED:
+			end_phase (instrumentation, &instrumentation->statistics.dns_time);
+			break;
+		case G_SOCKET_CLIENT_CONNECTED:
+			end_phase (instrumentation, &instrumentation->statistics.connect_time);
+			break;
+		case G_SOCKET_CLIENT_TLS_HANDSHAKED:
+			end_phase (instrumentation, &instrumentation->statistics.tls_time);
+			break;
+		default:
+			break;
+	}
+}
+
+static void
+message_wrote_headers_cb (SoupMessage *message, RequestInstrumentation *instrumentation)
+{
+	instrumentation->statistics.bytes_sent += get_headers_size (message->request_headers);
+}
+
+static void
+message_wrote_body_cb (SoupMessage *message, RequestInstrumentation *instrumentation)
+{
+	instrumentation->statistics.bytes_sent += message->request_body->length;
+}
+
+static void
+message_got_headers_cb (SoupMessage *message, RequestInstrumentation *instrumentation)
+{
+	instrumentation->statistics.bytes_received += get_headers_size (message->response_headers);
+	instrumentation->statistics.time_to_first_byte = g_get_monotonic_time () - instrumentation->attempt_start_time;
+}
+
+static void
+message_got_chunk_cb (SoupMessage *message, SoupBuffer *chunk, RequestInstrumentation *instrumentation)
+{
+	instrumentation->statistics.bytes_received += chunk->length;
+}
+
+static void
+request_instrumentation_free (RequestInstrumentation *instrumentation)
+{
+	g_signal_emit (instrumentation->service, service_signals[SIGNAL_REQUEST_FINISHED], 0, &instrumentation->statistics);
+
+	if (instrumentation->statistics.authorization_domain != NULL)
+		g_object_unref (instrumentation->statistics.authorization_domain);
+	g_free ((gchar *) instrumentation->statistics.host);
+	g_object_unref (instrumentation->service);
+
+	g_slice_free (RequestInstrumentation, instrumentation);
+}
+
+/* Start gathering statistics for @message, if anybody is listening for them. Returns the instrumentation, which is owned by @message, or
+ * %NULL. */
+static RequestInstrumentation *
+instrument_message (GDataService *self, SoupMessage *message)
+{
+	RequestInstrumentation *instrumentation;
+	GDataAuthorizationDomain *domain;
+	gpointer operation_type;
+
+	/* Don't re-instrument a message which is being re-sent */
+	instrumentation = g_object_get_data (G_OBJECT (message), "gdata-request-instrumentation");
+	if (instrumentation != NULL)
+		return instrumentation;
+
+	if (g_signal_has_handler_pending (self, service_signals[SIGNAL_REQUEST_FINISHED], 0, FALSE) == FALSE)
+		return NULL;
+
+	instrumentation = g_slice_new0 (RequestInstrumentation);
+	instrumentation->service = g_object_ref (self);
+	instrumentation->start_time = g_get_monotonic_time ();
+
+	operation_type = g_object_get_data (G_OBJECT (message), "gdata-operation-type");
+	domain = g_object_get_data (G_OBJECT (message), "gdata-authorization-domain");
+
+	instrumentation->statistics.operation_type = (operation_type != NULL) ? GPOINTER_TO_UINT (operation_type) :
+	                                                                          operation_type_for_method (message->method);
+	instrumentation->statistics.authorization_domain = (domain != NULL) ? g_object_ref (domain) : NULL;
+	instrumentation->statistics.method = message->method; /* interned by libsoup */
+	instrumentation->statistics.host = g_strdup (soup_uri_get_host (soup_message_get_uri (message)));
+	instrumentation->statistics.dns_time = -1;
+	instrumentation->statistics.connect_time = -1;
+	instrumentation->statistics.tls_time = -1;
+	instrumentation->statistics.time_to_first_byte = -1;
+	instrumentation->statistics.parse_time = -1;
+
+	g_signal_connect (message, "network-event", (GCallback) message_network_event_cb, instrumentation);
+	g_signal_connect (message, "wrote-headers", (GCallback) message_wrote_headers_cb, instrumentation);
+	g_signal_connect (message, "wrote-body", (GCallback) message_wrote_body_cb, instrumentation);
+	g_signal_connect (message, "got-headers", (GCallback) message_got_headers_cb, instrumentation);
+	g_signal_connect (message, "got-chunk", (GCallback) message_got_chunk_cb, instrumentation);
+
+	g_object_set_data_full (G_OBJECT (message), "gdata-request-instrumentation", instrumentation,
+	                        (GDestroyNotify) request_instrumentation_free);
+
+	return instrumentation;
+}
+
+static void
+finish_instrumentation (RequestInstrumentation *instrumentation, guint status, guint retries)
+{
+	if (instrumentation == NULL)
+		return;
+
+	instrumentation->statistics.status = status;
+	instrumentation->statistics.retries = retries;
+	instrumentation->statistics.total_time = g_get_monotonic_time () - instrumentation->start_time;
+}
+
+/* Emit #GDataService::request-finished for @message straight away, rather than when it's finalised. This is for requests whose responses are
+ * handed over to another thread to be parsed, so that the signal is still emitted in the thread which made the request. */
+static void
+emit_request_finished (SoupMessage *message)
+{
+	RequestInstrumentation *instrumentation;
+
+	instrumentation = g_object_get_data (G_OBJECT (message), "gdata-request-instrumentation");
+	if (instrumentation == NULL)
+		return;
+
+	g_signal_handlers_disconnect_matched (message, G_SIGNAL_MATCH_DATA, 0, 0, NULL, NULL, instrumentation);
+
+	/* This frees the instrumentation, emitting the signal */
+	g_object_set_data (G_OBJECT (message), "gdata-request-instrumentation", NULL);
+}
+
+/* Record which operation @message is being made for, if it can't be worked out from its HTTP method. This is only used for instrumentation. */
+void
+_gdata_service_set_message_operation_type (SoupMessage *message, GDataOperationType operation_type)
+{
+	g_object_set_data (G_OBJECT (message), "gdata-operation-type", GUINT_TO_POINTER (operation_type));
+}
+
+/* Start parsing the response to @message, collecting parse statistics for it if it's instrumented. Returns the monotonic time parsing
+ * started at, which must be passed to _gdata_service_end_parse() afterwards. */
+gint64
+_gdata_service_begin_parse (SoupMessage *message)
+{
+	RequestInstrumentation *instrumentation;
+
+	instrumentation = g_object_get_data (G_OBJECT (message), "gdata-request-instrumentation");
+	if (instrumentation != NULL)
+		gdata_parse_statistics_start (&instrumentation->parse_statistics);
+
+	return g_get_monotonic_time ();
+}
+
+/* Record the time taken to parse the response to @message, and the parse statistics if it's instrumented. */
+void
+_gdata_service_end_parse (SoupMessage *message, gint64 parse_start_time)
+{
+	RequestInstrumentation *instrumentation;
+	GDataParseStatistics *statistics;
+
+	instrumentation = g_object_get_data (G_OBJECT (message), "gdata-request-instrumentation");
+	if (instrumentation == NULL)
+		return;
+
+	gdata_parse_statistics_stop (&instrumentation->parse_statistics);
+
+	/* Accumulate, in case the response is somehow parsed more than once */
+	statistics = &instrumentation->statistics.parse_statistics;
+	statistics->bytes_parsed += instrumentation->parse_statistics.bytes_parsed;
+	statistics->elements_visited += instrumentation->parse_statistics.elements_visited;
+	statistics->parsables_built += instrumentation->parse_statistics.parsables_built;
+	statistics->entries_built += instrumentation->parse_statistics.entries_built;
+	statistics->unhandled_elements += instrumentation->parse_statistics.unhandled_elements;
+	statistics->unhandled_bytes += instrumentation->parse_statistics.unhandled_bytes;
+	statistics->tokenize_time += instrumentation->parse_statistics.tokenize_time;
+	statistics->build_time += instrumentation->parse_statistics.build_time;
+	statistics->progress_callback_time += instrumentation->parse_statistics.progress_callback_time;
+
+	instrumentation->statistics.parse_time = MAX (instrumentation->statistics.parse_time, 0) + g_get_monotonic_time () - parse_start_time;
+}
+
+guint
+_gdata_service_send_message (GDataService *self, SoupMessage *message, GCancellable *cancellable, GError **error)
+{
+	GDataServiceClass *klass = GDATA_SERVICE_GET_CLASS (self);
+	RequestInstrumentation *instrumentation;
+	guint attempt;
+
+	instrumentation = instrument_message (self, message);
+	deposit_retry_budget (self, message);
+
+	for (attempt = 0;; attempt++) {
+		gint delay;
+		guint rate_limit_delay;
+
+		/* Pace requests to stay within the rate limit, rather than waiting for the server to tell us we've exceeded it */
+		rate_limit_delay = reserve_rate_limit_token (self, message);
+
+		if (instrumentation != NULL)
+			instrumentation->statistics.rate_limit_time += (gint64) rate_limit_delay * 1000;
+
+		if (rate_limit_delay > 0 && wait_cancellably (rate_limit_delay, cancellable) == FALSE) {
+			release_rate_limit_token (self, message);
+			g_cancellable_set_error_if_cancelled (cancellable, error);
+			soup_message_set_status (message, SOUP_STATUS_CANCELLED);
+			break;
+		}
+
+		if (instrumentation != NULL)
+			instrumentation->attempt_start_time = g_get_monotonic_time ();
+
+		if (send_message_once (self, message, cancellable, error) == SOUP_STATUS_NONE) {
+			finish_instrumentation (instrumentation, SOUP_STATUS_NONE, attempt);
+			return SOUP_STATUS_NONE;
+		}
+
+		update_rate_limit (self, message);
+
+		/* Retry transient failures, within limits */
+		if (attempt >= self->priv->max_retries || message->status_code == SOUP_STATUS_CANCELLED || klass->get_retry_delay == NULL)
+			break;
+
+		delay = klass->get_retry_delay (self, message, attempt);
+		if (delay < 0)
+			break;
+
+		if (withdraw_retry_budget (self, message) == FALSE) {
+			g_debug ("Not retrying request after status %u: retry budget for host ‘%s’ exhausted.", message->status_code,
+			         soup_uri_get_host (soup_message_get_uri (message)));
+			break;
+		}
+
+		g_debug ("Retrying request after status %u in %ims (attempt %u of %u).", message->status_code, delay, attempt + 1,
+		         self->priv->max_retries);
+
+		if (wait_cancellably (delay, cancellable) == FALSE) {
+			/* Report cancellation as _gdata_service_actually_send_message() would */
+			g_cancellable_set_error_if_cancelled (cancellable, error);
+			soup_message_set_status (message, SOUP_STATUS_CANCELLED);
+			break;
+		}
+
+		g_clear_error (error);
+	}
+
+	finish_instrumentation (instrumentation, message->status_code, attempt);
+
+	return message->status_code;
+}
+
+typedef struct {
+	/* Input */
+	GDataAuthorizationDomain *domain;
+	gchar *feed_uri;
+	GDataQuery *query;
+	GType entry_type;
+
+	/* Output */
+	GDataFeed *feed;
+	GDataQueryProgressCallback progress_callback;
+	gpointer progress_user_data;
+	GDestroyNotify destroy_progress_user_data;
+} QueryAsyncData;
+
+static void
+query_async_data_free (QueryAsyncData *self)
+{
+	if (self->domain != NULL)
+		g_object_unref (self->domain);
+
+	g_free (self->feed_uri);
+	if (self->query)
+		g_object_unref (self->query);
+	if (self->feed)
+		g_object_unref (self->feed);
+
+	g_slice_free (QueryAsyncData, self);
+}
+
+static void
+query_thread (GSimpleAsyncResult *result, GDataService *service, GCancellable *cancellable)
+{
+	GError *error = NULL;
+	QueryAsyncData *data = g_simple_async_result_get_op_res_gpointer (result);
+
+	/* Execute the query and return */
+	data->feed = __gdata_service_query (service, data->domain, data->feed_uri, data->query, data->entry_type, cancellable,
+	                                    data->progress_callback, data->progress_user_data, &error);
+	if (data->feed == NULL && error != NULL) {
+		g_simple_async_result_set_from_error (result, error);
+		g_error_free (error);
+	}
+
+	if (data->destroy_progress_user_data != NULL) {
+		data->destroy_progress_user_data (data->progress_user_data);
+	}
+}
+
+/**
+ * gdata_service_query_async:
+ * @self: a #GDataService
+ * @domain: (allow-none): the #GDataAuthorizationDomain the query falls under, or %NULL
+ * @feed_uri: the feed URI to query, including the host name and protocol
+ * @query: (allow-none): a #GDataQuery with the query parameters, or %NULL
+ * @entry_type: a #GType for the #GDataEntry<!-- -->s to build from the XML
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @progress_callback: (allow-none) (closure progress_user_data): a #GDataQueryProgressCallback to call when an entry is loaded, or %NULL
+ * @progress_user_data: (closure): data to pass to the @progress_callback function
+ * @destroy_progress_user_data: (allow-none): the function to call when @progress_callback will not be called any more, or %NULL. This function will be
+ * called with @progress_user_data as a parameter and can be used to free any memory allocated for it.
+ * @callback: a #GAsyncReadyCallback to call when the query is finished
+ * @user_data: (closure): data to pass to the @callback function
+ *
+ * Queries the service's @feed_uri feed to build a #GDataFeed. @self, @feed_uri and
+ * @query are all reffed/copied when this function is called, so can safely be freed after this function returns.
+ *
+ * For more details, see gdata_service_query(), which is the synchronous version of this function.
+ *
+ * When the operation is finished, @callback will be called. You can then call gdata_service_query_finish()
+ * to get the results of the operation.
+ *
+ * Since: 0.9.1
+ */
+void
+gdata_service_query_async (GDataService *self, GDataAuthorizationDomain *domain, const gchar *feed_uri, GDataQuery *query, GType entry_type,
+                           GCancellable *cancellable, GDataQueryProgressCallback progress_callback, gpointer progress_user_data,
+                           GDestroyNotify destroy_progress_user_data, GAsyncReadyCallback callback, gpointer user_data)
+{
+	GSimpleAsyncResult *result;
+	QueryAsyncData *data;
+
+	g_return_if_fail (GDATA_IS_SERVICE (self));
+	g_return_if_fail (domain == NULL || GDATA_IS_AUTHORIZATION_DOMAIN (domain));
+	g_return_if_fail (feed_uri != NULL);
+	g_return_if_fail (g_type_is_a (entry_type, GDATA_TYPE_ENTRY));
+	g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+	g_return_if_fail (callback != NULL);
+
+	data = g_slice_new (QueryAsyncData);
+	data->domain = (domain != NULL) ? g_object_ref (domain) : NULL;
+	data->feed_uri = g_strdup (feed_uri);
+	data->query = (query != NULL) ? g_object_ref (query) : NULL;
+	data->entry_type = entry_type;
+	data->feed = NULL;
+	data->progress_callback = progress_callback;
+	data->progress_user_data = progress_user_data;
+	data->destroy_progress_user_data = destroy_progress_user_data;
+
+	result = g_simple_async_result_new (G_OBJECT (self), callback, user_data, gdata_service_query_async);
+	g_simple_async_result_set_op_res_gpointer (result, data, (GDestroyNotify) query_async_data_free);
+	g_simple_async_result_run_in_thread (result, (GSimpleAsyncThreadFunc) query_thread, G_PRIORITY_DEFAULT, cancellable);
+	g_object_unref (result);
+}
+
+/**
+ * gdata_service_query_finish:
+ * @self: a #GDataService
+ * @async_result: a #GAsyncResult
+ * @error: a #GError, or %NULL
+ *
+ * Finishes an asynchronous query operation started with gdata_service_query_async().
+ *
+ * Return value: (transfer full): a #GDataFeed of query results, or %NULL; unref with g_object_unref()
+ */
+GDataFeed *
+gdata_service_query_finish (GDataService *self, GAsyncResult *async_result, GError **error)
+{
+	GSimpleAsyncResult *result = G_SIMPLE_ASYNC_RESULT (async_result);
+	QueryAsyncData *data;
+
+	g_return_val_if_fail (GDATA_IS_SERVICE (self), NULL);
+	g_return_val_if_fail (G_IS_ASYNC_RESULT (async_result), NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	g_warn_if_fail (g_simple_async_result_get_source_tag (result) == gdata_service_query_async);
+
+	if (g_simple_async_result_propagate_error (result, error) == TRUE)
+		return NULL;
+
+	data = g_simple_async_result_get_op_res_gpointer (result);
+	if (data->feed != NULL)
+		return g_object_ref (data->feed);
+	return NULL;
+}
+
+/* A page of query results being read ahead in the background, so that it's ready by the time the query moves on to it. Only the request is
+ * made in the background; the response is parsed by the query which uses it. See prefetch_pages(). */
+struct _GDataPrefetch {
+	volatile gint ref_count;
+
+	GDataService *service; /* owned */
+	GDataAuthorizationDomain *domain; /* owned; may be NULL */
+	gchar *uri; /* owned */
+	GCancellable *cancellable; /* owned */
+
+	GMutex mutex; /* protects message and finished */
+	GCond cond; /* signalled when finished is set */
+	SoupMessage *message; /* owned; NULL until finished, and if cancelled before being sent */
+	gboolean finished;
+};
+
+/* Limits on how far ahead pages are read, and how many are read at once */
+#define PREFETCH_MAX_DEPTH 16
+#define PREFETCH_MAX_THREADS 4
+
+static GDataPrefetch *
+prefetch_ref (GDataPrefetch *self)
+{
+	g_atomic_int_inc (&self->ref_count);
+	return self;
+}
+
+static void
+prefetch_unref (GDataPrefetch *self)
+{
+	if (g_atomic_int_dec_and_test (&self->ref_count) == FALSE)
+		return;
+
+	g_object_unref (self->service);
+	if (self->domain != NULL)
+		g_object_unref (self->domain);
+	g_free (self->uri);
+	g_object_unref (self->cancellable);
+	if (self->message != NULL)
+		g_object_unref (self->message);
+
+	g_mutex_clear (&self->mutex);
+	g_cond_clear (&self->cond);
+
+	g_slice_free (GDataPrefetch, self);
+}
+
+gboolean
+_gdata_prefetch_matches (GDataPrefetch *self, GDataService *service, GDataAuthorizationDomain *domain, const gchar *uri)
+{
+	return (self->service == service && self->domain == domain && strcmp (self->uri, uri) == 0) ? TRUE : FALSE;
+}
+
+void
+_gdata_prefetch_cancel_and_unref (GDataPrefetch *self)
+{
+	/* This is used as a GPtrArray free function, so may be passed NULL for elements which have been stolen */
+	if (self == NULL)
+		return;
+
+	g_cancellable_cancel (self->cancellable);
+	prefetch_unref (self);
+}
+
+static void
+prefetch_thread_cb (GDataPrefetch *prefetch, gpointer user_data)
+{
+	SoupMessage *message = NULL;
+
+	/* Don't bother making the request if the query has already moved on */
+	if (g_cancellable_is_cancelled (prefetch->cancellable) == FALSE) {
+		GError *child_error = NULL;
+
+		message = _gdata_service_build_message (prefetch->service, prefetch->domain, SOUP_METHOD_GET, prefetch->uri, NULL, FALSE);
+		_gdata_service_send_message (prefetch->service, message, prefetch->cancellable, &child_error);
+
+		/* Any error will be reported when the page is requested again by the query */
+		g_clear_error (&child_error);
+
+		/* The response may be parsed in another thread, or never, so report the request as finished now */
+		emit_request_finished (message);
+	}
+
+	g_mutex_lock (&prefetch->mutex);
+	prefetch->message = message;
+	prefetch->finished = TRUE;
+	g_cond_broadcast (&prefetch->cond);
+	g_mutex_unlock (&prefetch->mutex);
+
+	prefetch_unref (prefetch);
+}
+
+static GThreadPool *
+get_prefetch_pool (void)
+{
+	static gsize pool = 0;
+
+	if (g_once_init_enter (&pool)) {
+		GThreadPool *_pool = g_thread_pool_new ((GFunc) prefetch_thread_cb, NULL, PREFETCH_MAX_THREADS, FALSE, NULL);
+		g_once_init_leave (&pool, (gsize) _pool);
+	}
+
+	return (GThreadPool*) pool;
+}
+
+static void
+prefetch_cancelled_cb (GCancellable *cancellable, GDataPrefetch *prefetch)
+{
+	g_cancellable_cancel (prefetch->cancellable);
+}
+
+/* Waits for @prefetch to finish, and returns its response (transfer full) if the request was successful. Otherwise %NULL is returned and the
+ * request should be made again as normal, unless @cancellable was cancelled while waiting, in which case @error is set. */
+static SoupMessage *
+prefetch_wait (GDataPrefetch *prefetch, GCancellable *cancellable, GError **error)
+{
+	SoupMessage *message = NULL;
+	gulong cancelled_id = 0;
+
+	/* Abandon the request if the caller cancels while we're waiting for it */
+	if (cancellable != NULL)
+		cancelled_id = g_cancellable_connect (cancellable, G_CALLBACK (prefetch_cancelled_cb), prefetch, NULL);
+
+	g_mutex_lock (&prefetch->mutex);
+
+	while (prefetch->finished == FALSE)
+		g_cond_wait (&prefetch->cond, &prefetch->mutex);
+
+	if (prefetch->message != NULL && prefetch->message->status_code == SOUP_STATUS_OK)
+		message = g_object_ref (prefetch->message);
+
+	g_mutex_unlock (&prefetch->mutex);
+
+	if (cancellable != NULL)
+		g_cancellable_disconnect (cancellable, cancelled_id);
+
+	if (g_cancellable_set_error_if_cancelled (cancellable, error) == TRUE)
+		g_clear_object (&message);
+
+	return message;
+}
+
+/* Starts reading ahead the pages which follow @feed, the page just queried using @query, up to its #GDataQuery:prefetch-depth, and drops any
+ * pages previously read ahead which the query has since moved away from. */
+static void
+prefetch_pages (GDataService *self, GDataAuthorizationDomain *domain, const gchar *feed_uri, GDataQuery *query, GDataFeed *feed)
+{
+	gchar **uris;
+	guint depth, n_uris, i;
+
+	depth = MIN (gdata_query_get_prefetch_depth (query), PREFETCH_MAX_DEPTH);
+
+	/* Work out which pages to read ahead, stopping at the first one which can't be known yet */
+	uris = g_new0 (gchar*, depth + 1);
+
+	for (n_uris = 0; n_uris < depth; n_uris++) {
+		uris[n_uris] = _gdata_query_build_next_page_uri (query, feed_uri, feed, n_uris + 1);
+		if (uris[n_uris] == NULL)
+			break;
+	}
+
+	_gdata_query_retain_prefetches (query, self, domain, uris, n_uris);
+
+	for (i = 0; i < n_uris; i++) {
+		GDataPrefetch *prefetch;
+
+		if (_gdata_query_has_prefetch (query, self, domain, uris[i]) == TRUE)
+			continue;
+
+		prefetch = g_slice_new0 (GDataPrefetch);
+		prefetch->ref_count = 1;
+		prefetch->service = g_object_ref (self);
+		prefetch->domain = (domain != NULL) ? g_object_ref (domain) : NULL;
+		prefetch->uri = g_strdup (uris[i]);
+		prefetch->cancellable = g_cancellable_new ();
+		g_mutex_init (&prefetch->mutex);
+		g_cond_init (&prefetch->cond);
+
+		g_debug ("Reading ahead query page ‘%s’.", prefetch->uri);
+
+		/* The query owns one reference, and the thread pool another */
+		_gdata_query_add_prefetch (query, prefetch);
+		g_thread_pool_push (get_prefetch_pool (), prefetch_ref (prefetch), NULL);
+	}
+
+	g_strfreev (uris);
+}
+
+/* Does the bulk of the work of gdata_service_query. Split out because certain queries (such as that done by
+ * gdata_service_query_single_entry()) only return a single entry, and thus need special parsing code. */
+SoupMessage *
+_gdata_service_query (GDataService *self, GDataAuthorizationDomain *domain, const gchar *feed_uri, GDataQuery *query,
+                      GCancellable *cancellable, GError **error)
+{
+	SoupMessage *message;
+	guint status;
+	const gchar *etag = NULL;
+
+	/* Append the ETag header if possible */
+	if (query != NULL)
+		etag = gdata_query_get_etag (query);
+
+	/* Use the page if it's already been read ahead. It was requested without an ETag, so can only be used if there isn't one now. */
+	if (query != NULL && etag == NULL) {
+		const gchar *query_uri = _gdata_query_build_uri (query, feed_uri);
+		GDataPrefetch *prefetch = NULL;
+
+		if (query_uri != NULL)
+			prefetch = _gdata_query_steal_prefetch (query, self, domain, query_uri);
+
+		if (prefetch != NULL) {
+			GError *child_error = NULL;
+
+			message = prefetch_wait (prefetch, cancellable, &child_error);
+			prefetch_unref (prefetch);
+
+			if (child_error != NULL) {
+				g_propagate_error (error, child_error);
+				return NULL;
+			} else if (message != NULL) {
+				return message;
+			}
+
+			/* Otherwise, the read-ahead failed, so try again below */
+		}
+	}
+
+	/* Build the message */
+	if (query != NULL) {
+		/* The query caches its parsed URI, so repeated queries don't need to rebuild or reparse it */
+		SoupURI *query_uri = _gdata_query_get_soup_uri (query, feed_uri);
+		message = _gdata_service_build_message_from_soup_uri (self, domain, SOUP_METHOD_GET, query_uri, etag, FALSE);
+	} else {
+		message = _gdata_service_build_message (self, domain, SOUP_METHOD_GET, feed_uri, etag, FALSE);
+	}
+
+	/* Note that cancellation only applies to network activity; not to the processing done afterwards */
+	status = _gdata_service_send_message (self, message, cancellable, error);
 
 	if (status == SOUP_STATUS_NOT_MODIFIED || status == SOUP_STATUS_CANCELLED) {
 		/* Not modified (ETag has worked), or cancelled (in which case the error has been set) */
@@ -964,6 +2041,7 @@ __gdata_service_query (GDataService *self, GDataAuthorizationDomain *domain, con
 	GDataServiceClass *klass;
 	SoupMessage *message;
 	GDataFeed *feed;
+	gint64 parse_start_time;
 
 	klass = GDATA_SERVICE_GET_CLASS (self);
 
@@ -986,12 +2064,18 @@ __gdata_service_query (GDataService *self, GDataAuthorizationDomain *domain, con
 	g_assert (klass->parse_feed != NULL);
 
 	/* Parse the response. */
+	parse_start_time = _gdata_service_begin_parse (message);
 	feed = klass->parse_feed (self, domain, query, entry_type,
 	                          message, cancellable, progress_callback,
 	                          progress_user_data, error);
+	_gdata_service_end_parse (message, parse_start_time);
 
 	g_object_unref (message);
 
+	/* Now that the query knows where the next page is, start fetching it while the caller deals with this one */
+	if (query != NULL && feed != NULL && gdata_query_get_prefetch_depth (query) > 0)
+		prefetch_pages (self, domain, feed_uri, query, feed);
+
 	return feed;
 }
 
@@ -1019,13 +2103,13 @@ real_parse_feed (GDataService *self,
 		/* Definitely JSON. */
 		g_debug("JSON content type detected.");
 		feed = _gdata_feed_new_from_json (klass->feed_type, message->response_body->data, message->response_body->length, entry_type,
-		                                  progress_callback, progress_user_data, error);
+		                                  query, progress_callback, progress_user_data, error);
 	} else {
 		/* Potentially XML. Don't bother checking the Content-Type, since the parser
 		 * will fail gracefully if the response body is not valid XML. */
 		g_debug("XML content type detected.");
 		feed = _gdata_feed_new_from_xml (klass->feed_type, message->response_body->data, message->response_body->length, entry_type,
-		                                 progress_callback, progress_user_data, error);
+		                                 query, progress_callback, progress_user_data, error);
 	}
 
 	/* Update the query with the feed's ETag */
@@ -1140,6 +2224,7 @@ gdata_service_query_single_entry (GDataService *self, GDataAuthorizationDomain *
 	SoupMessage *message;
 	SoupMessageHeaders *headers;
 	const gchar *content_type;
+	gint64 parse_start_time;
 
 	g_return_val_if_fail (GDATA_IS_SERVICE (self), NULL);
 	g_return_val_if_fail (domain == NULL || GDATA_IS_AUTHORIZATION_DOMAIN (domain), NULL);
@@ -1167,12 +2252,15 @@ gdata_service_query_single_entry (GDataService *self, GDataAuthorizationDomain *
 	headers = message->response_headers;
 	content_type = soup_message_headers_get_content_type (headers, NULL);
 
+	parse_start_time = _gdata_service_begin_parse (message);
+
 	if (g_strcmp0 (content_type, "application/json") == 0) {
 		entry = GDATA_ENTRY (gdata_parsable_new_from_json (entry_type, message->response_body->data, message->response_body->length, error));
 	} else {
 		entry = GDATA_ENTRY (gdata_parsable_new_from_xml (entry_type, message->response_body->data, message->response_body->length, error));
 	}
 
+	_gdata_service_end_parse (message, parse_start_time);
 	g_object_unref (message);
 	g_type_class_unref (klass);
 
@@ -1453,29 +2541,236 @@ gdata_service_insert_entry (GDataService *self, GDataAuthorizationDomain *domain
 	gchar *upload_data;
 	guint status;
 	GDataParsableClass *klass;
+	gint64 parse_start_time;
+
+	g_return_val_if_fail (GDATA_IS_SERVICE (self), NULL);
+	g_return_val_if_fail (domain == NULL || GDATA_IS_AUTHORIZATION_DOMAIN (domain), NULL);
+	g_return_val_if_fail (upload_uri != NULL, NULL);
+	g_return_val_if_fail (GDATA_IS_ENTRY (entry), NULL);
+	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	if (gdata_entry_is_inserted (entry) == TRUE) {
+		g_set_error_literal (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_ENTRY_ALREADY_INSERTED,
+		                     _("The entry has already been inserted."));
+		return NULL;
+	}
+
+	message = _gdata_service_build_message (self, domain, SOUP_METHOD_POST, upload_uri, NULL, FALSE);
+
+	/* Append the data */
+	klass = GDATA_PARSABLE_GET_CLASS (entry);
+	g_assert (klass->get_content_type != NULL);
+	if (g_strcmp0 (klass->get_content_type (), "application/json") == 0) {
+		upload_data = gdata_parsable_get_json (GDATA_PARSABLE (entry));
+		soup_message_set_request (message, "application/json", SOUP_MEMORY_TAKE, upload_data, strlen (upload_data));
+	} else {
+		upload_data = gdata_parsable_get_xml (GDATA_PARSABLE (entry));
+		soup_message_set_request (message, "application/atom+xml", SOUP_MEMORY_TAKE, upload_data, strlen (upload_data));
+	}
+
+	/* Send the message */
+	status = _gdata_service_send_message (self, message, cancellable, error);
+
+	if (status == SOUP_STATUS_NONE || status == SOUP_STATUS_CANCELLED) {
+		/* Redirect error or cancelled */
+		g_object_unref (message);
+		return NULL;
+	} else if (status != SOUP_STATUS_CREATED && status != SOUP_STATUS_OK) {
+		/* Error: for XML APIs Google returns CREATED and for JSON it returns OK. */
+		GDataServiceClass *service_klass = GDATA_SERVICE_GET_CLASS (self);
+		g_assert (service_klass->parse_error_response != NULL);
+		service_klass->parse_error_response (self, GDATA_OPERATION_INSERTION, status, message->reason_phrase, message->response_body->data,
+		                                     message->response_body->length, error);
+		g_object_unref (message);
+		return NULL;
+	}
+
+	/* Parse the XML or JSON according to GDataEntry type; create and return a new GDataEntry of the same type as @entry */
+	g_assert (message->response_body->data != NULL);
+	parse_start_time = _gdata_service_begin_parse (message);
+	if (g_strcmp0 (klass->get_content_type (), "application/json") == 0) {
+		updated_entry = GDATA_ENTRY (gdata_parsable_new_from_json (G_OBJECT_TYPE (entry), message->response_body->data,
+		                             message->response_body->length, error));
+	} else {
+		updated_entry = GDATA_ENTRY (gdata_parsable_new_from_xml (G_OBJECT_TYPE (entry), message->response_body->data,
+		                             message->response_body->length, error));
+	}
+	_gdata_service_end_parse (message, parse_start_time);
+	g_object_unref (message);
+
+	return updated_entry;
+}
+
+typedef struct {
+	GDataAuthorizationDomain *domain;
+	GDataEntry *entry;
+} UpdateEntryAsyncData;
+
+static void
+update_entry_async_data_free (UpdateEntryAsyncData *data)
+{
+	if (data->domain != NULL)
+		g_object_unref (data->domain);
+
+	if (data->entry != NULL)
+		g_object_unref (data->entry);
+
+	g_slice_free (UpdateEntryAsyncData, data);
+}
+
+static void
+update_entry_thread (GSimpleAsyncResult *result, GDataService *service, GCancellable *cancellable)
+{
+	GDataEntry *updated_entry;
+	GError *error = NULL;
+	UpdateEntryAsyncData *data = g_simple_async_result_get_op_res_gpointer (result);
+
+	/* Update the entry and return */
+	updated_entry = gdata_service_update_entry (service, data->domain, data->entry, cancellable, &error);
+	if (updated_entry == NULL) {
+		g_simple_async_result_set_from_error (result, error);
+		g_error_free (error);
+		return;
+	}
+
+	/* Swap the old entry with the new one */
+	g_simple_async_result_set_op_res_gpointer (result, updated_entry, (GDestroyNotify) g_object_unref);
+}
+
+/**
+ * gdata_service_update_entry_async:
+ * @self: a #GDataService
+ * @domain: (allow-none): the #GDataAuthorizationDomain the update operation falls under, or %NULL
+ * @entry: the #GDataEntry to update
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @callback: a #GAsyncReadyCallback to call when the update is finished, or %NULL
+ * @user_data: (closure): data to pass to the @callback function
+ *
+ * Updates @entry by PUTting it to its <literal>edit</literal> link's URI. @self and
+ * @entry are both reffed when this function is called, so can safely be unreffed after this function returns.
+ *
+ * For more details, see gdata_service_update_entry(), which is the synchronous version of this function.
+ *
+ * When the operation is finished, @callback will be called. You can then call gdata_service_update_entry_finish()
+ * to get the results of the operation.
+ *
+ * Since: 0.9.0
+ */
+void
+gdata_service_update_entry_async (GDataService *self, GDataAuthorizationDomain *domain, GDataEntry *entry,
+                                  GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data)
+{
+	GSimpleAsyncResult *result;
+	UpdateEntryAsyncData *data;
+
+	g_return_if_fail (GDATA_IS_SERVICE (self));
+	g_return_if_fail (domain == NULL || GDATA_IS_AUTHORIZATION_DOMAIN (domain));
+	g_return_if_fail (GDATA_IS_ENTRY (entry));
+	g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+
+	data = g_slice_new (UpdateEntryAsyncData);
+	data->domain = (domain != NULL) ? g_object_ref (domain) : NULL;
+	data->entry = g_object_ref (entry);
+
+	result = g_simple_async_result_new (G_OBJECT (self), callback, user_data, gdata_service_update_entry_async);
+	g_simple_async_result_set_op_res_gpointer (result, data, (GDestroyNotify) update_entry_async_data_free);
+	g_simple_async_result_run_in_thread (result, (GSimpleAsyncThreadFunc) update_entry_thread, G_PRIORITY_DEFAULT, cancellable);
+	g_object_unref (result);
+}
+
+/**
+ * gdata_service_update_entry_finish:
+ * @self: a #GDataService
+ * @async_result: a #GAsyncResult
+ * @error: a #GError, or %NULL
+ *
+ * Finishes an asynchronous entry update operation started with gdata_service_update_entry_async().
+ *
+ * Return value: (transfer full): an updated #GDataEntry, or %NULL; unref with g_object_unref()
+ *
+ * Since: 0.3.0
+ */
+GDataEntry *
+gdata_service_update_entry_finish (GDataService *self, GAsyncResult *async_result, GError **error)
+{
+	GSimpleAsyncResult *result = G_SIMPLE_ASYNC_RESULT (async_result);
+	GDataEntry *entry;
+
+	g_return_val_if_fail (GDATA_IS_SERVICE (self), NULL);
+	g_return_val_if_fail (G_IS_ASYNC_RESULT (async_result), NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	g_warn_if_fail (g_simple_async_result_get_source_tag (result) == gdata_service_update_entry_async);
+
+	if (g_simple_async_result_propagate_error (result, error) == TRUE)
+		return NULL;
+
+	entry = g_simple_async_result_get_op_res_gpointer (result);
+	g_assert (entry != NULL);
+
+	return g_object_ref (entry);
+}
+
+/**
+ * gdata_service_update_entry:
+ * @self: a #GDataService
+ * @domain: (allow-none): the #GDataAuthorizationDomain the update operation falls under, or %NULL
+ * @entry: the #GDataEntry to update
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @error: a #GError, or %NULL
+ *
+ * Updates @entry by PUTting it to its <literal>edit</literal> link's URI. For more information about the concept of updating entries, see
+ * the <ulink type="http" url="http://code.google.com/apis/gdata/docs/2.0/basics.html#UpdatingEntry">online documentation</ulink> for the GData
+ * protocol.
+ *
+ * The service will return an updated version of the entry, which is the return value of this function on success.
+ *
+ * If @cancellable is not %NULL, then the operation can be cancelled by triggering the @cancellable object from another thread.
+ * If the operation was cancelled before or during network activity, the error %G_IO_ERROR_CANCELLED will be returned. Cancellation has no effect
+ * after network activity has finished, however, and the update will return successfully (or return an error sent by the server) if it is first
+ * cancelled after network activity has finished. See the <link linkend="cancellable-support">overview of cancellation</link> for
+ * more details.
+ *
+ * If there is an error updating the entry, a %GDATA_SERVICE_ERROR_PROTOCOL_ERROR error will be returned. Currently, subclasses
+ * <emphasis>cannot</emphasis> cannot override this or provide more specific errors.
+ *
+ * Return value: (transfer full): an updated #GDataEntry, or %NULL; unref with g_object_unref()
+ *
+ * Since: 0.9.0
+ */
+GDataEntry *
+gdata_service_update_entry (GDataService *self, GDataAuthorizationDomain *domain, GDataEntry *entry, GCancellable *cancellable, GError **error)
+{
+	GDataEntry *updated_entry;
+	GDataLink *_link;
+	SoupMessage *message;
+	gchar *upload_data;
+	guint status;
+	GDataParsableClass *klass;
+	gint64 parse_start_time;
 
 	g_return_val_if_fail (GDATA_IS_SERVICE (self), NULL);
 	g_return_val_if_fail (domain == NULL || GDATA_IS_AUTHORIZATION_DOMAIN (domain), NULL);
-	g_return_val_if_fail (upload_uri != NULL, NULL);
 	g_return_val_if_fail (GDATA_IS_ENTRY (entry), NULL);
 	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), FALSE);
 	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
 
-	if (gdata_entry_is_inserted (entry) == TRUE) {
-		g_set_error_literal (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_ENTRY_ALREADY_INSERTED,
-		                     _("The entry has already been inserted."));
-		return NULL;
-	}
-
-	message = _gdata_service_build_message (self, domain, SOUP_METHOD_POST, upload_uri, NULL, FALSE);
-
 	/* Append the data */
 	klass = GDATA_PARSABLE_GET_CLASS (entry);
 	g_assert (klass->get_content_type != NULL);
 	if (g_strcmp0 (klass->get_content_type (), "application/json") == 0) {
+		/* Get the edit URI */
+		_link = gdata_entry_look_up_link (entry, GDATA_LINK_SELF);
+		g_assert (_link != NULL);
+		message = _gdata_service_build_message (self, domain, SOUP_METHOD_PUT, gdata_link_get_uri (_link), gdata_entry_get_etag (entry), TRUE);
 		upload_data = gdata_parsable_get_json (GDATA_PARSABLE (entry));
 		soup_message_set_request (message, "application/json", SOUP_MEMORY_TAKE, upload_data, strlen (upload_data));
 	} else {
+		/* Get the edit URI */
+		_link = gdata_entry_look_up_link (entry, GDATA_LINK_EDIT);
+		g_assert (_link != NULL);
+		message = _gdata_service_build_message (self, domain, SOUP_METHOD_PUT, gdata_link_get_uri (_link), gdata_entry_get_etag (entry), TRUE);
 		upload_data = gdata_parsable_get_xml (GDATA_PARSABLE (entry));
 		soup_message_set_request (message, "application/atom+xml", SOUP_MEMORY_TAKE, upload_data, strlen (upload_data));
 	}
@@ -1487,56 +2782,40 @@ gdata_service_insert_entry (GDataService *self, GDataAuthorizationDomain *domain
 		/* Redirect error or cancelled */
 		g_object_unref (message);
 		return NULL;
-	} else if (status != SOUP_STATUS_CREATED && status != SOUP_STATUS_OK) {
-		/* Error: for XML APIs Google returns CREATED and for JSON it returns OK. */
+	} else if (status != SOUP_STATUS_OK) {
+		/* Error */
 		GDataServiceClass *service_klass = GDATA_SERVICE_GET_CLASS (self);
 		g_assert (service_klass->parse_error_response != NULL);
-		service_klass->parse_error_response (self, GDATA_OPERATION_INSERTION, status, message->reason_phrase, message->response_body->data,
+		service_klass->parse_error_response (self, GDATA_OPERATION_UPDATE, status, message->reason_phrase, message->response_body->data,
 		                                     message->response_body->length, error);
 		g_object_unref (message);
 		return NULL;
 	}
 
-	/* Parse the XML or JSON according to GDataEntry type; create and return a new GDataEntry of the same type as @entry */
-	g_assert (message->response_body->data != NULL);
+	/* Parse the XML; create and return a new GDataEntry of the same type as @entry */
+	parse_start_time = _gdata_service_begin_parse (message);
 	if (g_strcmp0 (klass->get_content_type (), "application/json") == 0) {
 		updated_entry = GDATA_ENTRY (gdata_parsable_new_from_json (G_OBJECT_TYPE (entry), message->response_body->data,
-		                             message->response_body->length, error));
+		                         message->response_body->length, error));
 	} else {
 		updated_entry = GDATA_ENTRY (gdata_parsable_new_from_xml (G_OBJECT_TYPE (entry), message->response_body->data,
 		                             message->response_body->length, error));
 	}
+	_gdata_service_end_parse (message, parse_start_time);
 	g_object_unref (message);
 
 	return updated_entry;
 }
 
-typedef struct {
-	GDataAuthorizationDomain *domain;
-	GDataEntry *entry;
-} UpdateEntryAsyncData;
-
-static void
-update_entry_async_data_free (UpdateEntryAsyncData *data)
-{
-	if (data->domain != NULL)
-		g_object_unref (data->domain);
-
-	if (data->entry != NULL)
-		g_object_unref (data->entry);
-
-	g_slice_free (UpdateEntryAsyncData, data);
-}
-
 static void
-update_entry_thread (GSimpleAsyncResult *result, GDataService *service, GCancellable *cancellable)
+patch_entry_thread (GSimpleAsyncResult *result, GDataService *service, GCancellable *cancellable)
 {
 	GDataEntry *updated_entry;
 	GError *error = NULL;
 	UpdateEntryAsyncData *data = g_simple_async_result_get_op_res_gpointer (result);
 
-	/* Update the entry and return */
-	updated_entry = gdata_service_update_entry (service, data->domain, data->entry, cancellable, &error);
+	/* Patch the entry and return */
+	updated_entry = gdata_service_patch_entry (service, data->domain, data->entry, cancellable, &error);
 	if (updated_entry == NULL) {
 		g_simple_async_result_set_from_error (result, error);
 		g_error_free (error);
@@ -1548,7 +2827,7 @@ update_entry_thread (GSimpleAsyncResult *result, GDataService *service, GCancell
 }
 
 /**
- * gdata_service_update_entry_async:
+ * gdata_service_patch_entry_async:
  * @self: a #GDataService
  * @domain: (allow-none): the #GDataAuthorizationDomain the update operation falls under, or %NULL
  * @entry: the #GDataEntry to update
@@ -1556,19 +2835,19 @@ update_entry_thread (GSimpleAsyncResult *result, GDataService *service, GCancell
  * @callback: a #GAsyncReadyCallback to call when the update is finished, or %NULL
  * @user_data: (closure): data to pass to the @callback function
  *
- * Updates @entry by PUTting it to its <literal>edit</literal> link's URI. @self and
- * @entry are both reffed when this function is called, so can safely be unreffed after this function returns.
+ * Updates @entry by PATCHing its changed elements to the server. @self, @domain and @entry are all reffed when this function is called, so can
+ * safely be unreffed after this function returns. @entry must not be modified until the operation has finished.
  *
- * For more details, see gdata_service_update_entry(), which is the synchronous version of this function.
+ * For more details, see gdata_service_patch_entry(), which is the synchronous version of this function.
  *
- * When the operation is finished, @callback will be called. You can then call gdata_service_update_entry_finish()
+ * When the operation is finished, @callback will be called. You can then call gdata_service_patch_entry_finish()
  * to get the results of the operation.
  *
- * Since: 0.9.0
+ * Since: 0.17.9
  */
 void
-gdata_service_update_entry_async (GDataService *self, GDataAuthorizationDomain *domain, GDataEntry *entry,
-                                  GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data)
+gdata_service_patch_entry_async (GDataService *self, GDataAuthorizationDomain *domain, GDataEntry *entry,
+                                 GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data)
 {
 	GSimpleAsyncResult *result;
 	UpdateEntryAsyncData *data;
@@ -1582,35 +2861,35 @@ gdata_service_update_entry_async (GDataService *self, GDataAuthorizationDomain *
 	data->domain = (domain != NULL) ? g_object_ref (domain) : NULL;
 	data->entry = g_object_ref (entry);
 
-	result = g_simple_async_result_new (G_OBJECT (self), callback, user_data, gdata_service_update_entry_async);
+	result = g_simple_async_result_new (G_OBJECT (self), callback, user_data, gdata_service_patch_entry_async);
 	g_simple_async_result_set_op_res_gpointer (result, data, (GDestroyNotify) update_entry_async_data_free);
-	g_simple_async_result_run_in_thread (result, (GSimpleAsyncThreadFunc) update_entry_thread, G_PRIORITY_DEFAULT, cancellable);
+	g_simple_async_result_run_in_thread (result, (GSimpleAsyncThreadFunc) patch_entry_thread, G_PRIORITY_DEFAULT, cancellable);
 	g_object_unref (result);
 }
 
 /**
- * gdata_service_update_entry_finish:
+ * gdata_service_patch_entry_finish:
  * @self: a #GDataService
  * @async_result: a #GAsyncResult
  * @error: a #GError, or %NULL
  *
- * Finishes an asynchronous entry update operation started with gdata_service_update_entry_async().
+ * Finishes an asynchronous entry patch operation started with gdata_service_patch_entry_async().
  *
  * Return value: (transfer full): an updated #GDataEntry, or %NULL; unref with g_object_unref()
  *
- * Since: 0.3.0
+ * Since: 0.17.9
  */
 GDataEntry *
-gdata_service_update_entry_finish (GDataService *self, GAsyncResult *async_result, GError **error)
+gdata_service_patch_entry_finish (GDataService *self, GAsyncResult *async_result, GError **error)
 {
 	GSimpleAsyncResult *result = G_SIMPLE_ASYNC_RESULT (async_result);
 	GDataEntry *entry;
 
 	g_return_val_if_fail (GDATA_IS_SERVICE (self), NULL);
 	g_return_val_if_fail (G_IS_ASYNC_RESULT (async_result), NULL);
-	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
 
-	g_warn_if_fail (g_simple_async_result_get_source_tag (result) == gdata_service_update_entry_async);
+	g_warn_if_fail (g_simple_async_result_get_source_tag (result) == gdata_service_patch_entry_async);
 
 	if (g_simple_async_result_propagate_error (result, error) == TRUE)
 		return NULL;
@@ -1622,34 +2901,39 @@ gdata_service_update_entry_finish (GDataService *self, GAsyncResult *async_resul
 }
 
 /**
- * gdata_service_update_entry:
+ * gdata_service_patch_entry:
  * @self: a #GDataService
  * @domain: (allow-none): the #GDataAuthorizationDomain the update operation falls under, or %NULL
  * @entry: the #GDataEntry to update
  * @cancellable: (allow-none): optional #GCancellable object, or %NULL
  * @error: a #GError, or %NULL
  *
- * Updates @entry by PUTting it to its <literal>edit</literal> link's URI. For more information about the concept of updating entries, see
- * the <ulink type="http" url="http://code.google.com/apis/gdata/docs/2.0/basics.html#UpdatingEntry">online documentation</ulink> for the GData
- * protocol.
+ * Updates @entry on the server by sending only the elements (or JSON members) which have changed locally since @entry was retrieved from
+ * the server, using a PATCH request to the same URI gdata_service_update_entry() would PUT to. This is much cheaper than a full update
+ * for large entries, and avoids sending back unhandled XML or JSON which libgdata doesn't understand.
  *
- * The service will return an updated version of the entry, which is the return value of this function on success.
+ * Changes are tracked through the public setters of the entry's properties, as well as through the add and remove methods of multi-valued
+ * properties where the entry class supports it (such as gdata_contacts_contact_add_phone_number()). Changes made to child objects in place
+ * (such as calling gdata_gd_phone_number_set_number() on one of a contact's existing phone numbers) are <emphasis>not</emphasis> tracked;
+ * remove and re-add the child instead, or use gdata_service_update_entry(). Entries which were not retrieved from the server, or which
+ * have no tracked changes, are not sent at all: @entry is returned (with an extra reference) straight away.
  *
- * If @cancellable is not %NULL, then the operation can be cancelled by triggering the @cancellable object from another thread.
- * If the operation was cancelled before or during network activity, the error %G_IO_ERROR_CANCELLED will be returned. Cancellation has no effect
- * after network activity has finished, however, and the update will return successfully (or return an error sent by the server) if it is first
- * cancelled after network activity has finished. See the <link linkend="cancellable-support">overview of cancellation</link> for
- * more details.
+ * For XML-based services, the request body is a partial entry with a <code class="literal">gd:fields</code> attribute naming the changed
+ * elements, as described in the <ulink type="http" url="https://developers.google.com/gdata/docs/2.0/reference#PartialUpdate">online
+ * documentation</ulink>. For JSON-based services, it's a JSON object containing only the changed members; members which have been cleared
+ * are sent as <code class="literal">null</code>.
  *
- * If there is an error updating the entry, a %GDATA_SERVICE_ERROR_PROTOCOL_ERROR error will be returned. Currently, subclasses
- * <emphasis>cannot</emphasis> cannot override this or provide more specific errors.
+ * The service returns the updated entry, which is the return value of this function on success. The server-assigned ETag and update time
+ * are also merged back into @entry, and its change tracking is reset, so @entry can be modified and patched again without re-fetching it.
+ *
+ * Cancellation and errors behave as for gdata_service_update_entry().
  *
  * Return value: (transfer full): an updated #GDataEntry, or %NULL; unref with g_object_unref()
  *
- * Since: 0.9.0
+ * Since: 0.17.9
  */
 GDataEntry *
-gdata_service_update_entry (GDataService *self, GDataAuthorizationDomain *domain, GDataEntry *entry, GCancellable *cancellable, GError **error)
+gdata_service_patch_entry (GDataService *self, GDataAuthorizationDomain *domain, GDataEntry *entry, GCancellable *cancellable, GError **error)
 {
 	GDataEntry *updated_entry;
 	GDataLink *_link;
@@ -1657,30 +2941,38 @@ gdata_service_update_entry (GDataService *self, GDataAuthorizationDomain *domain
 	gchar *upload_data;
 	guint status;
 	GDataParsableClass *klass;
+	gboolean is_json;
+	gint64 parse_start_time;
 
 	g_return_val_if_fail (GDATA_IS_SERVICE (self), NULL);
 	g_return_val_if_fail (domain == NULL || GDATA_IS_AUTHORIZATION_DOMAIN (domain), NULL);
 	g_return_val_if_fail (GDATA_IS_ENTRY (entry), NULL);
-	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), FALSE);
-	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
 
-	/* Append the data */
+	/* Nothing to do? */
+	if (_gdata_parsable_is_dirty (GDATA_PARSABLE (entry)) == FALSE)
+		return g_object_ref (entry);
+
+	/* Build the partial entry */
 	klass = GDATA_PARSABLE_GET_CLASS (entry);
 	g_assert (klass->get_content_type != NULL);
-	if (g_strcmp0 (klass->get_content_type (), "application/json") == 0) {
+	is_json = (g_strcmp0 (klass->get_content_type (), "application/json") == 0);
+
+	if (is_json == TRUE) {
 		/* Get the edit URI */
 		_link = gdata_entry_look_up_link (entry, GDATA_LINK_SELF);
 		g_assert (_link != NULL);
-		message = _gdata_service_build_message (self, domain, SOUP_METHOD_PUT, gdata_link_get_uri (_link), gdata_entry_get_etag (entry), TRUE);
-		upload_data = gdata_parsable_get_json (GDATA_PARSABLE (entry));
+		message = _gdata_service_build_message (self, domain, "PATCH", gdata_link_get_uri (_link), gdata_entry_get_etag (entry), TRUE);
+		upload_data = _gdata_parsable_get_patch_json (GDATA_PARSABLE (entry));
 		soup_message_set_request (message, "application/json", SOUP_MEMORY_TAKE, upload_data, strlen (upload_data));
 	} else {
 		/* Get the edit URI */
 		_link = gdata_entry_look_up_link (entry, GDATA_LINK_EDIT);
 		g_assert (_link != NULL);
-		message = _gdata_service_build_message (self, domain, SOUP_METHOD_PUT, gdata_link_get_uri (_link), gdata_entry_get_etag (entry), TRUE);
-		upload_data = gdata_parsable_get_xml (GDATA_PARSABLE (entry));
-		soup_message_set_request (message, "application/atom+xml", SOUP_MEMORY_TAKE, upload_data, strlen (upload_data));
+		message = _gdata_service_build_message (self, domain, "PATCH", gdata_link_get_uri (_link), gdata_entry_get_etag (entry), TRUE);
+		upload_data = _gdata_parsable_get_patch_xml (GDATA_PARSABLE (entry));
+		soup_message_set_request (message, "application/xml", SOUP_MEMORY_TAKE, upload_data, strlen (upload_data));
 	}
 
 	/* Send the message */
@@ -1700,16 +2992,27 @@ gdata_service_update_entry (GDataService *self, GDataAuthorizationDomain *domain
 		return NULL;
 	}
 
-	/* Parse the XML; create and return a new GDataEntry of the same type as @entry */
-	if (g_strcmp0 (klass->get_content_type (), "application/json") == 0) {
+	/* Parse the response; create and return a new GDataEntry of the same type as @entry */
+	parse_start_time = _gdata_service_begin_parse (message);
+	if (is_json == TRUE) {
 		updated_entry = GDATA_ENTRY (gdata_parsable_new_from_json (G_OBJECT_TYPE (entry), message->response_body->data,
-		                         message->response_body->length, error));
+		                             message->response_body->length, error));
 	} else {
 		updated_entry = GDATA_ENTRY (gdata_parsable_new_from_xml (G_OBJECT_TYPE (entry), message->response_body->data,
 		                             message->response_body->length, error));
 	}
+	_gdata_service_end_parse (message, parse_start_time);
 	g_object_unref (message);
 
+	if (updated_entry == NULL)
+		return NULL;
+
+	/* Merge the server-assigned metadata back into the local entry, so that it can be patched again. The changes have now been sent, so
+	 * forget about them. */
+	_gdata_entry_set_etag (entry, gdata_entry_get_etag (updated_entry));
+	_gdata_entry_set_updated (entry, gdata_entry_get_updated (updated_entry));
+	_gdata_parsable_clear_dirty (GDATA_PARSABLE (entry));
+
 	return updated_entry;
 }
 
@@ -2056,6 +3359,280 @@ gdata_service_set_timeout (GDataService *self, guint timeout)
 	g_object_notify (G_OBJECT (self), "timeout");
 }
 
+static void
+notify_max_conns_cb (GObject *gobject, GParamSpec *pspec, GObject *self)
+{
+	g_object_notify (self, "max-connections");
+}
+
+/**
+ * gdata_service_get_max_connections:
+ * @self: a #GDataService
+ *
+ * Gets the #GDataService:max-connections property; the maximum number of concurrent network connections.
+ *
+ * Return value: the maximum number of connections
+ *
+ * Since: 0.17.9
+ */
+guint
+gdata_service_get_max_connections (GDataService *self)
+{
+	gint max_conns;
+
+	g_return_val_if_fail (GDATA_IS_SERVICE (self), 0);
+
+	g_object_get (self->priv->session, SOUP_SESSION_MAX_CONNS, &max_conns, NULL);
+
+	return max_conns;
+}
+
+/**
+ * gdata_service_set_max_connections:
+ * @self: a #GDataService
+ * @max_connections: the maximum number of connections, which must be at least <code class="literal">1</code>
+ *
+ * Sets the #GDataService:max-connections property; the maximum number of concurrent network connections. This only affects connections opened
+ * after it's called.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_service_set_max_connections (GDataService *self, guint max_connections)
+{
+	g_return_if_fail (GDATA_IS_SERVICE (self));
+	g_return_if_fail (max_connections > 0 && max_connections <= G_MAXINT);
+
+	g_object_set (self->priv->session, SOUP_SESSION_MAX_CONNS, (gint) max_connections, NULL);
+	g_object_notify (G_OBJECT (self), "max-connections");
+}
+
+static void
+notify_max_conns_per_host_cb (GObject *gobject, GParamSpec *pspec, GObject *self)
+{
+	g_object_notify (self, "max-connections-per-host");
+}
+
+/**
+ * gdata_service_get_max_connections_per_host:
+ * @self: a #GDataService
+ *
+ * Gets the #GDataService:max-connections-per-host property; the maximum number of concurrent network connections to a single host.
+ *
+ * Return value: the maximum number of connections per host
+ *
+ * Since: 0.17.9
+ */
+guint
+gdata_service_get_max_connections_per_host (GDataService *self)
+{
+	gint max_conns_per_host;
+
+	g_return_val_if_fail (GDATA_IS_SERVICE (self), 0);
+
+	g_object_get (self->priv->session, SOUP_SESSION_MAX_CONNS_PER_HOST, &max_conns_per_host, NULL);
+
+	return max_conns_per_host;
+}
+
+/**
+ * gdata_service_set_max_connections_per_host:
+ * @self: a #GDataService
+ * @max_connections_per_host: the maximum number of connections per host, which must be at least <code class="literal">1</code>
+ *
+ * Sets the #GDataService:max-connections-per-host property; the maximum number of concurrent network connections to a single host. This only
+ * affects connections opened after it's called.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_service_set_max_connections_per_host (GDataService *self, guint max_connections_per_host)
+{
+	g_return_if_fail (GDATA_IS_SERVICE (self));
+	g_return_if_fail (max_connections_per_host > 0 && max_connections_per_host <= G_MAXINT);
+
+	g_object_set (self->priv->session, SOUP_SESSION_MAX_CONNS_PER_HOST, (gint) max_connections_per_host, NULL);
+	g_object_notify (G_OBJECT (self), "max-connections-per-host");
+}
+
+static void
+notify_idle_timeout_cb (GObject *gobject, GParamSpec *pspec, GObject *self)
+{
+	g_object_notify (self, "idle-timeout");
+}
+
+/**
+ * gdata_service_get_idle_timeout:
+ * @self: a #GDataService
+ *
+ * Gets the #GDataService:idle-timeout property; the timeout, in seconds, after which idle persistent connections are closed.
+ *
+ * Return value: the idle timeout, or <code class="literal">0</code>
+ *
+ * Since: 0.17.9
+ */
+guint
+gdata_service_get_idle_timeout (GDataService *self)
+{
+	guint idle_timeout;
+
+	g_return_val_if_fail (GDATA_IS_SERVICE (self), 0);
+
+	g_object_get (self->priv->session, SOUP_SESSION_IDLE_TIMEOUT, &idle_timeout, NULL);
+
+	return idle_timeout;
+}
+
+/**
+ * gdata_service_set_idle_timeout:
+ * @self: a #GDataService
+ * @idle_timeout: the idle timeout, or <code class="literal">0</code>
+ *
+ * Sets the #GDataService:idle-timeout property; the timeout, in seconds, after which idle persistent connections are closed.
+ *
+ * If @idle_timeout is <code class="literal">0</code>, idle connections are kept open until the server closes them.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_service_set_idle_timeout (GDataService *self, guint idle_timeout)
+{
+	g_return_if_fail (GDATA_IS_SERVICE (self));
+	g_object_set (self->priv->session, SOUP_SESSION_IDLE_TIMEOUT, idle_timeout, NULL);
+	g_object_notify (G_OBJECT (self), "idle-timeout");
+}
+
+/**
+ * gdata_service_get_max_retries:
+ * @self: a #GDataService
+ *
+ * Gets the #GDataService:max-retries property; the maximum number of times a request will be retried after a transient failure.
+ *
+ * Return value: the maximum number of retries, or <code class="literal">0</code>
+ *
+ * Since: 0.17.9
+ */
+guint
+gdata_service_get_max_retries (GDataService *self)
+{
+	g_return_val_if_fail (GDATA_IS_SERVICE (self), 0);
+	return self->priv->max_retries;
+}
+
+/**
+ * gdata_service_set_max_retries:
+ * @self: a #GDataService
+ * @max_retries: the maximum number of retries, or <code class="literal">0</code>
+ *
+ * Sets the #GDataService:max-retries property; the maximum number of times a request will be retried after a transient failure.
+ *
+ * If @max_retries is <code class="literal">0</code>, requests will never be retried.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_service_set_max_retries (GDataService *self, guint max_retries)
+{
+	g_return_if_fail (GDATA_IS_SERVICE (self));
+
+	self->priv->max_retries = max_retries;
+	g_object_notify (G_OBJECT (self), "max-retries");
+}
+
+/**
+ * gdata_service_set_rate_limit:
+ * @self: a #GDataService
+ * @domain: (allow-none): the #GDataAuthorizationDomain to limit requests for, or %NULL to limit requests which aren't made under any domain
+ * @requests_per_second: the maximum sustained request rate, or <code class="literal">0</code> to remove the limit
+ * @burst: the maximum number of requests which can be made in a burst after a quiet period; must be at least <code class="literal">1</code>
+ * @adaptive: %TRUE to reduce the rate temporarily if the server reports that the quota has been exceeded, %FALSE otherwise
+ *
+ * Limits the rate at which the service makes requests under @domain, using a token bucket. Requests which would exceed the limit are delayed
+ * (in the thread making them) until they can be made, rather than being sent and rejected by the server with
+ * %GDATA_SERVICE_ERROR_API_QUOTA_EXCEEDED. Concurrent requests are delayed fairly, in the order they were made. Retries (see
+ * #GDataService:max-retries) are subject to the limit too.
+ *
+ * Google applies quotas per user and per API, so the limit should be set to match the quota for the API the service accesses under @domain.
+ *
+ * If @adaptive is %TRUE, the rate is halved each time the server reports that the quota has been exceeded (down to a sixteenth of
+ * @requests_per_second), and gradually restored as requests succeed. This allows for quota shared with other clients.
+ *
+ * By default, requests are not rate limited.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_service_set_rate_limit (GDataService *self, GDataAuthorizationDomain *domain, gdouble requests_per_second, guint burst, gboolean adaptive)
+{
+	RateLimiter *limiter;
+
+	g_return_if_fail (GDATA_IS_SERVICE (self));
+	g_return_if_fail (domain == NULL || GDATA_IS_AUTHORIZATION_DOMAIN (domain));
+	g_return_if_fail (requests_per_second >= 0.0);
+	g_return_if_fail (burst > 0);
+
+	g_mutex_lock (&self->priv->rate_limit_mutex);
+
+	if (requests_per_second == 0.0) {
+		g_hash_table_remove (self->priv->rate_limiters, domain);
+	} else {
+		limiter = g_hash_table_lookup (self->priv->rate_limiters, domain);
+
+		if (limiter == NULL) {
+			limiter = g_new (RateLimiter, 1);
+			limiter->tokens = burst;
+			limiter->last_refill = g_get_monotonic_time ();
+			g_hash_table_insert (self->priv->rate_limiters, domain, limiter);
+		} else {
+			rate_limiter_refill (limiter, g_get_monotonic_time ());
+			limiter->tokens = MIN (limiter->tokens, burst);
+		}
+
+		limiter->rate = requests_per_second;
+		limiter->effective_rate = requests_per_second;
+		limiter->burst = burst;
+		limiter->adaptive = adaptive;
+	}
+
+	g_mutex_unlock (&self->priv->rate_limit_mutex);
+}
+
+/**
+ * gdata_service_get_rate_limit:
+ * @self: a #GDataService
+ * @domain: (allow-none): the #GDataAuthorizationDomain to get the rate limit for, or %NULL
+ * @requests_per_second: (out caller-allocates) (allow-none): return location for the current maximum request rate, or %NULL
+ * @burst: (out caller-allocates) (allow-none): return location for the maximum burst size, or %NULL
+ *
+ * Gets the rate limit set on requests made under @domain by gdata_service_set_rate_limit(). If the limit is adaptive, @requests_per_second
+ * is set to the current rate, which may be lower than the one originally set.
+ *
+ * Return value: %TRUE if requests under @domain are rate limited, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_service_get_rate_limit (GDataService *self, GDataAuthorizationDomain *domain, gdouble *requests_per_second, guint *burst)
+{
+	RateLimiter *limiter;
+
+	g_return_val_if_fail (GDATA_IS_SERVICE (self), FALSE);
+	g_return_val_if_fail (domain == NULL || GDATA_IS_AUTHORIZATION_DOMAIN (domain), FALSE);
+
+	g_mutex_lock (&self->priv->rate_limit_mutex);
+
+	limiter = g_hash_table_lookup (self->priv->rate_limiters, domain);
+
+	if (requests_per_second != NULL)
+		*requests_per_second = (limiter != NULL) ? limiter->effective_rate : 0.0;
+	if (burst != NULL)
+		*burst = (limiter != NULL) ? (guint) limiter->burst : 0;
+
+	g_mutex_unlock (&self->priv->rate_limit_mutex);
+
+	return (limiter != NULL);
+}
+
 SoupSession *
 _gdata_service_get_session (GDataService *self)
 {
@@ -2101,7 +3678,6 @@ gchar *
 _gdata_service_build_uri (const gchar *format, ...)
 {
 	const gchar *p;
-	gchar *fixed_uri;
 	GString *uri;
 	va_list args;
 
@@ -2140,11 +3716,16 @@ _gdata_service_build_uri (const gchar *format, ...)
 
 	va_end (args);
 
-	/* Fix the scheme to always be HTTPS */
-	fixed_uri = _gdata_service_fix_uri_scheme (uri->str);
-	g_string_free (uri, TRUE);
+	/* Fix the scheme to always be HTTPS. This is done in place, rather than using _gdata_service_fix_uri_scheme(), to save copying the URI. */
+	if (g_str_has_prefix (uri->str, "https") == FALSE) {
+		const gchar *colon = strchr (uri->str, ':');
+
+		g_assert (colon != NULL);
+		g_string_erase (uri, 0, colon - uri->str);
+		g_string_prepend (uri, "https");
+	}
 
-	return fixed_uri;
+	return g_string_free (uri, FALSE);
 }
 
 /**
@@ -104,9 +104,67 @@ typedef enum {
  * It is called in the main thread, so there is no guarantee on the order in which the callbacks are executed,
  * or whether they will be called in a timely manner. It is, however, guaranteed that they will all be called before
  * the #GAsyncReadyCallback which signals the completion of the query is called.
+ *
+ * Since version 0.17.9, the callbacks for consecutive entries are dispatched to the main thread together, according to the
+ * #GDataQuery:progress-batch-size and #GDataQuery:progress-latency properties of the query (or their defaults if no query was given). If the
+ * query's #GDataQuery:progress-in-thread property is set, the callback is instead called directly in the thread parsing the feed.
  */
 typedef void (*GDataQueryProgressCallback) (GDataEntry *entry, guint entry_key, guint entry_count, gpointer user_data);
 
+/**
+ * GDataRequestStatistics:
+ * @operation_type: the type of operation the request was made for
+ * @authorization_domain: (allow-none): the authorization domain the request was made under, or %NULL
+ * @method: the HTTP method of the request
+ * @host: the host the request was sent to
+ * @status: the final HTTP status of the request, or a libsoup transport status such as %SOUP_STATUS_CANT_CONNECT
+ * @retries: the number of times the request was retried after a transient failure
+ * @bytes_sent: the number of bytes sent for the request, including headers, across all attempts
+ * @bytes_received: the number of bytes received for the request, including headers, across all attempts
+ * @dns_time: the time spent resolving the host name, in microseconds, or <code class="literal">-1</code> if an existing connection was
+ * reused
+ * @connect_time: the time spent establishing a connection, in microseconds, or <code class="literal">-1</code> if an existing connection was
+ * reused
+ * @tls_time: the time spent in the TLS handshake, in microseconds, or <code class="literal">-1</code> if there was no handshake
+ * @time_to_first_byte: the time from the start of the final attempt until the response headers were received, in microseconds, or
+ * <code class="literal">-1</code> if no response was received
+ * @total_time: the time from the start of the request until the final response was received, in microseconds, including any time spent
+ * waiting for retries or for the rate limit
+ * @rate_limit_time: the time spent waiting for the client-side rate limit, in microseconds
+ * @parse_time: the time spent parsing the response, in microseconds, or <code class="literal">-1</code> if the response wasn't parsed
+ * @parse_statistics: counters describing the parsing of the response, which are all zero if the response wasn't parsed
+ *
+ * Statistics about a network request made by a #GDataService, as passed to the #GDataService::request-finished signal. All times are
+ * measured using the monotonic clock. The strings and the authorization domain are owned by the library and are only valid for the duration
+ * of the signal emission.
+ *
+ * Since: 0.17.9
+ */
+typedef struct {
+	/*< public >*/
+	GDataOperationType operation_type;
+	GDataAuthorizationDomain *authorization_domain;
+	const gchar *method;
+	const gchar *host;
+	guint status;
+	guint retries;
+	guint64 bytes_sent;
+	guint64 bytes_received;
+	gint64 dns_time;
+	gint64 connect_time;
+	gint64 tls_time;
+	gint64 time_to_first_byte;
+	gint64 total_time;
+	gint64 rate_limit_time;
+	gint64 parse_time;
+	GDataParseStatistics parse_statistics;
+} GDataRequestStatistics;
+
+#define GDATA_TYPE_REQUEST_STATISTICS (gdata_request_statistics_get_type ())
+GType gdata_request_statistics_get_type (void) G_GNUC_CONST;
+GDataRequestStatistics *gdata_request_statistics_copy (const GDataRequestStatistics *self) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+void gdata_request_statistics_free (GDataRequestStatistics *self);
+
 #define GDATA_TYPE_SERVICE		(gdata_service_get_type ())
 #define GDATA_SERVICE(o)		(G_TYPE_CHECK_INSTANCE_CAST ((o), GDATA_TYPE_SERVICE, GDataService))
 #define GDATA_SERVICE_CLASS(k)		(G_TYPE_CHECK_CLASS_CAST((k), GDATA_TYPE_SERVICE, GDataServiceClass))
@@ -142,6 +200,9 @@ typedef struct {
  * empty list; new in version 0.9.0
  * @parse_feed: a function to parse feed responses to queries from the online
  * service; new in version 0.17.0
+ * @get_retry_delay: a function to decide whether a request which has failed should be retried. It is passed the failed message and the
+ * number of retries already made (starting from <code class="literal">0</code>), and should return the number of milliseconds to wait before
+ * retrying, or <code class="literal">-1</code> to not retry; new in version 0.17.9
  *
  * The class structure for the #GDataService type.
  *
@@ -166,6 +227,7 @@ typedef struct {
 	                          GDataQueryProgressCallback progress_callback,
 	                          gpointer progress_user_data,
 	                          GError **error);
+	gint (*get_retry_delay) (GDataService *self, SoupMessage *message, guint attempt);
 
 	/*< private >*/
 	/* Padding for future expansion */
@@ -175,7 +237,6 @@ typedef struct {
 	void (*_g_reserved4) (void);
 	void (*_g_reserved5) (void);
 	void (*_g_reserved6) (void);
-	void (*_g_reserved7) (void);
 } GDataServiceClass;
 
 GType gdata_service_get_type (void) G_GNUC_CONST;
@@ -220,6 +281,13 @@ void gdata_service_update_entry_async (GDataService *self, GDataAuthorizationDom
 GDataEntry *gdata_service_update_entry_finish (GDataService *self, GAsyncResult *async_result,
                                                GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
 
+GDataEntry *gdata_service_patch_entry (GDataService *self, GDataAuthorizationDomain *domain, GDataEntry *entry,
+                                       GCancellable *cancellable, GError **error) G_GNUC_WARN_UNUSED_RESULT;
+void gdata_service_patch_entry_async (GDataService *self, GDataAuthorizationDomain *domain, GDataEntry *entry, GCancellable *cancellable,
+                                      GAsyncReadyCallback callback, gpointer user_data);
+GDataEntry *gdata_service_patch_entry_finish (GDataService *self, GAsyncResult *async_result,
+                                              GError **error) G_GNUC_WARN_UNUSED_RESULT;
+
 gboolean gdata_service_delete_entry (GDataService *self, GDataAuthorizationDomain *domain, GDataEntry *entry,
                                      GCancellable *cancellable, GError **error);
 void gdata_service_delete_entry_async (GDataService *self, GDataAuthorizationDomain *domain, GDataEntry *entry, GCancellable *cancellable,
@@ -237,6 +305,22 @@ void gdata_service_set_proxy_resolver (GDataService *self, GProxyResolver *proxy
 guint gdata_service_get_timeout (GDataService *self) G_GNUC_PURE;
 void gdata_service_set_timeout (GDataService *self, guint timeout);
 
+guint gdata_service_get_max_connections (GDataService *self) G_GNUC_PURE;
+void gdata_service_set_max_connections (GDataService *self, guint max_connections);
+
+guint gdata_service_get_max_connections_per_host (GDataService *self) G_GNUC_PURE;
+void gdata_service_set_max_connections_per_host (GDataService *self, guint max_connections_per_host);
+
+guint gdata_service_get_idle_timeout (GDataService *self) G_GNUC_PURE;
+void gdata_service_set_idle_timeout (GDataService *self, guint idle_timeout);
+
+guint gdata_service_get_max_retries (GDataService *self) G_GNUC_PURE;
+void gdata_service_set_max_retries (GDataService *self, guint max_retries);
+
+void gdata_service_set_rate_limit (GDataService *self, GDataAuthorizationDomain *domain, gdouble requests_per_second, guint burst,
+                                   gboolean adaptive);
+gboolean gdata_service_get_rate_limit (GDataService *self, GDataAuthorizationDomain *domain, gdouble *requests_per_second, guint *burst);
+
 const gchar *gdata_service_get_locale (GDataService *self) G_GNUC_PURE;
 void gdata_service_set_locale (GDataService *self, const gchar *locale);
 
@@ -0,0 +1,839 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ * Copyright (C) Philip Withnall 2017 <philip@tecnocode.co.uk>
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:gdata-sync-session
+ * @short_description: GData incremental synchronisation object
+ * @stability: Unstable
+ * @include: gdata/gdata-sync-session.h
+ *
+ * #GDataSyncSession keeps a local copy of a collection of entries (such as the events in a calendar, or the tasks in a task list) up to date
+ * without re-downloading the whole collection each time. It keeps a cursor marking how far through the collection's history the local copy is,
+ * and each time gdata_sync_session_run() is called, only the entries which have been inserted, updated or deleted since the cursor are
+ * downloaded and passed to the #GDataSyncSessionCallback. The cursor is then advanced.
+ *
+ * Sync sessions are created by the services which support them, using gdata_calendar_service_create_sync_session(),
+ * gdata_contacts_service_create_sync_session(), gdata_documents_service_create_sync_session() or gdata_tasks_service_create_sync_session().
+ * How the cursor is tracked depends on the service: Google Calendar and Google Drive provide opaque sync tokens (<code class="literal">nextSyncToken</code>
+ * and <code class="literal">largestChangeId</code>, respectively), whereas for Google Tasks and Google Contacts the cursor is the latest update
+ * time seen.
+ *
+ * The first run of a session, and any run after the service has invalidated the cursor (by returning <code class="literal">410 Gone</code>, for
+ * example because the cursor is too old), is a full synchronisation: a %GDATA_SYNC_CHANGE_RESET change is reported, followed by a
+ * %GDATA_SYNC_CHANGE_INSERTION change for every entry in the collection.
+ *
+ * The cursor can be persisted between runs of the application by storing the string returned by gdata_sync_session_dup_cursor() after a successful
+ * run, and restoring it with gdata_sync_session_set_cursor() on a new session for the same collection. The cursor is only advanced once a run has
+ * retrieved all of the changes, so a run which fails part-way through will be retried from the same point next time.
+ *
+ * Services don't report whether a changed entry is new, so an entry is reported as a %GDATA_SYNC_CHANGE_INSERTION if it was created after the
+ * previous run, and as a %GDATA_SYNC_CHANGE_UPDATE otherwise. For services which don't provide entries' creation times (such as Google Tasks
+ * and Google Contacts), new entries are reported as updates, so callers should treat updates to entries they don't have as insertions.
+ *
+ * <example>
+ * 	<title>Keeping a Local Copy of a Calendar Up to Date</title>
+ * 	<programlisting>
+ *	GDataCalendarService *service;
+ *	GDataCalendarCalendar *calendar;
+ *	GDataSyncSession *session;
+ *	gchar *cursor;
+ *	GError *error = NULL;
+ *
+ *	service = create_calendar_service ();
+ *	calendar = get_calendar (service);
+ *	session = gdata_calendar_service_create_sync_session (service, calendar);
+ *
+ *	/<!-- -->* Restore the cursor from the previous time the application was run, if there was one *<!-- -->/
+ *	cursor = load_cursor ();
+ *	gdata_sync_session_set_cursor (session, cursor);
+ *	g_free (cursor);
+ *
+ *	/<!-- -->* Fetch the changes *<!-- -->/
+ *	if (gdata_sync_session_run (session, change_cb, local_copy, NULL, &error) == FALSE) {
+ *		g_error ("Error synchronising calendar: %s", error->message);
+ *		g_error_free (error);
+ *	} else {
+ *		/<!-- -->* Save the new cursor *<!-- -->/
+ *		cursor = gdata_sync_session_dup_cursor (session);
+ *		save_cursor (cursor);
+ *		g_free (cursor);
+ *	}
+ *
+ *	g_object_unref (session);
+ *	g_object_unref (calendar);
+ *	g_object_unref (service);
+ *
+ *	static void
+ *	change_cb (GDataSyncChangeType change_type, GDataEntry *entry, gpointer user_data)
+ *	{
+ *		LocalCopy *local_copy = user_data;
+ *
+ *		switch (change_type) {
+ *			case GDATA_SYNC_CHANGE_RESET:
+ *				local_copy_clear (local_copy);
+ *				break;
+ *			case GDATA_SYNC_CHANGE_INSERTION:
+ *			case GDATA_SYNC_CHANGE_UPDATE:
+ *				local_copy_store (local_copy, entry);
+ *				break;
+ *			case GDATA_SYNC_CHANGE_DELETION:
+ *				local_copy_remove (local_copy, gdata_entry_get_id (entry));
+ *				break;
+ *		}
+ *	}
+ * 	</programlisting>
+ * </example>
+ *
+ * Since: 0.17.9
+ */
+
+#include <config.h>
+#include <glib.h>
+#include <string.h>
+
+#include "gdata-sync-session.h"
+#include "gdata-private.h"
+
+/* For cursors based on update times, the cursor falls back to the time the run started (minus this margin, to allow for clock skew between us
+ * and the server) if a full sync finds the collection empty. */
+#define CLOCK_SKEW_MARGIN (5 * 60) /* seconds */
+
+static void gdata_sync_session_dispose (GObject *object);
+static void gdata_sync_session_finalize (GObject *object);
+static void gdata_sync_session_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+static void gdata_sync_session_set_property (GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+
+struct _GDataSyncSessionPrivate {
+	GDataService *service;
+	GDataAuthorizationDomain *authorization_domain;
+	gchar *feed_uri;
+
+	/* Set by the service which created the session */
+	GDataQuery *query;
+	GType entry_type;
+	gchar *sync_token_parameter; /* name of the query parameter to pass the sync token in, or NULL if the cursor is an update time */
+	GDataSyncSessionIsDeletedFunc is_deleted;
+
+	GMutex cursor_mutex; /* protects sync_time and sync_token */
+	gint64 sync_time; /* latest update time seen, or the start time of the previous run for token cursors; -1 if never synchronised */
+	gchar *sync_token;
+
+	volatile gint is_running; /* TRUE while a run is in progress; only one run may happen at once. Accessed atomically. */
+};
+
+enum {
+	PROP_SERVICE = 1,
+	PROP_AUTHORIZATION_DOMAIN,
+	PROP_FEED_URI,
+};
+
+G_DEFINE_TYPE (GDataSyncSession, gdata_sync_session, G_TYPE_OBJECT)
+
+static void
+gdata_sync_session_class_init (GDataSyncSessionClass *klass)
+{
+	GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+	g_type_class_add_private (klass, sizeof (GDataSyncSessionPrivate));
+
+	gobject_class->dispose = gdata_sync_session_dispose;
+	gobject_class->finalize = gdata_sync_session_finalize;
+	gobject_class->get_property = gdata_sync_session_get_property;
+	gobject_class->set_property = gdata_sync_session_set_property;
+
+	/**
+	 * GDataSyncSession:service:
+	 *
+	 * The service this sync session is attached to.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_SERVICE,
+	                                 g_param_spec_object ("service",
+	                                                      "Service", "The service this sync session is attached to.",
+	                                                      GDATA_TYPE_SERVICE,
+	                                                      G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataSyncSession:authorization-domain:
+	 *
+	 * The authorization domain for the sync session, against which the #GDataService:authorizer for the #GDataSyncSession:service should be
+	 * authorized. This may be %NULL if authorization is not needed to query the collection.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_AUTHORIZATION_DOMAIN,
+	                                 g_param_spec_object ("authorization-domain",
+	                                                      "Authorization domain", "The authorization domain for the sync session.",
+	                                                      GDATA_TYPE_AUTHORIZATION_DOMAIN,
+	                                                      G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataSyncSession:feed-uri:
+	 *
+	 * The URI of the feed which changes to the collection are queried from.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_FEED_URI,
+	                                 g_param_spec_string ("feed-uri",
+	                                                      "Feed URI", "The URI of the feed which changes to the collection are queried from.",
+	                                                      NULL,
+	                                                      G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+}
+
+static void
+gdata_sync_session_init (GDataSyncSession *self)
+{
+	self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self, GDATA_TYPE_SYNC_SESSION, GDataSyncSessionPrivate);
+	self->priv->entry_type = GDATA_TYPE_ENTRY;
+	self->priv->sync_time = -1;
+	g_mutex_init (&(self->priv->cursor_mutex));
+}
+
+static void
+gdata_sync_session_dispose (GObject *object)
+{
+	GDataSyncSessionPrivate *priv = GDATA_SYNC_SESSION (object)->priv;
+
+	g_clear_object (&priv->query);
+	g_clear_object (&priv->authorization_domain);
+	g_clear_object (&priv->service);
+
+	/* Chain up to the parent class */
+	G_OBJECT_CLASS (gdata_sync_session_parent_class)->dispose (object);
+}
+
+static void
+gdata_sync_session_finalize (GObject *object)
+{
+	GDataSyncSessionPrivate *priv = GDATA_SYNC_SESSION (object)->priv;
+
+	g_free (priv->feed_uri);
+	g_free (priv->sync_token_parameter);
+	g_free (priv->sync_token);
+	g_mutex_clear (&(priv->cursor_mutex));
+
+	/* Chain up to the parent class */
+	G_OBJECT_CLASS (gdata_sync_session_parent_class)->finalize (object);
+}
+
+static void
+gdata_sync_session_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+	GDataSyncSessionPrivate *priv = GDATA_SYNC_SESSION (object)->priv;
+
+	switch (property_id) {
+		case PROP_SERVICE:
+			g_value_set_object (value, priv->service);
+			break;
+		case PROP_AUTHORIZATION_DOMAIN:
+			g_value_set_object (value, priv->authorization_domain);
+			break;
+		case PROP_FEED_URI:
+			g_value_set_string (value, priv->feed_uri);
+			break;
+		default:
+			/* We don't have any other property... */
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+			break;
+	}
+}
+
+static void
+gdata_sync_session_set_property (GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+	GDataSyncSessionPrivate *priv = GDATA_SYNC_SESSION (object)->priv;
+
+	switch (property_id) {
+		/* Construct only */
+		case PROP_SERVICE:
+			priv->service = g_value_dup_object (value);
+			break;
+		case PROP_AUTHORIZATION_DOMAIN:
+			priv->authorization_domain = g_value_dup_object (value);
+			break;
+		case PROP_FEED_URI:
+			priv->feed_uri = g_value_dup_string (value);
+			break;
+		default:
+			/* We don't have any other property... */
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+			break;
+	}
+}
+
+/*
+ * _gdata_sync_session_new:
+ * @service: the #GDataService the collection belongs to
+ * @domain: (allow-none): the #GDataAuthorizationDomain to authorize queries under, or %NULL
+ * @feed_uri: the URI of the feed to query for changes
+ * @query: the query to use for each request; the session takes over its pagination and (if @sync_token_parameter is %NULL) its
+ * #GDataQuery:updated-min property
+ * @entry_type: the type of the entries in the feed
+ * @sync_token_parameter: (allow-none): the name of the query parameter to pass the sync token from the previous run in, or %NULL to use
+ * #GDataQuery:updated-min as the cursor instead
+ * @is_deleted: function to determine whether an entry returned by the feed represents a deletion
+ *
+ * Creates a new #GDataSyncSession. This is used by services to implement their gdata_*_service_create_sync_session() functions. If
+ * @sync_token_parameter is non-%NULL, the service must set the next sync token on the last page of the feed using
+ * _gdata_feed_set_next_sync_token() (this is done automatically for JSON feeds which use <code class="literal">nextSyncToken</code>).
+ *
+ * Return value: (transfer full): a new #GDataSyncSession; unref with g_object_unref()
+ */
+GDataSyncSession *
+_gdata_sync_session_new (GDataService *service, GDataAuthorizationDomain *domain, const gchar *feed_uri, GDataQuery *query, GType entry_type,
+                         const gchar *sync_token_parameter, GDataSyncSessionIsDeletedFunc is_deleted)
+{
+	GDataSyncSession *self;
+
+	g_return_val_if_fail (GDATA_IS_SERVICE (service), NULL);
+	g_return_val_if_fail (domain == NULL || GDATA_IS_AUTHORIZATION_DOMAIN (domain), NULL);
+	g_return_val_if_fail (feed_uri != NULL, NULL);
+	g_return_val_if_fail (GDATA_IS_QUERY (query), NULL);
+	g_return_val_if_fail (g_type_is_a (entry_type, GDATA_TYPE_ENTRY), NULL);
+	g_return_val_if_fail (is_deleted != NULL, NULL);
+
+	self = g_object_new (GDATA_TYPE_SYNC_SESSION,
+	                     "service", service,
+	                     "authorization-domain", domain,
+	                     "feed-uri", feed_uri,
+	                     NULL);
+
+	self->priv->query = g_object_ref (query);
+	self->priv->entry_type = entry_type;
+	self->priv->sync_token_parameter = g_strdup (sync_token_parameter);
+	self->priv->is_deleted = is_deleted;
+
+	return self;
+}
+
+/**
+ * gdata_sync_session_get_service:
+ * @self: a #GDataSyncSession
+ *
+ * Gets the #GDataSyncSession:service property.
+ *
+ * Return value: (transfer none): the sync session's attached service
+ *
+ * Since: 0.17.9
+ */
+GDataService *
+gdata_sync_session_get_service (GDataSyncSession *self)
+{
+	g_return_val_if_fail (GDATA_IS_SYNC_SESSION (self), NULL);
+	return self->priv->service;
+}
+
+/**
+ * gdata_sync_session_get_authorization_domain:
+ * @self: a #GDataSyncSession
+ *
+ * Gets the #GDataSyncSession:authorization-domain property.
+ *
+ * Return value: (transfer none) (allow-none): the #GDataAuthorizationDomain used to authorize the sync session's queries, or %NULL
+ *
+ * Since: 0.17.9
+ */
+GDataAuthorizationDomain *
+gdata_sync_session_get_authorization_domain (GDataSyncSession *self)
+{
+	g_return_val_if_fail (GDATA_IS_SYNC_SESSION (self), NULL);
+	return self->priv->authorization_domain;
+}
+
+/**
+ * gdata_sync_session_get_feed_uri:
+ * @self: a #GDataSyncSession
+ *
+ * Gets the #GDataSyncSession:feed-uri property.
+ *
+ * Return value: the sync session's feed URI
+ *
+ * Since: 0.17.9
+ */
+const gchar *
+gdata_sync_session_get_feed_uri (GDataSyncSession *self)
+{
+	g_return_val_if_fail (GDATA_IS_SYNC_SESSION (self), NULL);
+	return self->priv->feed_uri;
+}
+
+/**
+ * gdata_sync_session_dup_cursor:
+ * @self: a #GDataSyncSession
+ *
+ * Gets a string representing how far through the collection's history the session has synchronised, suitable for storing and later passing to
+ * gdata_sync_session_set_cursor(). The format of the string is opaque, and specific to the service and collection the session was created for.
+ *
+ * If the session hasn't yet synchronised successfully, %NULL is returned.
+ *
+ * Return value: (allow-none): the session's cursor, or %NULL; free with g_free()
+ *
+ * Since: 0.17.9
+ */
+gchar *
+gdata_sync_session_dup_cursor (GDataSyncSession *self)
+{
+	GDataSyncSessionPrivate *priv;
+	gchar *cursor = NULL;
+
+	g_return_val_if_fail (GDATA_IS_SYNC_SESSION (self), NULL);
+
+	priv = self->priv;
+
+	g_mutex_lock (&(priv->cursor_mutex));
+
+	/* The cursor is the sync time and the sync token (if used), separated by a colon. Tokens don't contain colons, but it doesn't matter if they
+	 * do, as we only split on the first one. */
+	if (priv->sync_time != -1 && (priv->sync_token_parameter == NULL || priv->sync_token != NULL)) {
+		cursor = g_strdup_printf ("%" G_GINT64_FORMAT ":%s", priv->sync_time,
+		                          (priv->sync_token != NULL) ? priv->sync_token : "");
+	}
+
+	g_mutex_unlock (&(priv->cursor_mutex));
+
+	return cursor;
+}
+
+/**
+ * gdata_sync_session_set_cursor:
+ * @self: a #GDataSyncSession
+ * @cursor: (allow-none): a cursor previously returned by gdata_sync_session_dup_cursor(), or %NULL
+ *
+ * Sets the cursor of the session, so that the next run of the session will only return changes made since the run which @cursor was retrieved
+ * after. @cursor must have been retrieved from a session for the same collection. If @cursor is %NULL or invalid, the next run will be a full
+ * synchronisation.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_sync_session_set_cursor (GDataSyncSession *self, const gchar *cursor)
+{
+	GDataSyncSessionPrivate *priv;
+	gint64 sync_time = -1;
+	const gchar *sync_token = NULL;
+	gchar *end_ptr;
+
+	g_return_if_fail (GDATA_IS_SYNC_SESSION (self));
+
+	priv = self->priv;
+
+	if (cursor != NULL) {
+		sync_time = g_ascii_strtoll (cursor, &end_ptr, 10);
+
+		if (end_ptr == cursor || *end_ptr != ':' || sync_time < 0) {
+			sync_time = -1;
+		} else if (*(end_ptr + 1) != '\0') {
+			sync_token = end_ptr + 1;
+		}
+	}
+
+	g_mutex_lock (&(priv->cursor_mutex));
+
+	priv->sync_time = sync_time;
+	g_free (priv->sync_token);
+	priv->sync_token = (sync_time != -1) ? g_strdup (sync_token) : NULL;
+
+	g_mutex_unlock (&(priv->cursor_mutex));
+}
+
+typedef struct {
+	GDataSyncSessionCallback callback;
+	gpointer user_data;
+	GDestroyNotify destroy_user_data;
+	gboolean is_async; /* TRUE if the callback should be called in the main thread */
+} RunData;
+
+static void
+run_data_free (RunData *data)
+{
+	if (data->destroy_user_data != NULL)
+		data->destroy_user_data (data->user_data);
+
+	g_slice_free (RunData, data);
+}
+
+typedef struct {
+	GDataSyncSessionCallback callback;
+	gpointer user_data;
+	GDataSyncChangeType change_type;
+	GDataEntry *entry;
+} ChangeData;
+
+static gboolean
+change_cb (ChangeData *data)
+{
+	data->callback (data->change_type, data->entry, data->user_data);
+
+	if (data->entry != NULL)
+		g_object_unref (data->entry);
+	g_slice_free (ChangeData, data);
+
+	return FALSE;
+}
+
+static void
+report_change (RunData *run_data, GDataSyncChangeType change_type, GDataEntry *entry)
+{
+	ChangeData *data;
+
+	if (run_data->callback == NULL)
+		return;
+
+	if (run_data->is_async == FALSE) {
+		run_data->callback (change_type, entry, run_data->user_data);
+		return;
+	}
+
+	/* Send the change to the main thread; use G_PRIORITY_DEFAULT rather than G_PRIORITY_DEFAULT_IDLE to contend with the priorities used by the
+	 * callback functions in GAsyncResult, so that all the changes are reported before the run finishes */
+	data = g_slice_new (ChangeData);
+	data->callback = run_data->callback;
+	data->user_data = run_data->user_data;
+	data->change_type = change_type;
+	data->entry = (entry != NULL) ? g_object_ref (entry) : NULL;
+
+	g_idle_add_full (G_PRIORITY_DEFAULT, (GSourceFunc) change_cb, data, NULL);
+}
+
+/* Query a single page of changes. If the request fails, *status is set to the HTTP status of the response, so that the caller can check whether
+ * the cursor has been invalidated. */
+static GDataFeed *
+query_page (GDataSyncSession *self, const gchar *feed_uri, GCancellable *cancellable, guint *status, GError **error)
+{
+	GDataSyncSessionPrivate *priv = self->priv;
+	GDataServiceClass *klass;
+	SoupMessage *message;
+	GDataFeed *feed;
+	gchar *query_uri;
+
+	klass = GDATA_SERVICE_GET_CLASS (priv->service);
+
+	query_uri = gdata_query_get_query_uri (priv->query, feed_uri);
+	message = _gdata_service_build_message (priv->service, priv->authorization_domain, SOUP_METHOD_GET, query_uri, NULL, FALSE);
+	g_free (query_uri);
+
+	/* Note that cancellation only applies to network activity; not to the processing done afterwards */
+	*status = _gdata_service_send_message (priv->service, message, cancellable, error);
+
+	if (*status != SOUP_STATUS_OK) {
+		/* Iff status is SOUP_STATUS_NONE or SOUP_STATUS_CANCELLED, error has already been set */
+		if (*status != SOUP_STATUS_NONE && *status != SOUP_STATUS_CANCELLED) {
+			g_assert (klass->parse_error_response != NULL);
+			klass->parse_error_response (priv->service, GDATA_OPERATION_QUERY, *status, message->reason_phrase,
+			                             message->response_body->data, message->response_body->length, error);
+		}
+
+		g_object_unref (message);
+		return NULL;
+	}
+
+	/* Parse the feed. This also updates the query's pagination state. */
+	g_assert (klass->parse_feed != NULL);
+	feed = klass->parse_feed (priv->service, priv->authorization_domain, priv->query, priv->entry_type, message, cancellable, NULL, NULL,
+	                          error);
+	g_object_unref (message);
+
+	return feed;
+}
+
+static gboolean
+run_session (GDataSyncSession *self, RunData *run_data, GCancellable *cancellable, GError **error)
+{
+	GDataSyncSessionPrivate *priv = self->priv;
+	gint64 previous_sync_time, start_time, latest_updated;
+	gchar *previous_sync_token, *next_sync_token = NULL, *feed_uri;
+	gboolean is_full_sync;
+	GError *child_error = NULL;
+
+	g_mutex_lock (&(priv->cursor_mutex));
+	previous_sync_time = priv->sync_time;
+	previous_sync_token = g_strdup (priv->sync_token);
+	g_mutex_unlock (&(priv->cursor_mutex));
+
+	start_time = g_get_real_time () / G_USEC_PER_SEC;
+	is_full_sync = (previous_sync_time == -1 || (priv->sync_token_parameter != NULL && previous_sync_token == NULL));
+
+restart:
+	if (is_full_sync == TRUE)
+		report_change (run_data, GDATA_SYNC_CHANGE_RESET, NULL);
+
+	/* Reset the query to the first page of changes since the cursor */
+	_gdata_query_clear_pagination (priv->query);
+	gdata_query_set_start_index (priv->query, 0);
+	gdata_query_set_etag (priv->query, NULL);
+
+	if (priv->sync_token_parameter == NULL) {
+		gdata_query_set_updated_min (priv->query, (is_full_sync == TRUE) ? -1 : previous_sync_time);
+		feed_uri = g_strdup (priv->feed_uri);
+	} else if (is_full_sync == FALSE) {
+		GString *uri = g_string_new (priv->feed_uri);
+
+		g_string_append_c (uri, (strchr (priv->feed_uri, '?') == NULL) ? '?' : '&');
+		g_string_append_uri_escaped (uri, priv->sync_token_parameter, NULL, FALSE);
+		g_string_append_c (uri, '=');
+		g_string_append_uri_escaped (uri, previous_sync_token, NULL, FALSE);
+
+		feed_uri = g_string_free (uri, FALSE);
+	} else {
+		feed_uri = g_strdup (priv->feed_uri);
+	}
+
+	latest_updated = -1;
+
+	while (TRUE) {
+		GDataFeed *feed;
+		GList *entries, *i;
+		guint status;
+
+		feed = query_page (self, feed_uri, cancellable, &status, &child_error);
+
+		if (feed == NULL) {
+			if (status == SOUP_STATUS_GONE && is_full_sync == FALSE) {
+				/* The service has invalidated the cursor, so start again from scratch */
+				g_debug ("Sync cursor for %s is no longer valid; doing a full sync.", priv->feed_uri);
+
+				g_clear_error (&child_error);
+				g_free (feed_uri);
+				is_full_sync = TRUE;
+
+				goto restart;
+			}
+
+			g_free (feed_uri);
+			g_free (previous_sync_token);
+			g_free (next_sync_token);
+			g_propagate_error (error, child_error);
+
+			return FALSE;
+		}
+
+		entries = gdata_feed_get_entries (feed);
+
+		for (i = entries; i != NULL; i = i->next) {
+			GDataEntry *entry = GDATA_ENTRY (i->data);
+			GDataSyncChangeType change_type;
+			gint64 published, updated;
+
+			updated = gdata_entry_get_updated (entry);
+			if (updated > latest_updated)
+				latest_updated = updated;
+
+			if (priv->is_deleted (entry) == TRUE) {
+				/* A full sync only reports what's there now */
+				if (is_full_sync == TRUE)
+					continue;
+
+				change_type = GDATA_SYNC_CHANGE_DELETION;
+			} else {
+				published = gdata_entry_get_published (entry);
+
+				if (is_full_sync == TRUE || (published != -1 && published >= previous_sync_time))
+					change_type = GDATA_SYNC_CHANGE_INSERTION;
+				else
+					change_type = GDATA_SYNC_CHANGE_UPDATE;
+			}
+
+			report_change (run_data, change_type, entry);
+		}
+
+		/* The sync token is only given on the last page */
+		if (_gdata_feed_get_next_sync_token (feed) != NULL) {
+			g_free (next_sync_token);
+			next_sync_token = g_strdup (_gdata_feed_get_next_sync_token (feed));
+		}
+
+		g_object_unref (feed);
+
+		/* Move on to the next page, if there is one */
+		gdata_query_next_page (priv->query);
+
+		if (entries == NULL || _gdata_query_is_finished (priv->query) == TRUE)
+			break;
+	}
+
+	g_free (feed_uri);
+	g_free (previous_sync_token);
+
+	/* Advance the cursor now that all the changes have been retrieved */
+	g_mutex_lock (&(priv->cursor_mutex));
+
+	if (priv->sync_token_parameter == NULL) {
+		/* The update time bound is inclusive, so entries updated at exactly latest_updated will be returned again by the next run; that's
+		 * harmless, and avoids missing changes made in the same second. */
+		if (latest_updated != -1)
+			priv->sync_time = latest_updated;
+		else if (is_full_sync == TRUE)
+			priv->sync_time = start_time - CLOCK_SKEW_MARGIN;
+	} else {
+		if (next_sync_token == NULL)
+			g_debug ("No sync token returned for %s; the next sync will be a full sync.", priv->feed_uri);
+
+		priv->sync_time = start_time;
+		g_free (priv->sync_token);
+		priv->sync_token = next_sync_token;
+	}
+
+	g_mutex_unlock (&(priv->cursor_mutex));
+
+	return TRUE;
+}
+
+/**
+ * gdata_sync_session_run:
+ * @self: a #GDataSyncSession
+ * @callback: (allow-none) (scope call) (closure user_data): a #GDataSyncSessionCallback to call for each change, or %NULL
+ * @user_data: (closure): data to pass to the @callback function
+ * @cancellable: (allow-none): a #GCancellable, or %NULL
+ * @error: a #GError, or %NULL
+ *
+ * Retrieves the changes made to the session's collection since the session's cursor, calling @callback for each of them in the order they were
+ * received, and then advances the cursor. If the session has no cursor, or the service reports that the cursor is no longer valid, all the
+ * entries in the collection are retrieved instead, preceded by a %GDATA_SYNC_CHANGE_RESET change. This function blocks until all the changes
+ * have been retrieved, which may take several requests.
+ *
+ * If the run fails (including if it is cancelled using @cancellable), %FALSE is returned, @error is set and the cursor is left unchanged. Some
+ * of the changes may already have been passed to @callback; these will be reported again by the next run.
+ *
+ * Only one run of a session may be in progress at once.
+ *
+ * Return value: %TRUE on success, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_sync_session_run (GDataSyncSession *self, GDataSyncSessionCallback callback, gpointer user_data, GCancellable *cancellable, GError **error)
+{
+	RunData run_data = { callback, user_data, NULL, FALSE };
+	gboolean started, success;
+
+	g_return_val_if_fail (GDATA_IS_SYNC_SESSION (self), FALSE);
+	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	/* Runs may be started from several threads at once, so check and set the flag in one step */
+	started = g_atomic_int_compare_and_exchange (&(self->priv->is_running), FALSE, TRUE);
+	g_return_val_if_fail (started == TRUE, FALSE);
+
+	success = run_session (self, &run_data, cancellable, error);
+	g_atomic_int_set (&(self->priv->is_running), FALSE);
+
+	return success;
+}
+
+static void
+run_thread (GSimpleAsyncResult *result, GDataSyncSession *self, GCancellable *cancellable)
+{
+	RunData *run_data;
+	gboolean success;
+	GError *error = NULL;
+
+	run_data = g_simple_async_result_get_op_res_gpointer (result);
+
+	/* Run the session and return */
+	success = run_session (self, run_data, cancellable, &error);
+	g_atomic_int_set (&(self->priv->is_running), FALSE);
+
+	/* Propagate any errors */
+	if (success == FALSE) {
+		g_simple_async_result_set_from_error (result, error);
+		g_error_free (error);
+	}
+}
+
+/**
+ * gdata_sync_session_run_async:
+ * @self: a #GDataSyncSession
+ * @change_callback: (allow-none) (closure change_user_data): a #GDataSyncSessionCallback to call for each change, or %NULL
+ * @change_user_data: (closure): data to pass to the @change_callback function
+ * @destroy_change_user_data: (allow-none): the function to call when @change_callback will not be called any more, or %NULL. This function will
+ * be called with @change_user_data as a parameter and can be used to free any memory allocated for it.
+ * @cancellable: (allow-none): a #GCancellable, or %NULL
+ * @callback: a #GAsyncReadyCallback to call when the run is finished, or %NULL
+ * @user_data: (closure): data to pass to the @callback function
+ *
+ * Retrieves the changes made to the session's collection since the session's cursor, asynchronously. @change_callback is called for each
+ * change in an idle function in the main thread. @self is reffed when this function is called, so can safely be unreffed after this function
+ * returns.
+ *
+ * For more details, see gdata_sync_session_run(), which is the synchronous version of this function.
+ *
+ * When the run is finished, @callback will be called. You can then call gdata_sync_session_run_finish() to get the result of the run.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_sync_session_run_async (GDataSyncSession *self, GDataSyncSessionCallback change_callback, gpointer change_user_data,
+                              GDestroyNotify destroy_change_user_data, GCancellable *cancellable,
+                              GAsyncReadyCallback callback, gpointer user_data)
+{
+	GSimpleAsyncResult *result;
+	RunData *run_data;
+	gboolean started;
+
+	g_return_if_fail (GDATA_IS_SYNC_SESSION (self));
+	g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+
+	/* The flag is cleared by run_thread() in a worker thread */
+	started = g_atomic_int_compare_and_exchange (&(self->priv->is_running), FALSE, TRUE);
+	g_return_if_fail (started == TRUE);
+
+	run_data = g_slice_new (RunData);
+	run_data->callback = change_callback;
+	run_data->user_data = change_user_data;
+	run_data->destroy_user_data = destroy_change_user_data;
+	run_data->is_async = TRUE;
+
+	result = g_simple_async_result_new (G_OBJECT (self), callback, user_data, gdata_sync_session_run_async);
+	g_simple_async_result_set_op_res_gpointer (result, run_data, (GDestroyNotify) run_data_free);
+
+	/* Disable handling of cancellation so that g_simple_async_result_run_in_thread() doesn't return immediately without calling run_thread() if
+	 * cancellable has already been cancelled by this point. */
+	g_simple_async_result_set_handle_cancellation (result, FALSE);
+
+	g_simple_async_result_run_in_thread (result, (GSimpleAsyncThreadFunc) run_thread, G_PRIORITY_DEFAULT, cancellable);
+	g_object_unref (result);
+}
+
+/**
+ * gdata_sync_session_run_finish:
+ * @self: a #GDataSyncSession
+ * @async_result: a #GAsyncResult
+ * @error: a #GError, or %NULL
+ *
+ * Finishes an asynchronous sync session run started with gdata_sync_session_run_async().
+ *
+ * Return values are as for gdata_sync_session_run().
+ *
+ * Return value: %TRUE on success, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_sync_session_run_finish (GDataSyncSession *self, GAsyncResult *async_result, GError **error)
+{
+	g_return_val_if_fail (GDATA_IS_SYNC_SESSION (self), FALSE);
+	g_return_val_if_fail (G_IS_ASYNC_RESULT (async_result), FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	g_warn_if_fail (g_simple_async_result_get_source_tag (G_SIMPLE_ASYNC_RESULT (async_result)) == gdata_sync_session_run_async);
+
+	return !g_simple_async_result_propagate_error (G_SIMPLE_ASYNC_RESULT (async_result), error);
+}
@@ -0,0 +1,129 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ * Copyright (C) Philip Withnall 2017 <philip@tecnocode.co.uk>
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GDATA_SYNC_SESSION_H
+#define GDATA_SYNC_SESSION_H
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <gdata/gdata-service.h>
+#include <gdata/gdata-entry.h>
+#include <gdata/gdata-authorization-domain.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GDataSyncChangeType:
+ * @GDATA_SYNC_CHANGE_RESET: the local copy of the collection is out of date and must be discarded; all the entries in the collection follow
+ * as %GDATA_SYNC_CHANGE_INSERTION changes
+ * @GDATA_SYNC_CHANGE_INSERTION: the entry has been added to the collection
+ * @GDATA_SYNC_CHANGE_UPDATE: the entry has been modified
+ * @GDATA_SYNC_CHANGE_DELETION: the entry has been removed from the collection
+ *
+ * Indicates which type of change to the collection caused the current #GDataSyncSessionCallback to be called.
+ *
+ * Since: 0.17.9
+ */
+typedef enum {
+	GDATA_SYNC_CHANGE_RESET = 0,
+	GDATA_SYNC_CHANGE_INSERTION,
+	GDATA_SYNC_CHANGE_UPDATE,
+	GDATA_SYNC_CHANGE_DELETION
+} GDataSyncChangeType;
+
+/**
+ * GDataSyncSessionCallback:
+ * @change_type: the type of change
+ * @entry: (allow-none): the entry which has changed, or %NULL if @change_type is %GDATA_SYNC_CHANGE_RESET
+ * @user_data: user data passed to the callback
+ *
+ * Callback function called once for each change to the collection found by gdata_sync_session_run().
+ *
+ * For %GDATA_SYNC_CHANGE_DELETION changes, only the ID of @entry is guaranteed to be set. If the callback code needs to retain a copy of @entry,
+ * it must be referenced (with g_object_ref()).
+ *
+ * The callbacks are called in the order the changes were received. They are all called before gdata_sync_session_run() returns, or before the
+ * #GAsyncReadyCallback passed to gdata_sync_session_run_async() is called.
+ *
+ * Since: 0.17.9
+ */
+typedef void (*GDataSyncSessionCallback) (GDataSyncChangeType change_type, GDataEntry *entry, gpointer user_data);
+
+#define GDATA_TYPE_SYNC_SESSION			(gdata_sync_session_get_type ())
+#define GDATA_SYNC_SESSION(o)			(G_TYPE_CHECK_INSTANCE_CAST ((o), GDATA_TYPE_SYNC_SESSION, GDataSyncSession))
+#define GDATA_SYNC_SESSION_CLASS(k)		(G_TYPE_CHECK_CLASS_CAST((k), GDATA_TYPE_SYNC_SESSION, GDataSyncSessionClass))
+#define GDATA_IS_SYNC_SESSION(o)		(G_TYPE_CHECK_INSTANCE_TYPE ((o), GDATA_TYPE_SYNC_SESSION))
+#define GDATA_IS_SYNC_SESSION_CLASS(k)		(G_TYPE_CHECK_CLASS_TYPE ((k), GDATA_TYPE_SYNC_SESSION))
+#define GDATA_SYNC_SESSION_GET_CLASS(o)		(G_TYPE_INSTANCE_GET_CLASS ((o), GDATA_TYPE_SYNC_SESSION, GDataSyncSessionClass))
+
+typedef struct _GDataSyncSessionPrivate	GDataSyncSessionPrivate;
+
+/**
+ * GDataSyncSession:
+ *
+ * All the fields in the #GDataSyncSession structure are private and should never be accessed directly.
+ *
+ * Since: 0.17.9
+ */
+typedef struct {
+	GObject parent;
+	GDataSyncSessionPrivate *priv;
+} GDataSyncSession;
+
+/**
+ * GDataSyncSessionClass:
+ *
+ * All the fields in the #GDataSyncSessionClass structure are private and should never be accessed directly.
+ *
+ * Since: 0.17.9
+ */
+typedef struct {
+	/*< private >*/
+	GObjectClass parent;
+
+	/*< private >*/
+	/* Padding for future expansion */
+	void (*_g_reserved0) (void);
+	void (*_g_reserved1) (void);
+	void (*_g_reserved2) (void);
+	void (*_g_reserved3) (void);
+	void (*_g_reserved4) (void);
+	void (*_g_reserved5) (void);
+} GDataSyncSessionClass;
+
+GType gdata_sync_session_get_type (void) G_GNUC_CONST;
+
+GDataService *gdata_sync_session_get_service (GDataSyncSession *self) G_GNUC_PURE;
+GDataAuthorizationDomain *gdata_sync_session_get_authorization_domain (GDataSyncSession *self) G_GNUC_PURE;
+const gchar *gdata_sync_session_get_feed_uri (GDataSyncSession *self) G_GNUC_PURE;
+
+gchar *gdata_sync_session_dup_cursor (GDataSyncSession *self) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+void gdata_sync_session_set_cursor (GDataSyncSession *self, const gchar *cursor);
+
+gboolean gdata_sync_session_run (GDataSyncSession *self, GDataSyncSessionCallback callback, gpointer user_data,
+                                 GCancellable *cancellable, GError **error);
+void gdata_sync_session_run_async (GDataSyncSession *self, GDataSyncSessionCallback change_callback, gpointer change_user_data,
+                                   GDestroyNotify destroy_change_user_data, GCancellable *cancellable,
+                                   GAsyncReadyCallback callback, gpointer user_data);
+gboolean gdata_sync_session_run_finish (GDataSyncSession *self, GAsyncResult *async_result, GError **error);
+
+G_END_DECLS
+
+#endif /* !GDATA_SYNC_SESSION_H */
@@ -35,6 +35,8 @@
 #include <gdata/gdata-comparable.h>
 #include <gdata/gdata-batchable.h>
 #include <gdata/gdata-batch-operation.h>
+#include <gdata/gdata-sync-session.h>
+#include <gdata/gdata-entry-store.h>
 #include <gdata/gdata-authorizer.h>
 #include <gdata/gdata-authorization-domain.h>
 #include <gdata/gdata-client-login-authorizer.h>
@@ -84,6 +86,7 @@
 #include <gdata/media/gdata-media-category.h>
 #include <gdata/media/gdata-media-content.h>
 #include <gdata/media/gdata-media-credit.h>
+#include <gdata/media/gdata-media-downloader.h>
 #include <gdata/media/gdata-media-enums.h>
 #include <gdata/media/gdata-media-thumbnail.h>
 
@@ -106,6 +109,7 @@
 #include <gdata/services/calendar/gdata-calendar-feed.h>
 #include <gdata/services/calendar/gdata-calendar-calendar.h>
 #include <gdata/services/calendar/gdata-calendar-event.h>
+#include <gdata/services/calendar/gdata-calendar-recurrence.h>
 #include <gdata/services/calendar/gdata-calendar-query.h>
 #include <gdata/services/calendar/gdata-calendar-access-rule.h>
 
@@ -132,6 +136,7 @@
 #include <gdata/services/documents/gdata-documents-spreadsheet.h>
 #include <gdata/services/documents/gdata-documents-presentation.h>
 #include <gdata/services/documents/gdata-documents-folder.h>
+#include <gdata/services/documents/gdata-documents-folder-index.h>
 #include <gdata/services/documents/gdata-documents-query.h>
 #include <gdata/services/documents/gdata-documents-service.h>
 #include <gdata/services/documents/gdata-documents-feed.h>
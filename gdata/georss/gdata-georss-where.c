@@ -68,6 +68,8 @@ gdata_georss_where_class_init (GDataGeoRSSWhereClass *klass)
 	parsable_class->get_namespaces = get_namespaces;
 	parsable_class->element_name = "where";
 	parsable_class->element_namespace = "georss";
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static void
@@ -35,6 +35,7 @@
 #include "gdata-media-category.h"
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 #include "gdata-types.h"
 
 static void gdata_media_category_finalize (GObject *object);
@@ -124,6 +125,8 @@ gdata_media_category_class_init (GDataMediaCategoryClass *klass)
 	                                                      "Label", "A human-readable label that can be displayed in end-user applications.",
 	                                                      NULL,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static void
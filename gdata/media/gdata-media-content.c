@@ -45,6 +45,8 @@ static void gdata_media_content_finalize (GObject *object);
 static void gdata_media_content_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 static gboolean pre_parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *root_node, gpointer user_data, GError **error);
 static void get_namespaces (GDataParsable *parsable, GHashTable *namespaces);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 
 struct _GDataMediaContentPrivate {
 	gchar *uri;
@@ -224,6 +226,8 @@ gdata_media_content_class_init (GDataMediaContentClass *klass)
 	                                                    "Width", "The width of the media object.",
 	                                                    0, G_MAXUINT, 0,
 	                                                    G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static void
@@ -381,6 +385,39 @@ get_namespaces (GDataParsable *parsable, GHashTable *namespaces)
 	g_hash_table_insert (namespaces, (gchar*) "media", (gchar*) "http://search.yahoo.com/mrss/");
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	GDataMediaContentPrivate *priv = GDATA_MEDIA_CONTENT (parsable)->priv;
+
+	/* All of the content's properties are read-only */
+	gdata_binary_writer_put_string (writer, priv->uri);
+	gdata_binary_writer_put_uint (writer, priv->filesize);
+	gdata_binary_writer_put_string (writer, priv->content_type);
+	gdata_binary_writer_put_int (writer, priv->medium);
+	gdata_binary_writer_put_boolean (writer, priv->is_default);
+	gdata_binary_writer_put_int (writer, priv->expression);
+	gdata_binary_writer_put_int (writer, priv->duration);
+	gdata_binary_writer_put_uint (writer, priv->height);
+	gdata_binary_writer_put_uint (writer, priv->width);
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	GDataMediaContentPrivate *priv = GDATA_MEDIA_CONTENT (parsable)->priv;
+
+	priv->uri = gdata_binary_reader_dup_string (reader);
+	priv->filesize = gdata_binary_reader_get_uint (reader);
+	priv->content_type = gdata_binary_reader_dup_string (reader);
+	priv->medium = gdata_binary_reader_get_int (reader);
+	priv->is_default = gdata_binary_reader_get_boolean (reader);
+	priv->expression = gdata_binary_reader_get_int (reader);
+	priv->duration = gdata_binary_reader_get_int (reader);
+	priv->height = gdata_binary_reader_get_uint (reader);
+	priv->width = gdata_binary_reader_get_uint (reader);
+}
+
 /**
  * gdata_media_content_get_uri:
  * @self: a #GDataMediaContent
@@ -38,12 +38,15 @@
 #include "gdata-parsable.h"
 #include "gdata-parser.h"
 #include "gdata-types.h"
+#include "gdata-private.h"
 
 static void gdata_media_credit_finalize (GObject *object);
 static void gdata_media_credit_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 static gboolean pre_parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *root_node, gpointer user_data, GError **error);
 static gboolean parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *node, gpointer user_data, GError **error);
 static void get_namespaces (GDataParsable *parsable, GHashTable *namespaces);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 
 struct _GDataMediaCreditPrivate {
 	gchar *credit;
@@ -120,6 +123,8 @@ gdata_media_credit_class_init (GDataMediaCreditClass *klass)
 	                                                      "Role", "The role the credited entity played in the production of the media.",
 	                                                      NULL,
 	                                                      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static void
@@ -216,6 +221,26 @@ get_namespaces (GDataParsable *parsable, GHashTable *namespaces)
 	g_hash_table_insert (namespaces, (gchar*) "media", (gchar*) "http://search.yahoo.com/mrss/");
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	GDataMediaCreditPrivate *priv = GDATA_MEDIA_CREDIT (parsable)->priv;
+
+	gdata_binary_writer_put_string (writer, priv->credit);
+	gdata_binary_writer_put_string (writer, priv->scheme);
+	gdata_binary_writer_put_string (writer, priv->role);
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	GDataMediaCreditPrivate *priv = GDATA_MEDIA_CREDIT (parsable)->priv;
+
+	priv->credit = gdata_binary_reader_dup_string (reader);
+	priv->scheme = gdata_binary_reader_dup_string (reader);
+	priv->role = gdata_binary_reader_dup_string (reader);
+}
+
 /**
  * gdata_media_credit_get_credit:
  * @self: a #GDataMediaCredit
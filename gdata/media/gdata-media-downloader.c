@@ -0,0 +1,971 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ * Copyright (C) Philip Withnall 2017 <philip@tecnocode.co.uk>
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:gdata-media-downloader
+ * @short_description: Bulk downloader for media thumbnails and content
+ * @stability: Unstable
+ * @include: gdata/media/gdata-media-downloader.h
+ *
+ * #GDataMediaDownloader downloads many #GDataMediaThumbnail<!-- -->s and #GDataMediaContent<!-- -->s at once, such as all the thumbnails
+ * needed to show a gallery of #GDataPicasaWebFile<!-- -->s. Unlike gdata_media_thumbnail_download(), which uses a separate network thread for
+ * each download, the downloads are shared between at most #GDataMediaDownloader:max-connections threads, each making one request at a time
+ * through the #GDataService's session.
+ *
+ * Items to download are added using gdata_media_downloader_add_thumbnail() and gdata_media_downloader_add_content(), each with an optional
+ * #GOutputStream to write the downloaded data to. Items with the same URI are only downloaded once, with the data written to each of their
+ * streams. Thumbnails are downloaded before content, and smaller items before larger ones, so that something can be shown to the user as
+ * soon as possible.
+ *
+ * If #GDataMediaDownloader:cache-directory is set, each downloaded item is also stored in that directory, and items already stored there are
+ * read from it rather than downloaded again.
+ *
+ * gdata_media_downloader_run() downloads all the items added since the previous run, emitting #GDataMediaDownloader::item-completed as each
+ * item finishes.
+ *
+ * <example>
+ * 	<title>Downloading Thumbnails for a Gallery</title>
+ * 	<programlisting>
+ *	static void
+ *	item_completed_cb (GDataMediaDownloader *downloader, GObject *media, GFile *file, const GError *error, gpointer user_data)
+ *	{
+ *		if (error != NULL) {
+ *			g_warning ("Error downloading thumbnail ‘%s’: %s", gdata_media_thumbnail_get_uri (GDATA_MEDIA_THUMBNAIL (media)),
+ *			           error->message);
+ *			return;
+ *		}
+ *
+ *		/<!-- -->* Queue loading the thumbnail from file in the UI here *<!-- -->/
+ *	}
+ *
+ *	GDataMediaDownloader *downloader;
+ *	GFile *cache_directory;
+ *	GList *i;
+ *	GError *error = NULL;
+ *
+ *	downloader = gdata_media_downloader_new (GDATA_SERVICE (service), 4);
+ *	cache_directory = g_file_new_for_path ("/home/user/.cache/my-application/thumbnails");
+ *	gdata_media_downloader_set_cache_directory (downloader, cache_directory);
+ *	g_object_unref (cache_directory);
+ *
+ *	g_signal_connect (downloader, "item-completed", (GCallback) item_completed_cb, NULL);
+ *
+ *	for (i = gdata_feed_get_entries (feed); i != NULL; i = i->next) {
+ *		GList *thumbnails = gdata_picasaweb_file_get_thumbnails (GDATA_PICASAWEB_FILE (i->data));
+ *
+ *		if (thumbnails != NULL)
+ *			gdata_media_downloader_add_thumbnail (downloader, GDATA_MEDIA_THUMBNAIL (thumbnails->data), NULL);
+ *	}
+ *
+ *	gdata_media_downloader_run (downloader, NULL, &error);
+ *
+ *	if (error != NULL) {
+ *		g_warning ("Error downloading thumbnails: %s", error->message);
+ *		g_error_free (error);
+ *	}
+ *
+ *	g_object_unref (downloader);
+ * 	</programlisting>
+ * </example>
+ *
+ * Since: 0.17.9
+ */
+
+#include <config.h>
+#include <glib.h>
+#include <glib/gi18n-lib.h>
+#include <libsoup/soup.h>
+
+#include "gdata-media-downloader.h"
+#include "gdata-marshal.h"
+#include "gdata-private.h"
+
+/* Size of the buffer used to copy items out of the cache */
+#define COPY_BUFFER_SIZE 8192
+
+typedef struct {
+	GObject *media; /* GDataMediaThumbnail or GDataMediaContent */
+	GOutputStream *sink; /* owned; may be NULL */
+} DownloadItem;
+
+typedef struct {
+	gchar *uri;
+	GPtrArray *items; /* DownloadItem; all with the same URI */
+
+	/* Priority */
+	gboolean is_thumbnail;
+	guint64 size; /* pixels for thumbnails, bytes for content; 0 if unknown */
+	guint sequence; /* order the download was added in */
+
+	/* Set for the duration of a run; not owned */
+	GDataService *service;
+	GCancellable *cancellable;
+
+	/* State of a run */
+	GFile *cache_file; /* owned; NULL if there's no cache directory */
+	GOutputStream *cache_stream; /* owned; non-NULL while writing the downloaded data to the cache */
+	gboolean cached; /* whether the data is in cache_file once the download's finished */
+	guint64 bytes_written; /* to the sinks, so that data isn't written twice if the request is retried */
+	guint64 bytes_received; /* in the current attempt */
+	GError *error;
+} Download;
+
+static void gdata_media_downloader_dispose (GObject *object);
+static void gdata_media_downloader_finalize (GObject *object);
+static void gdata_media_downloader_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+static void gdata_media_downloader_set_property (GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+
+struct _GDataMediaDownloaderPrivate {
+	GDataService *service;
+	guint max_connections;
+
+	GMutex mutex; /* protects everything below */
+	GFile *cache_directory;
+	GHashTable *downloads; /* URI → Download; those added since the last run started */
+	guint next_sequence;
+};
+
+enum {
+	PROP_SERVICE = 1,
+	PROP_MAX_CONNECTIONS,
+	PROP_CACHE_DIRECTORY,
+};
+
+enum {
+	SIGNAL_ITEM_COMPLETED,
+	LAST_SIGNAL
+};
+
+static guint downloader_signals[LAST_SIGNAL] = { 0, };
+
+G_DEFINE_TYPE (GDataMediaDownloader, gdata_media_downloader, G_TYPE_OBJECT)
+
+static void
+gdata_media_downloader_class_init (GDataMediaDownloaderClass *klass)
+{
+	GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+	g_type_class_add_private (klass, sizeof (GDataMediaDownloaderPrivate));
+
+	gobject_class->dispose = gdata_media_downloader_dispose;
+	gobject_class->finalize = gdata_media_downloader_finalize;
+	gobject_class->get_property = gdata_media_downloader_get_property;
+	gobject_class->set_property = gdata_media_downloader_set_property;
+
+	/**
+	 * GDataMediaDownloader:service:
+	 *
+	 * The service used to make the download requests.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_SERVICE,
+	                                 g_param_spec_object ("service",
+	                                                      "Service", "The service used to make the download requests.",
+	                                                      GDATA_TYPE_SERVICE,
+	                                                      G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataMediaDownloader:max-connections:
+	 *
+	 * The maximum number of downloads to make at once.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_MAX_CONNECTIONS,
+	                                 g_param_spec_uint ("max-connections",
+	                                                    "Maximum connections", "The maximum number of downloads to make at once.",
+	                                                    1, G_MAXUINT, 4,
+	                                                    G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataMediaDownloader:cache-directory:
+	 *
+	 * A directory to store downloaded items in, and to read previously downloaded items from rather than downloading them again. Each item
+	 * is stored in a file named after the SHA-256 checksum of its URI. The directory is created when the downloader is next run, if it
+	 * doesn't already exist.
+	 *
+	 * If this is %NULL, items are only written to the streams they were added with.
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_CACHE_DIRECTORY,
+	                                 g_param_spec_object ("cache-directory",
+	                                                      "Cache directory", "A directory to store downloaded items in.",
+	                                                      G_TYPE_FILE,
+	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/**
+	 * GDataMediaDownloader::item-completed:
+	 * @self: a #GDataMediaDownloader
+	 * @media: the #GDataMediaThumbnail or #GDataMediaContent which has finished downloading
+	 * @file: (allow-none): the file in #GDataMediaDownloader:cache-directory holding the item's data, or %NULL
+	 * @error: (allow-none): the error which caused the download to fail, or %NULL if it succeeded
+	 *
+	 * Emitted once for each item added to the downloader, when it has finished downloading (or failed to). If several items with the same
+	 * URI were added, it is emitted for each of them, in the order they were added. By the time the signal is emitted, all the item's data
+	 * has been written to the stream it was added with, but the stream hasn't been closed.
+	 *
+	 * @file is only set if the item's data is in #GDataMediaDownloader:cache-directory, and may be used after the signal emission.
+	 *
+	 * The signal is emitted in the thread which is running the downloader, which will not be the main thread if
+	 * gdata_media_downloader_run_async() was used, so handlers must be thread safe.
+	 *
+	 * Since: 0.17.9
+	 */
+	downloader_signals[SIGNAL_ITEM_COMPLETED] = g_signal_new ("item-completed",
+	                                                          G_TYPE_FROM_CLASS (klass),
+	                                                          G_SIGNAL_RUN_LAST,
+	                                                          0, NULL, NULL,
+	                                                          gdata_marshal_VOID__OBJECT_OBJECT_BOXED,
+	                                                          G_TYPE_NONE, 3, G_TYPE_OBJECT, G_TYPE_FILE, G_TYPE_ERROR);
+}
+
+static void
+download_item_free (DownloadItem *item)
+{
+	g_object_unref (item->media);
+	if (item->sink != NULL)
+		g_object_unref (item->sink);
+	g_slice_free (DownloadItem, item);
+}
+
+static void
+download_free (Download *download)
+{
+	g_assert (download->cache_stream == NULL);
+
+	g_clear_error (&download->error);
+	g_clear_object (&download->cache_file);
+	g_ptr_array_unref (download->items);
+	g_free (download->uri);
+	g_slice_free (Download, download);
+}
+
+static void
+gdata_media_downloader_init (GDataMediaDownloader *self)
+{
+	self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self, GDATA_TYPE_MEDIA_DOWNLOADER, GDataMediaDownloaderPrivate);
+
+	g_mutex_init (&(self->priv->mutex));
+	self->priv->downloads = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) download_free);
+}
+
+static void
+gdata_media_downloader_dispose (GObject *object)
+{
+	GDataMediaDownloaderPrivate *priv = GDATA_MEDIA_DOWNLOADER (object)->priv;
+
+	g_hash_table_remove_all (priv->downloads);
+	g_clear_object (&priv->cache_directory);
+	g_clear_object (&priv->service);
+
+	/* Chain up to the parent class */
+	G_OBJECT_CLASS (gdata_media_downloader_parent_class)->dispose (object);
+}
+
+static void
+gdata_media_downloader_finalize (GObject *object)
+{
+	GDataMediaDownloaderPrivate *priv = GDATA_MEDIA_DOWNLOADER (object)->priv;
+
+	g_hash_table_unref (priv->downloads);
+	g_mutex_clear (&(priv->mutex));
+
+	/* Chain up to the parent class */
+	G_OBJECT_CLASS (gdata_media_downloader_parent_class)->finalize (object);
+}
+
+static void
+gdata_media_downloader_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+	GDataMediaDownloaderPrivate *priv = GDATA_MEDIA_DOWNLOADER (object)->priv;
+
+	switch (property_id) {
+		case PROP_SERVICE:
+			g_value_set_object (value, priv->service);
+			break;
+		case PROP_MAX_CONNECTIONS:
+			g_value_set_uint (value, priv->max_connections);
+			break;
+		case PROP_CACHE_DIRECTORY:
+			g_mutex_lock (&(priv->mutex));
+			g_value_set_object (value, priv->cache_directory);
+			g_mutex_unlock (&(priv->mutex));
+			break;
+		default:
+			/* We don't have any other property... */
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+			break;
+	}
+}
+
+static void
+gdata_media_downloader_set_property (GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+	GDataMediaDownloader *self = GDATA_MEDIA_DOWNLOADER (object);
+
+	switch (property_id) {
+		/* Construct only */
+		case PROP_SERVICE:
+			self->priv->service = g_value_dup_object (value);
+			break;
+		/* Construct only */
+		case PROP_MAX_CONNECTIONS:
+			self->priv->max_connections = g_value_get_uint (value);
+			break;
+		case PROP_CACHE_DIRECTORY:
+			gdata_media_downloader_set_cache_directory (self, g_value_get_object (value));
+			break;
+		default:
+			/* We don't have any other property... */
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+			break;
+	}
+}
+
+/**
+ * gdata_media_downloader_new:
+ * @service: the #GDataService to make the download requests using
+ * @max_connections: the maximum number of downloads to make at once, which must be at least 1
+ *
+ * Creates a new #GDataMediaDownloader, with no items to download and no cache directory.
+ *
+ * Return value: (transfer full): a new #GDataMediaDownloader; unref with g_object_unref()
+ *
+ * Since: 0.17.9
+ */
+GDataMediaDownloader *
+gdata_media_downloader_new (GDataService *service, guint max_connections)
+{
+	g_return_val_if_fail (GDATA_IS_SERVICE (service), NULL);
+	g_return_val_if_fail (max_connections > 0, NULL);
+
+	return g_object_new (GDATA_TYPE_MEDIA_DOWNLOADER, "service", service, "max-connections", max_connections, NULL);
+}
+
+/**
+ * gdata_media_downloader_get_service:
+ * @self: a #GDataMediaDownloader
+ *
+ * Gets the #GDataMediaDownloader:service property.
+ *
+ * Return value: (transfer none): the service used to make the download requests
+ *
+ * Since: 0.17.9
+ */
+GDataService *
+gdata_media_downloader_get_service (GDataMediaDownloader *self)
+{
+	g_return_val_if_fail (GDATA_IS_MEDIA_DOWNLOADER (self), NULL);
+	return self->priv->service;
+}
+
+/**
+ * gdata_media_downloader_get_max_connections:
+ * @self: a #GDataMediaDownloader
+ *
+ * Gets the #GDataMediaDownloader:max-connections property.
+ *
+ * Return value: the maximum number of downloads made at once
+ *
+ * Since: 0.17.9
+ */
+guint
+gdata_media_downloader_get_max_connections (GDataMediaDownloader *self)
+{
+	g_return_val_if_fail (GDATA_IS_MEDIA_DOWNLOADER (self), 0);
+	return self->priv->max_connections;
+}
+
+/**
+ * gdata_media_downloader_get_cache_directory:
+ * @self: a #GDataMediaDownloader
+ *
+ * Gets the #GDataMediaDownloader:cache-directory property.
+ *
+ * Return value: (transfer none) (allow-none): the directory downloaded items are stored in, or %NULL
+ *
+ * Since: 0.17.9
+ */
+GFile *
+gdata_media_downloader_get_cache_directory (GDataMediaDownloader *self)
+{
+	g_return_val_if_fail (GDATA_IS_MEDIA_DOWNLOADER (self), NULL);
+	return self->priv->cache_directory;
+}
+
+/**
+ * gdata_media_downloader_set_cache_directory:
+ * @self: a #GDataMediaDownloader
+ * @cache_directory: (allow-none): a directory to store downloaded items in, or %NULL
+ *
+ * Sets the #GDataMediaDownloader:cache-directory property to @cache_directory. The change takes effect from the next run of the downloader.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_media_downloader_set_cache_directory (GDataMediaDownloader *self, GFile *cache_directory)
+{
+	GFile *old_cache_directory;
+
+	g_return_if_fail (GDATA_IS_MEDIA_DOWNLOADER (self));
+	g_return_if_fail (cache_directory == NULL || G_IS_FILE (cache_directory));
+
+	if (cache_directory != NULL)
+		g_object_ref (cache_directory);
+
+	g_mutex_lock (&(self->priv->mutex));
+	old_cache_directory = self->priv->cache_directory;
+	self->priv->cache_directory = cache_directory;
+	g_mutex_unlock (&(self->priv->mutex));
+
+	if (old_cache_directory != NULL)
+		g_object_unref (old_cache_directory);
+
+	g_object_notify (G_OBJECT (self), "cache-directory");
+}
+
+/**
+ * gdata_media_downloader_get_n_pending:
+ * @self: a #GDataMediaDownloader
+ *
+ * Gets the number of distinct URIs which will be downloaded by the next run of the downloader. Items with the same URI are only counted once.
+ *
+ * Return value: the number of downloads waiting to be run
+ *
+ * Since: 0.17.9
+ */
+guint
+gdata_media_downloader_get_n_pending (GDataMediaDownloader *self)
+{
+	guint n_pending;
+
+	g_return_val_if_fail (GDATA_IS_MEDIA_DOWNLOADER (self), 0);
+
+	g_mutex_lock (&(self->priv->mutex));
+	n_pending = g_hash_table_size (self->priv->downloads);
+	g_mutex_unlock (&(self->priv->mutex));
+
+	return n_pending;
+}
+
+static gint
+compare_downloads (const Download *a, const Download *b)
+{
+	/* Thumbnails go first, as they're what gets something in front of the user */
+	if (a->is_thumbnail != b->is_thumbnail)
+		return (a->is_thumbnail == TRUE) ? -1 : 1;
+
+	/* Then smaller items, with those of unknown size last */
+	if (a->size != b->size) {
+		if (a->size == 0)
+			return 1;
+		else if (b->size == 0)
+			return -1;
+
+		return (a->size < b->size) ? -1 : 1;
+	}
+
+	/* Otherwise, keep the order they were added in */
+	return (a->sequence < b->sequence) ? -1 : (a->sequence > b->sequence) ? 1 : 0;
+}
+
+static gint
+compare_download_pointers (gconstpointer a, gconstpointer b)
+{
+	return compare_downloads (*((const Download**) a), *((const Download**) b));
+}
+
+static void
+add_item (GDataMediaDownloader *self, GObject *media, const gchar *uri, gboolean is_thumbnail, guint64 size, GOutputStream *sink)
+{
+	GDataMediaDownloaderPrivate *priv = self->priv;
+	DownloadItem *item;
+	Download *download;
+
+	item = g_slice_new (DownloadItem);
+	item->media = g_object_ref (media);
+	item->sink = (sink != NULL) ? g_object_ref (sink) : NULL;
+
+	g_mutex_lock (&(priv->mutex));
+
+	download = g_hash_table_lookup (priv->downloads, uri);
+
+	if (download == NULL) {
+		download = g_slice_new0 (Download);
+		download->uri = g_strdup (uri);
+		download->items = g_ptr_array_new_with_free_func ((GDestroyNotify) download_item_free);
+		download->is_thumbnail = is_thumbnail;
+		download->size = size;
+		download->sequence = priv->next_sequence++;
+
+		g_hash_table_insert (priv->downloads, download->uri, download);
+	} else {
+		Download key = { NULL, };
+
+		/* The URI's already queued, so give the download the higher of the two items' priorities */
+		key.is_thumbnail = is_thumbnail;
+		key.size = size;
+		key.sequence = download->sequence;
+
+		if (compare_downloads (&key, download) < 0) {
+			download->is_thumbnail = is_thumbnail;
+			download->size = size;
+		}
+	}
+
+	g_ptr_array_add (download->items, item);
+
+	g_mutex_unlock (&(priv->mutex));
+}
+
+/**
+ * gdata_media_downloader_add_thumbnail:
+ * @self: a #GDataMediaDownloader
+ * @thumbnail: the #GDataMediaThumbnail to download
+ * @sink: (allow-none): a #GOutputStream to write the thumbnail's data to, or %NULL
+ *
+ * Adds @thumbnail to the items to be downloaded by the next run of the downloader. Its data will be written to @sink, if given, which will not
+ * be closed by the downloader. If @sink is %NULL, #GDataMediaDownloader:cache-directory should be set so that the data isn't just discarded.
+ *
+ * If the same thumbnail or another item with the same URI has already been added, the URI is only downloaded once.
+ *
+ * Thumbnails are downloaded before any #GDataMediaContent<!-- -->s, in increasing order of their size.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_media_downloader_add_thumbnail (GDataMediaDownloader *self, GDataMediaThumbnail *thumbnail, GOutputStream *sink)
+{
+	const gchar *uri;
+
+	g_return_if_fail (GDATA_IS_MEDIA_DOWNLOADER (self));
+	g_return_if_fail (GDATA_IS_MEDIA_THUMBNAIL (thumbnail));
+	g_return_if_fail (sink == NULL || G_IS_OUTPUT_STREAM (sink));
+
+	uri = gdata_media_thumbnail_get_uri (thumbnail);
+	g_return_if_fail (uri != NULL);
+
+	add_item (self, G_OBJECT (thumbnail), uri, TRUE,
+	          (guint64) gdata_media_thumbnail_get_width (thumbnail) * gdata_media_thumbnail_get_height (thumbnail), sink);
+}
+
+/**
+ * gdata_media_downloader_add_content:
+ * @self: a #GDataMediaDownloader
+ * @content: the #GDataMediaContent to download
+ * @sink: (allow-none): a #GOutputStream to write the content's data to, or %NULL
+ *
+ * Adds @content to the items to be downloaded by the next run of the downloader. Its data will be written to @sink, if given, which will not be
+ * closed by the downloader. If @sink is %NULL, #GDataMediaDownloader:cache-directory should be set so that the data isn't just discarded.
+ *
+ * If the same content or another item with the same URI has already been added, the URI is only downloaded once.
+ *
+ * Content is downloaded after any #GDataMediaThumbnail<!-- -->s, in increasing order of #GDataMediaContent:filesize, with content of unknown
+ * size last.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_media_downloader_add_content (GDataMediaDownloader *self, GDataMediaContent *content, GOutputStream *sink)
+{
+	const gchar *uri;
+
+	g_return_if_fail (GDATA_IS_MEDIA_DOWNLOADER (self));
+	g_return_if_fail (GDATA_IS_MEDIA_CONTENT (content));
+	g_return_if_fail (sink == NULL || G_IS_OUTPUT_STREAM (sink));
+
+	uri = gdata_media_content_get_uri (content);
+	g_return_if_fail (uri != NULL);
+
+	add_item (self, G_OBJECT (content), uri, FALSE, gdata_media_content_get_filesize (content), sink);
+}
+
+static void
+abort_cache_stream (Download *download)
+{
+	GCancellable *cancellable;
+
+	if (download->cache_stream == NULL)
+		return;
+
+	/* Closing a g_file_replace() stream with a cancelled cancellable discards the partially written file, leaving any old one alone */
+	cancellable = g_cancellable_new ();
+	g_cancellable_cancel (cancellable);
+	g_output_stream_close (download->cache_stream, cancellable, NULL);
+	g_object_unref (cancellable);
+
+	g_clear_object (&download->cache_stream);
+}
+
+static gboolean
+write_to_sinks (Download *download, const gchar *data, gsize length, GError **error)
+{
+	guint i;
+
+	for (i = 0; i < download->items->len; i++) {
+		DownloadItem *item = g_ptr_array_index (download->items, i);
+
+		if (item->sink != NULL && g_output_stream_write_all (item->sink, data, length, NULL, download->cancellable, error) == FALSE)
+			return FALSE;
+	}
+
+	download->bytes_written += length;
+
+	/* Failing to write to the cache isn't fatal; the item just won't be cached */
+	if (download->cache_stream != NULL &&
+	    g_output_stream_write_all (download->cache_stream, data, length, NULL, download->cancellable, NULL) == FALSE) {
+		g_debug ("Error writing ‘%s’ to the media cache; not caching it.", download->uri);
+		abort_cache_stream (download);
+	}
+
+	return TRUE;
+}
+
+static gboolean
+has_sinks (Download *download)
+{
+	guint i;
+
+	for (i = 0; i < download->items->len; i++) {
+		if (((DownloadItem*) g_ptr_array_index (download->items, i))->sink != NULL)
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+/* Returns TRUE if the item was in the cache, in which case download->error is set if copying it to the sinks failed */
+static gboolean
+load_from_cache (Download *download)
+{
+	GFileInputStream *input_stream;
+	gchar buffer[COPY_BUFFER_SIZE];
+	gssize length;
+
+	if (download->cache_file == NULL)
+		return FALSE;
+
+	input_stream = g_file_read (download->cache_file, download->cancellable, NULL);
+	if (input_stream == NULL)
+		return FALSE;
+
+	download->cached = TRUE;
+
+	while (has_sinks (download) == TRUE) {
+		length = g_input_stream_read (G_INPUT_STREAM (input_stream), buffer, sizeof (buffer), download->cancellable, &download->error);
+
+		if (length <= 0 || write_to_sinks (download, buffer, length, &download->error) == FALSE)
+			break;
+	}
+
+	g_input_stream_close (G_INPUT_STREAM (input_stream), NULL, NULL);
+	g_object_unref (input_stream);
+
+	return TRUE;
+}
+
+static void
+got_headers_cb (SoupMessage *message, Download *download)
+{
+	/* Keep the body of error responses so they can be parsed, but stream successful ones straight to the sinks */
+	soup_message_body_set_accumulate (message->response_body, SOUP_STATUS_IS_SUCCESSFUL (message->status_code) == FALSE);
+	download->bytes_received = 0;
+}
+
+static void
+got_chunk_cb (SoupMessage *message, SoupBuffer *buffer, Download *download)
+{
+	gsize offset = 0;
+
+	/* Ignore the chunk if the response is unsuccessful or it has zero length */
+	if (SOUP_STATUS_IS_SUCCESSFUL (message->status_code) == FALSE || buffer->length == 0 || download->error != NULL)
+		return;
+
+	/* If this is a retry, skip the data which was written to the sinks by earlier attempts */
+	if (download->bytes_received < download->bytes_written)
+		offset = MIN (buffer->length, download->bytes_written - download->bytes_received);
+
+	download->bytes_received += buffer->length;
+
+	if (offset < buffer->length && write_to_sinks (download, buffer->data + offset, buffer->length - offset, &download->error) == FALSE) {
+		/* No point downloading the rest of the data */
+		soup_session_cancel_message (_gdata_service_get_session (download->service), message, SOUP_STATUS_CANCELLED);
+	}
+}
+
+static void
+download_from_network (Download *download)
+{
+	SoupMessage *message;
+	guint status;
+	GError *child_error = NULL;
+
+	/* Write the data to the cache as well, if we have one. Errors aren't fatal, as the cache is only an optimisation. */
+	if (download->cache_file != NULL) {
+		download->cache_stream = G_OUTPUT_STREAM (g_file_replace (download->cache_file, NULL, FALSE, G_FILE_CREATE_PRIVATE,
+		                                                          download->cancellable, &child_error));
+
+		if (child_error != NULL) {
+			g_debug ("Error opening media cache file for ‘%s’: %s", download->uri, child_error->message);
+			g_clear_error (&child_error);
+		}
+	}
+
+	message = _gdata_service_build_message (download->service, NULL, SOUP_METHOD_GET, download->uri, NULL, FALSE);
+
+	g_signal_connect (message, "got-headers", (GCallback) got_headers_cb, download);
+	g_signal_connect (message, "got-chunk", (GCallback) got_chunk_cb, download);
+
+	status = _gdata_service_send_message (download->service, message, download->cancellable, &child_error);
+
+	if (download->error != NULL) {
+		/* Writing to a sink failed, and we cancelled the message */
+		g_clear_error (&child_error);
+	} else if (status == SOUP_STATUS_NONE || status == SOUP_STATUS_CANCELLED) {
+		/* Redirect error or cancelled */
+		if (child_error == NULL && g_cancellable_set_error_if_cancelled (download->cancellable, &child_error) == FALSE)
+			g_set_error_literal (&child_error, G_IO_ERROR, G_IO_ERROR_CANCELLED, _("Operation was cancelled"));
+
+		download->error = child_error;
+	} else if (SOUP_STATUS_IS_SUCCESSFUL (status) == FALSE) {
+		/* Error */
+		GDataServiceClass *klass = GDATA_SERVICE_GET_CLASS (download->service);
+
+		g_clear_error (&child_error);
+
+		g_assert (klass->parse_error_response != NULL);
+		klass->parse_error_response (download->service, GDATA_OPERATION_DOWNLOAD, status, message->reason_phrase,
+		                             message->response_body->data, message->response_body->length, &download->error);
+	} else {
+		g_clear_error (&child_error);
+	}
+
+	g_signal_handlers_disconnect_by_func (message, got_chunk_cb, download);
+	g_signal_handlers_disconnect_by_func (message, got_headers_cb, download);
+	g_object_unref (message);
+
+	/* Commit the data to the cache, or throw it away if the download failed */
+	if (download->cache_stream != NULL) {
+		if (download->error == NULL && g_output_stream_close (download->cache_stream, NULL, NULL) == TRUE) {
+			download->cached = TRUE;
+			g_clear_object (&download->cache_stream);
+		} else {
+			abort_cache_stream (download);
+		}
+	}
+}
+
+static void
+download_thread_cb (Download *download, GAsyncQueue *results)
+{
+	if (g_cancellable_set_error_if_cancelled (download->cancellable, &download->error) == FALSE && load_from_cache (download) == FALSE)
+		download_from_network (download);
+
+	g_async_queue_push (results, download);
+}
+
+/**
+ * gdata_media_downloader_run:
+ * @self: a #GDataMediaDownloader
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @error: a #GError, or %NULL
+ *
+ * Downloads all the items added to the downloader since it was last run, using up to #GDataMediaDownloader:max-connections connections at
+ * once. This function blocks until all the downloads have finished. #GDataMediaDownloader::item-completed is emitted for each item as it
+ * finishes.
+ *
+ * Items added while the downloader is running are downloaded by its next run. Several runs may happen at once, each downloading different
+ * items.
+ *
+ * If any of the items fail to download, the other items are still downloaded, and the error from the first item which failed (in the order
+ * they finished) is returned. The errors for all the items are reported by #GDataMediaDownloader::item-completed.
+ *
+ * If the operation is cancelled from another thread using @cancellable, the downloads which haven't finished will fail with
+ * %G_IO_ERROR_CANCELLED, and that error will be returned.
+ *
+ * Return value: %TRUE if all the items were downloaded successfully, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_media_downloader_run (GDataMediaDownloader *self, GCancellable *cancellable, GError **error)
+{
+	GDataMediaDownloaderPrivate *priv;
+	GHashTable *downloads;
+	GFile *cache_directory;
+	GPtrArray *queue;
+	GHashTableIter iter;
+	Download *download;
+	GAsyncQueue *results;
+	GThreadPool *pool;
+	GError *child_error = NULL;
+	guint i, j;
+
+	g_return_val_if_fail (GDATA_IS_MEDIA_DOWNLOADER (self), FALSE);
+	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	priv = self->priv;
+
+	g_mutex_lock (&(priv->mutex));
+	cache_directory = (priv->cache_directory != NULL) ? g_object_ref (priv->cache_directory) : NULL;
+	g_mutex_unlock (&(priv->mutex));
+
+	/* Make sure the cache directory exists before taking the downloads, so they aren't lost if it can't be created */
+	if (cache_directory != NULL && g_file_make_directory_with_parents (cache_directory, cancellable, &child_error) == FALSE &&
+	    g_error_matches (child_error, G_IO_ERROR, G_IO_ERROR_EXISTS) == FALSE) {
+		g_propagate_error (error, child_error);
+		g_object_unref (cache_directory);
+		return FALSE;
+	}
+
+	g_clear_error (&child_error);
+
+	/* Take the downloads added so far, leaving a new table for items added while we're running */
+	g_mutex_lock (&(priv->mutex));
+	downloads = priv->downloads;
+	priv->downloads = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) download_free);
+	g_mutex_unlock (&(priv->mutex));
+
+	queue = g_ptr_array_sized_new (g_hash_table_size (downloads));
+
+	g_hash_table_iter_init (&iter, downloads);
+	while (g_hash_table_iter_next (&iter, NULL, (gpointer*) &download) == TRUE) {
+		download->service = priv->service;
+		download->cancellable = cancellable;
+
+		if (cache_directory != NULL) {
+			gchar *checksum = g_compute_checksum_for_string (G_CHECKSUM_SHA256, download->uri, -1);
+			download->cache_file = g_file_get_child (cache_directory, checksum);
+			g_free (checksum);
+		}
+
+		g_ptr_array_add (queue, download);
+	}
+
+	if (cache_directory != NULL)
+		g_object_unref (cache_directory);
+
+	/* The pool runs tasks in the order they're pushed, so push the most important ones first */
+	g_ptr_array_sort (queue, compare_download_pointers);
+
+	results = g_async_queue_new ();
+
+	if (queue->len > 0) {
+		/* A non-exclusive pool can't fail to be created */
+		pool = g_thread_pool_new ((GFunc) download_thread_cb, results, MIN (priv->max_connections, queue->len), FALSE, NULL);
+
+		for (i = 0; i < queue->len; i++)
+			g_thread_pool_push (pool, g_ptr_array_index (queue, i), NULL);
+
+		/* Report each download as it finishes */
+		for (i = 0; i < queue->len; i++) {
+			download = g_async_queue_pop (results);
+
+			for (j = 0; j < download->items->len; j++) {
+				DownloadItem *item = g_ptr_array_index (download->items, j);
+
+				g_signal_emit (self, downloader_signals[SIGNAL_ITEM_COMPLETED], 0, item->media,
+				               (download->cached == TRUE) ? download->cache_file : NULL, download->error);
+			}
+
+			if (download->error != NULL && child_error == NULL)
+				child_error = g_error_copy (download->error);
+		}
+
+		g_thread_pool_free (pool, FALSE, TRUE);
+	}
+
+	g_async_queue_unref (results);
+	g_ptr_array_unref (queue);
+	g_hash_table_unref (downloads);
+
+	if (child_error != NULL) {
+		g_propagate_error (error, child_error);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+static void
+run_thread (GSimpleAsyncResult *result, GDataMediaDownloader *self, GCancellable *cancellable)
+{
+	GError *error = NULL;
+
+	/* Run the downloader and return */
+	if (gdata_media_downloader_run (self, cancellable, &error) == FALSE)
+		g_simple_async_result_take_error (result, error);
+}
+
+/**
+ * gdata_media_downloader_run_async:
+ * @self: a #GDataMediaDownloader
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @callback: a #GAsyncReadyCallback to call when the downloads are finished, or %NULL
+ * @user_data: (closure): data to pass to the @callback function
+ *
+ * Downloads all the items added to the downloader since it was last run, asynchronously. @self is reffed when this function is called, so can
+ * safely be unreffed after this function returns.
+ *
+ * For more details, see gdata_media_downloader_run(), which is the synchronous version of this function.
+ *
+ * When the downloads are finished, @callback will be called. You can then call gdata_media_downloader_run_finish() to get the result of the
+ * operation.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_media_downloader_run_async (GDataMediaDownloader *self, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data)
+{
+	GSimpleAsyncResult *result;
+
+	g_return_if_fail (GDATA_IS_MEDIA_DOWNLOADER (self));
+	g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+
+	result = g_simple_async_result_new (G_OBJECT (self), callback, user_data, gdata_media_downloader_run_async);
+	g_simple_async_result_run_in_thread (result, (GSimpleAsyncThreadFunc) run_thread, G_PRIORITY_DEFAULT, cancellable);
+	g_object_unref (result);
+}
+
+/**
+ * gdata_media_downloader_run_finish:
+ * @self: a #GDataMediaDownloader
+ * @async_result: a #GAsyncResult
+ * @error: a #GError, or %NULL
+ *
+ * Finishes an asynchronous run of the downloader started with gdata_media_downloader_run_async().
+ *
+ * Return value: %TRUE if all the items were downloaded successfully, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_media_downloader_run_finish (GDataMediaDownloader *self, GAsyncResult *async_result, GError **error)
+{
+	g_return_val_if_fail (GDATA_IS_MEDIA_DOWNLOADER (self), FALSE);
+	g_return_val_if_fail (G_IS_ASYNC_RESULT (async_result), FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	g_warn_if_fail (g_simple_async_result_get_source_tag (G_SIMPLE_ASYNC_RESULT (async_result)) == gdata_media_downloader_run_async);
+
+	return !g_simple_async_result_propagate_error (G_SIMPLE_ASYNC_RESULT (async_result), error);
+}
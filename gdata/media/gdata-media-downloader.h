@@ -0,0 +1,94 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ * Copyright (C) Philip Withnall 2017 <philip@tecnocode.co.uk>
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GDATA_MEDIA_DOWNLOADER_H
+#define GDATA_MEDIA_DOWNLOADER_H
+
+#include <glib.h>
+#include <glib-object.h>
+#include <gio/gio.h>
+
+#include <gdata/gdata-service.h>
+#include <gdata/media/gdata-media-content.h>
+#include <gdata/media/gdata-media-thumbnail.h>
+
+G_BEGIN_DECLS
+
+#define GDATA_TYPE_MEDIA_DOWNLOADER		(gdata_media_downloader_get_type ())
+#define GDATA_MEDIA_DOWNLOADER(o)		(G_TYPE_CHECK_INSTANCE_CAST ((o), GDATA_TYPE_MEDIA_DOWNLOADER, GDataMediaDownloader))
+#define GDATA_MEDIA_DOWNLOADER_CLASS(k)		(G_TYPE_CHECK_CLASS_CAST((k), GDATA_TYPE_MEDIA_DOWNLOADER, GDataMediaDownloaderClass))
+#define GDATA_IS_MEDIA_DOWNLOADER(o)		(G_TYPE_CHECK_INSTANCE_TYPE ((o), GDATA_TYPE_MEDIA_DOWNLOADER))
+#define GDATA_IS_MEDIA_DOWNLOADER_CLASS(k)	(G_TYPE_CHECK_CLASS_TYPE ((k), GDATA_TYPE_MEDIA_DOWNLOADER))
+#define GDATA_MEDIA_DOWNLOADER_GET_CLASS(o)	(G_TYPE_INSTANCE_GET_CLASS ((o), GDATA_TYPE_MEDIA_DOWNLOADER, GDataMediaDownloaderClass))
+
+typedef struct _GDataMediaDownloaderPrivate	GDataMediaDownloaderPrivate;
+
+/**
+ * GDataMediaDownloader:
+ *
+ * All the fields in the #GDataMediaDownloader structure are private and should never be accessed directly.
+ *
+ * Since: 0.17.9
+ */
+typedef struct {
+	GObject parent;
+	GDataMediaDownloaderPrivate *priv;
+} GDataMediaDownloader;
+
+/**
+ * GDataMediaDownloaderClass:
+ *
+ * All the fields in the #GDataMediaDownloaderClass structure are private and should never be accessed directly.
+ *
+ * Since: 0.17.9
+ */
+typedef struct {
+	/*< private >*/
+	GObjectClass parent;
+
+	/*< private >*/
+	/* Padding for future expansion */
+	void (*_g_reserved0) (void);
+	void (*_g_reserved1) (void);
+	void (*_g_reserved2) (void);
+	void (*_g_reserved3) (void);
+	void (*_g_reserved4) (void);
+	void (*_g_reserved5) (void);
+} GDataMediaDownloaderClass;
+
+GType gdata_media_downloader_get_type (void) G_GNUC_CONST;
+
+GDataMediaDownloader *gdata_media_downloader_new (GDataService *service, guint max_connections) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+
+GDataService *gdata_media_downloader_get_service (GDataMediaDownloader *self) G_GNUC_PURE;
+guint gdata_media_downloader_get_max_connections (GDataMediaDownloader *self) G_GNUC_PURE;
+GFile *gdata_media_downloader_get_cache_directory (GDataMediaDownloader *self) G_GNUC_PURE;
+void gdata_media_downloader_set_cache_directory (GDataMediaDownloader *self, GFile *cache_directory);
+guint gdata_media_downloader_get_n_pending (GDataMediaDownloader *self);
+
+void gdata_media_downloader_add_thumbnail (GDataMediaDownloader *self, GDataMediaThumbnail *thumbnail, GOutputStream *sink);
+void gdata_media_downloader_add_content (GDataMediaDownloader *self, GDataMediaContent *content, GOutputStream *sink);
+
+gboolean gdata_media_downloader_run (GDataMediaDownloader *self, GCancellable *cancellable, GError **error);
+void gdata_media_downloader_run_async (GDataMediaDownloader *self, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data);
+gboolean gdata_media_downloader_run_finish (GDataMediaDownloader *self, GAsyncResult *async_result, GError **error);
+
+G_END_DECLS
+
+#endif /* !GDATA_MEDIA_DOWNLOADER_H */
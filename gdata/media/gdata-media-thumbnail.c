@@ -43,6 +43,8 @@ static void gdata_media_thumbnail_finalize (GObject *object);
 static void gdata_media_thumbnail_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 static gboolean pre_parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *root_node, gpointer user_data, GError **error);
 static void get_namespaces (GDataParsable *parsable, GHashTable *namespaces);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 static gboolean
 parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data,
             GError **error);
@@ -139,6 +141,8 @@ gdata_media_thumbnail_class_init (GDataMediaThumbnailClass *klass)
 	                                                     "Time", "The time offset of the thumbnail in relation to the media object, in ms.",
 	                                                     -1, G_MAXINT64, -1,
 	                                                     G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static void
@@ -327,6 +331,28 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data,
 	}
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	GDataMediaThumbnailPrivate *priv = GDATA_MEDIA_THUMBNAIL (parsable)->priv;
+
+	gdata_binary_writer_put_string (writer, priv->uri);
+	gdata_binary_writer_put_uint (writer, priv->height);
+	gdata_binary_writer_put_uint (writer, priv->width);
+	gdata_binary_writer_put_int (writer, priv->time);
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	GDataMediaThumbnailPrivate *priv = GDATA_MEDIA_THUMBNAIL (parsable)->priv;
+
+	priv->uri = gdata_binary_reader_dup_string (reader);
+	priv->height = gdata_binary_reader_get_uint (reader);
+	priv->width = gdata_binary_reader_get_uint (reader);
+	priv->time = gdata_binary_reader_get_int (reader);
+}
+
 /**
  * gdata_media_thumbnail_get_uri:
  * @self: a #GDataMediaThumbnail
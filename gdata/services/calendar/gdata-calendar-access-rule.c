@@ -65,6 +65,8 @@ gdata_calendar_access_rule_class_init (GDataCalendarAccessRuleClass *klass)
 	parsable_class->get_content_type = get_content_type;
 
 	entry_class->kind_term = "calendar#aclRule";
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static void
@@ -95,6 +95,8 @@ static void gdata_calendar_calendar_set_property (GObject *object, guint propert
 static void get_json (GDataParsable *parsable, JsonBuilder *builder);
 static gboolean parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GError **error);
 static const gchar *get_content_type (void);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 
 struct _GDataCalendarCalendarPrivate {
 	gchar *timezone;
@@ -239,6 +241,16 @@ gdata_calendar_calendar_class_init (GDataCalendarCalendarClass *klass)
 
 	/* Override the ETag property since ETags don't seem to be supported for calendars. */
 	g_object_class_override_property (gobject_class, PROP_ETAG, "etag");
+
+	/* Members to send in partial updates when the properties change */
+	_gdata_parsable_class_set_patch_name (parsable_class, "title", "summary");
+	_gdata_parsable_class_set_patch_name (parsable_class, "summary", "description");
+	_gdata_parsable_class_set_patch_name (parsable_class, "timezone", "timeZone");
+	_gdata_parsable_class_set_patch_name (parsable_class, "is-hidden", "hidden");
+	_gdata_parsable_class_set_patch_name (parsable_class, "color", "backgroundColor");
+	_gdata_parsable_class_set_patch_name (parsable_class, "is-selected", "selected");
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static gboolean
@@ -291,6 +303,7 @@ get_rules (GDataAccessHandler *self,
 	                                  message->response_body->data,
 	                                  message->response_body->length,
 	                                  GDATA_TYPE_CALENDAR_ACCESS_RULE,
+	                                  NULL,
 	                                  progress_callback, progress_user_data,
 	                                  error);
 
@@ -607,6 +620,18 @@ get_content_type (void)
 	return "application/json";
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	gdata_binary_writer_put_string (writer, GDATA_CALENDAR_CALENDAR (parsable)->priv->access_level);
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	GDATA_CALENDAR_CALENDAR (parsable)->priv->access_level = gdata_binary_reader_dup_string (reader);
+}
+
 /**
  * gdata_calendar_calendar_new:
  * @id: (allow-none): the calendar's ID, or %NULL
@@ -653,6 +678,7 @@ gdata_calendar_calendar_set_timezone (GDataCalendarCalendar *self, const gchar *
 
 	g_free (self->priv->timezone);
 	self->priv->timezone = g_strdup (_timezone);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "timezone");
 	g_object_notify (G_OBJECT (self), "timezone");
 }
 
@@ -704,6 +730,7 @@ gdata_calendar_calendar_set_is_hidden (GDataCalendarCalendar *self, gboolean is_
 {
 	g_return_if_fail (GDATA_IS_CALENDAR_CALENDAR (self));
 	self->priv->is_hidden = is_hidden;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "is-hidden");
 	g_object_notify (G_OBJECT (self), "is-hidden");
 }
 
@@ -735,6 +762,7 @@ gdata_calendar_calendar_set_color (GDataCalendarCalendar *self, const GDataColor
 	g_return_if_fail (GDATA_IS_CALENDAR_CALENDAR (self));
 	g_return_if_fail (color != NULL);
 	self->priv->colour = *color;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "color");
 	g_object_notify (G_OBJECT (self), "color");
 }
 
@@ -769,6 +797,7 @@ gdata_calendar_calendar_set_is_selected (GDataCalendarCalendar *self, gboolean i
 {
 	g_return_if_fail (GDATA_IS_CALENDAR_CALENDAR (self));
 	self->priv->is_selected = is_selected;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "is-selected");
 	g_object_notify (G_OBJECT (self), "is-selected");
 }
 
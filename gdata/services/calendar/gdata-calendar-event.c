@@ -103,6 +103,8 @@ static void get_json (GDataParsable *parsable, JsonBuilder *builder);
 static gboolean parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GError **error);
 static gboolean post_parse_json (GDataParsable *parsable, gpointer user_data, GError **error);
 static const gchar *get_content_type (void);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 
 struct _GDataCalendarEventPrivate {
 	gint64 edited;
@@ -111,14 +113,15 @@ struct _GDataCalendarEventPrivate {
 	gchar *transparency;
 	gchar *uid;
 	gint64 sequence;
-	GList *times; /* GDataGDWhen */
+	GDataComparableList times; /* GDataGDWhen */
 	gboolean guests_can_modify;
 	gboolean guests_can_invite_others;
 	gboolean guests_can_see_guests;
 	gboolean anyone_can_add_self;
-	GList *people; /* GDataGDWho */
-	GList *places; /* GDataGDWhere */
+	GDataComparableList people; /* GDataGDWho */
+	GDataComparableList places; /* GDataGDWhere */
 	gchar *recurrence;
+	gchar *time_zone;  /* owned; IANA time zone of the start time, used to expand the recurrence */
 	gchar *original_event_id;
 	gchar *original_event_uri;
 	gchar *organiser_email;  /* owned */
@@ -357,6 +360,14 @@ gdata_calendar_event_class_init (GDataCalendarEventClass *klass)
 	                                                      "Original event URI", "The event URI for the original event.",
 	                                                      NULL,
 	                                                      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+	/* Members to send in partial updates when the properties change */
+	_gdata_parsable_class_set_patch_name (parsable_class, "title", "summary");
+	_gdata_parsable_class_set_patch_name (parsable_class, "summary", "description");
+	_gdata_parsable_class_set_patch_name (parsable_class, "uid", "iCalUID");
+	_gdata_parsable_class_set_patch_name (parsable_class, "guests-can-see-guests", "guestsCanSeeOtherGuests");
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static void
@@ -392,23 +403,11 @@ gdata_calendar_event_dispose (GObject *object)
 {
 	GDataCalendarEventPrivate *priv = GDATA_CALENDAR_EVENT (object)->priv;
 
-	if (priv->times != NULL) {
-		g_list_foreach (priv->times, (GFunc) g_object_unref, NULL);
-		g_list_free (priv->times);
-	}
-	priv->times = NULL;
+	_gdata_comparable_list_clear (&priv->times);
 
-	if (priv->people != NULL) {
-		g_list_foreach (priv->people, (GFunc) g_object_unref, NULL);
-		g_list_free (priv->people);
-	}
-	priv->people = NULL;
+	_gdata_comparable_list_clear (&priv->people);
 
-	if (priv->places != NULL) {
-		g_list_foreach (priv->places, (GFunc) g_object_unref, NULL);
-		g_list_free (priv->places);
-	}
-	priv->places = NULL;
+	_gdata_comparable_list_clear (&priv->places);
 
 	/* Chain up to the parent class */
 	G_OBJECT_CLASS (gdata_calendar_event_parent_class)->dispose (object);
@@ -424,6 +423,7 @@ gdata_calendar_event_finalize (GObject *object)
 	g_free (priv->transparency);
 	g_free (priv->uid);
 	g_free (priv->recurrence);
+	g_free (priv->time_zone);
 	g_free (priv->original_event_id);
 	g_free (priv->original_event_uri);
 	g_free (priv->organiser_email);
@@ -533,6 +533,7 @@ date_object_from_json (JsonReader *reader,
                        GDataParserOptions options,
                        gint64 *date_time_output,
                        gboolean *is_date_output,
+                       gchar **time_zone_output,
                        gboolean *success,
                        GError **error)
 {
@@ -616,7 +617,17 @@ date_object_from_json (JsonReader *reader,
 	}
 	json_reader_end_member (reader);
 
-	/* Ignore timeZone; it should be specified in dateTime. */
+	/* The UTC offset is specified in dateTime, but the time zone name is needed to expand recurrences. */
+	if (time_zone_output != NULL && json_reader_read_member (reader, "timeZone")) {
+		const gchar *time_zone = json_reader_get_string_value (reader);
+
+		if (time_zone != NULL && *time_zone != '\0') {
+			g_free (*time_zone_output);
+			*time_zone_output = g_strdup (time_zone);
+		}
+	}
+	json_reader_end_member (reader);
+
 	if (!found_member) {
 		*success = gdata_parser_error_required_json_content_missing (reader, error);
 		return TRUE;
@@ -687,8 +698,9 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 	    gdata_parser_string_from_json_member (reader, "iCalUID", P_DEFAULT, &self->priv->uid, &success, error) ||
 	    gdata_parser_int_from_json_member (reader, "sequence", P_DEFAULT, &self->priv->sequence, &success, error) ||
 	    gdata_parser_int64_time_from_json_member (reader, "updated", P_DEFAULT, &self->priv->edited, &success, error) ||
-	    date_object_from_json (reader, "start", P_DEFAULT, &self->priv->parser.start_time, &self->priv->parser.start_is_date, &success, error) ||
-	    date_object_from_json (reader, "end", P_DEFAULT, &self->priv->parser.end_time, &self->priv->parser.end_is_date, &success, error)) {
+	    date_object_from_json (reader, "start", P_DEFAULT, &self->priv->parser.start_time, &self->priv->parser.start_is_date,
+	                           &self->priv->time_zone, &success, error) ||
+	    date_object_from_json (reader, "end", P_DEFAULT, &self->priv->parser.end_time, &self->priv->parser.end_is_date, NULL, &success, error)) {
 		if (success) {
 			if (self->priv->edited != -1) {
 				_gdata_entry_set_updated (GDATA_ENTRY (parsable),
@@ -708,7 +720,8 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 				                          self->priv->parser.end_time,
 				                          self->priv->parser.start_is_date ||
 				                          self->priv->parser.end_is_date);
-				self->priv->times = g_list_prepend (self->priv->times, when);  /* transfer ownership */
+				_gdata_comparable_list_add (&self->priv->times, GDATA_COMPARABLE (when), TRUE);
+				g_object_unref (when);
 
 				self->priv->parser.seen_start = FALSE;
 				self->priv->parser.seen_end = FALSE;
@@ -816,7 +829,8 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 
 		where = gdata_gd_where_new (GDATA_GD_WHERE_EVENT,
 		                            location, NULL);
-		priv->places = g_list_prepend (priv->places, where);  /* transfer ownership */
+		_gdata_comparable_list_add (&priv->places, GDATA_COMPARABLE (where), TRUE);
+		g_object_unref (where);
 	} else if (g_strcmp0 (json_reader_get_member_name (reader), "created") == 0) {
 		gint64 created;
 
@@ -875,7 +889,7 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 	} else if (g_strcmp0 (json_reader_get_member_name (reader), "attendees") == 0) {
 		guint i, j;
 
-		if (priv->people != NULL) {
+		if (priv->people.list != NULL) {
 			return gdata_parser_error_duplicate_json_element (reader,
 			                                                  error);
 		}
@@ -936,7 +950,8 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 
 			who = gdata_gd_who_new (relation_type, value_string,
 			                        email_address);
-			priv->people = g_list_prepend (priv->people, who);  /* transfer ownership */
+			_gdata_comparable_list_add (&priv->people, GDATA_COMPARABLE (who), TRUE);
+			g_object_unref (who);
 
 			json_reader_end_element (reader);
 		}
@@ -1107,7 +1122,7 @@ get_json (GDataParsable *parsable, JsonBuilder *builder)
 	}
 
 	/* Times. */
-	for (l = priv->times; l != NULL; l = l->next) {
+	for (l = priv->times.list; l != NULL; l = l->next) {
 		GDataGDWhen *when;  /* unowned */
 		gchar *val = NULL;  /* owned */
 		const gchar *member_name;
@@ -1175,7 +1190,7 @@ get_json (GDataParsable *parsable, JsonBuilder *builder)
 	}
 
 	/* Locations. */
-	for (l = priv->places; l != NULL; l = l->next) {
+	for (l = priv->places.list; l != NULL; l = l->next) {
 		GDataGDWhere *where;  /* unowned */
 		const gchar *location;
 
@@ -1198,7 +1213,7 @@ get_json (GDataParsable *parsable, JsonBuilder *builder)
 	json_builder_set_member_name (builder, "attendees");
 	json_builder_begin_array (builder);
 
-	for (l = priv->people; l != NULL; l = l->next) {
+	for (l = priv->people.list; l != NULL; l = l->next) {
 		GDataGDWho *who;  /* unowned */
 		const gchar *display_name, *email_address;
 
@@ -1259,6 +1274,36 @@ get_content_type (void)
 	return "application/json";
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	GDataCalendarEventPrivate *priv = GDATA_CALENDAR_EVENT (parsable)->priv;
+
+	gdata_binary_writer_put_int (writer, priv->edited);
+	gdata_binary_writer_put_string (writer, priv->original_event_id);
+	gdata_binary_writer_put_string (writer, priv->original_event_uri);
+	gdata_binary_writer_put_string (writer, priv->time_zone);
+	gdata_binary_writer_put_string (writer, priv->organiser_email);
+	gdata_binary_writer_put_parsable_list (writer, priv->times.list);
+	gdata_binary_writer_put_parsable_list (writer, priv->people.list);
+	gdata_binary_writer_put_parsable_list (writer, priv->places.list);
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	GDataCalendarEventPrivate *priv = GDATA_CALENDAR_EVENT (parsable)->priv;
+
+	priv->edited = gdata_binary_reader_get_int (reader);
+	priv->original_event_id = gdata_binary_reader_dup_string (reader);
+	priv->original_event_uri = gdata_binary_reader_dup_string (reader);
+	priv->time_zone = gdata_binary_reader_dup_string (reader);
+	priv->organiser_email = gdata_binary_reader_dup_string (reader);
+	_gdata_comparable_list_set (&priv->times, gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_GD_WHEN));
+	_gdata_comparable_list_set (&priv->people, gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_GD_WHO));
+	_gdata_comparable_list_set (&priv->places, gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_GD_WHERE));
+}
+
 /**
  * gdata_calendar_event_new:
  * @id: (allow-none): the event's ID, or %NULL
@@ -1323,6 +1368,7 @@ gdata_calendar_event_set_status (GDataCalendarEvent *self, const gchar *status)
 
 	g_free (self->priv->status);
 	self->priv->status = g_strdup (status);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "status");
 	g_object_notify (G_OBJECT (self), "status");
 }
 
@@ -1357,6 +1403,7 @@ gdata_calendar_event_set_visibility (GDataCalendarEvent *self, const gchar *visi
 
 	g_free (self->priv->visibility);
 	self->priv->visibility = g_strdup (visibility);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "visibility");
 	g_object_notify (G_OBJECT (self), "visibility");
 }
 
@@ -1391,6 +1438,7 @@ gdata_calendar_event_set_transparency (GDataCalendarEvent *self, const gchar *tr
 
 	g_free (self->priv->transparency);
 	self->priv->transparency = g_strdup (transparency);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "transparency");
 	g_object_notify (G_OBJECT (self), "transparency");
 }
 
@@ -1426,6 +1474,7 @@ gdata_calendar_event_set_uid (GDataCalendarEvent *self, const gchar *uid)
 
 	g_free (self->priv->uid);
 	self->priv->uid = g_strdup (uid);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "uid");
 	g_object_notify (G_OBJECT (self), "uid");
 }
 
@@ -1456,6 +1505,7 @@ gdata_calendar_event_set_sequence (GDataCalendarEvent *self, guint sequence)
 {
 	g_return_if_fail (GDATA_IS_CALENDAR_EVENT (self));
 	self->priv->sequence = sequence;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "sequence");
 	g_object_notify (G_OBJECT (self), "sequence");
 }
 
@@ -1486,6 +1536,7 @@ gdata_calendar_event_set_guests_can_modify (GDataCalendarEvent *self, gboolean g
 {
 	g_return_if_fail (GDATA_IS_CALENDAR_EVENT (self));
 	self->priv->guests_can_modify = guests_can_modify;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "guests-can-modify");
 	g_object_notify (G_OBJECT (self), "guests-can-modify");
 }
 
@@ -1516,6 +1567,7 @@ gdata_calendar_event_set_guests_can_invite_others (GDataCalendarEvent *self, gbo
 {
 	g_return_if_fail (GDATA_IS_CALENDAR_EVENT (self));
 	self->priv->guests_can_invite_others = guests_can_invite_others;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "guests-can-invite-others");
 	g_object_notify (G_OBJECT (self), "guests-can-invite-others");
 }
 
@@ -1546,6 +1598,7 @@ gdata_calendar_event_set_guests_can_see_guests (GDataCalendarEvent *self, gboole
 {
 	g_return_if_fail (GDATA_IS_CALENDAR_EVENT (self));
 	self->priv->guests_can_see_guests = guests_can_see_guests;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "guests-can-see-guests");
 	g_object_notify (G_OBJECT (self), "guests-can-see-guests");
 }
 
@@ -1576,6 +1629,7 @@ gdata_calendar_event_set_anyone_can_add_self (GDataCalendarEvent *self, gboolean
 {
 	g_return_if_fail (GDATA_IS_CALENDAR_EVENT (self));
 	self->priv->anyone_can_add_self = anyone_can_add_self;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "anyone-can-add-self");
 	g_object_notify (G_OBJECT (self), "anyone-can-add-self");
 }
 
@@ -1594,8 +1648,7 @@ gdata_calendar_event_add_person (GDataCalendarEvent *self, GDataGDWho *who)
 	g_return_if_fail (GDATA_IS_CALENDAR_EVENT (self));
 	g_return_if_fail (GDATA_IS_GD_WHO (who));
 
-	if (g_list_find_custom (self->priv->people, who, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->people = g_list_append (self->priv->people, g_object_ref (who));
+	_gdata_comparable_list_add (&self->priv->people, GDATA_COMPARABLE (who), FALSE);
 }
 
 /**
@@ -1612,7 +1665,7 @@ GList *
 gdata_calendar_event_get_people (GDataCalendarEvent *self)
 {
 	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT (self), NULL);
-	return self->priv->people;
+	return self->priv->people.list;
 }
 
 /**
@@ -1630,8 +1683,7 @@ gdata_calendar_event_add_place (GDataCalendarEvent *self, GDataGDWhere *where)
 	g_return_if_fail (GDATA_IS_CALENDAR_EVENT (self));
 	g_return_if_fail (GDATA_IS_GD_WHERE (where));
 
-	if (g_list_find_custom (self->priv->places, where, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->places = g_list_append (self->priv->places, g_object_ref (where));
+	_gdata_comparable_list_add (&self->priv->places, GDATA_COMPARABLE (where), FALSE);
 }
 
 /**
@@ -1648,7 +1700,7 @@ GList *
 gdata_calendar_event_get_places (GDataCalendarEvent *self)
 {
 	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT (self), NULL);
-	return self->priv->places;
+	return self->priv->places.list;
 }
 
 /**
@@ -1676,8 +1728,7 @@ gdata_calendar_event_add_time (GDataCalendarEvent *self, GDataGDWhen *when)
 	g_return_if_fail (GDATA_IS_CALENDAR_EVENT (self));
 	g_return_if_fail (GDATA_IS_GD_WHEN (when));
 
-	if (g_list_find_custom (self->priv->times, when, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->times = g_list_append (self->priv->times, g_object_ref (when));
+	_gdata_comparable_list_add (&self->priv->times, GDATA_COMPARABLE (when), FALSE);
 }
 
 /**
@@ -1694,7 +1745,7 @@ GList *
 gdata_calendar_event_get_times (GDataCalendarEvent *self)
 {
 	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT (self), NULL);
-	return self->priv->times;
+	return self->priv->times.list;
 }
 
 /**
@@ -1721,10 +1772,10 @@ gdata_calendar_event_get_primary_time (GDataCalendarEvent *self, gint64 *start_t
 
 	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT (self), FALSE);
 
-	if (self->priv->times == NULL || self->priv->times->next != NULL)
+	if (self->priv->times.list == NULL || self->priv->times.list->next != NULL)
 		return FALSE;
 
-	primary_when = GDATA_GD_WHEN (self->priv->times->data);
+	primary_when = GDATA_GD_WHEN (self->priv->times.list->data);
 	if (start_time != NULL)
 		*start_time = gdata_gd_when_get_start_time (primary_when);
 	if (end_time != NULL)
@@ -1773,9 +1824,68 @@ gdata_calendar_event_set_recurrence (GDataCalendarEvent *self, const gchar *recu
 
 	g_free (self->priv->recurrence);
 	self->priv->recurrence = g_strdup (recurrence);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "recurrence");
 	g_object_notify (G_OBJECT (self), "recurrence");
 }
 
+/**
+ * gdata_calendar_event_expand_recurrence:
+ * @self: a #GDataCalendarEvent
+ * @window_start: the start of the time window to expand the recurrence over, as a UNIX timestamp, or <code class="literal">-1</code>
+ * @window_end: the end of the time window to expand the recurrence over, as a UNIX timestamp, or <code class="literal">-1</code>
+ * @time_zone: (allow-none): the time zone to expand the recurrence in, or %NULL to use the event's time zone
+ * @error: a #GError, or %NULL
+ *
+ * Expands the #GDataCalendarEvent:recurrence of the event locally, returning an iterator over the instances of the event which overlap the time
+ * window between @window_start and @window_end. The first instance is given by gdata_calendar_event_get_primary_time(). If the event doesn't
+ * recur, the iterator returns that single instance if it overlaps the window.
+ *
+ * This allows recurring events to be queried with #GDataCalendarQuery:single-events set to %FALSE, and expanded locally, which is much cheaper than
+ * having the server expand them. Note that modified or cancelled instances of a recurring event are still returned by the server as separate
+ * events (see gdata_calendar_event_is_exception()), and it is up to the caller to apply them to the expanded instances.
+ *
+ * If @time_zone is %NULL, the recurrence is expanded in the time zone the event's start time was given in by the server, or UTC if that isn't
+ * known. See gdata_calendar_recurrence_iter_new() for details of the errors which can be returned.
+ *
+ * Return value: (transfer full): a new #GDataCalendarRecurrenceIter, or %NULL; free with gdata_calendar_recurrence_iter_unref()
+ *
+ * Since: 0.17.9
+ */
+GDataCalendarRecurrenceIter *
+gdata_calendar_event_expand_recurrence (GDataCalendarEvent *self, gint64 window_start, gint64 window_end, GTimeZone *time_zone, GError **error)
+{
+	GDataCalendarRecurrenceIter *iter;
+	GDataGDWhen *when = NULL;
+	GTimeZone *event_time_zone = NULL;
+	gint64 start_time = -1, end_time = -1;
+
+	g_return_val_if_fail (GDATA_IS_CALENDAR_EVENT (self), NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	if (self->priv->times.list != NULL) {
+		when = GDATA_GD_WHEN (self->priv->times.list->data);
+		start_time = gdata_gd_when_get_start_time (when);
+		end_time = MAX (gdata_gd_when_get_end_time (when), start_time);
+	}
+
+	if (when == NULL || start_time == -1) {
+		g_set_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR,
+		             _("The event has no start time, so its recurrence can’t be expanded."));
+		return NULL;
+	}
+
+	if (time_zone == NULL && self->priv->time_zone != NULL)
+		event_time_zone = g_time_zone_new (self->priv->time_zone);
+
+	iter = gdata_calendar_recurrence_iter_new (self->priv->recurrence, start_time, end_time, gdata_gd_when_is_date (when),
+	                                           (time_zone != NULL) ? time_zone : event_time_zone, window_start, window_end, error);
+
+	if (event_time_zone != NULL)
+		g_time_zone_unref (event_time_zone);
+
+	return iter;
+}
+
 /**
  * gdata_calendar_event_get_original_event_details:
  * @self: a #GDataCalendarEvent
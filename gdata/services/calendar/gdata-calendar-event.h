@@ -28,6 +28,7 @@
 #include <gdata/gd/gdata-gd-when.h>
 #include <gdata/gd/gdata-gd-where.h>
 #include <gdata/gd/gdata-gd-who.h>
+#include <gdata/services/calendar/gdata-calendar-recurrence.h>
 
 G_BEGIN_DECLS
 
@@ -97,6 +98,8 @@ GList *gdata_calendar_event_get_times (GDataCalendarEvent *self) G_GNUC_PURE;
 gboolean gdata_calendar_event_get_primary_time (GDataCalendarEvent *self, gint64 *start_time, gint64 *end_time, GDataGDWhen **when);
 const gchar *gdata_calendar_event_get_recurrence (GDataCalendarEvent *self) G_GNUC_PURE;
 void gdata_calendar_event_set_recurrence (GDataCalendarEvent *self, const gchar *recurrence);
+GDataCalendarRecurrenceIter *gdata_calendar_event_expand_recurrence (GDataCalendarEvent *self, gint64 window_start, gint64 window_end,
+                                                                     GTimeZone *time_zone, GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
 void gdata_calendar_event_get_original_event_details (GDataCalendarEvent *self, gchar **event_id, gchar **event_uri);
 gboolean gdata_calendar_event_is_exception (GDataCalendarEvent *self) G_GNUC_PURE;
 
@@ -84,6 +84,8 @@ gdata_calendar_feed_class_init (GDataCalendarFeedClass *klass)
 	                                                    G_PARAM_DEPRECATED |
 	                                                    G_PARAM_READABLE |
 	                                                    G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (GDATA_PARSABLE_CLASS (klass), NULL, NULL);
 }
 
 static void
@@ -190,6 +190,9 @@ gdata_calendar_query_class_init (GDataCalendarQueryClass *klass)
 	 * GDataCalendarQuery:single-events:
 	 *
 	 * Indicates whether recurring events should be expanded or represented as a single event.
+	 *
+	 * Expanding recurring events on the server returns a separate copy of the event for each instance, which can be a lot of data for long
+	 * time ranges. If this is %FALSE, recurring events can instead be expanded locally with gdata_calendar_event_expand_recurrence().
 	 */
 	g_object_class_install_property (gobject_class, PROP_SINGLE_EVENTS,
 	                                 g_param_spec_boolean ("single-events",
@@ -459,29 +462,26 @@ get_query_uri (GDataQuery *self, const gchar *feed_uri, GString *query_uri, gboo
 		g_string_append (query_uri, "singleEvents=false");
 
 	if (priv->start_min != -1) {
-		gchar *start_min;
 		gint64 start_min_time;
 
-		if (priv->future_events)
+		if (priv->future_events) {
 			start_min_time = g_get_real_time () / G_USEC_PER_SEC;
-		else
+
+			/* The URI depends on the current time, so mustn't be cached */
+			_gdata_query_mark_uri_volatile (self);
+		} else {
 			start_min_time = priv->start_min;
+		}
 
 		APPEND_SEP
 		g_string_append (query_uri, "timeMin=");
-		start_min = gdata_parser_int64_to_iso8601 (start_min_time);
-		g_string_append (query_uri, start_min);
-		g_free (start_min);
+		gdata_parser_string_append_iso8601 (query_uri, start_min_time);
 	}
 
 	if (priv->start_max != -1 && !priv->future_events) {
-		gchar *start_max;
-
 		APPEND_SEP
 		g_string_append (query_uri, "timeMax=");
-		start_max = gdata_parser_int64_to_iso8601 (priv->start_max);
-		g_string_append (query_uri, start_max);
-		g_free (start_max);
+		gdata_parser_string_append_iso8601 (query_uri, priv->start_max);
 	}
 
 	if (priv->timezone != NULL) {
@@ -0,0 +1,1313 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ * Copyright (C) Philip Withnall 2017 <philip@tecnocode.co.uk>
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:gdata-calendar-recurrence
+ * @short_description: local expansion of recurring calendar events
+ * @stability: Stable
+ * @include: gdata/services/calendar/gdata-calendar-recurrence.h
+ *
+ * #GDataCalendarRecurrenceIter expands the iCalendar recurrence of an event (as returned by gdata_calendar_event_get_recurrence()) into the
+ * individual instances of the event which fall inside a time window. This allows the master copies of recurring events to be downloaded once (by
+ * setting #GDataCalendarQuery:single-events to %FALSE) and expanded locally for as many different windows as needed, rather than having the server
+ * send a separate copy of the event for every instance.
+ *
+ * The <code class="literal">RRULE</code>, <code class="literal">EXRULE</code>, <code class="literal">RDATE</code> and
+ * <code class="literal">EXDATE</code> properties from <ulink type="http" url="https://tools.ietf.org/html/rfc5545#section-3.8.5">RFC 5545</ulink>
+ * are supported, with the <code class="literal">YEARLY</code>, <code class="literal">MONTHLY</code>, <code class="literal">WEEKLY</code> and
+ * <code class="literal">DAILY</code> frequencies and all of their <code class="literal">BY*</code> rule parts. Instances are generated in local
+ * time in the event's time zone, so a recurring event keeps the same wall clock time across daylight saving time changes.
+ *
+ * Instances are generated lazily by gdata_calendar_recurrence_iter_next(), in ascending order of start time, so iterating over a small window of
+ * an unbounded recurrence is cheap.
+ *
+ * <example>
+ * 	<title>Listing the Instances of an Event in a Week</title>
+ * 	<programlisting>
+ *	GDataCalendarEvent *event;
+ *	GDataCalendarRecurrenceIter *iter;
+ *	gint64 week_start, start_time, end_time;
+ *	GError *error = NULL;
+ *
+ *	/<!-- -->* Get the master copy of a recurring event and the start of the week *<!-- -->/
+ *	event = query_for_recurring_event ();
+ *	week_start = get_start_of_week ();
+ *
+ *	/<!-- -->* Expand the recurrence over the week, in the event's own time zone *<!-- -->/
+ *	iter = gdata_calendar_event_expand_recurrence (event, week_start, week_start + 7 * 24 * 60 * 60, NULL, &error);
+ *	g_object_unref (event);
+ *
+ *	if (error != NULL) {
+ *		g_error ("Error expanding recurrence: %s", error->message);
+ *		g_error_free (error);
+ *		return;
+ *	}
+ *
+ *	while (gdata_calendar_recurrence_iter_next (iter, &start_time, &end_time) == TRUE) {
+ *		/<!-- -->* Display the instance *<!-- -->/
+ *		add_instance_to_ui (start_time, end_time);
+ *	}
+ *
+ *	gdata_calendar_recurrence_iter_unref (iter);
+ * 	</programlisting>
+ * </example>
+ *
+ * Since: 0.17.9
+ */
+
+#include <config.h>
+#include <glib.h>
+#include <glib/gi18n-lib.h>
+#include <gio/gio.h>
+#include <string.h>
+
+#include "gdata-calendar-recurrence.h"
+#include "gdata-service.h"
+
+#define SECONDS_PER_DAY 86400
+
+/* Julian day (as used by #GDate) of the UNIX epoch, 1970-01-01. */
+#define UNIX_EPOCH_JULIAN G_GINT64_CONSTANT (719163)
+
+/* Local times are handled as naive second counts since the start of the #GDate calendar: (Julian day × SECONDS_PER_DAY) + seconds since midnight.
+ * This limits them to the same range of years as #GDateTime. */
+#define MAX_YEAR 9999
+#define MAX_JULIAN G_GINT64_CONSTANT (3652059) /* 9999-12-31 */
+#define MIN_UNIX_TIME G_GINT64_CONSTANT (-62135596800) /* 0001-01-01T00:00:00Z */
+#define MAX_UNIX_TIME G_GINT64_CONSTANT (253402300799) /* 9999-12-31T23:59:59Z */
+
+/* Give up on a rule if this many consecutive periods contain no instances; the rule can't be satisfied (e.g. BYMONTH=2;BYMONTHDAY=30). */
+#define MAX_EMPTY_PERIODS 10000
+
+typedef enum {
+	FREQUENCY_YEARLY,
+	FREQUENCY_MONTHLY,
+	FREQUENCY_WEEKLY,
+	FREQUENCY_DAILY
+} Frequency;
+
+typedef struct {
+	GDate date;
+	guint seconds;
+	gboolean is_date;
+	gboolean is_utc;
+} DateValue;
+
+typedef struct {
+	gint ordinal;
+	GDateWeekday weekday;
+} OrdinalWeekday;
+
+typedef struct {
+	Frequency frequency;
+	guint interval;
+	guint count; /* 0 if unlimited */
+	GDateWeekday week_start;
+
+	/* Bit n is set for each value n of the BY* rule part; negative values are stored in separate masks */
+	guint16 by_month;
+	guint32 by_month_day;
+	guint32 by_month_day_negative;
+	guint64 by_week_no;
+	guint64 by_week_no_negative;
+	guint8 by_weekday;
+	guint32 by_hour;
+	guint64 by_minute;
+	guint64 by_second;
+	GArray *by_year_day; /* gint */
+	GArray *by_ordinal_weekday; /* OrdinalWeekday */
+	GArray *by_set_pos; /* gint */
+
+	gboolean has_until;
+	DateValue until;
+	gint64 until_local; /* G_MAXINT64 if unset */
+	gint64 until_utc; /* G_MAXINT64 if unset */
+
+	/* Iteration state */
+	GArray *times; /* guint seconds since midnight, ascending */
+	gint64 period;
+	guint n_empty_periods;
+	GArray *pending; /* gint64 local times in the current period, ascending */
+	guint pending_index;
+	guint n_generated;
+	gboolean finished;
+	gboolean has_next;
+	gint64 next;
+} Rule;
+
+struct _GDataCalendarRecurrenceIter {
+	volatile gint ref_count;
+
+	GTimeZone *time_zone;
+	gboolean is_date;
+	GDate start_date;
+	guint start_seconds;
+	gint64 start_local;
+	gint64 start_utc;
+	gint64 duration;
+	gint64 window_start;
+	gint64 window_end;
+
+	gboolean start_pending; /* whether DTSTART itself still has to be returned */
+	GPtrArray *rules; /* Rule, from RRULE */
+	GPtrArray *exception_rules; /* Rule, from EXRULE */
+	GArray *dates; /* gint64 UTC times, from RDATE; ascending */
+	guint dates_index;
+	GHashTable *exception_times; /* gint64 UTC times, from EXDATE */
+	GHashTable *exception_days; /* local Julian days, from EXDATE;VALUE=DATE */
+	gboolean finished;
+};
+
+G_DEFINE_BOXED_TYPE (GDataCalendarRecurrenceIter, gdata_calendar_recurrence_iter,
+                     gdata_calendar_recurrence_iter_ref, gdata_calendar_recurrence_iter_unref)
+
+static gint64
+utc_to_local (GTimeZone *time_zone, gint64 utc)
+{
+	gint interval;
+
+	interval = g_time_zone_find_interval (time_zone, G_TIME_TYPE_UNIVERSAL, utc);
+	return utc + g_time_zone_get_offset (time_zone, interval) + UNIX_EPOCH_JULIAN * SECONDS_PER_DAY;
+}
+
+static gint64
+local_to_utc (GTimeZone *time_zone, gint64 local)
+{
+	gint64 local_unix = local - UNIX_EPOCH_JULIAN * SECONDS_PER_DAY;
+	gint interval;
+
+	/* This moves times which fall in a daylight saving gap forwards, as #GDateTime does */
+	interval = g_time_zone_adjust_time (time_zone, G_TIME_TYPE_STANDARD, &local_unix);
+	return local_unix - g_time_zone_get_offset (time_zone, interval);
+}
+
+static inline gint64
+local_from_date (const GDate *date, guint seconds)
+{
+	return (gint64) g_date_get_julian (date) * SECONDS_PER_DAY + seconds;
+}
+
+static guint32
+get_week_start_julian (const GDate *date, GDateWeekday week_start)
+{
+	return g_date_get_julian (date) - ((g_date_get_weekday (date) - week_start + 7) % 7);
+}
+
+static gboolean
+parse_digits (const gchar *str, guint n_digits, guint *out)
+{
+	guint i, value = 0;
+
+	for (i = 0; i < n_digits; i++) {
+		if (g_ascii_isdigit (str[i]) == FALSE)
+			return FALSE;
+		value = value * 10 + g_ascii_digit_value (str[i]);
+	}
+
+	*out = value;
+	return TRUE;
+}
+
+/* Parses an iCalendar DATE or DATE-TIME value. A trailing ‘Z’ marks a UTC time; otherwise the time is local to a time zone given elsewhere. */
+static gboolean
+parse_date_value (const gchar *value, DateValue *out)
+{
+	guint year, month, day, hour = 0, minute = 0, second = 0;
+	gsize length = strlen (value);
+
+	if (length < 8 || parse_digits (value, 4, &year) == FALSE || parse_digits (value + 4, 2, &month) == FALSE ||
+	    parse_digits (value + 6, 2, &day) == FALSE || year < 1 || year > MAX_YEAR || month < 1 || month > 12 ||
+	    g_date_valid_dmy (day, month, year) == FALSE) {
+		return FALSE;
+	}
+
+	if (length == 8) {
+		out->is_date = TRUE;
+		out->is_utc = FALSE;
+	} else if (value[8] == 'T' && (length == 15 || (length == 16 && value[15] == 'Z')) &&
+	           parse_digits (value + 9, 2, &hour) == TRUE && parse_digits (value + 11, 2, &minute) == TRUE &&
+	           parse_digits (value + 13, 2, &second) == TRUE && hour < 24 && minute < 60 && second <= 60) {
+		out->is_date = FALSE;
+		out->is_utc = (length == 16);
+	} else {
+		return FALSE;
+	}
+
+	/* Leap seconds are folded into the following second */
+	g_date_clear (&out->date, 1);
+	g_date_set_dmy (&out->date, day, month, year);
+	out->seconds = hour * 3600 + minute * 60 + MIN (second, 59);
+
+	return TRUE;
+}
+
+static gint64
+date_value_to_utc (const DateValue *value, GTimeZone *time_zone)
+{
+	gint64 local = local_from_date (&value->date, value->seconds);
+
+	if (value->is_utc == TRUE)
+		return local - UNIX_EPOCH_JULIAN * SECONDS_PER_DAY;
+
+	return local_to_utc (time_zone, local);
+}
+
+static void
+set_parse_error (GError **error, const gchar *line)
+{
+	g_set_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR,
+	             /* Translators: the parameter is the line of an iCalendar recurrence which couldn't be parsed. */
+	             _("Invalid recurrence property ‘%s’."), line);
+}
+
+static gboolean
+parse_weekday (const gchar *str, GDateWeekday *out)
+{
+	static const gchar weekdays[][3] = { "MO", "TU", "WE", "TH", "FR", "SA", "SU" };
+	guint i;
+
+	for (i = 0; i < G_N_ELEMENTS (weekdays); i++) {
+		if (g_ascii_strcasecmp (str, weekdays[i]) == 0) {
+			*out = (GDateWeekday) (G_DATE_MONDAY + i);
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+/* Parses a comma-separated list of integers whose absolute values lie in [min, max]. */
+static gboolean
+parse_int_list (const gchar *value, gint min, gint max, gboolean allow_negative, GArray *out)
+{
+	gchar **parts;
+	guint i;
+	gboolean success = TRUE;
+
+	parts = g_strsplit (value, ",", -1);
+
+	for (i = 0; success == TRUE && parts[i] != NULL; i++) {
+		gchar *end;
+		gint64 number;
+
+		number = g_ascii_strtoll (parts[i], &end, 10);
+
+		if (end == parts[i] || *end != '\0' || (number < 0 && allow_negative == FALSE) ||
+		    number > G_MAXINT || number < -G_MAXINT || ABS (number) < min || ABS (number) > max) {
+			success = FALSE;
+		} else {
+			gint int_number = (gint) number;
+			g_array_append_val (out, int_number);
+		}
+	}
+
+	g_strfreev (parts);
+
+	return (success == TRUE && out->len > 0);
+}
+
+static Rule *
+rule_new (void)
+{
+	Rule *rule;
+
+	rule = g_slice_new0 (Rule);
+	rule->interval = 1;
+	rule->week_start = G_DATE_MONDAY;
+	rule->by_year_day = g_array_new (FALSE, FALSE, sizeof (gint));
+	rule->by_ordinal_weekday = g_array_new (FALSE, FALSE, sizeof (OrdinalWeekday));
+	rule->by_set_pos = g_array_new (FALSE, FALSE, sizeof (gint));
+	rule->until_local = G_MAXINT64;
+	rule->until_utc = G_MAXINT64;
+	rule->times = g_array_new (FALSE, FALSE, sizeof (guint));
+	rule->pending = g_array_new (FALSE, FALSE, sizeof (gint64));
+
+	return rule;
+}
+
+static void
+rule_free (Rule *rule)
+{
+	g_array_free (rule->by_year_day, TRUE);
+	g_array_free (rule->by_ordinal_weekday, TRUE);
+	g_array_free (rule->by_set_pos, TRUE);
+	g_array_free (rule->times, TRUE);
+	g_array_free (rule->pending, TRUE);
+	g_slice_free (Rule, rule);
+}
+
+/* Parses the value of an RRULE or EXRULE property, such as ‘FREQ=WEEKLY;COUNT=10;BYDAY=MO,WE’. */
+static Rule *
+parse_rule (const gchar *line, const gchar *value, GError **error)
+{
+	Rule *rule;
+	gchar **parts;
+	guint i;
+	gboolean seen_frequency = FALSE, success = TRUE;
+	GArray *numbers;
+
+	rule = rule_new ();
+	numbers = g_array_new (FALSE, FALSE, sizeof (gint));
+	parts = g_strsplit (value, ";", -1);
+
+	for (i = 0; success == TRUE && parts[i] != NULL; i++) {
+		gchar *part_value;
+		guint j;
+
+		part_value = strchr (parts[i], '=');
+		if (part_value == NULL) {
+			success = FALSE;
+			break;
+		}
+
+		*(part_value++) = '\0';
+		g_array_set_size (numbers, 0);
+
+		if (g_ascii_strcasecmp (parts[i], "FREQ") == 0) {
+			seen_frequency = TRUE;
+
+			if (g_ascii_strcasecmp (part_value, "YEARLY") == 0) {
+				rule->frequency = FREQUENCY_YEARLY;
+			} else if (g_ascii_strcasecmp (part_value, "MONTHLY") == 0) {
+				rule->frequency = FREQUENCY_MONTHLY;
+			} else if (g_ascii_strcasecmp (part_value, "WEEKLY") == 0) {
+				rule->frequency = FREQUENCY_WEEKLY;
+			} else if (g_ascii_strcasecmp (part_value, "DAILY") == 0) {
+				rule->frequency = FREQUENCY_DAILY;
+			} else if (g_ascii_strcasecmp (part_value, "HOURLY") == 0 || g_ascii_strcasecmp (part_value, "MINUTELY") == 0 ||
+			           g_ascii_strcasecmp (part_value, "SECONDLY") == 0) {
+				/* Google Calendar never generates these, and supporting them would complicate the period handling below */
+				g_set_error (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+				             /* Translators: the parameter is an iCalendar recurrence frequency, such as “HOURLY”. */
+				             _("Recurrence frequency ‘%s’ is not supported."), part_value);
+				goto error;
+			} else {
+				success = FALSE;
+			}
+		} else if (g_ascii_strcasecmp (parts[i], "INTERVAL") == 0) {
+			success = parse_int_list (part_value, 1, G_MAXINT16, FALSE, numbers) && numbers->len == 1;
+			if (success)
+				rule->interval = g_array_index (numbers, gint, 0);
+		} else if (g_ascii_strcasecmp (parts[i], "COUNT") == 0) {
+			success = parse_int_list (part_value, 1, G_MAXINT, FALSE, numbers) && numbers->len == 1;
+			if (success)
+				rule->count = g_array_index (numbers, gint, 0);
+		} else if (g_ascii_strcasecmp (parts[i], "UNTIL") == 0) {
+			success = parse_date_value (part_value, &rule->until);
+			rule->has_until = success;
+		} else if (g_ascii_strcasecmp (parts[i], "WKST") == 0) {
+			success = parse_weekday (part_value, &rule->week_start);
+		} else if (g_ascii_strcasecmp (parts[i], "BYMONTH") == 0) {
+			success = parse_int_list (part_value, 1, 12, FALSE, numbers);
+			for (j = 0; success && j < numbers->len; j++)
+				rule->by_month |= 1U << g_array_index (numbers, gint, j);
+		} else if (g_ascii_strcasecmp (parts[i], "BYMONTHDAY") == 0) {
+			success = parse_int_list (part_value, 1, 31, TRUE, numbers);
+			for (j = 0; success && j < numbers->len; j++) {
+				gint n = g_array_index (numbers, gint, j);
+
+				if (n > 0)
+					rule->by_month_day |= 1U << n;
+				else
+					rule->by_month_day_negative |= 1U << -n;
+			}
+		} else if (g_ascii_strcasecmp (parts[i], "BYWEEKNO") == 0) {
+			success = parse_int_list (part_value, 1, 53, TRUE, numbers);
+			for (j = 0; success && j < numbers->len; j++) {
+				gint n = g_array_index (numbers, gint, j);
+
+				if (n > 0)
+					rule->by_week_no |= G_GUINT64_CONSTANT (1) << n;
+				else
+					rule->by_week_no_negative |= G_GUINT64_CONSTANT (1) << -n;
+			}
+		} else if (g_ascii_strcasecmp (parts[i], "BYYEARDAY") == 0) {
+			success = parse_int_list (part_value, 1, 366, TRUE, rule->by_year_day);
+		} else if (g_ascii_strcasecmp (parts[i], "BYSETPOS") == 0) {
+			success = parse_int_list (part_value, 1, 366, TRUE, rule->by_set_pos);
+		} else if (g_ascii_strcasecmp (parts[i], "BYHOUR") == 0) {
+			success = parse_int_list (part_value, 0, 23, FALSE, numbers);
+			for (j = 0; success && j < numbers->len; j++)
+				rule->by_hour |= 1U << g_array_index (numbers, gint, j);
+		} else if (g_ascii_strcasecmp (parts[i], "BYMINUTE") == 0) {
+			success = parse_int_list (part_value, 0, 59, FALSE, numbers);
+			for (j = 0; success && j < numbers->len; j++)
+				rule->by_minute |= G_GUINT64_CONSTANT (1) << g_array_index (numbers, gint, j);
+		} else if (g_ascii_strcasecmp (parts[i], "BYSECOND") == 0) {
+			success = parse_int_list (part_value, 0, 60, FALSE, numbers);
+			for (j = 0; success && j < numbers->len; j++)
+				rule->by_second |= G_GUINT64_CONSTANT (1) << MIN (g_array_index (numbers, gint, j), 59);
+		} else if (g_ascii_strcasecmp (parts[i], "BYDAY") == 0) {
+			gchar **days = g_strsplit (part_value, ",", -1);
+
+			for (j = 0; success && days[j] != NULL; j++) {
+				OrdinalWeekday day;
+				gchar *end = NULL;
+				gsize length = strlen (days[j]);
+
+				if (length < 2 || parse_weekday (days[j] + length - 2, &day.weekday) == FALSE) {
+					success = FALSE;
+					break;
+				}
+
+				days[j][length - 2] = '\0';
+				day.ordinal = (length == 2) ? 0 : (gint) g_ascii_strtoll (days[j], &end, 10);
+
+				if (length > 2 && (end == days[j] || *end != '\0' || day.ordinal == 0 || ABS (day.ordinal) > 53)) {
+					success = FALSE;
+				} else if (day.ordinal == 0) {
+					rule->by_weekday |= 1U << day.weekday;
+				} else {
+					g_array_append_val (rule->by_ordinal_weekday, day);
+				}
+			}
+
+			g_strfreev (days);
+		}
+
+		/* Other rule parts (such as X-NAMEs) are ignored */
+	}
+
+	if (success == FALSE || seen_frequency == FALSE || (rule->count > 0 && rule->has_until == TRUE)) {
+		set_parse_error (error, line);
+		goto error;
+	}
+
+	g_strfreev (parts);
+	g_array_free (numbers, TRUE);
+
+	return rule;
+
+error:
+	g_strfreev (parts);
+	g_array_free (numbers, TRUE);
+	rule_free (rule);
+
+	return NULL;
+}
+
+/* Fills in the rule parts which default to the corresponding parts of DTSTART, and prepares the rule for iteration. These are the defaults
+ * used by RFC 5545: e.g. a plain FREQ=MONTHLY rule recurs on the day of the month of DTSTART. */
+static void
+rule_prepare (GDataCalendarRecurrenceIter *self, Rule *rule)
+{
+	guint hour, minute, second;
+	guint i;
+
+	/* Ordinal weekdays only mean something for monthly and yearly rules */
+	if (rule->frequency != FREQUENCY_MONTHLY && rule->frequency != FREQUENCY_YEARLY) {
+		for (i = 0; i < rule->by_ordinal_weekday->len; i++)
+			rule->by_weekday |= 1U << g_array_index (rule->by_ordinal_weekday, OrdinalWeekday, i).weekday;
+		g_array_set_size (rule->by_ordinal_weekday, 0);
+	}
+
+	if (rule->by_week_no == 0 && rule->by_week_no_negative == 0 && rule->by_year_day->len == 0 && rule->by_month_day == 0 &&
+	    rule->by_month_day_negative == 0 && rule->by_weekday == 0 && rule->by_ordinal_weekday->len == 0) {
+		switch (rule->frequency) {
+			case FREQUENCY_YEARLY:
+				if (rule->by_month == 0)
+					rule->by_month = 1U << g_date_get_month (&self->start_date);
+				rule->by_month_day = 1U << g_date_get_day (&self->start_date);
+				break;
+			case FREQUENCY_MONTHLY:
+				rule->by_month_day = 1U << g_date_get_day (&self->start_date);
+				break;
+			case FREQUENCY_WEEKLY:
+				rule->by_weekday = 1U << g_date_get_weekday (&self->start_date);
+				break;
+			case FREQUENCY_DAILY:
+			default:
+				break;
+		}
+	}
+
+	if (rule->by_hour == 0)
+		rule->by_hour = 1U << (self->start_seconds / 3600);
+	if (rule->by_minute == 0)
+		rule->by_minute = G_GUINT64_CONSTANT (1) << (self->start_seconds / 60 % 60);
+	if (rule->by_second == 0)
+		rule->by_second = G_GUINT64_CONSTANT (1) << (self->start_seconds % 60);
+
+	/* All-day events have no times of day */
+	if (self->is_date == TRUE) {
+		rule->by_hour = 1;
+		rule->by_minute = 1;
+		rule->by_second = 1;
+	}
+
+	for (hour = 0; hour < 24; hour++) {
+		if ((rule->by_hour & (1U << hour)) == 0)
+			continue;
+
+		for (minute = 0; minute < 60; minute++) {
+			if ((rule->by_minute & (G_GUINT64_CONSTANT (1) << minute)) == 0)
+				continue;
+
+			for (second = 0; second < 60; second++) {
+				if ((rule->by_second & (G_GUINT64_CONSTANT (1) << second)) != 0) {
+					guint seconds = hour * 3600 + minute * 60 + second;
+					g_array_append_val (rule->times, seconds);
+				}
+			}
+		}
+	}
+
+	/* A DATE UNTIL includes the whole of that day; a floating DATE-TIME is in the event's time zone */
+	if (rule->has_until == TRUE) {
+		if (rule->until.is_utc == TRUE)
+			rule->until_utc = date_value_to_utc (&rule->until, self->time_zone);
+		else if (rule->until.is_date == TRUE)
+			rule->until_local = local_from_date (&rule->until.date, SECONDS_PER_DAY - 1);
+		else
+			rule->until_local = local_from_date (&rule->until.date, rule->until.seconds);
+	}
+}
+
+static gboolean
+rule_matches_day (const Rule *rule, const GDate *date)
+{
+	GDateMonth month = g_date_get_month (date);
+	GDateYear year = g_date_get_year (date);
+	guint day = g_date_get_day (date);
+	guint days_in_month = g_date_get_days_in_month (month, year);
+	guint day_of_year = g_date_get_day_of_year (date);
+	guint days_in_year = g_date_is_leap_year (year) ? 366 : 365;
+	guint i;
+
+	if (rule->by_month != 0 && (rule->by_month & (1U << month)) == 0)
+		return FALSE;
+
+	if (rule->by_month_day != 0 || rule->by_month_day_negative != 0) {
+		if ((rule->by_month_day & (1U << day)) == 0 && (rule->by_month_day_negative & (1U << (days_in_month - day + 1))) == 0)
+			return FALSE;
+	}
+
+	if (rule->by_year_day->len > 0) {
+		gboolean matched = FALSE;
+
+		for (i = 0; matched == FALSE && i < rule->by_year_day->len; i++) {
+			gint n = g_array_index (rule->by_year_day, gint, i);
+			matched = (n == (gint) day_of_year || n == (gint) day_of_year - (gint) days_in_year - 1);
+		}
+
+		if (matched == FALSE)
+			return FALSE;
+	}
+
+	/* Week numbers follow ISO 8601 (weeks starting on Monday) rather than WKST */
+	if (rule->frequency == FREQUENCY_YEARLY && (rule->by_week_no != 0 || rule->by_week_no_negative != 0)) {
+		GDate last_week;
+		guint week, weeks_in_year;
+
+		g_date_clear (&last_week, 1);
+		g_date_set_dmy (&last_week, 28, G_DATE_DECEMBER, year);
+		weeks_in_year = g_date_get_iso8601_week_of_year (&last_week);
+		week = g_date_get_iso8601_week_of_year (date);
+
+		if ((rule->by_week_no & (G_GUINT64_CONSTANT (1) << week)) == 0 &&
+		    (week > weeks_in_year || (rule->by_week_no_negative & (G_GUINT64_CONSTANT (1) << (weeks_in_year - week + 1))) == 0)) {
+			return FALSE;
+		}
+	}
+
+	if (rule->by_weekday != 0 || rule->by_ordinal_weekday->len > 0) {
+		GDateWeekday weekday = g_date_get_weekday (date);
+		gboolean matched = (rule->by_weekday & (1U << weekday)) != 0;
+
+		for (i = 0; matched == FALSE && i < rule->by_ordinal_weekday->len; i++) {
+			const OrdinalWeekday *ordinal = &g_array_index (rule->by_ordinal_weekday, OrdinalWeekday, i);
+			gint position, negative_position;
+
+			if (ordinal->weekday != weekday)
+				continue;
+
+			/* e.g. 2MO is the second Monday of the month (or of the year, for yearly rules without BYMONTH) */
+			if (rule->frequency == FREQUENCY_MONTHLY || rule->by_month != 0) {
+				position = (day - 1) / 7 + 1;
+				negative_position = -(gint) ((days_in_month - day) / 7 + 1);
+			} else {
+				position = (day_of_year - 1) / 7 + 1;
+				negative_position = -(gint) ((days_in_year - day_of_year) / 7 + 1);
+			}
+
+			matched = (ordinal->ordinal == position || ordinal->ordinal == negative_position);
+		}
+
+		if (matched == FALSE)
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+static gint
+compare_int64 (gconstpointer a, gconstpointer b)
+{
+	gint64 _a = *((const gint64*) a), _b = *((const gint64*) b);
+	return (_a < _b) ? -1 : (_a > _b) ? 1 : 0;
+}
+
+/* Generates the local start times of all the instances in the rule's next period, returning %FALSE if the period is past the end of the
+ * calendar. */
+static gboolean
+rule_fill_period (GDataCalendarRecurrenceIter *self, Rule *rule)
+{
+	GDate date;
+	gint64 step, first_julian;
+	guint n_days, i, j;
+
+	g_array_set_size (rule->pending, 0);
+	rule->pending_index = 0;
+
+	g_date_clear (&date, 1);
+	step = rule->period * rule->interval;
+
+	switch (rule->frequency) {
+		case FREQUENCY_DAILY:
+			first_julian = g_date_get_julian (&self->start_date) + step;
+			n_days = 1;
+			break;
+		case FREQUENCY_WEEKLY:
+			first_julian = get_week_start_julian (&self->start_date, rule->week_start) + 7 * step;
+			n_days = 7;
+			break;
+		case FREQUENCY_MONTHLY: {
+			gint64 months = (gint64) g_date_get_year (&self->start_date) * 12 + g_date_get_month (&self->start_date) - 1 + step;
+
+			if (months / 12 > MAX_YEAR)
+				return FALSE;
+
+			g_date_set_dmy (&date, 1, months % 12 + 1, months / 12);
+			first_julian = g_date_get_julian (&date);
+			n_days = g_date_get_days_in_month (months % 12 + 1, months / 12);
+			break;
+		}
+		case FREQUENCY_YEARLY:
+		default: {
+			gint64 year = g_date_get_year (&self->start_date) + step;
+
+			if (year > MAX_YEAR)
+				return FALSE;
+
+			g_date_set_dmy (&date, 1, G_DATE_JANUARY, year);
+			first_julian = g_date_get_julian (&date);
+			n_days = g_date_is_leap_year (year) ? 366 : 365;
+			break;
+		}
+	}
+
+	if (first_julian < 1 || first_julian + n_days - 1 > MAX_JULIAN)
+		return FALSE;
+
+	for (i = 0; i < n_days; i++) {
+		g_date_set_julian (&date, first_julian + i);
+
+		if (rule_matches_day (rule, &date) == FALSE)
+			continue;
+
+		for (j = 0; j < rule->times->len; j++) {
+			gint64 local = (first_julian + i) * SECONDS_PER_DAY + g_array_index (rule->times, guint, j);
+			g_array_append_val (rule->pending, local);
+		}
+	}
+
+	/* BYSETPOS picks instances from the whole period's set */
+	if (rule->by_set_pos->len > 0 && rule->pending->len > 0) {
+		GArray *selected = g_array_sized_new (FALSE, FALSE, sizeof (gint64), rule->by_set_pos->len);
+
+		for (i = 0; i < rule->by_set_pos->len; i++) {
+			gint position = g_array_index (rule->by_set_pos, gint, i);
+			gint index = (position > 0) ? position - 1 : (gint) rule->pending->len + position;
+
+			if (index >= 0 && index < (gint) rule->pending->len)
+				g_array_append_val (selected, g_array_index (rule->pending, gint64, index));
+		}
+
+		g_array_sort (selected, compare_int64);
+
+		/* Remove duplicates */
+		for (i = 1, j = 0; i < selected->len; i++) {
+			if (g_array_index (selected, gint64, i) != g_array_index (selected, gint64, j))
+				g_array_index (selected, gint64, ++j) = g_array_index (selected, gint64, i);
+		}
+		g_array_set_size (selected, MIN (selected->len, j + 1));
+
+		g_array_free (rule->pending, TRUE);
+		rule->pending = selected;
+	}
+
+	rule->period++;
+
+	return TRUE;
+}
+
+/* Skips whole periods of an unbounded rule which end before @local. Rules with a COUNT can't be skipped, as every instance has to be counted. */
+static void
+rule_skip_to (GDataCalendarRecurrenceIter *self, Rule *rule, gint64 local)
+{
+	GDate target;
+	gint64 periods;
+
+	if (rule->count > 0 || local <= self->start_local)
+		return;
+
+	g_date_clear (&target, 1);
+	g_date_set_julian (&target, MIN (local / SECONDS_PER_DAY, MAX_JULIAN));
+
+	switch (rule->frequency) {
+		case FREQUENCY_DAILY:
+			periods = (gint64) g_date_get_julian (&target) - g_date_get_julian (&self->start_date);
+			break;
+		case FREQUENCY_WEEKLY:
+			periods = ((gint64) get_week_start_julian (&target, rule->week_start) -
+			           get_week_start_julian (&self->start_date, rule->week_start)) / 7;
+			break;
+		case FREQUENCY_MONTHLY:
+			periods = ((gint64) g_date_get_year (&target) * 12 + g_date_get_month (&target)) -
+			          ((gint64) g_date_get_year (&self->start_date) * 12 + g_date_get_month (&self->start_date));
+			break;
+		case FREQUENCY_YEARLY:
+		default:
+			periods = (gint64) g_date_get_year (&target) - g_date_get_year (&self->start_date);
+			break;
+	}
+
+	rule->period = MAX (periods / rule->interval, 0);
+}
+
+static gboolean
+rule_peek (GDataCalendarRecurrenceIter *self, Rule *rule, gint64 *next)
+{
+	while (rule->has_next == FALSE && rule->finished == FALSE) {
+		if (rule->pending_index < rule->pending->len) {
+			gint64 local, utc;
+
+			local = g_array_index (rule->pending, gint64, rule->pending_index++);
+
+			/* Instances before DTSTART aren't part of the recurrence set */
+			if (local < self->start_local)
+				continue;
+
+			if (local > rule->until_local || (rule->count > 0 && rule->n_generated >= rule->count)) {
+				rule->finished = TRUE;
+				break;
+			}
+
+			utc = local_to_utc (self->time_zone, local);
+			if (utc > rule->until_utc) {
+				rule->finished = TRUE;
+				break;
+			}
+
+			rule->n_generated++;
+			rule->has_next = TRUE;
+			rule->next = utc;
+		} else if (rule->n_empty_periods >= MAX_EMPTY_PERIODS || rule_fill_period (self, rule) == FALSE) {
+			rule->finished = TRUE;
+		} else {
+			rule->n_empty_periods = (rule->pending->len == 0) ? rule->n_empty_periods + 1 : 0;
+		}
+	}
+
+	*next = rule->next;
+
+	return rule->has_next;
+}
+
+/* Iterates through the lines of an iCalendar recurrence, unfolding continuation lines and skipping nested components such as VTIMEZONE. */
+static gchar **
+split_recurrence (const gchar *recurrence)
+{
+	GPtrArray *lines;
+	gchar **raw_lines;
+	guint i, depth = 0;
+	gboolean skipping = TRUE;
+
+	lines = g_ptr_array_new ();
+	raw_lines = g_strsplit (recurrence, "\n", -1);
+
+	for (i = 0; raw_lines[i] != NULL; i++) {
+		gchar *line = raw_lines[i];
+		gsize length = strlen (line);
+
+		if (length > 0 && line[length - 1] == '\r')
+			line[--length] = '\0';
+
+		if (line[0] == ' ' || line[0] == '\t') {
+			/* Continuation lines belong to whichever line preceded them, which might have been skipped */
+			if (skipping == FALSE) {
+				gchar *previous = g_ptr_array_index (lines, lines->len - 1);
+
+				g_ptr_array_index (lines, lines->len - 1) = g_strconcat (previous, line + 1, NULL);
+				g_free (previous);
+			}
+		} else if (g_ascii_strncasecmp (line, "BEGIN:", strlen ("BEGIN:")) == 0) {
+			depth++;
+			skipping = TRUE;
+		} else if (g_ascii_strncasecmp (line, "END:", strlen ("END:")) == 0) {
+			depth = (depth > 0) ? depth - 1 : 0;
+			skipping = TRUE;
+		} else if (depth == 0 && length > 0) {
+			g_ptr_array_add (lines, g_strdup (line));
+			skipping = FALSE;
+		} else {
+			skipping = TRUE;
+		}
+	}
+
+	g_strfreev (raw_lines);
+	g_ptr_array_add (lines, NULL);
+
+	return (gchar**) g_ptr_array_free (lines, FALSE);
+}
+
+/* Splits ‘NAME;PARAM=VALUE;…:VALUE’ into its parts. @line is modified in place. */
+static gboolean
+split_property (gchar *line, gchar **name, gchar **parameters, gchar **value)
+{
+	gboolean in_quotes = FALSE;
+	gchar *i, *separator;
+
+	for (i = line; *i != '\0' && (*i != ':' || in_quotes == TRUE); i++) {
+		if (*i == '"')
+			in_quotes = !in_quotes;
+	}
+
+	if (*i == '\0')
+		return FALSE;
+
+	*i = '\0';
+	*value = i + 1;
+
+	separator = strchr (line, ';');
+	if (separator != NULL)
+		*(separator++) = '\0';
+
+	*name = line;
+	*parameters = separator;
+
+	return TRUE;
+}
+
+/* Gets the value of parameter @key from a ‘;’-separated parameter list, stripping any quotes. */
+static gchar *
+get_parameter (const gchar *parameters, const gchar *key)
+{
+	gchar **parts;
+	gchar *value = NULL;
+	guint i;
+	gsize key_length = strlen (key);
+
+	if (parameters == NULL)
+		return NULL;
+
+	parts = g_strsplit (parameters, ";", -1);
+
+	for (i = 0; value == NULL && parts[i] != NULL; i++) {
+		if (g_ascii_strncasecmp (parts[i], key, key_length) == 0 && parts[i][key_length] == '=') {
+			value = g_strdup (parts[i] + key_length + 1);
+
+			if (value[0] == '"') {
+				gchar *unquoted = g_strndup (value + 1, MAX (strlen (value), 2) - 2);
+				g_free (value);
+				value = unquoted;
+			}
+		}
+	}
+
+	g_strfreev (parts);
+
+	return value;
+}
+
+/* Gets the time zone named by the TZID parameter, or the iterator's time zone if there isn't one. */
+static GTimeZone *
+get_time_zone_parameter (GDataCalendarRecurrenceIter *self, const gchar *parameters)
+{
+	gchar *tzid;
+	GTimeZone *time_zone;
+
+	tzid = get_parameter (parameters, "TZID");
+	time_zone = (tzid != NULL) ? g_time_zone_new (tzid) : g_time_zone_ref (self->time_zone);
+	g_free (tzid);
+
+	return time_zone;
+}
+
+/* Parses the comma-separated values of an RDATE or EXDATE property. */
+static gboolean
+parse_date_list (GDataCalendarRecurrenceIter *self, const gchar *parameters, const gchar *value, gboolean is_exception)
+{
+	GTimeZone *time_zone;
+	gchar **parts;
+	guint i;
+	gboolean success = TRUE;
+
+	time_zone = get_time_zone_parameter (self, parameters);
+	parts = g_strsplit (value, ",", -1);
+
+	for (i = 0; success == TRUE && parts[i] != NULL; i++) {
+		DateValue date_value;
+		gchar *period_end;
+
+		/* For PERIOD values, only the start of the period matters */
+		period_end = strchr (parts[i], '/');
+		if (period_end != NULL)
+			*period_end = '\0';
+
+		if (parse_date_value (parts[i], &date_value) == FALSE) {
+			success = FALSE;
+		} else if (is_exception == TRUE && date_value.is_date == TRUE) {
+			/* An excluded date removes every instance starting on that (local) day */
+			g_hash_table_add (self->exception_days, GUINT_TO_POINTER (g_date_get_julian (&date_value.date)));
+		} else {
+			gint64 utc;
+
+			/* Dates without times take the time of DTSTART */
+			if (date_value.is_date == TRUE)
+				date_value.seconds = self->start_seconds;
+
+			utc = date_value_to_utc (&date_value, time_zone);
+
+			if (is_exception == TRUE)
+				g_hash_table_add (self->exception_times, g_memdup (&utc, sizeof (utc)));
+			else
+				g_array_append_val (self->dates, utc);
+		}
+	}
+
+	g_strfreev (parts);
+	g_time_zone_unref (time_zone);
+
+	return success;
+}
+
+/**
+ * gdata_calendar_recurrence_iter_new:
+ * @recurrence: (allow-none): an iCalendar recurrence, as returned by gdata_calendar_event_get_recurrence(), or %NULL
+ * @start_time: the start time of the first instance of the event, as a UNIX timestamp
+ * @end_time: the end time of the first instance of the event, as a UNIX timestamp
+ * @is_date: %TRUE if the event is an all-day event, %FALSE otherwise
+ * @time_zone: (allow-none): the time zone to expand the recurrence in, or %NULL to use UTC
+ * @window_start: the start of the time window to return instances for, as a UNIX timestamp, or <code class="literal">-1</code>
+ * @window_end: the end of the time window to return instances for, as a UNIX timestamp, or <code class="literal">-1</code>
+ * @error: a #GError, or %NULL
+ *
+ * Creates an iterator over the instances of the recurrence @recurrence which overlap the time window between @window_start and @window_end. The
+ * first instance of the recurrence (<code class="literal">DTSTART</code> in iCalendar terms) runs from @start_time to @end_time, and all the
+ * other instances have the same duration. If @recurrence contains <code class="literal">DTSTART</code> or <code class="literal">DTEND</code>
+ * properties (as returned by version 2 of the Google Calendar API), they take precedence over @start_time and @end_time.
+ *
+ * Rules are evaluated in local time in @time_zone, which should be the time zone the event was created in. A
+ * <code class="literal">TZID</code> parameter on a <code class="literal">DTSTART</code> property in @recurrence takes precedence over
+ * @time_zone. All-day events are always expanded in UTC, matching how libgdata represents their dates.
+ *
+ * If @recurrence is %NULL, the iterator returns the single instance from @start_time to @end_time, if it overlaps the window.
+ *
+ * If @recurrence can't be parsed, a %GDATA_SERVICE_ERROR_PROTOCOL_ERROR error will be returned. If it uses a sub-daily recurrence
+ * frequency, a %G_IO_ERROR_NOT_SUPPORTED error will be returned.
+ *
+ * Return value: (transfer full): a new #GDataCalendarRecurrenceIter, or %NULL; free with gdata_calendar_recurrence_iter_unref()
+ *
+ * Since: 0.17.9
+ */
+GDataCalendarRecurrenceIter *
+gdata_calendar_recurrence_iter_new (const gchar *recurrence, gint64 start_time, gint64 end_time, gboolean is_date, GTimeZone *time_zone,
+                                    gint64 window_start, gint64 window_end, GError **error)
+{
+	GDataCalendarRecurrenceIter *self;
+	gchar **lines;
+	guint i;
+	gboolean success = TRUE, has_end = FALSE;
+	DateValue end_value = { { 0, }, 0, FALSE, FALSE };
+	gchar *end_parameters = NULL;
+
+	g_return_val_if_fail (start_time >= MIN_UNIX_TIME && start_time <= MAX_UNIX_TIME, NULL);
+	g_return_val_if_fail (end_time >= start_time, NULL);
+	g_return_val_if_fail (error == NULL || *error == NULL, NULL);
+
+	self = g_slice_new0 (GDataCalendarRecurrenceIter);
+	self->ref_count = 1;
+	self->is_date = is_date;
+	self->time_zone = (time_zone != NULL && is_date == FALSE) ? g_time_zone_ref (time_zone) : g_time_zone_new_utc ();
+	self->start_utc = start_time;
+	self->duration = end_time - start_time;
+	self->window_start = (window_start == -1) ? G_MININT64 : window_start;
+	self->window_end = (window_end == -1) ? G_MAXINT64 : window_end;
+	self->start_pending = TRUE;
+	self->rules = g_ptr_array_new_with_free_func ((GDestroyNotify) rule_free);
+	self->exception_rules = g_ptr_array_new_with_free_func ((GDestroyNotify) rule_free);
+	self->dates = g_array_new (FALSE, FALSE, sizeof (gint64));
+	self->exception_times = g_hash_table_new_full (g_int64_hash, g_int64_equal, g_free, NULL);
+	self->exception_days = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+	lines = split_recurrence ((recurrence != NULL) ? recurrence : "");
+
+	/* DTSTART and DTEND have to be known before any rules are prepared, as the rules' defaults depend on them */
+	for (i = 0; success == TRUE && lines[i] != NULL; i++) {
+		gchar *line, *name, *parameters, *value;
+		DateValue date_value;
+
+		line = g_strdup (lines[i]);
+
+		if (split_property (line, &name, &parameters, &value) == TRUE &&
+		    (g_ascii_strcasecmp (name, "DTSTART") == 0 || g_ascii_strcasecmp (name, "DTEND") == 0)) {
+			if (parse_date_value (value, &date_value) == FALSE) {
+				set_parse_error (error, lines[i]);
+				success = FALSE;
+			} else if (g_ascii_strcasecmp (name, "DTSTART") == 0) {
+				GTimeZone *start_time_zone;
+
+				start_time_zone = (date_value.is_date == TRUE) ? g_time_zone_new_utc () : get_time_zone_parameter (self, parameters);
+				g_time_zone_unref (self->time_zone);
+				self->time_zone = start_time_zone;
+				self->is_date = date_value.is_date;
+				self->start_utc = date_value_to_utc (&date_value, self->time_zone);
+			} else {
+				/* Resolved below, as a floating DTEND is in the time zone of DTSTART */
+				has_end = TRUE;
+				end_value = date_value;
+				g_free (end_parameters);
+				end_parameters = g_strdup (parameters);
+			}
+		}
+
+		g_free (line);
+	}
+
+	if (success == TRUE && has_end == TRUE) {
+		GTimeZone *end_time_zone;
+
+		end_time_zone = (end_value.is_date == TRUE) ? g_time_zone_new_utc () : get_time_zone_parameter (self, end_parameters);
+		self->duration = MAX (date_value_to_utc (&end_value, end_time_zone) - self->start_utc, 0);
+		g_time_zone_unref (end_time_zone);
+	}
+
+	g_free (end_parameters);
+
+	if (success == TRUE) {
+		self->start_local = utc_to_local (self->time_zone, self->start_utc);
+		self->start_seconds = self->start_local % SECONDS_PER_DAY;
+		g_date_clear (&self->start_date, 1);
+		g_date_set_julian (&self->start_date, self->start_local / SECONDS_PER_DAY);
+	}
+
+	for (i = 0; success == TRUE && lines[i] != NULL; i++) {
+		gchar *line, *name, *parameters, *value;
+
+		line = g_strdup (lines[i]);
+
+		if (split_property (line, &name, &parameters, &value) == FALSE) {
+			set_parse_error (error, lines[i]);
+			success = FALSE;
+		} else if (g_ascii_strcasecmp (name, "RRULE") == 0 || g_ascii_strcasecmp (name, "EXRULE") == 0) {
+			Rule *rule = parse_rule (lines[i], value, error);
+
+			if (rule == NULL) {
+				success = FALSE;
+			} else {
+				rule_prepare (self, rule);
+				g_ptr_array_add ((g_ascii_strcasecmp (name, "RRULE") == 0) ? self->rules : self->exception_rules, rule);
+			}
+		} else if (g_ascii_strcasecmp (name, "RDATE") == 0 || g_ascii_strcasecmp (name, "EXDATE") == 0) {
+			if (parse_date_list (self, parameters, value, g_ascii_strcasecmp (name, "EXDATE") == 0) == FALSE) {
+				set_parse_error (error, lines[i]);
+				success = FALSE;
+			}
+		}
+
+		/* Other properties, including DTSTART and DTEND (handled above), are ignored */
+		g_free (line);
+	}
+
+	g_strfreev (lines);
+
+	if (success == FALSE) {
+		gdata_calendar_recurrence_iter_unref (self);
+		return NULL;
+	}
+
+	g_array_sort (self->dates, compare_int64);
+
+	/* Jump straight to the rule periods which can overlap the window, rather than generating every instance since DTSTART. The margin of a day
+	 * covers any time zone offset changes. */
+	if (self->window_start > self->start_utc && self->window_start <= MAX_UNIX_TIME) {
+		gint64 skip_to = utc_to_local (self->time_zone, self->window_start - self->duration) - SECONDS_PER_DAY;
+
+		for (i = 0; i < self->rules->len; i++)
+			rule_skip_to (self, g_ptr_array_index (self->rules, i), skip_to);
+		for (i = 0; i < self->exception_rules->len; i++)
+			rule_skip_to (self, g_ptr_array_index (self->exception_rules, i), skip_to);
+	}
+
+	return self;
+}
+
+/**
+ * gdata_calendar_recurrence_iter_ref:
+ * @self: a #GDataCalendarRecurrenceIter
+ *
+ * Adds a reference to @self.
+ *
+ * Return value: (transfer full): @self
+ *
+ * Since: 0.17.9
+ */
+GDataCalendarRecurrenceIter *
+gdata_calendar_recurrence_iter_ref (GDataCalendarRecurrenceIter *self)
+{
+	g_return_val_if_fail (self != NULL, NULL);
+
+	g_atomic_int_inc (&self->ref_count);
+
+	return self;
+}
+
+/**
+ * gdata_calendar_recurrence_iter_unref:
+ * @self: (transfer full): a #GDataCalendarRecurrenceIter
+ *
+ * Removes a reference from @self, freeing it if this was the last reference.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_calendar_recurrence_iter_unref (GDataCalendarRecurrenceIter *self)
+{
+	g_return_if_fail (self != NULL);
+
+	if (g_atomic_int_dec_and_test (&self->ref_count) == FALSE)
+		return;
+
+	g_time_zone_unref (self->time_zone);
+	g_ptr_array_unref (self->rules);
+	g_ptr_array_unref (self->exception_rules);
+	g_array_free (self->dates, TRUE);
+	g_hash_table_unref (self->exception_times);
+	g_hash_table_unref (self->exception_days);
+
+	g_slice_free (GDataCalendarRecurrenceIter, self);
+}
+
+static gboolean
+is_excluded (GDataCalendarRecurrenceIter *self, gint64 start_time)
+{
+	guint i;
+
+	if (g_hash_table_contains (self->exception_times, &start_time) == TRUE ||
+	    (g_hash_table_size (self->exception_days) > 0 &&
+	     g_hash_table_contains (self->exception_days,
+	                            GUINT_TO_POINTER (utc_to_local (self->time_zone, start_time) / SECONDS_PER_DAY)) == TRUE)) {
+		return TRUE;
+	}
+
+	/* Exception rules only ever move forwards, as the instances are checked in order */
+	for (i = 0; i < self->exception_rules->len; i++) {
+		Rule *rule = g_ptr_array_index (self->exception_rules, i);
+		gint64 next;
+
+		while (rule_peek (self, rule, &next) == TRUE && next < start_time)
+			rule->has_next = FALSE;
+
+		if (rule->has_next == TRUE && next == start_time)
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+/**
+ * gdata_calendar_recurrence_iter_next:
+ * @self: a #GDataCalendarRecurrenceIter
+ * @start_time: (out caller-allocates) (allow-none): return location for the start time of the instance, as a UNIX timestamp, or %NULL
+ * @end_time: (out caller-allocates) (allow-none): return location for the end time of the instance, as a UNIX timestamp, or %NULL
+ *
+ * Gets the next instance of the recurrence which overlaps the iterator's time window. Instances are returned in ascending order of start time,
+ * and each start time is only returned once, even if several rules generate it.
+ *
+ * Instances are generated on demand, so it is safe to iterate over a recurrence with no end, as long as the iteration is stopped at some point
+ * (either by the end of the time window, or by the caller).
+ *
+ * Return value: %TRUE if an instance was returned, %FALSE if there are no more instances in the window
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_calendar_recurrence_iter_next (GDataCalendarRecurrenceIter *self, gint64 *start_time, gint64 *end_time)
+{
+	g_return_val_if_fail (self != NULL, FALSE);
+
+	while (self->finished == FALSE) {
+		gint64 next = G_MAXINT64, rule_next;
+		gboolean found = FALSE;
+		guint i;
+
+		/* Find the earliest instance from any of the sources */
+		if (self->start_pending == TRUE) {
+			next = self->start_utc;
+			found = TRUE;
+		}
+
+		for (i = 0; i < self->rules->len; i++) {
+			if (rule_peek (self, g_ptr_array_index (self->rules, i), &rule_next) == TRUE && rule_next < next) {
+				next = rule_next;
+				found = TRUE;
+			}
+		}
+
+		if (self->dates_index < self->dates->len && g_array_index (self->dates, gint64, self->dates_index) < next) {
+			next = g_array_index (self->dates, gint64, self->dates_index);
+			found = TRUE;
+		}
+
+		if (found == FALSE || next >= self->window_end) {
+			self->finished = TRUE;
+			break;
+		}
+
+		/* Consume it from every source which generated it, so duplicates are dropped */
+		if (self->start_pending == TRUE && self->start_utc == next)
+			self->start_pending = FALSE;
+
+		for (i = 0; i < self->rules->len; i++) {
+			Rule *rule = g_ptr_array_index (self->rules, i);
+
+			if (rule->has_next == TRUE && rule->next == next)
+				rule->has_next = FALSE;
+		}
+
+		while (self->dates_index < self->dates->len && g_array_index (self->dates, gint64, self->dates_index) == next)
+			self->dates_index++;
+
+		if (next + self->duration <= self->window_start && next < self->window_start)
+			continue;
+
+		if (is_excluded (self, next) == TRUE)
+			continue;
+
+		if (start_time != NULL)
+			*start_time = next;
+		if (end_time != NULL)
+			*end_time = next + self->duration;
+
+		return TRUE;
+	}
+
+	return FALSE;
+}
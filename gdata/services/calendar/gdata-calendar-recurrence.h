@@ -0,0 +1,52 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ * Copyright (C) Philip Withnall 2017 <philip@tecnocode.co.uk>
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GDATA_CALENDAR_RECURRENCE_H
+#define GDATA_CALENDAR_RECURRENCE_H
+
+#include <glib.h>
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GDataCalendarRecurrenceIter:
+ *
+ * An iterator over the instances of a recurring event which fall inside a time window. All the fields in the #GDataCalendarRecurrenceIter
+ * structure are private and should never be accessed directly.
+ *
+ * Since: 0.17.9
+ */
+typedef struct _GDataCalendarRecurrenceIter GDataCalendarRecurrenceIter;
+
+#define GDATA_TYPE_CALENDAR_RECURRENCE_ITER (gdata_calendar_recurrence_iter_get_type ())
+
+GType gdata_calendar_recurrence_iter_get_type (void) G_GNUC_CONST;
+
+GDataCalendarRecurrenceIter *gdata_calendar_recurrence_iter_new (const gchar *recurrence, gint64 start_time, gint64 end_time, gboolean is_date,
+                                                                 GTimeZone *time_zone, gint64 window_start, gint64 window_end,
+                                                                 GError **error) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+GDataCalendarRecurrenceIter *gdata_calendar_recurrence_iter_ref (GDataCalendarRecurrenceIter *self);
+void gdata_calendar_recurrence_iter_unref (GDataCalendarRecurrenceIter *self);
+
+gboolean gdata_calendar_recurrence_iter_next (GDataCalendarRecurrenceIter *self, gint64 *start_time, gint64 *end_time);
+
+G_END_DECLS
+
+#endif /* !GDATA_CALENDAR_RECURRENCE_H */
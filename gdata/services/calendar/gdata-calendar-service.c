@@ -146,6 +146,7 @@
 #include "gdata-private.h"
 #include "gdata-query.h"
 #include "gdata-calendar-feed.h"
+#include "gdata-calendar-query.h"
 
 /* Standards reference here:
  * https://developers.google.com/google-apps/calendar/v3/reference/ */
@@ -750,6 +751,53 @@ gdata_calendar_service_query_events_async (GDataCalendarService *self, GDataCale
 	g_free (request_uri);
 }
 
+static gboolean
+event_is_deleted (GDataEntry *entry)
+{
+	return (g_strcmp0 (gdata_calendar_event_get_status (GDATA_CALENDAR_EVENT (entry)), GDATA_GD_EVENT_STATUS_CANCELED) == 0);
+}
+
+/**
+ * gdata_calendar_service_create_sync_session:
+ * @self: a #GDataCalendarService
+ * @calendar: (allow-none): the #GDataCalendarCalendar to keep up to date, or %NULL
+ *
+ * Creates a #GDataSyncSession for keeping a local copy of the events in @calendar up to date. If @calendar is %NULL, the default calendar for the
+ * authenticated user is used. Recurring events are returned as a single event containing the recurrence rule; cancelled events (including
+ * cancelled instances of recurring events) are reported as %GDATA_SYNC_CHANGE_DELETION changes.
+ *
+ * The session uses the <ulink type="http" url="https://developers.google.com/google-apps/calendar/v3/sync">sync tokens</ulink> provided by
+ * Google Calendar as its cursor.
+ *
+ * Return value: (transfer full): a new #GDataSyncSession; unref with g_object_unref()
+ *
+ * Since: 0.17.9
+ */
+GDataSyncSession *
+gdata_calendar_service_create_sync_session (GDataCalendarService *self, GDataCalendarCalendar *calendar)
+{
+	GDataCalendarQuery *query;
+	GDataSyncSession *session;
+	gchar *request_uri;
+
+	g_return_val_if_fail (GDATA_IS_CALENDAR_SERVICE (self), NULL);
+	g_return_val_if_fail (calendar == NULL || GDATA_IS_CALENDAR_CALENDAR (calendar), NULL);
+
+	/* Deleted events have to be included, as the API doesn't allow excluding them when using sync tokens. Most other parameters (such as
+	 * time ranges) can't be used with sync tokens at all. */
+	query = gdata_calendar_query_new (NULL);
+	gdata_query_set_max_results (GDATA_QUERY (query), 250);
+	gdata_calendar_query_set_show_deleted (query, TRUE);
+
+	request_uri = build_events_uri (calendar);
+	session = _gdata_sync_session_new (GDATA_SERVICE (self), get_calendar_authorization_domain (), request_uri, GDATA_QUERY (query),
+	                                   GDATA_TYPE_CALENDAR_EVENT, "syncToken", event_is_deleted);
+	g_free (request_uri);
+	g_object_unref (query);
+
+	return session;
+}
+
 /**
  * gdata_calendar_service_insert_event:
  * @self: a #GDataCalendarService
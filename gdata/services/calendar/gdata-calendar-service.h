@@ -25,6 +25,7 @@
 
 #include <gdata/gdata-service.h>
 #include <gdata/gdata-query.h>
+#include <gdata/gdata-sync-session.h>
 #include <gdata/services/calendar/gdata-calendar-calendar.h>
 
 G_BEGIN_DECLS
@@ -93,6 +94,9 @@ void gdata_calendar_service_query_events_async (GDataCalendarService *self, GDat
                                                 GCancellable *cancellable, GDataQueryProgressCallback progress_callback, gpointer progress_user_data,
                                                 GDestroyNotify destroy_progress_user_data, GAsyncReadyCallback callback, gpointer user_data);
 
+GDataSyncSession *gdata_calendar_service_create_sync_session (GDataCalendarService *self,
+                                                              GDataCalendarCalendar *calendar) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+
 #include <gdata/services/calendar/gdata-calendar-event.h>
 
 #ifndef LIBGDATA_DISABLE_DEPRECATED
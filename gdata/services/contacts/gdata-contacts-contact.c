@@ -172,16 +172,18 @@ static void gdata_contacts_contact_set_property (GObject *object, guint property
 static void get_xml (GDataParsable *parsable, GString *xml_string);
 static gboolean parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *node, gpointer user_data, GError **error);
 static void get_namespaces (GDataParsable *parsable, GHashTable *namespaces);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 static gchar *get_entry_uri (const gchar *id) G_GNUC_WARN_UNUSED_RESULT;
 
 struct _GDataContactsContactPrivate {
 	gint64 edited;
 	GDataGDName *name;
-	GList *email_addresses; /* GDataGDEmailAddress */
-	GList *im_addresses; /* GDataGDIMAddress */
-	GList *phone_numbers; /* GDataGDPhoneNumber */
-	GList *postal_addresses; /* GDataGDPostalAddress */
-	GList *organizations; /* GDataGDOrganization */
+	GDataComparableList email_addresses; /* GDataGDEmailAddress */
+	GDataComparableList im_addresses; /* GDataGDIMAddress */
+	GDataComparableList phone_numbers; /* GDataGDPhoneNumber */
+	GDataComparableList postal_addresses; /* GDataGDPostalAddress */
+	GDataComparableList organizations; /* GDataGDOrganization */
 	GHashTable *extended_properties;
 	GHashTable *user_defined_fields;
 	GHashTable *groups;
@@ -193,10 +195,10 @@ struct _GDataContactsContactPrivate {
 	GDate birthday;
 	gboolean birthday_has_year; /* contacts can choose to just give the month and day of their birth */
 	GList *relations; /* GDataGContactRelation */
-	GList *websites; /* GDataGContactWebsite */
+	GDataComparableList websites; /* GDataGContactWebsite */
 	GList *events; /* GDataGContactEvent */
-	GList *calendars; /* GDataGContactCalendar */
-	GList *external_ids; /* GDataGContactExternalID */
+	GDataComparableList calendars; /* GDataGContactCalendar */
+	GDataComparableList external_ids; /* GDataGContactExternalID */
 	gchar *billing_information;
 	gchar *directory_server;
 	gchar *gender;
@@ -209,7 +211,7 @@ struct _GDataContactsContactPrivate {
 	gchar *short_name;
 	gchar *subject;
 	GList *hobbies; /* gchar* */
-	GList *languages; /* GDataGContactLanguage */
+	GDataComparableList languages; /* GDataGContactLanguage */
 };
 
 enum {
@@ -508,6 +510,26 @@ gdata_contacts_contact_class_init (GDataContactsContactClass *klass)
 	                                                      "Subject", "The subject of the contact.",
 	                                                      NULL,
 	                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	/* Elements to send in partial updates when the properties change */
+	_gdata_parsable_class_set_patch_name (parsable_class, "name", "gd:name");
+	_gdata_parsable_class_set_patch_name (parsable_class, "nickname", "gContact:nickname");
+	_gdata_parsable_class_set_patch_name (parsable_class, "file-as", "gContact:fileAs");
+	_gdata_parsable_class_set_patch_name (parsable_class, "birthday", "gContact:birthday");
+	_gdata_parsable_class_set_patch_name (parsable_class, "birthday-has-year", "gContact:birthday");
+	_gdata_parsable_class_set_patch_name (parsable_class, "billing-information", "gContact:billingInformation");
+	_gdata_parsable_class_set_patch_name (parsable_class, "directory-server", "gContact:directoryServer");
+	_gdata_parsable_class_set_patch_name (parsable_class, "gender", "gContact:gender");
+	_gdata_parsable_class_set_patch_name (parsable_class, "initials", "gContact:initials");
+	_gdata_parsable_class_set_patch_name (parsable_class, "maiden-name", "gContact:maidenName");
+	_gdata_parsable_class_set_patch_name (parsable_class, "mileage", "gContact:mileage");
+	_gdata_parsable_class_set_patch_name (parsable_class, "occupation", "gContact:occupation");
+	_gdata_parsable_class_set_patch_name (parsable_class, "priority", "gContact:priority");
+	_gdata_parsable_class_set_patch_name (parsable_class, "sensitivity", "gContact:sensitivity");
+	_gdata_parsable_class_set_patch_name (parsable_class, "short-name", "gContact:shortName");
+	_gdata_parsable_class_set_patch_name (parsable_class, "subject", "gContact:subject");
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static void notify_full_name_cb (GObject *gobject, GParamSpec *pspec, GDataContactsContact *self);
@@ -519,6 +541,8 @@ notify_title_cb (GObject *gobject, GParamSpec *pspec, GDataContactsContact *self
 	g_signal_handlers_block_by_func (self->priv->name, notify_full_name_cb, self);
 	gdata_gd_name_set_full_name (self->priv->name, gdata_entry_get_title (GDATA_ENTRY (self)));
 	g_signal_handlers_unblock_by_func (self->priv->name, notify_full_name_cb, self);
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gd:name");
 }
 
 static void
@@ -528,6 +552,8 @@ notify_full_name_cb (GObject *gobject, GParamSpec *pspec, GDataContactsContact *
 	g_signal_handlers_block_by_func (self, notify_title_cb, self);
 	gdata_entry_set_title (GDATA_ENTRY (self), gdata_gd_name_get_full_name (self->priv->name));
 	g_signal_handlers_unblock_by_func (self, notify_title_cb, self);
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gd:name");
 }
 
 static void
@@ -604,6 +630,9 @@ gdata_contacts_contact_dispose (GObject *object)
 		g_object_unref (self->priv->name);
 	self->priv->name = NULL;
 
+	/* Don't parse any elements deferred by lite parsing just to remove them again */
+	_gdata_parsable_discard_deferred (GDATA_PARSABLE (self));
+
 	gdata_contacts_contact_remove_all_organizations (self);
 	gdata_contacts_contact_remove_all_email_addresses (self);
 	gdata_contacts_contact_remove_all_im_addresses (self);
@@ -784,12 +813,36 @@ gdata_contacts_contact_set_property (GObject *object, guint property_id, const G
 	}
 }
 
+/* Whether @node is one of the multi-valued child elements which are deferred when parsing in lite mode. These account for most of the objects
+ * built when parsing a contact, but many callers never look at them. */
+static gboolean
+is_deferrable_element (xmlNode *node)
+{
+	if (gdata_parser_is_namespace (node, "http://schemas.google.com/g/2005") == TRUE) {
+		return (xmlStrcmp (node->name, (xmlChar*) "email") == 0 || xmlStrcmp (node->name, (xmlChar*) "im") == 0 ||
+		        xmlStrcmp (node->name, (xmlChar*) "phoneNumber") == 0 || xmlStrcmp (node->name, (xmlChar*) "structuredPostalAddress") == 0 ||
+		        xmlStrcmp (node->name, (xmlChar*) "organization") == 0) ? TRUE : FALSE;
+	} else if (gdata_parser_is_namespace (node, "http://schemas.google.com/contact/2008") == TRUE) {
+		return (xmlStrcmp (node->name, (xmlChar*) "jot") == 0 || xmlStrcmp (node->name, (xmlChar*) "relation") == 0 ||
+		        xmlStrcmp (node->name, (xmlChar*) "event") == 0 || xmlStrcmp (node->name, (xmlChar*) "website") == 0 ||
+		        xmlStrcmp (node->name, (xmlChar*) "calendarLink") == 0 || xmlStrcmp (node->name, (xmlChar*) "externalId") == 0 ||
+		        xmlStrcmp (node->name, (xmlChar*) "language") == 0) ? TRUE : FALSE;
+	}
+
+	return FALSE;
+}
+
 static gboolean
 parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *node, gpointer user_data, GError **error)
 {
 	gboolean success;
 	GDataContactsContact *self = GDATA_CONTACTS_CONTACT (parsable);
 
+	if (_gdata_parsable_is_lite (parsable) == TRUE && is_deferrable_element (node) == TRUE) {
+		_gdata_parsable_defer_xml (parsable, doc, node);
+		return TRUE;
+	}
+
 	if (gdata_parser_is_namespace (node, "http://www.w3.org/2007/app") == TRUE &&
 	    gdata_parser_int64_time_from_element (node, "edited", P_REQUIRED | P_NO_DUPES, &(self->priv->edited), &success, error) == TRUE) {
 		return success;
@@ -1117,18 +1170,18 @@ get_xml (GDataParsable *parsable, GString *xml_string)
 	_gdata_parsable_get_xml (GDATA_PARSABLE (priv->name), xml_string, FALSE);
 
 	/* Lists of stuff */
-	get_child_xml (priv->email_addresses, xml_string);
-	get_child_xml (priv->im_addresses, xml_string);
-	get_child_xml (priv->phone_numbers, xml_string);
-	get_child_xml (priv->postal_addresses, xml_string);
-	get_child_xml (priv->organizations, xml_string);
+	get_child_xml (priv->email_addresses.list, xml_string);
+	get_child_xml (priv->im_addresses.list, xml_string);
+	get_child_xml (priv->phone_numbers.list, xml_string);
+	get_child_xml (priv->postal_addresses.list, xml_string);
+	get_child_xml (priv->organizations.list, xml_string);
 	get_child_xml (priv->jots, xml_string);
 	get_child_xml (priv->relations, xml_string);
-	get_child_xml (priv->websites, xml_string);
+	get_child_xml (priv->websites.list, xml_string);
 	get_child_xml (priv->events, xml_string);
-	get_child_xml (priv->calendars, xml_string);
-	get_child_xml (priv->external_ids, xml_string);
-	get_child_xml (priv->languages, xml_string);
+	get_child_xml (priv->calendars.list, xml_string);
+	get_child_xml (priv->external_ids.list, xml_string);
+	get_child_xml (priv->languages.list, xml_string);
 
 	/* Extended properties */
 	g_hash_table_foreach (priv->extended_properties, (GHFunc) get_extended_property_xml_cb, xml_string);
@@ -1253,6 +1306,83 @@ get_entry_uri (const gchar *id)
 	return uri;
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	GDataContactsContactPrivate *priv = GDATA_CONTACTS_CONTACT (parsable)->priv;
+	GHashTableIter iter;
+	const gchar *href;
+	gpointer deleted;
+
+	gdata_binary_writer_put_int (writer, priv->edited);
+	gdata_binary_writer_put_boolean (writer, priv->deleted);
+	gdata_binary_writer_put_string (writer, priv->photo_etag);
+
+	gdata_binary_writer_put_parsable_list (writer, priv->email_addresses.list);
+	gdata_binary_writer_put_parsable_list (writer, priv->im_addresses.list);
+	gdata_binary_writer_put_parsable_list (writer, priv->phone_numbers.list);
+	gdata_binary_writer_put_parsable_list (writer, priv->postal_addresses.list);
+	gdata_binary_writer_put_parsable_list (writer, priv->organizations.list);
+	gdata_binary_writer_put_parsable_list (writer, priv->jots);
+	gdata_binary_writer_put_parsable_list (writer, priv->relations);
+	gdata_binary_writer_put_parsable_list (writer, priv->websites.list);
+	gdata_binary_writer_put_parsable_list (writer, priv->events);
+	gdata_binary_writer_put_parsable_list (writer, priv->calendars.list);
+	gdata_binary_writer_put_parsable_list (writer, priv->external_ids.list);
+	gdata_binary_writer_put_parsable_list (writer, priv->languages.list);
+	gdata_binary_writer_put_string_list (writer, priv->hobbies);
+
+	gdata_binary_writer_put_string_hash (writer, priv->extended_properties);
+	gdata_binary_writer_put_string_hash (writer, priv->user_defined_fields);
+
+	/* Group membership maps each group's URI to whether the contact has been removed from it */
+	gdata_binary_writer_put_uint (writer, g_hash_table_size (priv->groups));
+
+	g_hash_table_iter_init (&iter, priv->groups);
+	while (g_hash_table_iter_next (&iter, (gpointer*) &href, &deleted) == TRUE) {
+		gdata_binary_writer_put_string (writer, href);
+		gdata_binary_writer_put_boolean (writer, GPOINTER_TO_UINT (deleted));
+	}
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	GDataContactsContactPrivate *priv = GDATA_CONTACTS_CONTACT (parsable)->priv;
+	guint64 n_groups;
+
+	priv->edited = gdata_binary_reader_get_int (reader);
+	priv->deleted = gdata_binary_reader_get_boolean (reader);
+	priv->photo_etag = gdata_binary_reader_dup_string (reader);
+
+	_gdata_comparable_list_set (&priv->email_addresses, gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_GD_EMAIL_ADDRESS));
+	_gdata_comparable_list_set (&priv->im_addresses, gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_GD_IM_ADDRESS));
+	_gdata_comparable_list_set (&priv->phone_numbers, gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_GD_PHONE_NUMBER));
+	_gdata_comparable_list_set (&priv->postal_addresses, gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_GD_POSTAL_ADDRESS));
+	_gdata_comparable_list_set (&priv->organizations, gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_GD_ORGANIZATION));
+	priv->jots = gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_GCONTACT_JOT);
+	priv->relations = gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_GCONTACT_RELATION);
+	_gdata_comparable_list_set (&priv->websites, gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_GCONTACT_WEBSITE));
+	priv->events = gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_GCONTACT_EVENT);
+	_gdata_comparable_list_set (&priv->calendars, gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_GCONTACT_CALENDAR));
+	_gdata_comparable_list_set (&priv->external_ids, gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_GCONTACT_EXTERNAL_ID));
+	_gdata_comparable_list_set (&priv->languages, gdata_binary_reader_get_parsable_list (reader, GDATA_TYPE_GCONTACT_LANGUAGE));
+	priv->hobbies = gdata_binary_reader_get_string_list (reader);
+
+	gdata_binary_reader_get_string_hash (reader, priv->extended_properties);
+	gdata_binary_reader_get_string_hash (reader, priv->user_defined_fields);
+
+	n_groups = gdata_binary_reader_get_uint (reader);
+
+	for (; n_groups > 0 && gdata_binary_reader_failed (reader) == FALSE; n_groups--) {
+		const gchar *href = gdata_binary_reader_get_string (reader);
+		gboolean deleted = gdata_binary_reader_get_boolean (reader);
+
+		if (href != NULL)
+			g_hash_table_insert (priv->groups, g_strdup (href), GUINT_TO_POINTER (deleted));
+	}
+}
+
 /**
  * gdata_contacts_contact_new:
  * @id: (allow-none): the contact's ID, or %NULL
@@ -1323,6 +1453,7 @@ gdata_contacts_contact_set_name (GDataContactsContact *self, GDataGDName *name)
 	if (self->priv->name != NULL)
 		g_object_unref (self->priv->name);
 	self->priv->name = g_object_ref (name);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "name");
 	g_object_notify (G_OBJECT (self), "name");
 
 	/* Notify the change in #GDataGDName:full-name explicitly, so that our #GDataEntry:title gets updated */
@@ -1364,6 +1495,7 @@ gdata_contacts_contact_set_nickname (GDataContactsContact *self, const gchar *ni
 
 	g_free (self->priv->nickname);
 	self->priv->nickname = g_strdup (nickname);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "nickname");
 	g_object_notify (G_OBJECT (self), "nickname");
 }
 
@@ -1402,6 +1534,7 @@ gdata_contacts_contact_set_file_as (GDataContactsContact *self, const gchar *fil
 
 	g_free (self->priv->file_as);
 	self->priv->file_as = g_strdup (file_as);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "file-as");
 	g_object_notify (G_OBJECT (self), "file-as");
 }
 
@@ -1456,7 +1589,9 @@ gdata_contacts_contact_set_birthday (GDataContactsContact *self, GDate *birthday
 	self->priv->birthday_has_year = birthday_has_year;
 
 	g_object_freeze_notify (G_OBJECT (self));
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "birthday");
 	g_object_notify (G_OBJECT (self), "birthday");
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "birthday-has-year");
 	g_object_notify (G_OBJECT (self), "birthday-has-year");
 	g_object_thaw_notify (G_OBJECT (self));
 }
@@ -1497,6 +1632,7 @@ gdata_contacts_contact_set_billing_information (GDataContactsContact *self, cons
 
 	g_free (self->priv->billing_information);
 	self->priv->billing_information = g_strdup (billing_information);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "billing-information");
 	g_object_notify (G_OBJECT (self), "billing-information");
 }
 
@@ -1536,6 +1672,7 @@ gdata_contacts_contact_set_directory_server (GDataContactsContact *self, const g
 
 	g_free (self->priv->directory_server);
 	self->priv->directory_server = g_strdup (directory_server);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "directory-server");
 	g_object_notify (G_OBJECT (self), "directory-server");
 }
 
@@ -1575,6 +1712,7 @@ gdata_contacts_contact_set_gender (GDataContactsContact *self, const gchar *gend
 
 	g_free (self->priv->gender);
 	self->priv->gender = g_strdup (gender);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "gender");
 	g_object_notify (G_OBJECT (self), "gender");
 }
 
@@ -1613,6 +1751,7 @@ gdata_contacts_contact_set_initials (GDataContactsContact *self, const gchar *in
 
 	g_free (self->priv->initials);
 	self->priv->initials = g_strdup (initials);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "initials");
 	g_object_notify (G_OBJECT (self), "initials");
 }
 
@@ -1651,6 +1790,7 @@ gdata_contacts_contact_set_maiden_name (GDataContactsContact *self, const gchar
 
 	g_free (self->priv->maiden_name);
 	self->priv->maiden_name = g_strdup (maiden_name);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "maiden-name");
 	g_object_notify (G_OBJECT (self), "maiden-name");
 }
 
@@ -1689,6 +1829,7 @@ gdata_contacts_contact_set_mileage (GDataContactsContact *self, const gchar *mil
 
 	g_free (self->priv->mileage);
 	self->priv->mileage = g_strdup (mileage);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "mileage");
 	g_object_notify (G_OBJECT (self), "mileage");
 }
 
@@ -1727,6 +1868,7 @@ gdata_contacts_contact_set_occupation (GDataContactsContact *self, const gchar *
 
 	g_free (self->priv->occupation);
 	self->priv->occupation = g_strdup (occupation);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "occupation");
 	g_object_notify (G_OBJECT (self), "occupation");
 }
 
@@ -1766,6 +1908,7 @@ gdata_contacts_contact_set_priority (GDataContactsContact *self, const gchar *pr
 
 	g_free (self->priv->priority);
 	self->priv->priority = g_strdup (priority);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "priority");
 	g_object_notify (G_OBJECT (self), "priority");
 }
 
@@ -1805,6 +1948,7 @@ gdata_contacts_contact_set_sensitivity (GDataContactsContact *self, const gchar
 
 	g_free (self->priv->sensitivity);
 	self->priv->sensitivity = g_strdup (sensitivity);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "sensitivity");
 	g_object_notify (G_OBJECT (self), "sensitivity");
 }
 
@@ -1843,6 +1987,7 @@ gdata_contacts_contact_set_short_name (GDataContactsContact *self, const gchar *
 
 	g_free (self->priv->short_name);
 	self->priv->short_name = g_strdup (short_name);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "short-name");
 	g_object_notify (G_OBJECT (self), "short-name");
 }
 
@@ -1881,6 +2026,7 @@ gdata_contacts_contact_set_subject (GDataContactsContact *self, const gchar *sub
 
 	g_free (self->priv->subject);
 	self->priv->subject = g_strdup (subject);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "subject");
 	g_object_notify (G_OBJECT (self), "subject");
 }
 
@@ -1905,8 +2051,11 @@ gdata_contacts_contact_add_email_address (GDataContactsContact *self, GDataGDEma
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 	g_return_if_fail (GDATA_IS_GD_EMAIL_ADDRESS (email_address));
 
-	if (g_list_find_custom (self->priv->email_addresses, email_address, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->email_addresses = g_list_append (self->priv->email_addresses, g_object_ref (email_address));
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	/* Only mark the field as changed if the item wasn't a duplicate */
+	if (_gdata_comparable_list_add (&self->priv->email_addresses, GDATA_COMPARABLE (email_address), FALSE) == TRUE)
+		_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gd:email");
 }
 
 /**
@@ -1923,7 +2072,10 @@ GList *
 gdata_contacts_contact_get_email_addresses (GDataContactsContact *self)
 {
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
-	return self->priv->email_addresses;
+
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	return self->priv->email_addresses.list;
 }
 
 /**
@@ -1943,7 +2095,9 @@ gdata_contacts_contact_get_primary_email_address (GDataContactsContact *self)
 
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
 
-	for (i = self->priv->email_addresses; i != NULL; i = i->next) {
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	for (i = self->priv->email_addresses.list; i != NULL; i = i->next) {
 		if (gdata_gd_email_address_is_primary (GDATA_GD_EMAIL_ADDRESS (i->data)) == TRUE)
 			return GDATA_GD_EMAIL_ADDRESS (i->data);
 	}
@@ -1966,11 +2120,11 @@ gdata_contacts_contact_remove_all_email_addresses (GDataContactsContact *self)
 
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 
-	if (priv->email_addresses != NULL) {
-		g_list_foreach (priv->email_addresses, (GFunc) g_object_unref, NULL);
-		g_list_free (priv->email_addresses);
-	}
-	priv->email_addresses = NULL;
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gd:email");
+
+	_gdata_comparable_list_clear (&priv->email_addresses);
 }
 
 /**
@@ -1994,8 +2148,10 @@ gdata_contacts_contact_add_im_address (GDataContactsContact *self, GDataGDIMAddr
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 	g_return_if_fail (GDATA_IS_GD_IM_ADDRESS (im_address));
 
-	if (g_list_find_custom (self->priv->im_addresses, im_address, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->im_addresses = g_list_append (self->priv->im_addresses, g_object_ref (im_address));
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	if (_gdata_comparable_list_add (&self->priv->im_addresses, GDATA_COMPARABLE (im_address), FALSE) == TRUE)
+		_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gd:im");
 }
 
 /**
@@ -2012,7 +2168,10 @@ GList *
 gdata_contacts_contact_get_im_addresses (GDataContactsContact *self)
 {
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
-	return self->priv->im_addresses;
+
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	return self->priv->im_addresses.list;
 }
 
 /**
@@ -2032,7 +2191,9 @@ gdata_contacts_contact_get_primary_im_address (GDataContactsContact *self)
 
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
 
-	for (i = self->priv->im_addresses; i != NULL; i = i->next) {
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	for (i = self->priv->im_addresses.list; i != NULL; i = i->next) {
 		if (gdata_gd_im_address_is_primary (GDATA_GD_IM_ADDRESS (i->data)) == TRUE)
 			return GDATA_GD_IM_ADDRESS (i->data);
 	}
@@ -2055,11 +2216,11 @@ gdata_contacts_contact_remove_all_im_addresses (GDataContactsContact *self)
 
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 
-	if (priv->im_addresses != NULL) {
-		g_list_foreach (priv->im_addresses, (GFunc) g_object_unref, NULL);
-		g_list_free (priv->im_addresses);
-	}
-	priv->im_addresses = NULL;
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gd:im");
+
+	_gdata_comparable_list_clear (&priv->im_addresses);
 }
 
 /**
@@ -2083,8 +2244,10 @@ gdata_contacts_contact_add_phone_number (GDataContactsContact *self, GDataGDPhon
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 	g_return_if_fail (GDATA_IS_GD_PHONE_NUMBER (phone_number));
 
-	if (g_list_find_custom (self->priv->phone_numbers, phone_number, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->phone_numbers = g_list_append (self->priv->phone_numbers, g_object_ref (phone_number));
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	if (_gdata_comparable_list_add (&self->priv->phone_numbers, GDATA_COMPARABLE (phone_number), FALSE) == TRUE)
+		_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gd:phoneNumber");
 }
 
 /**
@@ -2101,7 +2264,10 @@ GList *
 gdata_contacts_contact_get_phone_numbers (GDataContactsContact *self)
 {
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
-	return self->priv->phone_numbers;
+
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	return self->priv->phone_numbers.list;
 }
 
 /**
@@ -2121,7 +2287,9 @@ gdata_contacts_contact_get_primary_phone_number (GDataContactsContact *self)
 
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
 
-	for (i = self->priv->phone_numbers; i != NULL; i = i->next) {
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	for (i = self->priv->phone_numbers.list; i != NULL; i = i->next) {
 		if (gdata_gd_phone_number_is_primary (GDATA_GD_PHONE_NUMBER (i->data)) == TRUE)
 			return GDATA_GD_PHONE_NUMBER (i->data);
 	}
@@ -2144,11 +2312,11 @@ gdata_contacts_contact_remove_all_phone_numbers (GDataContactsContact *self)
 
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 
-	if (priv->phone_numbers != NULL) {
-		g_list_foreach (priv->phone_numbers, (GFunc) g_object_unref, NULL);
-		g_list_free (priv->phone_numbers);
-	}
-	priv->phone_numbers = NULL;
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gd:phoneNumber");
+
+	_gdata_comparable_list_clear (&priv->phone_numbers);
 }
 
 /**
@@ -2172,8 +2340,10 @@ gdata_contacts_contact_add_postal_address (GDataContactsContact *self, GDataGDPo
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 	g_return_if_fail (GDATA_IS_GD_POSTAL_ADDRESS (postal_address));
 
-	if (g_list_find_custom (self->priv->postal_addresses, postal_address, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->postal_addresses = g_list_append (self->priv->postal_addresses, g_object_ref (postal_address));
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	if (_gdata_comparable_list_add (&self->priv->postal_addresses, GDATA_COMPARABLE (postal_address), FALSE) == TRUE)
+		_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gd:structuredPostalAddress");
 }
 
 /**
@@ -2190,7 +2360,10 @@ GList *
 gdata_contacts_contact_get_postal_addresses (GDataContactsContact *self)
 {
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
-	return self->priv->postal_addresses;
+
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	return self->priv->postal_addresses.list;
 }
 
 /**
@@ -2210,7 +2383,9 @@ gdata_contacts_contact_get_primary_postal_address (GDataContactsContact *self)
 
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
 
-	for (i = self->priv->postal_addresses; i != NULL; i = i->next) {
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	for (i = self->priv->postal_addresses.list; i != NULL; i = i->next) {
 		if (gdata_gd_postal_address_is_primary (GDATA_GD_POSTAL_ADDRESS (i->data)) == TRUE)
 			return GDATA_GD_POSTAL_ADDRESS (i->data);
 	}
@@ -2233,11 +2408,11 @@ gdata_contacts_contact_remove_all_postal_addresses (GDataContactsContact *self)
 
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 
-	if (priv->postal_addresses != NULL) {
-		g_list_foreach (priv->postal_addresses, (GFunc) g_object_unref, NULL);
-		g_list_free (priv->postal_addresses);
-	}
-	priv->postal_addresses = NULL;
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gd:structuredPostalAddress");
+
+	_gdata_comparable_list_clear (&priv->postal_addresses);
 }
 
 /**
@@ -2261,8 +2436,10 @@ gdata_contacts_contact_add_organization (GDataContactsContact *self, GDataGDOrga
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 	g_return_if_fail (organization != NULL);
 
-	if (g_list_find_custom (self->priv->organizations, organization, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->organizations = g_list_append (self->priv->organizations, g_object_ref (organization));
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	if (_gdata_comparable_list_add (&self->priv->organizations, GDATA_COMPARABLE (organization), FALSE) == TRUE)
+		_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gd:organization");
 }
 
 /**
@@ -2279,7 +2456,10 @@ GList *
 gdata_contacts_contact_get_organizations (GDataContactsContact *self)
 {
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
-	return self->priv->organizations;
+
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	return self->priv->organizations.list;
 }
 
 /**
@@ -2299,7 +2479,9 @@ gdata_contacts_contact_get_primary_organization (GDataContactsContact *self)
 
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
 
-	for (i = self->priv->organizations; i != NULL; i = i->next) {
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	for (i = self->priv->organizations.list; i != NULL; i = i->next) {
 		if (gdata_gd_organization_is_primary (GDATA_GD_ORGANIZATION (i->data)) == TRUE)
 			return GDATA_GD_ORGANIZATION (i->data);
 	}
@@ -2322,11 +2504,11 @@ gdata_contacts_contact_remove_all_organizations (GDataContactsContact *self)
 
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 
-	if (priv->organizations != NULL) {
-		g_list_foreach (priv->organizations, (GFunc) g_object_unref, NULL);
-		g_list_free (priv->organizations);
-	}
-	priv->organizations = NULL;
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gd:organization");
+
+	_gdata_comparable_list_clear (&priv->organizations);
 }
 
 /**
@@ -2346,6 +2528,10 @@ gdata_contacts_contact_add_jot (GDataContactsContact *self, GDataGContactJot *jo
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 	g_return_if_fail (GDATA_IS_GCONTACT_JOT (jot));
 
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:jot");
+
 	self->priv->jots = g_list_append (self->priv->jots, g_object_ref (jot));
 }
 
@@ -2363,6 +2549,9 @@ GList *
 gdata_contacts_contact_get_jots (GDataContactsContact *self)
 {
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
+
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
 	return self->priv->jots;
 }
 
@@ -2381,6 +2570,10 @@ gdata_contacts_contact_remove_all_jots (GDataContactsContact *self)
 
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:jot");
+
 	if (priv->jots != NULL) {
 		g_list_foreach (priv->jots, (GFunc) g_object_unref, NULL);
 		g_list_free (priv->jots);
@@ -2406,6 +2599,10 @@ gdata_contacts_contact_add_relation (GDataContactsContact *self, GDataGContactRe
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 	g_return_if_fail (GDATA_IS_GCONTACT_RELATION (relation));
 
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:relation");
+
 	self->priv->relations = g_list_append (self->priv->relations, g_object_ref (relation));
 }
 
@@ -2423,6 +2620,9 @@ GList *
 gdata_contacts_contact_get_relations (GDataContactsContact *self)
 {
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
+
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
 	return self->priv->relations;
 }
 
@@ -2441,6 +2641,10 @@ gdata_contacts_contact_remove_all_relations (GDataContactsContact *self)
 
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:relation");
+
 	if (priv->relations != NULL) {
 		g_list_foreach (priv->relations, (GFunc) g_object_unref, NULL);
 		g_list_free (priv->relations);
@@ -2466,8 +2670,10 @@ gdata_contacts_contact_add_website (GDataContactsContact *self, GDataGContactWeb
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 	g_return_if_fail (GDATA_IS_GCONTACT_WEBSITE (website));
 
-	if (g_list_find_custom (self->priv->websites, website, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->websites = g_list_append (self->priv->websites, g_object_ref (website));
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	if (_gdata_comparable_list_add (&self->priv->websites, GDATA_COMPARABLE (website), FALSE) == TRUE)
+		_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:website");
 }
 
 /**
@@ -2484,7 +2690,10 @@ GList *
 gdata_contacts_contact_get_websites (GDataContactsContact *self)
 {
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
-	return self->priv->websites;
+
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	return self->priv->websites.list;
 }
 
 /**
@@ -2504,7 +2713,9 @@ gdata_contacts_contact_get_primary_website (GDataContactsContact *self)
 
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
 
-	for (i = self->priv->websites; i != NULL; i = i->next) {
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	for (i = self->priv->websites.list; i != NULL; i = i->next) {
 		if (gdata_gcontact_website_is_primary (GDATA_GCONTACT_WEBSITE (i->data)) == TRUE)
 			return GDATA_GCONTACT_WEBSITE (i->data);
 	}
@@ -2527,11 +2738,11 @@ gdata_contacts_contact_remove_all_websites (GDataContactsContact *self)
 
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 
-	if (priv->websites != NULL) {
-		g_list_foreach (priv->websites, (GFunc) g_object_unref, NULL);
-		g_list_free (priv->websites);
-	}
-	priv->websites = NULL;
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:website");
+
+	_gdata_comparable_list_clear (&priv->websites);
 }
 
 /**
@@ -2552,6 +2763,10 @@ gdata_contacts_contact_add_event (GDataContactsContact *self, GDataGContactEvent
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 	g_return_if_fail (GDATA_IS_GCONTACT_EVENT (event));
 
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:event");
+
 	self->priv->events = g_list_append (self->priv->events, g_object_ref (event));
 }
 
@@ -2569,6 +2784,9 @@ GList *
 gdata_contacts_contact_get_events (GDataContactsContact *self)
 {
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
+
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
 	return self->priv->events;
 }
 
@@ -2587,6 +2805,10 @@ gdata_contacts_contact_remove_all_events (GDataContactsContact *self)
 
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:event");
+
 	if (priv->events != NULL) {
 		g_list_foreach (priv->events, (GFunc) g_object_unref, NULL);
 		g_list_free (priv->events);
@@ -2612,8 +2834,10 @@ gdata_contacts_contact_add_calendar (GDataContactsContact *self, GDataGContactCa
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 	g_return_if_fail (GDATA_IS_GCONTACT_CALENDAR (calendar));
 
-	if (g_list_find_custom (self->priv->calendars, calendar, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->calendars = g_list_append (self->priv->calendars, g_object_ref (calendar));
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	if (_gdata_comparable_list_add (&self->priv->calendars, GDATA_COMPARABLE (calendar), FALSE) == TRUE)
+		_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:calendarLink");
 }
 
 /**
@@ -2630,7 +2854,10 @@ GList *
 gdata_contacts_contact_get_calendars (GDataContactsContact *self)
 {
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
-	return self->priv->calendars;
+
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	return self->priv->calendars.list;
 }
 
 /**
@@ -2650,7 +2877,9 @@ gdata_contacts_contact_get_primary_calendar (GDataContactsContact *self)
 
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
 
-	for (i = self->priv->calendars; i != NULL; i = i->next) {
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	for (i = self->priv->calendars.list; i != NULL; i = i->next) {
 		if (gdata_gcontact_calendar_is_primary (GDATA_GCONTACT_CALENDAR (i->data)) == TRUE)
 			return GDATA_GCONTACT_CALENDAR (i->data);
 	}
@@ -2673,11 +2902,11 @@ gdata_contacts_contact_remove_all_calendars (GDataContactsContact *self)
 
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 
-	if (priv->calendars != NULL) {
-		g_list_foreach (priv->calendars, (GFunc) g_object_unref, NULL);
-		g_list_free (priv->calendars);
-	}
-	priv->calendars = NULL;
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:calendarLink");
+
+	_gdata_comparable_list_clear (&priv->calendars);
 }
 
 /**
@@ -2697,8 +2926,10 @@ gdata_contacts_contact_add_external_id (GDataContactsContact *self, GDataGContac
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 	g_return_if_fail (GDATA_IS_GCONTACT_EXTERNAL_ID (external_id));
 
-	if (g_list_find_custom (self->priv->external_ids, external_id, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->external_ids = g_list_append (self->priv->external_ids, g_object_ref (external_id));
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	if (_gdata_comparable_list_add (&self->priv->external_ids, GDATA_COMPARABLE (external_id), FALSE) == TRUE)
+		_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:externalId");
 }
 
 /**
@@ -2715,7 +2946,10 @@ GList *
 gdata_contacts_contact_get_external_ids (GDataContactsContact *self)
 {
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
-	return self->priv->external_ids;
+
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	return self->priv->external_ids.list;
 }
 
 /**
@@ -2733,11 +2967,11 @@ gdata_contacts_contact_remove_all_external_ids (GDataContactsContact *self)
 
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 
-	if (priv->external_ids != NULL) {
-		g_list_foreach (priv->external_ids, (GFunc) g_object_unref, NULL);
-		g_list_free (priv->external_ids);
-	}
-	priv->external_ids = NULL;
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:externalId");
+
+	_gdata_comparable_list_clear (&priv->external_ids);
 }
 
 /**
@@ -2757,8 +2991,10 @@ gdata_contacts_contact_add_hobby (GDataContactsContact *self, const gchar *hobby
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 	g_return_if_fail (hobby != NULL && *hobby != '\0');
 
-	if (g_list_find_custom (self->priv->hobbies, hobby, (GCompareFunc) g_strcmp0) == NULL)
+	if (g_list_find_custom (self->priv->hobbies, hobby, (GCompareFunc) g_strcmp0) == NULL) {
 		self->priv->hobbies = g_list_append (self->priv->hobbies, g_strdup (hobby));
+		_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:hobby");
+	}
 }
 
 /**
@@ -2793,6 +3029,8 @@ gdata_contacts_contact_remove_all_hobbies (GDataContactsContact *self)
 
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:hobby");
+
 	if (priv->hobbies != NULL) {
 		g_list_foreach (priv->hobbies, (GFunc) g_free, NULL);
 		g_list_free (priv->hobbies);
@@ -2817,8 +3055,10 @@ gdata_contacts_contact_add_language (GDataContactsContact *self, GDataGContactLa
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 	g_return_if_fail (GDATA_IS_GCONTACT_LANGUAGE (language));
 
-	if (g_list_find_custom (self->priv->languages, language, (GCompareFunc) gdata_comparable_compare) == NULL)
-		self->priv->languages = g_list_append (self->priv->languages, g_object_ref (language));
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	if (_gdata_comparable_list_add (&self->priv->languages, GDATA_COMPARABLE (language), FALSE) == TRUE)
+		_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:language");
 }
 
 /**
@@ -2835,7 +3075,10 @@ GList *
 gdata_contacts_contact_get_languages (GDataContactsContact *self)
 {
 	g_return_val_if_fail (GDATA_IS_CONTACTS_CONTACT (self), NULL);
-	return self->priv->languages;
+
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	return self->priv->languages.list;
 }
 
 /**
@@ -2853,11 +3096,11 @@ gdata_contacts_contact_remove_all_languages (GDataContactsContact *self)
 
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 
-	if (priv->languages != NULL) {
-		g_list_foreach (priv->languages, (GFunc) g_object_unref, NULL);
-		g_list_free (priv->languages);
-	}
-	priv->languages = NULL;
+	_gdata_parsable_materialise (GDATA_PARSABLE (self));
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:language");
+
+	_gdata_comparable_list_clear (&priv->languages);
 }
 
 /**
@@ -2927,7 +3170,8 @@ gdata_contacts_contact_set_extended_property (GDataContactsContact *self, const
 
 	if (value == NULL || *value == '\0') {
 		/* Removing a property */
-		g_hash_table_remove (extended_properties, name);
+		if (g_hash_table_remove (extended_properties, name) == TRUE)
+			_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gd:extendedProperty");
 		return TRUE;
 	}
 
@@ -2938,6 +3182,7 @@ gdata_contacts_contact_set_extended_property (GDataContactsContact *self, const
 
 	/* Updating an existing property or adding a new one */
 	g_hash_table_insert (extended_properties, g_strdup (name), g_strdup (value));
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gd:extendedProperty");
 
 	return TRUE;
 }
@@ -3002,6 +3247,8 @@ gdata_contacts_contact_set_user_defined_field (GDataContactsContact *self, const
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 	g_return_if_fail (name != NULL);
 
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:userDefinedField");
+
 	if (value == NULL) {
 		/* Removing a field */
 		g_hash_table_remove (self->priv->user_defined_fields, name);
@@ -3025,6 +3272,8 @@ gdata_contacts_contact_add_group (GDataContactsContact *self, const gchar *href)
 {
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 	g_return_if_fail (href != NULL);
+
+	_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:groupMembershipInfo");
 	g_hash_table_insert (self->priv->groups, g_strdup (href), GUINT_TO_POINTER (FALSE));
 }
 
@@ -3042,7 +3291,9 @@ gdata_contacts_contact_remove_group (GDataContactsContact *self, const gchar *hr
 {
 	g_return_if_fail (GDATA_IS_CONTACTS_CONTACT (self));
 	g_return_if_fail (href != NULL);
-	g_hash_table_remove (self->priv->groups, href);
+
+	if (g_hash_table_remove (self->priv->groups, href) == TRUE)
+		_gdata_parsable_mark_dirty (GDATA_PARSABLE (self), "gContact:groupMembershipInfo");
 }
 
 /**
@@ -3190,6 +3441,7 @@ gdata_contacts_contact_get_photo (GDataContactsContact *self, GDataContactsServi
 	g_assert (_link != NULL);
 	message = _gdata_service_build_message (GDATA_SERVICE (service), gdata_contacts_service_get_primary_authorization_domain (),
 	                                        SOUP_METHOD_GET, gdata_link_get_uri (_link), NULL, FALSE);
+	_gdata_service_set_message_operation_type (message, GDATA_OPERATION_DOWNLOAD);
 
 	/* Send the message */
 	status = _gdata_service_send_message (GDATA_SERVICE (service), message, cancellable, error);
@@ -3415,8 +3667,10 @@ gdata_contacts_contact_set_photo (GDataContactsContact *self, GDataContactsServi
 	                                        gdata_link_get_uri (_link), etag, TRUE);
 
 	/* Append the data */
-	if (deleting_photo == FALSE)
+	if (deleting_photo == FALSE) {
 		soup_message_set_request (message, content_type, SOUP_MEMORY_STATIC, (gchar*) data, length);
+		_gdata_service_set_message_operation_type (message, GDATA_OPERATION_UPLOAD);
+	}
 
 	/* Send the message */
 	status = _gdata_service_send_message (GDATA_SERVICE (service), message, cancellable, error);
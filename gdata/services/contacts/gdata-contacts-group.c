@@ -115,6 +115,8 @@ static void gdata_contacts_group_finalize (GObject *object);
 static void get_xml (GDataParsable *parsable, GString *xml_string);
 static gboolean parse_xml (GDataParsable *parsable, xmlDoc *doc, xmlNode *node, gpointer user_data, GError **error);
 static void get_namespaces (GDataParsable *parsable, GHashTable *namespaces);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 static gchar *get_entry_uri (const gchar *id) G_GNUC_WARN_UNUSED_RESULT;
 
 struct _GDataContactsGroupPrivate {
@@ -200,6 +202,8 @@ gdata_contacts_group_class_init (GDataContactsGroupClass *klass)
 	                                                      "System group ID", "The system group ID for this group, if it's a system group.",
 	                                                      NULL,
 	                                                      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static void notify_content_cb (GObject *gobject, GParamSpec *pspec, GDataContactsGroup *self);
@@ -449,6 +453,28 @@ get_entry_uri (const gchar *id)
 	return uri;
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	GDataContactsGroupPrivate *priv = GDATA_CONTACTS_GROUP (parsable)->priv;
+
+	gdata_binary_writer_put_int (writer, priv->edited);
+	gdata_binary_writer_put_boolean (writer, priv->deleted);
+	gdata_binary_writer_put_string (writer, priv->system_group_id);
+	gdata_binary_writer_put_string_hash (writer, priv->extended_properties);
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	GDataContactsGroupPrivate *priv = GDATA_CONTACTS_GROUP (parsable)->priv;
+
+	priv->edited = gdata_binary_reader_get_int (reader);
+	priv->deleted = gdata_binary_reader_get_boolean (reader);
+	priv->system_group_id = gdata_binary_reader_dup_string (reader);
+	gdata_binary_reader_get_string_hash (reader, priv->extended_properties);
+}
+
 /**
  * gdata_contacts_group_new:
  * @id: (allow-none): the group's ID, or %NULL
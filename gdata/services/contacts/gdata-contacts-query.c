@@ -483,3 +483,55 @@ gdata_contacts_query_set_group (GDataContactsQuery *self, const gchar *group)
 	/* Our current ETag will no longer be relevant */
 	gdata_query_set_etag (GDATA_QUERY (self), NULL);
 }
+
+/**
+ * gdata_contacts_query_set_field_mask:
+ * @self: a #GDataContactsQuery
+ * @fields: the entry fields to request
+ *
+ * Sets the #GDataQuery:fields property of the #GDataContactsQuery to a partial-response selector which requests only the given @fields
+ * of each contact (or group), plus the feed's total result count so that progress reporting keeps working. For example, a mask of
+ * %GDATA_QUERY_FIELDS_ID | %GDATA_QUERY_FIELDS_ETAG | %GDATA_QUERY_FIELDS_UPDATED is enough to work out which contacts have changed.
+ *
+ * %GDATA_QUERY_FIELDS_DELETED maps to the <code class="literal">gd:deleted</code> element, and is only useful in conjunction with
+ * #GDataContactsQuery:show-deleted.
+ *
+ * Pass <code class="literal">0</code> as @fields to unset the property and request full entries again.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_contacts_query_set_field_mask (GDataContactsQuery *self, GDataQueryFields fields)
+{
+	GString *selector;
+
+	g_return_if_fail (GDATA_IS_CONTACTS_QUERY (self));
+
+	fields &= GDATA_QUERY_FIELDS_ID | GDATA_QUERY_FIELDS_ETAG | GDATA_QUERY_FIELDS_UPDATED | GDATA_QUERY_FIELDS_TITLE |
+	          GDATA_QUERY_FIELDS_DELETED;
+
+	if (fields == 0) {
+		gdata_query_set_fields (GDATA_QUERY (self), NULL);
+		return;
+	}
+
+	/* See: https://developers.google.com/google-apps/contacts/v3/reference#Parameters */
+	selector = g_string_new ("openSearch:totalResults,entry(");
+
+	if (fields & GDATA_QUERY_FIELDS_ETAG)
+		g_string_append (selector, "@gd:etag,");
+	if (fields & GDATA_QUERY_FIELDS_ID)
+		g_string_append (selector, "id,");
+	if (fields & GDATA_QUERY_FIELDS_UPDATED)
+		g_string_append (selector, "updated,");
+	if (fields & GDATA_QUERY_FIELDS_TITLE)
+		g_string_append (selector, "title,");
+	if (fields & GDATA_QUERY_FIELDS_DELETED)
+		g_string_append (selector, "gd:deleted,");
+
+	/* Replace the trailing comma */
+	selector->str[selector->len - 1] = ')';
+
+	gdata_query_set_fields (GDATA_QUERY (self), selector->str);
+	g_string_free (selector, TRUE);
+}
@@ -79,6 +79,7 @@ const gchar *gdata_contacts_query_get_sort_order (GDataContactsQuery *self) G_GN
 void gdata_contacts_query_set_sort_order (GDataContactsQuery *self, const gchar *sort_order);
 const gchar *gdata_contacts_query_get_group (GDataContactsQuery *self) G_GNUC_PURE;
 void gdata_contacts_query_set_group (GDataContactsQuery *self, const gchar *group);
+void gdata_contacts_query_set_field_mask (GDataContactsQuery *self, GDataQueryFields fields);
 
 G_END_DECLS
 
@@ -156,6 +156,7 @@
 #include "gdata-service.h"
 #include "gdata-private.h"
 #include "gdata-query.h"
+#include "gdata-contacts-query.h"
 
 static GList *get_authorization_domains (void);
 
@@ -319,6 +320,50 @@ gdata_contacts_service_query_contacts_async (GDataContactsService *self, GDataQu
 	g_free (request_uri);
 }
 
+static gboolean
+contact_is_deleted (GDataEntry *entry)
+{
+	return gdata_contacts_contact_is_deleted (GDATA_CONTACTS_CONTACT (entry));
+}
+
+/**
+ * gdata_contacts_service_create_sync_session:
+ * @self: a #GDataContactsService
+ *
+ * Creates a #GDataSyncSession for keeping a local copy of the authenticated user's contacts up to date.
+ *
+ * The session's cursor is the latest update time of the contacts it has seen, and changes are queried using the
+ * <ulink type="http" url="https://developers.google.com/google-apps/contacts/v3/#retrieving_all_contacts"><code class="literal">updated-min</code>
+ * and <code class="literal">showdeleted</code> parameters</ulink>. Google Contacts only keeps deleted contacts for 30 days, so a session which
+ * hasn't been run for longer than that will do a full synchronisation.
+ *
+ * Return value: (transfer full): a new #GDataSyncSession; unref with g_object_unref()
+ *
+ * Since: 0.17.9
+ */
+GDataSyncSession *
+gdata_contacts_service_create_sync_session (GDataContactsService *self)
+{
+	GDataContactsQuery *query;
+	GDataSyncSession *session;
+	gchar *request_uri;
+
+	g_return_val_if_fail (GDATA_IS_CONTACTS_SERVICE (self), NULL);
+
+	/* Deleted contacts have to be included so that deletions can be reported */
+	query = gdata_contacts_query_new (NULL);
+	gdata_query_set_max_results (GDATA_QUERY (query), 500);
+	gdata_contacts_query_set_show_deleted (query, TRUE);
+
+	request_uri = g_strconcat (_gdata_service_get_scheme (), "://www.google.com/m8/feeds/contacts/default/full", NULL);
+	session = _gdata_sync_session_new (GDATA_SERVICE (self), get_contacts_authorization_domain (), request_uri, GDATA_QUERY (query),
+	                                   GDATA_TYPE_CONTACTS_CONTACT, NULL, contact_is_deleted);
+	g_free (request_uri);
+	g_object_unref (query);
+
+	return session;
+}
+
 /**
  * gdata_contacts_service_insert_contact:
  * @self: a #GDataContactsService
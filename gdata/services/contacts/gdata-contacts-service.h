@@ -25,6 +25,7 @@
 
 #include <gdata/gdata-service.h>
 #include <gdata/gdata-query.h>
+#include <gdata/gdata-sync-session.h>
 
 G_BEGIN_DECLS
 
@@ -83,6 +84,8 @@ void gdata_contacts_service_query_contacts_async (GDataContactsService *self, GD
                                                   GDestroyNotify destroy_progress_user_data,
                                                   GAsyncReadyCallback callback, gpointer user_data);
 
+GDataSyncSession *gdata_contacts_service_create_sync_session (GDataContactsService *self) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+
 #include <gdata/services/contacts/gdata-contacts-contact.h>
 
 GDataContactsContact *gdata_contacts_service_insert_contact (GDataContactsService *self, GDataContactsContact *contact,
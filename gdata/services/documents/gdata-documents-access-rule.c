@@ -62,6 +62,8 @@ gdata_documents_access_rule_class_init (GDataDocumentsAccessRuleClass *klass)
 	parsable_class->post_parse_json = post_parse_json;
 	parsable_class->get_content_type = get_content_type;
 	parsable_class->get_json = get_json;
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static void
@@ -213,6 +213,8 @@
 
 static void gdata_documents_document_finalize (GObject *object);
 static gboolean parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GError **error);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 
 struct _GDataDocumentsDocumentPrivate {
 	GHashTable *export_links; /* owned string → owned string */
@@ -232,6 +234,8 @@ gdata_documents_document_class_init (GDataDocumentsDocumentClass *klass)
 	gobject_class->finalize = gdata_documents_document_finalize;
 	parsable_class->parse_json = parse_json;
 	entry_class->kind_term = "http://schemas.google.com/docs/2007#file";
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static void
@@ -312,6 +316,18 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 	return GDATA_PARSABLE_CLASS (gdata_documents_document_parent_class)->parse_json (parsable, reader, user_data, error);
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	gdata_binary_writer_put_string_hash (writer, GDATA_DOCUMENTS_DOCUMENT (parsable)->priv->export_links);
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	gdata_binary_reader_get_string_hash (reader, GDATA_DOCUMENTS_DOCUMENT (parsable)->priv->export_links);
+}
+
 /**
  * gdata_documents_document_new:
  * @id: (allow-none): the entry's ID (not the document ID), or %NULL
@@ -124,6 +124,8 @@ static gboolean parse_json (GDataParsable *parsable, JsonReader *reader, gpointe
 static gboolean post_parse_json (GDataParsable *parsable, gpointer user_data, GError **error);
 static void get_json (GDataParsable *parsable, JsonBuilder *builder);
 static gchar *get_entry_uri (const gchar *id);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 
 struct _GDataDocumentsEntryPrivate {
 	gint64 last_viewed;
@@ -309,6 +311,11 @@ gdata_documents_entry_class_init (GDataDocumentsEntryClass *klass)
 	                                                     "File size", "The size of the document.",
 	                                                     0, G_MAXINT64, 0,
 	                                                     G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+	/* Members to send in partial updates when the properties change */
+	_gdata_parsable_class_set_patch_name (parsable_class, "summary", "description");
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static gboolean
@@ -353,7 +360,7 @@ get_rules (GDataAccessHandler *self,
 	g_assert (message->response_body->data != NULL);
 
 	feed = _gdata_feed_new_from_json (GDATA_TYPE_FEED, message->response_body->data, message->response_body->length, GDATA_TYPE_DOCUMENTS_ACCESS_RULE,
-					  progress_callback, progress_user_data, error);
+					  NULL, progress_callback, progress_user_data, error);
 
 	g_object_unref (message);
 
@@ -669,23 +676,29 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 		}
 
 		for (i = 0, members = (guint) json_reader_count_members (reader); i < members; i++) {
-			gboolean starred;
-			gboolean viewed;
+			gboolean starred = FALSE;
+			gboolean trashed = FALSE;
+			gboolean viewed = FALSE;
 
 			json_reader_read_element (reader, i);
 
-			gdata_parser_boolean_from_json_member (reader, "starred", P_DEFAULT, &starred, &success, NULL);
-			if (success && starred) {
-				category = gdata_category_new (GDATA_CATEGORY_SCHEMA_LABELS_STARRED, GDATA_CATEGORY_SCHEMA_LABELS, "starred");
-				gdata_entry_add_category (GDATA_ENTRY (parsable), category);
-				g_object_unref (category);
-			}
-
-			gdata_parser_boolean_from_json_member (reader, "viewed", P_DEFAULT, &viewed, &success, NULL);
-			if (success && viewed) {
-				category = gdata_category_new ("http://schemas.google.com/g/2005/labels#viewed", GDATA_CATEGORY_SCHEMA_LABELS, "viewed");
-				gdata_entry_add_category (GDATA_ENTRY (parsable), category);
-				g_object_unref (category);
+			/* Each member is only one of the labels, so only act on the one which matched */
+			if (gdata_parser_boolean_from_json_member (reader, "starred", P_DEFAULT, &starred, &success, NULL) == TRUE) {
+				if (success && starred) {
+					category = gdata_category_new (GDATA_CATEGORY_SCHEMA_LABELS_STARRED, GDATA_CATEGORY_SCHEMA_LABELS, "starred");
+					gdata_entry_add_category (GDATA_ENTRY (parsable), category);
+					g_object_unref (category);
+				}
+			} else if (gdata_parser_boolean_from_json_member (reader, "viewed", P_DEFAULT, &viewed, &success, NULL) == TRUE) {
+				if (success && viewed) {
+					category = gdata_category_new ("http://schemas.google.com/g/2005/labels#viewed", GDATA_CATEGORY_SCHEMA_LABELS,
+					                               "viewed");
+					gdata_entry_add_category (GDATA_ENTRY (parsable), category);
+					g_object_unref (category);
+				}
+			} else if (gdata_parser_boolean_from_json_member (reader, "trashed", P_DEFAULT, &trashed, &success, NULL) == TRUE) {
+				if (success)
+					priv->is_deleted = trashed;
 			}
 
 			json_reader_end_element (reader);
@@ -911,6 +924,30 @@ get_entry_uri (const gchar *id)
 	return g_strconcat ("https://www.googleapis.com/drive/v2/files/", id, NULL);
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	GDataDocumentsEntryPrivate *priv = GDATA_DOCUMENTS_ENTRY (parsable)->priv;
+
+	gdata_binary_writer_put_int (writer, priv->last_viewed);
+	gdata_binary_writer_put_string (writer, priv->resource_id);
+	gdata_binary_writer_put_parsable (writer, GDATA_PARSABLE (priv->last_modified_by));
+	gdata_binary_writer_put_int (writer, priv->quota_used);
+	gdata_binary_writer_put_int (writer, priv->file_size);
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	GDataDocumentsEntryPrivate *priv = GDATA_DOCUMENTS_ENTRY (parsable)->priv;
+
+	priv->last_viewed = gdata_binary_reader_get_int (reader);
+	priv->resource_id = gdata_binary_reader_dup_string (reader);
+	priv->last_modified_by = GDATA_AUTHOR (gdata_binary_reader_get_parsable (reader, GDATA_TYPE_AUTHOR));
+	priv->quota_used = gdata_binary_reader_get_int (reader);
+	priv->file_size = gdata_binary_reader_get_int (reader);
+}
+
 /**
  * gdata_documents_entry_get_edited:
  * @self: a #GDataDocumentsEntry
@@ -1066,6 +1103,7 @@ gdata_documents_entry_set_writers_can_invite (GDataDocumentsEntry *self, gboolea
 {
 	g_return_if_fail (GDATA_IS_DOCUMENTS_ENTRY (self));
 	self->priv->writers_can_invite = writers_can_invite;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "writers-can-invite");
 	g_object_notify (G_OBJECT (self), "writers-can-invite");
 }
 
@@ -1155,3 +1193,13 @@ gdata_documents_entry_is_deleted (GDataDocumentsEntry *self)
 	g_return_val_if_fail (GDATA_IS_DOCUMENTS_ENTRY (self), FALSE);
 	return self->priv->is_deleted;
 }
+
+/* Used by the feed parser to mark the placeholder entries it builds for deletions in a Drive changes feed. */
+void
+_gdata_documents_entry_set_is_deleted (GDataDocumentsEntry *self, gboolean is_deleted)
+{
+	g_return_if_fail (GDATA_IS_DOCUMENTS_ENTRY (self));
+
+	self->priv->is_deleted = is_deleted;
+	g_object_notify (G_OBJECT (self), "is-deleted");
+}
@@ -40,6 +40,7 @@
 #include <string.h>
 
 #include "gdata-documents-feed.h"
+#include "gdata-documents-document.h"
 #include "gdata-documents-utils.h"
 #include "gdata-types.h"
 #include "gdata-private.h"
@@ -54,6 +55,8 @@ gdata_documents_feed_class_init (GDataDocumentsFeedClass *klass)
 {
 	GDataParsableClass *parsable_class = GDATA_PARSABLE_CLASS (klass);
 	parsable_class->parse_json = parse_json;
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static void
@@ -114,13 +117,71 @@ get_kind_and_mime_type (JsonReader *reader, gchar **out_kind, gchar **out_mime_t
 	g_free (mime_type);
 }
 
+/* Parses a drive#change resource: https://developers.google.com/drive/v2/reference/changes
+ * If the file was deleted (or is no longer visible to the user), a placeholder entry with only its ID set is returned, marked as deleted. */
+static GDataEntry *
+parse_change (JsonReader *reader, GError **error)
+{
+	GDataEntry *entry = NULL;
+	GError *child_error = NULL;
+	gboolean deleted = FALSE;
+	gchar *file_id = NULL;
+
+	if (json_reader_read_member (reader, "deleted") == TRUE)
+		deleted = json_reader_get_boolean_value (reader);
+	json_reader_end_member (reader);
+
+	if (deleted == FALSE && json_reader_read_member (reader, "file") == TRUE && json_reader_is_object (reader) == TRUE) {
+		gchar *mime_type = NULL;
+
+		get_kind_and_mime_type (reader, NULL, &mime_type, &child_error);
+		if (child_error == NULL) {
+			entry = GDATA_ENTRY (_gdata_parsable_new_from_json_node (gdata_documents_utils_get_type_from_content_type (mime_type),
+			                                                         reader, NULL, &child_error));
+		}
+
+		g_free (mime_type);
+	}
+
+	if (deleted == FALSE)
+		json_reader_end_member (reader);
+
+	if (child_error != NULL) {
+		g_propagate_error (error, child_error);
+		return NULL;
+	} else if (entry != NULL) {
+		return entry;
+	}
+
+	if (json_reader_read_member (reader, "fileId") == TRUE)
+		file_id = g_strdup (json_reader_get_string_value (reader));
+	json_reader_end_member (reader);
+
+	if (file_id == NULL || *file_id == '\0') {
+		g_set_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR,
+		             /* Translators: the parameter is an error message */
+		             _("Error parsing JSON: %s"),
+		             "Failed to find ‘fileId’.");
+		g_free (file_id);
+		return NULL;
+	}
+
+	entry = g_object_new (GDATA_TYPE_DOCUMENTS_DOCUMENT, "id", file_id, NULL);
+	_gdata_documents_entry_set_is_deleted (GDATA_DOCUMENTS_ENTRY (entry), TRUE);
+	g_free (file_id);
+
+	return entry;
+}
+
 static gboolean
 parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GError **error)
 {
 	gboolean success = TRUE;
 	gchar *next_uri = NULL;
+	gchar *largest_change_id = NULL;
 
-	/* JSON format: https://developers.google.com/drive/v2/reference/files/list */
+	/* JSON format: https://developers.google.com/drive/v2/reference/files/list
+	 * and https://developers.google.com/drive/v2/reference/changes/list */
 
 	if (gdata_parser_string_from_json_member (reader, "nextLink", P_DEFAULT, &next_uri, &success, error) == TRUE) {
 		if (success && next_uri != NULL && next_uri[0] != '\0') {
@@ -133,6 +194,18 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 
 		g_free (next_uri);
 		return success;
+	} else if (gdata_parser_string_from_json_member (reader, "largestChangeId", P_DEFAULT, &largest_change_id, &success, error) == TRUE) {
+		/* The changes feed is resumed from the change after the largest one seen, so store that as the sync token. */
+		if (success && largest_change_id != NULL && largest_change_id[0] != '\0') {
+			gchar *sync_token;
+
+			sync_token = g_strdup_printf ("%" G_GINT64_FORMAT, g_ascii_strtoll (largest_change_id, NULL, 10) + 1);
+			_gdata_feed_set_next_sync_token (GDATA_FEED (parsable), sync_token);
+			g_free (sync_token);
+		}
+
+		g_free (largest_change_id);
+		return success;
 	} else if (g_strcmp0 (json_reader_get_member_name (reader), "items") == 0) {
 		guint i, elements;
 
@@ -172,6 +245,16 @@ parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GEr
 
 			if (g_strcmp0 (kind, "drive#file") == 0) {
 				entry_type = gdata_documents_utils_get_type_from_content_type (mime_type);
+			} else if (g_strcmp0 (kind, "drive#change") == 0) {
+				entry = parse_change (reader, error);
+				if (entry == NULL) {
+					success = FALSE;
+					goto continuation;
+				}
+
+				_gdata_feed_call_progress_callback (GDATA_FEED (parsable), user_data, entry);
+				_gdata_feed_add_entry (GDATA_FEED (parsable), entry);
+				goto continuation;
 			} else {
 				g_warning ("%s files are not handled yet", kind);
 			}
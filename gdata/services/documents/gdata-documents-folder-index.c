@@ -0,0 +1,980 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ * Copyright (C) Philip Withnall 2017 <philip@tecnocode.co.uk>
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:gdata-documents-folder-index
+ * @short_description: GData documents folder hierarchy index
+ * @stability: Unstable
+ * @include: gdata/services/documents/gdata-documents-folder-index.h
+ *
+ * #GDataDocumentsFolderIndex is an in-memory index of the folder hierarchy of the authenticated user's documents. It maps folders to their
+ * children, and paths to entry IDs, so that paths can be resolved, folders listed recursively, and moves validated without making a request
+ * to the server for each folder involved.
+ *
+ * The index is populated by gdata_documents_folder_index_refresh(). The first refresh lists all the user's documents in a single paginated
+ * query of the changes feed; later refreshes fetch only the changes made since the previous one, using a #GDataSyncSession. Entries returned
+ * by other operations (such as gdata_documents_service_add_entry_to_folder()) can be added to the index straight away using
+ * gdata_documents_folder_index_update_entry(), rather than waiting for the next refresh.
+ *
+ * Paths are formed from the #GDataEntry:title<!-- -->s of entries, separated by ‘/’. The top level of the hierarchy contains the entries in
+ * the root folder (‘My Drive’), and any entries shared with the user which don't have a parent folder visible to them. An entry in several
+ * folders is reachable by several paths. If several entries in a folder have the same title, a path naming that title resolves to the one with
+ * the lowest ID. Titles containing ‘/’ can't be resolved as paths.
+ *
+ * <example>
+ * 	<title>Resolving a Path</title>
+ * 	<programlisting>
+ *	GDataDocumentsFolderIndex *index;
+ *	GDataDocumentsEntry *entry;
+ *	gchar *id;
+ *	GError *error = NULL;
+ *
+ *	index = gdata_documents_folder_index_new (service);
+ *	gdata_documents_folder_index_refresh (index, NULL, &error);
+ *
+ *	if (error != NULL) {
+ *		g_error ("Error building folder index: %s", error->message);
+ *		g_error_free (error);
+ *		g_object_unref (index);
+ *		return;
+ *	}
+ *
+ *	/<!-- -->* Resolve the path to an entry ID, then get the entry itself *<!-- -->/
+ *	id = gdata_documents_folder_index_lookup_path (index, "/Projects/2017/Report");
+ *	entry = (id != NULL) ? gdata_documents_folder_index_get_entry (index, id) : NULL;
+ *	g_free (id);
+ *
+ *	/<!-- -->* Do something with the entry here *<!-- -->/
+ *
+ *	if (entry != NULL)
+ *		g_object_unref (entry);
+ *	g_object_unref (index);
+ * 	</programlisting>
+ * </example>
+ *
+ * Since: 0.17.9
+ */
+
+#include <config.h>
+#include <glib.h>
+#include <glib/gi18n-lib.h>
+#include <string.h>
+
+#include "gdata-documents-folder-index.h"
+#include "gdata-documents-utils.h"
+#include "gdata-sync-session.h"
+#include "gdata-private.h"
+
+/* Guards against cycles in the hierarchy, which the server shouldn't allow, but which would otherwise make path building recurse forever */
+#define MAX_DEPTH 256
+
+typedef struct {
+	GDataDocumentsEntry *entry;
+	GPtrArray *parent_ids; /* IDs of the parent folders, which may not be in the index */
+} IndexNode;
+
+static void gdata_documents_folder_index_dispose (GObject *object);
+static void gdata_documents_folder_index_finalize (GObject *object);
+static void gdata_documents_folder_index_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+static void gdata_documents_folder_index_set_property (GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+
+struct _GDataDocumentsFolderIndexPrivate {
+	GDataDocumentsService *service;
+
+	GMutex refresh_mutex; /* serialises refreshes, as a sync session can only be run once at a time */
+	GDataSyncSession *sync_session; /* NULL until the first refresh */
+
+	GMutex mutex; /* protects everything below */
+	GHashTable *nodes; /* entry ID → IndexNode */
+	GHashTable *children; /* parent folder ID → (set of child entry IDs) */
+	GHashTable *paths; /* path → entry ID; NULL if out of date, and rebuilt on demand */
+};
+
+enum {
+	PROP_SERVICE = 1,
+};
+
+G_DEFINE_TYPE (GDataDocumentsFolderIndex, gdata_documents_folder_index, G_TYPE_OBJECT)
+
+static void
+gdata_documents_folder_index_class_init (GDataDocumentsFolderIndexClass *klass)
+{
+	GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+	g_type_class_add_private (klass, sizeof (GDataDocumentsFolderIndexPrivate));
+
+	gobject_class->dispose = gdata_documents_folder_index_dispose;
+	gobject_class->finalize = gdata_documents_folder_index_finalize;
+	gobject_class->get_property = gdata_documents_folder_index_get_property;
+	gobject_class->set_property = gdata_documents_folder_index_set_property;
+
+	/**
+	 * GDataDocumentsFolderIndex:service:
+	 *
+	 * The service used to refresh the index. If this is %NULL, the index can only be changed using
+	 * gdata_documents_folder_index_update_entry() and gdata_documents_folder_index_remove_entry().
+	 *
+	 * Since: 0.17.9
+	 */
+	g_object_class_install_property (gobject_class, PROP_SERVICE,
+	                                 g_param_spec_object ("service",
+	                                                      "Service", "The service used to refresh the index.",
+	                                                      GDATA_TYPE_DOCUMENTS_SERVICE,
+	                                                      G_PARAM_CONSTRUCT_ONLY | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+}
+
+static void
+index_node_free (IndexNode *node)
+{
+	g_object_unref (node->entry);
+	g_ptr_array_unref (node->parent_ids);
+	g_slice_free (IndexNode, node);
+}
+
+static void
+gdata_documents_folder_index_init (GDataDocumentsFolderIndex *self)
+{
+	self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self, GDATA_TYPE_DOCUMENTS_FOLDER_INDEX, GDataDocumentsFolderIndexPrivate);
+
+	g_mutex_init (&(self->priv->refresh_mutex));
+	g_mutex_init (&(self->priv->mutex));
+	self->priv->nodes = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) index_node_free);
+	self->priv->children = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_hash_table_unref);
+}
+
+static void
+gdata_documents_folder_index_dispose (GObject *object)
+{
+	GDataDocumentsFolderIndexPrivate *priv = GDATA_DOCUMENTS_FOLDER_INDEX (object)->priv;
+
+	g_clear_object (&priv->sync_session);
+	g_clear_object (&priv->service);
+
+	/* Chain up to the parent class */
+	G_OBJECT_CLASS (gdata_documents_folder_index_parent_class)->dispose (object);
+}
+
+static void
+gdata_documents_folder_index_finalize (GObject *object)
+{
+	GDataDocumentsFolderIndexPrivate *priv = GDATA_DOCUMENTS_FOLDER_INDEX (object)->priv;
+
+	if (priv->paths != NULL)
+		g_hash_table_unref (priv->paths);
+	g_hash_table_unref (priv->children);
+	g_hash_table_unref (priv->nodes);
+	g_mutex_clear (&(priv->mutex));
+	g_mutex_clear (&(priv->refresh_mutex));
+
+	/* Chain up to the parent class */
+	G_OBJECT_CLASS (gdata_documents_folder_index_parent_class)->finalize (object);
+}
+
+static void
+gdata_documents_folder_index_get_property (GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+	GDataDocumentsFolderIndexPrivate *priv = GDATA_DOCUMENTS_FOLDER_INDEX (object)->priv;
+
+	switch (property_id) {
+		case PROP_SERVICE:
+			g_value_set_object (value, priv->service);
+			break;
+		default:
+			/* We don't have any other property... */
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+			break;
+	}
+}
+
+static void
+gdata_documents_folder_index_set_property (GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+	GDataDocumentsFolderIndexPrivate *priv = GDATA_DOCUMENTS_FOLDER_INDEX (object)->priv;
+
+	switch (property_id) {
+		/* Construct only */
+		case PROP_SERVICE:
+			priv->service = g_value_dup_object (value);
+			break;
+		default:
+			/* We don't have any other property... */
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+			break;
+	}
+}
+
+/**
+ * gdata_documents_folder_index_new:
+ * @service: (allow-none): the #GDataDocumentsService to refresh the index using, or %NULL
+ *
+ * Creates a new, empty #GDataDocumentsFolderIndex. Call gdata_documents_folder_index_refresh() to populate it.
+ *
+ * Return value: (transfer full): a new #GDataDocumentsFolderIndex; unref with g_object_unref()
+ *
+ * Since: 0.17.9
+ */
+GDataDocumentsFolderIndex *
+gdata_documents_folder_index_new (GDataDocumentsService *service)
+{
+	g_return_val_if_fail (service == NULL || GDATA_IS_DOCUMENTS_SERVICE (service), NULL);
+
+	return g_object_new (GDATA_TYPE_DOCUMENTS_FOLDER_INDEX, "service", service, NULL);
+}
+
+/**
+ * gdata_documents_folder_index_get_service:
+ * @self: a #GDataDocumentsFolderIndex
+ *
+ * Gets the #GDataDocumentsFolderIndex:service property.
+ *
+ * Return value: (transfer none) (allow-none): the service used to refresh the index, or %NULL
+ *
+ * Since: 0.17.9
+ */
+GDataDocumentsService *
+gdata_documents_folder_index_get_service (GDataDocumentsFolderIndex *self)
+{
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_FOLDER_INDEX (self), NULL);
+	return self->priv->service;
+}
+
+/**
+ * gdata_documents_folder_index_get_n_entries:
+ * @self: a #GDataDocumentsFolderIndex
+ *
+ * Gets the number of entries (documents and folders) in the index.
+ *
+ * Return value: the number of entries in the index
+ *
+ * Since: 0.17.9
+ */
+guint
+gdata_documents_folder_index_get_n_entries (GDataDocumentsFolderIndex *self)
+{
+	guint n_entries;
+
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_FOLDER_INDEX (self), 0);
+
+	g_mutex_lock (&(self->priv->mutex));
+	n_entries = g_hash_table_size (self->priv->nodes);
+	g_mutex_unlock (&(self->priv->mutex));
+
+	return n_entries;
+}
+
+static void
+invalidate_paths (GDataDocumentsFolderIndexPrivate *priv)
+{
+	if (priv->paths != NULL) {
+		g_hash_table_unref (priv->paths);
+		priv->paths = NULL;
+	}
+}
+
+static void
+unlink_node (GDataDocumentsFolderIndexPrivate *priv, const gchar *id, IndexNode *node)
+{
+	guint i;
+
+	for (i = 0; i < node->parent_ids->len; i++) {
+		const gchar *parent_id = g_ptr_array_index (node->parent_ids, i);
+		GHashTable *siblings = g_hash_table_lookup (priv->children, parent_id);
+
+		if (siblings != NULL) {
+			g_hash_table_remove (siblings, id);
+			if (g_hash_table_size (siblings) == 0)
+				g_hash_table_remove (priv->children, parent_id);
+		}
+	}
+}
+
+static void
+remove_node (GDataDocumentsFolderIndexPrivate *priv, const gchar *id)
+{
+	IndexNode *node;
+
+	node = g_hash_table_lookup (priv->nodes, id);
+	if (node == NULL)
+		return;
+
+	/* Children of a removed folder are left in place; they're normally removed by their own changes */
+	unlink_node (priv, id, node);
+	g_hash_table_remove (priv->nodes, id);
+	invalidate_paths (priv);
+}
+
+static void
+update_node (GDataDocumentsFolderIndexPrivate *priv, GDataDocumentsEntry *entry)
+{
+	IndexNode *node, *old_node;
+	const gchar *id;
+	GList *parent_links, *i;
+
+	id = gdata_entry_get_id (GDATA_ENTRY (entry));
+
+	node = g_slice_new (IndexNode);
+	node->entry = g_object_ref (entry);
+	node->parent_ids = g_ptr_array_new_with_free_func (g_free);
+
+	/* Parent links are of the form GDATA_DOCUMENTS_URI_PREFIX + parent ID; see add_folder_link_to_entry() */
+	parent_links = gdata_entry_look_up_links (GDATA_ENTRY (entry), GDATA_LINK_PARENT);
+
+	for (i = parent_links; i != NULL; i = i->next) {
+		const gchar *uri = gdata_link_get_uri (GDATA_LINK (i->data));
+		const gchar *parent_id;
+		GHashTable *siblings;
+
+		if (g_str_has_prefix (uri, GDATA_DOCUMENTS_URI_PREFIX) == FALSE)
+			continue;
+
+		parent_id = uri + strlen (GDATA_DOCUMENTS_URI_PREFIX);
+		if (*parent_id == '\0')
+			continue;
+
+		g_ptr_array_add (node->parent_ids, g_strdup (parent_id));
+
+		siblings = g_hash_table_lookup (priv->children, parent_id);
+		if (siblings == NULL) {
+			siblings = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+			g_hash_table_insert (priv->children, g_strdup (parent_id), siblings);
+		}
+
+		g_hash_table_add (siblings, g_strdup (id));
+	}
+
+	g_list_free (parent_links);
+
+	/* Unlink the old node from any parents the entry is no longer in, then replace it */
+	old_node = g_hash_table_lookup (priv->nodes, id);
+	if (old_node != NULL) {
+		guint j;
+
+		for (j = 0; j < old_node->parent_ids->len; j++) {
+			const gchar *parent_id = g_ptr_array_index (old_node->parent_ids, j);
+			gboolean still_parent = FALSE;
+			guint k;
+
+			for (k = 0; k < node->parent_ids->len && still_parent == FALSE; k++)
+				still_parent = (strcmp (parent_id, g_ptr_array_index (node->parent_ids, k)) == 0);
+
+			if (still_parent == FALSE) {
+				GHashTable *siblings = g_hash_table_lookup (priv->children, parent_id);
+
+				if (siblings != NULL) {
+					g_hash_table_remove (siblings, id);
+					if (g_hash_table_size (siblings) == 0)
+						g_hash_table_remove (priv->children, parent_id);
+				}
+			}
+		}
+	}
+
+	g_hash_table_insert (priv->nodes, g_strdup (id), node);
+	invalidate_paths (priv);
+}
+
+static gboolean
+node_is_folder (IndexNode *node)
+{
+	return (node != NULL && GDATA_IS_DOCUMENTS_FOLDER (node->entry));
+}
+
+/* An entry is at the top level if none of its parents are folders in the index. The root folder itself is never returned by the server, so
+ * entries in the root folder are at the top level. */
+static gboolean
+node_is_top_level (GDataDocumentsFolderIndexPrivate *priv, IndexNode *node)
+{
+	guint i;
+
+	for (i = 0; i < node->parent_ids->len; i++) {
+		if (node_is_folder (g_hash_table_lookup (priv->nodes, g_ptr_array_index (node->parent_ids, i))) == TRUE)
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+static void
+add_paths (GDataDocumentsFolderIndexPrivate *priv, const gchar *parent_path, const gchar *id, IndexNode *node, guint depth)
+{
+	const gchar *title, *existing_id;
+	GHashTable *children;
+	gchar *path;
+
+	title = gdata_entry_get_title (GDATA_ENTRY (node->entry));
+	if (depth >= MAX_DEPTH || title == NULL || *title == '\0' || strchr (title, '/') != NULL)
+		return;
+
+	path = g_strconcat (parent_path, "/", title, NULL);
+
+	/* Resolve title clashes deterministically */
+	existing_id = g_hash_table_lookup (priv->paths, path);
+	if (existing_id != NULL && strcmp (existing_id, id) <= 0) {
+		g_free (path);
+		return;
+	}
+
+	g_hash_table_insert (priv->paths, path, g_strdup (id));
+
+	children = node_is_folder (node) ? g_hash_table_lookup (priv->children, id) : NULL;
+	if (children != NULL) {
+		GHashTableIter iter;
+		gpointer child_id;
+
+		g_hash_table_iter_init (&iter, children);
+		while (g_hash_table_iter_next (&iter, &child_id, NULL) == TRUE) {
+			IndexNode *child = g_hash_table_lookup (priv->nodes, child_id);
+
+			if (child != NULL)
+				add_paths (priv, path, child_id, child, depth + 1);
+		}
+	}
+}
+
+/* Paths are rebuilt in one pass after the hierarchy changes, which keeps updates cheap (a move doesn't have to rewrite the paths of a whole
+ * subtree) and makes path lookups a single hash table lookup between changes. */
+static void
+ensure_paths (GDataDocumentsFolderIndexPrivate *priv)
+{
+	GHashTableIter iter;
+	gpointer id, node;
+
+	if (priv->paths != NULL)
+		return;
+
+	priv->paths = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+
+	g_hash_table_iter_init (&iter, priv->nodes);
+	while (g_hash_table_iter_next (&iter, &id, &node) == TRUE) {
+		if (node_is_top_level (priv, node) == TRUE)
+			add_paths (priv, "", id, node, 0);
+	}
+}
+
+/**
+ * gdata_documents_folder_index_update_entry:
+ * @self: a #GDataDocumentsFolderIndex
+ * @entry: a #GDataDocumentsEntry which has been inserted on the server
+ *
+ * Adds @entry to the index, or replaces the indexed copy of it. This can be used to update the index with the entry returned by an operation
+ * such as gdata_documents_service_add_entry_to_folder(), without waiting for the next refresh.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_documents_folder_index_update_entry (GDataDocumentsFolderIndex *self, GDataDocumentsEntry *entry)
+{
+	g_return_if_fail (GDATA_IS_DOCUMENTS_FOLDER_INDEX (self));
+	g_return_if_fail (GDATA_IS_DOCUMENTS_ENTRY (entry));
+	g_return_if_fail (gdata_entry_get_id (GDATA_ENTRY (entry)) != NULL);
+
+	g_mutex_lock (&(self->priv->mutex));
+	update_node (self->priv, entry);
+	g_mutex_unlock (&(self->priv->mutex));
+}
+
+/**
+ * gdata_documents_folder_index_remove_entry:
+ * @self: a #GDataDocumentsFolderIndex
+ * @id: the ID of the entry to remove
+ *
+ * Removes the entry with the given @id from the index, if it's present. If the entry is a folder, its children stay in the index.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_documents_folder_index_remove_entry (GDataDocumentsFolderIndex *self, const gchar *id)
+{
+	g_return_if_fail (GDATA_IS_DOCUMENTS_FOLDER_INDEX (self));
+	g_return_if_fail (id != NULL);
+
+	g_mutex_lock (&(self->priv->mutex));
+	remove_node (self->priv, id);
+	g_mutex_unlock (&(self->priv->mutex));
+}
+
+static void
+refresh_change_cb (GDataSyncChangeType change_type, GDataEntry *entry, GDataDocumentsFolderIndexPrivate *priv)
+{
+	g_mutex_lock (&(priv->mutex));
+
+	switch (change_type) {
+		case GDATA_SYNC_CHANGE_RESET:
+			g_hash_table_remove_all (priv->children);
+			g_hash_table_remove_all (priv->nodes);
+			invalidate_paths (priv);
+			break;
+		case GDATA_SYNC_CHANGE_INSERTION:
+		case GDATA_SYNC_CHANGE_UPDATE:
+			if (GDATA_IS_DOCUMENTS_ENTRY (entry) && gdata_entry_get_id (entry) != NULL)
+				update_node (priv, GDATA_DOCUMENTS_ENTRY (entry));
+			break;
+		case GDATA_SYNC_CHANGE_DELETION:
+			if (gdata_entry_get_id (entry) != NULL)
+				remove_node (priv, gdata_entry_get_id (entry));
+			break;
+		default:
+			g_assert_not_reached ();
+	}
+
+	g_mutex_unlock (&(priv->mutex));
+}
+
+/**
+ * gdata_documents_folder_index_refresh:
+ * @self: a #GDataDocumentsFolderIndex
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @error: a #GError, or %NULL
+ *
+ * Brings the index up to date with the server. The first refresh lists all of the user's documents; later refreshes only download the changes
+ * made since the previous refresh. If a refresh fails, the changes it had already applied are kept, and the next refresh starts again from the
+ * same point.
+ *
+ * The index can be queried while it's being refreshed from another thread, but may reflect some of the changes being applied and not others.
+ *
+ * The #GDataDocumentsFolderIndex:service must be set, and authorized for documents access. Errors from #GDataServiceError can be returned
+ * for exceptional conditions, as determined by the server.
+ *
+ * Return value: %TRUE on success, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_documents_folder_index_refresh (GDataDocumentsFolderIndex *self, GCancellable *cancellable, GError **error)
+{
+	GDataDocumentsFolderIndexPrivate *priv;
+	gboolean success;
+
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_FOLDER_INDEX (self), FALSE);
+	g_return_val_if_fail (self->priv->service != NULL, FALSE);
+	g_return_val_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable), FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	priv = self->priv;
+	g_mutex_lock (&(priv->refresh_mutex));
+
+	if (priv->sync_session == NULL)
+		priv->sync_session = gdata_documents_service_create_sync_session (priv->service);
+
+	success = gdata_sync_session_run (priv->sync_session, (GDataSyncSessionCallback) refresh_change_cb, priv, cancellable, error);
+
+	g_mutex_unlock (&(priv->refresh_mutex));
+
+	return success;
+}
+
+static void
+refresh_thread (GSimpleAsyncResult *result, GDataDocumentsFolderIndex *self, GCancellable *cancellable)
+{
+	GError *error = NULL;
+
+	/* Refresh the index and return */
+	if (gdata_documents_folder_index_refresh (self, cancellable, &error) == FALSE)
+		g_simple_async_result_take_error (result, error);
+}
+
+/**
+ * gdata_documents_folder_index_refresh_async:
+ * @self: a #GDataDocumentsFolderIndex
+ * @cancellable: (allow-none): optional #GCancellable object, or %NULL
+ * @callback: a #GAsyncReadyCallback to call when the refresh is finished, or %NULL
+ * @user_data: (closure): data to pass to the @callback function
+ *
+ * Brings the index up to date with the server, asynchronously. @self is reffed when this function is called, so can safely be unreffed after
+ * this function returns.
+ *
+ * For more details, see gdata_documents_folder_index_refresh(), which is the synchronous version of this function.
+ *
+ * When the refresh is finished, @callback will be called. You can then call gdata_documents_folder_index_refresh_finish() to get the result
+ * of the refresh.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_documents_folder_index_refresh_async (GDataDocumentsFolderIndex *self, GCancellable *cancellable, GAsyncReadyCallback callback,
+                                            gpointer user_data)
+{
+	GSimpleAsyncResult *result;
+
+	g_return_if_fail (GDATA_IS_DOCUMENTS_FOLDER_INDEX (self));
+	g_return_if_fail (self->priv->service != NULL);
+	g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+
+	result = g_simple_async_result_new (G_OBJECT (self), callback, user_data, gdata_documents_folder_index_refresh_async);
+	g_simple_async_result_run_in_thread (result, (GSimpleAsyncThreadFunc) refresh_thread, G_PRIORITY_DEFAULT, cancellable);
+	g_object_unref (result);
+}
+
+/**
+ * gdata_documents_folder_index_refresh_finish:
+ * @self: a #GDataDocumentsFolderIndex
+ * @async_result: a #GAsyncResult
+ * @error: a #GError, or %NULL
+ *
+ * Finishes an asynchronous refresh started with gdata_documents_folder_index_refresh_async().
+ *
+ * Return value: %TRUE on success, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_documents_folder_index_refresh_finish (GDataDocumentsFolderIndex *self, GAsyncResult *async_result, GError **error)
+{
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_FOLDER_INDEX (self), FALSE);
+	g_return_val_if_fail (G_IS_ASYNC_RESULT (async_result), FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	g_warn_if_fail (g_simple_async_result_get_source_tag (G_SIMPLE_ASYNC_RESULT (async_result)) == gdata_documents_folder_index_refresh_async);
+
+	return !g_simple_async_result_propagate_error (G_SIMPLE_ASYNC_RESULT (async_result), error);
+}
+
+/**
+ * gdata_documents_folder_index_get_entry:
+ * @self: a #GDataDocumentsFolderIndex
+ * @id: the ID of the entry to get
+ *
+ * Gets the indexed copy of the entry with the given @id.
+ *
+ * Return value: (transfer full) (allow-none): the entry, or %NULL if it isn't in the index; unref with g_object_unref()
+ *
+ * Since: 0.17.9
+ */
+GDataDocumentsEntry *
+gdata_documents_folder_index_get_entry (GDataDocumentsFolderIndex *self, const gchar *id)
+{
+	IndexNode *node;
+	GDataDocumentsEntry *entry = NULL;
+
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_FOLDER_INDEX (self), NULL);
+	g_return_val_if_fail (id != NULL, NULL);
+
+	g_mutex_lock (&(self->priv->mutex));
+
+	node = g_hash_table_lookup (self->priv->nodes, id);
+	if (node != NULL)
+		entry = g_object_ref (node->entry);
+
+	g_mutex_unlock (&(self->priv->mutex));
+
+	return entry;
+}
+
+/**
+ * gdata_documents_folder_index_lookup_path:
+ * @self: a #GDataDocumentsFolderIndex
+ * @path: an absolute path, such as <literal>/Projects/2017/Report</literal>
+ *
+ * Resolves @path to the ID of the entry it names. Empty path components are ignored, so <literal>//Projects/</literal> is the same as
+ * <literal>/Projects</literal>. The root folder isn't in the index, so <literal>/</literal> doesn't resolve to anything.
+ *
+ * Return value: (allow-none): the ID of the entry, or %NULL if no entry has the given path; free with g_free()
+ *
+ * Since: 0.17.9
+ */
+gchar *
+gdata_documents_folder_index_lookup_path (GDataDocumentsFolderIndex *self, const gchar *path)
+{
+	GString *normalised_path;
+	gchar **components;
+	gchar *id;
+	guint i;
+
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_FOLDER_INDEX (self), NULL);
+	g_return_val_if_fail (path != NULL && *path == '/', NULL);
+
+	normalised_path = g_string_new (NULL);
+	components = g_strsplit (path, "/", -1);
+
+	for (i = 0; components[i] != NULL; i++) {
+		if (*components[i] != '\0') {
+			g_string_append_c (normalised_path, '/');
+			g_string_append (normalised_path, components[i]);
+		}
+	}
+
+	g_strfreev (components);
+
+	g_mutex_lock (&(self->priv->mutex));
+	ensure_paths (self->priv);
+	id = g_strdup (g_hash_table_lookup (self->priv->paths, normalised_path->str));
+	g_mutex_unlock (&(self->priv->mutex));
+
+	g_string_free (normalised_path, TRUE);
+
+	return id;
+}
+
+/* Returns (transfer full) the IDs of the children of @folder_id, or of the top-level entries if @folder_id is %NULL. */
+static GList *
+list_children (GDataDocumentsFolderIndexPrivate *priv, const gchar *folder_id)
+{
+	GHashTableIter iter;
+	gpointer id, node;
+	GList *ids = NULL;
+
+	if (folder_id == NULL) {
+		g_hash_table_iter_init (&iter, priv->nodes);
+		while (g_hash_table_iter_next (&iter, &id, &node) == TRUE) {
+			if (node_is_top_level (priv, node) == TRUE)
+				ids = g_list_prepend (ids, g_strdup (id));
+		}
+	} else if (node_is_folder (g_hash_table_lookup (priv->nodes, folder_id)) == TRUE) {
+		GHashTable *children = g_hash_table_lookup (priv->children, folder_id);
+
+		if (children != NULL) {
+			g_hash_table_iter_init (&iter, children);
+			while (g_hash_table_iter_next (&iter, &id, NULL) == TRUE) {
+				if (g_hash_table_contains (priv->nodes, id) == TRUE)
+					ids = g_list_prepend (ids, g_strdup (id));
+			}
+		}
+	}
+
+	return ids;
+}
+
+/**
+ * gdata_documents_folder_index_get_children:
+ * @self: a #GDataDocumentsFolderIndex
+ * @folder_id: (allow-none): the ID of a folder, or %NULL for the top level
+ *
+ * Lists the IDs of the entries directly inside the folder with the given @folder_id, or of the entries at the top level of the hierarchy if
+ * @folder_id is %NULL. The IDs are in no particular order.
+ *
+ * Return value: (transfer full) (element-type utf8): a list of entry IDs, or %NULL if there are none or @folder_id isn't an indexed folder;
+ * free with <literal>g_list_free_full (list, g_free)</literal>
+ *
+ * Since: 0.17.9
+ */
+GList *
+gdata_documents_folder_index_get_children (GDataDocumentsFolderIndex *self, const gchar *folder_id)
+{
+	GList *ids;
+
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_FOLDER_INDEX (self), NULL);
+
+	g_mutex_lock (&(self->priv->mutex));
+	ids = list_children (self->priv, folder_id);
+	g_mutex_unlock (&(self->priv->mutex));
+
+	return ids;
+}
+
+/**
+ * gdata_documents_folder_index_get_descendants:
+ * @self: a #GDataDocumentsFolderIndex
+ * @folder_id: (allow-none): the ID of a folder, or %NULL for the top level
+ *
+ * Lists the IDs of all the entries inside the folder with the given @folder_id, recursively, or of all the entries reachable from the top
+ * level if @folder_id is %NULL. Each entry is listed once, even if it's in several of the folders. The list is in breadth-first order.
+ *
+ * Return value: (transfer full) (element-type utf8): a list of entry IDs, or %NULL if there are none or @folder_id isn't an indexed folder;
+ * free with <literal>g_list_free_full (list, g_free)</literal>
+ *
+ * Since: 0.17.9
+ */
+GList *
+gdata_documents_folder_index_get_descendants (GDataDocumentsFolderIndex *self, const gchar *folder_id)
+{
+	GDataDocumentsFolderIndexPrivate *priv;
+	GHashTable *seen;
+	GQueue queue = G_QUEUE_INIT;
+	GList *ids = NULL, *children, *i;
+
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_FOLDER_INDEX (self), NULL);
+
+	priv = self->priv;
+	g_mutex_lock (&(priv->mutex));
+
+	/* Breadth-first search; the set of seen IDs stops entries in several folders (or cycles) being listed more than once */
+	seen = g_hash_table_new (g_str_hash, g_str_equal);
+	children = list_children (priv, folder_id);
+
+	for (i = children; i != NULL; i = i->next)
+		g_queue_push_tail (&queue, i->data);
+	g_list_free (children);
+
+	while (g_queue_is_empty (&queue) == FALSE) {
+		gchar *id = g_queue_pop_head (&queue);
+
+		if (g_hash_table_contains (seen, id) == TRUE || (folder_id != NULL && strcmp (id, folder_id) == 0)) {
+			g_free (id);
+			continue;
+		}
+
+		g_hash_table_add (seen, id);
+		ids = g_list_prepend (ids, id);
+
+		children = list_children (priv, id);
+		for (i = children; i != NULL; i = i->next)
+			g_queue_push_tail (&queue, i->data);
+		g_list_free (children);
+	}
+
+	g_hash_table_unref (seen);
+	g_mutex_unlock (&(priv->mutex));
+
+	return g_list_reverse (ids);
+}
+
+static gboolean
+node_has_parent (IndexNode *node, const gchar *parent_id)
+{
+	guint i;
+
+	for (i = 0; i < node->parent_ids->len; i++) {
+		if (strcmp (g_ptr_array_index (node->parent_ids, i), parent_id) == 0)
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+static gboolean
+check_folder (GDataDocumentsFolderIndexPrivate *priv, GDataDocumentsFolder *folder, GError **error)
+{
+	const gchar *folder_id = gdata_entry_get_id (GDATA_ENTRY (folder));
+
+	if (folder_id == NULL || node_is_folder (g_hash_table_lookup (priv->nodes, folder_id)) == FALSE) {
+		g_set_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_NOT_FOUND,
+		             /* Translators: the parameter is the title of a folder. */
+		             _("The folder ‘%s’ could not be found."), gdata_entry_get_title (GDATA_ENTRY (folder)));
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/**
+ * gdata_documents_folder_index_check_add_to_folder:
+ * @self: a #GDataDocumentsFolderIndex
+ * @entry: the #GDataDocumentsEntry to add to @folder
+ * @folder: the #GDataDocumentsFolder to add @entry to
+ * @error: a #GError, or %NULL
+ *
+ * Checks, using only the index, whether gdata_documents_service_add_entry_to_folder() would be able to add @entry to @folder. It would fail
+ * with %GDATA_SERVICE_ERROR_NOT_FOUND if @folder doesn't exist, %GDATA_SERVICE_ERROR_FORBIDDEN if @entry is a folder which already exists on
+ * the server, and %GDATA_SERVICE_ERROR_CONFLICT if @entry is already in @folder.
+ *
+ * The check is only as up to date as the index, so the operation may still fail on the server.
+ *
+ * Return value: %TRUE if the operation is expected to succeed, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_documents_folder_index_check_add_to_folder (GDataDocumentsFolderIndex *self, GDataDocumentsEntry *entry, GDataDocumentsFolder *folder,
+                                                  GError **error)
+{
+	GDataDocumentsFolderIndexPrivate *priv;
+	IndexNode *node;
+	gboolean success = FALSE;
+
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_FOLDER_INDEX (self), FALSE);
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_ENTRY (entry), FALSE);
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_FOLDER (folder), FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	priv = self->priv;
+	g_mutex_lock (&(priv->mutex));
+
+	if (check_folder (priv, folder, error) == FALSE)
+		goto done;
+
+	if (gdata_entry_is_inserted (GDATA_ENTRY (entry)) == TRUE) {
+		if (GDATA_IS_DOCUMENTS_FOLDER (entry)) {
+			g_set_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_FORBIDDEN,
+			             /* Translators: the parameter is the title of a folder. */
+			             _("The existing folder ‘%s’ can’t be added to another folder."), gdata_entry_get_title (GDATA_ENTRY (entry)));
+			goto done;
+		}
+
+		node = g_hash_table_lookup (priv->nodes, gdata_entry_get_id (GDATA_ENTRY (entry)));
+		if (node != NULL && node_has_parent (node, gdata_entry_get_id (GDATA_ENTRY (folder))) == TRUE) {
+			g_set_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_CONFLICT,
+			             /* Translators: the first parameter is the title of a document, and the second is the title of a folder. */
+			             _("‘%s’ is already in the folder ‘%s’."), gdata_entry_get_title (GDATA_ENTRY (entry)),
+			             gdata_entry_get_title (GDATA_ENTRY (folder)));
+			goto done;
+		}
+	}
+
+	success = TRUE;
+
+done:
+	g_mutex_unlock (&(priv->mutex));
+
+	return success;
+}
+
+/**
+ * gdata_documents_folder_index_check_remove_from_folder:
+ * @self: a #GDataDocumentsFolderIndex
+ * @entry: the #GDataDocumentsEntry to remove from @folder
+ * @folder: the #GDataDocumentsFolder to remove @entry from
+ * @error: a #GError, or %NULL
+ *
+ * Checks, using only the index, whether gdata_documents_service_remove_entry_from_folder() would be able to remove @entry from @folder. It
+ * would fail with %GDATA_SERVICE_ERROR_NOT_FOUND if @folder doesn't exist or @entry isn't in it.
+ *
+ * The check is only as up to date as the index, so the operation may still fail on the server.
+ *
+ * Return value: %TRUE if the operation is expected to succeed, %FALSE otherwise
+ *
+ * Since: 0.17.9
+ */
+gboolean
+gdata_documents_folder_index_check_remove_from_folder (GDataDocumentsFolderIndex *self, GDataDocumentsEntry *entry,
+                                                       GDataDocumentsFolder *folder, GError **error)
+{
+	GDataDocumentsFolderIndexPrivate *priv;
+	IndexNode *node;
+	const gchar *id;
+	gboolean success = FALSE;
+
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_FOLDER_INDEX (self), FALSE);
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_ENTRY (entry), FALSE);
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_FOLDER (folder), FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	priv = self->priv;
+	g_mutex_lock (&(priv->mutex));
+
+	if (check_folder (priv, folder, error) == FALSE)
+		goto done;
+
+	id = gdata_entry_get_id (GDATA_ENTRY (entry));
+	node = (id != NULL) ? g_hash_table_lookup (priv->nodes, id) : NULL;
+
+	if (node == NULL || node_has_parent (node, gdata_entry_get_id (GDATA_ENTRY (folder))) == FALSE) {
+		g_set_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_NOT_FOUND,
+		             /* Translators: the first parameter is the title of a document, and the second is the title of a folder. */
+		             _("‘%s’ is not in the folder ‘%s’."), gdata_entry_get_title (GDATA_ENTRY (entry)),
+		             gdata_entry_get_title (GDATA_ENTRY (folder)));
+		goto done;
+	}
+
+	success = TRUE;
+
+done:
+	g_mutex_unlock (&(priv->mutex));
+
+	return success;
+}
@@ -0,0 +1,102 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ * Copyright (C) Philip Withnall 2017 <philip@tecnocode.co.uk>
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GDATA_DOCUMENTS_FOLDER_INDEX_H
+#define GDATA_DOCUMENTS_FOLDER_INDEX_H
+
+#include <glib.h>
+#include <glib-object.h>
+#include <gio/gio.h>
+
+#include <gdata/services/documents/gdata-documents-service.h>
+#include <gdata/services/documents/gdata-documents-entry.h>
+#include <gdata/services/documents/gdata-documents-folder.h>
+
+G_BEGIN_DECLS
+
+#define GDATA_TYPE_DOCUMENTS_FOLDER_INDEX		(gdata_documents_folder_index_get_type ())
+#define GDATA_DOCUMENTS_FOLDER_INDEX(o)			(G_TYPE_CHECK_INSTANCE_CAST ((o), GDATA_TYPE_DOCUMENTS_FOLDER_INDEX, GDataDocumentsFolderIndex))
+#define GDATA_DOCUMENTS_FOLDER_INDEX_CLASS(k)		(G_TYPE_CHECK_CLASS_CAST((k), GDATA_TYPE_DOCUMENTS_FOLDER_INDEX, GDataDocumentsFolderIndexClass))
+#define GDATA_IS_DOCUMENTS_FOLDER_INDEX(o)		(G_TYPE_CHECK_INSTANCE_TYPE ((o), GDATA_TYPE_DOCUMENTS_FOLDER_INDEX))
+#define GDATA_IS_DOCUMENTS_FOLDER_INDEX_CLASS(k)	(G_TYPE_CHECK_CLASS_TYPE ((k), GDATA_TYPE_DOCUMENTS_FOLDER_INDEX))
+#define GDATA_DOCUMENTS_FOLDER_INDEX_GET_CLASS(o)	(G_TYPE_INSTANCE_GET_CLASS ((o), GDATA_TYPE_DOCUMENTS_FOLDER_INDEX, GDataDocumentsFolderIndexClass))
+
+typedef struct _GDataDocumentsFolderIndexPrivate	GDataDocumentsFolderIndexPrivate;
+
+/**
+ * GDataDocumentsFolderIndex:
+ *
+ * All the fields in the #GDataDocumentsFolderIndex structure are private and should never be accessed directly.
+ *
+ * Since: 0.17.9
+ */
+typedef struct {
+	GObject parent;
+	GDataDocumentsFolderIndexPrivate *priv;
+} GDataDocumentsFolderIndex;
+
+/**
+ * GDataDocumentsFolderIndexClass:
+ *
+ * All the fields in the #GDataDocumentsFolderIndexClass structure are private and should never be accessed directly.
+ *
+ * Since: 0.17.9
+ */
+typedef struct {
+	/*< private >*/
+	GObjectClass parent;
+
+	/*< private >*/
+	/* Padding for future expansion */
+	void (*_g_reserved0) (void);
+	void (*_g_reserved1) (void);
+	void (*_g_reserved2) (void);
+	void (*_g_reserved3) (void);
+	void (*_g_reserved4) (void);
+	void (*_g_reserved5) (void);
+} GDataDocumentsFolderIndexClass;
+
+GType gdata_documents_folder_index_get_type (void) G_GNUC_CONST;
+
+GDataDocumentsFolderIndex *gdata_documents_folder_index_new (GDataDocumentsService *service) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+
+GDataDocumentsService *gdata_documents_folder_index_get_service (GDataDocumentsFolderIndex *self) G_GNUC_PURE;
+guint gdata_documents_folder_index_get_n_entries (GDataDocumentsFolderIndex *self);
+
+gboolean gdata_documents_folder_index_refresh (GDataDocumentsFolderIndex *self, GCancellable *cancellable, GError **error);
+void gdata_documents_folder_index_refresh_async (GDataDocumentsFolderIndex *self, GCancellable *cancellable,
+                                                 GAsyncReadyCallback callback, gpointer user_data);
+gboolean gdata_documents_folder_index_refresh_finish (GDataDocumentsFolderIndex *self, GAsyncResult *async_result, GError **error);
+
+void gdata_documents_folder_index_update_entry (GDataDocumentsFolderIndex *self, GDataDocumentsEntry *entry);
+void gdata_documents_folder_index_remove_entry (GDataDocumentsFolderIndex *self, const gchar *id);
+
+GDataDocumentsEntry *gdata_documents_folder_index_get_entry (GDataDocumentsFolderIndex *self, const gchar *id) G_GNUC_WARN_UNUSED_RESULT;
+gchar *gdata_documents_folder_index_lookup_path (GDataDocumentsFolderIndex *self, const gchar *path) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+GList *gdata_documents_folder_index_get_children (GDataDocumentsFolderIndex *self, const gchar *folder_id) G_GNUC_WARN_UNUSED_RESULT;
+GList *gdata_documents_folder_index_get_descendants (GDataDocumentsFolderIndex *self, const gchar *folder_id) G_GNUC_WARN_UNUSED_RESULT;
+
+gboolean gdata_documents_folder_index_check_add_to_folder (GDataDocumentsFolderIndex *self, GDataDocumentsEntry *entry,
+                                                           GDataDocumentsFolder *folder, GError **error);
+gboolean gdata_documents_folder_index_check_remove_from_folder (GDataDocumentsFolderIndex *self, GDataDocumentsEntry *entry,
+                                                                GDataDocumentsFolder *folder, GError **error);
+
+G_END_DECLS
+
+#endif /* !GDATA_DOCUMENTS_FOLDER_INDEX_H */
@@ -102,6 +102,8 @@ gdata_documents_folder_class_init (GDataDocumentsFolderClass *klass)
 
 	gobject_class->constructed = gdata_documents_folder_constructed;
 	entry_class->kind_term = "http://schemas.google.com/docs/2007#folder";
+
+	_gdata_parsable_class_set_binary_funcs (GDATA_PARSABLE_CLASS (klass), NULL, NULL);
 }
 
 static void
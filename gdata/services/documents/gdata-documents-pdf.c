@@ -54,6 +54,8 @@ gdata_documents_pdf_class_init (GDataDocumentsPdfClass *klass)
 
 	gobject_class->constructed = gdata_documents_pdf_constructed;
 	entry_class->kind_term = "http://schemas.google.com/docs/2007#pdf";
+
+	_gdata_parsable_class_set_binary_funcs (GDATA_PARSABLE_CLASS (klass), NULL, NULL);
 }
 
 static void
@@ -53,6 +53,8 @@ gdata_documents_presentation_class_init (GDataDocumentsPresentationClass *klass)
 
 	gobject_class->constructed = gdata_documents_presentation_constructed;
 	entry_class->kind_term = "http://schemas.google.com/docs/2007#presentation";
+
+	_gdata_parsable_class_set_binary_funcs (GDATA_PARSABLE_CLASS (klass), NULL, NULL);
 }
 
 static void
@@ -680,6 +680,9 @@ gdata_documents_query_add_reader (GDataDocumentsQuery *self, const gchar *email_
 	address = gdata_gd_email_address_new (email_address, "reader", NULL, FALSE);
 	self->priv->reader_addresses = g_list_append (self->priv->reader_addresses, address);
 
+	/* This isn't a property, so doesn't notify */
+	_gdata_query_invalidate_uri (GDATA_QUERY (self));
+
 	/* Our current ETag will no longer be relevant */
 	gdata_query_set_etag (GDATA_QUERY (self), NULL);
 }
@@ -704,6 +707,59 @@ gdata_documents_query_add_collaborator (GDataDocumentsQuery *self, const gchar *
 	address = gdata_gd_email_address_new (email_address, "collaborator", NULL, FALSE);
 	self->priv->collaborator_addresses = g_list_append (self->priv->collaborator_addresses, address);
 
+	/* This isn't a property, so doesn't notify */
+	_gdata_query_invalidate_uri (GDATA_QUERY (self));
+
 	/* Our current ETag will no longer be relevant */
 	gdata_query_set_etag (GDATA_QUERY (self), NULL);
 }
+
+/**
+ * gdata_documents_query_set_field_mask:
+ * @self: a #GDataDocumentsQuery
+ * @fields: the entry fields to request
+ *
+ * Sets the #GDataQuery:fields property of the #GDataDocumentsQuery to a partial-response selector which requests only the given @fields
+ * of each file. The <code class="literal">kind</code> and <code class="literal">mimeType</code> of each file are always requested, as
+ * they are needed to pick the right #GDataDocumentsEntry subclass, as is the next page token so that gdata_query_next_page() keeps working.
+ *
+ * %GDATA_QUERY_FIELDS_UPDATED maps to the file's modification date, and %GDATA_QUERY_FIELDS_DELETED maps to its trashed label.
+ *
+ * Pass <code class="literal">0</code> as @fields to unset the property and request full entries again.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_documents_query_set_field_mask (GDataDocumentsQuery *self, GDataQueryFields fields)
+{
+	GString *selector;
+
+	g_return_if_fail (GDATA_IS_DOCUMENTS_QUERY (self));
+
+	fields &= GDATA_QUERY_FIELDS_ID | GDATA_QUERY_FIELDS_ETAG | GDATA_QUERY_FIELDS_UPDATED | GDATA_QUERY_FIELDS_TITLE |
+	          GDATA_QUERY_FIELDS_DELETED;
+
+	if (fields == 0) {
+		gdata_query_set_fields (GDATA_QUERY (self), NULL);
+		return;
+	}
+
+	/* See: https://developers.google.com/drive/v2/web/performance#partial-response */
+	selector = g_string_new ("kind,nextPageToken,items(kind,mimeType");
+
+	if (fields & GDATA_QUERY_FIELDS_ID)
+		g_string_append (selector, ",id");
+	if (fields & GDATA_QUERY_FIELDS_ETAG)
+		g_string_append (selector, ",etag");
+	if (fields & GDATA_QUERY_FIELDS_UPDATED)
+		g_string_append (selector, ",modifiedDate");
+	if (fields & GDATA_QUERY_FIELDS_TITLE)
+		g_string_append (selector, ",title");
+	if (fields & GDATA_QUERY_FIELDS_DELETED)
+		g_string_append (selector, ",labels(trashed)");
+
+	g_string_append_c (selector, ')');
+
+	gdata_query_set_fields (GDATA_QUERY (self), selector->str);
+	g_string_free (selector, TRUE);
+}
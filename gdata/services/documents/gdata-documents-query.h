@@ -86,6 +86,7 @@ GList *gdata_documents_query_get_collaborator_addresses (GDataDocumentsQuery *se
 GList *gdata_documents_query_get_reader_addresses (GDataDocumentsQuery *self) G_GNUC_PURE;
 void gdata_documents_query_add_reader (GDataDocumentsQuery *self, const gchar *email_address);
 void gdata_documents_query_add_collaborator (GDataDocumentsQuery *self, const gchar *email_address);
+void gdata_documents_query_set_field_mask (GDataDocumentsQuery *self, GDataQueryFields fields);
 
 G_END_DECLS
 
@@ -515,6 +515,48 @@ gdata_documents_service_query_documents_async (GDataDocumentsService *self, GDat
 	g_free (request_uri);
 }
 
+static gboolean
+documents_entry_is_deleted (GDataEntry *entry)
+{
+	return gdata_documents_entry_is_deleted (GDATA_DOCUMENTS_ENTRY (entry));
+}
+
+/**
+ * gdata_documents_service_create_sync_session:
+ * @self: a #GDataDocumentsService
+ *
+ * Creates a #GDataSyncSession for keeping a local copy of the authenticated user's documents up to date.
+ *
+ * Changes are queried from the <ulink type="http" url="https://developers.google.com/drive/v2/reference/changes/list">Drive changes
+ * feed</ulink>, and the session's cursor contains the ID of the next change to fetch. Documents which have been trashed, or which the user can
+ * no longer see, are reported as %GDATA_SYNC_CHANGE_DELETION changes; for permanently deleted documents only the ID of the entry is set.
+ *
+ * Return value: (transfer full): a new #GDataSyncSession; unref with g_object_unref()
+ *
+ * Since: 0.17.9
+ */
+GDataSyncSession *
+gdata_documents_service_create_sync_session (GDataDocumentsService *self)
+{
+	GDataQuery *query;
+	GDataSyncSession *session;
+	gchar *request_uri;
+
+	g_return_val_if_fail (GDATA_IS_DOCUMENTS_SERVICE (self), NULL);
+
+	/* The changes feed is paginated using page tokens, rather than start indices */
+	query = gdata_query_new (NULL);
+	_gdata_query_set_pagination_type (query, GDATA_QUERY_PAGINATION_TOKENS);
+
+	request_uri = g_strconcat (_gdata_service_get_scheme (), "://www.googleapis.com/drive/v2/changes", NULL);
+	session = _gdata_sync_session_new (GDATA_SERVICE (self), get_documents_authorization_domain (), request_uri, query,
+	                                   GDATA_TYPE_DOCUMENTS_ENTRY, "startChangeId", documents_entry_is_deleted);
+	g_free (request_uri);
+	g_object_unref (query);
+
+	return session;
+}
+
 static void
 add_folder_link_to_entry (GDataDocumentsEntry *entry, GDataDocumentsFolder *folder)
 {
@@ -25,6 +25,7 @@
 #include <gio/gio.h>
 #include <gdata/gdata-service.h>
 #include <gdata/gdata-upload-stream.h>
+#include <gdata/gdata-sync-session.h>
 #include <gdata/services/documents/gdata-documents-query.h>
 #include <gdata/services/documents/gdata-documents-feed.h>
 
@@ -102,6 +103,8 @@ void gdata_documents_service_query_documents_async (GDataDocumentsService *self,
                                                     GDestroyNotify destroy_progress_user_data,
                                                     GAsyncReadyCallback callback, gpointer user_data);
 
+GDataSyncSession *gdata_documents_service_create_sync_session (GDataDocumentsService *self) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+
 #include <gdata/services/documents/gdata-documents-document.h>
 #include <gdata/services/documents/gdata-documents-folder.h>
 #include <gdata/services/documents/gdata-documents-upload-query.h>
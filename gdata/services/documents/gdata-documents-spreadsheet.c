@@ -110,6 +110,8 @@ gdata_documents_spreadsheet_class_init (GDataDocumentsSpreadsheetClass *klass)
 
 	gobject_class->constructed = gdata_documents_spreadsheet_constructed;
 	entry_class->kind_term = "http://schemas.google.com/docs/2007#spreadsheet";
+
+	_gdata_parsable_class_set_binary_funcs (GDATA_PARSABLE_CLASS (klass), NULL, NULL);
 }
 
 static void
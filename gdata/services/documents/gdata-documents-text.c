@@ -53,6 +53,8 @@ gdata_documents_text_class_init (GDataDocumentsTextClass *klass)
 
 	gobject_class->constructed = gdata_documents_text_constructed;
 	entry_class->kind_term = "http://schemas.google.com/docs/2007#document";
+
+	_gdata_parsable_class_set_binary_funcs (GDATA_PARSABLE_CLASS (klass), NULL, NULL);
 }
 
 static void
@@ -45,6 +45,7 @@
 #include "gdata-freebase-search-query.h"
 #include "gdata-query.h"
 #include "gdata-parser.h"
+#include "gdata-private.h"
 
 G_GNUC_BEGIN_IGNORE_DEPRECATIONS
 
@@ -417,6 +418,9 @@ gdata_freebase_search_query_open_filter (GDataFreebaseSearchQuery *self, GDataFr
 	}
 
 	priv->filter_stack = g_list_prepend (priv->filter_stack, node);
+
+	/* The filter isn't a property, so doesn't notify */
+	_gdata_query_invalidate_uri (GDATA_QUERY (self));
 }
 
 /**
@@ -480,6 +484,8 @@ gdata_freebase_search_query_add_filter (GDataFreebaseSearchQuery *self, const gc
 
 	current_node = priv->filter_stack->data;
 	g_ptr_array_add (current_node->container.child_nodes, node);
+
+	_gdata_query_invalidate_uri (GDATA_QUERY (self));
 }
 
 /**
@@ -518,6 +524,8 @@ gdata_freebase_search_query_add_location (GDataFreebaseSearchQuery *self, guint6
 
 	current_node = priv->filter_stack->data;
 	g_ptr_array_add (current_node->container.child_nodes, node);
+
+	_gdata_query_invalidate_uri (GDATA_QUERY (self));
 }
 
 /**
@@ -967,6 +967,7 @@ gdata_picasaweb_album_set_location (GDataPicasaWebAlbum *self, const gchar *loca
 
 	g_free (self->priv->location);
 	self->priv->location = g_strdup (location);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "location");
 	g_object_notify (G_OBJECT (self), "location");
 }
 
@@ -1002,6 +1003,7 @@ gdata_picasaweb_album_set_visibility (GDataPicasaWebAlbum *self, GDataPicasaWebV
 	g_return_if_fail (GDATA_IS_PICASAWEB_ALBUM (self));
 
 	self->priv->visibility = visibility;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "visibility");
 	g_object_notify (G_OBJECT (self), "visibility");
 }
 
@@ -1042,6 +1044,7 @@ gdata_picasaweb_album_set_timestamp (GDataPicasaWebAlbum *self, gint64 timestamp
 	g_return_if_fail (timestamp >= -1);
 
 	self->priv->timestamp = timestamp;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "timestamp");
 	g_object_notify (G_OBJECT (self), "timestamp");
 }
 
@@ -1128,6 +1131,7 @@ gdata_picasaweb_album_set_is_commenting_enabled (GDataPicasaWebAlbum *self, gboo
 {
 	g_return_if_fail (GDATA_IS_PICASAWEB_ALBUM (self));
 	self->priv->is_commenting_enabled = is_commenting_enabled;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "is-commenting-enabled");
 	g_object_notify (G_OBJECT (self), "is-commenting-enabled");
 }
 
@@ -1182,6 +1186,7 @@ gdata_picasaweb_album_set_tags (GDataPicasaWebAlbum *self, const gchar * const *
 	g_return_if_fail (GDATA_IS_PICASAWEB_ALBUM (self));
 
 	gdata_media_group_set_keywords (self->priv->media_group, tags);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "tags");
 	g_object_notify (G_OBJECT (self), "tags");
 }
 
@@ -1262,7 +1267,9 @@ gdata_picasaweb_album_set_coordinates (GDataPicasaWebAlbum *self, gdouble latitu
 	gdata_georss_where_set_longitude (self->priv->georss_where, longitude);
 
 	g_object_freeze_notify (G_OBJECT (self));
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "latitude");
 	g_object_notify (G_OBJECT (self), "latitude");
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "longitude");
 	g_object_notify (G_OBJECT (self), "longitude");
 	g_object_thaw_notify (G_OBJECT (self));
 }
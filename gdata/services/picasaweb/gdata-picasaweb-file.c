@@ -1224,6 +1224,7 @@ gdata_picasaweb_file_set_album_id (GDataPicasaWebFile *self, const gchar *album_
 
 	g_free (self->priv->album_id);
 	self->priv->album_id = g_strdup (album_id);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "album-id");
 	g_object_notify (G_OBJECT (self), "album-id");
 }
 
@@ -1313,6 +1314,7 @@ gdata_picasaweb_file_set_checksum (GDataPicasaWebFile *self, const gchar *checks
 
 	g_free (self->priv->checksum);
 	self->priv->checksum = g_strdup (checksum);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "checksum");
 	g_object_notify (G_OBJECT (self), "checksum");
 }
 
@@ -1356,6 +1358,7 @@ gdata_picasaweb_file_set_timestamp (GDataPicasaWebFile *self, gint64 timestamp)
 	g_return_if_fail (timestamp >= -1);
 
 	self->priv->timestamp = timestamp;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "timestamp");
 	g_object_notify (G_OBJECT (self), "timestamp");
 }
 
@@ -1390,6 +1393,7 @@ gdata_picasaweb_file_set_is_commenting_enabled (GDataPicasaWebFile *self, gboole
 {
 	g_return_if_fail (GDATA_IS_PICASAWEB_FILE (self));
 	self->priv->is_commenting_enabled = is_commenting_enabled;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "is-commenting-enabled");
 	g_object_notify (G_OBJECT (self), "is-commenting-enabled");
 }
 
@@ -1444,6 +1448,7 @@ gdata_picasaweb_file_set_rotation (GDataPicasaWebFile *self, guint rotation)
 {
 	g_return_if_fail (GDATA_IS_PICASAWEB_FILE (self));
 	self->priv->rotation = rotation % 360;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "rotation");
 	g_object_notify (G_OBJECT (self), "rotation");
 }
 
@@ -1499,6 +1504,7 @@ gdata_picasaweb_file_set_tags (GDataPicasaWebFile *self, const gchar * const *ta
 	g_return_if_fail (GDATA_IS_PICASAWEB_FILE (self));
 
 	gdata_media_group_set_keywords (self->priv->media_group, tags);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "tags");
 	g_object_notify (G_OBJECT (self), "tags");
 }
 
@@ -1558,6 +1564,7 @@ gdata_picasaweb_file_set_caption (GDataPicasaWebFile *self, const gchar *caption
 
 	gdata_entry_set_summary (GDATA_ENTRY (self), caption);
 	gdata_media_group_set_description (self->priv->media_group, caption);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "caption");
 	g_object_notify (G_OBJECT (self), "caption");
 }
 
@@ -1795,7 +1802,9 @@ gdata_picasaweb_file_set_coordinates (GDataPicasaWebFile *self, gdouble latitude
 	gdata_georss_where_set_longitude (self->priv->georss_where, longitude);
 
 	g_object_freeze_notify (G_OBJECT (self));
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "latitude");
 	g_object_notify (G_OBJECT (self), "latitude");
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "longitude");
 	g_object_notify (G_OBJECT (self), "longitude");
 	g_object_thaw_notify (G_OBJECT (self));
 }
@@ -562,6 +562,9 @@ gdata_picasaweb_query_set_bounding_box (GDataPicasaWebQuery *self, gdouble north
 	self->priv->bounding_box.south = south;
 	self->priv->bounding_box.west = west;
 
+	/* This isn't a property, so doesn't notify */
+	_gdata_query_invalidate_uri (GDATA_QUERY (self));
+
 	/* Our current ETag will no longer be relevant */
 	gdata_query_set_etag (GDATA_QUERY (self), NULL);
 }
@@ -38,10 +38,12 @@
 #include <string.h>
 
 #include "gdata-tasks-service.h"
+#include "gdata-tasks-query.h"
 #include "gdata-service.h"
 #include "gdata-private.h"
 #include "gdata-query.h"
 #include "gdata-feed.h"
+#include "gdata-batchable.h"
 
 /* Standards reference here: https://developers.google.com/google-apps/tasks/v1/reference/ */
 
@@ -53,7 +55,7 @@ static void parse_error_response (GDataService *self,
 static GList *get_authorization_domains (void);
 
 _GDATA_DEFINE_AUTHORIZATION_DOMAIN (tasks, "tasks", "https://www.googleapis.com/auth/tasks")
-G_DEFINE_TYPE (GDataTasksService, gdata_tasks_service, GDATA_TYPE_SERVICE)
+G_DEFINE_TYPE_WITH_CODE (GDataTasksService, gdata_tasks_service, GDATA_TYPE_SERVICE, G_IMPLEMENT_INTERFACE (GDATA_TYPE_BATCHABLE, NULL))
 
 static void
 gdata_tasks_service_class_init (GDataTasksServiceClass *klass)
@@ -499,6 +501,55 @@ gdata_tasks_service_query_tasks_async (GDataTasksService *self, GDataTasksTaskli
 	g_free (request_uri);
 }
 
+static gboolean
+task_is_deleted (GDataEntry *entry)
+{
+	return gdata_tasks_task_is_deleted (GDATA_TASKS_TASK (entry));
+}
+
+/**
+ * gdata_tasks_service_create_sync_session:
+ * @self: a #GDataTasksService
+ * @tasklist: the #GDataTasksTasklist to keep up to date
+ *
+ * Creates a #GDataSyncSession for keeping a local copy of the tasks in @tasklist up to date. Completed and hidden tasks are included.
+ *
+ * The session's cursor is the latest update time of the tasks it has seen, and changes are queried using the
+ * <ulink type="http" url="https://developers.google.com/google-apps/tasks/v1/reference/tasks/list"><code class="literal">updatedMin</code>
+ * parameter</ulink>. Google Tasks doesn't give the creation times of tasks, so new tasks are reported as %GDATA_SYNC_CHANGE_UPDATE changes after
+ * the first run.
+ *
+ * Return value: (transfer full): a new #GDataSyncSession; unref with g_object_unref()
+ *
+ * Since: 0.17.9
+ */
+GDataSyncSession *
+gdata_tasks_service_create_sync_session (GDataTasksService *self, GDataTasksTasklist *tasklist)
+{
+	GDataTasksQuery *query;
+	GDataSyncSession *session;
+	gchar *request_uri;
+
+	g_return_val_if_fail (GDATA_IS_TASKS_SERVICE (self), NULL);
+	g_return_val_if_fail (GDATA_IS_TASKS_TASKLIST (tasklist), NULL);
+	g_return_val_if_fail (gdata_entry_get_id (GDATA_ENTRY (tasklist)) != NULL, NULL);
+
+	/* Deleted tasks have to be included so that deletions can be reported */
+	query = gdata_tasks_query_new (NULL);
+	gdata_query_set_max_results (GDATA_QUERY (query), 100);
+	gdata_tasks_query_set_show_completed (query, TRUE);
+	gdata_tasks_query_set_show_deleted (query, TRUE);
+	gdata_tasks_query_set_show_hidden (query, TRUE);
+
+	request_uri = g_strconcat (_gdata_service_get_scheme (), "://www.googleapis.com/tasks/v1/lists/", gdata_entry_get_id (GDATA_ENTRY (tasklist)), "/tasks", NULL);
+	session = _gdata_sync_session_new (GDATA_SERVICE (self), get_tasks_authorization_domain (), request_uri, GDATA_QUERY (query),
+	                                   GDATA_TYPE_TASKS_TASK, NULL, task_is_deleted);
+	g_free (request_uri);
+	g_object_unref (query);
+
+	return session;
+}
+
 /**
  * gdata_tasks_service_insert_task:
  * @self: a #GDataTasksService
@@ -25,6 +25,7 @@
 
 #include <gdata/gdata-service.h>
 #include <gdata/gdata-query.h>
+#include <gdata/gdata-sync-session.h>
 #include <gdata/services/tasks/gdata-tasks-tasklist.h>
 #include <gdata/services/tasks/gdata-tasks-task.h>
 
@@ -85,6 +86,9 @@ void gdata_tasks_service_query_tasks_async (GDataTasksService *self, GDataTasksT
                                             GCancellable *cancellable, GDataQueryProgressCallback progress_callback, gpointer progress_user_data,
                                             GDestroyNotify destroy_progress_user_data, GAsyncReadyCallback callback, gpointer user_data);
 
+GDataSyncSession *gdata_tasks_service_create_sync_session (GDataTasksService *self,
+                                                           GDataTasksTasklist *tasklist) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
+
 GDataTasksTask *gdata_tasks_service_insert_task (GDataTasksService *self, GDataTasksTask *task, GDataTasksTasklist *tasklist,
                                                  GCancellable *cancellable, GError **error) G_GNUC_MALLOC G_GNUC_WARN_UNUSED_RESULT;
 void gdata_tasks_service_insert_task_async (GDataTasksService *self, GDataTasksTask *task, GDataTasksTasklist *tasklist,
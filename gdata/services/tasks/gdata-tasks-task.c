@@ -52,6 +52,8 @@ static void gdata_tasks_task_set_property (GObject *object, guint property_id, c
 static void get_json (GDataParsable *parsable, JsonBuilder *builder);
 static gboolean parse_json (GDataParsable *parsable, JsonReader *reader, gpointer user_data, GError **error);
 static const gchar *get_content_type (void);
+static void get_binary (GDataParsable *parsable, GDataBinaryWriter *writer);
+static void parse_binary (GDataParsable *parsable, GDataBinaryReader *reader);
 
 struct _GDataTasksTaskPrivate {
 	gchar *parent;
@@ -213,6 +215,13 @@ gdata_tasks_task_class_init (GDataTasksTaskClass *klass)
 	                                 "Hidden?", "Indicated whatever task is hidden.",
 	                                 FALSE,
 	                                 G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+	/* Members to send in partial updates when the properties change. Tasks have no description. */
+	_gdata_parsable_class_set_patch_name (parsable_class, "summary", "");
+	_gdata_parsable_class_set_patch_name (parsable_class, "is-deleted", "deleted");
+	_gdata_parsable_class_set_patch_name (parsable_class, "is-hidden", "hidden");
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, get_binary, parse_binary);
 }
 
 static void
@@ -422,6 +431,26 @@ get_content_type (void)
 	return "application/json";
 }
 
+static void
+get_binary (GDataParsable *parsable, GDataBinaryWriter *writer)
+{
+	GDataTasksTaskPrivate *priv = GDATA_TASKS_TASK (parsable)->priv;
+
+	gdata_binary_writer_put_string (writer, priv->parent);
+	gdata_binary_writer_put_string (writer, priv->position);
+	gdata_binary_writer_put_boolean (writer, priv->hidden);
+}
+
+static void
+parse_binary (GDataParsable *parsable, GDataBinaryReader *reader)
+{
+	GDataTasksTaskPrivate *priv = GDATA_TASKS_TASK (parsable)->priv;
+
+	priv->parent = gdata_binary_reader_dup_string (reader);
+	priv->position = gdata_binary_reader_dup_string (reader);
+	priv->hidden = gdata_binary_reader_get_boolean (reader);
+}
+
 /**
  * gdata_tasks_task_new:
  * @id: (allow-none): the task's ID, or %NULL
@@ -509,6 +538,7 @@ gdata_tasks_task_set_notes (GDataTasksTask *self, const gchar *notes)
 	local_notes = self->priv->notes;
 	self->priv->notes = g_strdup (notes);
 	g_free (local_notes);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "notes");
 	g_object_notify (G_OBJECT (self), "notes");
 }
 
@@ -549,6 +579,7 @@ gdata_tasks_task_set_status (GDataTasksTask *self, const gchar *status)
 	local_status = self->priv->status;
 	self->priv->status = g_strdup (status);
 	g_free (local_status);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "status");
 	g_object_notify (G_OBJECT (self), "status");
 }
 
@@ -587,6 +618,7 @@ gdata_tasks_task_set_due (GDataTasksTask *self, gint64 due)
 	g_return_if_fail (due >= -1);
 
 	self->priv->due = due;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "due");
 	g_object_notify (G_OBJECT (self), "due");
 }
 
@@ -625,6 +657,7 @@ gdata_tasks_task_set_completed (GDataTasksTask *self, gint64 completed)
 	g_return_if_fail (completed >= -1);
 
 	self->priv->completed = completed;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "completed");
 	g_object_notify (G_OBJECT (self), "completed");
 }
 
@@ -659,6 +692,7 @@ gdata_tasks_task_set_is_deleted (GDataTasksTask *self, gboolean deleted)
 {
 	g_return_if_fail (GDATA_IS_TASKS_TASK (self));
 	self->priv->deleted = deleted;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "is-deleted");
 	g_object_notify (G_OBJECT (self), "is-deleted");
 }
 
@@ -55,6 +55,8 @@ gdata_tasks_tasklist_class_init (GDataTasksTasklistClass *klass)
 	parsable_class->get_content_type = get_content_type;
 
 	entry_class->kind_term = "tasks#taskList";
+
+	_gdata_parsable_class_set_binary_funcs (parsable_class, NULL, NULL);
 }
 
 static void
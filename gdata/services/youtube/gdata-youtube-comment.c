@@ -514,6 +514,7 @@ gdata_youtube_comment_set_parent_comment_uri (GDataYouTubeComment *self, const g
 		gdata_link_set_uri (link_, parent_comment_uri);
 	}
 
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "parent-comment-uri");
 	g_object_notify (G_OBJECT (self), "parent-comment-uri");
 }
 
@@ -578,6 +578,9 @@ get_query_uri (GDataQuery *self, const gchar *feed_uri, GString *query_uri, gboo
 
 		g_get_current_time (&tv);
 
+		/* The URI depends on the current time, so mustn't be cached */
+		_gdata_query_mark_uri_volatile (self);
+
 		/* Squash the microseconds; they’re not useful. */
 		tv.tv_usec = 0;
 
@@ -669,6 +672,9 @@ get_query_uri (GDataQuery *self, const gchar *feed_uri, GString *query_uri, gboo
 			                             FALSE);
 		}
 	}
+
+	/* Partial response selector */
+	_gdata_query_append_fields (self, query_uri, params_started);
 }
 
 /**
@@ -1125,3 +1131,54 @@ gdata_youtube_query_set_license (GDataYouTubeQuery *self, const gchar *license)
 	/* Our current ETag will no longer be relevant */
 	gdata_query_set_etag (GDATA_QUERY (self), NULL);
 }
+
+/**
+ * gdata_youtube_query_set_field_mask:
+ * @self: a #GDataYouTubeQuery
+ * @fields: the entry fields to request
+ *
+ * Sets the #GDataQuery:fields property of the #GDataYouTubeQuery to a partial-response selector which requests only the given @fields
+ * of each video. The <code class="literal">kind</code> of each result, the page info and the page tokens are always requested, so that
+ * result parsing and pagination keep working.
+ *
+ * YouTube videos have no modification time, so %GDATA_QUERY_FIELDS_UPDATED maps to the video's publication time (see
+ * gdata_entry_get_published()). %GDATA_QUERY_FIELDS_DELETED is not supported by YouTube, and is ignored.
+ *
+ * Pass <code class="literal">0</code> as @fields to unset the property and request full entries again.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_youtube_query_set_field_mask (GDataYouTubeQuery *self, GDataQueryFields fields)
+{
+	GString *selector;
+
+	g_return_if_fail (GDATA_IS_YOUTUBE_QUERY (self));
+
+	fields &= GDATA_QUERY_FIELDS_ID | GDATA_QUERY_FIELDS_ETAG | GDATA_QUERY_FIELDS_UPDATED | GDATA_QUERY_FIELDS_TITLE;
+
+	if (fields == 0) {
+		gdata_query_set_fields (GDATA_QUERY (self), NULL);
+		return;
+	}
+
+	/* See: https://developers.google.com/youtube/v3/getting-started#fields */
+	selector = g_string_new ("kind,nextPageToken,prevPageToken,pageInfo,items(kind");
+
+	if (fields & GDATA_QUERY_FIELDS_ID)
+		g_string_append (selector, ",id");
+	if (fields & GDATA_QUERY_FIELDS_ETAG)
+		g_string_append (selector, ",etag");
+
+	if ((fields & GDATA_QUERY_FIELDS_UPDATED) && (fields & GDATA_QUERY_FIELDS_TITLE))
+		g_string_append (selector, ",snippet(publishedAt,title)");
+	else if (fields & GDATA_QUERY_FIELDS_UPDATED)
+		g_string_append (selector, ",snippet/publishedAt");
+	else if (fields & GDATA_QUERY_FIELDS_TITLE)
+		g_string_append (selector, ",snippet/title");
+
+	g_string_append_c (selector, ')');
+
+	gdata_query_set_fields (GDATA_QUERY (self), selector->str);
+	g_string_free (selector, TRUE);
+}
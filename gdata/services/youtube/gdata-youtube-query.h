@@ -178,6 +178,7 @@ GDataYouTubeAge gdata_youtube_query_get_age (GDataYouTubeQuery *self) G_GNUC_PUR
 void gdata_youtube_query_set_age (GDataYouTubeQuery *self, GDataYouTubeAge age);
 const gchar *gdata_youtube_query_get_license (GDataYouTubeQuery *self) G_GNUC_PURE;
 void gdata_youtube_query_set_license (GDataYouTubeQuery *self, const gchar *license);
+void gdata_youtube_query_set_field_mask (GDataYouTubeQuery *self, GDataQueryFields fields);
 
 #ifndef LIBGDATA_DISABLE_DEPRECATED
 G_GNUC_BEGIN_IGNORE_DEPRECATIONS
@@ -1635,6 +1635,7 @@ gdata_youtube_video_set_location (GDataYouTubeVideo *self, const gchar *location
 
 	g_free (self->priv->location);
 	self->priv->location = g_strdup (location);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "location");
 	g_object_notify (G_OBJECT (self), "location");
 }
 
@@ -1746,6 +1747,7 @@ gdata_youtube_video_set_keywords (GDataYouTubeVideo *self, const gchar * const *
 
 	g_strfreev (self->priv->keywords);
 	self->priv->keywords = g_strdupv ((gchar **) keywords);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "keywords");
 	g_object_notify (G_OBJECT (self), "keywords");
 }
 
@@ -1955,6 +1957,7 @@ gdata_youtube_video_set_category (GDataYouTubeVideo *self, GDataMediaCategory *c
 	g_object_ref (category);
 	g_clear_object (&self->priv->category);
 	self->priv->category = category;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "category");
 	g_object_notify (G_OBJECT (self), "category");
 }
 
@@ -2008,6 +2011,7 @@ gdata_youtube_video_set_description (GDataYouTubeVideo *self, const gchar *descr
 {
 	g_return_if_fail (GDATA_IS_YOUTUBE_VIDEO (self));
 	gdata_entry_set_summary (GDATA_ENTRY (self), description);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "description");
 	g_object_notify (G_OBJECT (self), "description");
 }
 
@@ -2095,6 +2099,7 @@ gdata_youtube_video_set_is_private (GDataYouTubeVideo *self, gboolean is_private
 {
 	g_return_if_fail (GDATA_IS_YOUTUBE_VIDEO (self));
 	self->priv->is_private = is_private;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "is-private");
 	g_object_notify (G_OBJECT (self), "is-private");
 }
 
@@ -2161,6 +2166,7 @@ gdata_youtube_video_set_is_draft (GDataYouTubeVideo *self, gboolean is_draft)
 {
 	g_return_if_fail (GDATA_IS_YOUTUBE_VIDEO (self));
 	gdata_youtube_video_set_is_private (self, is_draft);
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "is-draft");
 	g_object_notify (G_OBJECT (self), "is-draft");
 }
 
@@ -2319,6 +2325,7 @@ gdata_youtube_video_set_recorded (GDataYouTubeVideo *self, gint64 recorded)
 	g_return_if_fail (recorded >= -1);
 
 	self->priv->recorded = recorded;
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "recorded");
 	g_object_notify (G_OBJECT (self), "recorded");
 }
 
@@ -2471,7 +2478,9 @@ gdata_youtube_video_set_coordinates (GDataYouTubeVideo *self, gdouble latitude,
 	self->priv->longitude = longitude;
 
 	g_object_freeze_notify (G_OBJECT (self));
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "latitude");
 	g_object_notify (G_OBJECT (self), "latitude");
+	_gdata_parsable_mark_property_dirty (GDATA_PARSABLE (self), "longitude");
 	g_object_notify (G_OBJECT (self), "longitude");
 	g_object_thaw_notify (G_OBJECT (self));
 }
@@ -946,6 +946,93 @@ test_event_json_recurrence (void)
 	g_object_unref (event);
 }
 
+static void
+test_event_recurrence_expansion (void)
+{
+	GDataCalendarEvent *event;
+	GDataCalendarRecurrenceIter *iter;
+	GError *error = NULL;
+	gint64 start_time, end_time;
+	guint i;
+	const gint64 weekly_instances[] = {
+		1490000400, /* 2017-03-20 09:00 GMT */
+		/* 2017-03-27 is excluded */
+		1490785200, /* 2017-03-29 12:00 BST, from the RDATE */
+		1491206400, /* 2017-04-03 09:00 BST */
+		1491811200, /* 2017-04-10 09:00 BST */
+	};
+	const gint64 monthly_instances[] = {
+		1485820800, /* 2017-01-31 */
+		1488240000, /* 2017-02-28 */
+		1490918400, /* 2017-03-31 */
+	};
+
+	/* A weekly event which crosses the start of British Summer Time, and should keep its local time */
+	event = GDATA_CALENDAR_EVENT (gdata_parsable_new_from_json (GDATA_TYPE_CALENDAR_EVENT, "{"
+		"'kind': 'calendar#event',"
+		"'summary': 'Weekly meeting',"
+		"'start': {"
+			"'dateTime': '2017-03-20T09:00:00Z',"
+			"'timeZone': 'Europe/London'"
+		"},"
+		"'end': {"
+			"'dateTime': '2017-03-20T10:00:00Z',"
+			"'timeZone': 'Europe/London'"
+		"},"
+		"'recurrence': ["
+			"'RRULE:FREQ=WEEKLY;BYDAY=MO;COUNT=4',"
+			"'EXDATE;TZID=Europe/London:20170327T090000',"
+			"'RDATE;TZID=Europe/London:20170329T120000'"
+		"]"
+	"}", -1, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_CALENDAR_EVENT (event));
+
+	iter = gdata_calendar_event_expand_recurrence (event, -1, -1, NULL, &error);
+	g_assert_no_error (error);
+	g_assert (iter != NULL);
+
+	for (i = 0; i < G_N_ELEMENTS (weekly_instances); i++) {
+		g_assert (gdata_calendar_recurrence_iter_next (iter, &start_time, &end_time) == TRUE);
+		g_assert_cmpint (start_time, ==, weekly_instances[i]);
+		g_assert_cmpint (end_time, ==, weekly_instances[i] + 60 * 60);
+	}
+
+	g_assert (gdata_calendar_recurrence_iter_next (iter, &start_time, &end_time) == FALSE);
+	gdata_calendar_recurrence_iter_unref (iter);
+
+	/* Only instances inside the window should be returned */
+	iter = gdata_calendar_event_expand_recurrence (event, 1491004800 /* 2017-04-01 */, 1491350400 /* 2017-04-05 */, NULL, &error);
+	g_assert_no_error (error);
+
+	g_assert (gdata_calendar_recurrence_iter_next (iter, &start_time, NULL) == TRUE);
+	g_assert_cmpint (start_time, ==, weekly_instances[2]);
+	g_assert (gdata_calendar_recurrence_iter_next (iter, &start_time, NULL) == FALSE);
+
+	gdata_calendar_recurrence_iter_unref (iter);
+	g_object_unref (event);
+
+	/* An all-day event on the last day of each month */
+	iter = gdata_calendar_recurrence_iter_new ("RRULE:FREQ=MONTHLY;BYMONTHDAY=-1;COUNT=3", 1485820800, 1485820800 + 24 * 60 * 60, TRUE, NULL,
+	                                           -1, -1, &error);
+	g_assert_no_error (error);
+
+	for (i = 0; i < G_N_ELEMENTS (monthly_instances); i++) {
+		g_assert (gdata_calendar_recurrence_iter_next (iter, &start_time, &end_time) == TRUE);
+		g_assert_cmpint (start_time, ==, monthly_instances[i]);
+		g_assert_cmpint (end_time, ==, monthly_instances[i] + 24 * 60 * 60);
+	}
+
+	g_assert (gdata_calendar_recurrence_iter_next (iter, &start_time, &end_time) == FALSE);
+	gdata_calendar_recurrence_iter_unref (iter);
+
+	/* Invalid rules should be rejected */
+	iter = gdata_calendar_recurrence_iter_new ("RRULE:FREQ=FORTNIGHTLY", 1485820800, 1485820800, FALSE, NULL, -1, -1, &error);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR);
+	g_assert (iter == NULL);
+	g_clear_error (&error);
+}
+
 static void
 test_calendar_escaping (void)
 {
@@ -1430,6 +1517,101 @@ test_access_rule_delete (TempCalendarAclsData *data, gconstpointer service)
 	uhm_server_end_trace (mock_server);
 }
 
+/* Check that the session's cursor holds @token, and the time of a run which started at or after @run_time. */
+static void
+assert_sync_cursor (GDataSyncSession *session, gint64 run_time, const gchar *token)
+{
+	gchar *cursor, *end;
+	gint64 sync_time;
+
+	cursor = gdata_sync_session_dup_cursor (session);
+	g_assert (cursor != NULL);
+
+	sync_time = g_ascii_strtoll (cursor, &end, 10);
+	g_assert_cmpint (sync_time, >=, run_time);
+	g_assert_cmpint (sync_time, <=, run_time + TIME_FUZZINESS);
+	g_assert_cmpstr (end, ==, token);
+
+	g_free (cursor);
+}
+
+/* Test that a sync session for a calendar does a full sync on its first run, then only fetches the events changed since the sync token returned by
+ * the previous run, classifying them as insertions or updates by their creation times. The trace is hand-written. */
+static void
+test_sync_session (gconstpointer service)
+{
+	GDataSyncSession *session;
+	GString *changes;
+	gchar *cursor, *new_cursor;
+	gint64 run_time;
+	GError *error = NULL;
+
+	gdata_test_mock_server_start_trace (mock_server, "sync-session");
+
+	session = gdata_calendar_service_create_sync_session (GDATA_CALENDAR_SERVICE (service), NULL);
+	g_assert (GDATA_IS_SYNC_SESSION (session));
+	g_assert (gdata_sync_session_get_service (session) == service);
+	g_assert (gdata_sync_session_get_authorization_domain (session) == gdata_calendar_service_get_primary_authorization_domain ());
+	g_assert_cmpstr (gdata_sync_session_get_feed_uri (session), ==, "https://www.googleapis.com/calendar/v3/calendars/default/events");
+	g_assert (gdata_sync_session_dup_cursor (session) == NULL);
+
+	/* The first run is a full sync across two pages, and cancelled events aren't reported */
+	changes = g_string_new (NULL);
+	run_time = g_get_real_time () / G_USEC_PER_SEC;
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpstr (changes->str, ==, "reset insertion:sync1event insertion:sync2event");
+	assert_sync_cursor (session, run_time, ":CMCjqpeJrsUCEMCjqpeJrsUCGAU=");
+
+	/* Restore a cursor from 21:35, after the first two events were created. The events created before then are updates, and those created since
+	 * are insertions. */
+	gdata_sync_session_set_cursor (session, "1430948100:CMCjqpeJrsUCEMCjqpeJrsUCGAU=");
+	cursor = gdata_sync_session_dup_cursor (session);
+	g_assert_cmpstr (cursor, ==, "1430948100:CMCjqpeJrsUCEMCjqpeJrsUCGAU=");
+	g_free (cursor);
+
+	g_string_truncate (changes, 0);
+	run_time = g_get_real_time () / G_USEC_PER_SEC;
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpstr (changes->str, ==, "update:sync1event insertion:sync4event deletion:sync2event");
+	assert_sync_cursor (session, run_time, ":CPDAlvWDx8UCEPDAlvWDx8UCGAU=");
+
+	/* A failed run leaves the cursor where it was */
+	cursor = gdata_sync_session_dup_cursor (session);
+
+	g_string_truncate (changes, 0);
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == FALSE);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR);
+	g_clear_error (&error);
+	g_assert_cmpstr (changes->str, ==, "");
+
+	new_cursor = gdata_sync_session_dup_cursor (session);
+	g_assert_cmpstr (new_cursor, ==, cursor);
+	g_free (new_cursor);
+	g_free (cursor);
+
+	/* If the service rejects the sync token with 410 Gone, the run falls back to a full sync */
+	run_time = g_get_real_time () / G_USEC_PER_SEC;
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpstr (changes->str, ==, "reset insertion:sync1event insertion:sync4event");
+	assert_sync_cursor (session, run_time, ":CKCbrJODx8UCEKCbrJODx8UCGAU=");
+
+	/* Malformed cursors, and cursors without a sync token, are ignored */
+	gdata_sync_session_set_cursor (session, "CKCbrJODx8UCEKCbrJODx8UCGAU=");
+	g_assert (gdata_sync_session_dup_cursor (session) == NULL);
+	gdata_sync_session_set_cursor (session, "-1:CKCbrJODx8UCEKCbrJODx8UCGAU=");
+	g_assert (gdata_sync_session_dup_cursor (session) == NULL);
+	gdata_sync_session_set_cursor (session, "1430948100:");
+	g_assert (gdata_sync_session_dup_cursor (session) == NULL);
+
+	g_string_free (changes, TRUE);
+	g_object_unref (session);
+
+	uhm_server_end_trace (mock_server);
+}
+
 static void
 mock_server_notify_resolver_cb (GObject *object, GParamSpec *pspec, gpointer user_data)
 {
@@ -1560,6 +1742,8 @@ main (int argc, char *argv[])
 	g_test_add ("/calendar/event/insert/async/cancellation", GDataAsyncTestData, service, set_up_insert_event_async,
 	            test_event_insert_async_cancellation, tear_down_insert_event_async);
 
+	g_test_add_data_func ("/calendar/sync-session", service, test_sync_session);
+
 	g_test_add ("/calendar/access-rule/get", TempCalendarAclsData, service, set_up_temp_calendar_acls, test_access_rule_get,
 	            tear_down_temp_calendar_acls);
 	g_test_add ("/calendar/access-rule/insert", TempCalendarAclsData, service, set_up_temp_calendar_acls_no_insertion,
@@ -1574,6 +1758,7 @@ main (int argc, char *argv[])
 	g_test_add_func ("/calendar/event/json/dates", test_event_json_dates);
 	g_test_add_func ("/calendar/event/json/organizer", test_event_json_organizer);
 	g_test_add_func ("/calendar/event/json/recurrence", test_event_json_recurrence);
+	g_test_add_func ("/calendar/event/recurrence/expansion", test_event_recurrence_expansion);
 	g_test_add_func ("/calendar/event/escaping", test_event_escaping);
 	g_test_add_func ("/calendar/event/parser/minimal",
 	                 test_calendar_event_parser_minimal);
@@ -1020,6 +1020,68 @@ gdata_test_mock_server_handle_message_timeout (UhmServer *server, SoupMessage *m
 	return TRUE;
 }
 
+static gboolean
+record_request_cb (UhmServer *server, SoupMessage *message, SoupClientContext *client, GPtrArray *requests)
+{
+	g_ptr_array_add (requests, g_object_ref (message));
+
+	/* Let the trace (or the online server) provide the response as normal */
+	return FALSE;
+}
+
+/**
+ * gdata_test_mock_server_record_requests:
+ * @server: a #UhmServer
+ * @requests: (element-type SoupMessage): an array to add the requests to, which should free its elements with g_object_unref()
+ *
+ * Adds a reference to each #SoupMessage received by @server from now on to @requests, so that tests can check the method, headers and
+ * body of the requests libgdata sends, which aren't compared against the trace file. The requests should only be inspected once the
+ * operation which sent them has finished.
+ *
+ * Return value: the ID of the #UhmServer::handle-message handler; pass it to g_signal_handler_disconnect() to stop recording
+ *
+ * Since: 0.17.9
+ */
+gulong
+gdata_test_mock_server_record_requests (UhmServer *server, GPtrArray *requests)
+{
+	g_return_val_if_fail (UHM_IS_SERVER (server), 0);
+	g_return_val_if_fail (requests != NULL, 0);
+
+	return g_signal_connect (server, "handle-message", (GCallback) record_request_cb, requests);
+}
+
+/**
+ * gdata_test_sync_session_record_change:
+ * @change_type: the type of change
+ * @entry: (allow-none): the changed entry, or %NULL for a %GDATA_SYNC_CHANGE_RESET change
+ * @user_data: a #GString to append the change to
+ *
+ * #GDataSyncSessionCallback which appends a description of each change to the #GString passed as @user_data, so that the changes reported
+ * by a sync session run can be compared against a single expected string. Changes are separated by spaces, and each is described by its type,
+ * followed by the ID of its entry (if it has one); for example: <literal>reset insertion:a update:b deletion:c</literal>.
+ *
+ * Since: 0.17.9
+ */
+void
+gdata_test_sync_session_record_change (GDataSyncChangeType change_type, GDataEntry *entry, gpointer user_data)
+{
+	GString *changes = user_data;
+	const gchar *change_type_names[] = { "reset", "insertion", "update", "deletion" };
+
+	g_assert_cmpuint (change_type, <, G_N_ELEMENTS (change_type_names));
+	g_assert ((change_type == GDATA_SYNC_CHANGE_RESET) == (entry == NULL));
+
+	if (changes->len > 0)
+		g_string_append_c (changes, ' ');
+	g_string_append (changes, change_type_names[change_type]);
+
+	if (entry != NULL) {
+		g_assert (GDATA_IS_ENTRY (entry));
+		g_string_append_printf (changes, ":%s", gdata_entry_get_id (entry));
+	}
+}
+
 /**
  * gdata_test_query_user_for_verifier:
  * @authentication_uri: authentication URI to present
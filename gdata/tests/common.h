@@ -336,6 +336,9 @@ void gdata_test_set_https_port (UhmServer *server);
 void gdata_test_mock_server_start_trace (UhmServer *server, const gchar *trace_filename);
 gboolean gdata_test_mock_server_handle_message_error (UhmServer *server, SoupMessage *message, SoupClientContext *client, gpointer user_data);
 gboolean gdata_test_mock_server_handle_message_timeout (UhmServer *server, SoupMessage *message, SoupClientContext *client, gpointer user_data);
+gulong gdata_test_mock_server_record_requests (UhmServer *server, GPtrArray *requests);
+
+void gdata_test_sync_session_record_change (GDataSyncChangeType change_type, GDataEntry *entry, gpointer user_data);
 
 gchar *gdata_test_query_user_for_verifier (const gchar *authentication_uri) G_GNUC_WARN_UNUSED_RESULT G_GNUC_MALLOC;
 
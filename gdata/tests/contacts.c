@@ -593,6 +593,692 @@ test_contact_update (TempContactData *data, gconstpointer service)
 	uhm_server_end_trace (mock_server);
 }
 
+/* Test that a partial update only sends the elements which have changed, and that the updated ETag is merged back into the local contact so it
+ * can be patched again. The trace is hand-written. */
+static void
+test_contact_patch (gconstpointer service)
+{
+	GDataContactsContact *contact, *new_contact;
+	GDataGDEmailAddress *email_address;
+	GDataEntry *same_entry;
+	GPtrArray *requests;
+	SoupMessage *request;
+	gulong handler_id;
+	GError *error = NULL;
+
+	contact = GDATA_CONTACTS_CONTACT (gdata_parsable_new_from_xml (GDATA_TYPE_CONTACTS_CONTACT,
+		"<entry xmlns='http://www.w3.org/2005/Atom' "
+			"xmlns:gd='http://schemas.google.com/g/2005' "
+			"xmlns:gContact='http://schemas.google.com/contact/2008' "
+			"gd:etag='&quot;Q3g7cTVSLit7I2A9XRdWFEUDQgc.&quot;'>"
+			"<id>http://www.google.com/m8/feeds/contacts/libgdata.test%40googlemail.com/base/c8390ec0ef7f98a</id>"
+			"<updated>2014-11-08T23:32:12.000Z</updated>"
+			"<category scheme='http://schemas.google.com/g/2005#kind' term='http://schemas.google.com/contact/2008#contact'/>"
+			"<title>John Wilson</title>"
+			"<link rel='http://www.iana.org/assignments/relation/self' type='application/atom+xml' "
+			      "href='https://www.google.com/m8/feeds/contacts/libgdata.test%40googlemail.com/full/c8390ec0ef7f98a'/>"
+			"<link rel='http://www.iana.org/assignments/relation/edit' type='application/atom+xml' "
+			      "href='https://www.google.com/m8/feeds/contacts/libgdata.test%40googlemail.com/full/c8390ec0ef7f98a'/>"
+			"<gd:name><gd:fullName>John Wilson</gd:fullName></gd:name>"
+			"<gd:email rel='http://schemas.google.com/g/2005#work' address='john@example.com' primary='true'/>"
+			"<gd:phoneNumber rel='http://schemas.google.com/g/2005#home'>(206)555-1212</gd:phoneNumber>"
+			"<gContact:nickname>Johnny</gContact:nickname>"
+			"<gContact:hobby>Rowing</gContact:hobby>"
+			"<foo:bar xmlns:foo='http://example.com/'>Unhandled</foo:bar>"
+		"</entry>", -1, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_CONTACTS_CONTACT (contact));
+
+	/* Change a property, add to one multi-valued element and clear another. Adding a hobby the contact already has shouldn't count as a
+	 * change. */
+	gdata_contacts_contact_set_nickname (contact, "Jack");
+	email_address = gdata_gd_email_address_new ("bob@example.com", GDATA_GD_EMAIL_ADDRESS_HOME, NULL, FALSE);
+	gdata_contacts_contact_add_email_address (contact, email_address);
+	g_object_unref (email_address);
+	gdata_contacts_contact_remove_all_phone_numbers (contact);
+	gdata_contacts_contact_add_hobby (contact, "Rowing");
+
+	gdata_test_mock_server_start_trace (mock_server, "contact-patch");
+	requests = g_ptr_array_new_with_free_func (g_object_unref);
+	handler_id = gdata_test_mock_server_record_requests (mock_server, requests);
+
+	new_contact = GDATA_CONTACTS_CONTACT (gdata_service_patch_entry (GDATA_SERVICE (service),
+	                                                                 gdata_contacts_service_get_primary_authorization_domain (),
+	                                                                 GDATA_ENTRY (contact), NULL, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_CONTACTS_CONTACT (new_contact));
+
+	/* Check the request: only the changed elements should have been sent, with gd:fields listing all of them (including the phone numbers,
+	 * which have no elements left) but not the unchanged hobbies or the unhandled XML. */
+	g_assert_cmpuint (requests->len, ==, 1);
+	request = g_ptr_array_index (requests, 0);
+	g_assert_cmpstr (request->method, ==, "PATCH");
+	g_assert_cmpstr (soup_message_headers_get_one (request->request_headers, "If-Match"), ==, "\"Q3g7cTVSLit7I2A9XRdWFEUDQgc.\"");
+	g_assert_cmpstr (soup_message_headers_get_content_type (request->request_headers, NULL), ==, "application/xml");
+	g_assert (gdata_test_compare_xml_strings (request->request_body->data,
+		"<?xml version='1.0' encoding='UTF-8'?>"
+		"<entry xmlns='http://www.w3.org/2005/Atom' "
+		       "xmlns:gd='http://schemas.google.com/g/2005' "
+		       "xmlns:app='http://www.w3.org/2007/app' "
+		       "xmlns:gContact='http://schemas.google.com/contact/2008' "
+		       "gd:etag='&quot;Q3g7cTVSLit7I2A9XRdWFEUDQgc.&quot;' "
+		       "gd:fields='gContact:nickname,gd:email,gd:phoneNumber'>"
+			"<gd:email address='john@example.com' rel='http://schemas.google.com/g/2005#work' primary='true'/>"
+			"<gd:email address='bob@example.com' rel='http://schemas.google.com/g/2005#home' primary='false'/>"
+			"<gContact:nickname>Jack</gContact:nickname>"
+		"</entry>", TRUE) == TRUE);
+
+	/* Check the returned contact */
+	g_assert_cmpstr (gdata_contacts_contact_get_nickname (new_contact), ==, "Jack");
+	g_assert_cmpuint (g_list_length (gdata_contacts_contact_get_email_addresses (new_contact)), ==, 2);
+	g_assert (gdata_contacts_contact_get_phone_numbers (new_contact) == NULL);
+	g_object_unref (new_contact);
+
+	/* The server's ETag and update time should have been merged back into the local contact, and its changes forgotten */
+	g_assert_cmpstr (gdata_entry_get_etag (GDATA_ENTRY (contact)), ==, "\"Qnw7fjVSLyt7I2A9XRdWFEUDQgA.\"");
+	g_assert_cmpint (gdata_entry_get_updated (GDATA_ENTRY (contact)), ==, 1415489543);
+
+	/* So patching it again straight away shouldn't send anything */
+	same_entry = gdata_service_patch_entry (GDATA_SERVICE (service), gdata_contacts_service_get_primary_authorization_domain (),
+	                                        GDATA_ENTRY (contact), NULL, &error);
+	g_assert_no_error (error);
+	g_assert (same_entry == GDATA_ENTRY (contact));
+	g_object_unref (same_entry);
+	g_assert_cmpuint (requests->len, ==, 1);
+
+	/* Whereas a further change should only send that change, conditional on the new ETag */
+	gdata_contacts_contact_set_nickname (contact, "Jackie");
+
+	new_contact = GDATA_CONTACTS_CONTACT (gdata_service_patch_entry (GDATA_SERVICE (service),
+	                                                                 gdata_contacts_service_get_primary_authorization_domain (),
+	                                                                 GDATA_ENTRY (contact), NULL, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_CONTACTS_CONTACT (new_contact));
+	g_assert_cmpstr (gdata_contacts_contact_get_nickname (new_contact), ==, "Jackie");
+	g_object_unref (new_contact);
+
+	g_assert_cmpuint (requests->len, ==, 2);
+	request = g_ptr_array_index (requests, 1);
+	g_assert_cmpstr (soup_message_headers_get_one (request->request_headers, "If-Match"), ==, "\"Qnw7fjVSLyt7I2A9XRdWFEUDQgA.\"");
+	g_assert (gdata_test_compare_xml_strings (request->request_body->data,
+		"<?xml version='1.0' encoding='UTF-8'?>"
+		"<entry xmlns='http://www.w3.org/2005/Atom' "
+		       "xmlns:gd='http://schemas.google.com/g/2005' "
+		       "xmlns:app='http://www.w3.org/2007/app' "
+		       "xmlns:gContact='http://schemas.google.com/contact/2008' "
+		       "gd:etag='&quot;Qnw7fjVSLyt7I2A9XRdWFEUDQgA.&quot;' "
+		       "gd:fields='gContact:nickname'>"
+			"<gContact:nickname>Jackie</gContact:nickname>"
+		"</entry>", TRUE) == TRUE);
+	g_assert_cmpstr (gdata_entry_get_etag (GDATA_ENTRY (contact)), ==, "\"Qn47ejVSLyt7I2A9XRdWFEUMRAU.\"");
+
+	g_signal_handler_disconnect (mock_server, handler_id);
+	g_ptr_array_unref (requests);
+	g_object_unref (contact);
+
+	uhm_server_end_trace (mock_server);
+}
+
+#define SYNC_CONTACT_ID(ID) "http://www.google.com/m8/feeds/contacts/libgdata.test%40googlemail.com/base/" ID
+
+/* Test that a sync session for the user's contacts does a full sync on its first run, then only fetches the contacts updated since the latest update
+ * time it has seen, classifying them as insertions or updates by their publication times. The trace is hand-written. */
+static void
+test_sync_session (gconstpointer service)
+{
+	GDataSyncSession *session;
+	GString *changes;
+	gchar *cursor;
+	GError *error = NULL;
+
+	gdata_test_mock_server_start_trace (mock_server, "sync-session");
+
+	session = gdata_contacts_service_create_sync_session (GDATA_CONTACTS_SERVICE (service));
+	g_assert (GDATA_IS_SYNC_SESSION (session));
+	g_assert (gdata_sync_session_get_service (session) == service);
+	g_assert (gdata_sync_session_get_authorization_domain (session) == gdata_contacts_service_get_primary_authorization_domain ());
+	g_assert_cmpstr (gdata_sync_session_get_feed_uri (session), ==, "https://www.google.com/m8/feeds/contacts/default/full");
+	g_assert (gdata_sync_session_dup_cursor (session) == NULL);
+
+	/* The first run is a full sync. Deleted contacts aren't reported, but they still advance the cursor (to 23:25). */
+	changes = g_string_new (NULL);
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpstr (changes->str, ==, "reset insertion:" SYNC_CONTACT_ID ("sync1") " insertion:" SYNC_CONTACT_ID ("sync2"));
+
+	cursor = gdata_sync_session_dup_cursor (session);
+	g_assert_cmpstr (cursor, ==, "1415489100:");
+	g_free (cursor);
+
+	/* The second run only fetches changes since 23:25. The contact published before then is an update, and the one published since is an
+	 * insertion. */
+	g_string_truncate (changes, 0);
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpstr (changes->str, ==,
+	                 "update:" SYNC_CONTACT_ID ("sync1") " insertion:" SYNC_CONTACT_ID ("sync4") " deletion:" SYNC_CONTACT_ID ("sync2"));
+
+	cursor = gdata_sync_session_dup_cursor (session);
+	g_assert_cmpstr (cursor, ==, "1415490300:");
+	g_free (cursor);
+
+	/* A failed run leaves the cursor where it was */
+	g_string_truncate (changes, 0);
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == FALSE);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR);
+	g_clear_error (&error);
+	g_assert_cmpstr (changes->str, ==, "");
+
+	cursor = gdata_sync_session_dup_cursor (session);
+	g_assert_cmpstr (cursor, ==, "1415490300:");
+	g_free (cursor);
+
+	/* If the service rejects the cursor with 410 Gone, the run falls back to a full sync */
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpstr (changes->str, ==, "reset insertion:" SYNC_CONTACT_ID ("sync1") " insertion:" SYNC_CONTACT_ID ("sync4"));
+
+	cursor = gdata_sync_session_dup_cursor (session);
+	g_assert_cmpstr (cursor, ==, "1415490000:");
+
+	/* The cursor can be restored into a new session, but malformed cursors are ignored */
+	g_object_unref (session);
+	session = gdata_contacts_service_create_sync_session (GDATA_CONTACTS_SERVICE (service));
+
+	gdata_sync_session_set_cursor (session, "1415490000");
+	g_assert (gdata_sync_session_dup_cursor (session) == NULL);
+	gdata_sync_session_set_cursor (session, "-1415490000:");
+	g_assert (gdata_sync_session_dup_cursor (session) == NULL);
+
+	gdata_sync_session_set_cursor (session, cursor);
+	g_free (cursor);
+	cursor = gdata_sync_session_dup_cursor (session);
+	g_assert_cmpstr (cursor, ==, "1415490000:");
+	g_free (cursor);
+
+	g_string_free (changes, TRUE);
+	g_object_unref (session);
+
+	uhm_server_end_trace (mock_server);
+}
+
+#undef SYNC_CONTACT_ID
+
+/* State shared by the read-ahead tests with the mock server's thread, which handles the read-ahead requests, and with the service's read-ahead
+ * threads, which emit GDataService::request-finished for them. The traces for these tests are hand-written. */
+typedef struct {
+	GDataContactsQuery *query;
+	GPtrArray *requests;
+	gulong record_handler_id;
+	gulong finished_handler_id;
+	gulong hold_handler_id;
+
+	GMutex mutex; /* protects everything below */
+	GCond cond;
+
+	/* Requests reported by GDataService::request-finished */
+	GThread *test_thread;
+	guint n_requests_finished;
+	guint n_requests_finished_in_other_threads;
+	guint last_status;
+
+	/* A request for a page after the first, held by the mock server until it's released */
+	gboolean request_held;
+	gboolean request_released;
+	gboolean query_finished;
+} PrefetchData;
+
+static void
+prefetch_request_finished_cb (GDataService *service, GDataRequestStatistics *statistics, PrefetchData *data)
+{
+	g_mutex_lock (&data->mutex);
+
+	data->n_requests_finished++;
+	if (g_thread_self () != data->test_thread)
+		data->n_requests_finished_in_other_threads++;
+	data->last_status = statistics->status;
+
+	g_cond_broadcast (&data->cond);
+	g_mutex_unlock (&data->mutex);
+}
+
+static gboolean
+prefetch_hold_request_cb (UhmServer *server, SoupMessage *message, SoupClientContext *client, PrefetchData *data)
+{
+	const gchar *query = soup_uri_get_query (soup_message_get_uri (message));
+
+	/* Only pages after the first are read ahead */
+	if (query == NULL || strstr (query, "start-index=") == NULL)
+		return FALSE;
+
+	g_mutex_lock (&data->mutex);
+
+	data->request_held = TRUE;
+	g_cond_broadcast (&data->cond);
+
+	while (data->request_released == FALSE)
+		g_cond_wait (&data->cond, &data->mutex);
+
+	g_mutex_unlock (&data->mutex);
+
+	/* Let the trace provide the response as normal */
+	return FALSE;
+}
+
+static void
+prefetch_hold_requests (PrefetchData *data)
+{
+	data->hold_handler_id = g_signal_connect (mock_server, "handle-message", (GCallback) prefetch_hold_request_cb, data);
+}
+
+static void
+prefetch_wait_for_held_request (PrefetchData *data)
+{
+	g_mutex_lock (&data->mutex);
+	while (data->request_held == FALSE)
+		g_cond_wait (&data->cond, &data->mutex);
+	g_mutex_unlock (&data->mutex);
+}
+
+static void
+prefetch_release_request (PrefetchData *data)
+{
+	g_mutex_lock (&data->mutex);
+	data->request_released = TRUE;
+	g_cond_broadcast (&data->cond);
+	g_mutex_unlock (&data->mutex);
+}
+
+static void
+set_up_prefetch (PrefetchData *data, gconstpointer service)
+{
+	g_mutex_init (&data->mutex);
+	g_cond_init (&data->cond);
+	data->test_thread = g_thread_self ();
+
+	/* Read up to four pages of two contacts ahead */
+	data->query = gdata_contacts_query_new_with_limits (NULL, 0, 2);
+	gdata_query_set_prefetch_depth (GDATA_QUERY (data->query), 4);
+
+	data->requests = g_ptr_array_new_with_free_func (g_object_unref);
+	data->record_handler_id = gdata_test_mock_server_record_requests (mock_server, data->requests);
+	data->finished_handler_id = g_signal_connect (GDATA_SERVICE (service), "request-finished", (GCallback) prefetch_request_finished_cb,
+	                                              data);
+}
+
+static void
+tear_down_prefetch (PrefetchData *data, gconstpointer service)
+{
+	if (data->hold_handler_id != 0)
+		g_signal_handler_disconnect (mock_server, data->hold_handler_id);
+	g_signal_handler_disconnect (GDATA_SERVICE (service), data->finished_handler_id);
+	g_signal_handler_disconnect (mock_server, data->record_handler_id);
+
+	g_ptr_array_unref (data->requests);
+	g_object_unref (data->query);
+
+	g_cond_clear (&data->cond);
+	g_mutex_clear (&data->mutex);
+}
+
+static void
+assert_prefetch_request_uri (PrefetchData *data, guint i, const gchar *expected_query)
+{
+	SoupMessage *request;
+
+	g_assert_cmpuint (i, <, data->requests->len);
+	request = g_ptr_array_index (data->requests, i);
+	g_assert_cmpstr (soup_uri_get_query (soup_message_get_uri (request)), ==, expected_query);
+}
+
+static void
+assert_prefetch_page (GDataFeed *feed, const gchar *first_id, guint n_entries)
+{
+	GList *entries;
+
+	g_assert (GDATA_IS_FEED (feed));
+	entries = gdata_feed_get_entries (feed);
+	g_assert_cmpuint (g_list_length (entries), ==, n_entries);
+	g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (entries->data)), ==, first_id);
+}
+
+#define PREFETCH_CONTACT_ID(ID) "http://www.google.com/m8/feeds/contacts/libgdata.test%40googlemail.com/base/" ID
+
+/* Test that a page read ahead is handed over to the query when it moves on to it, rather than being requested again, and that nothing is read
+ * ahead beyond the total number of results. */
+static void
+test_query_prefetch (PrefetchData *data, gconstpointer service)
+{
+	GDataFeed *feed;
+	GError *error = NULL;
+
+	gdata_test_mock_server_start_trace (mock_server, "query-prefetch");
+
+	/* Querying the first page reads the second ahead. There are only four results, so the second page is the last, and no more are read
+	 * ahead, whatever the prefetch depth. */
+	feed = gdata_contacts_service_query_contacts (GDATA_CONTACTS_SERVICE (service), GDATA_QUERY (data->query), NULL, NULL, NULL, &error);
+	g_assert_no_error (error);
+	assert_prefetch_page (feed, PREFETCH_CONTACT_ID ("prefetch1"), 2);
+	g_object_unref (feed);
+
+	gdata_query_next_page (GDATA_QUERY (data->query));
+	feed = gdata_contacts_service_query_contacts (GDATA_CONTACTS_SERVICE (service), GDATA_QUERY (data->query), NULL, NULL, NULL, &error);
+	g_assert_no_error (error);
+	assert_prefetch_page (feed, PREFETCH_CONTACT_ID ("prefetch3"), 2);
+	g_object_unref (feed);
+
+	/* Each page should have been requested once, with the read-ahead request reported as finished in the thread which made it */
+	g_assert_cmpuint (data->requests->len, ==, 2);
+	assert_prefetch_request_uri (data, 0, "max-results=2&showdeleted=false");
+	assert_prefetch_request_uri (data, 1, "start-index=3&max-results=2&showdeleted=false");
+
+	g_mutex_lock (&data->mutex);
+	g_assert_cmpuint (data->n_requests_finished, ==, 2);
+	g_assert_cmpuint (data->n_requests_finished_in_other_threads, ==, 1);
+	g_mutex_unlock (&data->mutex);
+
+	uhm_server_end_trace (mock_server);
+}
+
+static void
+test_query_prefetch_wait_cb (GDataService *service, GAsyncResult *async_result, PrefetchData *data)
+{
+	GDataFeed *feed;
+	GError *error = NULL;
+
+	feed = gdata_service_query_finish (service, async_result, &error);
+	g_assert_no_error (error);
+	assert_prefetch_page (feed, PREFETCH_CONTACT_ID ("prefetch3"), 2);
+	g_object_unref (feed);
+
+	data->query_finished = TRUE;
+}
+
+static gboolean
+test_query_prefetch_wait_release_cb (PrefetchData *data)
+{
+	/* The query can't have finished yet, as the server is still holding on to the page it needs */
+	g_assert (data->query_finished == FALSE);
+	prefetch_release_request (data);
+
+	return G_SOURCE_REMOVE;
+}
+
+/* Test that a query waits for a page which is still being read ahead, rather than requesting it again. */
+static void
+test_query_prefetch_wait (PrefetchData *data, gconstpointer service)
+{
+	GDataFeed *feed;
+	GError *error = NULL;
+
+	gdata_test_mock_server_start_trace (mock_server, "query-prefetch-wait");
+	prefetch_hold_requests (data);
+
+	/* Query the first page, and wait for the server to receive the read-ahead request for the second */
+	feed = gdata_contacts_service_query_contacts (GDATA_CONTACTS_SERVICE (service), GDATA_QUERY (data->query), NULL, NULL, NULL, &error);
+	g_assert_no_error (error);
+	assert_prefetch_page (feed, PREFETCH_CONTACT_ID ("prefetch1"), 2);
+	g_object_unref (feed);
+
+	prefetch_wait_for_held_request (data);
+
+	/* Query the second page while it's still being read ahead, and release the read-ahead request a little later */
+	gdata_query_next_page (GDATA_QUERY (data->query));
+	gdata_contacts_service_query_contacts_async (GDATA_CONTACTS_SERVICE (service), GDATA_QUERY (data->query), NULL, NULL, NULL, NULL,
+	                                             (GAsyncReadyCallback) test_query_prefetch_wait_cb, data);
+	g_timeout_add (100, (GSourceFunc) test_query_prefetch_wait_release_cb, data);
+
+	while (data->query_finished == FALSE)
+		g_main_context_iteration (NULL, TRUE);
+
+	g_assert_cmpuint (data->requests->len, ==, 2);
+	assert_prefetch_request_uri (data, 1, "start-index=3&max-results=2&showdeleted=false");
+
+	uhm_server_end_trace (mock_server);
+}
+
+/* Test that changing a property which affects the query URI cancels the pages being read ahead. */
+static void
+test_query_prefetch_cancellation (PrefetchData *data, gconstpointer service)
+{
+	GDataFeed *feed;
+	GError *error = NULL;
+
+	gdata_test_mock_server_start_trace (mock_server, "query-prefetch-cancellation");
+	prefetch_hold_requests (data);
+
+	feed = gdata_contacts_service_query_contacts (GDATA_CONTACTS_SERVICE (service), GDATA_QUERY (data->query), NULL, NULL, NULL, &error);
+	g_assert_no_error (error);
+	assert_prefetch_page (feed, PREFETCH_CONTACT_ID ("prefetch1"), 2);
+	g_object_unref (feed);
+
+	prefetch_wait_for_held_request (data);
+
+	/* Changing the page size changes the URIs of all the pages, so the read-ahead request should be cancelled while the server's still
+	 * holding on to it */
+	gdata_query_set_max_results (GDATA_QUERY (data->query), 3);
+
+	g_mutex_lock (&data->mutex);
+
+	while (data->n_requests_finished < 2)
+		g_cond_wait (&data->cond, &data->mutex);
+
+	g_assert_cmpuint (data->n_requests_finished_in_other_threads, ==, 1);
+	g_assert_cmpuint (data->last_status, ==, SOUP_STATUS_CANCELLED);
+
+	g_mutex_unlock (&data->mutex);
+
+	prefetch_release_request (data);
+
+	/* So the query should request its new first page itself. That page is short, so it's the last one, and nothing more is read ahead. */
+	feed = gdata_contacts_service_query_contacts (GDATA_CONTACTS_SERVICE (service), GDATA_QUERY (data->query), NULL, NULL, NULL, &error);
+	g_assert_no_error (error);
+	assert_prefetch_page (feed, PREFETCH_CONTACT_ID ("prefetch5"), 1);
+	g_object_unref (feed);
+
+	g_assert_cmpuint (data->requests->len, ==, 3);
+	assert_prefetch_request_uri (data, 2, "max-results=3&showdeleted=false");
+
+	uhm_server_end_trace (mock_server);
+}
+
+/* Test that if reading a page ahead fails, the query requests the page again itself, rather than failing. */
+static void
+test_query_prefetch_failure (PrefetchData *data, gconstpointer service)
+{
+	GDataFeed *feed;
+	GError *error = NULL;
+
+	gdata_test_mock_server_start_trace (mock_server, "query-prefetch-failure");
+
+	feed = gdata_contacts_service_query_contacts (GDATA_CONTACTS_SERVICE (service), GDATA_QUERY (data->query), NULL, NULL, NULL, &error);
+	g_assert_no_error (error);
+	assert_prefetch_page (feed, PREFETCH_CONTACT_ID ("prefetch1"), 2);
+	g_object_unref (feed);
+
+	gdata_query_next_page (GDATA_QUERY (data->query));
+	feed = gdata_contacts_service_query_contacts (GDATA_CONTACTS_SERVICE (service), GDATA_QUERY (data->query), NULL, NULL, NULL, &error);
+	g_assert_no_error (error);
+	assert_prefetch_page (feed, PREFETCH_CONTACT_ID ("prefetch3"), 2);
+	g_object_unref (feed);
+
+	/* The second page should have been requested twice: the failed read-ahead, then by the query */
+	g_assert_cmpuint (data->requests->len, ==, 3);
+	assert_prefetch_request_uri (data, 1, "start-index=3&max-results=2&showdeleted=false");
+	assert_prefetch_request_uri (data, 2, "start-index=3&max-results=2&showdeleted=false");
+
+	g_mutex_lock (&data->mutex);
+	g_assert_cmpuint (data->n_requests_finished, ==, 3);
+	g_assert_cmpuint (data->n_requests_finished_in_other_threads, ==, 1);
+	g_mutex_unlock (&data->mutex);
+
+	uhm_server_end_trace (mock_server);
+}
+
+#undef PREFETCH_CONTACT_ID
+
+/* Check that two lists of parsables have the same elements, in the same order */
+static void
+assert_parsable_lists_equal (GList *list1, GList *list2)
+{
+	g_assert_cmpuint (g_list_length (list1), ==, g_list_length (list2));
+
+	for (; list1 != NULL; list1 = list1->next, list2 = list2->next) {
+		gchar *xml1, *xml2;
+
+		xml1 = gdata_parsable_get_xml (GDATA_PARSABLE (list1->data));
+		xml2 = gdata_parsable_get_xml (GDATA_PARSABLE (list2->data));
+		g_assert_cmpstr (xml1, ==, xml2);
+		g_free (xml2);
+		g_free (xml1);
+	}
+}
+
+static void
+assert_parsables_equal (gpointer parsable1, gpointer parsable2)
+{
+	gchar *xml1, *xml2;
+
+	if (parsable1 == NULL || parsable2 == NULL) {
+		g_assert (parsable1 == parsable2);
+		return;
+	}
+
+	xml1 = gdata_parsable_get_xml (GDATA_PARSABLE (parsable1));
+	xml2 = gdata_parsable_get_xml (GDATA_PARSABLE (parsable2));
+	g_assert_cmpstr (xml1, ==, xml2);
+	g_free (xml2);
+	g_free (xml1);
+}
+
+/* Test that contacts parsed in lite mode are indistinguishable from ones parsed normally, however their deferred elements are first
+ * accessed, and that invalid deferred elements are only reported when they're accessed. */
+static void
+test_query_lite (gconstpointer service)
+{
+	GDataContactsQuery *query, *lite_query;
+	GDataFeed *feed, *lite_feed;
+	GList *entries, *lite_entries;
+	GDataContactsContact *contact;
+	guint i;
+	GError *error = NULL;
+
+	gdata_test_mock_server_start_trace (mock_server, "query-lite");
+
+	/* The service sets the ETag of the query, so use separate queries */
+	query = gdata_contacts_query_new (NULL);
+	feed = gdata_contacts_service_query_contacts (GDATA_CONTACTS_SERVICE (service), GDATA_QUERY (query), NULL, NULL, NULL, &error);
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_FEED (feed));
+
+	lite_query = gdata_contacts_query_new (NULL);
+	gdata_query_set_is_lite (GDATA_QUERY (lite_query), TRUE);
+	lite_feed = gdata_contacts_service_query_contacts (GDATA_CONTACTS_SERVICE (service), GDATA_QUERY (lite_query), NULL, NULL, NULL,
+	                                                   &error);
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_FEED (lite_feed));
+
+	entries = gdata_feed_get_entries (feed);
+	lite_entries = gdata_feed_get_entries (lite_feed);
+	g_assert_cmpuint (g_list_length (entries), ==, 3);
+	g_assert_cmpuint (g_list_length (lite_entries), ==, 3);
+
+	for (i = 0; entries != NULL; entries = entries->next, lite_entries = lite_entries->next, i++) {
+		GDataContactsContact *lite_contact;
+		GBytes *bytes, *lite_bytes;
+		gchar *xml, *lite_xml;
+
+		contact = GDATA_CONTACTS_CONTACT (entries->data);
+		lite_contact = GDATA_CONTACTS_CONTACT (lite_entries->data);
+		g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (contact)), ==, gdata_entry_get_id (GDATA_ENTRY (lite_contact)));
+
+		/* Materialise each lite contact through a different accessor first */
+		switch (i) {
+			case 0:
+				g_assert_cmpuint (g_list_length (gdata_contacts_contact_get_email_addresses (lite_contact)), ==, 2);
+				break;
+			case 1:
+				/* The second contact's elements use a g prefix which the feed binds to another namespace */
+				g_assert (gdata_contacts_contact_get_primary_phone_number (lite_contact) != NULL);
+				break;
+			case 2:
+				lite_bytes = gdata_parsable_get_binary (GDATA_PARSABLE (lite_contact), &error);
+				g_assert_no_error (error);
+				g_bytes_unref (lite_bytes);
+				break;
+			default:
+				g_assert_not_reached ();
+		}
+
+		assert_parsable_lists_equal (gdata_contacts_contact_get_email_addresses (contact),
+		                             gdata_contacts_contact_get_email_addresses (lite_contact));
+		assert_parsable_lists_equal (gdata_contacts_contact_get_phone_numbers (contact),
+		                             gdata_contacts_contact_get_phone_numbers (lite_contact));
+		g_assert (gdata_contacts_contact_get_email_addresses (lite_contact) != NULL);
+		g_assert (gdata_contacts_contact_get_phone_numbers (lite_contact) != NULL);
+
+		assert_parsables_equal (gdata_contacts_contact_get_primary_email_address (contact),
+		                        gdata_contacts_contact_get_primary_email_address (lite_contact));
+		assert_parsables_equal (gdata_contacts_contact_get_primary_im_address (contact),
+		                        gdata_contacts_contact_get_primary_im_address (lite_contact));
+		assert_parsables_equal (gdata_contacts_contact_get_primary_phone_number (contact),
+		                        gdata_contacts_contact_get_primary_phone_number (lite_contact));
+		assert_parsables_equal (gdata_contacts_contact_get_primary_postal_address (contact),
+		                        gdata_contacts_contact_get_primary_postal_address (lite_contact));
+		assert_parsables_equal (gdata_contacts_contact_get_primary_organization (contact),
+		                        gdata_contacts_contact_get_primary_organization (lite_contact));
+		assert_parsables_equal (gdata_contacts_contact_get_primary_website (contact),
+		                        gdata_contacts_contact_get_primary_website (lite_contact));
+		assert_parsables_equal (gdata_contacts_contact_get_primary_calendar (contact),
+		                        gdata_contacts_contact_get_primary_calendar (lite_contact));
+
+		xml = gdata_parsable_get_xml (GDATA_PARSABLE (contact));
+		lite_xml = gdata_parsable_get_xml (GDATA_PARSABLE (lite_contact));
+		g_assert_cmpstr (xml, ==, lite_xml);
+		g_free (lite_xml);
+		g_free (xml);
+
+		bytes = gdata_parsable_get_binary (GDATA_PARSABLE (contact), &error);
+		g_assert_no_error (error);
+		lite_bytes = gdata_parsable_get_binary (GDATA_PARSABLE (lite_contact), &error);
+		g_assert_no_error (error);
+		g_assert (g_bytes_equal (bytes, lite_bytes));
+		g_bytes_unref (lite_bytes);
+		g_bytes_unref (bytes);
+	}
+
+	/* Check the rich first contact was fully materialised */
+	contact = GDATA_CONTACTS_CONTACT (gdata_feed_get_entries (lite_feed)->data);
+	g_assert (gdata_contacts_contact_get_primary_email_address (contact) != NULL);
+	g_assert (gdata_contacts_contact_get_primary_im_address (contact) != NULL);
+	g_assert (gdata_contacts_contact_get_primary_postal_address (contact) != NULL);
+	g_assert (gdata_contacts_contact_get_primary_organization (contact) != NULL);
+	g_assert (gdata_contacts_contact_get_primary_website (contact) != NULL);
+	g_assert (gdata_contacts_contact_get_primary_calendar (contact) != NULL);
+
+	g_object_unref (lite_feed);
+	g_object_unref (feed);
+	g_object_unref (query);
+
+	/* The contacts in this feed have invalid e-mail addresses, which are only parsed when the first contact is accessed. The second contact
+	 * is never accessed, so its deferred elements must be discarded without being parsed (and warned about) when it's disposed. */
+	lite_feed = gdata_contacts_service_query_contacts (GDATA_CONTACTS_SERVICE (service), GDATA_QUERY (lite_query), NULL, NULL, NULL,
+	                                                   &error);
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_FEED (lite_feed));
+	g_assert_cmpuint (g_list_length (gdata_feed_get_entries (lite_feed)), ==, 2);
+
+	contact = GDATA_CONTACTS_CONTACT (gdata_feed_get_entries (lite_feed)->data);
+	g_test_expect_message ("libgdata", G_LOG_LEVEL_WARNING, "Error parsing deferred XML for GDataContactsContact*");
+	g_assert (gdata_contacts_contact_get_email_addresses (contact) == NULL);
+	g_test_assert_expected_messages ();
+
+	g_object_unref (lite_feed);
+	g_object_unref (lite_query);
+
+	uhm_server_end_trace (mock_server);
+}
+
 typedef struct {
 	GDataContactsGroup *group1;
 	GDataContactsGroup *group2;
@@ -1249,6 +1935,19 @@ test_query_uri (void)
 	                                "&group=http%3A%2F%2Fwww.google.com%2Ffeeds%2Fcontacts%2Fgroups%2Fjo%40gmail.com%2Fbase%2F1234a");
 	g_free (query_uri);
 
+	/* …with a partial-response field mask */
+	gdata_contacts_query_set_field_mask (query, GDATA_QUERY_FIELDS_ID | GDATA_QUERY_FIELDS_ETAG | GDATA_QUERY_FIELDS_DELETED);
+	g_assert_cmpstr (gdata_query_get_fields (GDATA_QUERY (query)), ==, "openSearch:totalResults,entry(@gd:etag,id,gd:deleted)");
+
+	query_uri = gdata_query_get_query_uri (GDATA_QUERY (query), "http://example.com");
+	g_assert_cmpstr (query_uri, ==, "http://example.com?q=q&fields=openSearch:totalResults,entry(@gd:etag,id,gd:deleted)"
+	                                "&orderby=lastmodified&showdeleted=true&sortorder=descending"
+	                                "&group=http%3A%2F%2Fwww.google.com%2Ffeeds%2Fcontacts%2Fgroups%2Fjo%40gmail.com%2Fbase%2F1234a");
+	g_free (query_uri);
+
+	gdata_contacts_query_set_field_mask (query, 0);
+	g_assert (gdata_query_get_fields (GDATA_QUERY (query)) == NULL);
+
 	g_object_unref (query);
 }
 
@@ -1279,7 +1978,7 @@ static void
 test_query_properties (void)
 {
 	gchar *order_by, *sort_order, *group;
-	gboolean show_deleted;
+	gboolean show_deleted, is_lite;
 	guint start_index, max_results;
 	GDataContactsQuery *query = gdata_contacts_query_new_with_limits ("q", 1, 10);
 
@@ -1289,6 +1988,7 @@ test_query_properties (void)
 	              "show-deleted", TRUE,
 	              "sort-order", "descending",
 	              "group", "http://www.google.com/feeds/contacts/groups/jo@gmail.com/base/1234a",
+	              "is-lite", TRUE,
 	              NULL);
 
 	/* Check the query's properties */
@@ -1299,6 +1999,7 @@ test_query_properties (void)
 	              "group", &group,
 	              "start-index", &start_index,
 	              "max-results", &max_results,
+	              "is-lite", &is_lite,
 	              NULL);
 
 	g_assert_cmpstr (order_by, ==, "lastmodified");
@@ -1307,6 +2008,8 @@ test_query_properties (void)
 	g_assert_cmpstr (group, ==, "http://www.google.com/feeds/contacts/groups/jo@gmail.com/base/1234a");
 	g_assert_cmpuint (start_index, ==, 1);
 	g_assert_cmpuint (max_results, ==, 10);
+	g_assert (is_lite == TRUE);
+	g_assert (gdata_query_is_lite (GDATA_QUERY (query)) == TRUE);
 
 	g_free (order_by);
 	g_free (sort_order);
@@ -1746,6 +2449,93 @@ test_contact_parser_error_handling (void)
 #undef TEST_XML_ERROR_HANDLING
 }
 
+static void
+test_contact_binary (void)
+{
+	GDataContactsContact *contact, *contact2;
+	GDataParsable *parsable;
+	GBytes *bytes, *truncated;
+	gchar *xml;
+	GDate date;
+	GError *error = NULL;
+
+	contact = GDATA_CONTACTS_CONTACT (gdata_parsable_new_from_xml (GDATA_TYPE_CONTACTS_CONTACT,
+		"<entry xmlns='http://www.w3.org/2005/Atom' "
+			"xmlns:gd='http://schemas.google.com/g/2005' "
+			"xmlns:gContact='http://schemas.google.com/contact/2008' "
+			"gd:etag='&quot;QngzcDVSLyp7ImA9WxJTFkoITgU.&quot;'>"
+			"<id>http://www.google.com/m8/feeds/contacts/libgdata.test@googlemail.com/base/1b46cdd20bfbee3b</id>"
+			"<updated>2009-04-25T15:21:53.688Z</updated>"
+			"<app:edited xmlns:app='http://www.w3.org/2007/app'>2009-04-25T15:21:53.688Z</app:edited>"
+			"<category scheme='http://schemas.google.com/g/2005#kind' term='http://schemas.google.com/contact/2008#contact'/>"
+			"<title>Agent Smith</title>"
+			"<link rel='http://www.iana.org/assignments/relation/self' type='application/atom+xml' "
+			      "href='http://www.google.com/m8/feeds/contacts/libgdata.test@googlemail.com/full/1b46cdd20bfbee3b'/>"
+			"<gd:name><gd:givenName>Agent</gd:givenName><gd:familyName>Smith</gd:familyName></gd:name>"
+			"<gd:email rel='http://schemas.google.com/g/2005#other' address='bob@example.com' primary='true'/>"
+			"<gd:extendedProperty name='test' value='test value'/>"
+			"<gContact:groupMembershipInfo href='http://www.google.com/feeds/contacts/groups/jo%40gmail.com/base/1234a' "
+			                              "deleted='true'/>"
+			"<gContact:nickname>Agent Smith</gContact:nickname>"
+			"<gContact:birthday when='--12-03'/>"
+			"<gContact:jot rel='user'>Owes me ten pounds.</gContact:jot>"
+			"<gContact:userDefinedField key='Favourite colour' value='Blue'/>"
+			"<gContact:hobby>Programming</gContact:hobby>"
+			"<foobar:unknown xmlns:foobar='http://example.com/'>Unhandled</foobar:unknown>"
+		"</entry>", -1, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_CONTACTS_CONTACT (contact));
+
+	bytes = gdata_parsable_get_binary (GDATA_PARSABLE (contact), &error);
+	g_assert_no_error (error);
+	g_assert (bytes != NULL);
+
+	/* Read it back and check that it serialises to the same XML as the original */
+	contact2 = GDATA_CONTACTS_CONTACT (gdata_parsable_new_from_binary (GDATA_TYPE_CONTACTS_CONTACT, bytes, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_CONTACTS_CONTACT (contact2));
+
+	xml = gdata_parsable_get_xml (GDATA_PARSABLE (contact));
+	gdata_test_assert_xml (contact2, xml);
+	g_free (xml);
+
+	g_assert_cmpstr (gdata_entry_get_etag (GDATA_ENTRY (contact2)), ==, gdata_entry_get_etag (GDATA_ENTRY (contact)));
+	g_assert_cmpint (gdata_entry_get_updated (GDATA_ENTRY (contact2)), ==, gdata_entry_get_updated (GDATA_ENTRY (contact)));
+	g_assert_cmpint (gdata_contacts_contact_get_edited (contact2), ==, gdata_contacts_contact_get_edited (contact));
+	g_assert (gdata_contacts_contact_get_birthday (contact2, &date) == FALSE);
+	g_assert_cmpuint (g_date_get_month (&date), ==, 12);
+	g_assert_cmpuint (g_date_get_day (&date), ==, 3);
+	g_assert (gdata_contacts_contact_is_group_deleted (contact2,
+	                                                   "http://www.google.com/feeds/contacts/groups/jo%40gmail.com/base/1234a") == TRUE);
+
+	g_object_unref (contact2);
+
+	/* Reading it back as an unrelated type should fail */
+	parsable = gdata_parsable_new_from_binary (GDATA_TYPE_CONTACTS_GROUP, bytes, &error);
+	g_assert_error (error, GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_PARSING_STRING);
+	g_assert (parsable == NULL);
+	g_clear_error (&error);
+
+	/* As should reading truncated data */
+	truncated = g_bytes_new_from_bytes (bytes, 0, g_bytes_get_size (bytes) / 2);
+	parsable = gdata_parsable_new_from_binary (GDATA_TYPE_CONTACTS_CONTACT, truncated, &error);
+	g_assert_error (error, GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_PARSING_STRING);
+	g_assert (parsable == NULL);
+	g_clear_error (&error);
+	g_bytes_unref (truncated);
+
+	/* And empty data */
+	truncated = g_bytes_new_static ("", 0);
+	parsable = gdata_parsable_new_from_binary (GDATA_TYPE_CONTACTS_CONTACT, truncated, &error);
+	g_assert_error (error, GDATA_PARSER_ERROR, GDATA_PARSER_ERROR_EMPTY_DOCUMENT);
+	g_assert (parsable == NULL);
+	g_clear_error (&error);
+	g_bytes_unref (truncated);
+
+	g_bytes_unref (bytes);
+	g_object_unref (contact);
+}
+
 static void
 test_group_properties (void)
 {
@@ -2623,6 +3413,15 @@ main (int argc, char *argv[])
 
 	g_test_add ("/contacts/contact/insert", InsertData, service, set_up_insert, test_contact_insert, tear_down_insert);
 	g_test_add ("/contacts/contact/update", TempContactData, service, set_up_temp_contact, test_contact_update, tear_down_temp_contact);
+	g_test_add_data_func ("/contacts/contact/patch", service, test_contact_patch);
+	g_test_add_data_func ("/contacts/sync-session", service, test_sync_session);
+	g_test_add ("/contacts/query/prefetch", PrefetchData, service, set_up_prefetch, test_query_prefetch, tear_down_prefetch);
+	g_test_add ("/contacts/query/prefetch/wait", PrefetchData, service, set_up_prefetch, test_query_prefetch_wait, tear_down_prefetch);
+	g_test_add ("/contacts/query/prefetch/cancellation", PrefetchData, service, set_up_prefetch, test_query_prefetch_cancellation,
+	            tear_down_prefetch);
+	g_test_add ("/contacts/query/prefetch/failure", PrefetchData, service, set_up_prefetch, test_query_prefetch_failure,
+	            tear_down_prefetch);
+	g_test_add_data_func ("/contacts/query/lite", service, test_query_lite);
 
 	g_test_add ("/contacts/query/all_contacts", QueryAllContactsData, service, set_up_query_all_contacts, test_query_all_contacts,
 	            tear_down_query_all_contacts);
@@ -2681,6 +3480,7 @@ main (int argc, char *argv[])
 	g_test_add_func ("/contacts/contact/parser/normal", test_contact_parser_normal);
 	g_test_add_func ("/contacts/contact/parser/error_handling", test_contact_parser_error_handling);
 	g_test_add_func ("/contacts/contact/id", test_contact_id);
+	g_test_add_func ("/contacts/contact/binary", test_contact_binary);
 
 	g_test_add_func ("/contacts/query/uri", test_query_uri);
 	g_test_add_func ("/contacts/query/etag", test_query_etag);
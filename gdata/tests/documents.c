@@ -1657,6 +1657,260 @@ test_folder_parser_normal (void)
 	g_object_unref (folder);
 }
 
+static GDataDocumentsEntry *
+build_folder_index_entry (GType entry_type, const gchar *id, const gchar *title, const gchar *parent_id)
+{
+	GDataDocumentsEntry *entry;
+	GDataLink *_link;
+	gchar *uri;
+
+	entry = GDATA_DOCUMENTS_ENTRY (g_object_new (entry_type, "id", id, "title", title, NULL));
+
+	uri = g_strconcat ("https://www.googleapis.com/drive/v2/files/", parent_id, NULL);
+	_link = gdata_link_new (uri, GDATA_LINK_PARENT);
+	gdata_entry_add_link (GDATA_ENTRY (entry), _link);
+	g_object_unref (_link);
+	g_free (uri);
+
+	return entry;
+}
+
+static void
+test_folder_index (void)
+{
+	GDataDocumentsFolderIndex *index;
+	GDataDocumentsEntry *folder_a, *folder_b, *doc_c, *doc_d;
+	GList *ids;
+	gchar *id;
+	GError *error = NULL;
+
+	/* Build the hierarchy /Projects/2017/Report and /Notes */
+	folder_a = build_folder_index_entry (GDATA_TYPE_DOCUMENTS_FOLDER, "folder-a", "Projects", "root-id");
+	folder_b = build_folder_index_entry (GDATA_TYPE_DOCUMENTS_FOLDER, "folder-b", "2017", "folder-a");
+	doc_c = build_folder_index_entry (GDATA_TYPE_DOCUMENTS_TEXT, "doc-c", "Report", "folder-b");
+	doc_d = build_folder_index_entry (GDATA_TYPE_DOCUMENTS_TEXT, "doc-d", "Notes", "root-id");
+
+	index = gdata_documents_folder_index_new (NULL);
+	g_assert (GDATA_IS_DOCUMENTS_FOLDER_INDEX (index));
+	g_assert (gdata_documents_folder_index_get_service (index) == NULL);
+
+	/* Add children before their parents, as the changes feed may */
+	gdata_documents_folder_index_update_entry (index, doc_c);
+	gdata_documents_folder_index_update_entry (index, folder_b);
+	gdata_documents_folder_index_update_entry (index, folder_a);
+	gdata_documents_folder_index_update_entry (index, doc_d);
+	g_assert_cmpuint (gdata_documents_folder_index_get_n_entries (index), ==, 4);
+
+	/* Path lookups */
+	id = gdata_documents_folder_index_lookup_path (index, "/Projects/2017/Report");
+	g_assert_cmpstr (id, ==, "doc-c");
+	g_free (id);
+
+	id = gdata_documents_folder_index_lookup_path (index, "//Projects//2017/");
+	g_assert_cmpstr (id, ==, "folder-b");
+	g_free (id);
+
+	g_assert (gdata_documents_folder_index_lookup_path (index, "/Projects/Report") == NULL);
+	g_assert (gdata_documents_folder_index_lookup_path (index, "/") == NULL);
+
+	/* Listings */
+	ids = gdata_documents_folder_index_get_children (index, NULL);
+	g_assert_cmpuint (g_list_length (ids), ==, 2);
+	g_assert (g_list_find_custom (ids, "folder-a", (GCompareFunc) g_strcmp0) != NULL);
+	g_assert (g_list_find_custom (ids, "doc-d", (GCompareFunc) g_strcmp0) != NULL);
+	g_list_free_full (ids, g_free);
+
+	ids = gdata_documents_folder_index_get_children (index, "doc-d");
+	g_assert (ids == NULL);
+
+	ids = gdata_documents_folder_index_get_descendants (index, "folder-a");
+	g_assert_cmpuint (g_list_length (ids), ==, 2);
+	g_assert_cmpstr (ids->data, ==, "folder-b");
+	g_assert_cmpstr (ids->next->data, ==, "doc-c");
+	g_list_free_full (ids, g_free);
+
+	/* Check moves locally */
+	g_assert (gdata_documents_folder_index_check_add_to_folder (index, doc_d, GDATA_DOCUMENTS_FOLDER (folder_a), &error) == TRUE);
+	g_assert_no_error (error);
+
+	g_assert (gdata_documents_folder_index_check_add_to_folder (index, doc_c, GDATA_DOCUMENTS_FOLDER (folder_b), &error) == FALSE);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_CONFLICT);
+	g_clear_error (&error);
+
+	g_assert (gdata_documents_folder_index_check_add_to_folder (index, folder_b, GDATA_DOCUMENTS_FOLDER (folder_a), &error) == FALSE);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_FORBIDDEN);
+	g_clear_error (&error);
+
+	g_assert (gdata_documents_folder_index_check_remove_from_folder (index, doc_c, GDATA_DOCUMENTS_FOLDER (folder_b), &error) == TRUE);
+	g_assert_no_error (error);
+
+	g_assert (gdata_documents_folder_index_check_remove_from_folder (index, doc_c, GDATA_DOCUMENTS_FOLDER (folder_a), &error) == FALSE);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_NOT_FOUND);
+	g_clear_error (&error);
+
+	/* Move the report up a level */
+	g_object_unref (doc_c);
+	doc_c = build_folder_index_entry (GDATA_TYPE_DOCUMENTS_TEXT, "doc-c", "Report", "folder-a");
+	gdata_documents_folder_index_update_entry (index, doc_c);
+	g_assert_cmpuint (gdata_documents_folder_index_get_n_entries (index), ==, 4);
+
+	g_assert (gdata_documents_folder_index_lookup_path (index, "/Projects/2017/Report") == NULL);
+	id = gdata_documents_folder_index_lookup_path (index, "/Projects/Report");
+	g_assert_cmpstr (id, ==, "doc-c");
+	g_free (id);
+
+	/* Removing a folder moves its children to the top level */
+	gdata_documents_folder_index_remove_entry (index, "folder-a");
+	g_assert_cmpuint (gdata_documents_folder_index_get_n_entries (index), ==, 3);
+	g_assert (gdata_documents_folder_index_get_entry (index, "folder-a") == NULL);
+
+	id = gdata_documents_folder_index_lookup_path (index, "/2017");
+	g_assert_cmpstr (id, ==, "folder-b");
+	g_free (id);
+
+	g_object_unref (index);
+	g_object_unref (doc_d);
+	g_object_unref (doc_c);
+	g_object_unref (folder_b);
+	g_object_unref (folder_a);
+}
+
+static void
+assert_sync_cursor (GDataSyncSession *session, gint64 run_time, const gchar *change_id)
+{
+	gchar *cursor, *end;
+	gint64 sync_time;
+
+	cursor = gdata_sync_session_dup_cursor (session);
+	g_assert (cursor != NULL);
+
+	sync_time = g_ascii_strtoll (cursor, &end, 10);
+	g_assert_cmpint (sync_time, >=, run_time);
+	g_assert_cmpint (sync_time, <=, run_time + TIME_FUZZINESS);
+	g_assert_cmpstr (end, ==, change_id);
+
+	g_free (cursor);
+}
+
+/* Test that a sync session for the user's documents does a full sync of the changes feed on its first run, then only fetches the changes after
+ * the largest change ID seen by the previous run. Trashed and permanently deleted files are reported as deletions. The trace is hand-written. */
+static void
+test_sync_session (gconstpointer service)
+{
+	GDataSyncSession *session;
+	GString *changes;
+	gchar *cursor, *new_cursor;
+	gint64 run_time;
+	GError *error = NULL;
+
+	gdata_test_mock_server_start_trace (mock_server, "sync-session");
+
+	session = gdata_documents_service_create_sync_session (GDATA_DOCUMENTS_SERVICE (service));
+	g_assert (GDATA_IS_SYNC_SESSION (session));
+	g_assert (gdata_sync_session_get_service (session) == service);
+	g_assert (gdata_sync_session_get_authorization_domain (session) == gdata_documents_service_get_primary_authorization_domain ());
+	g_assert_cmpstr (gdata_sync_session_get_feed_uri (session), ==, "https://www.googleapis.com/drive/v2/changes");
+	g_assert (gdata_sync_session_dup_cursor (session) == NULL);
+
+	/* The first run is a full sync across two pages, and deleted and trashed files aren't reported */
+	changes = g_string_new (NULL);
+	run_time = g_get_real_time () / G_USEC_PER_SEC;
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpstr (changes->str, ==, "reset insertion:sync1file insertion:sync2file");
+	assert_sync_cursor (session, run_time, ":5121");
+
+	/* Restore a cursor from 10:05, after the first file was created. Files created before then are updates, and those created since are
+	 * insertions. */
+	gdata_sync_session_set_cursor (session, "1433153100:5121");
+	cursor = gdata_sync_session_dup_cursor (session);
+	g_assert_cmpstr (cursor, ==, "1433153100:5121");
+	g_free (cursor);
+
+	g_string_truncate (changes, 0);
+	run_time = g_get_real_time () / G_USEC_PER_SEC;
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpstr (changes->str, ==, "update:sync1file insertion:sync4file deletion:sync2file deletion:sync6file");
+	assert_sync_cursor (session, run_time, ":5131");
+
+	/* A failed run leaves the cursor where it was */
+	cursor = gdata_sync_session_dup_cursor (session);
+
+	g_string_truncate (changes, 0);
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == FALSE);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR);
+	g_clear_error (&error);
+	g_assert_cmpstr (changes->str, ==, "");
+
+	new_cursor = gdata_sync_session_dup_cursor (session);
+	g_assert_cmpstr (new_cursor, ==, cursor);
+	g_free (new_cursor);
+	g_free (cursor);
+
+	/* If the service rejects the change ID with 410 Gone, the run falls back to a full sync */
+	run_time = g_get_real_time () / G_USEC_PER_SEC;
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpstr (changes->str, ==, "reset insertion:sync1file insertion:sync4file");
+	assert_sync_cursor (session, run_time, ":5141");
+
+	/* Malformed cursors, and cursors without a change ID, are ignored */
+	gdata_sync_session_set_cursor (session, "5141");
+	g_assert (gdata_sync_session_dup_cursor (session) == NULL);
+	gdata_sync_session_set_cursor (session, "1433153100:");
+	g_assert (gdata_sync_session_dup_cursor (session) == NULL);
+
+	g_string_free (changes, TRUE);
+	g_object_unref (session);
+
+	uhm_server_end_trace (mock_server);
+}
+
+static void
+test_query_field_mask (void)
+{
+	gchar *query_uri;
+	GDataDocumentsQuery *query = gdata_documents_query_new (NULL);
+
+	/* Only filter out trashed files, to keep the q parameter short */
+	gdata_documents_query_set_show_folders (query, TRUE);
+
+	query_uri = gdata_query_get_query_uri (GDATA_QUERY (query), "http://example.com");
+	g_assert_cmpstr (query_uri, ==, "http://example.com?q=trashed%3Dfalse");
+	g_free (query_uri);
+
+	/* All the fields; the kind and MIME type of each file and the page token are always requested */
+	gdata_documents_query_set_field_mask (query, GDATA_QUERY_FIELDS_ID | GDATA_QUERY_FIELDS_ETAG | GDATA_QUERY_FIELDS_UPDATED |
+	                                             GDATA_QUERY_FIELDS_TITLE | GDATA_QUERY_FIELDS_DELETED);
+	g_assert_cmpstr (gdata_query_get_fields (GDATA_QUERY (query)), ==,
+	                 "kind,nextPageToken,items(kind,mimeType,id,etag,modifiedDate,title,labels(trashed))");
+
+	query_uri = gdata_query_get_query_uri (GDATA_QUERY (query), "http://example.com");
+	g_assert_cmpstr (query_uri, ==, "http://example.com?q=trashed%3Dfalse"
+	                                "&fields=kind,nextPageToken,items(kind,mimeType,id,etag,modifiedDate,title,labels(trashed))");
+	g_free (query_uri);
+
+	/* …a subset of them, with a feed URI with pre-existing arguments */
+	gdata_documents_query_set_field_mask (query, GDATA_QUERY_FIELDS_ID | GDATA_QUERY_FIELDS_UPDATED);
+	g_assert_cmpstr (gdata_query_get_fields (GDATA_QUERY (query)), ==, "kind,nextPageToken,items(kind,mimeType,id,modifiedDate)");
+
+	query_uri = gdata_query_get_query_uri (GDATA_QUERY (query), "http://example.com?foo=bar");
+	g_assert_cmpstr (query_uri, ==, "http://example.com?foo=bar&q=trashed%3Dfalse"
+	                                "&fields=kind,nextPageToken,items(kind,mimeType,id,modifiedDate)");
+	g_free (query_uri);
+
+	/* Unsetting the mask should remove the parameter again */
+	gdata_documents_query_set_field_mask (query, 0);
+	g_assert (gdata_query_get_fields (GDATA_QUERY (query)) == NULL);
+
+	query_uri = gdata_query_get_query_uri (GDATA_QUERY (query), "http://example.com");
+	g_assert_cmpstr (query_uri, ==, "http://example.com?q=trashed%3Dfalse");
+	g_free (query_uri);
+
+	g_object_unref (query);
+}
+
 static void
 test_query_etag (void)
 {
@@ -2164,7 +2418,10 @@ main (int argc, char *argv[])
 	            tear_down_batch_async);
 
 	g_test_add_func ("/documents/folder/parser/normal", test_folder_parser_normal);
+	g_test_add_func ("/documents/folder/index", test_folder_index);
+	g_test_add_data_func ("/documents/sync-session", service, test_sync_session);
 	g_test_add_func ("/documents/query/etag", test_query_etag);
+	g_test_add_func ("/documents/query/field_mask", test_query_field_mask);
 	g_test_add_func ("/documents/upload-query/properties/convert", test_upload_query_properties_convert);
 
 	retval = g_test_run ();
@@ -18,7 +18,9 @@
  */
 
 #include <glib.h>
+#include <glib/gstdio.h>
 #include <locale.h>
+#include <string.h>
 
 #include "gdata.h"
 #include "common.h"
@@ -538,6 +540,62 @@ test_entry_parse_xml (void)
 	g_object_unref (entry);
 }
 
+static void
+test_entry_parse_xml_statistics (void)
+{
+	GDataEntry *entry;
+	GDataParseStatistics outer, inner;
+	const gchar *xml =
+		"<entry xmlns='http://www.w3.org/2005/Atom' xmlns:ns='http://example.com/'>"
+			"<title type='text'>Testing parse statistics</title>"
+			"<updated>2009-01-25T14:07:37Z</updated>"
+			"<published>2009-01-23T14:06:37Z</published>"
+			"<foobar>Test!</foobar>"
+			"<ns:barfoo shizzle='zing'/>"
+		"</entry>";
+	GError *error = NULL;
+
+	gdata_parse_statistics_start (&outer);
+	gdata_parse_statistics_start (&inner);
+
+	entry = GDATA_ENTRY (gdata_parsable_new_from_xml (GDATA_TYPE_ENTRY, xml, -1, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_ENTRY (entry));
+	g_object_unref (entry);
+
+	gdata_parse_statistics_stop (&inner);
+
+	/* Nested collections should both be updated */
+	g_assert_cmpuint (inner.bytes_parsed, ==, strlen (xml));
+	g_assert_cmpuint (inner.elements_visited, ==, 5);
+	g_assert_cmpuint (inner.parsables_built, ==, 1);
+	g_assert_cmpuint (inner.entries_built, ==, 1);
+	g_assert_cmpuint (inner.unhandled_elements, ==, 2);
+	g_assert_cmpuint (inner.unhandled_bytes, >, 0);
+	g_assert_cmpint (inner.tokenize_time, >=, 0);
+	g_assert_cmpint (inner.build_time, >=, 0);
+	g_assert_cmpint (inner.progress_callback_time, ==, 0);
+
+	/* Only the outer collection should count this one */
+	entry = GDATA_ENTRY (gdata_parsable_new_from_xml (GDATA_TYPE_ENTRY, xml, -1, &error));
+	g_assert_no_error (error);
+	g_object_unref (entry);
+
+	gdata_parse_statistics_stop (&outer);
+
+	g_assert_cmpuint (outer.bytes_parsed, ==, 2 * strlen (xml));
+	g_assert_cmpuint (outer.entries_built, ==, 2);
+	g_assert_cmpuint (outer.unhandled_elements, ==, 4);
+	g_assert_cmpuint (inner.entries_built, ==, 1);
+
+	/* Nothing should be collected once stopped */
+	entry = GDATA_ENTRY (gdata_parsable_new_from_xml (GDATA_TYPE_ENTRY, xml, -1, &error));
+	g_assert_no_error (error);
+	g_object_unref (entry);
+
+	g_assert_cmpuint (outer.entries_built, ==, 2);
+}
+
 static void
 test_entry_parse_xml_kind_category (void)
 {
@@ -1083,6 +1141,308 @@ test_feed_error_handling (void)
 #undef TEST_XML_ERROR_HANDLING
 }
 
+/* Build a feed with @n_entries entries, every third of which has an element libgdata doesn't handle. The entries at @duplicate_title and
+ * @duplicate_id (if they're less than @n_entries) are made invalid by duplicating their <title> and <id> elements, respectively. */
+static gchar *
+build_feed_with_entries (guint n_entries, guint duplicate_title, guint duplicate_id)
+{
+	GString *xml;
+	guint i;
+
+	xml = g_string_new ("<?xml version='1.0' encoding='UTF-8'?>"
+	                    "<feed xmlns='http://www.w3.org/2005/Atom' xmlns:foo='http://example.com/foo'>"
+	                    "<title>Test feed</title>"
+	                    "<id>http://example.com/feed</id>"
+	                    "<updated>2009-01-25T14:07:37Z</updated>");
+
+	for (i = 0; i < n_entries; i++) {
+		g_string_append_printf (xml, "<entry><title>Entry %u</title><id>http://example.com/entries/%u</id>"
+		                        "<updated>2009-01-25T14:07:37Z</updated>", i, i);
+
+		if (i % 3 == 0)
+			g_string_append_printf (xml, "<foo:unhandled>Unhandled %u</foo:unhandled>", i);
+		if (i == duplicate_title)
+			g_string_append (xml, "<title>Duplicate title</title>");
+		if (i == duplicate_id)
+			g_string_append (xml, "<id>http://example.com/entries/duplicate</id>");
+
+		g_string_append (xml, "</entry>");
+	}
+
+	g_string_append (xml, "</feed>");
+
+	return g_string_free (xml, FALSE);
+}
+
+static gboolean
+feed_entries_handle_message_cb (UhmServer *server, SoupMessage *message, SoupClientContext *client, const gchar **feed_xml)
+{
+	soup_message_set_status (message, SOUP_STATUS_OK);
+	soup_message_set_response (message, "application/atom+xml", SOUP_MEMORY_COPY, *feed_xml, strlen (*feed_xml));
+
+	return TRUE;
+}
+
+static void
+feed_entries_progress_cb (GDataEntry *entry, guint entry_key, guint entry_count, GPtrArray *progress_entries)
+{
+	/* The entries should be reported in document order */
+	g_assert (GDATA_IS_ENTRY (entry));
+	g_assert_cmpuint (entry_key, ==, progress_entries->len);
+
+	g_ptr_array_add (progress_entries, g_object_ref (entry));
+}
+
+static GDataFeed *
+query_feed_with_entries (GDataService *service, GPtrArray *progress_entries, GError **error)
+{
+	GDataFeed *feed;
+
+	feed = gdata_service_query (service, NULL, "https://example.com/feed", NULL, GDATA_TYPE_ENTRY, NULL,
+	                            (GDataQueryProgressCallback) feed_entries_progress_cb, progress_entries, error);
+
+	/* Make sure any progress callbacks dispatched to the main context have been called */
+	while (g_main_context_iteration (NULL, FALSE) == TRUE);
+
+	return feed;
+}
+
+/* Test that the entries of a feed are added in document order, with progress callbacks in the same order, and that if several are invalid,
+ * the error from the first in the document is returned. Feeds with at least 16 entries have them built in parallel if more than one
+ * processor is available, so this is run with feeds either side of that threshold. */
+static void
+test_feed_parse_xml_entries (gconstpointer user_data)
+{
+	guint n_entries = GPOINTER_TO_UINT (user_data);
+	UhmServer *mock_server;
+	GDataService *service;
+	GDataFeed *feed;
+	GPtrArray *progress_entries;
+	GList *entries;
+	const gchar *feed_xml = NULL;
+	gchar *xml;
+	gulong handler_id;
+	guint i;
+	GError *error = NULL;
+
+	mock_server = gdata_test_get_mock_server ();
+
+	if (uhm_server_get_enable_logging (mock_server) == TRUE) {
+		g_test_message ("Ignoring test due to logging being enabled.");
+		return;
+	} else if (uhm_server_get_enable_online (mock_server) == TRUE) {
+		g_test_message ("Ignoring test due to running online and test not being reproducible.");
+		return;
+	}
+
+	if (n_entries >= 16 && g_get_num_processors () < 2)
+		g_test_message ("Only one processor is available, so the entries will be built serially.");
+
+	handler_id = g_signal_connect (mock_server, "handle-message", (GCallback) feed_entries_handle_message_cb, &feed_xml);
+	uhm_server_run (mock_server);
+	gdata_test_set_https_port (mock_server);
+	uhm_resolver_add_A (uhm_server_get_resolver (mock_server), "example.com", uhm_server_get_address (mock_server));
+
+	/* This is a little hacky, but it should work */
+	service = g_object_new (GDATA_TYPE_SERVICE, NULL);
+	progress_entries = g_ptr_array_new_with_free_func (g_object_unref);
+
+	/* A valid feed */
+	xml = build_feed_with_entries (n_entries, G_MAXUINT, G_MAXUINT);
+	feed_xml = xml;
+
+	feed = query_feed_with_entries (service, progress_entries, &error);
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_FEED (feed));
+
+	entries = gdata_feed_get_entries (feed);
+	g_assert_cmpuint (g_list_length (entries), ==, n_entries);
+	g_assert_cmpuint (progress_entries->len, ==, n_entries);
+
+	for (i = 0; entries != NULL; entries = entries->next, i++) {
+		gchar *id, *entry_xml, *unhandled;
+
+		id = g_strdup_printf ("http://example.com/entries/%u", i);
+		g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (entries->data)), ==, id);
+		g_assert (g_ptr_array_index (progress_entries, i) == entries->data);
+		g_free (id);
+
+		/* The unhandled elements should have been kept with the right entries */
+		entry_xml = gdata_parsable_get_xml (GDATA_PARSABLE (entries->data));
+		unhandled = g_strdup_printf ("Unhandled %u<", i);
+		g_assert ((strstr (entry_xml, unhandled) != NULL) == (i % 3 == 0));
+		g_free (unhandled);
+		g_free (entry_xml);
+	}
+
+	g_object_unref (feed);
+	g_free (xml);
+
+	/* Invalid entries a quarter and half of the way through; whichever is first should give the error */
+	xml = build_feed_with_entries (n_entries, n_entries / 4, n_entries / 2);
+	feed_xml = xml;
+	g_ptr_array_set_size (progress_entries, 0);
+
+	feed = query_feed_with_entries (service, progress_entries, &error);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR);
+	g_assert (strstr (error->message, "/title>") != NULL);
+	g_assert (feed == NULL);
+	g_clear_error (&error);
+	g_free (xml);
+
+	/* No entries after the invalid one should have been reported */
+	g_assert_cmpuint (progress_entries->len, <=, n_entries / 4);
+
+	xml = build_feed_with_entries (n_entries, n_entries / 2, n_entries / 4);
+	feed_xml = xml;
+	g_ptr_array_set_size (progress_entries, 0);
+
+	feed = query_feed_with_entries (service, progress_entries, &error);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR);
+	g_assert (strstr (error->message, "/id>") != NULL);
+	g_assert (feed == NULL);
+	g_clear_error (&error);
+	g_free (xml);
+
+	g_assert_cmpuint (progress_entries->len, <=, n_entries / 4);
+
+	g_ptr_array_unref (progress_entries);
+	g_object_unref (service);
+
+	uhm_server_stop (mock_server);
+	g_signal_handler_disconnect (mock_server, handler_id);
+}
+
+typedef struct {
+	GDataParseStatistics statistics;
+	GArray/*<guint>*/ *entries_built; /* statistics.entries_built at each progress callback */
+} ProgressLatencyData;
+
+static void
+feed_progress_latency_cb (GDataEntry *entry, guint entry_key, guint entry_count, ProgressLatencyData *data)
+{
+	g_assert (GDATA_IS_ENTRY (entry));
+	g_assert_cmpuint (entry_key, ==, data->entries_built->len);
+
+	g_array_append_val (data->entries_built, data->statistics.entries_built);
+}
+
+/* Test that GDataQuery:progress-latency bounds how long an entry in an XML feed is held back before its progress callback is called, even when
+ * the batch it's in isn't full. The callbacks are called in the parsing thread, so the parse statistics show how far through the feed the
+ * parser had got when each was called. */
+static void
+test_feed_parse_xml_progress_latency (void)
+{
+	UhmServer *mock_server;
+	GDataService *service;
+	GDataQuery *query;
+	GDataFeed *feed;
+	ProgressLatencyData data;
+	const gchar *feed_xml = NULL;
+	gchar *xml;
+	gulong handler_id;
+	guint i;
+	GError *error = NULL;
+
+	mock_server = gdata_test_get_mock_server ();
+
+	if (uhm_server_get_enable_logging (mock_server) == TRUE) {
+		g_test_message ("Ignoring test due to logging being enabled.");
+		return;
+	} else if (uhm_server_get_enable_online (mock_server) == TRUE) {
+		g_test_message ("Ignoring test due to running online and test not being reproducible.");
+		return;
+	}
+
+	handler_id = g_signal_connect (mock_server, "handle-message", (GCallback) feed_entries_handle_message_cb, &feed_xml);
+	uhm_server_run (mock_server);
+	gdata_test_set_https_port (mock_server);
+	uhm_resolver_add_A (uhm_server_get_resolver (mock_server), "example.com", uhm_server_get_address (mock_server));
+
+	/* This is a little hacky, but it should work */
+	service = g_object_new (GDATA_TYPE_SERVICE, NULL);
+	data.entries_built = g_array_new (FALSE, FALSE, sizeof (guint));
+
+	/* Few enough entries that they're built serially, all fitting in one batch */
+	xml = build_feed_with_entries (12, G_MAXUINT, G_MAXUINT);
+	feed_xml = xml;
+
+	query = gdata_query_new (NULL);
+	g_object_set (G_OBJECT (query),
+	              "progress-batch-size", 100,
+	              "progress-latency", 0,
+	              "progress-in-thread", TRUE,
+	              NULL);
+
+	/* With no latency allowed, each entry should be reported as soon as it's built, before any later entries are built */
+	gdata_parse_statistics_start (&(data.statistics));
+	feed = gdata_service_query (service, NULL, "https://example.com/feed", query, GDATA_TYPE_ENTRY, NULL,
+	                            (GDataQueryProgressCallback) feed_progress_latency_cb, &data, &error);
+	gdata_parse_statistics_stop (&(data.statistics));
+
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_FEED (feed));
+	g_object_unref (feed);
+
+	g_assert_cmpuint (data.entries_built->len, ==, 12);
+	for (i = 0; i < data.entries_built->len; i++)
+		g_assert_cmpuint (g_array_index (data.entries_built, guint, i), ==, i + 1);
+
+	/* With a long latency, the batch should only be dispatched once the whole feed has been built */
+	gdata_query_set_progress_latency (query, 60000);
+	g_array_set_size (data.entries_built, 0);
+
+	gdata_parse_statistics_start (&(data.statistics));
+	feed = gdata_service_query (service, NULL, "https://example.com/feed", query, GDATA_TYPE_ENTRY, NULL,
+	                            (GDataQueryProgressCallback) feed_progress_latency_cb, &data, &error);
+	gdata_parse_statistics_stop (&(data.statistics));
+
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_FEED (feed));
+	g_object_unref (feed);
+
+	g_assert_cmpuint (data.entries_built->len, ==, 12);
+	for (i = 0; i < data.entries_built->len; i++)
+		g_assert_cmpuint (g_array_index (data.entries_built, guint, i), ==, 12);
+
+	g_object_unref (query);
+	g_free (xml);
+	g_array_unref (data.entries_built);
+	g_object_unref (service);
+
+	uhm_server_stop (mock_server);
+	g_signal_handler_disconnect (mock_server, handler_id);
+}
+
+static void
+test_feed_parse_xml_partial (void)
+{
+	GDataFeed *feed;
+	GDataEntry *entry;
+	GError *error = NULL;
+
+	/* A partial response lacks the normally-required feed ID and updated time; it shouldn't be rejected */
+	feed = GDATA_FEED (gdata_parsable_new_from_xml (GDATA_TYPE_FEED,
+		"<feed xmlns='http://www.w3.org/2005/Atom' xmlns:gd='http://schemas.google.com/g/2005' "
+		      "gd:fields='entry(@gd:etag,id)'>"
+			"<entry gd:etag='W/\"C0QBRXcycSp7ImA9WxRVFUk.\"'>"
+				"<id>http://example.com/id/1</id>"
+			"</entry>"
+		"</feed>", -1, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_FEED (feed));
+
+	g_assert (gdata_feed_get_id (feed) == NULL);
+	g_assert_cmpint (gdata_feed_get_updated (feed), ==, -1);
+	g_assert_cmpuint (g_list_length (gdata_feed_get_entries (feed)), ==, 1);
+
+	entry = GDATA_ENTRY (gdata_feed_get_entries (feed)->data);
+	g_assert_cmpstr (gdata_entry_get_id (entry), ==, "http://example.com/id/1");
+	g_assert_cmpstr (gdata_entry_get_etag (entry), ==, "W/\"C0QBRXcycSp7ImA9WxRVFUk.\"");
+
+	g_object_unref (feed);
+}
+
 static void
 test_feed_escaping (void)
 {
@@ -1111,6 +1471,158 @@ test_feed_escaping (void)
 	g_object_unref (feed);
 }
 
+static GDataFeed *
+parse_entry_store_feed (const gchar *entries_xml)
+{
+	GDataFeed *feed;
+	gchar *xml;
+	GError *error = NULL;
+
+	xml = g_strconcat ("<feed xmlns='http://www.w3.org/2005/Atom' xmlns:gd='http://schemas.google.com/g/2005'>"
+	                   "<id>http://example.com/feed</id>"
+	                   "<updated>2017-03-01T12:00:00Z</updated>"
+	                   "<title>Test feed</title>", entries_xml, "</feed>", NULL);
+	feed = GDATA_FEED (gdata_parsable_new_from_xml (GDATA_TYPE_FEED, xml, -1, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_FEED (feed));
+	g_free (xml);
+
+	return feed;
+}
+
+static void
+test_entry_store (void)
+{
+	GDataEntryStore *store;
+	GDataFeed *feed;
+	GDataEntry *entry;
+	GList *entries;
+	gchar *tmp_dir, *filename, *index_filename, *etag;
+	GError *error = NULL;
+
+	tmp_dir = g_dir_make_tmp ("gdata-entry-store-XXXXXX", &error);
+	g_assert_no_error (error);
+	filename = g_build_filename (tmp_dir, "entries", NULL);
+	index_filename = g_strconcat (filename, ".index", NULL);
+
+	/* Create a new store */
+	store = gdata_entry_store_new (filename, &error);
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_ENTRY_STORE (store));
+	g_assert_cmpstr (gdata_entry_store_get_filename (store), ==, filename);
+	g_assert_cmpuint (gdata_entry_store_get_n_entries (store), ==, 0);
+
+	feed = parse_entry_store_feed (
+		"<entry gd:etag='\"one\"'><id>http://example.com/1</id><updated>2017-01-01T00:00:00Z</updated><title>One</title></entry>"
+		"<entry gd:etag='\"two\"'><id>http://example.com/2</id><updated>2017-01-02T00:00:00Z</updated><title>Two</title></entry>"
+		"<entry gd:etag='\"three\"'><id>http://example.com/3</id><updated>2017-01-03T00:00:00Z</updated><title>Three</title></entry>");
+	g_assert (gdata_entry_store_upsert_feed (store, feed, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpuint (gdata_entry_store_get_n_entries (store), ==, 3);
+
+	/* Storing the same entries again straight away should find the records just appended for them, and leave them alone */
+	g_assert (gdata_entry_store_upsert_feed (store, feed, &error) == TRUE);
+	g_assert_no_error (error);
+	g_object_unref (feed);
+
+	g_assert_cmpuint (gdata_entry_store_get_n_entries (store), ==, 3);
+
+	/* Look up by ID */
+	entry = gdata_entry_store_lookup (store, "http://example.com/2", &error);
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_ENTRY (entry));
+	g_assert_cmpstr (gdata_entry_get_title (entry), ==, "Two");
+	g_assert_cmpint (gdata_entry_get_updated (entry), ==, 1483315200);
+	g_object_unref (entry);
+
+	g_assert (gdata_entry_store_lookup (store, "http://example.com/4", &error) == NULL);
+	g_assert_no_error (error);
+
+	etag = gdata_entry_store_dup_etag (store, "http://example.com/1");
+	g_assert_cmpstr (etag, ==, "\"one\"");
+	g_free (etag);
+
+	/* Range scans */
+	entries = gdata_entry_store_scan_updated (store, 1483315200, -1, &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (g_list_length (entries), ==, 2);
+	g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (entries->data)), ==, "http://example.com/2");
+	g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (entries->next->data)), ==, "http://example.com/3");
+	g_list_free_full (entries, g_object_unref);
+
+	entries = gdata_entry_store_scan_updated (store, -1, 1483315200, &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (g_list_length (entries), ==, 1);
+	g_assert_cmpstr (gdata_entry_get_id (GDATA_ENTRY (entries->data)), ==, "http://example.com/1");
+	g_list_free_full (entries, g_object_unref);
+
+	/* Remove an entry, then write the index and re-open the store */
+	g_assert (gdata_entry_store_remove (store, "http://example.com/1", &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpuint (gdata_entry_store_get_n_entries (store), ==, 2);
+	g_assert (gdata_entry_store_lookup (store, "http://example.com/1", &error) == NULL);
+	g_assert_no_error (error);
+
+	g_assert (gdata_entry_store_flush (store, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert (g_file_test (index_filename, G_FILE_TEST_EXISTS) == TRUE);
+	g_object_unref (store);
+
+	store = gdata_entry_store_new (filename, &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (gdata_entry_store_get_n_entries (store), ==, 2);
+	g_assert (gdata_entry_store_lookup (store, "http://example.com/1", &error) == NULL);
+	g_assert_no_error (error);
+
+	/* Update an entry without writing the index; the update should be re-read from the data file when the store is re-opened */
+	feed = parse_entry_store_feed (
+		"<entry gd:etag='\"three-b\"'><id>http://example.com/3</id><updated>2017-01-04T00:00:00Z</updated><title>Three B</title></entry>");
+	g_assert (gdata_entry_store_upsert_feed (store, feed, &error) == TRUE);
+	g_assert_no_error (error);
+	g_object_unref (feed);
+	g_object_unref (store);
+
+	store = gdata_entry_store_new (filename, &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (gdata_entry_store_get_n_entries (store), ==, 2);
+
+	entry = gdata_entry_store_lookup (store, "http://example.com/3", &error);
+	g_assert_no_error (error);
+	g_assert_cmpstr (gdata_entry_get_title (entry), ==, "Three B");
+	g_assert_cmpstr (gdata_entry_get_etag (entry), ==, "\"three-b\"");
+	g_object_unref (entry);
+
+	/* Compact the store, which should keep only the latest versions of the remaining entries */
+	g_assert (gdata_entry_store_compact (store, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpuint (gdata_entry_store_get_n_entries (store), ==, 2);
+
+	entries = gdata_entry_store_scan_updated (store, -1, -1, &error);
+	g_assert_no_error (error);
+	g_assert_cmpuint (g_list_length (entries), ==, 2);
+	g_assert_cmpstr (gdata_entry_get_title (GDATA_ENTRY (entries->data)), ==, "Two");
+	g_assert_cmpstr (gdata_entry_get_title (GDATA_ENTRY (entries->next->data)), ==, "Three B");
+	g_list_free_full (entries, g_object_unref);
+
+	g_object_unref (store);
+
+	/* A file which isn't a store should be rejected */
+	g_assert (g_file_set_contents (filename, "Not an entry store", -1, &error) == TRUE);
+	g_assert_no_error (error);
+	store = gdata_entry_store_new (filename, &error);
+	g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+	g_assert (store == NULL);
+	g_clear_error (&error);
+
+	g_unlink (index_filename);
+	g_unlink (filename);
+	g_rmdir (tmp_dir);
+
+	g_free (index_filename);
+	g_free (filename);
+	g_free (tmp_dir);
+}
+
 static void
 test_query_categories (void)
 {
@@ -1338,6 +1850,7 @@ test_query_properties (void)
 #undef gdata_query_get_is_strict
 	CHECK_PROPERTY_UINT ("max-results", max_results, 0);
 	CHECK_PROPERTY_STR ("etag", etag, NULL);
+	CHECK_PROPERTY_UINT ("prefetch-depth", prefetch_depth, 0);
 
 #undef CHECK_PROPERTY_BOOLEAN
 #undef CHECK_PROPERTY_UINT
@@ -1377,6 +1890,82 @@ test_query_unicode (void)
 	g_object_unref (query);
 }
 
+static void
+test_query_fields (void)
+{
+	GDataQuery *query;
+	gchar *query_uri;
+
+	query = gdata_query_new ("foobar");
+	g_assert (gdata_query_get_fields (query) == NULL);
+
+	/* Selector punctuation should be passed through; everything else should be escaped */
+	gdata_query_set_fields (query, "link[@rel='next'],entry(@gd:etag,id,updated)");
+	g_assert_cmpstr (gdata_query_get_fields (query), ==, "link[@rel='next'],entry(@gd:etag,id,updated)");
+
+	query_uri = gdata_query_get_query_uri (query, "http://example.com");
+	g_assert_cmpstr (query_uri, ==, "http://example.com?q=foobar&fields=link%5B@rel%3D%27next%27%5D,entry(@gd:etag,id,updated)");
+	g_free (query_uri);
+
+	/* Empty strings should unset it */
+	gdata_query_set_fields (query, "");
+	g_assert (gdata_query_get_fields (query) == NULL);
+
+	query_uri = gdata_query_get_query_uri (query, "http://example.com");
+	g_assert_cmpstr (query_uri, ==, "http://example.com?q=foobar");
+	g_free (query_uri);
+
+	g_object_unref (query);
+}
+
+static void
+batch_progress_cb (GPtrArray *entries, guint first_entry_key, guint entry_count, gpointer user_data)
+{
+	g_assert_not_reached ();
+}
+
+static void
+destroy_count_cb (guint *destroy_count)
+{
+	(*destroy_count)++;
+}
+
+static void
+test_query_progress (void)
+{
+	GDataQuery *query;
+	gchar *query_uri;
+	guint destroy_count = 0;
+
+	query = gdata_query_new ("foobar");
+	g_assert_cmpuint (gdata_query_get_progress_batch_size (query), ==, GDATA_QUERY_DEFAULT_PROGRESS_BATCH_SIZE);
+	g_assert_cmpuint (gdata_query_get_progress_latency (query), ==, GDATA_QUERY_DEFAULT_PROGRESS_LATENCY);
+	g_assert (gdata_query_get_progress_in_thread (query) == FALSE);
+
+	g_object_set (G_OBJECT (query),
+	              "progress-batch-size", 1,
+	              "progress-latency", 0,
+	              "progress-in-thread", TRUE,
+	              NULL);
+	g_assert_cmpuint (gdata_query_get_progress_batch_size (query), ==, 1);
+	g_assert_cmpuint (gdata_query_get_progress_latency (query), ==, 0);
+	g_assert (gdata_query_get_progress_in_thread (query) == TRUE);
+
+	/* None of them should affect the query URI */
+	query_uri = gdata_query_get_query_uri (query, "http://example.com");
+	g_assert_cmpstr (query_uri, ==, "http://example.com?q=foobar");
+	g_free (query_uri);
+
+	/* Replacing the batch callback should destroy the old user data, as should finalising the query */
+	gdata_query_set_batch_progress_callback (query, batch_progress_cb, &destroy_count, (GDestroyNotify) destroy_count_cb);
+	g_assert_cmpuint (destroy_count, ==, 0);
+	gdata_query_set_batch_progress_callback (query, batch_progress_cb, &destroy_count, (GDestroyNotify) destroy_count_cb);
+	g_assert_cmpuint (destroy_count, ==, 1);
+
+	g_object_unref (query);
+	g_assert_cmpuint (destroy_count, ==, 2);
+}
+
 static void
 test_query_etag (void)
 {
@@ -1404,6 +1993,7 @@ test_query_etag (void)
 	CHECK_ETAG (gdata_query_set_start_index (query, 5))
 	CHECK_ETAG (gdata_query_set_is_strict (query, TRUE))
 	CHECK_ETAG (gdata_query_set_max_results (query, 1000))
+	CHECK_ETAG (gdata_query_set_fields (query, "entry(id)"))
 	CHECK_ETAG (gdata_query_next_page (query))
 	CHECK_ETAG (g_assert (gdata_query_previous_page (query)))
 
@@ -1412,6 +2002,55 @@ test_query_etag (void)
 	g_object_unref (query);
 }
 
+static void
+test_query_uri_cache (void)
+{
+	GDataQuery *query;
+	gchar *query_uri;
+
+	/* Test that the cached query URI is rebuilt whenever a property affecting it changes, and only then */
+	query = gdata_query_new ("test");
+
+	query_uri = gdata_query_get_query_uri (query, "http://example.com/");
+	g_assert_cmpstr (query_uri, ==, "http://example.com/?q=test");
+	g_free (query_uri);
+
+	/* Building it again, or changing properties which don't affect the URI, should give the same result */
+	gdata_query_set_etag (query, "etag");
+
+	query_uri = gdata_query_get_query_uri (query, "http://example.com/");
+	g_assert_cmpstr (query_uri, ==, "http://example.com/?q=test");
+	g_free (query_uri);
+
+	/* Changing the feed URI should rebuild it */
+	query_uri = gdata_query_get_query_uri (query, "http://example.com/?foo=bar");
+	g_assert_cmpstr (query_uri, ==, "http://example.com/?foo=bar&q=test");
+	g_free (query_uri);
+
+	/* As should changing properties */
+	gdata_query_set_max_results (query, 10);
+	gdata_query_set_updated_min (query, 1234567890);
+
+	query_uri = gdata_query_get_query_uri (query, "http://example.com/");
+	g_assert_cmpstr (query_uri, ==, "http://example.com/?q=test&updated-min=2009-02-13T23:31:30Z&max-results=10");
+	g_free (query_uri);
+
+	/* And paginating, which doesn't notify */
+	gdata_query_next_page (query);
+
+	query_uri = gdata_query_get_query_uri (query, "http://example.com/");
+	g_assert_cmpstr (query_uri, ==, "http://example.com/?q=test&updated-min=2009-02-13T23:31:30Z&start-index=11&max-results=10");
+	g_free (query_uri);
+
+	g_assert (gdata_query_previous_page (query) == TRUE);
+
+	query_uri = gdata_query_get_query_uri (query, "http://example.com/");
+	g_assert_cmpstr (query_uri, ==, "http://example.com/?q=test&updated-min=2009-02-13T23:31:30Z&max-results=10");
+	g_free (query_uri);
+
+	g_object_unref (query);
+}
+
 static void
 test_service_network_error (void)
 {
@@ -1467,6 +2106,123 @@ test_service_locale (void)
 	g_object_unref (service);
 }
 
+static void
+test_service_connections (void)
+{
+	GDataService *service, *service2;
+	SoupSession *session, *session2;
+	guint max_connections;
+
+	/* This is a little hacky, but it should work */
+	service = g_object_new (GDATA_TYPE_SERVICE, NULL);
+
+	/* Check the defaults and setting the properties */
+	g_assert_cmpuint (gdata_service_get_max_connections_per_host (service), ==, 6);
+	gdata_service_set_max_connections (service, 20);
+	g_assert_cmpuint (gdata_service_get_max_connections (service), ==, 20);
+	gdata_service_set_max_connections_per_host (service, 8);
+	g_assert_cmpuint (gdata_service_get_max_connections_per_host (service), ==, 8);
+	gdata_service_set_idle_timeout (service, 0);
+	g_assert_cmpuint (gdata_service_get_idle_timeout (service), ==, 0);
+
+	g_object_get (service, "max-connections", &max_connections, "session", &session, NULL);
+	g_assert_cmpuint (max_connections, ==, 20);
+	g_assert (SOUP_IS_SESSION (session));
+
+	/* Share the session with another service; the connection limits should be shared too */
+	service2 = g_object_new (GDATA_TYPE_SERVICE, "session", session, NULL);
+	g_object_get (service2, "session", &session2, NULL);
+	g_assert (session2 == session);
+	g_assert_cmpuint (gdata_service_get_max_connections_per_host (service2), ==, 8);
+
+	/* The second service should keep working after the first has been destroyed */
+	g_object_unref (service);
+	gdata_service_set_timeout (service2, 30);
+	g_assert_cmpuint (gdata_service_get_timeout (service2), ==, 30);
+
+	g_object_unref (session2);
+	g_object_unref (session);
+	g_object_unref (service2);
+}
+
+static void
+test_service_rate_limit (void)
+{
+	GDataService *service;
+	GDataAuthorizationDomain *domain;
+	gdouble requests_per_second;
+	guint burst;
+
+	/* This is a little hacky, but it should work */
+	service = g_object_new (GDATA_TYPE_SERVICE, NULL);
+	domain = g_object_new (GDATA_TYPE_AUTHORIZATION_DOMAIN, "service-name", "test", "scope", "https://example.com/", NULL);
+
+	/* No limits by default */
+	g_assert (gdata_service_get_rate_limit (service, domain, &requests_per_second, &burst) == FALSE);
+	g_assert_cmpfloat (requests_per_second, ==, 0.0);
+	g_assert_cmpuint (burst, ==, 0);
+
+	/* Limits are per-domain */
+	gdata_service_set_rate_limit (service, domain, 5.0, 10, TRUE);
+	g_assert (gdata_service_get_rate_limit (service, domain, &requests_per_second, &burst) == TRUE);
+	g_assert_cmpfloat (requests_per_second, ==, 5.0);
+	g_assert_cmpuint (burst, ==, 10);
+	g_assert (gdata_service_get_rate_limit (service, NULL, NULL, NULL) == FALSE);
+
+	gdata_service_set_rate_limit (service, NULL, 1.0, 1, FALSE);
+	g_assert (gdata_service_get_rate_limit (service, NULL, &requests_per_second, &burst) == TRUE);
+	g_assert_cmpfloat (requests_per_second, ==, 1.0);
+	g_assert_cmpuint (burst, ==, 1);
+
+	/* Remove them again */
+	gdata_service_set_rate_limit (service, domain, 0.0, 1, FALSE);
+	g_assert (gdata_service_get_rate_limit (service, domain, NULL, NULL) == FALSE);
+	g_assert (gdata_service_get_rate_limit (service, NULL, NULL, NULL) == TRUE);
+
+	g_object_unref (domain);
+	g_object_unref (service);
+}
+
+static void
+test_service_patch_entry (void)
+{
+	GDataService *service;
+	GDataEntry *entry, *updated_entry;
+	GError *error = NULL;
+
+	/* This is a little hacky, but it should work */
+	service = g_object_new (GDATA_TYPE_SERVICE, NULL);
+
+	entry = GDATA_ENTRY (gdata_parsable_new_from_xml (GDATA_TYPE_ENTRY,
+		"<entry xmlns='http://www.w3.org/2005/Atom' xmlns:gd='http://schemas.google.com/g/2005' gd:etag='W/\"ABC\"'>"
+			"<id>http://example.com/id</id>"
+			"<title type='text'>Patch me</title>"
+			"<updated>2009-01-25T14:07:37Z</updated>"
+			"<link rel='edit' href='https://thisshouldnotexist.invalid/edit'/>"
+		 "</entry>", -1, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_ENTRY (entry));
+
+	/* An unchanged entry shouldn't touch the network at all */
+	updated_entry = gdata_service_patch_entry (service, NULL, entry, NULL, &error);
+	g_assert_no_error (error);
+	g_assert (updated_entry == entry);
+	g_object_unref (updated_entry);
+
+	/* A changed one should be sent, which fails here due to errors resolving the hostname */
+	gdata_entry_set_title (entry, "Patched");
+	g_assert (gdata_service_patch_entry (service, NULL, entry, NULL, &error) == NULL);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_NETWORK_ERROR);
+	g_clear_error (&error);
+
+	/* The entry itself shouldn't have been touched by the failure */
+	g_assert_cmpstr (gdata_entry_get_title (entry), ==, "Patched");
+	g_assert_cmpstr (gdata_entry_get_etag (entry), ==, "W/\"ABC\"");
+
+	g_object_unref (entry);
+	g_object_unref (service);
+}
+
 static void
 test_access_rule_get_xml (void)
 {
@@ -1727,6 +2483,139 @@ test_comparable (void)
 	g_object_unref (category);
 }
 
+static void
+test_comparable_hash (void)
+{
+	GDataEntry *entry;
+	GDataLink *link_;
+	GList *links;
+	guint i;
+	gchar *uri;
+	GDataComparable *category1, *category2;
+
+	/* Equal objects must have equal hashes */
+	category1 = GDATA_COMPARABLE (gdata_category_new ("term", "http://scheme", "label"));
+	category2 = GDATA_COMPARABLE (gdata_category_new ("term", "http://other-scheme", NULL));
+	g_assert_cmpint (gdata_comparable_compare (category1, category2), ==, 0);
+	g_assert_cmpuint (gdata_comparable_hash (category1), ==, gdata_comparable_hash (category2));
+	g_object_unref (category2);
+	g_object_unref (category1);
+
+	/* Add enough links to an entry that they get indexed, then check duplicates are still rejected and the order is preserved */
+	entry = gdata_entry_new (NULL);
+
+	for (i = 0; i < 50; i++) {
+		uri = g_strdup_printf ("http://example.com/%u", i);
+		link_ = gdata_link_new (uri, GDATA_LINK_RELATED);
+		gdata_entry_add_link (entry, link_);
+		g_object_unref (link_);
+		g_free (uri);
+	}
+
+	for (i = 0; i < 50; i += 7) {
+		uri = g_strdup_printf ("http://example.com/%u", i);
+		link_ = gdata_link_new (uri, GDATA_LINK_RELATED);
+		gdata_entry_add_link (entry, link_);
+		g_object_unref (link_);
+		g_free (uri);
+	}
+
+	links = gdata_entry_look_up_links (entry, GDATA_LINK_RELATED);
+	g_assert_cmpuint (g_list_length (links), ==, 50);
+	g_assert_cmpstr (gdata_link_get_uri (GDATA_LINK (links->data)), ==, "http://example.com/49");
+	g_assert_cmpstr (gdata_link_get_uri (GDATA_LINK (g_list_last (links)->data)), ==, "http://example.com/0");
+
+	/* Removing a link and adding it again should work */
+	link_ = g_object_ref (g_list_nth_data (links, 49 - 21));
+	g_assert_cmpstr (gdata_link_get_uri (link_), ==, "http://example.com/21");
+	g_list_free (links);
+
+	g_assert (gdata_entry_remove_link (entry, link_) == TRUE);
+	g_assert (gdata_entry_remove_link (entry, link_) == FALSE);
+
+	gdata_entry_add_link (entry, link_);
+	gdata_entry_add_link (entry, link_);
+	g_object_unref (link_);
+
+	links = gdata_entry_look_up_links (entry, GDATA_LINK_RELATED);
+	g_assert_cmpuint (g_list_length (links), ==, 50);
+	g_assert_cmpstr (gdata_link_get_uri (GDATA_LINK (links->data)), ==, "http://example.com/21");
+	g_list_free (links);
+
+	g_object_unref (entry);
+}
+
+static void
+test_comparable_hash_mutation (void)
+{
+	GDataContactsContact *contact;
+	GDataGDEmailAddress *email_address;
+	GDataEntry *entry;
+	GDataLink *link_;
+	GList *list;
+	guint i;
+	gchar *address, *uri;
+
+	/* Index a contact's e-mail addresses, then modify one of them in place so that its hash changes */
+	contact = gdata_contacts_contact_new (NULL);
+
+	for (i = 0; i < 10; i++) {
+		address = g_strdup_printf ("user%u@example.com", i);
+		email_address = gdata_gd_email_address_new (address, GDATA_GD_EMAIL_ADDRESS_WORK, NULL, FALSE);
+		gdata_contacts_contact_add_email_address (contact, email_address);
+		g_object_unref (email_address);
+		g_free (address);
+	}
+
+	list = gdata_contacts_contact_get_email_addresses (contact);
+	gdata_gd_email_address_set_address (GDATA_GD_EMAIL_ADDRESS (g_list_nth_data (list, 3)), "changed@example.com");
+
+	/* Adding an address equal to the modified one should be rejected as a duplicate, and adding its old address should now be allowed */
+	email_address = gdata_gd_email_address_new ("changed@example.com", GDATA_GD_EMAIL_ADDRESS_HOME, NULL, FALSE);
+	gdata_contacts_contact_add_email_address (contact, email_address);
+	g_object_unref (email_address);
+
+	g_assert_cmpuint (g_list_length (gdata_contacts_contact_get_email_addresses (contact)), ==, 10);
+
+	email_address = gdata_gd_email_address_new ("user3@example.com", GDATA_GD_EMAIL_ADDRESS_HOME, NULL, FALSE);
+	gdata_contacts_contact_add_email_address (contact, email_address);
+	g_object_unref (email_address);
+
+	list = gdata_contacts_contact_get_email_addresses (contact);
+	g_assert_cmpuint (g_list_length (list), ==, 11);
+	g_assert_cmpstr (gdata_gd_email_address_get_address (GDATA_GD_EMAIL_ADDRESS (g_list_nth_data (list, 3))), ==, "changed@example.com");
+	g_assert_cmpstr (gdata_gd_email_address_get_address (GDATA_GD_EMAIL_ADDRESS (g_list_last (list)->data)), ==, "user3@example.com");
+
+	g_object_unref (contact);
+
+	/* Do the same with an entry's links, and check that the modified link can still be found to remove it */
+	entry = gdata_entry_new (NULL);
+
+	for (i = 0; i < 10; i++) {
+		uri = g_strdup_printf ("http://example.com/%u", i);
+		link_ = gdata_link_new (uri, GDATA_LINK_RELATED);
+		gdata_entry_add_link (entry, link_);
+		g_object_unref (link_);
+		g_free (uri);
+	}
+
+	list = gdata_entry_look_up_links (entry, GDATA_LINK_RELATED);
+	link_ = g_object_ref (g_list_nth_data (list, 5));
+	g_list_free (list);
+
+	gdata_link_set_uri (link_, "http://example.com/changed");
+
+	g_assert (gdata_entry_remove_link (entry, link_) == TRUE);
+	g_assert (gdata_entry_remove_link (entry, link_) == FALSE);
+	g_object_unref (link_);
+
+	list = gdata_entry_look_up_links (entry, GDATA_LINK_RELATED);
+	g_assert_cmpuint (g_list_length (list), ==, 9);
+	g_list_free (list);
+
+	g_object_unref (entry);
+}
+
 static void
 test_color_parsing (void)
 {
@@ -3984,6 +4873,98 @@ test_media_thumbnail (void)
 	g_object_unref (thumbnail);
 }
 
+static void
+media_downloader_item_completed_cb (GDataMediaDownloader *downloader, GObject *media, GFile *file, const GError *error, guint *n_completed)
+{
+	g_assert_no_error ((GError*) error);
+	g_assert (GDATA_IS_MEDIA_THUMBNAIL (media));
+	g_assert (G_IS_FILE (file));
+
+	*n_completed = *n_completed + 1;
+}
+
+static void
+test_media_downloader (void)
+{
+	GDataService *service;
+	GDataMediaDownloader *downloader;
+	GDataMediaThumbnail *thumbnail1, *thumbnail2;
+	GOutputStream *sink1, *sink2;
+	GFile *cache_directory;
+	gchar *tmp_dir, *checksum, *filename;
+	guint n_completed = 0;
+	GError *error = NULL;
+
+	service = g_object_new (GDATA_TYPE_SERVICE, NULL);
+	downloader = gdata_media_downloader_new (service, 2);
+	g_assert (GDATA_IS_MEDIA_DOWNLOADER (downloader));
+	g_assert (gdata_media_downloader_get_service (downloader) == service);
+	g_assert_cmpuint (gdata_media_downloader_get_max_connections (downloader), ==, 2);
+	g_assert (gdata_media_downloader_get_cache_directory (downloader) == NULL);
+
+	/* Pre-populate the cache, so that the thumbnail isn't downloaded from the network */
+	tmp_dir = g_dir_make_tmp ("gdata-media-downloader-XXXXXX", &error);
+	g_assert_no_error (error);
+	checksum = g_compute_checksum_for_string (G_CHECKSUM_SHA256, "http://www.foo.com/keyframe.jpg", -1);
+	filename = g_build_filename (tmp_dir, checksum, NULL);
+	g_assert (g_file_set_contents (filename, "thumbnail data", -1, &error) == TRUE);
+	g_assert_no_error (error);
+
+	cache_directory = g_file_new_for_path (tmp_dir);
+	gdata_media_downloader_set_cache_directory (downloader, cache_directory);
+	g_assert (gdata_media_downloader_get_cache_directory (downloader) == cache_directory);
+	g_object_unref (cache_directory);
+
+	/* Add two thumbnails with the same URI, which should only be fetched once */
+	thumbnail1 = GDATA_MEDIA_THUMBNAIL (gdata_parsable_new_from_xml (GDATA_TYPE_MEDIA_THUMBNAIL,
+		"<media:thumbnail xmlns:media='http://search.yahoo.com/mrss/' url='http://www.foo.com/keyframe.jpg' width='75' height='50'/>",
+		-1, &error));
+	g_assert_no_error (error);
+	thumbnail2 = GDATA_MEDIA_THUMBNAIL (gdata_parsable_new_from_xml (GDATA_TYPE_MEDIA_THUMBNAIL,
+		"<media:thumbnail xmlns:media='http://search.yahoo.com/mrss/' url='http://www.foo.com/keyframe.jpg'/>", -1, &error));
+	g_assert_no_error (error);
+
+	sink1 = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+	sink2 = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+
+	gdata_media_downloader_add_thumbnail (downloader, thumbnail1, sink1);
+	gdata_media_downloader_add_thumbnail (downloader, thumbnail2, sink2);
+	g_assert_cmpuint (gdata_media_downloader_get_n_pending (downloader), ==, 1);
+
+	g_signal_connect (downloader, "item-completed", (GCallback) media_downloader_item_completed_cb, &n_completed);
+
+	/* Run the downloader and check both sinks got the cached data */
+	g_assert (gdata_media_downloader_run (downloader, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+
+	g_assert_cmpuint (n_completed, ==, 2);
+	g_assert_cmpuint (gdata_media_downloader_get_n_pending (downloader), ==, 0);
+
+	g_assert_cmpuint (g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (sink1)), ==, strlen ("thumbnail data"));
+	g_assert (memcmp (g_memory_output_stream_get_data (G_MEMORY_OUTPUT_STREAM (sink1)), "thumbnail data", strlen ("thumbnail data")) == 0);
+	g_assert_cmpuint (g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (sink2)), ==, strlen ("thumbnail data"));
+	g_assert (memcmp (g_memory_output_stream_get_data (G_MEMORY_OUTPUT_STREAM (sink2)), "thumbnail data", strlen ("thumbnail data")) == 0);
+
+	/* Running again with nothing added should do nothing */
+	g_assert (gdata_media_downloader_run (downloader, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpuint (n_completed, ==, 2);
+
+	g_object_unref (sink2);
+	g_object_unref (sink1);
+	g_object_unref (thumbnail2);
+	g_object_unref (thumbnail1);
+	g_object_unref (downloader);
+	g_object_unref (service);
+
+	g_unlink (filename);
+	g_rmdir (tmp_dir);
+
+	g_free (filename);
+	g_free (checksum);
+	g_free (tmp_dir);
+}
+
 static void
 test_gcontact_calendar (void)
 {
@@ -4788,11 +5769,15 @@ main (int argc, char *argv[])
 
 	g_test_add_func ("/service/network_error", test_service_network_error);
 	g_test_add_func ("/service/locale", test_service_locale);
+	g_test_add_func ("/service/connections", test_service_connections);
+	g_test_add_func ("/service/rate_limit", test_service_rate_limit);
+	g_test_add_func ("/service/patch_entry", test_service_patch_entry);
 
 	g_test_add_func ("/entry/get_xml", test_entry_get_xml);
 	g_test_add_func ("/entry/get_json", test_entry_get_json);
 	g_test_add_func ("/entry/parse_xml", test_entry_parse_xml);
 	g_test_add_func ("/entry/parse_xml/kind_category", test_entry_parse_xml_kind_category);
+	g_test_add_func ("/entry/parse_xml/statistics", test_entry_parse_xml_statistics);
 	g_test_add_func ("/entry/parse_json", test_entry_parse_json);
 	g_test_add_func ("/entry/error_handling/xml", test_entry_error_handling_xml);
 	g_test_add_func ("/entry/error_handling/json", test_entry_error_handling_json);
@@ -4800,9 +5785,15 @@ main (int argc, char *argv[])
 	g_test_add_func ("/entry/links/remove", test_entry_links_remove);
 
 	g_test_add_func ("/feed/parse_xml", test_feed_parse_xml);
+	g_test_add_func ("/feed/parse_xml/partial", test_feed_parse_xml_partial);
 	g_test_add_func ("/feed/error_handling", test_feed_error_handling);
+	g_test_add_data_func ("/feed/parse_xml/entries/serial", GUINT_TO_POINTER (12), test_feed_parse_xml_entries);
+	g_test_add_data_func ("/feed/parse_xml/entries/parallel", GUINT_TO_POINTER (48), test_feed_parse_xml_entries);
+	g_test_add_func ("/feed/parse_xml/progress_latency", test_feed_parse_xml_progress_latency);
 	g_test_add_func ("/feed/escaping", test_feed_escaping);
 
+	g_test_add_func ("/entry_store", test_entry_store);
+
 	g_test_add_func ("/query/categories", test_query_categories);
 	g_test_add_func ("/query/dates", test_query_dates);
 	g_test_add_func ("/query/strict", test_query_strict);
@@ -4810,6 +5801,9 @@ main (int argc, char *argv[])
 	g_test_add_func ("/query/properties", test_query_properties);
 	g_test_add_func ("/query/unicode", test_query_unicode);
 	g_test_add_func ("/query/etag", test_query_etag);
+	g_test_add_func ("/query/uri-cache", test_query_uri_cache);
+	g_test_add_func ("/query/fields", test_query_fields);
+	g_test_add_func ("/query/progress", test_query_progress);
 
 	g_test_add_func ("/access-rule/get_xml", test_access_rule_get_xml);
 	g_test_add_func ("/access-rule/get_xml/with_key", test_access_rule_get_xml_with_key);
@@ -4817,6 +5811,8 @@ main (int argc, char *argv[])
 	g_test_add_func ("/access-rule/escaping", test_access_rule_escaping);
 
 	g_test_add_func ("/comparable", test_comparable);
+	g_test_add_func ("/comparable/hash", test_comparable_hash);
+	g_test_add_func ("/comparable/hash/mutation", test_comparable_hash_mutation);
 
 	g_test_add_func ("/color/parsing", test_color_parsing);
 	g_test_add_func ("/color/output", test_color_output);
@@ -4872,6 +5868,7 @@ main (int argc, char *argv[])
 	g_test_add_func ("/media/credit", test_media_credit);
 	/* g_test_add_func ("/media/group", test_media_group); */
 	g_test_add_func ("/media/thumbnail", test_media_thumbnail);
+	g_test_add_func ("/media/downloader", test_media_downloader);
 	/*g_test_add_data_func ("/media/thumbnail/parse_time", "", test_media_thumbnail_parse_time);
 	g_test_add_data_func ("/media/thumbnail/parse_time", "de_DE", test_media_thumbnail_parse_time);*/
 
@@ -0,0 +1,745 @@
+/* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
+/*
+ * GData Client
+ * Copyright (C) Philip Withnall 2017 <philip@tecnocode.co.uk>
+ *
+ * GData Client is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * GData Client is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Load generator which replays the recorded traces in traces/ from a local HTTPS server, and issues the recorded requests through real
+ * #GDataService instances from several threads at once. It reports end-to-end throughput and latency percentiles for the library (threading,
+ * authorization, parsing), so that scaling regressions can be caught offline.
+ *
+ * Usage: load [OPTION…] [TRACE-FILE-OR-DIRECTORY…]
+ *
+ * If no traces are given, all of those in $G_TEST_SRCDIR/traces are used. Each trace is replayed using the service for the directory it's in
+ * (e.g. the traces in traces/calendar use a #GDataCalendarService), authorized for that service's primary domain by a #GDataDummyAuthorizer.
+ *
+ * Only successful GET requests are replayed by the clients: those whose response is a feed are issued using gdata_service_query(), and the rest
+ * are downloaded using a #GDataDownloadStream. Requests which modify state can't be reissued meaningfully from a trace, so they're skipped. Feeds
+ * are parsed as plain #GDataEntrys, since a single trace can contain feeds of several different entry types.
+ *
+ * Besides the human-readable summary, the results are printed as a single line of the form:
+ *   # LOAD {"requests": 1000, "errors": 0, "requests_per_second": …, "latency_us": {"p50": …, "p90": …, "p99": …, "p999": …, "max": …}}
+ * for scripts to compare between runs.
+ *
+ * If --rate is given, requests are issued on a fixed schedule and latencies are measured from when each request was scheduled to be sent, so
+ * that requests queued behind slow ones are not under-reported.
+ */
+
+#include "config.h"
+
+#include <glib.h>
+#include <locale.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "gdata.h"
+#include "common.h"
+#include "gdata-dummy-authorizer.h"
+
+#ifdef HAVE_LIBSOUP_2_55_90
+typedef struct {
+	const gchar *directory;
+	GType (*get_service_type) (void);
+	GDataAuthorizationDomain *(*get_authorization_domain) (void);
+	GDataService *service;  /* owned; created once traces for it have been found */
+} ServiceData;
+
+static ServiceData services[] = {
+	{ "calendar", gdata_calendar_service_get_type, gdata_calendar_service_get_primary_authorization_domain, NULL },
+	{ "contacts", gdata_contacts_service_get_type, gdata_contacts_service_get_primary_authorization_domain, NULL },
+	{ "documents", gdata_documents_service_get_type, gdata_documents_service_get_primary_authorization_domain, NULL },
+	{ "picasaweb", gdata_picasaweb_service_get_type, gdata_picasaweb_service_get_primary_authorization_domain, NULL },
+	{ "tasks", gdata_tasks_service_get_type, gdata_tasks_service_get_primary_authorization_domain, NULL },
+	{ "youtube", gdata_youtube_service_get_type, gdata_youtube_service_get_primary_authorization_domain, NULL },
+};
+
+typedef enum {
+	REPLAY_SKIP = 0,
+	REPLAY_QUERY,
+	REPLAY_DOWNLOAD,
+} ReplayKind;
+
+/* One request–response pair from a trace. */
+typedef struct {
+	gchar *method;
+	gchar *path;  /* normalised path and query */
+	guint status;
+	gchar *reason_phrase;
+	SoupMessageHeaders *response_headers;
+	GBytes *response_body;
+
+	ReplayKind kind;
+	ServiceData *service;  /* unowned */
+} Exchange;
+
+static void
+exchange_free (Exchange *exchange)
+{
+	g_free (exchange->method);
+	g_free (exchange->path);
+	g_free (exchange->reason_phrase);
+	if (exchange->response_headers != NULL)
+		soup_message_headers_free (exchange->response_headers);
+	if (exchange->response_body != NULL)
+		g_bytes_unref (exchange->response_body);
+	g_slice_free (Exchange, exchange);
+}
+
+/* Options */
+static gint concurrency = 4;
+static gint n_requests = 1000;
+static gdouble rate = 0.0;
+static gint latency = 0;
+
+static const GOptionEntry option_entries[] = {
+	{ "concurrency", 'c', 0, G_OPTION_ARG_INT, &concurrency, "Number of client threads (default: 4)", "N" },
+	{ "requests", 'n', 0, G_OPTION_ARG_INT, &n_requests, "Total number of requests to issue (default: 1000)", "N" },
+	{ "rate", 'r', 0, G_OPTION_ARG_DOUBLE, &rate, "Target request rate across all threads, in requests per second (default: unlimited)",
+	  "RATE" },
+	{ "latency", 'l', 0, G_OPTION_ARG_INT, &latency, "Simulated server latency, in milliseconds (default: 0)", "MS" },
+	{ NULL }
+};
+
+/* Loaded traces */
+static GPtrArray/*<owned Exchange>*/ *exchanges = NULL;
+static GHashTable/*<unowned utf8, unowned Exchange>*/ *responses = NULL;  /* "METHOD path" → response to serve */
+static GPtrArray/*<unowned Exchange>*/ *replayable = NULL;
+
+/* Normalise the path and query of a request so that it compares equal however it was escaped. */
+static gchar *
+normalise_path (const gchar *path)
+{
+	SoupURI *base, *uri;
+	gchar *normalised;
+
+	base = soup_uri_new ("https://localhost/");
+	uri = soup_uri_new_with_base (base, path);
+	soup_uri_free (base);
+
+	if (uri == NULL)
+		return NULL;
+
+	normalised = soup_uri_to_string (uri, TRUE);
+	soup_uri_free (uri);
+
+	return normalised;
+}
+
+static ReplayKind
+classify_exchange (Exchange *exchange)
+{
+	const gchar *content_type;
+	gconstpointer body;
+	gsize length;
+
+	if (exchange->service == NULL || exchange->method == NULL || exchange->path == NULL ||
+	    strcmp (exchange->method, SOUP_METHOD_GET) != 0 || SOUP_STATUS_IS_SUCCESSFUL (exchange->status) == FALSE) {
+		return REPLAY_SKIP;
+	}
+
+	content_type = soup_message_headers_get_content_type (exchange->response_headers, NULL);
+	body = g_bytes_get_data (exchange->response_body, &length);
+
+	/* Crude, but the responses are all well-formed and it avoids parsing them twice */
+	if (g_strcmp0 (content_type, "application/json") == 0 && g_strstr_len (body, length, "\"items\"") != NULL)
+		return REPLAY_QUERY;
+	else if (g_strcmp0 (content_type, "application/atom+xml") == 0 && g_strstr_len (body, length, "<feed") != NULL)
+		return REPLAY_QUERY;
+
+	return REPLAY_DOWNLOAD;
+}
+
+static void
+finish_exchange (Exchange *exchange, GString *response_body)
+{
+	if (exchange == NULL)
+		return;
+
+	if (response_body->len > 0 && response_body->str[response_body->len - 1] == '\n')
+		g_string_truncate (response_body, response_body->len - 1);
+	exchange->response_body = g_bytes_new (response_body->str, response_body->len);
+	g_string_truncate (response_body, 0);
+
+	exchange->kind = classify_exchange (exchange);
+	g_ptr_array_add (exchanges, exchange);
+
+	if (exchange->method != NULL && exchange->path != NULL) {
+		gchar *key = g_strdup_printf ("%s %s", exchange->method, exchange->path);
+		Exchange *existing = g_hash_table_lookup (responses, key);
+
+		/* Prefer the first successful response to each request */
+		if (existing == NULL || (SOUP_STATUS_IS_SUCCESSFUL (existing->status) == FALSE && SOUP_STATUS_IS_SUCCESSFUL (exchange->status) == TRUE))
+			g_hash_table_replace (responses, key, exchange);
+		else
+			g_free (key);
+	}
+
+	if (exchange->kind != REPLAY_SKIP)
+		g_ptr_array_add (replayable, exchange);
+}
+
+static gboolean
+is_request_line (const gchar *line, gsize length)
+{
+	return (length > strlen (" HTTP/1.x") &&
+	        (strncmp (line + length - strlen (" HTTP/1.x"), " HTTP/1.1", strlen (" HTTP/1.x")) == 0 ||
+	         strncmp (line + length - strlen (" HTTP/1.x"), " HTTP/1.0", strlen (" HTTP/1.x")) == 0));
+}
+
+/* Load a trace in the format written by uhttpmock: lines of the request prefixed with ‘> ’, then lines of the response prefixed with ‘< ’; headers
+ * and bodies separated by a prefix-only line. */
+static gboolean
+load_trace (const gchar *filename, ServiceData *service, GError **error)
+{
+	gchar *contents;
+	gsize length;
+	const gchar *line, *end;
+	Exchange *exchange = NULL;
+	GString *response_body;
+	enum { IN_REQUEST_HEADERS, IN_REQUEST_BODY, IN_RESPONSE_HEADERS, IN_RESPONSE_BODY } state = IN_REQUEST_BODY;
+
+	if (g_file_get_contents (filename, &contents, &length, error) == FALSE)
+		return FALSE;
+
+	response_body = g_string_new (NULL);
+
+	for (line = contents, end = contents + length; line < end;) {
+		const gchar *line_end = memchr (line, '\n', end - line);
+		gsize line_length;
+		gchar direction;
+		const gchar *content;
+		gsize content_length;
+
+		if (line_end == NULL)
+			line_end = end;
+		line_length = line_end - line;
+
+		if (line_length == 0 || (line[0] != '>' && line[0] != '<'))
+			goto next_line;
+
+		direction = line[0];
+		content = (line_length >= 2) ? line + 2 : line + line_length;
+		content_length = (line_length >= 2) ? line_length - 2 : 0;
+
+		if (direction == '>' && state != IN_REQUEST_HEADERS && is_request_line (content, content_length) == TRUE) {
+			/* Request line of a new exchange */
+			gchar *request_line = g_strndup (content, content_length), *space;
+
+			finish_exchange (exchange, response_body);
+
+			exchange = g_slice_new0 (Exchange);
+			exchange->service = service;
+			exchange->response_headers = soup_message_headers_new (SOUP_MESSAGE_HEADERS_RESPONSE);
+
+			space = strchr (request_line, ' ');
+			if (space != NULL) {
+				gchar *path_end;
+
+				exchange->method = g_strndup (request_line, space - request_line);
+				path_end = strchr (space + 1, ' ');
+				if (path_end != NULL)
+					*path_end = '\0';
+				exchange->path = normalise_path (space + 1);
+			}
+
+			g_free (request_line);
+			state = IN_REQUEST_HEADERS;
+		} else if (exchange == NULL) {
+			/* Ignore anything before the first request */
+		} else if (direction == '>') {
+			if (state == IN_REQUEST_HEADERS && content_length == 0)
+				state = IN_REQUEST_BODY;
+			/* The request's headers and body aren't needed */
+		} else if (state == IN_REQUEST_HEADERS || state == IN_REQUEST_BODY) {
+			gchar *status_line = g_strndup (content, content_length);
+
+			if (soup_headers_parse_status_line (status_line, NULL, &exchange->status, &exchange->reason_phrase) == FALSE)
+				exchange->status = SOUP_STATUS_MALFORMED;
+
+			g_free (status_line);
+			state = IN_RESPONSE_HEADERS;
+		} else if (state == IN_RESPONSE_HEADERS && content_length == 0) {
+			state = IN_RESPONSE_BODY;
+		} else if (state == IN_RESPONSE_HEADERS) {
+			gchar *header = g_strndup (content, content_length), *colon;
+
+			colon = strchr (header, ':');
+			if (colon != NULL) {
+				*colon = '\0';
+
+				/* The body is stored decoded and unchunked, and the debug headers are only meaningful to the original session */
+				if (g_ascii_strcasecmp (header, "Content-Encoding") != 0 && g_ascii_strcasecmp (header, "Transfer-Encoding") != 0 &&
+				    g_ascii_strcasecmp (header, "Content-Length") != 0 && g_ascii_strcasecmp (header, "Connection") != 0 &&
+				    g_ascii_strncasecmp (header, "Soup-Debug", strlen ("Soup-Debug")) != 0) {
+					soup_message_headers_append (exchange->response_headers, header, g_strstrip (colon + 1));
+				}
+			}
+
+			g_free (header);
+		} else {
+			g_string_append_len (response_body, content, content_length);
+			g_string_append_c (response_body, '\n');
+		}
+
+next_line:
+		line = line_end + 1;
+	}
+
+	finish_exchange (exchange, response_body);
+
+	g_string_free (response_body, TRUE);
+	g_free (contents);
+
+	return TRUE;
+}
+
+static gboolean
+load_traces (const gchar *path, GError **error)
+{
+	GDir *dir;
+	const gchar *name;
+	guint i;
+
+	if (g_file_test (path, G_FILE_TEST_IS_DIR) == FALSE) {
+		ServiceData *service = NULL;
+		gchar *dirname, *directory;
+
+		/* Pick the service from the name of the directory containing the trace */
+		dirname = g_path_get_dirname (path);
+		directory = g_path_get_basename (dirname);
+
+		for (i = 0; i < G_N_ELEMENTS (services); i++) {
+			if (strcmp (services[i].directory, directory) == 0) {
+				service = &services[i];
+				break;
+			}
+		}
+
+		g_free (directory);
+		g_free (dirname);
+
+		/* Traces for the authorizers don't use a service */
+		if (service == NULL)
+			return TRUE;
+
+		return load_trace (path, service, error);
+	}
+
+	dir = g_dir_open (path, 0, error);
+	if (dir == NULL)
+		return FALSE;
+
+	while ((name = g_dir_read_name (dir)) != NULL) {
+		gchar *child = g_build_filename (path, name, NULL);
+		gboolean success = load_traces (child, error);
+
+		g_free (child);
+
+		if (success == FALSE) {
+			g_dir_close (dir);
+			return FALSE;
+		}
+	}
+
+	g_dir_close (dir);
+
+	return TRUE;
+}
+
+/* Mock server */
+static gboolean
+unpause_message_cb (gpointer user_data)
+{
+	gpointer *data = user_data;
+
+	soup_server_unpause_message (data[0], data[1]);
+	g_object_unref (data[1]);
+	g_free (data);
+
+	return G_SOURCE_REMOVE;
+}
+
+static void
+server_handler_cb (SoupServer *server, SoupMessage *message, const char *path, GHashTable *query, SoupClientContext *client, gpointer user_data)
+{
+	Exchange *exchange;
+	gchar *normalised, *key;
+
+	normalised = soup_uri_to_string (soup_message_get_uri (message), TRUE);
+	key = g_strdup_printf ("%s %s", message->method, normalised);
+	exchange = g_hash_table_lookup (responses, key);
+	g_free (key);
+	g_free (normalised);
+
+	if (exchange == NULL) {
+		soup_message_set_status (message, SOUP_STATUS_NOT_FOUND);
+	} else {
+		SoupMessageHeadersIter iter;
+		const gchar *name, *value;
+
+		soup_message_set_status_full (message, exchange->status, exchange->reason_phrase);
+
+		soup_message_headers_iter_init (&iter, exchange->response_headers);
+		while (soup_message_headers_iter_next (&iter, &name, &value) == TRUE)
+			soup_message_headers_append (message->response_headers, name, value);
+
+		soup_message_body_append_bytes (message->response_body, exchange->response_body);
+	}
+
+	/* Delay the response without blocking the server's other connections */
+	if (latency > 0) {
+		GSource *source;
+		gpointer *data;
+
+		data = g_new (gpointer, 2);
+		data[0] = server;
+		data[1] = g_object_ref (message);
+
+		soup_server_pause_message (server, message);
+
+		source = g_timeout_source_new (latency);
+		g_source_set_callback (source, unpause_message_cb, data, NULL);
+		g_source_attach (source, g_main_context_get_thread_default ());
+		g_source_unref (source);
+	}
+}
+
+static gpointer
+run_server_thread (GMainLoop *loop)
+{
+	g_main_context_push_thread_default (g_main_loop_get_context (loop));
+	g_main_loop_run (loop);
+	g_main_context_pop_thread_default (g_main_loop_get_context (loop));
+
+	return NULL;
+}
+
+static gboolean
+quit_server_cb (GMainLoop *loop)
+{
+	g_main_loop_quit (loop);
+
+	return G_SOURCE_REMOVE;
+}
+
+/* Clients */
+typedef struct {
+	gint64 start_time;
+	guint port;
+	volatile gint next_request;
+	volatile gint n_errors;
+} LoadData;
+
+typedef struct {
+	LoadData *load;
+	GArray/*<gint64>*/ *latencies;
+} ClientData;
+
+static gboolean
+replay_exchange (Exchange *exchange, guint port, GError **error)
+{
+	GDataService *service = exchange->service->service;
+	GDataAuthorizationDomain *domain = exchange->service->get_authorization_domain ();
+	gchar *uri;
+	gboolean success = FALSE;
+
+	uri = g_strdup_printf ("https://127.0.0.1:%u%s", port, exchange->path);
+
+	if (exchange->kind == REPLAY_QUERY) {
+		GDataFeed *feed;
+
+		feed = gdata_service_query (service, domain, uri, NULL, GDATA_TYPE_ENTRY, NULL, NULL, NULL, error);
+		success = (feed != NULL);
+		g_clear_object (&feed);
+	} else {
+		GInputStream *stream;
+		guint8 buffer[16384];
+		gssize length;
+
+		stream = gdata_download_stream_new (service, domain, uri, NULL);
+
+		do {
+			length = g_input_stream_read (stream, buffer, sizeof (buffer), NULL, error);
+		} while (length > 0);
+
+		success = (length == 0);
+		g_input_stream_close (stream, NULL, NULL);
+
+		g_object_unref (stream);
+	}
+
+	g_free (uri);
+
+	return success;
+}
+
+static gpointer
+client_thread (ClientData *data)
+{
+	LoadData *load = data->load;
+	gint i;
+
+	while ((i = g_atomic_int_add (&load->next_request, 1)) < n_requests) {
+		Exchange *exchange = g_ptr_array_index (replayable, i % replayable->len);
+		gint64 start_time, end_time;
+		GError *error = NULL;
+
+		if (rate > 0.0) {
+			gint64 now;
+
+			/* Measure from the scheduled time, rather than when we actually got round to sending it */
+			start_time = load->start_time + (gint64) ((gdouble) i * G_USEC_PER_SEC / rate);
+			now = g_get_monotonic_time ();
+			if (start_time > now)
+				g_usleep (start_time - now);
+		} else {
+			start_time = g_get_monotonic_time ();
+		}
+
+		if (replay_exchange (exchange, load->port, &error) == FALSE) {
+			/* Only report the first error, to avoid flooding the output */
+			if (g_atomic_int_add (&load->n_errors, 1) == 0)
+				fprintf (stderr, "Error replaying %s %s: %s\n", exchange->method, exchange->path,
+				         (error != NULL) ? error->message : "unknown error");
+			g_clear_error (&error);
+			continue;
+		}
+
+		end_time = g_get_monotonic_time ();
+		g_array_append_val (data->latencies, end_time - start_time);
+	}
+
+	return NULL;
+}
+
+static gint
+compare_latencies (gconstpointer a, gconstpointer b)
+{
+	gint64 latency_a = *((const gint64*) a), latency_b = *((const gint64*) b);
+
+	return (latency_a < latency_b) ? -1 : (latency_a > latency_b) ? 1 : 0;
+}
+
+/* Nearest-rank percentile of the sorted @latencies. */
+static gint64
+get_percentile (GArray *latencies, gdouble percentile)
+{
+	guint rank;
+
+	if (latencies->len == 0)
+		return 0;
+
+	rank = (guint) (percentile / 100.0 * latencies->len + 0.999999);
+	rank = CLAMP (rank, 1, latencies->len);
+
+	return g_array_index (latencies, gint64, rank - 1);
+}
+
+int
+main (int argc, char *argv[])
+{
+	GOptionContext *context;
+	GMainContext *server_context;
+	GMainLoop *loop;
+	SoupServer *server;
+	GThread *server_thread, **threads;
+	ClientData *clients;
+	GArray *latencies;
+	LoadData load = { 0, };
+	GDataDummyAuthorizer *authorizer;
+	GList *domains = NULL;
+	GSList *uris;
+	gchar *cert_path, *key_path, *port_string;
+	gint64 total_time;
+	gdouble requests_per_second;
+	gint i;
+	GError *error = NULL;
+
+	setlocale (LC_ALL, "");
+
+	context = g_option_context_new ("[TRACE-FILE-OR-DIRECTORY…] — replay libgdata traces under load");
+	g_option_context_add_main_entries (context, option_entries, NULL);
+
+	if (g_option_context_parse (context, &argc, &argv, &error) == FALSE) {
+		fprintf (stderr, "Error: %s\n", error->message);
+		return 1;
+	}
+
+	g_option_context_free (context);
+
+	if (concurrency < 1 || n_requests < 1 || rate < 0.0 || latency < 0) {
+		fprintf (stderr, "Error: --concurrency and --requests must be positive, and --rate and --latency must not be negative.\n");
+		return 1;
+	}
+
+	/* Load the traces */
+	exchanges = g_ptr_array_new_with_free_func ((GDestroyNotify) exchange_free);
+	responses = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+	replayable = g_ptr_array_new ();
+
+	if (argc > 1) {
+		for (i = 1; i < argc; i++) {
+			if (load_traces (argv[i], &error) == FALSE) {
+				fprintf (stderr, "Error loading traces from ‘%s’: %s\n", argv[i], error->message);
+				return 1;
+			}
+		}
+	} else {
+		const gchar *srcdir = g_getenv ("G_TEST_SRCDIR");
+		gchar *traces_path = g_build_filename ((srcdir != NULL) ? srcdir : ".", "traces", NULL);
+
+		if (load_traces (traces_path, &error) == FALSE) {
+			fprintf (stderr, "Error loading traces from ‘%s’: %s\n", traces_path, error->message);
+			return 1;
+		}
+
+		g_free (traces_path);
+	}
+
+	if (replayable->len == 0) {
+		fprintf (stderr, "Error: No replayable requests found in the traces.\n");
+		return 1;
+	}
+
+	printf ("Loaded %u exchanges, of which %u are replayable.\n", exchanges->len, replayable->len);
+
+	/* The mock server's certificate is self-signed */
+	g_setenv ("LIBGDATA_LAX_SSL_CERTIFICATES", "1", FALSE);
+
+	/* Start the server */
+	server_context = g_main_context_new ();
+	loop = g_main_loop_new (server_context, FALSE);
+	server = soup_server_new (NULL, NULL);
+
+	cert_path = g_build_filename ((g_getenv ("G_TEST_SRCDIR") != NULL) ? g_getenv ("G_TEST_SRCDIR") : ".", "cert.pem", NULL);
+	key_path = g_build_filename ((g_getenv ("G_TEST_SRCDIR") != NULL) ? g_getenv ("G_TEST_SRCDIR") : ".", "key.pem", NULL);
+	if (soup_server_set_ssl_cert_file (server, cert_path, key_path, &error) == FALSE) {
+		fprintf (stderr, "Error loading the server certificate: %s\n", error->message);
+		return 1;
+	}
+	g_free (key_path);
+	g_free (cert_path);
+
+	soup_server_add_handler (server, NULL, server_handler_cb, NULL, NULL);
+
+	g_main_context_push_thread_default (server_context);
+	if (soup_server_listen_local (server, 0  /* random port */, SOUP_SERVER_LISTEN_HTTPS | SOUP_SERVER_LISTEN_IPV4_ONLY, &error) == FALSE) {
+		fprintf (stderr, "Error starting the server: %s\n", error->message);
+		return 1;
+	}
+	g_main_context_pop_thread_default (server_context);
+
+	uris = soup_server_get_uris (server);
+	load.port = soup_uri_get_port (uris->data);
+	g_slist_free_full (uris, (GDestroyNotify) soup_uri_free);
+
+	port_string = g_strdup_printf ("%u", load.port);
+	g_setenv ("LIBGDATA_HTTPS_PORT", port_string, TRUE);
+	g_free (port_string);
+
+	server_thread = g_thread_new ("server-thread", (GThreadFunc) run_server_thread, loop);
+
+	/* Create one service of each type, shared between all the client threads */
+	for (i = 0; i < (gint) G_N_ELEMENTS (services); i++)
+		domains = g_list_prepend (domains, services[i].get_authorization_domain ());
+	authorizer = gdata_dummy_authorizer_new_for_authorization_domains (domains);
+	g_list_free (domains);
+
+	for (i = 0; i < (gint) G_N_ELEMENTS (services); i++) {
+		services[i].service = g_object_new (services[i].get_service_type (),
+		                                    "authorizer", authorizer,
+		                                    "max-connections-per-host", (guint) concurrency,
+		                                    NULL);
+	}
+
+	g_object_unref (authorizer);
+
+	/* Run the clients */
+	threads = g_new (GThread*, concurrency);
+	clients = g_new (ClientData, concurrency);
+
+	load.start_time = g_get_monotonic_time ();
+
+	for (i = 0; i < concurrency; i++) {
+		clients[i].load = &load;
+		clients[i].latencies = g_array_new (FALSE, FALSE, sizeof (gint64));
+		threads[i] = g_thread_new ("client-thread", (GThreadFunc) client_thread, &clients[i]);
+	}
+
+	latencies = g_array_new (FALSE, FALSE, sizeof (gint64));
+
+	for (i = 0; i < concurrency; i++) {
+		g_thread_join (threads[i]);
+		g_array_append_vals (latencies, clients[i].latencies->data, clients[i].latencies->len);
+		g_array_unref (clients[i].latencies);
+	}
+
+	total_time = MAX (g_get_monotonic_time () - load.start_time, 1);
+	requests_per_second = (gdouble) latencies->len * G_USEC_PER_SEC / (gdouble) total_time;
+
+	g_free (clients);
+	g_free (threads);
+
+	/* Report the results */
+	g_array_sort (latencies, compare_latencies);
+
+	printf ("%u requests from %d thread(s) (%d failed) took %.4fs: %.1f requests per second\n"
+	        "Latency: p50 %.2fms, p90 %.2fms, p99 %.2fms, p99.9 %.2fms, max %.2fms\n",
+	        latencies->len, concurrency, load.n_errors, (gdouble) total_time / (gdouble) G_USEC_PER_SEC, requests_per_second,
+	        get_percentile (latencies, 50.0) / 1000.0, get_percentile (latencies, 90.0) / 1000.0, get_percentile (latencies, 99.0) / 1000.0,
+	        get_percentile (latencies, 99.9) / 1000.0, get_percentile (latencies, 100.0) / 1000.0);
+
+	{
+		gchar buf[G_ASCII_DTOSTR_BUF_SIZE];
+
+		printf ("# LOAD {\"concurrency\": %d, \"requests\": %u, \"errors\": %d, \"total_us\": %" G_GINT64_FORMAT ", ",
+		        concurrency, latencies->len, load.n_errors, total_time);
+		printf ("\"requests_per_second\": %s, ", g_ascii_dtostr (buf, sizeof (buf), requests_per_second));
+		printf ("\"latency_us\": {\"p50\": %" G_GINT64_FORMAT ", \"p90\": %" G_GINT64_FORMAT ", \"p99\": %" G_GINT64_FORMAT ", "
+		        "\"p999\": %" G_GINT64_FORMAT ", \"max\": %" G_GINT64_FORMAT "}}\n",
+		        get_percentile (latencies, 50.0), get_percentile (latencies, 90.0), get_percentile (latencies, 99.0),
+		        get_percentile (latencies, 99.9), get_percentile (latencies, 100.0));
+	}
+
+	g_array_unref (latencies);
+
+	/* Clean up */
+	for (i = 0; i < (gint) G_N_ELEMENTS (services); i++)
+		g_clear_object (&services[i].service);
+
+	soup_add_completion (server_context, (GSourceFunc) quit_server_cb, loop);
+	g_thread_join (server_thread);
+
+	g_object_unref (server);
+	g_main_loop_unref (loop);
+	g_main_context_unref (server_context);
+
+	g_ptr_array_unref (replayable);
+	g_hash_table_unref (responses);
+	g_ptr_array_unref (exchanges);
+
+	return (load.n_errors > 0) ? 1 : 0;
+}
+#else /* if !HAVE_LIBSOUP_2_55_90 */
+int
+main (int argc, char *argv[])
+{
+	fprintf (stderr, "Error: The load generator requires libsoup 2.55.90 or later.\n");
+
+	return 1;
+}
+#endif /* !HAVE_LIBSOUP_2_55_90 */
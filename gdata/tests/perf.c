@@ -1,7 +1,7 @@
 /* -*- Mode: C; indent-tabs-mode: t; c-basic-offset: 8; tab-width: 8 -*- */
 /*
  * GData Client
- * Copyright (C) Philip Withnall 2010, 2015 <philip@tecnocode.co.uk>
+ * Copyright (C) Philip Withnall 2010, 2015, 2017 <philip@tecnocode.co.uk>
  *
  * GData Client is free software; you can redistribute it and/or
  * modify it under the terms of the GNU Lesser General Public
@@ -17,8 +17,34 @@
  * License along with GData Client.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+/*
+ * Benchmarks. Besides the human-readable output, every benchmark prints one line of the form:
+ *   # BENCHMARK {"name": "contacts/parse-xml", "entries": 1000, ...}
+ * containing a JSON object, so that scripts can collect and compare results between runs. The fields are:
+ *  • name: the benchmark's name, of the form ‘service/operation’
+ *  • entries: the number of entries (or URIs) processed, or null if the benchmark isn't entry-based
+ *  • bytes: the number of payload bytes transferred, or null if the benchmark doesn't transfer payloads
+ *  • operations: the number of operations timed
+ *  • total_us: the total time taken, in microseconds
+ *  • ops_per_second: operations per second
+ *  • ns_per_entry: nanoseconds per entry, or null
+ *  • mib_per_second: payload throughput, or null
+ *  • objects_built: the number of #GDataParsables constructed while parsing, as reported by #GDataParseStatistics; this is used as a
+ *    portable proxy for allocations, since each one owns most of the memory allocated for its part of the document
+ *  • peak_rss_kib: the peak resident set size of the whole test process so far, or null if unknown
+ *
+ * The generated feeds have 1000 entries by default, to keep `make check` fast. Run with `-m perf` or `-m slow` to also benchmark 10000 and
+ * 100000 entry feeds.
+ */
+
+#include "config.h"
+
 #include <glib.h>
 #include <stdio.h>
+#include <string.h>
+#ifdef G_OS_UNIX
+#include <sys/resource.h>
+#endif
 
 #include "gdata.h"
 #include "common.h"
@@ -107,12 +133,1120 @@ test_perf_parsing (void)
 	g_assert_cmpuint (per_iteration_time, <, 2000);  /* 2ms */
 }
 
+/* Entry counts for the generated feeds, in increasing order so that the peak RSS reported for each is meaningful. */
+static const guint feed_sizes[] = { 1000, 10000, 100000 };
+
+static guint
+get_n_feed_sizes (void)
+{
+	return (g_test_perf () || g_test_slow ()) ? G_N_ELEMENTS (feed_sizes) : 1;
+}
+
+/* Peak resident set size of the process so far, in KiB, or -1 if it can't be determined. */
+static glong
+get_peak_rss (void)
+{
+#ifdef G_OS_UNIX
+	struct rusage usage;
+
+	if (getrusage (RUSAGE_SELF, &usage) == 0)
+		return usage.ru_maxrss;
+#endif /* G_OS_UNIX */
+
+	return -1;
+}
+
+/* Print a benchmark result, both for humans and as a machine-readable ‘# BENCHMARK’ line; see the comment at the top of the file. Pass 0 for
+ * @n_entries or @n_bytes if they don't apply. */
+static void
+report_benchmark (const gchar *name, guint n_entries, guint64 n_bytes, guint n_operations, gint64 total_time, guint objects_built)
+{
+	GString *result;
+	gchar buf[G_ASCII_DTOSTR_BUF_SIZE];
+	gdouble ops_per_second;
+	glong peak_rss;
+
+	/* Guard against timer granularity for very quick runs */
+	total_time = MAX (total_time, 1);
+	ops_per_second = (gdouble) n_operations * G_USEC_PER_SEC / (gdouble) total_time;
+	peak_rss = get_peak_rss ();
+
+	/* Prefix with hashes to avoid the output being misinterpreted as TAP
+	 * commands. */
+	printf ("# %s: %u operation(s) took %.4fs: %.1f operations per second", name, n_operations,
+	        (gdouble) total_time / (gdouble) G_USEC_PER_SEC, ops_per_second);
+	if (n_entries > 0)
+		printf (", %.1fns per entry", (gdouble) total_time * 1000.0 / (gdouble) n_entries);
+	if (n_bytes > 0)
+		printf (", %.2fMiB/s", (gdouble) n_bytes * G_USEC_PER_SEC / (gdouble) total_time / (1024.0 * 1024.0));
+	printf ("\n");
+
+	result = g_string_new ("# BENCHMARK {");
+	g_string_append_printf (result, "\"name\": \"%s\", ", name);
+
+	if (n_entries > 0)
+		g_string_append_printf (result, "\"entries\": %u, ", n_entries);
+	else
+		g_string_append (result, "\"entries\": null, ");
+
+	if (n_bytes > 0)
+		g_string_append_printf (result, "\"bytes\": %" G_GUINT64_FORMAT ", ", n_bytes);
+	else
+		g_string_append (result, "\"bytes\": null, ");
+
+	g_string_append_printf (result, "\"operations\": %u, \"total_us\": %" G_GINT64_FORMAT ", ", n_operations, total_time);
+
+	/* Use g_ascii_dtostr() to always get a ‘.’ as the decimal separator, as JSON requires */
+	g_string_append_printf (result, "\"ops_per_second\": %s, ", g_ascii_dtostr (buf, sizeof (buf), ops_per_second));
+
+	if (n_entries > 0) {
+		g_string_append_printf (result, "\"ns_per_entry\": %s, ",
+		                        g_ascii_dtostr (buf, sizeof (buf), (gdouble) total_time * 1000.0 / (gdouble) n_entries));
+	} else {
+		g_string_append (result, "\"ns_per_entry\": null, ");
+	}
+
+	if (n_bytes > 0) {
+		g_string_append_printf (result, "\"mib_per_second\": %s, ",
+		                        g_ascii_dtostr (buf, sizeof (buf),
+		                                        (gdouble) n_bytes * G_USEC_PER_SEC / (gdouble) total_time / (1024.0 * 1024.0)));
+	} else {
+		g_string_append (result, "\"mib_per_second\": null, ");
+	}
+
+	g_string_append_printf (result, "\"objects_built\": %u, ", objects_built);
+
+	if (peak_rss >= 0)
+		g_string_append_printf (result, "\"peak_rss_kib\": %ld}", peak_rss);
+	else
+		g_string_append (result, "\"peak_rss_kib\": null}");
+
+	printf ("%s\n", result->str);
+	g_string_free (result, TRUE);
+
+	g_test_maximized_result (ops_per_second, "%s: %.1f operations per second", name, ops_per_second);
+}
+
+static void
+test_perf_query_uri (void)
+{
+	const struct {
+		const gchar *name;
+		const gchar *feed_uri;
+		GDataQuery *query;
+	} queries[] = {
+		{ "contacts", "https://www.google.com/m8/feeds/contacts/default/full", GDATA_QUERY (gdata_contacts_query_new ("search terms")) },
+		{ "calendar", "https://www.googleapis.com/calendar/v3/calendars/primary/events",
+		  GDATA_QUERY (gdata_calendar_query_new ("search terms")) },
+		{ "youtube", "https://www.googleapis.com/youtube/v3/search", GDATA_QUERY (gdata_youtube_query_new ("search terms")) },
+		{ "documents", "https://www.googleapis.com/drive/v2/files", GDATA_QUERY (gdata_documents_query_new ("search terms")) },
+		{ "picasaweb", "https://picasaweb.google.com/data/feed/api/user/default", GDATA_QUERY (gdata_picasaweb_query_new ("search terms")) },
+	};
+	guint i, j;
+
+	/* Set some typical properties on each query */
+	gdata_contacts_query_set_order_by (GDATA_CONTACTS_QUERY (queries[0].query), "lastmodified");
+	gdata_contacts_query_set_show_deleted (GDATA_CONTACTS_QUERY (queries[0].query), TRUE);
+	gdata_contacts_query_set_group (GDATA_CONTACTS_QUERY (queries[0].query),
+	                                "http://www.google.com/m8/feeds/groups/bench%40example.com/base/6");
+
+	gdata_calendar_query_set_single_events (GDATA_CALENDAR_QUERY (queries[1].query), TRUE);
+	gdata_calendar_query_set_order_by (GDATA_CALENDAR_QUERY (queries[1].query), "startTime");
+	gdata_calendar_query_set_start_min (GDATA_CALENDAR_QUERY (queries[1].query), 1488731182);
+	gdata_calendar_query_set_timezone (GDATA_CALENDAR_QUERY (queries[1].query), "Europe/London");
+
+	gdata_youtube_query_set_order_by (GDATA_YOUTUBE_QUERY (queries[2].query), "relevance");
+	gdata_youtube_query_set_safe_search (GDATA_YOUTUBE_QUERY (queries[2].query), GDATA_YOUTUBE_SAFE_SEARCH_STRICT);
+	gdata_youtube_query_set_location (GDATA_YOUTUBE_QUERY (queries[2].query), 51.5, -0.1, 1000.0, TRUE);
+
+	gdata_documents_query_set_show_folders (GDATA_DOCUMENTS_QUERY (queries[3].query), TRUE);
+	gdata_documents_query_set_title (GDATA_DOCUMENTS_QUERY (queries[3].query), "Title & stuff", TRUE);
+
+	gdata_picasaweb_query_set_image_size (GDATA_PICASAWEB_QUERY (queries[4].query), "1600");
+	gdata_picasaweb_query_set_thumbnail_size (GDATA_PICASAWEB_QUERY (queries[4].query), "72");
+	gdata_picasaweb_query_set_tag (GDATA_PICASAWEB_QUERY (queries[4].query), "holiday");
+
+	for (i = 0; i < G_N_ELEMENTS (queries); i++) {
+		gdata_query_set_updated_min (queries[i].query, 1488731182);
+		gdata_query_set_max_results (queries[i].query, 50);
+
+		for (j = 0; j < get_n_feed_sizes (); j++) {
+			guint n_uris = feed_sizes[j], k;
+			gint64 start_time, total_time;
+			gchar *name;
+
+			start_time = g_get_monotonic_time ();
+
+			/* Page through the results, as a client would */
+			for (k = 0; k < n_uris; k++) {
+				gchar *query_uri;
+
+				gdata_query_set_start_index (queries[i].query, k * 50 + 1);
+				query_uri = gdata_query_get_query_uri (queries[i].query, queries[i].feed_uri);
+				g_assert (g_str_has_prefix (query_uri, queries[i].feed_uri));
+				g_free (query_uri);
+			}
+
+			total_time = g_get_monotonic_time () - start_time;
+
+			name = g_strdup_printf ("%s/query-uri", queries[i].name);
+			report_benchmark (name, n_uris, 0, n_uris, total_time, 0);
+			g_free (name);
+		}
+
+		g_object_unref (queries[i].query);
+	}
+}
+
+#ifdef HAVE_LIBSOUP_2_55_90
+/* Feed generators. Each entry is reasonably representative of what the real service returns, so that the benchmarks exercise the same parsing
+ * paths as real responses; the index @i is used to make each entry distinct. */
+#define BENCHMARK_TIMESTAMP "2017-03-05T16:19:42.000Z"
+
+static void
+append_contacts_feed_header (GString *xml, const gchar *title, guint n_entries)
+{
+	g_string_append_printf (xml,
+		"<?xml version='1.0' encoding='UTF-8'?>"
+		"<feed xmlns='http://www.w3.org/2005/Atom' "
+		      "xmlns:openSearch='http://a9.com/-/spec/opensearch/1.1/' "
+		      "xmlns:app='http://www.w3.org/2007/app' "
+		      "xmlns:gContact='http://schemas.google.com/contact/2008' "
+		      "xmlns:batch='http://schemas.google.com/gdata/batch' "
+		      "xmlns:gd='http://schemas.google.com/g/2005' "
+		      "gd:etag='W/\"CUMBRHo_fip7I2A9WhJQF0k.\"'>"
+			"<id>bench@example.com</id>"
+			"<updated>" BENCHMARK_TIMESTAMP "</updated>"
+			"<category scheme='http://schemas.google.com/g/2005#kind' term='http://schemas.google.com/contact/2008#contact'/>"
+			"<title>%s</title>"
+			"<openSearch:totalResults>%u</openSearch:totalResults>"
+			"<openSearch:startIndex>1</openSearch:startIndex>"
+			"<openSearch:itemsPerPage>%u</openSearch:itemsPerPage>",
+		title, n_entries, n_entries);
+}
+
+/* If @batch_id is non-%NULL, the entry is formatted as the successful result of a batch insertion. */
+static void
+append_contact_entry (GString *xml, guint i, const gchar *batch_id)
+{
+	g_string_append (xml, "<entry gd:etag='\"Q3w7ezVSLit7I2A9WxNbGUkLQQ0.\"'>");
+
+	if (batch_id != NULL) {
+		g_string_append_printf (xml,
+			"<batch:id>%s</batch:id>"
+			"<batch:operation type='insert'/>"
+			"<batch:status code='201' reason='Created.'/>",
+			batch_id);
+	}
+
+	g_string_append_printf (xml,
+		"<id>http://www.google.com/m8/feeds/contacts/bench%%40example.com/base/%x</id>"
+		"<updated>" BENCHMARK_TIMESTAMP "</updated>"
+		"<app:edited>" BENCHMARK_TIMESTAMP "</app:edited>"
+		"<category scheme='http://schemas.google.com/g/2005#kind' term='http://schemas.google.com/contact/2008#contact'/>"
+		"<title>Contact %u</title>"
+		"<link rel='http://schemas.google.com/contacts/2008/rel#photo' type='image/*' "
+		      "href='https://www.google.com/m8/feeds/photos/media/bench%%40example.com/%x'/>"
+		"<link rel='self' type='application/atom+xml' href='https://www.google.com/m8/feeds/contacts/bench%%40example.com/full/%x'/>"
+		"<link rel='edit' type='application/atom+xml' href='https://www.google.com/m8/feeds/contacts/bench%%40example.com/full/%x'/>"
+		"<gd:name>"
+			"<gd:fullName>Contact %u</gd:fullName>"
+			"<gd:givenName>Contact</gd:givenName>"
+			"<gd:familyName>%u</gd:familyName>"
+		"</gd:name>"
+		"<gd:email rel='http://schemas.google.com/g/2005#home' address='contact%u@example.com' primary='true'/>"
+		"<gd:email rel='http://schemas.google.com/g/2005#work' address='contact%u@work.example.com'/>"
+		"<gd:phoneNumber rel='http://schemas.google.com/g/2005#mobile'>+1 555 %07u</gd:phoneNumber>"
+		"<gd:structuredPostalAddress rel='http://schemas.google.com/g/2005#work'>"
+			"<gd:street>%u Main Street</gd:street>"
+			"<gd:city>Springfield</gd:city>"
+			"<gd:country>United States</gd:country>"
+		"</gd:structuredPostalAddress>"
+		"<gContact:groupMembershipInfo deleted='false' href='http://www.google.com/m8/feeds/groups/bench%%40example.com/base/6'/>"
+		"</entry>",
+		i, i, i, i, i, i, i, i, i, i, i);
+}
+
+static GString *
+generate_contacts_feed (guint n_entries)
+{
+	GString *xml;
+	guint i;
+
+	xml = g_string_new (NULL);
+	append_contacts_feed_header (xml, "Benchmark's Contacts", n_entries);
+
+	for (i = 0; i < n_entries; i++)
+		append_contact_entry (xml, i, NULL);
+
+	g_string_append (xml, "</feed>");
+
+	return xml;
+}
+
+static GString *
+generate_calendar_feed (guint n_entries)
+{
+	GString *json;
+	guint i;
+
+	json = g_string_new (
+		"{"
+			"\"kind\": \"calendar#events\","
+			"\"etag\": \"\\\"p32c9v4ra4qmd80g\\\"\","
+			"\"summary\": \"Benchmark\","
+			"\"updated\": \"" BENCHMARK_TIMESTAMP "\","
+			"\"timeZone\": \"UTC\","
+			"\"accessRole\": \"owner\","
+			"\"items\": [");
+
+	for (i = 0; i < n_entries; i++) {
+		guint day = i % 28 + 1;
+
+		g_string_append_printf (json,
+			"%s{"
+				"\"kind\": \"calendar#event\","
+				"\"etag\": \"\\\"2966698113412000\\\"\","
+				"\"id\": \"bench%08x\","
+				"\"status\": \"confirmed\","
+				"\"htmlLink\": \"https://www.google.com/calendar/event?eid=bench%08x\","
+				"\"created\": \"" BENCHMARK_TIMESTAMP "\","
+				"\"updated\": \"" BENCHMARK_TIMESTAMP "\","
+				"\"summary\": \"Event %u\","
+				"\"description\": \"Benchmark event number %u.\","
+				"\"location\": \"Room %u\","
+				"\"creator\": {\"email\": \"bench@example.com\", \"displayName\": \"Benchmark\", \"self\": true},"
+				"\"organizer\": {\"email\": \"bench@example.com\", \"displayName\": \"Benchmark\", \"self\": true},"
+				"\"start\": {\"dateTime\": \"2017-03-%02uT09:00:00Z\", \"timeZone\": \"UTC\"},"
+				"\"end\": {\"dateTime\": \"2017-03-%02uT10:00:00Z\", \"timeZone\": \"UTC\"},"
+				"\"iCalUID\": \"bench%08x@google.com\","
+				"\"sequence\": 0,"
+				"\"attendees\": ["
+					"{\"email\": \"bench@example.com\", \"displayName\": \"Benchmark\", \"organizer\": true, \"self\": true,"
+					" \"responseStatus\": \"accepted\"},"
+					"{\"email\": \"guest%u@example.com\", \"responseStatus\": \"needsAction\"}"
+				"],"
+				"\"reminders\": {\"useDefault\": true}"
+			"}",
+			(i > 0) ? "," : "", i, i, i, i, i, day, day, i, i);
+	}
+
+	g_string_append (json, "]}");
+
+	return json;
+}
+
+static GString *
+generate_youtube_feed (guint n_entries)
+{
+	GString *json;
+	guint i;
+
+	json = g_string_new (NULL);
+	g_string_append_printf (json,
+		"{"
+			"\"kind\": \"youtube#videoListResponse\","
+			"\"etag\": \"\\\"tbWC5XrSXxe1WOAx6MK9z4hHSU8/yL2v1Y0YI1sDfr9wCT8WKkSHqME\\\"\","
+			"\"pageInfo\": {\"totalResults\": %u, \"resultsPerPage\": %u},"
+			"\"items\": [",
+		n_entries, n_entries);
+
+	for (i = 0; i < n_entries; i++) {
+		g_string_append_printf (json,
+			"%s{"
+				"\"kind\": \"youtube#video\","
+				"\"etag\": \"\\\"tbWC5XrSXxe1WOAx6MK9z4hHSU8/X_byq2BdOVgHzCA-ScpZbTWmgfQ\\\"\","
+				"\"id\": \"bench%07u\","
+				"\"snippet\": {"
+					"\"publishedAt\": \"" BENCHMARK_TIMESTAMP "\","
+					"\"channelId\": \"UCCS6UQvicRHyn1whEUDEMUQ\","
+					"\"title\": \"Video %u\","
+					"\"description\": \"Benchmark video number %u.\","
+					"\"thumbnails\": {"
+						"\"default\": {\"url\": \"https://i.ytimg.com/vi/bench%07u/default.jpg\", \"width\": 120, \"height\": 90},"
+						"\"medium\": {\"url\": \"https://i.ytimg.com/vi/bench%07u/mqdefault.jpg\", \"width\": 320, \"height\": 180},"
+						"\"high\": {\"url\": \"https://i.ytimg.com/vi/bench%07u/hqdefault.jpg\", \"width\": 480, \"height\": 360}"
+					"},"
+					"\"channelTitle\": \"Benchmark\","
+					"\"tags\": [\"benchmark\", \"video\", \"tag%u\"],"
+					"\"categoryId\": \"10\","
+					"\"liveBroadcastContent\": \"none\""
+				"},"
+				"\"contentDetails\": {"
+					"\"duration\": \"PT%uM%uS\","
+					"\"dimension\": \"2d\","
+					"\"definition\": \"hd\","
+					"\"caption\": \"false\","
+					"\"licensedContent\": false"
+				"},"
+				"\"status\": {"
+					"\"uploadStatus\": \"processed\","
+					"\"privacyStatus\": \"public\","
+					"\"license\": \"youtube\","
+					"\"embeddable\": true,"
+					"\"publicStatsViewable\": true"
+				"},"
+				"\"statistics\": {"
+					"\"viewCount\": \"%u\","
+					"\"likeCount\": \"%u\","
+					"\"dislikeCount\": \"%u\","
+					"\"favoriteCount\": \"0\","
+					"\"commentCount\": \"%u\""
+				"}"
+			"}",
+			(i > 0) ? "," : "", i, i, i, i, i, i, i, i % 60, i % 59, i * 7, i * 3, i % 100, i % 50);
+	}
+
+	g_string_append (json, "]}");
+
+	return json;
+}
+
+static GString *
+generate_documents_feed (guint n_entries)
+{
+	/* Cycle through the main entry types, which GDataDocumentsFeed picks between using the MIME type */
+	const gchar *mime_types[] = {
+		"application/vnd.google-apps.document",
+		"application/vnd.google-apps.spreadsheet",
+		"application/vnd.google-apps.presentation",
+		"application/pdf",
+		"application/vnd.google-apps.folder",
+	};
+	GString *json;
+	guint i;
+
+	json = g_string_new (
+		"{"
+			"\"kind\": \"drive#fileList\","
+			"\"etag\": \"\\\"Q3w7ezVSLit7I2A9WxNbGUkLQQ0/MTQ4ODczMTE4MjAwMA\\\"\","
+			"\"selfLink\": \"https://www.googleapis.com/drive/v2/files\","
+			"\"items\": [");
+
+	for (i = 0; i < n_entries; i++) {
+		g_string_append_printf (json,
+			"%s{"
+				"\"kind\": \"drive#file\","
+				"\"id\": \"bench%08x\","
+				"\"etag\": \"\\\"Q3w7ezVSLit7I2A9WxNbGUkLQQ0/MTQ4ODczMTE4MjAwMA\\\"\","
+				"\"selfLink\": \"https://www.googleapis.com/drive/v2/files/bench%08x\","
+				"\"alternateLink\": \"https://docs.google.com/document/d/bench%08x/edit\","
+				"\"title\": \"File %u\","
+				"\"mimeType\": \"%s\","
+				"\"labels\": {\"starred\": false, \"hidden\": false, \"trashed\": false, \"restricted\": false, \"viewed\": true},"
+				"\"createdDate\": \"" BENCHMARK_TIMESTAMP "\","
+				"\"modifiedDate\": \"" BENCHMARK_TIMESTAMP "\","
+				"\"lastViewedByMeDate\": \"" BENCHMARK_TIMESTAMP "\","
+				"\"parents\": [{"
+					"\"kind\": \"drive#parentReference\","
+					"\"id\": \"root\","
+					"\"selfLink\": \"https://www.googleapis.com/drive/v2/files/bench%08x/parents/root\","
+					"\"parentLink\": \"https://www.googleapis.com/drive/v2/files/root\","
+					"\"isRoot\": true"
+				"}],"
+				"\"owners\": [{\"kind\": \"drive#user\", \"displayName\": \"Benchmark\", \"emailAddress\": \"bench@example.com\"}],"
+				"\"quotaBytesUsed\": \"%u\","
+				"\"shared\": false"
+			"}",
+			(i > 0) ? "," : "", i, i, i, i, mime_types[i % G_N_ELEMENTS (mime_types)], i, i * 1024);
+	}
+
+	g_string_append (json, "]}");
+
+	return json;
+}
+
+static GString *
+generate_picasaweb_feed (guint n_entries)
+{
+	GString *xml;
+	guint i;
+
+	xml = g_string_new (NULL);
+	g_string_append_printf (xml,
+		"<?xml version='1.0' encoding='UTF-8'?>"
+		"<feed xmlns='http://www.w3.org/2005/Atom' "
+		      "xmlns:exif='http://schemas.google.com/photos/exif/2007' "
+		      "xmlns:app='http://www.w3.org/2007/app' "
+		      "xmlns:gphoto='http://schemas.google.com/photos/2007' "
+		      "xmlns:media='http://search.yahoo.com/mrss/' "
+		      "xmlns:openSearch='http://a9.com/-/spec/opensearch/1.1/' "
+		      "xmlns:gd='http://schemas.google.com/g/2005'>"
+			"<id>https://picasaweb.google.com/data/feed/user/bench/albumid/1</id>"
+			"<updated>" BENCHMARK_TIMESTAMP "</updated>"
+			"<category scheme='http://schemas.google.com/g/2005#kind' term='http://schemas.google.com/photos/2007#album'/>"
+			"<title>Benchmark album</title>"
+			"<openSearch:totalResults>%u</openSearch:totalResults>"
+			"<openSearch:startIndex>1</openSearch:startIndex>"
+			"<openSearch:itemsPerPage>%u</openSearch:itemsPerPage>",
+		n_entries, n_entries);
+
+	for (i = 0; i < n_entries; i++) {
+		g_string_append_printf (xml,
+			"<entry>"
+				"<id>https://picasaweb.google.com/data/entry/user/bench/albumid/1/photoid/%u</id>"
+				"<published>" BENCHMARK_TIMESTAMP "</published>"
+				"<updated>" BENCHMARK_TIMESTAMP "</updated>"
+				"<app:edited>" BENCHMARK_TIMESTAMP "</app:edited>"
+				"<category scheme='http://schemas.google.com/g/2005#kind' term='http://schemas.google.com/photos/2007#photo'/>"
+				"<title type='text'>Photo %u.jpg</title>"
+				"<summary type='text'>Benchmark photo number %u.</summary>"
+				"<content type='image/jpeg' src='https://lh3.googleusercontent.com/bench/%u.jpg'/>"
+				"<link rel='edit' type='application/atom+xml' "
+				      "href='https://picasaweb.google.com/data/entry/api/user/bench/albumid/1/photoid/%u'/>"
+				"<gphoto:id>%u</gphoto:id>"
+				"<gphoto:albumid>1</gphoto:albumid>"
+				"<gphoto:access>public</gphoto:access>"
+				"<gphoto:width>4000</gphoto:width>"
+				"<gphoto:height>3000</gphoto:height>"
+				"<gphoto:size>%u</gphoto:size>"
+				"<gphoto:timestamp>1488731182000</gphoto:timestamp>"
+				"<gphoto:imageVersion>1</gphoto:imageVersion>"
+				"<gphoto:commentingEnabled>true</gphoto:commentingEnabled>"
+				"<gphoto:commentCount>0</gphoto:commentCount>"
+				"<exif:tags>"
+					"<exif:fstop>2.8</exif:fstop>"
+					"<exif:make>Canon</exif:make>"
+					"<exif:model>Canon EOS 5D</exif:model>"
+					"<exif:exposure>0.008</exif:exposure>"
+					"<exif:flash>false</exif:flash>"
+					"<exif:focallength>50.0</exif:focallength>"
+					"<exif:iso>100</exif:iso>"
+					"<exif:time>1488731182000</exif:time>"
+					"<exif:imageUniqueID>%032x</exif:imageUniqueID>"
+				"</exif:tags>"
+				"<media:group>"
+					"<media:content url='https://lh3.googleusercontent.com/bench/%u.jpg' height='3000' width='4000' "
+					               "type='image/jpeg' medium='image'/>"
+					"<media:credit>Benchmark</media:credit>"
+					"<media:description type='plain'>Benchmark photo number %u.</media:description>"
+					"<media:keywords>benchmark, photo</media:keywords>"
+					"<media:thumbnail url='https://lh3.googleusercontent.com/bench/s72/%u.jpg' height='54' width='72'/>"
+					"<media:title type='plain'>Photo %u.jpg</media:title>"
+				"</media:group>"
+			"</entry>",
+			i, i, i, i, i, i, 2000000 + i, i, i, i, i, i);
+	}
+
+	g_string_append (xml, "</feed>");
+
+	return xml;
+}
+
+/* A local HTTPS server, run in its own thread, which serves canned responses by path, echoes batch requests, and accepts uploads. */
+typedef struct {
+	GMainContext *context;
+	GMainLoop *loop;
+	SoupServer *server;
+	GThread *thread;
+	gchar *uri;  /* base URI, without a trailing slash */
+	guint latency;  /* milliseconds */
+
+	GMutex mutex;
+	GHashTable/*<owned utf8, owned MockResponse>*/ *responses;  /* protected by mutex */
+} MockServer;
+
+typedef struct {
+	gchar *content_type;
+	GBytes *body;
+} MockResponse;
+
+static void
+mock_response_free (MockResponse *response)
+{
+	g_free (response->content_type);
+	g_bytes_unref (response->body);
+	g_slice_free (MockResponse, response);
+}
+
+static gboolean
+unpause_message_cb (gpointer user_data)
+{
+	gpointer *data = user_data;
+
+	soup_server_unpause_message (data[0], data[1]);
+	g_object_unref (data[1]);
+	g_free (data);
+
+	return G_SOURCE_REMOVE;
+}
+
+/* Reply to a batch request as if every operation in it were a successful contact insertion. */
+static void
+mock_server_handle_batch (SoupMessage *message)
+{
+	SoupBuffer *request;
+	GRegex *regex;
+	GMatchInfo *match_info;
+	GString *response;
+
+	request = soup_message_body_flatten (message->request_body);
+	regex = g_regex_new ("<batch:id>(\\d+)</batch:id>", 0, 0, NULL);
+
+	response = g_string_new (NULL);
+	append_contacts_feed_header (response, "Batch operation feed", 0);
+
+	g_regex_match_full (regex, request->data, request->length, 0, 0, &match_info, NULL);
+	while (g_match_info_matches (match_info) == TRUE) {
+		gchar *batch_id = g_match_info_fetch (match_info, 1);
+
+		append_contact_entry (response, g_ascii_strtoull (batch_id, NULL, 10), batch_id);
+		g_free (batch_id);
+
+		g_match_info_next (match_info, NULL);
+	}
+
+	g_string_append (response, "</feed>");
+
+	g_match_info_free (match_info);
+	g_regex_unref (regex);
+	soup_buffer_free (request);
+
+	soup_message_set_status (message, SOUP_STATUS_OK);
+	soup_message_set_response (message, "application/atom+xml", SOUP_MEMORY_TAKE, response->str, response->len);
+	g_string_free (response, FALSE);
+}
+
+static void
+mock_server_handler_cb (SoupServer *soup_server, SoupMessage *message, const char *path, GHashTable *query, SoupClientContext *client,
+                        gpointer user_data)
+{
+	MockServer *server = user_data;
+
+	if (message->method == SOUP_METHOD_POST && g_str_has_suffix (path, "/batch") == TRUE) {
+		mock_server_handle_batch (message);
+	} else if (message->method == SOUP_METHOD_POST) {
+		/* Upload sink; the body has already been received, so there's nothing more to do */
+		soup_message_set_status (message, SOUP_STATUS_CREATED);
+	} else {
+		MockResponse *response;
+
+		g_mutex_lock (&server->mutex);
+		response = g_hash_table_lookup (server->responses, path);
+
+		if (response != NULL) {
+			soup_message_set_status (message, SOUP_STATUS_OK);
+			soup_message_headers_set_content_type (message->response_headers, response->content_type, NULL);
+			soup_message_body_append_bytes (message->response_body, response->body);
+		} else {
+			soup_message_set_status (message, SOUP_STATUS_NOT_FOUND);
+		}
+
+		g_mutex_unlock (&server->mutex);
+	}
+
+	/* Delay the response without blocking the server's other connections */
+	if (server->latency > 0) {
+		GSource *source;
+		gpointer *data;
+
+		data = g_new (gpointer, 2);
+		data[0] = soup_server;
+		data[1] = g_object_ref (message);
+
+		soup_server_pause_message (soup_server, message);
+
+		source = g_timeout_source_new (server->latency);
+		g_source_set_callback (source, unpause_message_cb, data, NULL);
+		g_source_attach (source, g_main_context_get_thread_default ());
+		g_source_unref (source);
+	}
+}
+
+static gpointer
+run_server_thread (GMainLoop *loop)
+{
+	g_main_context_push_thread_default (g_main_loop_get_context (loop));
+	g_main_loop_run (loop);
+	g_main_context_pop_thread_default (g_main_loop_get_context (loop));
+
+	return NULL;
+}
+
+static gboolean
+quit_server_cb (GMainLoop *loop)
+{
+	g_main_loop_quit (loop);
+
+	return G_SOURCE_REMOVE;
+}
+
+/* Start a mock server which delays each response by @latency milliseconds. */
+static void
+mock_server_start (MockServer *server, guint latency)
+{
+	GSList *uris;
+	gchar *port_string, *cert_path, *key_path;
+	GError *error = NULL;
+
+	server->latency = latency;
+	g_mutex_init (&server->mutex);
+	server->responses = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) mock_response_free);
+
+	server->context = g_main_context_new ();
+	server->loop = g_main_loop_new (server->context, FALSE);
+
+	server->server = soup_server_new (NULL, NULL);
+
+	cert_path = g_test_build_filename (G_TEST_DIST, "cert.pem", NULL);
+	key_path = g_test_build_filename (G_TEST_DIST, "key.pem", NULL);
+	soup_server_set_ssl_cert_file (server->server, cert_path, key_path, &error);
+	g_assert_no_error (error);
+	g_free (key_path);
+	g_free (cert_path);
+
+	soup_server_add_handler (server->server, NULL, mock_server_handler_cb, server, NULL);
+
+	g_main_context_push_thread_default (server->context);
+	soup_server_listen_local (server->server, 0  /* random port */, SOUP_SERVER_LISTEN_HTTPS, &error);
+	g_assert_no_error (error);
+	g_main_context_pop_thread_default (server->context);
+
+	uris = soup_server_get_uris (server->server);
+	g_assert (uris != NULL);
+	server->uri = soup_uri_to_string (uris->data, FALSE);
+	if (g_str_has_suffix (server->uri, "/") == TRUE)
+		server->uri[strlen (server->uri) - 1] = '\0';
+	port_string = g_strdup_printf ("%u", soup_uri_get_port (uris->data));
+	g_setenv ("LIBGDATA_HTTPS_PORT", port_string, TRUE);
+	g_free (port_string);
+	g_slist_free_full (uris, (GDestroyNotify) soup_uri_free);
+
+	server->thread = g_thread_new ("server-thread", (GThreadFunc) run_server_thread, server->loop);
+}
+
+static void
+mock_server_stop (MockServer *server)
+{
+	soup_add_completion (server->context, (GSourceFunc) quit_server_cb, server->loop);
+	g_thread_join (server->thread);
+
+	g_free (server->uri);
+	g_object_unref (server->server);
+	g_main_loop_unref (server->loop);
+	g_main_context_unref (server->context);
+
+	g_hash_table_unref (server->responses);
+	g_mutex_clear (&server->mutex);
+}
+
+/* Serve @body (taking ownership of it) for GET requests to @path. */
+static void
+mock_server_add_response (MockServer *server, const gchar *path, const gchar *content_type, GBytes *body)
+{
+	MockResponse *response;
+
+	response = g_slice_new (MockResponse);
+	response->content_type = g_strdup (content_type);
+	response->body = body;
+
+	g_mutex_lock (&server->mutex);
+	g_hash_table_replace (server->responses, g_strdup (path), response);
+	g_mutex_unlock (&server->mutex);
+}
+
+static gchar *
+mock_server_build_uri (MockServer *server, const gchar *path)
+{
+	return g_strconcat (server->uri, path, NULL);
+}
+
+/* Keep a copy of the statistics for the most recent request. Only the numeric fields are valid once the handler has returned. */
+static void
+request_finished_cb (GDataService *service, GDataRequestStatistics *statistics, GDataRequestStatistics *last_statistics)
+{
+	*last_statistics = *statistics;
+}
+
+typedef struct {
+	const gchar *name;
+	GType (*get_service_type) (void);
+	GType (*get_entry_type) (void);
+	gboolean is_json;
+	GString *(*generate_feed) (guint n_entries);
+} FeedBenchmark;
+
+static const FeedBenchmark feed_benchmarks[] = {
+	{ "contacts", gdata_contacts_service_get_type, gdata_contacts_contact_get_type, FALSE, generate_contacts_feed },
+	{ "calendar", gdata_calendar_service_get_type, gdata_calendar_event_get_type, TRUE, generate_calendar_feed },
+	{ "youtube", gdata_youtube_service_get_type, gdata_youtube_video_get_type, TRUE, generate_youtube_feed },
+	{ "documents", gdata_documents_service_get_type, gdata_documents_entry_get_type, TRUE, generate_documents_feed },
+	{ "picasaweb", gdata_picasaweb_service_get_type, gdata_picasaweb_file_get_type, FALSE, generate_picasaweb_feed },
+};
+
+/* Query a generated feed from the mock server, then serialise all its entries again. The query is timed as a whole, and the parsing part of it
+ * is reported separately using the #GDataService::request-finished statistics. */
+static void
+test_perf_feed (gconstpointer user_data)
+{
+	const FeedBenchmark *benchmark = user_data;
+	MockServer server;
+	GDataService *service;
+	GDataRequestStatistics statistics;
+	guint i;
+
+	mock_server_start (&server, 0);
+
+	service = g_object_new (benchmark->get_service_type (), NULL);
+	g_signal_connect (service, "request-finished", (GCallback) request_finished_cb, &statistics);
+
+	for (i = 0; i < get_n_feed_sizes (); i++) {
+		guint n_entries = feed_sizes[i];
+		GString *feed_data;
+		gsize feed_length;
+		GDataFeed *feed;
+		GList *entries, *l;
+		gchar *path, *uri, *name;
+		gint64 start_time, total_time;
+		GError *error = NULL;
+
+		feed_data = benchmark->generate_feed (n_entries);
+		feed_length = feed_data->len;
+
+		path = g_strdup_printf ("/%s/%u", benchmark->name, n_entries);
+		mock_server_add_response (&server, path, benchmark->is_json ? "application/json" : "application/atom+xml",
+		                          g_string_free_to_bytes (feed_data));
+		uri = mock_server_build_uri (&server, path);
+
+		/* Query and parse */
+		memset (&statistics, 0, sizeof (statistics));
+
+		start_time = g_get_monotonic_time ();
+		feed = gdata_service_query (service, NULL, uri, NULL, benchmark->get_entry_type (), NULL, NULL, NULL, &error);
+		total_time = g_get_monotonic_time () - start_time;
+
+		g_assert_no_error (error);
+		g_assert (GDATA_IS_FEED (feed));
+
+		entries = gdata_feed_get_entries (feed);
+		g_assert_cmpuint (g_list_length (entries), ==, n_entries);
+		g_assert_cmpuint (statistics.parse_statistics.entries_built, ==, n_entries);
+
+		name = g_strdup_printf ("%s/query", benchmark->name);
+		report_benchmark (name, n_entries, feed_length, 1, total_time, statistics.parse_statistics.parsables_built);
+		g_free (name);
+
+		name = g_strdup_printf ("%s/parse-%s", benchmark->name, benchmark->is_json ? "json" : "xml");
+		report_benchmark (name, n_entries, statistics.parse_statistics.bytes_parsed, 1, statistics.parse_time,
+		                  statistics.parse_statistics.parsables_built);
+		g_free (name);
+
+		/* Serialise */
+		start_time = g_get_monotonic_time ();
+
+		for (l = entries; l != NULL; l = l->next) {
+			gchar *serialised;
+
+			if (benchmark->is_json == TRUE)
+				serialised = gdata_parsable_get_json (GDATA_PARSABLE (l->data));
+			else
+				serialised = gdata_parsable_get_xml (GDATA_PARSABLE (l->data));
+
+			g_assert (serialised != NULL && *serialised != '\0');
+			g_free (serialised);
+		}
+
+		total_time = g_get_monotonic_time () - start_time;
+
+		name = g_strdup_printf ("%s/serialise-%s", benchmark->name, benchmark->is_json ? "json" : "xml");
+		report_benchmark (name, n_entries, 0, n_entries, total_time, 0);
+		g_free (name);
+
+		g_object_unref (feed);
+		g_free (uri);
+		g_free (path);
+	}
+
+	g_object_unref (service);
+
+	mock_server_stop (&server);
+}
+
+static void
+batch_insertion_cb (guint operation_id, GDataBatchOperationType operation_type, GDataEntry *entry, GError *error, guint *n_inserted)
+{
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_CONTACTS_CONTACT (entry));
+
+	(*n_inserted)++;
+}
+
+/* Build, send and parse the response of a batch feed inserting one contact per entry. */
+static void
+test_perf_batch (void)
+{
+	MockServer server;
+	GDataContactsService *service;
+	gchar *uri;
+	guint i;
+
+	mock_server_start (&server, 0);
+
+	service = gdata_contacts_service_new (NULL);
+	uri = mock_server_build_uri (&server, "/contacts/batch");
+
+	for (i = 0; i < get_n_feed_sizes (); i++) {
+		guint n_entries = feed_sizes[i], n_inserted = 0, j;
+		GDataBatchOperation *operation;
+		GDataParseStatistics parse_statistics;
+		gint64 start_time, total_time;
+		gboolean success;
+		GError *error = NULL;
+
+		start_time = g_get_monotonic_time ();
+
+		operation = gdata_batchable_create_operation (GDATA_BATCHABLE (service), gdata_contacts_service_get_primary_authorization_domain (),
+		                                              uri);
+
+		for (j = 0; j < n_entries; j++) {
+			GDataContactsContact *contact;
+			GDataGDName *name;
+			GDataGDEmailAddress *email_address;
+			gchar *address;
+
+			contact = gdata_contacts_contact_new (NULL);
+
+			name = gdata_gd_name_new ("Contact", "Batch");
+			gdata_contacts_contact_set_name (contact, name);
+			g_object_unref (name);
+
+			address = g_strdup_printf ("contact%u@example.com", j);
+			email_address = gdata_gd_email_address_new (address, GDATA_GD_EMAIL_ADDRESS_HOME, NULL, TRUE);
+			gdata_contacts_contact_add_email_address (contact, email_address);
+			g_object_unref (email_address);
+			g_free (address);
+
+			gdata_batch_operation_add_insertion (operation, GDATA_ENTRY (contact), (GDataBatchOperationCallback) batch_insertion_cb,
+			                                     &n_inserted);
+			g_object_unref (contact);
+		}
+
+		/* The batch operation is run synchronously in this thread, so its response parsing is counted */
+		gdata_parse_statistics_start (&parse_statistics);
+		success = gdata_batch_operation_run (operation, NULL, &error);
+		gdata_parse_statistics_stop (&parse_statistics);
+
+		total_time = g_get_monotonic_time () - start_time;
+
+		g_assert_no_error (error);
+		g_assert (success == TRUE);
+		g_assert_cmpuint (n_inserted, ==, n_entries);
+
+		report_benchmark ("contacts/batch-insert", n_entries, 0, 1, total_time, parse_statistics.parsables_built);
+
+		g_object_unref (operation);
+	}
+
+	g_free (uri);
+	g_object_unref (service);
+
+	mock_server_stop (&server);
+}
+
+#define STREAM_CHUNK_SIZE 65536
+
+/* Stream sizes are scaled from the feed sizes, giving 1000KiB by default. */
+static void
+test_perf_streams (void)
+{
+	MockServer server;
+	GDataService *service;
+	guint8 *buffer;
+	guint i;
+
+	mock_server_start (&server, 0);
+
+	service = g_object_new (GDATA_TYPE_SERVICE, NULL);
+	buffer = g_malloc (STREAM_CHUNK_SIZE);
+	memset (buffer, 'x', STREAM_CHUNK_SIZE);
+
+	for (i = 0; i < get_n_feed_sizes (); i++) {
+		gsize n_bytes = (gsize) feed_sizes[i] * 1024, total_length = 0;
+		GInputStream *download_stream;
+		GOutputStream *upload_stream;
+		gchar *path, *uri;
+		gssize length;
+		gint64 start_time, total_time;
+		GError *error = NULL;
+
+		/* Download */
+		path = g_strdup_printf ("/download/%" G_GSIZE_FORMAT, n_bytes);
+		mock_server_add_response (&server, path, "application/octet-stream", g_bytes_new_take (g_malloc0 (n_bytes), n_bytes));
+		uri = mock_server_build_uri (&server, path);
+
+		start_time = g_get_monotonic_time ();
+
+		download_stream = gdata_download_stream_new (service, NULL, uri, NULL);
+
+		while ((length = g_input_stream_read (download_stream, buffer, STREAM_CHUNK_SIZE, NULL, &error)) > 0)
+			total_length += length;
+
+		g_assert_no_error (error);
+		g_input_stream_close (download_stream, NULL, &error);
+		g_assert_no_error (error);
+
+		total_time = g_get_monotonic_time () - start_time;
+
+		g_assert_cmpuint (total_length, ==, n_bytes);
+		report_benchmark ("streams/download", 0, n_bytes, 1, total_time, 0);
+
+		g_object_unref (download_stream);
+		g_free (uri);
+		g_free (path);
+
+		/* Upload */
+		uri = mock_server_build_uri (&server, "/upload");
+		memset (buffer, 'x', STREAM_CHUNK_SIZE);
+		total_length = 0;
+
+		start_time = g_get_monotonic_time ();
+
+		upload_stream = gdata_upload_stream_new (service, NULL, SOUP_METHOD_POST, uri, NULL, "slug", "application/octet-stream", NULL);
+
+		while (total_length < n_bytes) {
+			length = g_output_stream_write (upload_stream, buffer, MIN (STREAM_CHUNK_SIZE, n_bytes - total_length), NULL, &error);
+			g_assert_no_error (error);
+			g_assert_cmpint (length, >, 0);
+
+			total_length += length;
+		}
+
+		g_output_stream_close (upload_stream, NULL, &error);
+		g_assert_no_error (error);
+
+		total_time = g_get_monotonic_time () - start_time;
+
+		report_benchmark ("streams/upload", 0, n_bytes, 1, total_time, 0);
+
+		g_object_unref (upload_stream);
+		g_free (uri);
+	}
+
+	g_free (buffer);
+	g_object_unref (service);
+
+	mock_server_stop (&server);
+}
+
+/* Simulated round-trip latency of the mock server, in milliseconds. Without this, the loopback server responds so quickly that the benchmark
+ * only measures parsing, rather than how well requests overlap. */
+#define MOCK_LATENCY 10
+
+typedef struct {
+	GDataService *service;
+	const gchar *uri;
+	guint n_requests;
+} RequestThreadData;
+
+static gpointer
+request_thread (RequestThreadData *data)
+{
+	guint i;
+
+	for (i = 0; i < data->n_requests; i++) {
+		GDataFeed *feed;
+		GError *error = NULL;
+
+		feed = gdata_service_query (data->service, NULL, data->uri, NULL, GDATA_TYPE_ENTRY, NULL, NULL, NULL, &error);
+		g_assert_no_error (error);
+		g_assert (GDATA_IS_FEED (feed));
+		g_object_unref (feed);
+	}
+
+	return NULL;
+}
+
+static void
+test_perf_concurrent_requests (void)
+{
+	static const gchar feed_xml[] =
+		"<feed xmlns='http://www.w3.org/2005/Atom'>"
+			"<id>http://example.com/id</id>"
+			"<updated>2009-02-25T14:07:37.880860Z</updated>"
+			"<title type='text'>Test feed</title>"
+			"<entry>"
+				"<id>entry1</id>"
+				"<title type='text'>Entry</title>"
+				"<updated>2009-01-25T14:07:37.880860Z</updated>"
+			"</entry>"
+		"</feed>";
+	MockServer server;
+	gchar *uri;
+	guint concurrency, i;
+	gdouble requests_per_second = 0.0, serial_requests_per_second = 0.0;
+
+	#define REQUESTS 64
+
+	/* Start a local HTTPS server in its own thread */
+	mock_server_start (&server, MOCK_LATENCY);
+	mock_server_add_response (&server, "/feed", "application/atom+xml", g_bytes_new_static (feed_xml, sizeof (feed_xml) - 1));
+	uri = mock_server_build_uri (&server, "/feed");
+
+	/* Issue the same number of requests at increasing levels of concurrency, allowing one connection per thread */
+	for (concurrency = 1; concurrency <= 8; concurrency *= 2) {
+		GDataService *service;
+		GThread *threads[8];
+		RequestThreadData data;
+		gint64 start_time, total_time;
+
+		service = g_object_new (GDATA_TYPE_SERVICE, "max-connections-per-host", concurrency, NULL);
+
+		data.service = service;
+		data.uri = uri;
+		data.n_requests = REQUESTS / concurrency;
+
+		start_time = g_get_monotonic_time ();
+
+		for (i = 0; i < concurrency; i++)
+			threads[i] = g_thread_new ("request-thread", (GThreadFunc) request_thread, &data);
+		for (i = 0; i < concurrency; i++)
+			g_thread_join (threads[i]);
+
+		total_time = g_get_monotonic_time () - start_time;
+		requests_per_second = (gdouble) REQUESTS * G_USEC_PER_SEC / (gdouble) total_time;
+
+		if (concurrency == 1)
+			serial_requests_per_second = requests_per_second;
+
+		/* Prefix with hashes to avoid the output being misinterpreted as TAP
+		 * commands. */
+		printf ("# %u requests from %u thread(s) took %.4fs: %.1f requests per second\n",
+		        REQUESTS, concurrency, (gdouble) total_time / (gdouble) G_USEC_PER_SEC, requests_per_second);
+
+		g_object_unref (service);
+	}
+
+	/* Parallel requests should overlap on separate connections, rather than queuing for a single one */
+	g_assert_cmpfloat (requests_per_second, >, serial_requests_per_second);
+
+	g_free (uri);
+
+	mock_server_stop (&server);
+}
+#endif /* HAVE_LIBSOUP_2_55_90 */
+
 int
 main (int argc, char *argv[])
 {
+#ifdef HAVE_LIBSOUP_2_55_90
+	guint i;
+#endif /* HAVE_LIBSOUP_2_55_90 */
+
 	gdata_test_init (argc, argv);
 
 	g_test_add_func ("/perf/parsing", test_perf_parsing);
+	g_test_add_func ("/perf/query-uri", test_perf_query_uri);
+#ifdef HAVE_LIBSOUP_2_55_90
+	for (i = 0; i < G_N_ELEMENTS (feed_benchmarks); i++) {
+		gchar *test_name = g_strdup_printf ("/perf/feed/%s", feed_benchmarks[i].name);
+		g_test_add_data_func (test_name, &feed_benchmarks[i], test_perf_feed);
+		g_free (test_name);
+	}
+
+	g_test_add_func ("/perf/batch", test_perf_batch);
+	g_test_add_func ("/perf/streams", test_perf_streams);
+	g_test_add_func ("/perf/concurrent-requests", test_perf_concurrent_requests);
+#endif /* HAVE_LIBSOUP_2_55_90 */
 
 	return g_test_run ();
 }
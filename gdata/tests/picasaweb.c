@@ -19,6 +19,7 @@
  */
 
 #include <glib.h>
+#include <glib/gstdio.h>
 #include <unistd.h>
 #include <string.h>
 #include <config.h>
@@ -774,6 +775,369 @@ test_download_photo (QueryFilesData *data, gconstpointer service)
 	uhm_server_end_trace (mock_server);
 }
 
+typedef struct {
+	GDataMediaDownloader *downloader;
+	gchar *cache_path;
+
+	/* Details of each #GDataMediaDownloader::item-completed emission, in order */
+	GPtrArray *completed_media;
+	GPtrArray *completed_files; /* file paths, or NULL */
+	GPtrArray *completed_errors; /* GError, or NULL */
+
+	volatile gint truncate_next_response;
+} DownloaderData;
+
+static void
+downloader_item_completed_cb (GDataMediaDownloader *downloader, GObject *media, GFile *file, const GError *error, DownloaderData *data)
+{
+	g_ptr_array_add (data->completed_media, g_object_ref (media));
+	g_ptr_array_add (data->completed_files, (file != NULL) ? g_file_get_path (file) : NULL);
+	g_ptr_array_add (data->completed_errors, (error != NULL) ? g_error_copy (error) : NULL);
+}
+
+static void
+downloader_error_free (GError *error)
+{
+	if (error != NULL)
+		g_error_free (error);
+}
+
+static void
+downloader_wrote_chunk_cb (SoupMessage *message, SoupClientContext *client)
+{
+	/* Drop the connection part way through the response body, as if the network had failed */
+	G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+	soup_socket_disconnect (soup_client_context_get_socket (client));
+	G_GNUC_END_IGNORE_DEPRECATIONS
+}
+
+static gboolean
+downloader_truncate_response_cb (UhmServer *server, SoupMessage *message, SoupClientContext *client, DownloaderData *data)
+{
+	if (g_atomic_int_compare_and_exchange (&data->truncate_next_response, TRUE, FALSE) == FALSE) {
+		/* Let the trace provide the response */
+		return FALSE;
+	}
+
+	/* Send the start of a successful response, then drop the connection before the rest of the body */
+	soup_message_set_status (message, SOUP_STATUS_OK);
+	soup_message_headers_set_encoding (message->response_headers, SOUP_ENCODING_CHUNKED);
+	soup_message_headers_set_content_type (message->response_headers, "image/jpeg", NULL);
+	soup_message_body_append (message->response_body, SOUP_MEMORY_STATIC, "0123456789abcdef", strlen ("0123456789abcdef"));
+	g_signal_connect (message, "wrote-chunk", (GCallback) downloader_wrote_chunk_cb, client);
+
+	return TRUE;
+}
+
+static void
+set_up_downloader (DownloaderData *data, gconstpointer service)
+{
+	GFile *cache_directory;
+	GError *error = NULL;
+
+	data->cache_path = g_dir_make_tmp ("gdata-media-downloader-XXXXXX", &error);
+	g_assert_no_error (error);
+
+	/* Only use one connection, so that the downloads are requested in priority order and match the trace */
+	data->downloader = gdata_media_downloader_new (GDATA_SERVICE (service), 1);
+	cache_directory = g_file_new_for_path (data->cache_path);
+	gdata_media_downloader_set_cache_directory (data->downloader, cache_directory);
+	g_object_unref (cache_directory);
+
+	data->completed_media = g_ptr_array_new_with_free_func (g_object_unref);
+	data->completed_files = g_ptr_array_new_with_free_func (g_free);
+	data->completed_errors = g_ptr_array_new_with_free_func ((GDestroyNotify) downloader_error_free);
+
+	g_signal_connect (data->downloader, "item-completed", (GCallback) downloader_item_completed_cb, data);
+}
+
+static void
+tear_down_downloader (DownloaderData *data, gconstpointer service)
+{
+	GDir *dir;
+	const gchar *name;
+
+	g_ptr_array_unref (data->completed_errors);
+	g_ptr_array_unref (data->completed_files);
+	g_ptr_array_unref (data->completed_media);
+	g_object_unref (data->downloader);
+
+	/* Clear out the cache */
+	dir = g_dir_open (data->cache_path, 0, NULL);
+	g_assert (dir != NULL);
+
+	while ((name = g_dir_read_name (dir)) != NULL) {
+		gchar *filename = g_build_filename (data->cache_path, name, NULL);
+		g_unlink (filename);
+		g_free (filename);
+	}
+
+	g_dir_close (dir);
+	g_rmdir (data->cache_path);
+	g_free (data->cache_path);
+}
+
+static GDataMediaThumbnail *
+downloader_thumbnail_new (const gchar *name, guint width, guint height)
+{
+	GDataMediaThumbnail *thumbnail;
+	gchar *xml;
+	GError *error = NULL;
+
+	xml = g_strdup_printf ("<media:thumbnail xmlns:media='http://search.yahoo.com/mrss/' "
+	                       "url='https://lh3.googleusercontent.com/downloader/%s' width='%u' height='%u'/>", name, width, height);
+	thumbnail = GDATA_MEDIA_THUMBNAIL (gdata_parsable_new_from_xml (GDATA_TYPE_MEDIA_THUMBNAIL, xml, -1, &error));
+	g_assert_no_error (error);
+	g_free (xml);
+
+	return thumbnail;
+}
+
+static GDataMediaContent *
+downloader_content_new (const gchar *name, gsize filesize)
+{
+	GDataMediaContent *content;
+	gchar *xml, *filesize_attribute;
+	GError *error = NULL;
+
+	filesize_attribute = (filesize > 0) ? g_strdup_printf (" fileSize='%" G_GSIZE_FORMAT "'", filesize) : g_strdup ("");
+	xml = g_strdup_printf ("<media:content xmlns:media='http://search.yahoo.com/mrss/' "
+	                       "url='https://lh3.googleusercontent.com/downloader/%s' type='image/jpeg' medium='image'%s/>",
+	                       name, filesize_attribute);
+	content = GDATA_MEDIA_CONTENT (gdata_parsable_new_from_xml (GDATA_TYPE_MEDIA_CONTENT, xml, -1, &error));
+	g_assert_no_error (error);
+	g_free (xml);
+	g_free (filesize_attribute);
+
+	return content;
+}
+
+/* Get the path of the file the downloader caches @name in */
+static gchar *
+downloader_build_cache_filename (DownloaderData *data, const gchar *name)
+{
+	gchar *uri, *checksum, *filename;
+
+	uri = g_strconcat ("https://lh3.googleusercontent.com/downloader/", name, NULL);
+	checksum = g_compute_checksum_for_string (G_CHECKSUM_SHA256, uri, -1);
+	filename = g_build_filename (data->cache_path, checksum, NULL);
+	g_free (checksum);
+	g_free (uri);
+
+	return filename;
+}
+
+static void
+assert_downloader_sink_data (GOutputStream *sink, const gchar *expected_data)
+{
+	g_assert_cmpuint (g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (sink)), ==, strlen (expected_data));
+	g_assert (memcmp (g_memory_output_stream_get_data (G_MEMORY_OUTPUT_STREAM (sink)), expected_data, strlen (expected_data)) == 0);
+}
+
+static void
+assert_downloader_completed (DownloaderData *data, guint i, gpointer media, const gchar *cached_name, const gchar *expected_data)
+{
+	gchar *filename, *contents;
+	GError *error = NULL;
+
+	g_assert_cmpuint (i, <, data->completed_media->len);
+	g_assert (g_ptr_array_index (data->completed_media, i) == media);
+	g_assert_no_error ((GError*) g_ptr_array_index (data->completed_errors, i));
+
+	/* The data should also have been stored in the cache */
+	filename = downloader_build_cache_filename (data, cached_name);
+	g_assert_cmpstr (g_ptr_array_index (data->completed_files, i), ==, filename);
+
+	g_assert (g_file_get_contents (filename, &contents, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpstr (contents, ==, expected_data);
+
+	g_free (contents);
+	g_free (filename);
+}
+
+static void
+test_download_downloader (DownloaderData *data, gconstpointer service)
+{
+	GDataMediaThumbnail *small_thumbnail, *small_thumbnail2, *large_thumbnail;
+	GDataMediaContent *sized_content, *unsized_content;
+	GOutputStream *sink1, *sink2, *sink3, *sink4, *sink5;
+	GError *error = NULL;
+
+	gdata_test_mock_server_start_trace (mock_server, "download-downloader");
+
+	/* Add the items in the reverse of the order they should be downloaded in, which the trace checks: thumbnails first, smallest first,
+	 * then content of known size, then content of unknown size */
+	unsized_content = downloader_content_new ("content-unsized.jpg", 0);
+	sized_content = downloader_content_new ("content-sized.jpg", 1000);
+	large_thumbnail = downloader_thumbnail_new ("thumbnail-large.jpg", 100, 100);
+	small_thumbnail = downloader_thumbnail_new ("thumbnail-small.jpg", 10, 10);
+	small_thumbnail2 = downloader_thumbnail_new ("thumbnail-small.jpg", 10, 10);
+
+	sink1 = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+	sink2 = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+	sink3 = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+	sink4 = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+	sink5 = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+
+	gdata_media_downloader_add_content (data->downloader, unsized_content, sink1);
+	gdata_media_downloader_add_content (data->downloader, sized_content, sink2);
+	gdata_media_downloader_add_thumbnail (data->downloader, large_thumbnail, sink3);
+	gdata_media_downloader_add_thumbnail (data->downloader, small_thumbnail, sink4);
+
+	/* The second small thumbnail has the same URI, so its data should be streamed to both sinks from a single request */
+	gdata_media_downloader_add_thumbnail (data->downloader, small_thumbnail2, sink5);
+	g_assert_cmpuint (gdata_media_downloader_get_n_pending (data->downloader), ==, 4);
+
+	g_assert (gdata_media_downloader_run (data->downloader, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpuint (gdata_media_downloader_get_n_pending (data->downloader), ==, 0);
+
+	g_assert_cmpuint (data->completed_media->len, ==, 5);
+	assert_downloader_completed (data, 0, small_thumbnail, "thumbnail-small.jpg", "small thumbnail data");
+	assert_downloader_completed (data, 1, small_thumbnail2, "thumbnail-small.jpg", "small thumbnail data");
+	assert_downloader_completed (data, 2, large_thumbnail, "thumbnail-large.jpg", "large thumbnail data");
+	assert_downloader_completed (data, 3, sized_content, "content-sized.jpg", "sized content data");
+	assert_downloader_completed (data, 4, unsized_content, "content-unsized.jpg", "unsized content data");
+
+	assert_downloader_sink_data (sink1, "unsized content data");
+	assert_downloader_sink_data (sink2, "sized content data");
+	assert_downloader_sink_data (sink3, "large thumbnail data");
+	assert_downloader_sink_data (sink4, "small thumbnail data");
+	assert_downloader_sink_data (sink5, "small thumbnail data");
+
+	g_object_unref (sink5);
+	g_object_unref (sink4);
+	g_object_unref (sink3);
+	g_object_unref (sink2);
+	g_object_unref (sink1);
+	g_object_unref (small_thumbnail2);
+	g_object_unref (small_thumbnail);
+	g_object_unref (large_thumbnail);
+	g_object_unref (sized_content);
+	g_object_unref (unsized_content);
+
+	uhm_server_end_trace (mock_server);
+}
+
+/* Test that if a download fails part way through and is retried, the data already written to the sinks isn't written again; and that if it
+ * isn't retried, the partially downloaded data isn't left in the cache. */
+static void
+test_download_downloader_retry (DownloaderData *data, gconstpointer service)
+{
+	GDataMediaThumbnail *thumbnail;
+	GOutputStream *sink;
+	gulong handler_id;
+	gchar *filename;
+	guint max_retries;
+	GError *error = NULL;
+
+	gdata_test_mock_server_start_trace (mock_server, "download-downloader-retry");
+	handler_id = g_signal_connect (mock_server, "handle-message", (GCallback) downloader_truncate_response_cb, data);
+
+	thumbnail = downloader_thumbnail_new ("retry.jpg", 10, 10);
+	sink = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+
+	/* The first response is cut off after its first 16 bytes, and the retry gets the whole thing from the trace */
+	g_atomic_int_set (&data->truncate_next_response, TRUE);
+	gdata_media_downloader_add_thumbnail (data->downloader, thumbnail, sink);
+
+	g_assert (gdata_media_downloader_run (data->downloader, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert (g_atomic_int_get (&data->truncate_next_response) == FALSE);
+
+	g_assert_cmpuint (data->completed_media->len, ==, 1);
+	assert_downloader_completed (data, 0, thumbnail, "retry.jpg", "0123456789abcdefghijklmnopqrstuvwxyz");
+	assert_downloader_sink_data (sink, "0123456789abcdefghijklmnopqrstuvwxyz");
+
+	g_object_unref (sink);
+	g_object_unref (thumbnail);
+
+	/* Now fail the same way without retrying. The cache file should be discarded rather than left holding the first 16 bytes. */
+	max_retries = gdata_service_get_max_retries (GDATA_SERVICE (service));
+	gdata_service_set_max_retries (GDATA_SERVICE (service), 0);
+
+	thumbnail = downloader_thumbnail_new ("truncated.jpg", 10, 10);
+	sink = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+
+	g_atomic_int_set (&data->truncate_next_response, TRUE);
+	gdata_media_downloader_add_thumbnail (data->downloader, thumbnail, sink);
+
+	g_assert (gdata_media_downloader_run (data->downloader, NULL, &error) == FALSE);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_NETWORK_ERROR);
+	g_clear_error (&error);
+
+	gdata_service_set_max_retries (GDATA_SERVICE (service), max_retries);
+
+	g_assert_cmpuint (data->completed_media->len, ==, 2);
+	g_assert (g_ptr_array_index (data->completed_media, 1) == thumbnail);
+	g_assert (g_ptr_array_index (data->completed_files, 1) == NULL);
+	g_assert_error ((GError*) g_ptr_array_index (data->completed_errors, 1), GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_NETWORK_ERROR);
+
+	filename = downloader_build_cache_filename (data, "truncated.jpg");
+	g_assert (g_file_test (filename, G_FILE_TEST_EXISTS) == FALSE);
+	g_free (filename);
+
+	g_object_unref (sink);
+	g_object_unref (thumbnail);
+
+	g_signal_handler_disconnect (mock_server, handler_id);
+
+	uhm_server_end_trace (mock_server);
+}
+
+/* Test that a failed download is reported with an error parsed from the response, isn't cached, and doesn't stop the other items */
+static void
+test_download_downloader_error (DownloaderData *data, gconstpointer service)
+{
+	GDataMediaThumbnail *missing_thumbnail;
+	GDataMediaContent *present_content;
+	GOutputStream *sink1, *sink2;
+	const GError *item_error;
+	gchar *filename;
+	GError *error = NULL;
+
+	gdata_test_mock_server_start_trace (mock_server, "download-downloader-error");
+
+	missing_thumbnail = downloader_thumbnail_new ("missing.jpg", 10, 10);
+	present_content = downloader_content_new ("present.jpg", 20);
+
+	sink1 = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+	sink2 = g_memory_output_stream_new (NULL, 0, g_realloc, g_free);
+
+	gdata_media_downloader_add_content (data->downloader, present_content, sink2);
+	gdata_media_downloader_add_thumbnail (data->downloader, missing_thumbnail, sink1);
+
+	g_assert (gdata_media_downloader_run (data->downloader, NULL, &error) == FALSE);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_NOT_FOUND);
+	g_assert (strstr (error->message, "The requested thumbnail does not exist.") != NULL);
+	g_clear_error (&error);
+
+	g_assert_cmpuint (data->completed_media->len, ==, 2);
+
+	/* The thumbnail's 404 should have been parsed into an error, and nothing written to its sink or the cache */
+	g_assert (g_ptr_array_index (data->completed_media, 0) == missing_thumbnail);
+	g_assert (g_ptr_array_index (data->completed_files, 0) == NULL);
+	item_error = g_ptr_array_index (data->completed_errors, 0);
+	g_assert_error (item_error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_NOT_FOUND);
+	g_assert_cmpuint (g_memory_output_stream_get_data_size (G_MEMORY_OUTPUT_STREAM (sink1)), ==, 0);
+
+	filename = downloader_build_cache_filename (data, "missing.jpg");
+	g_assert (g_file_test (filename, G_FILE_TEST_EXISTS) == FALSE);
+	g_free (filename);
+
+	/* The content should still have been downloaded */
+	assert_downloader_completed (data, 1, present_content, "present.jpg", "present content data");
+	assert_downloader_sink_data (sink2, "present content data");
+
+	g_object_unref (sink2);
+	g_object_unref (sink1);
+	g_object_unref (present_content);
+	g_object_unref (missing_thumbnail);
+
+	uhm_server_end_trace (mock_server);
+}
+
 typedef struct {
 	GDataPicasaWebAlbum *album;
 	GDataPicasaWebAlbum *inserted_album;
@@ -2217,6 +2581,12 @@ main (int argc, char *argv[])
 	g_test_add ("/picasaweb/download/photo", QueryFilesData, service, set_up_query_files, test_download_photo, tear_down_query_files);
 	g_test_add ("/picasaweb/download/thumbnails", QueryFilesData, service, set_up_query_files, test_download_thumbnails,
 	            tear_down_query_files);
+	g_test_add ("/picasaweb/download/downloader", DownloaderData, service, set_up_downloader, test_download_downloader,
+	            tear_down_downloader);
+	g_test_add ("/picasaweb/download/downloader/retry", DownloaderData, service, set_up_downloader, test_download_downloader_retry,
+	            tear_down_downloader);
+	g_test_add ("/picasaweb/download/downloader/error", DownloaderData, service, set_up_downloader, test_download_downloader_error,
+	            tear_down_downloader);
 
 	g_test_add_func ("/picasaweb/album/new", test_album_new);
 	g_test_add_func ("/picasaweb/album/escaping", test_album_escaping);
@@ -697,6 +697,142 @@ test_tasklist_list (ListTasklistData *data, gconstpointer service)
 	uhm_server_end_trace (mock_server);
 }
 
+/* Test that listing tasklists is retried if the server is temporarily unavailable. */
+static void
+test_tasklist_list_retry (ListTasklistData *data, gconstpointer service)
+{
+	GDataFeed *feed = NULL;  /* owned */
+	GError *error = NULL;
+
+	gdata_test_mock_server_start_trace (mock_server, "tasklist-list-retry");
+
+	/* The first response is a 503 with a zero Retry-After, so this should succeed on the second attempt. */
+	feed = gdata_tasks_service_query_all_tasklists (GDATA_TASKS_SERVICE (service),
+	                                                NULL, NULL, NULL, NULL,
+	                                                &error);
+	g_assert_no_error (error);
+
+	g_assert (gdata_feed_look_up_entry (feed, gdata_entry_get_id (GDATA_ENTRY (data->tasklist1))) != NULL);
+
+	g_object_unref (feed);
+
+	uhm_server_end_trace (mock_server);
+}
+
+static void
+request_finished_cb (GDataService *service, GDataRequestStatistics *statistics, GDataRequestStatistics **statistics_out)
+{
+	g_assert (*statistics_out == NULL);
+	*statistics_out = gdata_request_statistics_copy (statistics);
+}
+
+/* Test that the statistics reported for a request which had to be retried are correct. */
+static void
+test_tasklist_list_statistics (ListTasklistData *data, gconstpointer service)
+{
+	GDataFeed *feed = NULL;  /* owned */
+	GDataRequestStatistics *statistics = NULL;  /* owned */
+	gulong handler_id;
+	GError *error = NULL;
+
+	gdata_test_mock_server_start_trace (mock_server, "tasklist-list-retry");
+
+	handler_id = g_signal_connect (GDATA_SERVICE (service), "request-finished", (GCallback) request_finished_cb, &statistics);
+
+	feed = gdata_tasks_service_query_all_tasklists (GDATA_TASKS_SERVICE (service),
+	                                                NULL, NULL, NULL, NULL,
+	                                                &error);
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_FEED (feed));
+
+	g_signal_handler_disconnect (GDATA_SERVICE (service), handler_id);
+
+	/* The request should have been reported exactly once, including the retry and the parse. */
+	g_assert (statistics != NULL);
+	g_assert_cmpint (statistics->operation_type, ==, GDATA_OPERATION_QUERY);
+	g_assert (statistics->authorization_domain == gdata_tasks_service_get_primary_authorization_domain ());
+	g_assert_cmpstr (statistics->method, ==, "GET");
+	g_assert_cmpuint (statistics->status, ==, SOUP_STATUS_OK);
+	g_assert_cmpuint (statistics->retries, ==, 1);
+	g_assert_cmpuint (statistics->bytes_sent, >, 0);
+	g_assert_cmpuint (statistics->bytes_received, >, 0);
+	g_assert_cmpint (statistics->time_to_first_byte, >=, 0);
+	g_assert_cmpint (statistics->total_time, >=, statistics->time_to_first_byte);
+	g_assert_cmpint (statistics->parse_time, >=, 0);
+	g_assert_cmpuint (statistics->parse_statistics.bytes_parsed, >, 0);
+	g_assert_cmpuint (statistics->parse_statistics.entries_built, >=, 1);
+	g_assert_cmpint (statistics->parse_statistics.build_time, <=, statistics->parse_time);
+
+	gdata_request_statistics_free (statistics);
+	g_object_unref (feed);
+
+	uhm_server_end_trace (mock_server);
+}
+
+/* Test that a 403 response saying a rate limit was exceeded, as Google APIs send instead of a 429, is retried. */
+static void
+test_tasklist_list_rate_limited (ListTasklistData *data, gconstpointer service)
+{
+	GDataFeed *feed = NULL;  /* owned */
+	GDataRequestStatistics *statistics = NULL;  /* owned */
+	gulong handler_id;
+	GError *error = NULL;
+
+	gdata_test_mock_server_start_trace (mock_server, "tasklist-list-rate-limited");
+
+	handler_id = g_signal_connect (GDATA_SERVICE (service), "request-finished", (GCallback) request_finished_cb, &statistics);
+
+	/* The first response is a 403 with a rateLimitExceeded reason and a zero Retry-After, so this should succeed on the second
+	 * attempt. */
+	feed = gdata_tasks_service_query_all_tasklists (GDATA_TASKS_SERVICE (service),
+	                                                NULL, NULL, NULL, NULL,
+	                                                &error);
+	g_assert_no_error (error);
+	g_assert (gdata_feed_look_up_entry (feed, gdata_entry_get_id (GDATA_ENTRY (data->tasklist1))) != NULL);
+
+	g_signal_handler_disconnect (GDATA_SERVICE (service), handler_id);
+
+	g_assert (statistics != NULL);
+	g_assert_cmpuint (statistics->status, ==, SOUP_STATUS_OK);
+	g_assert_cmpuint (statistics->retries, ==, 1);
+
+	gdata_request_statistics_free (statistics);
+	g_object_unref (feed);
+
+	uhm_server_end_trace (mock_server);
+}
+
+/* Test that an adaptive rate limit is lowered by a 403 response saying a rate limit was exceeded, as well as by a 429. */
+static void
+test_tasklist_list_rate_limited_adaptive (ListTasklistData *data, gconstpointer service)
+{
+	GDataAuthorizationDomain *domain;
+	GDataFeed *feed = NULL;  /* owned */
+	gdouble requests_per_second;
+	GError *error = NULL;
+
+	domain = gdata_tasks_service_get_primary_authorization_domain ();
+	gdata_service_set_rate_limit (GDATA_SERVICE (service), domain, 100.0, 10, TRUE);
+
+	gdata_test_mock_server_start_trace (mock_server, "tasklist-list-rate-limited");
+
+	feed = gdata_tasks_service_query_all_tasklists (GDATA_TASKS_SERVICE (service),
+	                                                NULL, NULL, NULL, NULL,
+	                                                &error);
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_FEED (feed));
+	g_object_unref (feed);
+
+	uhm_server_end_trace (mock_server);
+
+	/* The 403 should have halved the rate, and the successful retry only recovered a little of it */
+	g_assert (gdata_service_get_rate_limit (GDATA_SERVICE (service), domain, &requests_per_second, NULL) == TRUE);
+	g_assert_cmpfloat (requests_per_second, <, 100.0);
+	g_assert_cmpfloat (requests_per_second, >=, 50.0);
+
+	gdata_service_set_rate_limit (GDATA_SERVICE (service), domain, 0.0, 1, FALSE);
+}
+
 /* Test that updating a single tasklist works. */
 typedef struct {
 	GDataTasksTasklist *tasklist;
@@ -1082,6 +1218,358 @@ test_task_update (UpdateTaskData *data, gconstpointer service)
 	uhm_server_end_trace (mock_server);
 }
 
+/* Test that a partial update of a task only sends the changed members, with
+ * cleared members sent as null, and that the new ETag is merged back into the
+ * local task. The trace is hand-written. */
+static void
+test_task_patch (gconstpointer service)
+{
+	GDataTasksTask *task = NULL;  /* owned */
+	GDataTasksTask *patched_task = NULL;  /* owned */
+	GPtrArray *requests = NULL;  /* owned */
+	SoupMessage *request;  /* unowned */
+	gulong handler_id;
+	GError *error = NULL;
+
+	task = GDATA_TASKS_TASK (gdata_parsable_new_from_json (GDATA_TYPE_TASKS_TASK,
+		"{"
+			"\"kind\": \"tasks#task\","
+			"\"id\": \"MTY4ODYzMjk0OTkzNDgxODY2Njk6NTgwMzc0MTkzOjU1NzMwODc3Ng\","
+			"\"etag\": \"\\\"NEVtLf5Q_dTURZbE3E-zlPpPgGk/NzgyODM3MzA2\\\"\","
+			"\"title\": \"New Title!\","
+			"\"updated\": \"2017-03-05T16:20:00.000Z\","
+			"\"selfLink\": \"https://www.googleapis.com/tasks/v1/lists/MTY4ODYzMjk0OTkzNDgxODY2Njk6NTgwMzc0MTkzOjA/tasks/"
+			                 "MTY4ODYzMjk0OTkzNDgxODY2Njk6NTgwMzc0MTkzOjU1NzMwODc3Ng\","
+			"\"position\": \"00000000002147483647\","
+			"\"notes\": \"Some notes!\","
+			"\"status\": \"needsAction\","
+			"\"due\": \"2017-03-06T00:00:00.000Z\""
+		"}", -1, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_TASKS_TASK (task));
+
+	/* Change the title and clear the notes and due date. */
+	gdata_entry_set_title (GDATA_ENTRY (task), "Updated title");
+	gdata_tasks_task_set_notes (task, NULL);
+	gdata_tasks_task_set_due (task, -1);
+
+	gdata_test_mock_server_start_trace (mock_server, "task-patch");
+	requests = g_ptr_array_new_with_free_func (g_object_unref);
+	handler_id = gdata_test_mock_server_record_requests (mock_server, requests);
+
+	patched_task = GDATA_TASKS_TASK (gdata_service_patch_entry (GDATA_SERVICE (service),
+	                                                            gdata_tasks_service_get_primary_authorization_domain (),
+	                                                            GDATA_ENTRY (task), NULL, &error));
+	g_assert_no_error (error);
+	g_assert (GDATA_IS_TASKS_TASK (patched_task));
+
+	/* Check the request only contained the changed members. */
+	g_assert_cmpuint (requests->len, ==, 1);
+	request = g_ptr_array_index (requests, 0);
+	g_assert_cmpstr (request->method, ==, "PATCH");
+	g_assert_cmpstr (soup_message_headers_get_one (request->request_headers, "If-Match"),
+	                 ==, "\"NEVtLf5Q_dTURZbE3E-zlPpPgGk/NzgyODM3MzA2\"");
+	g_assert_cmpstr (soup_message_headers_get_content_type (request->request_headers, NULL), ==, "application/json");
+	g_assert (gdata_test_compare_json_strings (request->request_body->data,
+		"{"
+			"\"title\": \"Updated title\","
+			"\"notes\": null,"
+			"\"due\": null"
+		"}", TRUE) == TRUE);
+
+	/* Check the returned task. */
+	g_assert_cmpstr (gdata_entry_get_title (GDATA_ENTRY (patched_task)), ==, "Updated title");
+	g_assert (gdata_tasks_task_get_notes (patched_task) == NULL);
+	g_assert_cmpint (gdata_tasks_task_get_due (patched_task), ==, -1);
+
+	/* The new ETag and update time should have been merged back, and the
+	 * changes forgotten. */
+	g_assert_cmpstr (gdata_entry_get_etag (GDATA_ENTRY (task)),
+	                 ==, "\"NEVtLf5Q_dTURZbE3E-zlPpPgGk/MTA1NzYxNzQ5Mw\"");
+	g_assert_cmpint (gdata_entry_get_updated (GDATA_ENTRY (task)), ==, 1488731100);
+
+	g_object_unref (patched_task);
+	patched_task = GDATA_TASKS_TASK (gdata_service_patch_entry (GDATA_SERVICE (service),
+	                                                            gdata_tasks_service_get_primary_authorization_domain (),
+	                                                            GDATA_ENTRY (task), NULL, &error));
+	g_assert_no_error (error);
+	g_assert (patched_task == task);
+	g_assert_cmpuint (requests->len, ==, 1);
+
+	g_signal_handler_disconnect (mock_server, handler_id);
+	g_ptr_array_unref (requests);
+	g_object_unref (patched_task);
+	g_object_unref (task);
+
+	uhm_server_end_trace (mock_server);
+}
+
+#define BATCH_TASKS_URI "https://www.googleapis.com/tasks/v1/lists/MTY4ODYzMjk0OTkzNDgxODY2Njk6NTgwMzc0MTkzOjA/tasks"
+
+static GDataTasksTask *
+parse_batch_task (const gchar *task_id, const gchar *title)
+{
+	GDataTasksTask *task = NULL;  /* owned */
+	gchar *json = NULL;  /* owned */
+	GError *error = NULL;
+
+	json = g_strdup_printf ("{"
+		"\"kind\": \"tasks#task\","
+		"\"id\": \"%s\","
+		"\"etag\": \"\\\"%s-etag\\\"\","
+		"\"title\": \"%s\","
+		"\"updated\": \"2017-03-05T16:20:00.000Z\","
+		"\"selfLink\": \"" BATCH_TASKS_URI "/%s\","
+		"\"status\": \"needsAction\""
+	"}", task_id, task_id, title, task_id);
+	task = GDATA_TASKS_TASK (gdata_parsable_new_from_json (GDATA_TYPE_TASKS_TASK, json, -1, &error));
+	g_assert_no_error (error);
+	g_free (json);
+
+	return task;
+}
+
+/* Check that @request is a multipart batch request containing @n_parts
+ * embedded HTTP requests, the first of which is for operation @first_id. */
+static void
+assert_batch_request (SoupMessage *request, guint n_parts, guint first_id)
+{
+	SoupMultipart *multipart = NULL;  /* owned */
+	SoupMessageHeaders *part_headers;  /* unowned */
+	SoupBuffer *part_body;  /* unowned */
+	gchar *content_id = NULL;  /* owned */
+	guint i;
+
+	g_assert_cmpstr (request->method, ==, "POST");
+	multipart = soup_multipart_new_from_message (request->request_headers, request->request_body);
+	g_assert (multipart != NULL);
+	g_assert_cmpint (soup_multipart_get_length (multipart), ==, n_parts);
+
+	for (i = 0; i < n_parts; i++) {
+		g_assert (soup_multipart_get_part (multipart, i, &part_headers, &part_body));
+		g_assert_cmpstr (soup_message_headers_get_one (part_headers, "Content-Type"), ==, "application/http");
+
+		content_id = g_strdup_printf ("<item%u>", first_id + i);
+		g_assert_cmpstr (soup_message_headers_get_one (part_headers, "Content-ID"), ==, content_id);
+		g_free (content_id);
+	}
+
+	soup_multipart_free (multipart);
+}
+
+/* Test that a batch operation on more than 100 tasks is split into several
+ * multipart requests, that each operation gets the result from the response
+ * part with the matching Content-ID (whatever order the parts are in), and
+ * that failed parts and missing parts only fail their own operations. The
+ * trace is hand-written. */
+static void
+test_batch (gconstpointer service)
+{
+	GDataBatchOperation *operation = NULL;  /* owned */
+	GDataTasksTask *task1 = NULL, *task2 = NULL, *task3 = NULL;  /* owned */
+	GDataEntry *queried_entry = NULL, *updated_entry = NULL;  /* owned */
+	GDataEntry *inserted_entries[99] = { NULL, };  /* owned */
+	GDataTasksTask *new_task = NULL;  /* owned */
+	GPtrArray *requests = NULL;  /* owned */
+	gchar *title = NULL;  /* owned */
+	gulong handler_id;
+	guint op_id, i;
+	GError *error = NULL, *deletion_error = NULL, *insertion_error = NULL;
+
+	task1 = parse_batch_task ("task1", "Task 1");
+	task2 = parse_batch_task ("task2", "Task 2");
+	task3 = parse_batch_task ("task3", "Task 3");
+
+	gdata_test_mock_server_start_trace (mock_server, "batch");
+	requests = g_ptr_array_new_with_free_func (g_object_unref);
+	handler_id = gdata_test_mock_server_record_requests (mock_server, requests);
+
+	operation = gdata_batchable_create_operation (GDATA_BATCHABLE (service), gdata_tasks_service_get_primary_authorization_domain (),
+	                                              BATCH_TASKS_URI);
+
+	/* A query, an update, a deletion of a task which no longer exists, and
+	 * then enough insertions to need a second request. */
+	op_id = gdata_test_batch_operation_query (operation, BATCH_TASKS_URI "/task1", GDATA_TYPE_TASKS_TASK, GDATA_ENTRY (task1),
+	                                          &queried_entry, NULL);
+	g_assert_cmpuint (op_id, ==, 1);
+
+	gdata_entry_set_title (GDATA_ENTRY (task2), "Task 2 (updated)");
+	gdata_test_batch_operation_update (operation, GDATA_ENTRY (task2), &updated_entry, NULL);
+	gdata_test_batch_operation_deletion (operation, GDATA_ENTRY (task3), &deletion_error);
+
+	for (i = 0; i < G_N_ELEMENTS (inserted_entries); i++) {
+		title = g_strdup_printf ("Task %u", i + 4);
+		new_task = gdata_tasks_task_new (NULL);
+		gdata_entry_set_title (GDATA_ENTRY (new_task), title);
+
+		/* The server doesn't respond to the last insertion. */
+		op_id = gdata_test_batch_operation_insertion (operation, GDATA_ENTRY (new_task), &inserted_entries[i],
+		                                              (i == G_N_ELEMENTS (inserted_entries) - 1) ? &insertion_error : NULL);
+		g_assert_cmpuint (op_id, ==, i + 4);
+
+		g_object_unref (new_task);
+		g_free (title);
+	}
+
+	/* The batch operation as a whole should succeed. */
+	g_assert (gdata_test_batch_operation_run (operation, NULL, &error));
+	g_assert_no_error (error);
+
+	/* Check the requests: 100 operations, then the remaining 2. */
+	g_assert_cmpuint (requests->len, ==, 2);
+	assert_batch_request (g_ptr_array_index (requests, 0), 100, 1);
+	assert_batch_request (g_ptr_array_index (requests, 1), 2, 101);
+
+	/* Check the results. */
+	g_assert (GDATA_IS_TASKS_TASK (queried_entry));
+	g_assert_cmpstr (gdata_entry_get_id (queried_entry), ==, "task1");
+
+	g_assert (GDATA_IS_TASKS_TASK (updated_entry));
+	g_assert_cmpstr (gdata_entry_get_etag (updated_entry), ==, "\"task2-etag2\"");
+
+	g_assert_error (deletion_error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_NOT_FOUND);
+
+	for (i = 0; i < G_N_ELEMENTS (inserted_entries) - 1; i++) {
+		gchar *expected_id = g_strdup_printf ("new-task%u", i + 4);
+
+		g_assert (GDATA_IS_TASKS_TASK (inserted_entries[i]));
+		g_assert_cmpstr (gdata_entry_get_id (inserted_entries[i]), ==, expected_id);
+		g_free (expected_id);
+	}
+
+	g_assert (inserted_entries[G_N_ELEMENTS (inserted_entries) - 1] == NULL);
+	g_assert_error (insertion_error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR);
+
+	g_signal_handler_disconnect (mock_server, handler_id);
+	uhm_server_end_trace (mock_server);
+
+	for (i = 0; i < G_N_ELEMENTS (inserted_entries); i++)
+		g_clear_object (&inserted_entries[i]);
+
+	g_clear_error (&insertion_error);
+	g_clear_error (&deletion_error);
+	g_object_unref (updated_entry);
+	g_object_unref (queried_entry);
+	g_ptr_array_unref (requests);
+	g_object_unref (operation);
+	g_object_unref (task3);
+	g_object_unref (task2);
+	g_object_unref (task1);
+}
+
+/* Test that a sync session for a tasklist does a full sync on its first run,
+ * then only fetches the tasks updated since the latest update time it has
+ * seen, and that its cursor survives failed runs and can be saved and
+ * restored. The trace is hand-written. */
+static void
+test_sync_session (gconstpointer service)
+{
+	GDataTasksTasklist *tasklist = NULL;  /* owned */
+	GDataSyncSession *session = NULL;  /* owned */
+	GString *changes = NULL;  /* owned */
+	gchar *cursor = NULL;  /* owned */
+	gint64 now;
+	GError *error = NULL;
+
+	gdata_test_mock_server_start_trace (mock_server, "sync-session");
+
+	tasklist = gdata_tasks_tasklist_new ("MTY4ODYzMjk0OTkzNDgxODY2Njk6NTgwMzc0MTkzOjA");
+	session = gdata_tasks_service_create_sync_session (GDATA_TASKS_SERVICE (service), tasklist);
+	g_assert (GDATA_IS_SYNC_SESSION (session));
+	g_assert (gdata_sync_session_get_service (session) == service);
+	g_assert (gdata_sync_session_get_authorization_domain (session) == gdata_tasks_service_get_primary_authorization_domain ());
+	g_assert_cmpstr (gdata_sync_session_get_feed_uri (session), ==,
+	                 "https://www.googleapis.com/tasks/v1/lists/MTY4ODYzMjk0OTkzNDgxODY2Njk6NTgwMzc0MTkzOjA/tasks");
+
+	/* The session hasn't synchronised yet. */
+	cursor = gdata_sync_session_dup_cursor (session);
+	g_assert (cursor == NULL);
+
+	/* The first run is a full sync. Deleted tasks aren't reported, but
+	 * they still advance the cursor. */
+	changes = g_string_new (NULL);
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpstr (changes->str, ==, "reset insertion:sync-task1 insertion:sync-task2");
+
+	cursor = gdata_sync_session_dup_cursor (session);
+	g_assert_cmpstr (cursor, ==, "1488731400:");
+	g_free (cursor);
+
+	/* The second run only fetches changes since 16:30. Google Tasks doesn't
+	 * give creation times, so the new task is reported as an update. */
+	g_string_truncate (changes, 0);
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpstr (changes->str, ==, "update:sync-task1 update:sync-task4 deletion:sync-task2");
+
+	cursor = gdata_sync_session_dup_cursor (session);
+	g_assert_cmpstr (cursor, ==, "1488732600:");
+	g_free (cursor);
+
+	/* A failed run leaves the cursor where it was. */
+	g_string_truncate (changes, 0);
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == FALSE);
+	g_assert_error (error, GDATA_SERVICE_ERROR, GDATA_SERVICE_ERROR_PROTOCOL_ERROR);
+	g_clear_error (&error);
+	g_assert_cmpstr (changes->str, ==, "");
+
+	cursor = gdata_sync_session_dup_cursor (session);
+	g_assert_cmpstr (cursor, ==, "1488732600:");
+	g_free (cursor);
+
+	/* If the service rejects the cursor with 410 Gone, the run falls back
+	 * to a full sync. */
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpstr (changes->str, ==, "reset insertion:sync-task1 insertion:sync-task4");
+
+	cursor = gdata_sync_session_dup_cursor (session);
+	g_assert_cmpstr (cursor, ==, "1488732300:");
+	g_free (cursor);
+
+	/* Malformed cursors are ignored, leaving the session unsynchronised. */
+	gdata_sync_session_set_cursor (session, "not a cursor");
+	g_assert (gdata_sync_session_dup_cursor (session) == NULL);
+	gdata_sync_session_set_cursor (session, "1488732300");
+	g_assert (gdata_sync_session_dup_cursor (session) == NULL);
+	gdata_sync_session_set_cursor (session, "-5:");
+	g_assert (gdata_sync_session_dup_cursor (session) == NULL);
+	gdata_sync_session_set_cursor (session, ":");
+	g_assert (gdata_sync_session_dup_cursor (session) == NULL);
+
+	/* A well-formed cursor round-trips. */
+	gdata_sync_session_set_cursor (session, "1488732300:");
+	cursor = gdata_sync_session_dup_cursor (session);
+	g_assert_cmpstr (cursor, ==, "1488732300:");
+	g_free (cursor);
+
+	/* After clearing the cursor, the next run is a full sync. If the
+	 * tasklist is empty, the cursor falls back to the time of the run (less
+	 * a margin for clock skew). */
+	gdata_sync_session_set_cursor (session, NULL);
+	g_assert (gdata_sync_session_dup_cursor (session) == NULL);
+
+	g_string_truncate (changes, 0);
+	now = g_get_real_time () / G_USEC_PER_SEC;
+	g_assert (gdata_sync_session_run (session, gdata_test_sync_session_record_change, changes, NULL, &error) == TRUE);
+	g_assert_no_error (error);
+	g_assert_cmpstr (changes->str, ==, "reset");
+
+	cursor = gdata_sync_session_dup_cursor (session);
+	g_assert (cursor != NULL);
+	g_assert_cmpint (g_ascii_strtoll (cursor, NULL, 10), >=, now - 5 * 60 - TIME_FUZZINESS);
+	g_assert_cmpint (g_ascii_strtoll (cursor, NULL, 10), <=, now - 5 * 60 + TIME_FUZZINESS);
+	g_assert (g_str_has_suffix (cursor, ":") == TRUE);
+	g_free (cursor);
+
+	g_string_free (changes, TRUE);
+	g_object_unref (session);
+	g_object_unref (tasklist);
+
+	uhm_server_end_trace (mock_server);
+}
+
 /* Test that deleting a single task works. */
 typedef struct {
 	GDataTasksTasklist *tasklist;
@@ -1388,6 +1876,18 @@ main (int argc, char *argv[])
 	g_test_add ("/tasks/tasklist/list", ListTasklistData, service,
 	            set_up_list_tasklist, test_tasklist_list,
 	            tear_down_list_tasklist);
+	g_test_add ("/tasks/tasklist/list/retry", ListTasklistData, service,
+	            set_up_list_tasklist, test_tasklist_list_retry,
+	            tear_down_list_tasklist);
+	g_test_add ("/tasks/tasklist/list/statistics", ListTasklistData, service,
+	            set_up_list_tasklist, test_tasklist_list_statistics,
+	            tear_down_list_tasklist);
+	g_test_add ("/tasks/tasklist/list/rate-limited", ListTasklistData, service,
+	            set_up_list_tasklist, test_tasklist_list_rate_limited,
+	            tear_down_list_tasklist);
+	g_test_add ("/tasks/tasklist/list/rate-limited/adaptive", ListTasklistData, service,
+	            set_up_list_tasklist, test_tasklist_list_rate_limited_adaptive,
+	            tear_down_list_tasklist);
 	g_test_add ("/tasks/tasklist/update", UpdateTasklistData, service,
 	            set_up_update_tasklist, test_tasklist_update,
 	            tear_down_update_tasklist);
@@ -1404,10 +1904,14 @@ main (int argc, char *argv[])
 	g_test_add ("/tasks/task/update", UpdateTaskData, service,
 	            set_up_update_task, test_task_update,
 	            tear_down_update_task);
+	g_test_add_data_func ("/tasks/task/patch", service, test_task_patch);
 	g_test_add ("/tasks/task/delete", DeleteTaskData, service,
 	            set_up_delete_task, test_task_delete,
 	            tear_down_delete_task);
 
+	g_test_add_data_func ("/tasks/batch", service, test_batch);
+	g_test_add_data_func ("/tasks/sync-session", service, test_sync_session);
+
 	g_test_add_func ("/tasks/task/properties", test_task_properties);
 	g_test_add_func ("/tasks/task/escaping", test_task_escaping);
 	g_test_add_func ("/tasks/task/parser/minimal",
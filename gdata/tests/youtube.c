@@ -1648,6 +1648,38 @@ test_query_uri (void)
 	g_object_unref (query);
 
 	G_GNUC_END_IGNORE_DEPRECATIONS
+
+	/* Partial-response field masks; the kind of each result and the paging information are always requested */
+	query = gdata_youtube_query_new ("q");
+
+	gdata_youtube_query_set_field_mask (query, GDATA_QUERY_FIELDS_ID | GDATA_QUERY_FIELDS_ETAG | GDATA_QUERY_FIELDS_UPDATED |
+	                                           GDATA_QUERY_FIELDS_TITLE);
+	g_assert_cmpstr (gdata_query_get_fields (GDATA_QUERY (query)), ==,
+	                 "kind,nextPageToken,prevPageToken,pageInfo,items(kind,id,etag,snippet(publishedAt,title))");
+
+	query_uri = gdata_query_get_query_uri (GDATA_QUERY (query), "http://example.com");
+	g_assert_cmpstr (query_uri, ==, "http://example.com?q=q&safeSearch=none"
+	                                "&fields=kind,nextPageToken,prevPageToken,pageInfo,items(kind,id,etag,snippet(publishedAt,title))");
+	g_free (query_uri);
+
+	/* …with a single snippet field, and GDATA_QUERY_FIELDS_DELETED, which YouTube doesn't support */
+	gdata_youtube_query_set_field_mask (query, GDATA_QUERY_FIELDS_TITLE | GDATA_QUERY_FIELDS_DELETED);
+	g_assert_cmpstr (gdata_query_get_fields (GDATA_QUERY (query)), ==, "kind,nextPageToken,prevPageToken,pageInfo,items(kind,snippet/title)");
+
+	query_uri = gdata_query_get_query_uri (GDATA_QUERY (query), "http://example.com?foobar=shizzle");
+	g_assert_cmpstr (query_uri, ==, "http://example.com?foobar=shizzle&q=q&safeSearch=none"
+	                                "&fields=kind,nextPageToken,prevPageToken,pageInfo,items(kind,snippet/title)");
+	g_free (query_uri);
+
+	/* Unsetting the mask should remove the parameter again */
+	gdata_youtube_query_set_field_mask (query, 0);
+	g_assert (gdata_query_get_fields (GDATA_QUERY (query)) == NULL);
+
+	query_uri = gdata_query_get_query_uri (GDATA_QUERY (query), "http://example.com");
+	g_assert_cmpstr (query_uri, ==, "http://example.com?q=q&safeSearch=none");
+	g_free (query_uri);
+
+	g_object_unref (query);
 }
 
 static void